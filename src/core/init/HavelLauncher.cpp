@@ -1720,6 +1720,9 @@ LaunchConfig HavelLauncher::parseArgs(int argc, char *argv[]) {
       if (i + 1 < argc)
         cfg.vmConfig.gc_promotion_age =
             static_cast<uint8_t>(std::stoul(argv[++i]));
+    } else if (arg == "--gc-mark-threads") {
+      if (i + 1 < argc)
+        cfg.vmConfig.gc_mark_threads = std::stoul(argv[++i]);
     } else if (arg == "--max-call-depth") {
       if (i + 1 < argc)
         cfg.vmConfig.max_call_depth = std::stoul(argv[++i]);
@@ -1733,6 +1736,9 @@ LaunchConfig HavelLauncher::parseArgs(int argc, char *argv[]) {
       if (i + 1 < argc)
         cfg.vmConfig.goroutine_hotkey_tick_instructions =
             std::stoull(argv[++i]);
+    } else if (arg == "--tick-micros") {
+      if (i + 1 < argc)
+        cfg.vmConfig.goroutine_tick_micros = std::stoull(argv[++i]);
     } else if (arg == "--tier1-threshold") {
       if (i + 1 < argc)
         cfg.vmConfig.tier1_threshold = std::stoull(argv[++i]);
@@ -1885,9 +1891,10 @@ Modes:
 VM Configuration:
   --heap-max <bytes>     --gc-budget <n>      --gc-incremental
   --gc-stop-the-world    --gc-full-interval   --gc-promotion-age
+  --gc-mark-threads
   --max-call-depth       --max-instructions   --tick-instructions
   --hotkey-tick-instructions --tier1-threshold  --tier2-threshold
-  --tiering              --timer-interval
+  --tick-micros          --tiering            --timer-interval
 )" << std::flush;
 }
 
@@ -48,6 +48,7 @@ public:
     void UngrabAllDevices() override;
 
     int GetPollFd() const override;
+    std::vector<int> GetInputFds() const override;
     bool PollEvents(int timeoutMs) override;
     void SetExternalWakeupFd(int fd) override {
         std::lock_guard<std::mutex> lock(externalWakeupFdsMutex_);
@@ -472,6 +473,16 @@ int EvdevAdapter::GetPollFd() const {
     return shutdownFd_;
 }
 
+std::vector<int> EvdevAdapter::GetInputFds() const {
+    std::vector<int> fds;
+    std::lock_guard<std::recursive_mutex> lock(devicesMutex_);
+    fds.reserve(devices_.size());
+    for (const auto &dev : devices_) {
+        if (dev.fd >= 0) fds.push_back(dev.fd);
+    }
+    return fds;
+}
+
 bool EvdevAdapter::PollEvents(int timeoutMs) {
     static std::atomic<bool> firstPoll{true};
     if (firstPoll.exchange(false)) {
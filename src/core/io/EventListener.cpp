@@ -551,6 +551,8 @@ void EventListener::PumpOnce() {
   if (executionEngine) {
     if (modules_)
       modules_->checkTimers();
+    if (backend_)
+      executionEngine->setPreemptFds(backend_->GetInputFds());
     executionEngine->executeFrame();
 
     auto *vm = executionEngine->getVM();
@@ -595,6 +597,8 @@ void EventListener::EventLoop() {
     if (executionEngine) {
       if (modules_)
         modules_->checkTimers();
+      if (backend_)
+        executionEngine->setPreemptFds(backend_->GetInputFds());
       executionEngine->executeFrame();
 
       auto *vm = executionEngine->getVM();
@@ -108,6 +108,14 @@ public:
     virtual int GetPollFd() const = 0;
     virtual bool PollEvents(int timeoutMs = 100) = 0;
 
+    // Fds that turn readable when input arrives. The execution engine polls
+    // these (zero timeout) to end a goroutine quantum early so input is
+    // handled promptly. Backends with one connection fd keep the default.
+    virtual std::vector<int> GetInputFds() const {
+        int fd = GetPollFd();
+        return fd >= 0 ? std::vector<int>{fd} : std::vector<int>{};
+    }
+
     // Register an external fd whose readiness should break an in-progress blocking
     // PollEvents() wait (e.g. the VM scheduler's deferred-wakeup eventfd). The fd is
     // only observed for readiness, never drained or closed by the backend.
@@ -538,62 +538,23 @@ uint64_t havel_vm_collection_get_raw(void* vm_ptr, uint64_t container_bits, uint
   }
 
   if (container.isSetId()) {
-    auto key = vm->resolveKeyPublic(key_val);
-    if (!key) return Value::makeBool(false).rawBits();
-    auto* set = vm->getHeap().set(container.asSetId());
-    if (!set) return Value::makeBool(false).rawBits();
-    return Value::makeBool(set->find(*key) != set->end()).rawBits();
+    return Value::makeBool(vm->setHas(container.asSetId(), key_val)).rawBits();
   }
 
   if (container.isStringId() || container.isStringValId()) {
     auto index = indexFromRaw(key_val);
     if (!index) return Value::makeNull().rawBits();
-    std::string s;
-    if (container.isStringId()) {
-      auto *sp = vm->getHeap().string(container.asStringId());
-      if (sp) s = *sp;
-    } else if (container.isStringValId() && vm->getCurrentChunk()) {
-      s = vm->getCurrentChunk()->getString(container.asStringValId());
-    }
-    int64_t numCodepoints = 0;
-    size_t bytePos = 0;
-    while (bytePos < s.size()) {
-      unsigned char c = static_cast<unsigned char>(s[bytePos]);
-      size_t cpLen = 1;
-      if (c < 0x80) cpLen = 1;
-      else if ((c & 0xE0) == 0xC0) cpLen = 2;
-      else if ((c & 0xF0) == 0xE0) cpLen = 3;
-      else if ((c & 0xF8) == 0xF0) cpLen = 4;
-      if (bytePos + cpLen > s.size()) cpLen = 1;
-      numCodepoints++;
-      bytePos += cpLen;
-    }
+    const std::string *sp = vm->getStringPtr(container);
+    const std::string_view s = sp ? std::string_view(*sp) : std::string_view{};
+    Utf8Index scratch;
+    const Utf8Index &cps = vm->utf8Index(container, scratch);
+    const int64_t numCodepoints = static_cast<int64_t>(cps.length());
     int64_t idx = *index;
     if (idx < 0) idx = numCodepoints + idx;
     if (idx < 0 || idx >= numCodepoints) return Value::makeNull().rawBits();
-    size_t targetByte = 0;
-    int64_t cpIdx = 0;
-    while (cpIdx < idx && targetByte < s.size()) {
-      unsigned char c = static_cast<unsigned char>(s[targetByte]);
-      size_t cpLen = 1;
-      if (c < 0x80) cpLen = 1;
-      else if ((c & 0xE0) == 0xC0) cpLen = 2;
-      else if ((c & 0xF0) == 0xE0) cpLen = 3;
-      else if ((c & 0xF8) == 0xF0) cpLen = 4;
-      if (targetByte + cpLen > s.size()) cpLen = 1;
-      targetByte += cpLen;
-      cpIdx++;
-    }
-    size_t cpLen = 1;
-    if (targetByte < s.size()) {
-      unsigned char c = static_cast<unsigned char>(s[targetByte]);
-      if (c < 0x80) cpLen = 1;
-      else if ((c & 0xE0) == 0xC0) cpLen = 2;
-      else if ((c & 0xF0) == 0xE0) cpLen = 3;
-      else if ((c & 0xF8) == 0xF0) cpLen = 4;
-      if (targetByte + cpLen > s.size()) cpLen = 1;
-    }
-    auto ref = vm->getHeap().allocateString(s.substr(targetByte, cpLen));
+    const size_t targetByte = cps.byteOffset(s, static_cast<size_t>(idx));
+    const size_t cpLen = Utf8Index::sequenceLength(s, targetByte);
+    auto ref = vm->getHeap().internString(s.substr(targetByte, cpLen));
     return Value::makeStringId(ref.id).rawBits();
   }
 
@@ -1220,23 +1181,7 @@ uint64_t havel_vm_string_concat(void* vm_ptr, uint64_t l_bits, uint64_t r_bits)
     return Value::makeNull().rawBits();
   }
   
-  std::string lStr, rStr;
-  if (l.isStringId()) {
-    auto* strPtr = vm->getHeap().string(l.asStringId());
-    lStr = strPtr ? *strPtr : "";
-  } else {
-    lStr = chunk->getString(l.asStringValId());
-  }
-  if (r.isStringId()) {
-    auto* strPtr = vm->getHeap().string(r.asStringId());
-    rStr = strPtr ? *strPtr : "";
-  } else {
-    rStr = chunk->getString(r.asStringValId());
-  }
-  
-  std::string result = lStr + rStr;
-  auto ref = vm->createRuntimeString(std::move(result));
-  return Value::makeStringId(ref.id).rawBits();
+  return vm->concatStrings(l, r).rawBits();
 }
 
 // Bitwise operations (only valid for int48 values)
@@ -1426,24 +1371,12 @@ uint64_t havel_vm_closure_new(void* vm_ptr, uint32_t func_index) {
 
  auto& mainChunk = vm->getMainChunk();
  if (mainChunk && chunk != mainChunk.get()) {
-     closure.module_globals = std::make_shared<std::unordered_map<std::string, Value>>(vm->getGlobals());
+     closure.module_globals = std::make_shared<GlobalTable>(vm->getGlobals());
  }
 
     for (const auto& descriptor : target->upvalues) {
         if (descriptor.captures_local) {
-            uint32_t abs = vm->toAbsoluteLocalPublic(descriptor.index);
-            auto& open_uv = vm->openUpvaluesPublic();
-            auto open_it = open_uv.find(abs);
-            if (open_it == open_uv.end()) {
-                auto cell = std::make_shared<GCHeap::UpvalueCell>();
-                cell->is_open = true;
-                cell->open_index = descriptor.index;
-                cell->locals_base = static_cast<uint32_t>(vm->currentLocalsBasePublic());
-                open_uv.emplace(abs, cell);
-                closure.upvalues.push_back(std::move(cell));
-            } else {
-                closure.upvalues.push_back(open_it->second);
-            }
+            closure.upvalues.push_back(vm->captureLocalPublic(descriptor.index));
         } else {
             auto* parent_closure = vm->currentClosurePublic();
             if (!parent_closure || descriptor.index >= parent_closure->upvalues.size())
@@ -1614,16 +1547,11 @@ uint64_t havel_vm_set_set(void* vm_ptr, uint64_t set_bits, uint64_t val_bits, ui
   std::memcpy(&val, &val_bits, sizeof(uint64_t));
   std::memcpy(&key, &key_bits, sizeof(uint64_t));
   if (!setVal.isSetId()) return Value::makeNull().rawBits();
-  auto* s = vm->getHeap().set(setVal.asSetId());
-  if (!s) return Value::makeNull().rawBits();
-  auto k = vm->resolveKeyPublic(key);
-  if (!k) return Value::makeNull().rawBits();
-  if (s->find(*k) != s->end()) {
-    (*s)[*k] = val;
+  if (vm->toBoolPublic(val)) {
+    vm->setAdd(setVal.asSetId(), key);
   } else {
-    s->erase(*k);
+    vm->setRemove(setVal.asSetId(), key);
   }
-  vm->getHeap().bumpSetVersion(setVal.asSetId());
   return Value::makeNull().rawBits();
 }
 
@@ -1634,12 +1562,7 @@ uint64_t havel_vm_set_del(void* vm_ptr, uint64_t set_bits, uint64_t key_bits) {
     std::memcpy(&setVal, &set_bits, sizeof(uint64_t));
     std::memcpy(&key, &key_bits, sizeof(uint64_t));
     if (!setVal.isSetId()) return Value::makeBool(false).rawBits();
-    auto* s = vm->getHeap().set(setVal.asSetId());
-    if (!s) return Value::makeBool(false).rawBits();
-  auto k = vm->resolveKeyPublic(key);
-  if (!k) return Value::makeBool(false).rawBits();
-  s->erase(*k);
-  vm->getHeap().bumpSetVersion(setVal.asSetId());
+  vm->setRemove(setVal.asSetId(), key);
   return Value::makeNull().rawBits();
 }
 
@@ -3352,7 +3275,7 @@ else if (op == OpCode::INT_DIV) {
         const auto &instr = func.instructions[ip];
         const TypeFeedback* fb = (ip < func.type_feedback.size()) ? &func.type_feedback[ip] : nullptr;
 
-        switch (instr.opcode) {
+        switch (unfusedOpcode(instr.opcode)) {
         case OpCode::LOAD_CONST: {
             uint64_t bits; std::memcpy(&bits, &func.constants[instr.operands[0].asInt()], 8);
             vstack.push_back(llvm::ConstantInt::get(i64, bits));
@@ -5210,7 +5133,7 @@ case OpCode::LENGTH: {
         break;
 
     case OpCode::CALL_METHOD: {
-        if (instr.operands.size() != 2 || !instr.operands[0].isStringValId() || !instr.operands[1].isInt()) {
+        if (instr.operands.size() < 2 || !instr.operands[0].isStringValId() || !instr.operands[1].isInt()) {
             vstack.push_back(makeNull());
             break;
         }
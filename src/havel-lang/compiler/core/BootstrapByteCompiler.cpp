@@ -507,22 +507,32 @@ leaveFunction();
   return std::move(chunk);
 }
 
-void ByteCompiler::emit(OpCode op) { emit(op, std::vector<Value>{}); }
+void ByteCompiler::emit(OpCode op) { emit(op, OperandList{}); }
 
 void ByteCompiler::emit(OpCode op, Value operand) {
-  emit(op, std::vector<Value>{std::move(operand)});
+  emit(op, OperandList{operand});
 }
 
-void ByteCompiler::emit(OpCode op, std::vector<Value> operands) {
+void ByteCompiler::emit(OpCode op, OperandList operands) {
 if (!current_function) {
 COMPILER_THROW(
 "Attempted to emit bytecode without active function");
 }
+	// Give each global access site its own inline-cache slot (operand 1).
+	if ((op == OpCode::LOAD_GLOBAL || op == OpCode::STORE_GLOBAL) &&
+			operands.size() == 1 && operands[0].isStringValId()) {
+		operands.push_back(Value::makeInt(
+				static_cast<int64_t>(current_function->global_cache_slots++)));
+	}
+	// ...and each property access / method call site one for its shape cache.
+	if (((op == OpCode::OBJECT_GET || op == OpCode::OBJECT_SET) && operands.empty()) ||
+			(op == OpCode::CALL_METHOD && operands.size() == 2)) {
+		operands.push_back(Value::makeInt(
+				static_cast<int64_t>(current_function->property_cache_slots++)));
+	}
 	current_function->instructions.emplace_back(op, std::move(operands));
-	current_function->instruction_locations.push_back(
+	current_function->line_table.append(
 			current_source_location_.value_or(SourceLocation{}));
-	auto &instr = current_function->instructions.back();
-	instr.location = current_source_location_;
 }
 
 uint32_t ByteCompiler::addConstant(const Value &value) {
@@ -1663,7 +1673,7 @@ case ast::NodeType::LetDeclaration: {
             emit(OpCode::DUP);
             auto storeGlobalOp = let.isConst ? OpCode::STORE_IMMUT_GLOBAL : OpCode::STORE_GLOBAL;
             emit(storeGlobalOp,
-                std::vector<Value>{Value::makeStringValId(addStringConstant(identifier->symbol))});
+                OperandList{Value::makeStringValId(addStringConstant(identifier->symbol))});
             uint32_t storeIp = current_function->instructions.size();
             auto storeVarOp = let.isConst ? OpCode::STORE_IMMUT_VAR : OpCode::STORE_VAR;
             emit(storeVarOp, slot);
@@ -1736,7 +1746,7 @@ COMPILER_THROW("Tuple destructuring currently supports "
             if (lexical_resolution_.global_variables.count(element_id->symbol) > 0) {
                 auto sgOp = let.isConst ? OpCode::STORE_IMMUT_GLOBAL : OpCode::STORE_GLOBAL;
                 emit(sgOp,
-                    std::vector<Value>{Value::makeStringValId(addStringConstant(element_id->symbol))});
+                    OperandList{Value::makeStringValId(addStringConstant(element_id->symbol))});
             } else {
                 auto svOp = let.isConst ? OpCode::STORE_IMMUT_VAR : OpCode::STORE_VAR;
                 emit(svOp, slot);
@@ -1764,7 +1774,7 @@ reserveLocalSlot(slot);
         if (lexical_resolution_.global_variables.count(element_id->symbol) > 0) {
                 auto sgOp = let.isConst ? OpCode::STORE_IMMUT_GLOBAL : OpCode::STORE_GLOBAL;
                 emit(sgOp,
-                    std::vector<Value>{Value::makeStringValId(addStringConstant(element_id->symbol))});
+                    OperandList{Value::makeStringValId(addStringConstant(element_id->symbol))});
             } else {
                 auto svOp = let.isConst ? OpCode::STORE_IMMUT_VAR : OpCode::STORE_VAR;
                 emit(svOp, slot);
@@ -1808,7 +1818,7 @@ reserveLocalSlot(slot);
             emit(OpCode::OBJECT_GET);
             auto sgOp = let.isConst ? OpCode::STORE_IMMUT_GLOBAL : OpCode::STORE_GLOBAL;
             emit(sgOp,
-                std::vector<Value>{Value::makeStringValId(addStringConstant(alias->symbol))});
+                OperandList{Value::makeStringValId(addStringConstant(alias->symbol))});
         } else {
             const uint32_t slot = declarationSlot(*alias);
             reserveLocalSlot(slot);
@@ -2638,7 +2648,7 @@ void ByteCompiler::compileTryStatement(const ast::TryExpression &statement) {
   // Emit TRY_ENTER with placeholder operands (catch_ip and finally_ip patched
   // later)
   emit(OpCode::TRY_ENTER,
-       std::vector<Value>{
+       OperandList{
            static_cast<uint32_t>(0), // catch_ip - patched later
            static_cast<uint32_t>(
                0) // finally_ip - patched later (0 if no finally)
@@ -3056,7 +3066,7 @@ void ByteCompiler::compilePattern(const ast::Expression &pattern, uint32_t discS
       uint32_t methodSid = addStringConstant("match");
       emit(OpCode::LOAD_VAR, discSlot);
       compileExpression(pattern);
-      emit(OpCode::CALL_METHOD, std::vector<Value>{
+      emit(OpCode::CALL_METHOD, OperandList{
         Value::makeStringValId(methodSid), Value::makeInt(1)
       });
       emit(OpCode::IS_NULL);
@@ -3319,7 +3329,7 @@ for (const auto &entry : object.pairs) {
  // obj is the receiver, source is the arg for extend
  compileExpression(*entry.value); // [obj, source]
  uint32_t method_sid = addStringConstant("extend");
- emit(OpCode::CALL_METHOD, std::vector<Value>{
+ emit(OpCode::CALL_METHOD, OperandList{
  Value::makeStringValId(method_sid),
  Value(static_cast<uint32_t>(1))});
  } else if (entry.isComputedKey) {
@@ -3744,7 +3754,7 @@ case ast::NodeType::AtExpression: {
             compileExpression(*binary.left); // value (arg)
             in_tail_position_ = saved_tail;
             uint32_t method_sid = addStringConstant("has");
-            emit(OpCode::CALL_METHOD, std::vector<Value>{
+            emit(OpCode::CALL_METHOD, OperandList{
                 Value::makeStringValId(method_sid),
                 Value(static_cast<uint32_t>(1))});
             if (binary.operator_ == ast::BinaryOperator::NotIn) {
@@ -3981,7 +3991,7 @@ case ast::NodeType::CastExpression: {
           // Method call on piped value: value.trim(), value.len(), etc.
           emit(OpCode::LOAD_VAR, pipe_temp);
           uint32_t method_sid = addStringConstant(ident.symbol);
-          emit(OpCode::CALL_METHOD, std::vector<Value>{
+          emit(OpCode::CALL_METHOD, OperandList{
               Value::makeStringValId(method_sid),
               Value(static_cast<uint32_t>(0))});
         }
@@ -4143,7 +4153,7 @@ case ast::NodeType::CastExpression: {
         if (assignment.isGlobalScope) {
           emit(OpCode::DUP);
           emit(OpCode::STORE_GLOBAL,
-               std::vector<Value>{Value::makeStringValId(addStringConstant(target_id->symbol))});
+               OperandList{Value::makeStringValId(addStringConstant(target_id->symbol))});
           break;
         }
 
@@ -4350,7 +4360,7 @@ auto emitCompound = [&](OpCode math_op) {
                 compileExpression(*rhs_expr);
             }
             // CALL_METHOD pops arg_count args + receiver, pushes result
-            { uint32_t _sid = addStringConstant(inplace_method); emit(OpCode::CALL_METHOD, std::vector<Value>{ Value::makeStringValId(_sid), Value::makeInt(1) }); }
+            { uint32_t _sid = addStringConstant(inplace_method); emit(OpCode::CALL_METHOD, OperandList{ Value::makeStringValId(_sid), Value::makeInt(1) }); }
 
             // JUMP_IF_NULL pops the value, so DUP first to preserve it
             emit(OpCode::DUP);
@@ -4363,9 +4373,10 @@ auto emitCompound = [&](OpCode math_op) {
             emitLoadIdentifier(*binding);
             uint32_t end_jump = emitJump(OpCode::JUMP);
 
-            // Fallback: JUMP_IF_NULL popped the DUP'd null, stack is empty
-            // Do the desugared form: load + op + store
+            // Fallback: JUMP_IF_NULL popped the DUP'd null; pop the original
+            // null result too, then do the desugared form: load + op + store
             patchJump(fallback_jump, static_cast<uint32_t>(current_function->instructions.size()));
+            emit(OpCode::POP);
             emitLoadIdentifier(*binding);
             if (rhs_is_missing) {
                 emit(OpCode::LOAD_CONST, addConstant(Value::makeNull()));
@@ -5104,7 +5115,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
                 ++totalArgs;
             }
 		emit(OpCode::STRUCT_NEW,
-		     std::vector<Value>{Value::makeStringValId(type_sid),
+		     OperandList{Value::makeStringValId(type_sid),
 		                        Value(totalArgs)});
 		in_tail_position_ = saved_tail_position;
 		return;
@@ -5340,7 +5351,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
          COMPILER_THROW("Dynamic spread with keyword arguments not supported yet");
      }
      { uint32_t _sid = addStringConstant(property->symbol);
-     emit(OpCode::CALL_METHOD_SPREAD, std::vector<Value>{
+     emit(OpCode::CALL_METHOD_SPREAD, OperandList{
          Value::makeStringValId(_sid),
          Value::makeInt(cm_lit_before),
          Value::makeInt(cm_lit_after)}); }
@@ -5387,7 +5398,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
 
 // Call method
               uint32_t method_sid = addStringConstant(property->symbol);
-              emit(OpCode::CALL_METHOD, std::vector<Value>{
+              emit(OpCode::CALL_METHOD, OperandList{
                   Value::makeStringValId(method_sid),
                   Value(totalArgs)});
               
@@ -5457,7 +5468,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
             COMPILER_THROW("Dynamic spread with keyword arguments not supported yet");
         }
         { uint32_t _sid = addStringConstant(property->symbol);
-        emit(OpCode::CALL_METHOD_SPREAD, std::vector<Value>{
+        emit(OpCode::CALL_METHOD_SPREAD, OperandList{
             Value::makeStringValId(_sid),
             Value::makeInt(cm_lit_before),
             Value::makeInt(cm_lit_after)}); }
@@ -5502,7 +5513,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
         totalArgs++;
     }
     uint32_t method_sid = addStringConstant(property->symbol);
-    emit(OpCode::CALL_METHOD, std::vector<Value>{
+    emit(OpCode::CALL_METHOD, OperandList{
         Value::makeStringValId(method_sid),
         Value(totalArgs)});
         
@@ -5550,7 +5561,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
         totalArgs++;
       }
       uint32_t method_sid = addStringConstant(fieldId->symbol);
-      emit(OpCode::CALL_METHOD, std::vector<Value>{
+      emit(OpCode::CALL_METHOD, OperandList{
         Value::makeStringValId(method_sid),
         Value(totalArgs)});
       in_tail_position_ = saved_tail_position;
@@ -5708,7 +5719,7 @@ if (expression.callee->kind == ast::NodeType::Identifier) {
             lit_after++;
         }
     }
-    emit(OpCode::CALL_SPREAD, std::vector<Value>{Value::makeInt(lit_before), Value::makeInt(lit_after)});
+    emit(OpCode::CALL_SPREAD, OperandList{Value::makeInt(lit_before), Value::makeInt(lit_after)});
     return;
   }
   if (in_tail_position_ && try_depth_ == 0) {
@@ -5786,7 +5797,7 @@ if (hasDynamicSpread) {
             lit_after++;
         }
     }
-    emit(OpCode::CALL_SPREAD, std::vector<Value>{Value::makeInt(lit_before), Value::makeInt(lit_after)});
+    emit(OpCode::CALL_SPREAD, OperandList{Value::makeInt(lit_before), Value::makeInt(lit_after)});
     return;
 }
 if (in_tail_position_ && try_depth_ == 0) {
@@ -5884,7 +5895,7 @@ if (in_tail_position_ && try_depth_ == 0) {
     if (totalDynamicSpreads > 1) {
       COMPILER_THROW("Multiple dynamic spread arguments not yet supported");
     }
-    emit(OpCode::CALL_SPREAD, std::vector<Value>{
+    emit(OpCode::CALL_SPREAD, OperandList{
         Value::makeInt(spreadStackValuesBefore),
         Value::makeInt(spreadStackValuesAfter)});
   } else {
@@ -6230,7 +6241,8 @@ void ByteCompiler::compileForStatement(const ast::ForStatement &statement) {
     // 1. Check "push" (arrays have it) -> use second
     // 2. Check "upper" (strings have it) -> use second
     // 3. Check "step" (ranges have it) -> use second
-    // 4. Otherwise (object/set) -> use first
+    // 4. Check "byteLength" (byte buffers have it) -> use second
+    // 5. Otherwise (object/set) -> use first
     
     // First check if it's an array (has "push")
     emit(OpCode::LOAD_VAR, iterableSlot);
@@ -6285,8 +6297,26 @@ void ByteCompiler::compileForStatement(const ast::ForStatement &statement) {
     // Jump to end
     uint32_t rangeEndJump = emitJump(OpCode::JUMP);
     
-    // Otherwise (object/set) - use first (key/element)
+    // Check if it's a byte buffer (has "byteLength")
     patchJump(isRangeJump, static_cast<uint32_t>(current_function->instructions.size()));
+    emit(OpCode::LOAD_VAR, iterableSlot);
+    { uint32_t _sid = addStringConstant("byteLength"); emit(OpCode::LOAD_CONST, addConstant(Value::makeStringValId(_sid))); };
+    emit(OpCode::OBJECT_GET);
+    
+    // If byteLength is not null, it's a byte buffer - use second
+    uint32_t isBytesJump = emitJump(OpCode::JUMP_IF_NULL);
+    
+    // Has byteLength (bytes) - get second (element)
+    emit(OpCode::LOAD_VAR, resultSlot);
+    { uint32_t _sid = addStringConstant("second"); emit(OpCode::LOAD_CONST, addConstant(Value::makeStringValId(_sid))); };
+    emit(OpCode::OBJECT_GET);
+    emit(OpCode::STORE_VAR, iterSlots[0]);
+    
+    // Jump to end
+    uint32_t bytesEndJump = emitJump(OpCode::JUMP);
+    
+    // Otherwise (object/set) - use first (key/element)
+    patchJump(isBytesJump, static_cast<uint32_t>(current_function->instructions.size()));
     emit(OpCode::LOAD_VAR, resultSlot);
     { uint32_t _sid = addStringConstant("first"); emit(OpCode::LOAD_CONST, addConstant(Value::makeStringValId(_sid))); };
     emit(OpCode::OBJECT_GET);
@@ -6295,6 +6325,7 @@ void ByteCompiler::compileForStatement(const ast::ForStatement &statement) {
     patchJump(endJump, static_cast<uint32_t>(current_function->instructions.size()));
     patchJump(stringEndJump, static_cast<uint32_t>(current_function->instructions.size()));
     patchJump(rangeEndJump, static_cast<uint32_t>(current_function->instructions.size()));
+    patchJump(bytesEndJump, static_cast<uint32_t>(current_function->instructions.size()));
   }
 
 // Execute body
@@ -7495,6 +7526,9 @@ void ByteCompiler::leaveFunction() {
 
     // Apply jump threading optimization
   optimizeJumps();
+  if (fuse_superinstructions_) {
+    fuseSuperinstructions();
+  }
 
   
     current_function->type_feedback.resize(current_function->instructions.size());
@@ -8802,6 +8836,66 @@ void ByteCompiler::optimizeJumps() {
   }
 }
 
+// Rewrite the head of common opcode sequences into superinstructions so the
+// threaded dispatcher runs the whole sequence behind one dispatch. The
+// catalogue comes from fallthrough pair counts over the smoke, stress,
+// integration and tests suites (HAVEL_OPCODE_PAIRS): local loads feeding
+// arithmetic and compare-and-branch, `x = expr` statements (DUP, STORE, POP),
+// constant-key property reads and constant/local returns. Runs after
+// optimizeJumps; covered instructions are left untouched, see OpCode.
+void ByteCompiler::fuseSuperinstructions() {
+  if (!current_function) {
+    return;
+  }
+
+  auto &code = current_function->instructions;
+  auto opAt = [&](size_t i) {
+    return i < code.size() ? code[i].opcode : OpCode::NOP;
+  };
+  auto isComparison = [](OpCode op) {
+    return op == OpCode::EQ || op == OpCode::NEQ || op == OpCode::LT ||
+           op == OpCode::LTE || op == OpCode::GT || op == OpCode::GTE;
+  };
+  auto isBinop = [&](OpCode op) {
+    return op == OpCode::ADD || op == OpCode::SUB || op == OpCode::MUL ||
+           isComparison(op);
+  };
+
+  size_t i = 0;
+  while (i < code.size()) {
+    OpCode fused = code[i].opcode;
+    switch (code[i].opcode) {
+    case OpCode::LOAD_VAR: {
+      const OpCode second = opAt(i + 1);
+      const bool const_rhs = second == OpCode::LOAD_CONST;
+      if (const_rhs || second == OpCode::LOAD_VAR) {
+        if (isComparison(opAt(i + 2)) && opAt(i + 3) == OpCode::JUMP_IF_FALSE) {
+          fused = const_rhs ? OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP
+                            : OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP;
+        } else if (isBinop(opAt(i + 2))) {
+          fused = const_rhs ? OpCode::LOAD_VAR_LOAD_CONST_BINOP
+                            : OpCode::LOAD_VAR_LOAD_VAR_BINOP;
+        }
+      }
+      break;
+    }
+    case OpCode::DUP:
+      if (opAt(i + 2) == OpCode::POP) {
+        if (opAt(i + 1) == OpCode::STORE_VAR) {
+          fused = OpCode::DUP_STORE_VAR_POP;
+        } else if (opAt(i + 1) == OpCode::STORE_GLOBAL) {
+          fused = OpCode::DUP_STORE_GLOBAL_POP;
+        }
+      }
+      break;
+    default:
+      break;
+    }
+    code[i].opcode = fused;
+    i += superinstructionLength(fused);
+  }
+}
+
 bool ByteCompiler::expressionContainsYield(const ast::Expression &expr) const {
  switch (expr.kind) {
  case ast::NodeType::YieldExpression:
@@ -100,6 +100,9 @@ public:
   void setSourceFile(const std::string& f) { source_file_ = f; }
   const std::string& sourceFile() const { return source_file_; }
 
+  // Off: functions keep the plain opcode sequences (tests compare the two).
+  void setFuseSuperinstructions(bool enabled) { fuse_superinstructions_ = enabled; }
+
   // Shadow helpers so COMPILER_THROW macro picks up member location
   uint32_t _compiler_err_line() const {
     return current_source_location_ ? current_source_location_->line : 0;
@@ -129,13 +132,14 @@ private:
 
 void emit(OpCode op);
 void emit(OpCode op, Value operand);
-void emit(OpCode op, std::vector<Value> operands);
+void emit(OpCode op, OperandList operands);
 uint32_t addConstant(const Value &value);
 uint32_t addStringConstant(const std::string &str);
 uint32_t emitJump(OpCode op);
 void patchJump(uint32_t jump_instruction_index, uint32_t target);
 
 void optimizeJumps();  // Jump threading optimization
+void fuseSuperinstructions();  // Peephole superinstruction fusion
 
   void compileFunction(const ast::FunctionDeclaration &function);
   void compileLambda(const ast::LambdaExpression &lambda);
@@ -306,6 +310,7 @@ std::unordered_map<const ast::FunctionDeclaration *, std::string> impl_method_ty
     // Error collection for linting
     bool collect_errors_ = false;
     bool has_error_ = false;
+    bool fuse_superinstructions_ = true;
     std::vector<CompilerError> errors_;
 
     TypeCheckResult type_check_result_;
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "../../core/Value.hpp"
+#include "../gc/ObjectShape.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -33,6 +39,13 @@ struct TypeFeedback {
     // AOT type hints from annotations (set at compile time)
     uint64_t aot_type_hint = 0;  // Type hint for result (e.g., TYPE_HINT_INT for "x: int")
     bool has_aot_hint = false;   // Whether we have a compile-time type hint
+
+    // Interpreter quickening state for the instruction at this index (see
+    // VM::noteQuickenSite). Unlike the masks above it is keyed by the
+    // instruction's own index.
+    uint16_t quicken_streak = 0;   // consecutive generic runs that fit quicken_candidate
+    uint8_t quicken_candidate = 0; // OpCode the site would be rewritten to
+    uint8_t quicken_misses = 0;    // guard misses; the site stays generic past a limit
 };
 
 
@@ -315,9 +328,96 @@ WAITGROUP_WAIT, // WaitGroup.wait(): block until counter == 0
     FORMAT_BASE64_ENCODE, FORMAT_BASE64_DECODE,
 
     CALL_IF_FUNCTION, // Call if value is callable (auto-call bare functions in statement/pipe)
-    NOP
+    NOP,
+
+    // Superinstructions (see ByteCompiler::fuseSuperinstructions). Only the
+    // head of a fused sequence is rewritten; the instructions it covers stay
+    // in place with their own operands, so jump targets, line tables and
+    // type feedback keep their indices and a jump into the middle of a
+    // sequence still runs the plain opcodes. Appended after NOP so opcode
+    // numbers in existing .hvc images don't move.
+    LOAD_VAR_LOAD_CONST_BINOP,    // LOAD_VAR, LOAD_CONST, arithmetic/comparison
+    LOAD_VAR_LOAD_VAR_BINOP,      // LOAD_VAR, LOAD_VAR, arithmetic/comparison
+    LOAD_VAR_LOAD_CONST_CMP_JUMP, // LOAD_VAR, LOAD_CONST, comparison, JUMP_IF_FALSE
+    LOAD_VAR_LOAD_VAR_CMP_JUMP,   // LOAD_VAR, LOAD_VAR, comparison, JUMP_IF_FALSE
+    DUP_STORE_VAR_POP,            // DUP, STORE_VAR, POP (local assignment statement)
+    DUP_STORE_GLOBAL_POP,         // DUP, STORE_GLOBAL, POP (global assignment statement)
+
+    // Quickened forms (see VM::execQuickened). The interpreter rewrites a
+    // generic ADD/SUB/LT/EQ/ARRAY_GET in place once the site has seen the
+    // same operand kinds for a while, and rewrites it back to the generic
+    // opcode on the first guard miss. Never emitted by the compiler and never
+    // written to .hvc images.
+    ADD_INT, ADD_NUM, ADD_STR,    // int48 + int48, mixed/f64 + f64, string + string
+    SUB_INT, SUB_NUM,
+    LT_INT, LT_NUM,
+    EQ_INT, EQ_NUM, EQ_STR,
+    ARRAY_GET_INT,                // array[int48]
 };
 
+// Number of instructions a superinstruction covers (1 for plain opcodes).
+constexpr uint32_t superinstructionLength(OpCode op) {
+    switch (op) {
+    case OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP:
+    case OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP:
+        return 4;
+    case OpCode::LOAD_VAR_LOAD_CONST_BINOP:
+    case OpCode::LOAD_VAR_LOAD_VAR_BINOP:
+    case OpCode::DUP_STORE_VAR_POP:
+    case OpCode::DUP_STORE_GLOBAL_POP:
+        return 3;
+    default:
+        return 1;
+    }
+}
+
+// The generic opcode a quickened instruction stands for.
+constexpr OpCode unquickenedOpcode(OpCode op) {
+    switch (op) {
+    case OpCode::ADD_INT:
+    case OpCode::ADD_NUM:
+    case OpCode::ADD_STR:
+        return OpCode::ADD;
+    case OpCode::SUB_INT:
+    case OpCode::SUB_NUM:
+        return OpCode::SUB;
+    case OpCode::LT_INT:
+    case OpCode::LT_NUM:
+        return OpCode::LT;
+    case OpCode::EQ_INT:
+    case OpCode::EQ_NUM:
+    case OpCode::EQ_STR:
+        return OpCode::EQ;
+    case OpCode::ARRAY_GET_INT:
+        return OpCode::ARRAY_GET;
+    default:
+        return op;
+    }
+}
+
+constexpr bool isQuickenedOpcode(OpCode op) {
+    return unquickenedOpcode(op) != op;
+}
+
+// The opcode a superinstruction head replaced. Anything that walks
+// instructions one at a time (the switch dispatcher, debugger stepping, the
+// JIT, bytecode analyses) goes through this and sees the original sequence.
+// Quickened instructions map back to their generic opcode as well.
+constexpr OpCode unfusedOpcode(OpCode op) {
+    switch (op) {
+    case OpCode::LOAD_VAR_LOAD_CONST_BINOP:
+    case OpCode::LOAD_VAR_LOAD_VAR_BINOP:
+    case OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP:
+    case OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP:
+        return OpCode::LOAD_VAR;
+    case OpCode::DUP_STORE_VAR_POP:
+    case OpCode::DUP_STORE_GLOBAL_POP:
+        return OpCode::DUP;
+    default:
+        return unquickenedOpcode(op);
+    }
+}
+
 struct ClosureRef {
   uint32_t id = 0;
 };
@@ -350,6 +450,10 @@ struct RangeRef {
   uint32_t id = 0;
 };
 
+struct BytesRef {
+  uint32_t id = 0;
+};
+
 // Struct: compact field storage (fields stored as array, type info separate)
 struct StructRef {
   uint32_t id = 0;     // GC object id for the field array
@@ -411,6 +515,17 @@ struct ChannelRef {
 using BytecodeHostFunction =
     std::function<Value(const std::vector<Value> &)>;
 
+// Fast-call host ABI: the VM hands the callee a view of the arguments (copied
+// off its operand stack into a fixed buffer) instead of building a vector.
+using HostArgs = std::span<const Value>;
+using HostFastFunction = std::function<Value(HostArgs)>;
+
+// One slot of the VM's host function table, indexed by HostFuncId.
+struct HostFunctionEntry {
+  HostFastFunction call;
+  int32_t arity = -1; // checked by the VM before the call; -1 = any count
+};
+
 struct SourceLocation {
   std::string filename;
   uint32_t line = 0;
@@ -418,28 +533,300 @@ struct SourceLocation {
   uint32_t length = 0;
 };
 
-// Bytecode instruction
+// Operand storage for a single instruction. Every opcode the compiler emits
+// takes at most kInlineCapacity operands, which live inline so the code array
+// of a function is one contiguous block and operand fetch never leaves the
+// instruction's cache line. Longer lists (only reachable through the bytecode
+// builder module) spill to the heap.
+class OperandList {
+public:
+  static constexpr uint32_t kInlineCapacity = 3;
+
+  OperandList() noexcept : size_(0), capacity_(kInlineCapacity) {}
+  OperandList(std::initializer_list<Value> values) : OperandList() {
+    reserve(values.size());
+    for (const auto &value : values) push_back(value);
+  }
+  OperandList(const std::vector<Value> &values) : OperandList() {
+    reserve(values.size());
+    for (const auto &value : values) push_back(value);
+  }
+  OperandList(const OperandList &other) : OperandList() {
+    reserve(other.size_);
+    for (const auto &value : other) push_back(value);
+  }
+  OperandList(OperandList &&other) noexcept : OperandList() { swap(other); }
+  OperandList &operator=(const OperandList &other) {
+    if (this != &other) {
+      OperandList copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+  OperandList &operator=(OperandList &&other) noexcept {
+    if (this != &other) {
+      OperandList moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+  ~OperandList() {
+    if (!isInline()) delete[] heap_;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  Value *data() { return isInline() ? inline_ : heap_; }
+  const Value *data() const { return isInline() ? inline_ : heap_; }
+  Value &operator[](size_t index) { return data()[index]; }
+  const Value &operator[](size_t index) const { return data()[index]; }
+  Value &front() { return data()[0]; }
+  const Value &front() const { return data()[0]; }
+  Value &back() { return data()[size_ - 1]; }
+  const Value &back() const { return data()[size_ - 1]; }
+  Value *begin() { return data(); }
+  Value *end() { return data() + size_; }
+  const Value *begin() const { return data(); }
+  const Value *end() const { return data() + size_; }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) return;
+    Value *grown = new Value[capacity];
+    for (uint32_t i = 0; i < size_; ++i) grown[i] = data()[i];
+    if (!isInline()) delete[] heap_;
+    heap_ = grown;
+    capacity_ = static_cast<uint32_t>(capacity);
+  }
+  void push_back(const Value &value) {
+    if (size_ == capacity_) reserve(static_cast<size_t>(capacity_) * 2);
+    data()[size_++] = value;
+  }
+  void clear() { size_ = 0; }
+
+  void swap(OperandList &other) noexcept {
+    if (isInline() || other.isInline()) {
+      // Inline payloads cannot be pointer-swapped; exchange via a temporary.
+      OperandList *a = this;
+      OperandList *b = &other;
+      Value tmp_inline[kInlineCapacity];
+      Value *tmp_heap = nullptr;
+      if (a->isInline()) {
+        for (uint32_t i = 0; i < a->size_; ++i) tmp_inline[i] = a->inline_[i];
+      } else {
+        tmp_heap = a->heap_;
+      }
+      if (b->isInline()) {
+        for (uint32_t i = 0; i < b->size_; ++i) a->inline_[i] = b->inline_[i];
+      } else {
+        a->heap_ = b->heap_;
+      }
+      if (tmp_heap) {
+        b->heap_ = tmp_heap;
+      } else {
+        for (uint32_t i = 0; i < a->size_; ++i) b->inline_[i] = tmp_inline[i];
+      }
+    } else {
+      std::swap(heap_, other.heap_);
+    }
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+private:
+  bool isInline() const { return capacity_ <= kInlineCapacity; }
+
+  uint32_t size_;
+  uint32_t capacity_;
+  union {
+    Value inline_[kInlineCapacity];
+    Value *heap_;
+  };
+};
+
+// Bytecode instruction: opcode plus inline operands. Source locations are not
+// stored per instruction; they live in the owning function's LineTable.
 struct Instruction {
   OpCode opcode;
-  std::vector<Value> operands;
-  std::optional<SourceLocation> location;
+  OperandList operands;
 
   Instruction() : opcode(OpCode::NOP) {}
-  Instruction(OpCode op, std::vector<Value> ops = {})
+  Instruction(OpCode op, OperandList ops = {})
       : opcode(op), operands(std::move(ops)) {}
 };
 
+static_assert(sizeof(Instruction) <= 40,
+              "Instruction should stay a compact fixed-width record");
+
+// Run-length encoded map from instruction index to source location. A new
+// entry is recorded only when the location changes, so a statement that
+// expands to a dozen instructions costs a single entry. Looked up on errors,
+// stack traces and by the debugger, never on the dispatch path.
+class LineTable {
+public:
+  struct Entry {
+    uint32_t start_ip = 0;
+    uint32_t line = 0;
+    uint32_t column = 0;
+    uint32_t length = 0;
+    uint32_t file = 0; // index into files_
+  };
+
+  // Record the location of the next instruction.
+  void append(const SourceLocation &location) {
+    const uint32_t file = internFile(location.filename);
+    if (entries_.empty() || entries_.back().line != location.line ||
+        entries_.back().column != location.column ||
+        entries_.back().length != location.length ||
+        entries_.back().file != file) {
+      entries_.push_back(Entry{instruction_count_, location.line,
+                               location.column, location.length, file});
+    }
+    ++instruction_count_;
+  }
+
+  SourceLocation lookup(size_t ip) const {
+    if (ip >= instruction_count_ || entries_.empty()) return {};
+    auto it = std::upper_bound(
+        entries_.begin(), entries_.end(), ip,
+        [](size_t target, const Entry &e) { return target < e.start_ip; });
+    const Entry &entry = *std::prev(it);
+    return SourceLocation{files_[entry.file], entry.line, entry.column,
+                          entry.length};
+  }
+
+  // Closest preceding location with a real line number; ip is clamped to
+  // the last instruction. Synthetic instructions (implicit returns, jump
+  // pads) carry no location and report the statement before them.
+  SourceLocation nearest(size_t ip) const {
+    if (entries_.empty()) return {};
+    ip = std::min<size_t>(ip, instruction_count_ - 1);
+    auto it = std::upper_bound(
+        entries_.begin(), entries_.end(), ip,
+        [](size_t target, const Entry &e) { return target < e.start_ip; });
+    while (it != entries_.begin()) {
+      --it;
+      if (it->line > 0) {
+        return SourceLocation{files_[it->file], it->line, it->column,
+                              it->length};
+      }
+    }
+    return {};
+  }
+
+  // Number of instructions covered (matches instructions.size()).
+  size_t size() const { return instruction_count_; }
+  bool empty() const { return instruction_count_ == 0; }
+  const std::vector<Entry> &entries() const { return entries_; }
+
+private:
+  uint32_t internFile(const std::string &filename) {
+    for (uint32_t i = 0; i < files_.size(); ++i) {
+      if (files_[i] == filename) return i;
+    }
+    files_.push_back(filename);
+    return static_cast<uint32_t>(files_.size() - 1);
+  }
+
+  std::vector<Entry> entries_;
+  std::vector<std::string> files_;
+  uint32_t instruction_count_ = 0;
+};
+
 
 struct UpvalueDescriptor {
   uint32_t index = 0;
   bool captures_local = false;
 };
 
+// Resolution of one LOAD_GLOBAL/STORE_GLOBAL site. Valid while the VM's
+// globals table still has the epoch recorded here (see GlobalTable).
+struct GlobalCacheEntry {
+  uint64_t epoch = 0;                  // 0 = never filled
+  Value *slot = nullptr;               // value node in globals; null for host hits
+  const std::string *name = nullptr;   // key owned by the table that resolved it
+  Value host_value;                    // host function, when slot is null
+  uint64_t host_version = 0;           // VM host-globals version at fill time
+  uint32_t checked_object = UINT32_MAX; // object id known not to be a lazy proxy
+};
+
+class BytecodeChunk;
+
+// Inline cache for one OBJECT_GET/OBJECT_SET/CALL_METHOD site, in the
+// spirit of FastVM's PolymorphicInlineCache but keyed on object shapes:
+// each way remembers a receiver layout and where the property (or method)
+// was found, so a hit is a shape compare plus indexed loads. Once kMaxWays
+// layouts are in use the site is megamorphic and stops filling; it keeps
+// probing the ways it has.
+struct PropertyInlineCache {
+  static constexpr size_t kMaxWays = 4;
+  // Prototype links a way can follow (__proto/__class/__struct/__parent).
+  static constexpr size_t kMaxDepth = 3;
+  enum class State : uint8_t { Empty, Monomorphic, Polymorphic, Megamorphic };
+
+  // CALL_METHOD resolution flags.
+  static constexpr uint8_t kHostMethod = 1 << 0;    // host_index, else the slot's function
+  static constexpr uint8_t kInstanceFunc = 1 << 1;  // called without self
+  static constexpr uint8_t kViaModule = 1 << 2;     // receiver is a module in globals
+  static constexpr uint8_t kTypePrototype = 1 << 3; // prototypes_ hit for the receiver type
+  static constexpr uint8_t kNoMethod = 1 << 4;      // primitive type has no such method (`x += 1` probes)
+
+  struct Way {
+    std::shared_ptr<ObjectShape> shape;  // receiver layout; null for primitives
+    uint64_t key_bits = 0;               // OBJECT_GET/SET constant key
+    const BytecodeChunk *key_chunk = nullptr; // string table the key indexes
+    uint32_t slot = ObjectShape::kNotFound;       // slot in the holder
+    uint32_t class_slot = ObjectShape::kNotFound; // receiver __class; a string there means accessors
+    uint8_t depth = 0;                   // links followed from receiver to holder
+    std::array<uint32_t, kMaxDepth> link_slots{};
+    std::array<std::shared_ptr<ObjectShape>, kMaxDepth> link_shapes;
+    std::shared_ptr<ObjectShape> transition; // OBJECT_SET adding the key: layout after
+    // CALL_METHOD
+    uint8_t receiver_tag = 0;            // primitive receiver type, for kTypePrototype
+    uint8_t flags = 0;
+    uint32_t host_index = 0;
+    uint64_t method_bits = 0;            // method value at fill time
+    uint64_t epoch = 0;                  // prototype table or globals epoch
+    // kNoMethod: globals epoch, and the globals nodes named after the type
+    // (which must not become objects holding patched-in methods)
+    uint64_t globals_epoch = 0;
+    std::array<const Value *, 2> type_globals{};
+    const Value *module_slot = nullptr;  // globals node holding the module (kViaModule)
+  };
+
+  std::array<Way, kMaxWays> ways;
+  uint8_t count = 0;
+  State state = State::Empty;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+
+  bool megamorphic() const { return state == State::Megamorphic; }
+
+  // Record a resolution. A way for the same receiver and key is replaced;
+  // a new one past kMaxWays turns the site megamorphic instead.
+  void add(Way way) {
+    for (uint8_t i = 0; i < count; ++i) {
+      Way &existing = ways[i];
+      if (existing.shape == way.shape && existing.key_bits == way.key_bits &&
+          existing.receiver_tag == way.receiver_tag) {
+        existing = std::move(way);
+        return;
+      }
+    }
+    if (count == kMaxWays) {
+      state = State::Megamorphic;
+      return;
+    }
+    ways[count++] = std::move(way);
+    state = count == 1 ? State::Monomorphic : State::Polymorphic;
+  }
+};
+
 // Bytecode function
 struct BytecodeFunction {
   std::string name;
   std::vector<Instruction> instructions;
-  std::vector<SourceLocation> instruction_locations;
+  LineTable line_table;
   std::vector<Value> constants;
   std::vector<UpvalueDescriptor> upvalues;
   uint32_t param_count;
@@ -458,6 +845,14 @@ struct BytecodeFunction {
   
   
   mutable std::vector<TypeFeedback> type_feedback;
+  // Inline caches for LOAD_GLOBAL/STORE_GLOBAL. The compiler numbers each
+  // global access site (operand 1); the VM sizes global_cache on first use.
+  uint32_t global_cache_slots = 0;
+  mutable std::vector<GlobalCacheEntry> global_cache;
+  // Inline caches for OBJECT_GET/OBJECT_SET (operand 0) and CALL_METHOD
+  // (operand 2), numbered the same way.
+  uint32_t property_cache_slots = 0;
+  mutable std::vector<PropertyInlineCache> property_cache;
   mutable uint32_t execution_count = 0;
   mutable bool jit_compiled = false;
 
@@ -514,11 +909,12 @@ public:
   }
 
   uint32_t addString(std::string str) {
-    for (uint32_t i = 0; i < strings.size(); i++) {
-      if (strings[i] == str) return i;
-    }
+    auto it = string_indices.find(str);
+    if (it != string_indices.end()) return it->second;
+    const auto index = static_cast<uint32_t>(strings.size());
+    string_indices.emplace(str, index);
     strings.push_back(std::move(str));
-    return static_cast<uint32_t>(strings.size() - 1);
+    return index;
   }
 
   const std::string& getString(uint32_t index) const {
@@ -531,6 +927,7 @@ public:
 
 private:
   std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> string_indices;
 };
 
 // Bytecode compiler interface
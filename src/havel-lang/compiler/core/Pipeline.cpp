@@ -683,6 +683,40 @@ std::string opcodeName(OpCode opcode) {
     return "BIT_RSH";
   case OpCode::BIT_NOT:
     return "BIT_NOT";
+  case OpCode::LOAD_VAR_LOAD_CONST_BINOP:
+    return "LOAD_VAR_LOAD_CONST_BINOP";
+  case OpCode::LOAD_VAR_LOAD_VAR_BINOP:
+    return "LOAD_VAR_LOAD_VAR_BINOP";
+  case OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP:
+    return "LOAD_VAR_LOAD_CONST_CMP_JUMP";
+  case OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP:
+    return "LOAD_VAR_LOAD_VAR_CMP_JUMP";
+  case OpCode::DUP_STORE_VAR_POP:
+    return "DUP_STORE_VAR_POP";
+  case OpCode::DUP_STORE_GLOBAL_POP:
+    return "DUP_STORE_GLOBAL_POP";
+  case OpCode::ADD_INT:
+    return "ADD_INT";
+  case OpCode::ADD_NUM:
+    return "ADD_NUM";
+  case OpCode::ADD_STR:
+    return "ADD_STR";
+  case OpCode::SUB_INT:
+    return "SUB_INT";
+  case OpCode::SUB_NUM:
+    return "SUB_NUM";
+  case OpCode::LT_INT:
+    return "LT_INT";
+  case OpCode::LT_NUM:
+    return "LT_NUM";
+  case OpCode::EQ_INT:
+    return "EQ_INT";
+  case OpCode::EQ_NUM:
+    return "EQ_NUM";
+  case OpCode::EQ_STR:
+    return "EQ_STR";
+  case OpCode::ARRAY_GET_INT:
+    return "ARRAY_GET_INT";
   default:
     std::unreachable();
   }
@@ -744,8 +778,7 @@ std::string formatBytecodeSnapshot(const BytecodeChunk &chunk) {
           out << formatValue(op);
         }
       }
-      if (function.instructions[i].location) {
-        const auto &loc = *function.instructions[i].location;
+      if (const auto loc = function.line_table.lookup(i); loc.line > 0) {
         out << " @" << loc.line << ":" << loc.column;
       }
       out << "\n";
@@ -863,6 +896,7 @@ BytecodeSmokeResult runBytecodePipeline(const std::string &source,
   ByteCompiler compiler;
   compiler.setTypeCheckResult(std::move(typeCheckResult));
   compiler.setSourceFile(options.compile_unit_name);
+  compiler.setFuseSuperinstructions(options.superinstructions);
   BytecodeSmokeResult result;
   std::unique_ptr<BytecodeChunk> chunk;
   try {
@@ -1121,6 +1155,7 @@ std::unique_ptr<BytecodeChunk> compileToBytecodeChunk(
   ByteCompiler compiler;
   compiler.setTypeCheckResult(std::move(typeCheckResult));
   compiler.setSourceFile(options.compile_unit_name);
+  compiler.setFuseSuperinstructions(options.superinstructions);
 
   auto chunk = compiler.compile(*program);
   if (!chunk) {
@@ -23,6 +23,7 @@ struct PipelineOptions {
     bool write_snapshot_artifact = false;
     bool debugBytecode = false;
     uint64_t max_instructions = 0; // 0 = unlimited
+    bool superinstructions = true; // ByteCompiler::fuseSuperinstructions
     std::unordered_map<std::string, BytecodeHostFunction> host_functions;
     VM *vm_override = nullptr;
     std::function<void(VM &)> vm_setup;
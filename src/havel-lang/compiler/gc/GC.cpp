@@ -2,8 +2,11 @@
 
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include "utils/Logger.hpp"
 #include "common/Debug.hpp"
 
@@ -15,23 +18,13 @@ constexpr size_t kMinAllocationBudget = 256;
 constexpr size_t kMaxAllocationBudget = 1 << 20;
 constexpr size_t kDefaultWorkBudget = 1024;
 constexpr size_t kMaxIterationsPerStep = 100000;
-
-template <typename Map>
-void compactIfShrunk(Map& m, size_t load_factor_threshold) {
-    if (m.empty()) {
-        m = Map();
-        return;
-    }
-    size_t bucket_count = m.bucket_count();
-    if (bucket_count > m.size() * load_factor_threshold) {
-        Map compacted;
-        compacted.reserve(m.size());
-        for (auto& kv : m) {
-            compacted.insert(std::move(kv));
-        }
-        m = std::move(compacted);
-    }
-}
+// Gray values move between marking threads in batches of this size.
+constexpr size_t kMarkShareBatch = 128;
+// Below this many live objects a collection is marked on the VM thread
+// alone; waking the helpers would cost more than it saves.
+constexpr uint64_t kParallelMarkMinObjects = 16384;
+// Slots an allocation sweeps of its own kind while a cycle is being swept.
+constexpr size_t kLazySweepSlots = 32;
 
 }
 
@@ -59,14 +52,27 @@ approx_heap_bytes_.store(0, std::memory_order_relaxed);
 }
 
 void GCHeap::reset() {
+    for (auto [_, closure] : closures_) {
+        for (UpvalueCell *cell : closure.upvalues) {
+            if (cell) {
+                releaseUpvalue(cell);
+            }
+        }
+    }
     closures_.clear();
     arrays_.clear();
     objects_.clear();
     sets_.clear();
     ranges_.clear();
+    bytes_.clear();
     iterators_.clear();
     bound_methods_.clear();
     strings_.clear();
+    ropes_.clear();
+    rope_count_.store(0, std::memory_order_relaxed);
+    interned_.clear();
+    interned_ids_.clear();
+    utf8_indices_.clear();
     enums_.clear();
     enumTypes_.clear();
     threads_.clear();
@@ -75,22 +81,8 @@ void GCHeap::reset() {
     channels_.clear();
     coroutines_.clear();
     errors_.clear();
-
-    next_closure_id_ = 1;
-    next_array_id_ = 1;
-    next_object_id_ = 1;
-    next_set_id_ = 1;
-    next_range_id_ = 1;
-    next_iterator_id_ = 1;
-    next_bound_method_id_ = 1;
-    next_string_id_ = 1;
-    next_thread_id_ = 1;
-    next_interval_id_ = 1;
-    next_timeout_id_ = 1;
-    next_channel_id_ = 1;
-next_coroutine_id_ = 1;
-next_error_id_ = 1;
-next_enum_id_ = 1;
+    waitgroups_.clear();
+    set_versions_.clear();
 
     allocations_since_last_ = 0;
     recovered_in_cycle_ = 0;
@@ -99,61 +91,56 @@ next_enum_id_ = 1;
     next_external_root_id_ = 1;
     collections_ = 0;
     last_pause_ns_ = 0;
+    last_mark_ns_ = 0;
+    mark_ns_in_cycle_ = 0;
     total_recovered_ = 0;
     gc_state_ = IncrementalState::Idle;
     collection_requested_ = false;
 
     mark_worklist_.clear();
-    marked_arrays_.clear();
-    marked_objects_.clear();
-    marked_sets_.clear();
-    marked_closures_.clear();
-    marked_strings_.clear();
-    marked_iterators_.clear();
-    marked_bound_methods_.clear();
-    marked_ranges_.clear();
-    marked_errors_.clear();
-    marked_enums_.clear();
-    marked_coroutines_.clear();
-    marked_threads_.clear();
-    marked_intervals_.clear();
-    marked_timeouts_.clear();
-    marked_channels_.clear();
-  marked_waitgroups_.clear();
+    clearMarks();
 
     array_ages_.clear();
     object_ages_.clear();
     set_ages_.clear();
     closure_ages_.clear();
     string_ages_.clear();
-    old_arrays_.clear();
-    old_objects_.clear();
-    old_sets_.clear();
-    old_closures_.clear();
-    old_strings_.clear();
+    remembered_.clear();
 
     current_collection_full_ = false;
     minor_collections_since_full_ = 0;
 
-    root_stack_snapshot_.clear();
-    root_locals_snapshot_.clear();
-    root_globals_ptr_ = nullptr;
-    root_closures_snapshot_.clear();
-    open_local_reader_snapshot_ = {};
+    sweep_kind_ = kSweepKindCount;
+}
 
-    sweep_keys_.clear();
-    sweep_index_ = 0;
-    sweep_phase_ = IncrementalState::Idle;
+// Every slab allocation goes through here. While a cycle is being swept it
+// first sweeps a few slots of its own kind, so the sweep is paid for by the
+// allocations that want the space, and the new object is allocated black
+// so the rest of the sweep leaves it alone.
+template <typename T, typename... Args>
+uint32_t GCHeap::place(Slab<T> &slab, SweepKind kind, Args &&...args) {
+    if (gc_state_ == IncrementalState::Sweep) {
+        sweepKind(kind, kLazySweepSlots);
+        advanceSweep();
+    }
+    const uint32_t id = slab.emplace(std::forward<Args>(args)...);
+    if (gc_state_ == IncrementalState::Sweep) {
+        slab.mark(id);
+    }
+    return id;
 }
 
 ClosureRef GCHeap::allocateClosure(RuntimeClosure closure) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
-  size_t est = sizeof(RuntimeClosure) + closure.upvalues.size() * sizeof(std::shared_ptr<UpvalueCell>);
+  size_t est = sizeof(RuntimeClosure) + closure.upvalues.size() * (sizeof(UpvalueCell *) + sizeof(UpvalueCell));
   checkHeapLimit(est);
-  const uint32_t id = next_closure_id_++;
-  closures_.emplace(id, std::move(closure));
+  for (UpvalueCell *cell : closure.upvalues) {
+    if (cell) {
+      retainUpvalue(cell);
+    }
+  }
+  const uint32_t id = place(closures_, SweepKind::Closures, std::move(closure));
   closure_ages_[id] = 0;
-  old_closures_.erase(id);
   addHeapBytes(est);
   cached_object_count_.fetch_add(1, std::memory_order_relaxed);
   allocations_since_last_++;
@@ -164,8 +151,7 @@ StringRef GCHeap::allocateString(std::string value) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   size_t est = value.size() + 1;
   checkHeapLimit(est);
-  const uint32_t id = next_string_id_++;
-  strings_.emplace(id, std::move(value));
+  const uint32_t id = place(strings_, SweepKind::Strings, std::move(value));
   addHeapBytes(est);
   cached_object_count_.fetch_add(1, std::memory_order_relaxed);
   allocations_since_last_++;
@@ -173,25 +159,134 @@ StringRef GCHeap::allocateString(std::string value) {
 }
 
 std::string *GCHeap::string(uint32_t id) {
+    if (rope_count_.load(std::memory_order_acquire) == 0) {
+        return strings_.get(id);
+    }
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = strings_.find(id);
-    return it == strings_.end() ? nullptr : &it->second;
+    if (ropes_.count(id)) {
+        flattenRope(id);
+    }
+    return strings_.get(id);
 }
 
 const std::string *GCHeap::string(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = strings_.find(id);
-    return it == strings_.end() ? nullptr : &it->second;
+    // Flattening a rope doesn't change the string's value.
+    return const_cast<GCHeap *>(this)->string(id);
+}
+
+StringRef GCHeap::internString(std::string_view value) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  if (auto it = interned_.find(value); it != interned_.end()) {
+    // An unmarked hit mid-cycle may already be condemned; the new reference
+    // has to keep it alive like any other mutator write would.
+    if (gc_state_ != IncrementalState::Idle) {
+      strings_.mark(it->second);
+    }
+    return StringRef{.id = it->second};
+  }
+  StringRef ref = allocateString(std::string(value));
+  const std::string &stored = *strings_.get(ref.id);
+  interned_.emplace(std::string_view(stored), ref.id);
+  interned_ids_.insert(ref.id);
+  return ref;
+}
+
+bool GCHeap::retainCachedClosure(uint32_t id) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  switch (gc_state_) {
+  case IncrementalState::Idle:
+    return true;
+  case IncrementalState::Mark:
+    markReference(Value::makeClosureId(id));
+    return true;
+  case IncrementalState::Sweep:
+    // Survivors and closures allocated since marking ended are marked.
+    return closures_.isMarked(id);
+  }
+  return false;
+}
+
+bool GCHeap::isInterned(uint32_t id) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  return interned_ids_.count(id) != 0;
+}
+
+const Utf8Index &GCHeap::utf8Index(uint32_t id) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  auto it = utf8_indices_.find(id);
+  if (it == utf8_indices_.end()) {
+    const std::string *s = string(id);
+    it = utf8_indices_.emplace(id, Utf8Index(s ? *s : std::string_view{})).first;
+  }
+  return it->second;
+}
+
+StringRef GCHeap::concatStrings(uint32_t left_id, uint32_t right_id) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const size_t length = stringLength(left_id) + stringLength(right_id);
+  if (length < kRopeMinLength) {
+    std::string joined;
+    joined.reserve(length);
+    if (const std::string *l = string(left_id)) joined += *l;
+    if (const std::string *r = string(right_id)) joined += *r;
+    return allocateString(std::move(joined));
+  }
+  size_t est = sizeof(RopeNode);
+  checkHeapLimit(est);
+  const uint32_t id = place(strings_, SweepKind::Strings);
+  ropes_.emplace(id, RopeNode{left_id, right_id, length});
+  rope_count_.fetch_add(1, std::memory_order_release);
+  addHeapBytes(est);
+  cached_object_count_.fetch_add(1, std::memory_order_relaxed);
+  allocations_since_last_++;
+  return StringRef{.id = id};
+}
+
+size_t GCHeap::stringLength(uint32_t id) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (auto rope = ropes_.find(id); rope != ropes_.end()) {
+        return rope->second.length;
+    }
+    const std::string *s = strings_.get(id);
+    return s ? s->size() : 0;
+}
+
+// Copies the leaves in order into the rope's own strings_ entry and drops
+// the node, which releases the halves to the collector. Inner ropes are read
+// through, not flattened, since other strings may still share them. The walk
+// is iterative because `s = s + piece` loops build very deep left spines.
+void GCHeap::flattenRope(uint32_t id) {
+    auto node = ropes_.find(id);
+    if (node == ropes_.end()) {
+        return;
+    }
+    std::string flat;
+    flat.reserve(node->second.length);
+    std::vector<uint32_t> pending{node->second.right, node->second.left};
+    while (!pending.empty()) {
+        const uint32_t part = pending.back();
+        pending.pop_back();
+        if (auto inner = ropes_.find(part); inner != ropes_.end()) {
+            pending.push_back(inner->second.right);
+            pending.push_back(inner->second.left);
+            continue;
+        }
+        if (const std::string *leaf = strings_.get(part)) {
+            flat += *leaf;
+        }
+    }
+    ropes_.erase(node);
+    addHeapBytes(flat.size() + 1);
+    *strings_.get(id) = std::move(flat);
+    rope_count_.fetch_sub(1, std::memory_order_release);
 }
 
 ArrayRef GCHeap::allocateArray() {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   size_t est = sizeof(ArrayEntry);
   checkHeapLimit(est);
-  const uint32_t id = next_array_id_++;
-  arrays_[id] = {};
+  const uint32_t id = place(arrays_, SweepKind::Arrays);
   array_ages_[id] = 0;
-  old_arrays_.erase(id);
   addHeapBytes(est);
   cached_object_count_.fetch_add(1, std::memory_order_relaxed);
   allocations_since_last_++;
@@ -199,16 +294,13 @@ ArrayRef GCHeap::allocateArray() {
 }
 
 uint64_t GCHeap::arrayVersion(uint32_t id) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = arrays_.find(id);
-    return it == arrays_.end() ? 0 : it->second.version.load(std::memory_order_relaxed);
+    const ArrayEntry *arr = arrays_.get(id);
+    return arr ? arr->version.load(std::memory_order_relaxed) : 0;
 }
 
 void GCHeap::bumpArrayVersion(uint32_t id) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = arrays_.find(id);
-    if (it != arrays_.end()) {
-        it->second.version.fetch_add(1, std::memory_order_relaxed);
+    if (ArrayEntry *arr = arrays_.get(id)) {
+        arr->version.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
@@ -216,15 +308,9 @@ ObjectRef GCHeap::allocateObject(bool sorted) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     size_t est = sizeof(ObjectEntry);
     checkHeapLimit(est);
-    const uint32_t id = next_object_id_++;
-    ObjectEntry entry;
-    entry.sorted = sorted;
-    auto [it, inserted] = objects_.emplace(id, std::move(entry));
-    if (!inserted) {
-        it->second.sorted = sorted;
-    }
+    const uint32_t id = place(objects_, SweepKind::Objects);
+    objects_.get(id)->sorted = sorted;
     object_ages_[id] = 0;
-    old_objects_.erase(id);
     addHeapBytes(est);
   cached_object_count_.fetch_add(1, std::memory_order_relaxed);
   allocations_since_last_++;
@@ -233,13 +319,11 @@ ObjectRef GCHeap::allocateObject(bool sorted) {
 
 SetRef GCHeap::allocateSet() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    size_t est = sizeof(std::unordered_map<std::string, Value>);
+    size_t est = sizeof(ValueSet);
     checkHeapLimit(est);
-    const uint32_t id = next_set_id_++;
-    sets_[id] = {};
+    const uint32_t id = place(sets_, SweepKind::Sets);
     set_versions_[id] = 1;
     set_ages_[id] = 0;
-    old_sets_.erase(id);
     addHeapBytes(est);
   cached_object_count_.fetch_add(1, std::memory_order_relaxed);
   allocations_since_last_++;
@@ -258,25 +342,54 @@ RangeRef GCHeap::allocateRange(int64_t start, int64_t end, int64_t step) {
 std::lock_guard<std::recursive_mutex> lock(mutex_);
 size_t est = sizeof(Range);
     checkHeapLimit(est);
-    const uint32_t id = next_range_id_++;
     Range range;
     range.start = start;
     range.end = end;
     range.step = step;
-    ranges_[id] = range;
+    const uint32_t id = place(ranges_, SweepKind::Ranges, range);
     addHeapBytes(est);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return RangeRef{.id = id};
 }
 
+BytesRef GCHeap::allocateBytes(std::vector<uint8_t> data) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const size_t est = sizeof(ByteBuffer) + data.size();
+  checkHeapLimit(est);
+  ByteBuffer buffer;
+  buffer.length = data.size();
+  buffer.storage = std::make_shared<std::vector<uint8_t>>(std::move(data));
+  const uint32_t id = place(bytes_, SweepKind::Bytes, std::move(buffer));
+  addHeapBytes(est);
+  cached_object_count_.fetch_add(1, std::memory_order_relaxed);
+  allocations_since_last_++;
+  return BytesRef{.id = id};
+}
+
+BytesRef GCHeap::allocateBytesView(const ByteBuffer &base, size_t offset,
+    size_t length, ByteBuffer::Kind kind) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  const size_t est = sizeof(ByteBuffer);
+  checkHeapLimit(est);
+  ByteBuffer view;
+  view.storage = base.storage;
+  view.offset = base.offset + offset;
+  view.length = length;
+  view.kind = kind;
+  const uint32_t id = place(bytes_, SweepKind::Bytes, std::move(view));
+  addHeapBytes(est);
+  cached_object_count_.fetch_add(1, std::memory_order_relaxed);
+  allocations_since_last_++;
+  return BytesRef{.id = id};
+}
+
 ErrorRef GCHeap::allocateError(const std::string &errorType,
 const std::string &message,
 const std::string &stackTrace, uint32_t line, uint32_t column) {
 std::lock_guard<std::recursive_mutex> lock(mutex_);
 size_t est = errorType.size() + message.size() + stackTrace.size() + sizeof(ErrorObject);
     checkHeapLimit(est);
-    const uint32_t id = next_error_id_++;
-    errors_[id] = ErrorObject(errorType, message, stackTrace, line, column);
+    const uint32_t id = place(errors_, SweepKind::Errors, errorType, message, stackTrace, line, column);
     addHeapBytes(est);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return ErrorRef{.id = id};
@@ -286,31 +399,25 @@ IteratorRef GCHeap::allocateIterator(const Value &iterable) {
 std::lock_guard<std::recursive_mutex> lock(mutex_);
 size_t est = sizeof(Iterator);
     checkHeapLimit(est);
-    const uint32_t id = next_iterator_id_++;
     Iterator iter;
     iter.iterable = iterable;
     iter.index = 0;
 
     if (iterable.isObjectId()) {
-        auto *obj = object(iterable.asObjectId());
+        const auto *obj = objects_.get(iterable.asObjectId());
         if (obj) {
             iter.keys = obj->getKeys();
             est += iter.keys.size() * sizeof(std::string);
         }
     } else if (iterable.isSetId()) {
-        auto *setObj = set(iterable.asSetId());
+        const auto *setObj = sets_.get(iterable.asSetId());
         if (setObj) {
-            for (const auto &[key, present] : *setObj) {
-                if (present.isBool() && !present.asBool()) {
-                    continue;
-                }
-                iter.keys.push_back(key);
-            }
-            est += iter.keys.size() * sizeof(std::string);
+            iter.members.assign(setObj->begin(), setObj->end());
+            est += iter.members.size() * sizeof(Value);
         }
     }
 
-    iterators_[id] = std::move(iter);
+    const uint32_t id = place(iterators_, SweepKind::Iterators, std::move(iter));
     addHeapBytes(est);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return IteratorRef{.id = id};
@@ -330,8 +437,7 @@ uint32_t GCHeap::registerEnumType(const std::string &name,
 
 EnumRef GCHeap::allocateEnum(uint32_t typeId, uint32_t tag, size_t payloadCount) {
 std::lock_guard<std::recursive_mutex> lock(mutex_);
-const uint32_t id = next_enum_id_++;
-    enums_[id] = {tag, std::vector<Value>(payloadCount, Value::makeNull())};
+const uint32_t id = place(enums_, SweepKind::Enums, tag, std::vector<Value>(payloadCount, Value::makeNull()));
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return EnumRef{.id = id, .tag = tag, .typeId = typeId};
 }
@@ -352,7 +458,7 @@ Value GCHeap::iteratorNext(uint32_t id) {
     Value second;
 
     if (iter->iterable.isArrayId()) {
-        auto *arr = array(iter->iterable.asArrayId());
+        const auto *arr = arrays_.get(iter->iterable.asArrayId());
         if (!arr || iter->index >= arr->size()) {
             done = true;
             first = Value::makeNull();
@@ -373,15 +479,8 @@ Value GCHeap::iteratorNext(uint32_t id) {
                 second = Value::makeNull();
             } else {
                 size_t bytePos = iter->index;
-                unsigned char c = static_cast<unsigned char>((*s)[bytePos]);
-                size_t cpLen = 1;
-                if (c < 0x80) { cpLen = 1; }
-                else if ((c & 0xE0) == 0xC0) { cpLen = 2; }
-                else if ((c & 0xF0) == 0xE0) { cpLen = 3; }
-                else if ((c & 0xF8) == 0xF0) { cpLen = 4; }
-                if (bytePos + cpLen > s->size()) { cpLen = 1; }
-                std::string ch = s->substr(bytePos, cpLen);
-                auto charStrRef = allocateString(std::move(ch));
+                size_t cpLen = Utf8Index::sequenceLength(*s, bytePos);
+                auto charStrRef = internString(std::string_view(*s).substr(bytePos, cpLen));
                 iter->codepoint_index++;
                 iter->index = bytePos + cpLen;
                 first = Value::makeInt(iter->codepoint_index - 1);
@@ -394,9 +493,9 @@ Value GCHeap::iteratorNext(uint32_t id) {
             second = Value::makeNull();
         } else {
             auto key = iter->keys[iter->index];
-            auto keyStrRef = allocateString(key);
+            auto keyStrRef = internString(key);
             first = Value::makeStringId(keyStrRef.id);
-            auto *obj = object(iter->iterable.asObjectId());
+            const auto *obj = objects_.get(iter->iterable.asObjectId());
             if (obj) {
                 auto *val = obj->get(key);
                 second = val ? *val : Value::makeNull();
@@ -406,20 +505,23 @@ Value GCHeap::iteratorNext(uint32_t id) {
             iter->index++;
         }
     } else if (iter->iterable.isSetId()) {
-        if (iter->index >= iter->keys.size()) {
+        if (iter->index >= iter->members.size()) {
             done = true;
             first = Value::makeNull();
             second = Value::makeNull();
         } else {
-            auto key = iter->keys[iter->index++];
-            try {
-                first = Value::makeInt(std::stoll(key));
-                second = first;
-            } catch (...) {
-                auto strRef = allocateString(key);
-                first = Value::makeStringId(strRef.id);
-                second = first;
-            }
+            first = iter->members[iter->index++];
+            second = first;
+        }
+    } else if (iter->iterable.isBytesId()) {
+        auto *buf = bytes(iter->iterable.asBytesId());
+        if (!buf || iter->index >= buf->size()) {
+            done = true;
+            first = Value::makeNull();
+            second = Value::makeNull();
+        } else {
+            first = Value::makeInt(iter->index);
+            second = buf->get(iter->index++);
         }
     } else if (iter->iterable.isRangeId()) {
         auto *r = range(iter->iterable.asRangeId());
@@ -462,51 +564,58 @@ bool GCHeap::isCollectionInProgress() const {
 }
 
 GCHeap::RuntimeClosure *GCHeap::closure(uint32_t id) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = closures_.find(id);
-    return it == closures_.end() ? nullptr : &it->second;
+    return closures_.get(id);
 }
 
 const GCHeap::RuntimeClosure *GCHeap::closure(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-    auto it = closures_.find(id);
-    return it == closures_.end() ? nullptr : &it->second;
+    return closures_.get(id);
 }
 
+// Mutable lookups remember an old container up front: the caller may be
+// about to store a young reference into it, and only the store opcodes
+// report their stores through a write barrier (see arrayForStore).
 GCHeap::ArrayEntry *GCHeap::array(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = arrays_.find(id);
-return it == arrays_.end() ? nullptr : &it->second;
+    ArrayEntry *entry = arrays_.get(id);
+    if (entry && arrays_.remember(id)) {
+        addRemembered(Value::makeArrayId(id));
+    }
+    return entry;
 }
 
 const GCHeap::ArrayEntry *GCHeap::array(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = arrays_.find(id);
-return it == arrays_.end() ? nullptr : &it->second;
+    return arrays_.get(id);
+}
+
+GCHeap::ArrayEntry *GCHeap::arrayForStore(uint32_t id) {
+    return arrays_.get(id);
 }
 
 GCHeap::ObjectEntry *GCHeap::object(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = objects_.find(id);
-return it == objects_.end() ? nullptr : &it->second;
+    ObjectEntry *entry = objects_.get(id);
+    if (entry && objects_.remember(id)) {
+        addRemembered(Value::makeObjectId(id));
+    }
+    return entry;
 }
 
 const GCHeap::ObjectEntry *GCHeap::object(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = objects_.find(id);
-return it == objects_.end() ? nullptr : &it->second;
+    return objects_.get(id);
 }
 
-std::unordered_map<std::string, Value> *GCHeap::set(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = sets_.find(id);
-return it == sets_.end() ? nullptr : &it->second;
+GCHeap::ObjectEntry *GCHeap::objectForStore(uint32_t id) {
+    return objects_.get(id);
 }
 
-const std::unordered_map<std::string, Value> *GCHeap::set(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = sets_.find(id);
-return it == sets_.end() ? nullptr : &it->second;
+ValueSet *GCHeap::set(uint32_t id) {
+    ValueSet *entry = sets_.get(id);
+    if (entry && sets_.remember(id)) {
+        addRemembered(Value::makeSetId(id));
+    }
+    return entry;
+}
+
+const ValueSet *GCHeap::set(uint32_t id) const {
+    return sets_.get(id);
 }
 
 uint64_t GCHeap::setVersion(uint32_t id) const {
@@ -516,62 +625,156 @@ uint64_t GCHeap::setVersion(uint32_t id) const {
 }
 
 GCHeap::Range *GCHeap::range(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = ranges_.find(id);
-return it == ranges_.end() ? nullptr : &it->second;
+    return ranges_.get(id);
 }
 
 const GCHeap::Range *GCHeap::range(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = ranges_.find(id);
-return it == ranges_.end() ? nullptr : &it->second;
+    return ranges_.get(id);
+}
+
+// 1.0 and 1 are the same set member. Only doubles inside the 48-bit int
+// range fold (NaN fails both bounds); the rest keep their own bits.
+static Value foldIntegralDouble(const Value &value) {
+  if (value.isDouble()) {
+    const double d = value.asDouble();
+    if (d >= -140737488355328.0 && d < 140737488355328.0 &&
+        d == static_cast<double>(static_cast<int64_t>(d))) {
+      return Value::makeInt(static_cast<int64_t>(d));
+    }
+  }
+  return value;
+}
+
+Value GCHeap::setMember(const Value &value) {
+  if (value.isStringId()) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const uint32_t id = value.asStringId();
+    if (interned_ids_.count(id)) return value;
+    const std::string *s = string(id);
+    if (!s) return value;
+    if (interned_.count(*s)) {
+      // internString also shades the hit if a cycle is running
+      return Value::makeStringId(internString(*s).id);
+    }
+    // Heap strings are immutable and, once flattened by string(), no longer
+    // ropes, so this one can serve as the interned copy of its bytes.
+    interned_.emplace(std::string_view(*s), id);
+    interned_ids_.insert(id);
+    return value;
+  }
+  return foldIntegralDouble(value);
+}
+
+std::optional<Value> GCHeap::findSetMember(const Value &value) const {
+  if (value.isStringId()) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const uint32_t id = value.asStringId();
+    if (interned_ids_.count(id)) return value;
+    const std::string *s = string(id);
+    if (!s) return std::nullopt;
+    return findSetMember(std::string_view(*s));
+  }
+  return foldIntegralDouble(value);
+}
+
+std::optional<Value> GCHeap::findSetMember(std::string_view text) const {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  auto it = interned_.find(text);
+  if (it == interned_.end()) return std::nullopt;
+  return Value::makeStringId(it->second);
+}
+
+GCHeap::ByteBuffer *GCHeap::bytes(uint32_t id) {
+    return bytes_.get(id);
+}
+
+const GCHeap::ByteBuffer *GCHeap::bytes(uint32_t id) const {
+    return bytes_.get(id);
+}
+
+Value GCHeap::ByteBuffer::get(size_t i) const {
+    if (i >= size()) return Value::makeNull();
+    const uint8_t *p = data() + i * elementSize(kind);
+    switch (kind) {
+    case Kind::U8:
+        return Value::makeInt(*p);
+    case Kind::I32: {
+        int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return Value::makeInt(v);
+    }
+    case Kind::F32: {
+        float v;
+        std::memcpy(&v, p, sizeof(v));
+        return Value::makeDouble(v);
+    }
+    case Kind::F64: {
+        double v;
+        std::memcpy(&v, p, sizeof(v));
+        return Value::makeDouble(v);
+    }
+    }
+    return Value::makeNull();
+}
+
+bool GCHeap::ByteBuffer::set(size_t i, const Value &v) {
+    if (i >= size() || !(v.isInt() || v.isDouble())) return false;
+    uint8_t *p = data() + i * elementSize(kind);
+    switch (kind) {
+    case Kind::U8:
+        *p = static_cast<uint8_t>(v.isInt() ? v.asInt() : static_cast<int64_t>(v.asDouble()));
+        return true;
+    case Kind::I32: {
+        const auto x = static_cast<int32_t>(v.isInt() ? v.asInt() : static_cast<int64_t>(v.asDouble()));
+        std::memcpy(p, &x, sizeof(x));
+        return true;
+    }
+    case Kind::F32: {
+        const auto x = static_cast<float>(v.isInt() ? static_cast<double>(v.asInt()) : v.asDouble());
+        std::memcpy(p, &x, sizeof(x));
+        return true;
+    }
+    case Kind::F64: {
+        const double x = v.isInt() ? static_cast<double>(v.asInt()) : v.asDouble();
+        std::memcpy(p, &x, sizeof(x));
+        return true;
+    }
+    }
+    return false;
 }
 
 GCHeap::Iterator *GCHeap::iterator(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = iterators_.find(id);
-return it == iterators_.end() ? nullptr : &it->second;
+    return iterators_.get(id);
 }
 
 const GCHeap::Iterator *GCHeap::iterator(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = iterators_.find(id);
-return it == iterators_.end() ? nullptr : &it->second;
+    return iterators_.get(id);
 }
 
 BoundMethodRef GCHeap::allocateBoundMethod(Value fn, Value self) {
 std::lock_guard<std::recursive_mutex> lock(mutex_);
 size_t est = sizeof(BoundMethod);
     checkHeapLimit(est);
-    const uint32_t id = next_bound_method_id_++;
-    bound_methods_[id] = BoundMethod{fn, self};
+    const uint32_t id = place(bound_methods_, SweepKind::BoundMethods, BoundMethod{fn, self});
     addHeapBytes(est);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return BoundMethodRef{.id = id};
 }
 
 GCHeap::BoundMethod *GCHeap::boundMethod(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = bound_methods_.find(id);
-return it == bound_methods_.end() ? nullptr : &it->second;
+    return bound_methods_.get(id);
 }
 
 const GCHeap::BoundMethod *GCHeap::boundMethod(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = bound_methods_.find(id);
-return it == bound_methods_.end() ? nullptr : &it->second;
+    return bound_methods_.get(id);
 }
 
 GCHeap::ErrorObject *GCHeap::error(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = errors_.find(id);
-return it == errors_.end() ? nullptr : &it->second;
+    return errors_.get(id);
 }
 
 const GCHeap::ErrorObject *GCHeap::error(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = errors_.find(id);
-return it == errors_.end() ? nullptr : &it->second;
+    return errors_.get(id);
 }
 
 uint64_t GCHeap::pinExternalRoot(const Value &value) {
@@ -613,98 +816,72 @@ GCHeap::Stats GCHeap::stats() const {
         .object_count = cached_object_count_.load(std::memory_order_relaxed),
         .collections = collections_,
         .last_pause_ns = last_pause_ns_,
+        .last_mark_ns = last_mark_ns_,
         .total_recovered = total_recovered_,
     };
 }
 
-void GCHeap::maybeCollectGarbage(
-  const std::vector<Value> &stack_values,
-  const std::vector<Value> &locals,
-  const std::unordered_map<std::string, Value> &globals,
-  const std::vector<uint32_t> &active_closure_ids,
-  const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-  const std::vector<Value> &extra_roots) {
+void GCHeap::maybeCollectGarbage(const RootSource &roots) {
+  if (!collectionWorkPending()) {
+    return;
+  }
+  RootsInUse in_use(*this, roots);
 
   if (allocations_since_last_ >= allocation_budget_) {
     collection_requested_ = true;
   }
 
+    // Allocation sweeps the kinds being allocated; this keeps the rest of a
+    // marked cycle moving. The next cycle cannot start until it is swept.
+    if (gc_state_ == IncrementalState::Sweep) {
+        if (collection_requested_) {
+            finishSweep();
+        } else {
+            size_t budget = kDefaultWorkBudget;
+            sweepStep(budget);
+        }
+    }
+
     if (collection_requested_) {
         if (stop_the_world_) {
-            collectGarbage(stack_values, locals, globals, active_closure_ids,
-                           open_local_reader, extra_roots);
+            // Only marking stops the world; sweeping is left to allocation
+            // and later GC steps.
+            startIncrementalCollection(roots);
+            finishMark();
             collection_requested_ = false;
         } else if (gc_state_ == IncrementalState::Idle) {
-            stepGarbageCollection(stack_values, locals, globals, active_closure_ids,
-                                  open_local_reader, kDefaultWorkBudget, extra_roots);
-        } else if (gc_state_ != IncrementalState::Idle) {
-            root_stack_snapshot_ = stack_values;
-            root_locals_snapshot_ = locals;
-            root_closures_snapshot_ = active_closure_ids;
-            root_extra_roots_snapshot_ = extra_roots;
-            open_local_reader_snapshot_ = open_local_reader;
-            if (gc_state_ == IncrementalState::Mark) {
-                markRoots();
-            }
+            stepGarbageCollection(roots, kDefaultWorkBudget);
+        } else if (gc_state_ == IncrementalState::Mark) {
+            markRoots();
         }
     }
 }
 
-void GCHeap::collectGarbage(
-    const std::vector<Value> &stack_values,
-    const std::vector<Value> &locals,
-    const std::unordered_map<std::string, Value> &globals,
-    const std::vector<uint32_t> &active_closure_ids,
-    const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-    const std::vector<Value> &extra_roots) {
-
-    startIncrementalCollection(stack_values, locals, globals, active_closure_ids, open_local_reader, extra_roots);
-
-    // Complete marking first
-    while (gc_state_ == IncrementalState::Mark) {
-        size_t budget = std::numeric_limits<size_t>::max();
-        markStep(budget);
-    }
-
-    // Then sweep everything
-    while (gc_state_ != IncrementalState::Idle) {
-        size_t budget = std::numeric_limits<size_t>::max();
-        sweepStep(budget);
-    }
+void GCHeap::collectGarbage(const RootSource &roots) {
+    RootsInUse in_use(*this, roots);
 
-    completeCollection();
+    // An explicit collection is complete on return: finish any cycle
+    // still being swept, then mark and sweep a new one.
+    finishSweep();
+    startIncrementalCollection(roots);
+    finishMark();
+    finishSweep();
 }
 
-void GCHeap::forceFullCollection(
-    const std::vector<Value> &stack_values,
-    const std::vector<Value> &locals,
-    const std::unordered_map<std::string, Value> &globals,
-    const std::vector<uint32_t> &active_closure_ids,
-    const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-    const std::vector<Value> &extra_roots) {
-
+void GCHeap::forceFullCollection(const RootSource &roots) {
+  finishSweep();
   current_collection_full_ = true;
-  collectGarbage(stack_values, locals, globals, active_closure_ids, open_local_reader, extra_roots);
+  collectGarbage(roots);
 }
 
-void GCHeap::stepGarbageCollection(
-    const std::vector<Value> &stack_values,
-    const std::vector<Value> &locals,
-    const std::unordered_map<std::string, Value> &globals,
-    const std::vector<uint32_t> &active_closure_ids,
-    const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-    size_t work_budget,
-    const std::vector<Value> &extra_roots) {
-
-    if (work_budget == 0) {
+void GCHeap::stepGarbageCollection(const RootSource &roots, size_t work_budget) {
+    if (work_budget == 0 || !collectionWorkPending()) {
         return;
     }
+    RootsInUse in_use(*this, roots);
 
     if (gc_state_ == IncrementalState::Idle) {
-        if (!collection_requested_ && allocations_since_last_ < allocation_budget_) {
-            return;
-        }
-        startIncrementalCollection(stack_values, locals, globals, active_closure_ids, open_local_reader, extra_roots);
+        startIncrementalCollection(roots);
     }
 
     const auto pause_start = std::chrono::steady_clock::now();
@@ -720,49 +897,19 @@ void GCHeap::stepGarbageCollection(
         iterations++;
     }
 
-    if (gc_state_ == IncrementalState::Idle) {
-        completeCollection();
-    }
-
     const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
         std::chrono::steady_clock::now() - pause_start);
     last_pause_ns_ = static_cast<uint64_t>(elapsed_ns.count());
 }
 
-void GCHeap::startIncrementalCollection(
-    const std::vector<Value> &stack_values,
-    const std::vector<Value> &locals,
-    const std::unordered_map<std::string, Value> &globals,
-    const std::vector<uint32_t> &active_closure_ids,
-    const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-    const std::vector<Value> &extra_roots) {
-
-    root_stack_snapshot_ = stack_values;
-    root_locals_snapshot_ = locals;
-    root_globals_ptr_ = &globals;
-    root_closures_snapshot_ = active_closure_ids;
-    root_extra_roots_snapshot_ = extra_roots;
-    open_local_reader_snapshot_ = open_local_reader;
+void GCHeap::startIncrementalCollection(const RootSource &roots) {
+    RootsInUse in_use(*this, roots);
 
     mark_worklist_.clear();
-    marked_arrays_.clear();
-    marked_objects_.clear();
-    marked_sets_.clear();
-    marked_closures_.clear();
-    marked_strings_.clear();
-    marked_iterators_.clear();
-    marked_bound_methods_.clear();
-    marked_ranges_.clear();
-    marked_errors_.clear();
-    marked_enums_.clear();
-    marked_coroutines_.clear();
-    marked_threads_.clear();
-    marked_intervals_.clear();
-    marked_timeouts_.clear();
-    marked_channels_.clear();
-    marked_waitgroups_.clear();
+    clearMarks();
 
     recovered_in_cycle_ = 0;
+    mark_ns_in_cycle_ = 0;
     collection_requested_ = false;
 
   if (minor_collections_since_full_ >= full_collection_interval_) {
@@ -779,791 +926,691 @@ void GCHeap::startIncrementalCollection(
                   << ")\n";
 }
 
-void GCHeap::markReference(const Value &value) {
+void GCHeap::clearMarks() {
+    closures_.clearMarks();
+    strings_.clearMarks();
+    arrays_.clearMarks();
+    objects_.clearMarks();
+    sets_.clearMarks();
+    ranges_.clearMarks();
+    bytes_.clearMarks();
+    errors_.clearMarks();
+    enums_.clearMarks();
+    iterators_.clearMarks();
+    bound_methods_.clearMarks();
+    threads_.clearMarks();
+    intervals_.clearMarks();
+    timeouts_.clearMarks();
+    channels_.clearMarks();
+    waitgroups_.clearMarks();
+    coroutines_.clearMarks();
+}
+
+// Marks a generational kind. A minor cycle leaves old objects unmarked
+// and untraced: it never sweeps them, and their references to young
+// objects are reached through the remembered set instead.
+template <typename T>
+bool GCHeap::shadeGenerational(Slab<T> &slab, uint32_t id) {
+    if (!current_collection_full_ && slab.isOld(id)) {
+        return false;
+    }
+    return slab.mark(id);
+}
+
+// Sets the mark bit for `value`. True if it was newly marked and is of a
+// kind that holds references, i.e. it still has to be traced; leaf kinds
+// are done once marked. Safe to call from several marking threads.
+bool GCHeap::shade(const Value &value) {
     if (value.isArrayId()) {
-        const uint32_t id = value.asArrayId();
-        if (marked_arrays_.insert(id).second) {
-            mark_worklist_.push_back(value);
-        }
-        return;
+        return shadeGenerational(arrays_, value.asArrayId());
     }
     if (value.isObjectId()) {
-        const uint32_t id = value.asObjectId();
-        if (marked_objects_.insert(id).second) {
-            mark_worklist_.push_back(value);
-        }
-        return;
+        return shadeGenerational(objects_, value.asObjectId());
     }
     if (value.isSetId()) {
-        const uint32_t id = value.asSetId();
-        if (marked_sets_.insert(id).second) {
-            mark_worklist_.push_back(value);
-        }
-        return;
+        return shadeGenerational(sets_, value.asSetId());
     }
     if (value.isClosureId()) {
-        const uint32_t id = value.asClosureId();
-        if (marked_closures_.insert(id).second) {
-            mark_worklist_.push_back(value);
-        }
-        return;
+        return shadeGenerational(closures_, value.asClosureId());
     }
     if (value.isStringId()) {
-        marked_strings_.insert(value.asStringId());
-        return;
+        const uint32_t id = value.asStringId();
+        return shadeGenerational(strings_, id) && rope_count_.load(std::memory_order_relaxed) != 0 &&
+               ropes_.count(id) != 0;
     }
     if (value.isRangeId()) {
-        marked_ranges_.insert(value.asRangeId());
-        return;
+        ranges_.mark(value.asRangeId());
+        return false;
+    }
+    if (value.isBytesId()) {
+        bytes_.mark(value.asBytesId());
+        return false;
     }
     if (value.isErrorId()) {
-        marked_errors_.insert(value.asErrorId());
-        if (auto *err = error(value.asErrorId()); err && !err->cause.isNull()) {
-            markReference(err->cause);
-        }
-        return;
+        return errors_.mark(value.asErrorId());
     }
     if (value.isIteratorId()) {
-        marked_iterators_.insert(value.asIteratorId());
-        // Trace the iterable — the object being iterated can be the only
-        // reference keeping an array/object/string alive
-        auto it = iterators_.find(value.asIteratorId());
-        if (it != iterators_.end()) {
-            markReference(it->second.iterable);
-        }
-        return;
+        return iterators_.mark(value.asIteratorId());
     }
     if (value.isBoundMethodId()) {
-        marked_bound_methods_.insert(value.asBoundMethodId());
-        auto it = bound_methods_.find(value.asBoundMethodId());
-        if (it != bound_methods_.end()) {
-            markReference(it->second.fn);
-            markReference(it->second.self);
-        }
-        return;
+        return bound_methods_.mark(value.asBoundMethodId());
     }
     if (value.isEnumId()) {
-        marked_enums_.insert(value.asEnumId());
-        auto it = enums_.find(value.asEnumId());
-        if (it != enums_.end()) {
-            for (const auto &entry : it->second.second) {
-                markReference(entry);
-            }
-        }
-        return;
+        return enums_.mark(value.asEnumId());
     }
     if (value.isThreadId()) {
-        marked_threads_.insert(value.asThreadId());
-        return;
+        threads_.mark(value.asThreadId());
+        return false;
     }
     if (value.isIntervalId()) {
-        marked_intervals_.insert(value.asIntervalId());
-        return;
+        intervals_.mark(value.asIntervalId());
+        return false;
     }
     if (value.isTimeoutId()) {
-        marked_timeouts_.insert(value.asTimeoutId());
-        return;
+        timeouts_.mark(value.asTimeoutId());
+        return false;
     }
-  if (value.isChannelId()) {
-    marked_channels_.insert(value.asChannelId());
-    // Trace buffered values in the channel — they are live references
-    auto it = channels_.find(value.asChannelId());
-    if (it != channels_.end()) {
-      for (const auto &ch_val : it->second) {
-        markReference(ch_val);
-      }
+    if (value.isChannelId()) {
+        return channels_.mark(value.asChannelId());
+    }
+    if (value.isWaitGroupId()) {
+        waitgroups_.mark(value.asWaitGroupId());
+        return false;
     }
-    return;
-  }
-  if (value.isWaitGroupId()) {
-    marked_waitgroups_.insert(value.asWaitGroupId());
-    return;
-  }
     if (value.isCoroutineId()) {
-        marked_coroutines_.insert(value.asCoroutineId());
-        // Trace all Values inside the coroutine — stack, locals,
-        // caller_stack locals/stack, and yield_values are all live
-        // references that must prevent GC collection
-        auto it = coroutines_.find(value.asCoroutineId());
-        if (it != coroutines_.end()) {
-            const Coroutine &co = it->second;
-            for (const auto &v : co.stack) {
-                markReference(v);
-            }
-            for (const auto &v : co.locals) {
-                markReference(v);
-            }
-            for (const auto &cf : co.caller_stack) {
-                for (const auto &v : cf.locals) {
-                    markReference(v);
-                }
-                for (const auto &v : cf.stack) {
-                    markReference(v);
-                }
-            }
-            for (const auto &v : co.yield_values) {
-                markReference(v);
-            }
-        }
-        return;
+        return coroutines_.mark(value.asCoroutineId());
+    }
+    return false;
+}
+
+void GCHeap::markReference(const Value &value) {
+    if (shade(value)) {
+        mark_worklist_.push_back(value);
     }
 }
 
 void GCHeap::markRoots() {
-	for (const auto &value : root_stack_snapshot_) {
-		markReference(value);
-	}
-	for (const auto &value : root_locals_snapshot_) {
-		markReference(value);
-	}
-	if (root_globals_ptr_) {
-        for (const auto &[_, value] : *root_globals_ptr_) {
-            markReference(value);
-        }
+    if (roots_) {
+        auto visitor = rootVisitor([this](const Value &value) { markReference(value); });
+        roots_->visitRoots(visitor);
     }
     for (size_t i = 0; i < external_roots_.size(); i++) {
         if (external_roots_active_[i]) {
             markReference(external_roots_[i]);
         }
     }
-    for (uint32_t closure_id : root_closures_snapshot_) {
-        if (closure_id != 0) {
-            markReference(Value::makeClosureId(closure_id));
+
+    // A minor cycle does not trace the old generation, only the direct
+    // references of the old objects that may reach young ones: everything
+    // in the store buffer, and every old closure, since upvalue cells are
+    // written from several places that do not know which closures share
+    // the cell.
+    if (!current_collection_full_) {
+        auto mark_child = [this](const Value &child) { markReference(child); };
+        for (const Value &container : remembered_) {
+            traceValue(container, mark_child);
+        }
+        if (closures_.oldCount() != 0) {
+            for (auto [id, closure] : closures_) {
+                if (closures_.isOld(id)) {
+                    traceValue(Value::makeClosureId(id), mark_child);
+                }
+            }
         }
     }
-    for (const auto &value : root_extra_roots_snapshot_) {
-        markReference(value);
-    }
+}
 
-    if (!current_collection_full_) {
-        for (uint32_t id : old_arrays_) {
-            markReference(Value::makeArrayId(id));
+// Pushes each reference held by `value` through `push`. Only kinds that
+// shade() reports as needing a trace get here.
+template <typename Push>
+void GCHeap::traceValue(const Value &value, Push &&push) {
+    if (value.isArrayId()) {
+        const ArrayEntry *arr = arrays_.get(value.asArrayId());
+        if (!arr) {
+            return;
+        }
+        for (const auto &entry : *arr) {
+            push(entry);
+        }
+        return;
+    }
+    if (value.isObjectId()) {
+        const ObjectEntry *obj = objects_.get(value.asObjectId());
+        if (!obj) {
+            return;
         }
-        for (uint32_t id : old_objects_) {
-            markReference(Value::makeObjectId(id));
+        for (const Value &entry : obj->slots) {
+            push(entry);
         }
-        for (uint32_t id : old_sets_) {
-            markReference(Value::makeSetId(id));
+        return;
+    }
+    if (value.isStringId()) {
+        // Only ropes are queued; their halves keep the bytes.
+        auto it = ropes_.find(value.asStringId());
+        if (it != ropes_.end()) {
+            push(Value::makeStringId(it->second.left));
+            push(Value::makeStringId(it->second.right));
         }
-        for (uint32_t id : old_closures_) {
-            markReference(Value::makeClosureId(id));
+        return;
+    }
+    if (value.isSetId()) {
+        const ValueSet *set_ptr = sets_.get(value.asSetId());
+        if (!set_ptr) {
+            return;
         }
-        for (uint32_t id : old_strings_) {
-            markReference(Value::makeStringId(id));
+        for (const Value &member : *set_ptr) {
+            push(member);
         }
+        return;
     }
-}
-
-void GCHeap::markStep(size_t &work_budget) {
-    while (work_budget > 0 && !mark_worklist_.empty()) {
-        Value current = mark_worklist_.back();
-        mark_worklist_.pop_back();
-        work_budget--;
-
-        if (current.isArrayId()) {
-            auto it = arrays_.find(current.asArrayId());
-            if (it == arrays_.end()) {
+    if (value.isClosureId()) {
+        const RuntimeClosure *cl = closures_.get(value.asClosureId());
+        if (!cl) {
+            return;
+        }
+        for (const auto &cell : cl->upvalues) {
+            if (!cell) {
                 continue;
             }
-            for (const auto &entry : it->second) {
-                markReference(entry);
+            if (cell->is_open) {
+                if (roots_) {
+                    uint32_t abs_index = cell->locals_base + cell->open_index;
+                    auto local_value = roots_->openLocal(abs_index);
+                    if (local_value.has_value()) {
+                        push(*local_value);
+                    }
+                }
+            } else {
+                push(cell->closed_value);
             }
-            continue;
         }
-        if (current.isObjectId()) {
-            auto it = objects_.find(current.asObjectId());
-            if (it == objects_.end()) {
-                continue;
-            }
-            for (const auto &[_, entry] : it->second.data) {
-                markReference(entry);
+        if (cl->module_globals) {
+            for (const auto &[_, gv] : *cl->module_globals) {
+                push(gv);
             }
-            continue;
         }
-        if (current.isSetId()) {
-            auto it = sets_.find(current.asSetId());
-            if (it == sets_.end()) {
-                continue;
+        if (cl->chunk) {
+            for (const auto &func : cl->chunk->getAllFunctions()) {
+                for (const auto &constVal : func.constants) {
+                    push(constVal);
+                }
             }
-            for (const auto &[_, entry] : it->second) {
-                markReference(entry);
+        }
+        return;
+    }
+    if (value.isErrorId()) {
+        if (const ErrorObject *err = errors_.get(value.asErrorId());
+            err && !err->cause.isNull()) {
+            push(err->cause);
+        }
+        return;
+    }
+    if (value.isIteratorId()) {
+        // Trace the iterable — the object being iterated can be the only
+        // reference keeping an array/object/string alive
+        if (const Iterator *iter = iterators_.get(value.asIteratorId())) {
+            push(iter->iterable);
+            for (const Value &member : iter->members) {
+                push(member);
             }
-            continue;
         }
-  if (current.isClosureId()) {
-      auto it = closures_.find(current.asClosureId());
-      if (it == closures_.end()) {
-        continue;
-      }
-      for (const auto &cell : it->second.upvalues) {
-        if (!cell) {
-          continue;
+        return;
+    }
+    if (value.isBoundMethodId()) {
+        if (const BoundMethod *bm = bound_methods_.get(value.asBoundMethodId())) {
+            push(bm->fn);
+            push(bm->self);
         }
-        if (cell->is_open) {
-          uint32_t abs_index = cell->locals_base + cell->open_index;
-          auto local_value = open_local_reader_snapshot_(abs_index);
-          if (local_value.has_value()) {
-            markReference(*local_value);
-          }
-        } else {
-          markReference(cell->closed_value);
+        return;
+    }
+    if (value.isEnumId()) {
+        if (const auto *e = enums_.get(value.asEnumId())) {
+            for (const auto &entry : e->second) {
+                push(entry);
+            }
         }
-      }
-      if (it->second.module_globals) {
-        for (const auto &[_, gv] : *it->second.module_globals) {
-          markReference(gv);
+        return;
+    }
+    if (value.isChannelId()) {
+        // Buffered values in the channel are live references
+        if (const auto *buffered = channels_.get(value.asChannelId())) {
+            for (const auto &ch_val : *buffered) {
+                push(ch_val);
+            }
         }
-      }
-      if (it->second.chunk) {
-        for (const auto &func : it->second.chunk->getAllFunctions()) {
-          for (const auto &constVal : func.constants) {
-            markReference(constVal);
-          }
+        return;
+    }
+    if (value.isCoroutineId()) {
+        // Stack, locals, caller frames and yield_values of a suspended
+        // coroutine are all live references
+        if (const Coroutine *co = coroutines_.get(value.asCoroutineId())) {
+            for (const auto &v : co->stack) {
+                push(v);
+            }
+            for (const auto &v : co->locals) {
+                push(v);
+            }
+            for (const auto &cf : co->caller_stack) {
+                for (const auto &v : cf.locals) {
+                    push(v);
+                }
+                for (const auto &v : cf.stack) {
+                    push(v);
+                }
+            }
+            for (const auto &v : co->yield_values) {
+                push(v);
+            }
         }
-      }
-      continue;
+        return;
     }
+}
+
+void GCHeap::markStep(size_t &work_budget) {
+    const auto mark_start = std::chrono::steady_clock::now();
+    while (work_budget > 0 && !mark_worklist_.empty()) {
+        Value current = mark_worklist_.back();
+        mark_worklist_.pop_back();
+        work_budget--;
+
+        traceValue(current, [this](const Value &child) { markReference(child); });
     }
 
     if (mark_worklist_.empty()) {
         markRoots();
         if (mark_worklist_.empty()) {
-            gc_state_ = IncrementalState::SweepArrays;
-            snapshotSweepKeys();
+            beginSweep();
         }
     }
+    mark_ns_in_cycle_ += static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - mark_start).count());
 }
 
-void GCHeap::snapshotSweepKeys() {
-    sweep_keys_.clear();
-    sweep_index_ = 0;
-    sweep_phase_ = gc_state_;
+void GCHeap::setMarkThreads(size_t threads) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const size_t helpers = threads > 1 ? threads - 1 : 0;
+    if (helpers == (mark_workers_ ? mark_workers_->workerCount() - 1 : 0)) {
+        return;
+    }
+    mark_workers_.reset();
+    if (helpers > 0) {
+        mark_workers_ = std::make_unique<MarkWorkers>(helpers);
+    }
 }
 
-void GCHeap::sweepStep(size_t &work_budget) {
-    auto sweep_container = [this, &work_budget](auto &container, auto &marked_set,
-        auto &ages_map, auto &old_set, auto promote_fn) -> bool {
-        if (sweep_index_ >= sweep_keys_.size()) {
-            return true;
-        }
+size_t GCHeap::markThreads() const {
+    return mark_workers_ ? mark_workers_->workerCount() : 1;
+}
 
-        uint32_t id = sweep_keys_[sweep_index_++];
-        work_budget--;
+namespace {
 
-        auto it = container.find(id);
-        if (it == container.end()) {
+// One per marking thread. `local` is private to its owner; `shared` is the
+// part other workers may steal from.
+struct alignas(64) MarkDeque {
+    std::vector<Value> local;
+    std::mutex mutex;
+    std::vector<Value> shared;
+};
+
+} // namespace
+
+// Drains mark_worklist_ on the VM thread and the helper threads together.
+// Only called from finishMark, while the mutator is stopped, so the
+// heap is read-only apart from mark bits, which Slab::mark sets atomically.
+// Each worker traces depth-first from its own stack and, while some other
+// worker is idle and nothing is up for grabs, moves a batch to its shared
+// deque. Idle workers steal half of another worker's shared deque. The
+// phase ends when every worker is idle and no shared work is left.
+void GCHeap::drainMarkParallel() {
+    const size_t workers = mark_workers_->workerCount();
+    std::vector<MarkDeque> deques(workers);
+    std::atomic<size_t> shared_total{mark_worklist_.size()};
+    std::atomic<size_t> idle{0};
+    deques[0].shared.swap(mark_worklist_);
+
+    auto take = [&shared_total](MarkDeque &from, std::vector<Value> &into, bool half) {
+        std::lock_guard<std::mutex> lock(from.mutex);
+        if (from.shared.empty()) {
             return false;
         }
-
-        const bool is_old = old_set.find(id) != old_set.end();
-        const bool can_collect = current_collection_full_ || !is_old;
-
-        if (can_collect && marked_set.find(id) == marked_set.end()) {
-            container.erase(it);
-            ages_map.erase(id);
-            old_set.erase(id);
-            recovered_in_cycle_++;
-            cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-            subHeapBytes(64);
-        } else if (!is_old) {
-            promote_fn(id);
-        }
-
-        return false;
+        const size_t n = half ? std::max<size_t>(1, from.shared.size() / 2) : from.shared.size();
+        into.insert(into.end(), from.shared.end() - static_cast<std::ptrdiff_t>(n), from.shared.end());
+        from.shared.erase(from.shared.end() - static_cast<std::ptrdiff_t>(n), from.shared.end());
+        shared_total.fetch_sub(n, std::memory_order_acq_rel);
+        return true;
     };
 
-  switch (gc_state_) {
-  case IncrementalState::Idle:
-    break;
-  case IncrementalState::Mark:
-    break;
-  case IncrementalState::SweepArrays:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : arrays_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
-            }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                auto it = arrays_.find(id);
-                if (it == arrays_.end()) {
-                    continue;
-                }
-
-                const bool is_old = old_arrays_.find(id) != old_arrays_.end();
-                const bool can_collect = current_collection_full_ || !is_old;
-
-      if (can_collect && marked_arrays_.find(id) == marked_arrays_.end()) {
-        arrays_.erase(it);
-        array_ages_.erase(id);
-        old_arrays_.erase(id);
-        cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-        subHeapBytes(64);
-        recovered_in_cycle_++;
-      } else if (!is_old) {
-                    ageOrPromoteArray(id);
-                }
+    mark_workers_->run([&](size_t self) {
+        MarkDeque &mine = deques[self];
+        std::vector<Value> &local = mine.local;
+        auto push = [this, &local](const Value &child) {
+            if (shade(child)) {
+                local.push_back(child);
             }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepObjects;
-                sweep_index_ = 0;
+        };
+        auto find_work = [&] {
+            if (take(mine, local, false)) {
+                return true;
             }
-            break;
-
-        case IncrementalState::SweepObjects:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : objects_) {
-                    sweep_keys_.push_back(kv.first);
+            for (size_t i = 1; i < workers; ++i) {
+                if (take(deques[(self + i) % workers], local, true)) {
+                    return true;
                 }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                auto it = objects_.find(id);
-                if (it == objects_.end()) {
-                    continue;
+            return false;
+        };
+
+        for (;;) {
+            while (!local.empty()) {
+                const Value current = local.back();
+                local.pop_back();
+                traceValue(current, push);
+
+                if (local.size() > kMarkShareBatch &&
+                    idle.load(std::memory_order_relaxed) != 0 &&
+                    shared_total.load(std::memory_order_relaxed) == 0) {
+                    std::lock_guard<std::mutex> lock(mine.mutex);
+                    const auto batch = local.end() - static_cast<std::ptrdiff_t>(kMarkShareBatch);
+                    mine.shared.insert(mine.shared.end(), batch, local.end());
+                    local.erase(batch, local.end());
+                    shared_total.fetch_add(kMarkShareBatch, std::memory_order_acq_rel);
                 }
-
-                const bool is_old = old_objects_.find(id) != old_objects_.end();
-                const bool can_collect = current_collection_full_ || !is_old;
-
-    if (can_collect && marked_objects_.find(id) == marked_objects_.end()) {
-      auto *obj = object(id);
-      if (obj) {
-        auto it = obj->find("op_destructor");
-        if (it != obj->end() && (it->second.isFunctionObjId() || it->second.isClosureId() || it->second.isHostFuncId())) {
-          finalizer_queue_.emplace_back(id, std::move(*obj));
-        }
-      }
-      objects_.erase(it);
-      object_ages_.erase(id);
-      old_objects_.erase(id);
-      cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-      subHeapBytes(64);
-      recovered_in_cycle_++;
-    } else if (!is_old) {
-      ageOrPromoteObject(id);
-    }
-            }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepSets;
-                sweep_index_ = 0;
             }
-            break;
-
-        case IncrementalState::SweepSets:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : sets_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+            if (find_work()) {
+                continue;
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
 
-                auto it = sets_.find(id);
-                if (it == sets_.end()) {
-                    continue;
+            // Idle. Only a busy worker can publish work, so once everyone
+            // is idle with nothing shared, marking is complete.
+            idle.fetch_add(1, std::memory_order_acq_rel);
+            for (;;) {
+                if (shared_total.load(std::memory_order_acquire) != 0) {
+                    idle.fetch_sub(1, std::memory_order_acq_rel);
+                    break;
                 }
-
-                const bool is_old = old_sets_.find(id) != old_sets_.end();
-                const bool can_collect = current_collection_full_ || !is_old;
-
-      if (can_collect && marked_sets_.find(id) == marked_sets_.end()) {
-        sets_.erase(it);
-        set_ages_.erase(id);
-        old_sets_.erase(id);
-        cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-        subHeapBytes(64);
-        recovered_in_cycle_++;
-      } else if (!is_old) {
-        ageOrPromoteSet(id);
-      }
-            }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepClosures;
-                sweep_index_ = 0;
-            }
-            break;
-
-        case IncrementalState::SweepClosures:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : closures_) {
-                    sweep_keys_.push_back(kv.first);
+                if (idle.load(std::memory_order_acquire) == workers &&
+                    shared_total.load(std::memory_order_acquire) == 0) {
+                    return;
                 }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+                std::this_thread::yield();
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
+        }
+    });
 
-                auto it = closures_.find(id);
-                if (it == closures_.end()) {
-                    continue;
-                }
+    // Keep the worklist's capacity for the next cycle.
+    mark_worklist_.swap(deques[0].shared);
+    mark_worklist_.clear();
+}
 
-                const bool is_old = old_closures_.find(id) != old_closures_.end();
-                const bool can_collect = current_collection_full_ || !is_old;
-
-      if (can_collect && marked_closures_.find(id) == marked_closures_.end()) {
-        closures_.erase(it);
-        closure_ages_.erase(id);
-        old_closures_.erase(id);
-        cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-        subHeapBytes(64);
-        recovered_in_cycle_++;
-      } else if (!is_old) {
-        ageOrPromoteClosure(id);
-      }
-    }
-    if (sweep_index_ >= sweep_keys_.size()) {
-      gc_state_ = IncrementalState::SweepStrings;
-      sweep_index_ = 0;
-    }
-    break;
-
-  case IncrementalState::SweepStrings:
-        if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-            sweep_keys_.clear();
-            for (const auto &kv : strings_) {
-                sweep_keys_.push_back(kv.first);
-            }
-            sweep_index_ = 0;
-            sweep_phase_ = gc_state_;
-        }
-        while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-            uint32_t id = sweep_keys_[sweep_index_++];
-            work_budget--;
+// Marks until the worklist and a final root rescan come up empty, on the
+// helper threads too when they are configured and the heap is big enough.
+void GCHeap::finishMark() {
+    if (gc_state_ != IncrementalState::Mark) {
+        return;
+    }
+    if (mark_workers_ && cached_object_count_.load(std::memory_order_relaxed) >= kParallelMarkMinObjects) {
+        const auto mark_start = std::chrono::steady_clock::now();
+        drainMarkParallel();
+        mark_ns_in_cycle_ += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - mark_start).count());
+    }
+    while (gc_state_ == IncrementalState::Mark) {
+        size_t budget = std::numeric_limits<size_t>::max();
+        markStep(budget);
+    }
+}
 
-            auto it = strings_.find(id);
-            if (it == strings_.end()) {
-                continue;
-            }
+void GCHeap::beginSweep() {
+    auto from_slab = [this](SweepKind kind, const auto &slab) {
+        sweep_cursors_[static_cast<size_t>(kind)] = SweepCursor{1, slab.indexLimit()};
+    };
+    from_slab(SweepKind::Arrays, arrays_);
+    from_slab(SweepKind::Objects, objects_);
+    from_slab(SweepKind::Sets, sets_);
+    from_slab(SweepKind::Closures, closures_);
+    from_slab(SweepKind::Strings, strings_);
+    from_slab(SweepKind::Iterators, iterators_);
+    from_slab(SweepKind::BoundMethods, bound_methods_);
+    from_slab(SweepKind::Ranges, ranges_);
+    from_slab(SweepKind::Errors, errors_);
+    from_slab(SweepKind::Enums, enums_);
+    from_slab(SweepKind::Coroutines, coroutines_);
+    from_slab(SweepKind::Threads, threads_);
+    from_slab(SweepKind::Intervals, intervals_);
+    from_slab(SweepKind::Timeouts, timeouts_);
+    from_slab(SweepKind::Channels, channels_);
+    from_slab(SweepKind::WaitGroups, waitgroups_);
+    from_slab(SweepKind::Bytes, bytes_);
+    sweep_kind_ = 0;
+    gc_state_ = IncrementalState::Sweep;
+}
 
-            const bool is_old = old_strings_.find(id) != old_strings_.end();
-            const bool can_collect = current_collection_full_ || !is_old;
+void GCHeap::sweepStep(size_t &work_budget) {
+    while (work_budget > 0 && gc_state_ == IncrementalState::Sweep) {
+        work_budget -= sweepKind(static_cast<SweepKind>(sweep_kind_), work_budget);
+        advanceSweep();
+    }
+}
 
-    if (can_collect && marked_strings_.find(id) == marked_strings_.end()) {
-      strings_.erase(it);
-      string_ages_.erase(id);
-      old_strings_.erase(id);
-      cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-      subHeapBytes(64);
-      recovered_in_cycle_++;
-    } else if (!is_old) {
-      ageOrPromoteString(id);
+void GCHeap::finishSweep() {
+    while (gc_state_ == IncrementalState::Sweep) {
+        size_t budget = std::numeric_limits<size_t>::max();
+        sweepStep(budget);
     }
-  }
-  if (sweep_index_ >= sweep_keys_.size()) {
-            gc_state_ = IncrementalState::SweepIterators;
-            sweep_index_ = 0;
-        }
-        break;
+}
 
-        case IncrementalState::SweepIterators:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : iterators_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
-            }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
+// Skips kinds whose cursor is done and completes the cycle after the last.
+void GCHeap::advanceSweep() {
+    while (sweep_kind_ < kSweepKindCount &&
+           sweep_cursors_[sweep_kind_].next >= sweep_cursors_[sweep_kind_].end) {
+        ++sweep_kind_;
+    }
+    if (sweep_kind_ >= kSweepKindCount && gc_state_ == IncrementalState::Sweep) {
+        gc_state_ = IncrementalState::Idle;
+        completeCollection();
+    }
+}
 
-                if (marked_iterators_.find(id) == marked_iterators_.end()) {
-                    iterators_.erase(id);
-                    recovered_in_cycle_++;
-                }
-            }
-        if (sweep_index_ >= sweep_keys_.size()) {
-            gc_state_ = IncrementalState::SweepBoundMethods;
-            sweep_index_ = 0;
-        }
-        break;
+void GCHeap::noteSwept(size_t bytes) {
+    cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
+    subHeapBytes(bytes);
+    recovered_in_cycle_++;
+}
 
-    case IncrementalState::SweepBoundMethods:
-        if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-            sweep_keys_.clear();
-            for (const auto &kv : bound_methods_) {
-                sweep_keys_.push_back(kv.first);
-            }
-            sweep_index_ = 0;
-            sweep_phase_ = gc_state_;
-        }
-        while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-            uint32_t id = sweep_keys_[sweep_index_++];
-            work_budget--;
-
-          if (marked_bound_methods_.find(id) == marked_bound_methods_.end()) {
-            bound_methods_.erase(id);
-            cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-            subHeapBytes(64);
-            recovered_in_cycle_++;
-          }
+// Visits up to `budget` slots of `slab` from the cursor, handing each live
+// id to `sweep_one`. Returns the number of slots visited.
+template <typename T, typename Fn>
+size_t GCHeap::sweepSlots(Slab<T> &slab, SweepCursor &cursor, size_t budget, Fn &&sweep_one) {
+    size_t visited = 0;
+    while (visited < budget && cursor.next < cursor.end) {
+        const uint32_t id = slab.idAt(cursor.next++);
+        ++visited;
+        if (id != 0) {
+            sweep_one(id);
         }
-        if (sweep_index_ >= sweep_keys_.size()) {
-          gc_state_ = IncrementalState::SweepRanges;
-          sweep_index_ = 0;
-        }
-        break;
-
-    case IncrementalState::SweepRanges:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : ranges_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
-            }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-          if (marked_ranges_.find(id) == marked_ranges_.end()) {
-            ranges_.erase(id);
-            cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-            subHeapBytes(64);
-            recovered_in_cycle_++;
-          }
-            }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepErrors;
-                sweep_index_ = 0;
-            }
-        break;
-
-      case IncrementalState::SweepErrors:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : errors_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+    }
+    return visited;
+}
+
+// Frees each unmarked object the cycle may collect (minor cycles leave old
+// objects alone) and ages the young survivors.
+size_t GCHeap::sweepKind(SweepKind kind, size_t budget) {
+    SweepCursor &cursor = sweep_cursors_[static_cast<size_t>(kind)];
+    switch (kind) {
+    case SweepKind::Arrays:
+        return sweepSlots(arrays_, cursor, budget, [this](uint32_t id) {
+            const bool is_old = arrays_.isOld(id);
+            if ((current_collection_full_ || !is_old) && !arrays_.isMarked(id)) {
+                arrays_.erase(id);
+                array_ages_.erase(id);
+                noteSwept(64);
+            } else if (!is_old) {
+                ageOrPromoteArray(id);
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                if (marked_errors_.find(id) == marked_errors_.end()) {
-                    errors_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-                    recovered_in_cycle_++;
+        });
+    case SweepKind::Objects:
+        return sweepSlots(objects_, cursor, budget, [this](uint32_t id) {
+            const bool is_old = objects_.isOld(id);
+            if ((current_collection_full_ || !is_old) && !objects_.isMarked(id)) {
+                // Destructors run later, on the VM thread, via drainFinalizers.
+                ObjectEntry *obj = objects_.get(id);
+                auto it = obj->find("op_destructor");
+                if (it != obj->end() && (it->second.isFunctionObjId() || it->second.isClosureId() || it->second.isHostFuncId())) {
+                    finalizer_queue_.emplace_back(id, std::move(*obj));
                 }
+                objects_.erase(id);
+                object_ages_.erase(id);
+                noteSwept(64);
+            } else if (!is_old) {
+                ageOrPromoteObject(id);
             }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepEnums;
-                sweep_index_ = 0;
+        });
+    case SweepKind::Sets:
+        return sweepSlots(sets_, cursor, budget, [this](uint32_t id) {
+            const bool is_old = sets_.isOld(id);
+            if ((current_collection_full_ || !is_old) && !sets_.isMarked(id)) {
+                sets_.erase(id);
+                set_versions_.erase(id);
+                set_ages_.erase(id);
+                noteSwept(64);
+            } else if (!is_old) {
+                ageOrPromoteSet(id);
             }
-            break;
-
-        case IncrementalState::SweepEnums:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : enums_) {
-                    sweep_keys_.push_back(kv.first);
+        });
+    case SweepKind::Closures:
+        return sweepSlots(closures_, cursor, budget, [this](uint32_t id) {
+            const bool is_old = closures_.isOld(id);
+            if ((current_collection_full_ || !is_old) && !closures_.isMarked(id)) {
+                for (UpvalueCell *cell : closures_.get(id)->upvalues) {
+                    if (cell) {
+                        releaseUpvalue(cell);
+                    }
                 }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+                closures_.erase(id);
+                closure_ages_.erase(id);
+                noteSwept(64);
+            } else if (!is_old) {
+                ageOrPromoteClosure(id);
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                if (marked_enums_.find(id) == marked_enums_.end()) {
-                    enums_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-                    recovered_in_cycle_++;
+        });
+    case SweepKind::Strings:
+        return sweepSlots(strings_, cursor, budget, [this](uint32_t id) {
+            const bool is_old = strings_.isOld(id);
+            if ((current_collection_full_ || !is_old) && !strings_.isMarked(id)) {
+                if (!interned_ids_.empty() && interned_ids_.erase(id)) {
+                    interned_.erase(std::string_view(*strings_.get(id)));
                 }
-            }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepCoroutines;
-                sweep_index_ = 0;
-            }
-            break;
-
-        case IncrementalState::SweepCoroutines:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : coroutines_) {
-                    sweep_keys_.push_back(kv.first);
+                strings_.erase(id);
+                if (ropes_.erase(id)) {
+                    rope_count_.fetch_sub(1, std::memory_order_release);
                 }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+                utf8_indices_.erase(id);
+                string_ages_.erase(id);
+                noteSwept(64);
+            } else if (!is_old) {
+                ageOrPromoteString(id);
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                if (marked_coroutines_.find(id) == marked_coroutines_.end()) {
-                    if (auto *co = coroutine(id); co && co->state != Coroutine::Done) {
-                        continue;
-                    }
-                    coroutines_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-                    recovered_in_cycle_++;
-                }
+        });
+    case SweepKind::Iterators:
+        return sweepSlots(iterators_, cursor, budget, [this](uint32_t id) {
+            if (!iterators_.isMarked(id)) {
+                iterators_.erase(id);
+                noteSwept(64);
             }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepThreads;
-                sweep_index_ = 0;
+        });
+    case SweepKind::BoundMethods:
+        return sweepSlots(bound_methods_, cursor, budget, [this](uint32_t id) {
+            if (!bound_methods_.isMarked(id)) {
+                bound_methods_.erase(id);
+                noteSwept(64);
             }
-            break;
-
-        case IncrementalState::SweepThreads:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : threads_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+        });
+    case SweepKind::Ranges:
+        return sweepSlots(ranges_, cursor, budget, [this](uint32_t id) {
+            if (!ranges_.isMarked(id)) {
+                ranges_.erase(id);
+                noteSwept(64);
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                if (marked_threads_.find(id) == marked_threads_.end()) {
-                    if (auto *t = thread(id); t && t->isRunning()) {
-                        continue;
-                    }
-                    threads_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-                    recovered_in_cycle_++;
-                }
+        });
+    case SweepKind::Errors:
+        return sweepSlots(errors_, cursor, budget, [this](uint32_t id) {
+            if (!errors_.isMarked(id)) {
+                errors_.erase(id);
+                noteSwept(64);
             }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepIntervals;
-                sweep_index_ = 0;
+        });
+    case SweepKind::Enums:
+        return sweepSlots(enums_, cursor, budget, [this](uint32_t id) {
+            if (!enums_.isMarked(id)) {
+                enums_.erase(id);
+                noteSwept(64);
             }
-            break;
-
-        case IncrementalState::SweepIntervals:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : intervals_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+        });
+    case SweepKind::Coroutines:
+        return sweepSlots(coroutines_, cursor, budget, [this](uint32_t id) {
+            // A coroutine that has not finished stays, reachable or not.
+            if (!coroutines_.isMarked(id) && coroutines_.get(id)->state == Coroutine::Done) {
+                coroutines_.erase(id);
+                noteSwept(64);
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-if (marked_intervals_.find(id) == marked_intervals_.end()) {
-intervals_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-recovered_in_cycle_++;
+        });
+    case SweepKind::Threads:
+        return sweepSlots(threads_, cursor, budget, [this](uint32_t id) {
+            if (!threads_.isMarked(id)) {
+                if (auto *t = thread(id); t && t->isRunning()) {
+                    return;
                 }
+                threads_.erase(id);
+                noteSwept(64);
             }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepTimeouts;
-                sweep_index_ = 0;
+        });
+    case SweepKind::Intervals:
+        return sweepSlots(intervals_, cursor, budget, [this](uint32_t id) {
+            if (!intervals_.isMarked(id)) {
+                intervals_.erase(id);
+                noteSwept(64);
             }
-            break;
-
-        case IncrementalState::SweepTimeouts:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : timeouts_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+        });
+    case SweepKind::Timeouts:
+        return sweepSlots(timeouts_, cursor, budget, [this](uint32_t id) {
+            if (!timeouts_.isMarked(id)) {
+                timeouts_.erase(id);
+                noteSwept(64);
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                if (marked_timeouts_.find(id) == marked_timeouts_.end()) {
-                    timeouts_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-                    recovered_in_cycle_++;
-                }
+        });
+    case SweepKind::Channels:
+        return sweepSlots(channels_, cursor, budget, [this](uint32_t id) {
+            if (!channels_.isMarked(id)) {
+                channels_.erase(id);
+                noteSwept(64);
             }
-            if (sweep_index_ >= sweep_keys_.size()) {
-                gc_state_ = IncrementalState::SweepChannels;
-                sweep_index_ = 0;
+        });
+    case SweepKind::WaitGroups:
+        return sweepSlots(waitgroups_, cursor, budget, [this](uint32_t id) {
+            if (!waitgroups_.isMarked(id)) {
+                waitgroups_.erase(id);
+                noteSwept(64);
             }
-            break;
-
-        case IncrementalState::SweepChannels:
-            if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-                sweep_keys_.clear();
-                for (const auto &kv : channels_) {
-                    sweep_keys_.push_back(kv.first);
-                }
-                sweep_index_ = 0;
-                sweep_phase_ = gc_state_;
+        });
+    case SweepKind::Bytes:
+        return sweepSlots(bytes_, cursor, budget, [this](uint32_t id) {
+            if (bytes_.isMarked(id)) {
+                return;
             }
-            while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-                uint32_t id = sweep_keys_[sweep_index_++];
-                work_budget--;
-
-                if (marked_channels_.find(id) == marked_channels_.end()) {
-                    channels_.erase(id);
-            cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-            subHeapBytes(64);
-                    recovered_in_cycle_++;
-                }
+            // The storage block is charged once, to the buffer that created
+            // it, and given back by whichever view of it goes last.
+            const ByteBuffer *buf = bytes_.get(id);
+            size_t freed = sizeof(ByteBuffer);
+            if (buf->storage && buf->storage.use_count() == 1) {
+                freed += buf->storage->size();
             }
-  if (sweep_index_ >= sweep_keys_.size()) {
-    gc_state_ = IncrementalState::SweepWaitGroups;
-    sweep_index_ = 0;
-  }
-  break;
-
-case IncrementalState::SweepWaitGroups:
-  if (sweep_index_ == 0 || sweep_phase_ != gc_state_) {
-    sweep_keys_.clear();
-    for (const auto &kv : waitgroups_) {
-      sweep_keys_.push_back(kv.first);
-    }
-    sweep_index_ = 0;
-    sweep_phase_ = gc_state_;
-  }
-  while (work_budget > 0 && sweep_index_ < sweep_keys_.size()) {
-    uint32_t id = sweep_keys_[sweep_index_++];
-    work_budget--;
-
-    if (marked_waitgroups_.find(id) == marked_waitgroups_.end()) {
-      waitgroups_.erase(id);
-              cached_object_count_.fetch_sub(1, std::memory_order_relaxed);
-              subHeapBytes(64);
-      recovered_in_cycle_++;
+            bytes_.erase(id);
+            noteSwept(freed);
+        });
     }
-  }
-if (sweep_index_ >= sweep_keys_.size()) {
-gc_state_ = IncrementalState::Idle;
-sweep_index_ = 0;
-}
-break;
-}
+    return budget;
 }
 
 void GCHeap::completeCollection() {
@@ -1579,33 +1626,11 @@ void GCHeap::completeCollection() {
     allocations_since_last_ = 0;
     total_recovered_ += recovered_in_cycle_;
     collections_++;
+    last_mark_ns_ = mark_ns_in_cycle_;
 
     mark_worklist_.clear();
-    marked_arrays_.clear();
-    marked_objects_.clear();
-    marked_sets_.clear();
-    marked_closures_.clear();
-    marked_strings_.clear();
-    marked_iterators_.clear();
-    marked_bound_methods_.clear();
-    marked_ranges_.clear();
-    marked_errors_.clear();
-    marked_enums_.clear();
-    marked_coroutines_.clear();
-    marked_threads_.clear();
-    marked_intervals_.clear();
-    marked_timeouts_.clear();
-    marked_channels_.clear();
-  marked_waitgroups_.clear();
-
-    root_stack_snapshot_.clear();
-    root_locals_snapshot_.clear();
-    root_globals_ptr_ = nullptr;
-    root_closures_snapshot_.clear();
-    open_local_reader_snapshot_ = {};
-
-    sweep_keys_.clear();
-    sweep_index_ = 0;
+    clearMarks();
+    refineRememberedSet();
 
     if (current_collection_full_) {
         minor_collections_since_full_ = 0;
@@ -1613,25 +1638,97 @@ void GCHeap::completeCollection() {
     } else {
         minor_collections_since_full_++;
     }
-    if (current_collection_full_) {
-        compactIfShrunk(arrays_, 4);
-        compactIfShrunk(objects_, 4);
-        compactIfShrunk(strings_, 4);
-        compactIfShrunk(closures_, 4);
-    }
 
     if (debugging::debug_gc)
         std::cerr << "[GC] Collection complete: recovered " << recovered_in_cycle_
                   << " objects, new budget: " << allocation_budget_ << "\n";
 }
 
+// True for a reference a minor cycle may free: a young object of a kind
+// that is promoted, or any object of a kind that never is.
+bool GCHeap::isYoung(const Value &value) const {
+    if (value.isArrayId()) {
+        return !arrays_.isOld(value.asArrayId());
+    }
+    if (value.isObjectId()) {
+        return !objects_.isOld(value.asObjectId());
+    }
+    if (value.isSetId()) {
+        return !sets_.isOld(value.asSetId());
+    }
+    if (value.isClosureId()) {
+        return !closures_.isOld(value.asClosureId());
+    }
+    if (value.isStringId()) {
+        return !strings_.isOld(value.asStringId());
+    }
+    return value.isRangeId() || value.isBytesId() || value.isErrorId() || value.isIteratorId() ||
+           value.isBoundMethodId() || value.isEnumId() || value.isThreadId() ||
+           value.isIntervalId() || value.isTimeoutId() || value.isChannelId() ||
+           value.isWaitGroupId() || value.isCoroutineId();
+}
+
+void GCHeap::addRemembered(const Value &container) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    remembered_.push_back(container);
+}
+
+// Sets or clears the remembered bit of a store-buffer entry. Setting is
+// true only if the entry is live, old and was not remembered.
+bool GCHeap::setRemembered(const Value &container, bool remembered) {
+    auto apply = [remembered](auto &slab, uint32_t id) {
+        if (remembered) {
+            return slab.remember(id);
+        }
+        slab.forget(id);
+        return false;
+    };
+    if (container.isArrayId()) {
+        return apply(arrays_, container.asArrayId());
+    }
+    if (container.isObjectId()) {
+        return apply(objects_, container.asObjectId());
+    }
+    if (container.isSetId()) {
+        return apply(sets_, container.asSetId());
+    }
+    if (container.isStringId()) {
+        return apply(strings_, container.asStringId());
+    }
+    return false;
+}
+
+// Runs once a cycle is swept and its survivors aged. Keeps the entries
+// that still hold a young reference, once each, and forgets the rest, so
+// the store buffer tracks the old-to-young edges rather than every old
+// object written since the program started.
+void GCHeap::refineRememberedSet() {
+    for (const Value &container : remembered_) {
+        setRemembered(container, false);
+    }
+    size_t kept = 0;
+    for (const Value &container : remembered_) {
+        bool holds_young = false;
+        traceValue(container, [&](const Value &child) {
+            holds_young = holds_young || isYoung(child);
+        });
+        if (holds_young && setRemembered(container, true)) {
+            remembered_[kept++] = container;
+        }
+    }
+    remembered_.resize(kept);
+}
+
+// A promoted object starts out remembered: it may hold references to
+// objects younger than itself. refineRememberedSet forgets it at the end
+// of the cycle if it does not.
 void GCHeap::ageOrPromoteArray(uint32_t id) {
     auto &age = array_ages_[id];
     if (age < std::numeric_limits<uint8_t>::max()) {
         age++;
     }
-    if (age >= promotion_age_threshold_) {
-        old_arrays_.insert(id);
+    if (age >= promotion_age_threshold_ && arrays_.promote(id) && arrays_.remember(id)) {
+        remembered_.push_back(Value::makeArrayId(id));
     }
 }
 
@@ -1640,8 +1737,8 @@ void GCHeap::ageOrPromoteObject(uint32_t id) {
     if (age < std::numeric_limits<uint8_t>::max()) {
         age++;
     }
-    if (age >= promotion_age_threshold_) {
-        old_objects_.insert(id);
+    if (age >= promotion_age_threshold_ && objects_.promote(id) && objects_.remember(id)) {
+        remembered_.push_back(Value::makeObjectId(id));
     }
 }
 
@@ -1650,8 +1747,8 @@ void GCHeap::ageOrPromoteSet(uint32_t id) {
     if (age < std::numeric_limits<uint8_t>::max()) {
         age++;
     }
-    if (age >= promotion_age_threshold_) {
-        old_sets_.insert(id);
+    if (age >= promotion_age_threshold_ && sets_.promote(id) && sets_.remember(id)) {
+        remembered_.push_back(Value::makeSetId(id));
     }
 }
 
@@ -1661,7 +1758,7 @@ void GCHeap::ageOrPromoteClosure(uint32_t id) {
         age++;
     }
     if (age >= promotion_age_threshold_) {
-        old_closures_.insert(id);
+        closures_.promote(id);
     }
 }
 
@@ -1670,153 +1767,153 @@ void GCHeap::ageOrPromoteString(uint32_t id) {
     if (age < std::numeric_limits<uint8_t>::max()) {
         age++;
     }
-    if (age >= promotion_age_threshold_) {
-        old_strings_.insert(id);
+    // A rope's halves may be younger than the rope; flat strings hold no
+    // references.
+    if (age >= promotion_age_threshold_ && strings_.promote(id) && ropes_.count(id) != 0 &&
+        strings_.remember(id)) {
+        remembered_.push_back(Value::makeStringId(id));
     }
 }
 
-std::shared_ptr<GCHeap::UpvalueCell> GCHeap::createUpvalue(uint32_t index) {
-    auto cell = std::make_shared<UpvalueCell>();
+GCHeap::UpvalueCell *GCHeap::createUpvalue(uint32_t index, uint32_t locals_base) {
+    UpvalueCell *cell;
+    if (!free_upvalue_cells_.empty()) {
+        cell = free_upvalue_cells_.back();
+        free_upvalue_cells_.pop_back();
+    } else {
+        cell = &upvalue_cells_.emplace_back();
+    }
     cell->is_open = true;
     cell->open_index = index;
+    cell->locals_base = locals_base;
+    cell->refs = 0;
+    cell->closed_value = nullptr;
     return cell;
 }
 
+void GCHeap::releaseUpvalue(UpvalueCell *cell) {
+    if (cell->refs == 0 || --cell->refs > 0) {
+        return;
+    }
+    cell->is_open = false;
+    cell->closed_value = nullptr;
+    free_upvalue_cells_.push_back(cell);
+}
+
 ThreadRef GCHeap::allocateThreadObj(std::shared_ptr<::havel::Thread> thread) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_thread_id_++;
-    threads_.emplace(id, std::move(thread));
+    const uint32_t id = place(threads_, SweepKind::Threads, std::move(thread));
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return ThreadRef{.id = id};
 }
 
 IntervalRef GCHeap::allocateIntervalObj(std::shared_ptr<::havel::Interval> interval) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_interval_id_++;
-    intervals_.emplace(id, std::move(interval));
+    const uint32_t id = place(intervals_, SweepKind::Intervals, std::move(interval));
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return IntervalRef{.id = id};
 }
 
 TimeoutRef GCHeap::allocateTimeoutObj(std::shared_ptr<::havel::Timeout> timeout) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_timeout_id_++;
-    timeouts_.emplace(id, std::move(timeout));
+    const uint32_t id = place(timeouts_, SweepKind::Timeouts, std::move(timeout));
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return TimeoutRef{.id = id};
 }
 
 ChannelRef GCHeap::allocateChannel() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_channel_id_++;
-    channels_[id] = {};
+    const uint32_t id = place(channels_, SweepKind::Channels);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return ChannelRef{.id = id};
 }
 
 GCHeap::WaitGroupRef GCHeap::allocateWaitGroup() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_waitgroup_id_++;
-    waitgroups_[id] = std::make_unique<WaitGroup>();
+    const uint32_t id = place(waitgroups_, SweepKind::WaitGroups, std::make_unique<WaitGroup>());
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return WaitGroupRef{.id = id};
 }
 
 uint32_t GCHeap::allocateThread() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_thread_id_++;
-    threads_[id] = nullptr;
+    const uint32_t id = place(threads_, SweepKind::Threads, nullptr);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return id;
 }
 
 uint32_t GCHeap::allocateInterval() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_interval_id_++;
-    intervals_[id] = nullptr;
+    const uint32_t id = place(intervals_, SweepKind::Intervals, nullptr);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return id;
 }
 
 uint32_t GCHeap::allocateTimeout() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_timeout_id_++;
-    timeouts_[id] = nullptr;
+    const uint32_t id = place(timeouts_, SweepKind::Timeouts, nullptr);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return id;
 }
 
 uint32_t GCHeap::allocateCoroutine(uint32_t function_index, uint32_t chunk_index) {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    const uint32_t id = next_coroutine_id_++;
-    Coroutine co;
+    const uint32_t id = place(coroutines_, SweepKind::Coroutines);
+    Coroutine &co = *coroutines_.get(id);
     co.function_index = function_index;
     co.chunk_index = chunk_index;
     co.ip = 0;
     co.state = Coroutine::Runnable;
-    coroutines_[id] = std::move(co);
     cached_object_count_.fetch_add(1, std::memory_order_relaxed);
     return id;
 }
 
 ::havel::Thread* GCHeap::thread(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = threads_.find(id);
-return it == threads_.end() ? nullptr : it->second.get();
+    auto *slot = threads_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 const ::havel::Thread* GCHeap::thread(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = threads_.find(id);
-return it == threads_.end() ? nullptr : it->second.get();
+    auto *slot = threads_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 ::havel::Interval* GCHeap::interval(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = intervals_.find(id);
-return it == intervals_.end() ? nullptr : it->second.get();
+    auto *slot = intervals_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 const ::havel::Interval* GCHeap::interval(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = intervals_.find(id);
-return it == intervals_.end() ? nullptr : it->second.get();
+    auto *slot = intervals_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 ::havel::Timeout* GCHeap::timeout(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = timeouts_.find(id);
-return it == timeouts_.end() ? nullptr : it->second.get();
+    auto *slot = timeouts_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 const ::havel::Timeout* GCHeap::timeout(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = timeouts_.find(id);
-return it == timeouts_.end() ? nullptr : it->second.get();
+    auto *slot = timeouts_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 GCHeap::Coroutine* GCHeap::coroutine(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = coroutines_.find(id);
-return it == coroutines_.end() ? nullptr : &it->second;
+    return coroutines_.get(id);
 }
 
 const GCHeap::Coroutine* GCHeap::coroutine(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = coroutines_.find(id);
-return it == coroutines_.end() ? nullptr : &it->second;
+    return coroutines_.get(id);
 }
 
 GCHeap::WaitGroup* GCHeap::waitgroup(uint32_t id) {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = waitgroups_.find(id);
-return it == waitgroups_.end() ? nullptr : it->second.get();
+    auto *slot = waitgroups_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 const GCHeap::WaitGroup* GCHeap::waitgroup(uint32_t id) const {
-std::lock_guard<std::recursive_mutex> lock(mutex_);
-auto it = waitgroups_.find(id);
-return it == waitgroups_.end() ? nullptr : it->second.get();
+    auto *slot = waitgroups_.get(id);
+    return slot ? slot->get() : nullptr;
 }
 
 std::vector<std::pair<uint32_t, GCHeap::ObjectEntry>> GCHeap::drainFinalizers() {
@@ -1831,27 +1928,40 @@ std::vector<std::pair<uint32_t, GCHeap::ObjectEntry>> GCHeap::drainFinalizerQueu
 }
 
 void GCHeap::writeBarrier(const Value &obj, const Value &field) {
-    if (gc_state_ == IncrementalState::Idle) return;
+    if (gc_state_ != IncrementalState::Mark) return;
     markReference(obj);
     markReference(field);
 }
 
-void GCHeap::writeArrayBarrier(const std::vector<Value> &array, const Value &element) {
-    if (gc_state_ == IncrementalState::Idle) return;
-    for (const auto &v : array) markReference(v);
+void GCHeap::writeArrayBarrier(uint32_t array_id, const Value &element) {
+    if (isYoung(element) && arrays_.remember(array_id)) {
+        addRemembered(Value::makeArrayId(array_id));
+    }
+    if (gc_state_ != IncrementalState::Mark) return;
+    if (const ArrayEntry *array = arrays_.get(array_id)) {
+        for (const auto &v : *array) markReference(v);
+    }
     markReference(element);
 }
 
-void GCHeap::writeObjectBarrier(const std::unordered_map<std::string, Value> &obj, const std::string &key, const Value &value) {
-    if (gc_state_ == IncrementalState::Idle) return;
-    for (const auto &[k, v] : obj) markReference(v);
+void GCHeap::writeObjectBarrier(uint32_t object_id, const Value &value) {
+    if (isYoung(value) && objects_.remember(object_id)) {
+        addRemembered(Value::makeObjectId(object_id));
+    }
+    if (gc_state_ != IncrementalState::Mark) return;
+    if (const ObjectEntry *obj = objects_.get(object_id)) {
+        for (const Value &v : obj->slots) markReference(v);
+    }
     markReference(value);
 }
 
-void GCHeap::writeSetBarrier(const std::unordered_map<std::string, Value> &set, const std::string &key, const Value &value) {
-    if (gc_state_ == IncrementalState::Idle) return;
-    for (const auto &[k, v] : set) markReference(v);
-    markReference(value);
+void GCHeap::writeSetBarrier(const ValueSet &set, const Value &member) {
+    // Members are never overwritten, only added and removed, so shading the
+    // new member is enough; rescanning the whole set per add would make
+    // filling a large set quadratic while a cycle is running.
+    (void)set;
+    if (gc_state_ != IncrementalState::Mark) return;
+    markReference(member);
 }
 
 }
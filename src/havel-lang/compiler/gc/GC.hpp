@@ -1,20 +1,34 @@
 #pragma once
 
 #include "../core/BytecodeIR.hpp"
+#include "../vm/GlobalTable.hpp"
+#include "../vm/ValueStack.hpp"
+#include "MarkWorkers.hpp"
+#include "ObjectShape.hpp"
+#include "RootVisitor.hpp"
+#include "Slab.hpp"
+#include "Utf8Index.hpp"
+#include "ValueSet.hpp"
 #include "../../runtime/concurrency/Thread.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace havel::compiler {
@@ -29,15 +43,26 @@ public:
         uint64_t object_count = 0;
         uint64_t collections = 0;
         uint64_t last_pause_ns = 0;
+        // Time spent tracing in the last completed cycle, summed across
+        // its incremental steps.
+        uint64_t last_mark_ns = 0;
         uint64_t total_recovered = 0;
     };
 
+// Upvalue cells are allocated from an arena owned by the heap and passed
+// around as raw pointers. refs counts the heap closures holding the cell
+// plus one while it sits on the VM's open list; the cell returns to the
+// arena's free list when that reaches zero. Only the mutator thread touches
+// refs, so it is a plain counter rather than an atomic.
 struct UpvalueCell {
 bool is_open = false;
 uint32_t open_index = 0;
 uint32_t locals_base = 0;
+uint32_t refs = 0;
 Value closed_value = nullptr;
 
+uint32_t absoluteIndex() const { return locals_base + open_index; }
+
 Value get() const { return is_open ? nullptr : closed_value; }
 void set(Value value) { closed_value = value; }
 void close(Value value = nullptr) {
@@ -52,96 +77,172 @@ struct RuntimeClosure {
     uint32_t chunk_index = 0;
     const BytecodeChunk* chunk = nullptr;       // raw pointer for fast execution path
     std::shared_ptr<BytecodeChunk> chunk_ref;   // strong ref keeping chunk alive
-    std::shared_ptr<std::unordered_map<std::string, Value>> module_globals;
-    std::vector<std::shared_ptr<UpvalueCell>> upvalues;
+    ModuleGlobals module_globals;
+    std::vector<UpvalueCell *> upvalues;
 };
 
+// Objects keep their values in a dense slot vector laid out by a shared
+// ObjectShape (see ObjectShape.hpp). The map-like interface (get/set/find/
+// iteration as key/value pairs) is unchanged; iteration follows slot order,
+// i.e. insertion order. References into slots are invalidated when a key is
+// added or erased.
 struct ObjectEntry {
-std::unordered_map<std::string, Value> data;
-std::vector<std::string> insertionOrder;
-bool sorted = true;
-std::atomic<uint64_t> shape_version{1};
-
-ObjectEntry() = default;
-ObjectEntry(ObjectEntry &&o) noexcept
-    : data(std::move(o.data)),
-        insertionOrder(std::move(o.insertionOrder)),
-      sorted(o.sorted),
-      shape_version(o.shape_version.load(std::memory_order_relaxed)) {}
-ObjectEntry &operator=(ObjectEntry &&o) noexcept {
-    if (this != &o) {
-        data = std::move(o.data);
-        insertionOrder = std::move(o.insertionOrder);
-        sorted = o.sorted;
-        shape_version.store(o.shape_version.load(std::memory_order_relaxed),
-                            std::memory_order_relaxed);
-    }
-    return *this;
-}
-ObjectEntry(const ObjectEntry &) = delete;
-ObjectEntry &operator=(const ObjectEntry &) = delete;
-
-        Value *get(const std::string &key) {
-            auto it = data.find(key);
-            if (it != data.end())
-                return &it->second;
-            return nullptr;
+    template <bool Const> class SlotIterator {
+    public:
+        using Owner = std::conditional_t<Const, const ObjectEntry, ObjectEntry>;
+        using ValueRef = std::conditional_t<Const, const Value &, Value &>;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<std::string, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const std::string &, ValueRef>;
+        struct pointer {
+            reference ref;
+            reference *operator->() { return &ref; }
+        };
+
+        SlotIterator() = default;
+        SlotIterator(Owner *owner, size_t slot) : owner_(owner), slot_(slot) {}
+        // iterator -> const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        SlotIterator(const SlotIterator<false> &o)
+            : owner_(o.owner_), slot_(o.slot_) {}
+
+        reference operator*() const {
+            return {owner_->shape->keyAt(static_cast<uint32_t>(slot_)),
+                    owner_->slots[slot_]};
         }
-        const Value *get(const std::string &key) const {
-            auto it = data.find(key);
-            if (it != data.end())
-                return &it->second;
-            return nullptr;
+        pointer operator->() const { return pointer{**this}; }
+        SlotIterator &operator++() { ++slot_; return *this; }
+        SlotIterator operator++(int) { auto copy = *this; ++slot_; return copy; }
+        bool operator==(const SlotIterator &o) const { return slot_ == o.slot_; }
+        bool operator!=(const SlotIterator &o) const { return slot_ != o.slot_; }
+
+    private:
+        friend class SlotIterator<true>;
+        Owner *owner_ = nullptr;
+        size_t slot_ = 0;
+    };
+    using iterator = SlotIterator<false>;
+    using const_iterator = SlotIterator<true>;
+
+    std::shared_ptr<ObjectShape> shape = ObjectShape::empty();
+    std::vector<Value> slots;
+    bool sorted = true;
+    std::atomic<uint64_t> shape_version{1};
+
+    ObjectEntry() = default;
+    ObjectEntry(ObjectEntry &&o) noexcept
+        : shape(std::exchange(o.shape, ObjectShape::empty())),
+          slots(std::move(o.slots)),
+          sorted(o.sorted),
+          shape_version(o.shape_version.load(std::memory_order_relaxed)) {}
+    ObjectEntry &operator=(ObjectEntry &&o) noexcept {
+        if (this != &o) {
+            shape = std::exchange(o.shape, ObjectShape::empty());
+            slots = std::move(o.slots);
+            sorted = o.sorted;
+            shape_version.store(o.shape_version.load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
         }
+        return *this;
+    }
+    ObjectEntry(const ObjectEntry &) = delete;
+    ObjectEntry &operator=(const ObjectEntry &) = delete;
+
+    Value *get(const std::string &key) {
+        uint32_t slot = shape->slotOf(key);
+        return slot == ObjectShape::kNotFound ? nullptr : &slots[slot];
+    }
+    const Value *get(const std::string &key) const {
+        uint32_t slot = shape->slotOf(key);
+        return slot == ObjectShape::kNotFound ? nullptr : &slots[slot];
+    }
 
     void set(const std::string &key, Value value) {
-        auto [it, inserted] = data.insert_or_assign(key, std::move(value));
-        if (inserted) {
-            insertionOrder.push_back(key);
+        uint32_t slot = shape->slotOf(key);
+        if (slot == ObjectShape::kNotFound) {
+            addSlot(key, value);
+        } else {
+            slots[slot] = value;
         }
         shape_version.fetch_add(1, std::memory_order_relaxed);
     }
 
     Value &operator[](const std::string &key) {
-        auto [it, inserted] = data.try_emplace(key);
-        if (inserted) {
-            insertionOrder.push_back(key);
+        uint32_t slot = shape->slotOf(key);
+        if (slot == ObjectShape::kNotFound) {
+            addSlot(key, Value());
+            return slots.back();
         }
-        return it->second;
+        return slots[slot];
     }
 
-        auto begin() { return data.begin(); }
-        auto end() { return data.end(); }
-        auto begin() const { return data.begin(); }
-        auto end() const { return data.end(); }
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, slots.size()}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, slots.size()}; }
 
-        auto find(const std::string &key) { return data.find(key); }
-        auto find(const std::string &key) const { return data.find(key); }
-        size_t size() const { return data.size(); }
+    iterator find(const std::string &key) {
+        uint32_t slot = shape->slotOf(key);
+        return slot == ObjectShape::kNotFound ? end() : iterator{this, slot};
+    }
+    const_iterator find(const std::string &key) const {
+        uint32_t slot = shape->slotOf(key);
+        return slot == ObjectShape::kNotFound ? end() : const_iterator{this, slot};
+    }
+    size_t size() const { return slots.size(); }
+
+    // Erasing moves the last key/value into the vacated slot, so unsorted
+    // (`!{}`) key order sees the same swap-with-last as before.
     size_t erase(const std::string &key) {
-        auto it = std::find(insertionOrder.begin(), insertionOrder.end(), key);
-        if (it != insertionOrder.end()) {
-            std::swap(*it, insertionOrder.back());
-            insertionOrder.pop_back();
+        uint32_t slot = shape->slotOf(key);
+        if (slot == ObjectShape::kNotFound) {
+            return 0;
         }
-        auto erased = data.erase(key);
-        if (erased > 0) {
-            shape_version.fetch_add(1, std::memory_order_relaxed);
+        if (shape->isShared()) {
+            shape = shape->dictionaryCopy();
         }
-        return erased;
+        shape->removeSlot(slot);
+        slots[slot] = slots.back();
+        slots.pop_back();
+        shape_version.fetch_add(1, std::memory_order_relaxed);
+        return 1;
     }
 
-        std::vector<std::string> getKeys() const {
-            if (sorted) {
-                std::vector<std::string> keys;
-                for (const auto &[k, _] : data)
-                    keys.push_back(k);
-                std::sort(keys.begin(), keys.end());
-                return keys;
-            }
-            return insertionOrder;
+    // Inline-cache store paths: write a known slot, or add a key whose
+    // transition (`next` == shape->withKey(key)) was cached. Both count as
+    // a set() for shape_version.
+    void storeSlot(uint32_t slot, Value value) {
+        slots[slot] = value;
+        shape_version.fetch_add(1, std::memory_order_relaxed);
+    }
+    void appendSlot(const std::shared_ptr<ObjectShape> &next, Value value) {
+        shape = next;
+        slots.push_back(value);
+        shape_version.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<std::string> getKeys() const {
+        std::vector<std::string> keys = shape->keys();
+        if (sorted) {
+            std::sort(keys.begin(), keys.end());
         }
-    };
+        return keys;
+    }
+
+private:
+    void addSlot(const std::string &key, Value value) {
+        if (!shape->isShared()) {
+            shape->appendKey(key);
+        } else if (shape->slotCount() < ObjectShape::kMaxSharedSlots) {
+            shape = shape->withKey(key);
+        } else {
+            shape = shape->dictionaryCopy();
+            shape->appendKey(key);
+        }
+        slots.push_back(value);
+    }
+};
 
     struct ArrayEntry {
         std::vector<Value> data;
@@ -195,6 +296,9 @@ ObjectEntry &operator=(const ObjectEntry &) = delete;
         size_t index = 0;
         size_t codepoint_index = 0;
         std::vector<std::string> keys;
+        // Set members as of creation; marked with the iterator, since a
+        // member removed mid-loop may have no other reference.
+        std::vector<Value> members;
     };
 
     struct BoundMethod {
@@ -208,6 +312,37 @@ ObjectEntry &operator=(const ObjectEntry &) = delete;
         int64_t step = 1;
     };
 
+    // Packed binary data. Slices and typed views of a buffer share its
+    // storage block, which lives as long as any view of it does. `offset`
+    // and `length` are in bytes; `kind` decides what an element is when
+    // the buffer is indexed. Elements use native byte order.
+    struct ByteBuffer {
+        enum class Kind : uint8_t { U8, I32, F32, F64 };
+
+        std::shared_ptr<std::vector<uint8_t>> storage;
+        size_t offset = 0;
+        size_t length = 0;
+        Kind kind = Kind::U8;
+
+        static size_t elementSize(Kind k) {
+            switch (k) {
+            case Kind::U8: return 1;
+            case Kind::I32: return 4;
+            case Kind::F32: return 4;
+            case Kind::F64: return 8;
+            }
+            return 1;
+        }
+        size_t size() const { return length / elementSize(kind); }
+        uint8_t *data() { return storage ? storage->data() + offset : nullptr; }
+        const uint8_t *data() const { return storage ? storage->data() + offset : nullptr; }
+        // Element i as an int (U8, I32) or number (F32, F64); null if out of range.
+        Value get(size_t i) const;
+        // Stores v, converted to the element type. False if i is out of range
+        // or v is not a number.
+        bool set(size_t i, const Value &v);
+    };
+
     struct EnumType {
         std::string name;
         std::vector<std::string> variantNames;
@@ -228,12 +363,15 @@ ObjectEntry &operator=(const ObjectEntry &) = delete;
               column(col), cause(nullptr) {}
     };
 
+    // The resumer's execution window, parked while a coroutine runs. Its
+    // locals and operand stack are swapped out of the VM, not copied, and
+    // swapped back in when the coroutine yields or returns.
     struct CallerFrame {
         uint32_t coroutine_id = UINT32_MAX;
         size_t frame_count = 0;
         uint32_t ip = 0;
         std::vector<Value> locals;
-        std::vector<Value> stack;
+        ValueStack stack{0};
     };
 
     struct Coroutine {
@@ -244,7 +382,9 @@ ObjectEntry &operator=(const ObjectEntry &) = delete;
         const BytecodeChunk *chunk = nullptr;
         uint32_t ip = 0;
         uint32_t closure_id = 0;
-  std::vector<Value> stack;
+  // Owned by the coroutine while suspended; swapped into the VM while it
+  // runs (and empty here meanwhile).
+  ValueStack stack{0};
   std::vector<Value> locals;
   std::vector<CallerFrame> caller_stack;
   State state = Runnable;
@@ -265,14 +405,47 @@ struct WaitGroup {
 
     ClosureRef allocateClosure(RuntimeClosure closure);
     StringRef allocateString(std::string value);
+    // Returns the string's bytes, flattening it first if it is a rope.
     std::string *string(uint32_t id);
     const std::string *string(uint32_t id) const;
-    std::shared_ptr<UpvalueCell> createUpvalue(uint32_t index);
+    // Returns the live interned string with these bytes, allocating one only
+    // if there is none. Two interned ids hold equal strings exactly when the
+    // ids are equal. The table is weak: sweeping a string drops its entry.
+    StringRef internString(std::string_view value);
+    bool isInterned(uint32_t id) const;
+    // Codepoint index of a heap string, built on first use and dropped when
+    // the string is swept. Only worth it for strings of Utf8Index::kStride
+    // bytes or more; shorter ones are cheaper to scan.
+    const Utf8Index &utf8Index(uint32_t id);
+    // Joins two heap strings. Results of kRopeMinLength bytes or more are
+    // kept as a rope node over both halves and only flattened when string()
+    // is first asked for them, so a string built by repeated appends copies
+    // each byte once rather than once per append.
+    static constexpr size_t kRopeMinLength = 256;
+    StringRef concatStrings(uint32_t left_id, uint32_t right_id);
+    // Byte length without flattening.
+    size_t stringLength(uint32_t id) const;
+    // A fresh open cell for local `index` of the frame at `locals_base`,
+    // with no references yet. retainUpvalue/releaseUpvalue adjust refs;
+    // allocateClosure retains every cell of the closure and sweeping the
+    // closure releases them.
+    UpvalueCell *createUpvalue(uint32_t index, uint32_t locals_base = 0);
+    void retainUpvalue(UpvalueCell *cell) { ++cell->refs; }
+    void releaseUpvalue(UpvalueCell *cell);
+    size_t liveUpvalueCount() const {
+        return upvalue_cells_.size() - free_upvalue_cells_.size();
+    }
 
     ArrayRef allocateArray();
     ObjectRef allocateObject(bool sorted = false);
     SetRef allocateSet();
     RangeRef allocateRange(int64_t start, int64_t end, int64_t step);
+    // A fresh buffer owning `data`, viewed as U8.
+    BytesRef allocateBytes(std::vector<uint8_t> data);
+    // A view of `length` bytes of `base`'s storage starting `offset` bytes
+    // into `base`. The caller checks the range.
+    BytesRef allocateBytesView(const ByteBuffer &base, size_t offset,
+        size_t length, ByteBuffer::Kind kind);
     ErrorRef allocateError(const std::string &errorType,
         const std::string &message,
         const std::string &stackTrace = "", uint32_t line = 0,
@@ -283,19 +456,16 @@ struct WaitGroup {
     EnumRef allocateEnum(uint32_t typeId, uint32_t tag, size_t payloadCount);
 
     uint32_t enumTag(uint32_t id) const {
-        auto it = enums_.find(id);
-        if (it == enums_.end()) return 0;
-        return it->second.first;
+        auto *e = enums_.get(id);
+        return e ? e->first : 0;
     }
     const std::vector<Value>* enumPayloads(uint32_t id) const {
-        auto it = enums_.find(id);
-        if (it == enums_.end()) return nullptr;
-        return &it->second.second;
+        auto *e = enums_.get(id);
+        return e ? &e->second : nullptr;
     }
     std::vector<Value>* enumPayloadsMut(uint32_t id) {
-        auto it = enums_.find(id);
-        if (it == enums_.end()) return nullptr;
-        return &it->second.second;
+        auto *e = enums_.get(id);
+        return e ? &e->second : nullptr;
     }
 
     IteratorRef allocateIterator(const Value &iterable);
@@ -317,18 +487,37 @@ struct WaitGroup {
 
     RuntimeClosure *closure(uint32_t id);
     const RuntimeClosure *closure(uint32_t id) const;
+    // A mutable lookup of an old array, object or set puts it in the
+    // remembered set, since the caller may store a young reference into
+    // it; read-only callers should use the const overloads. The VM's store
+    // opcodes use arrayForStore/objectForStore instead and report the
+    // stored value through the write barrier, which remembers the
+    // container only when that value is young.
     ArrayEntry *array(uint32_t id);
     const ArrayEntry *array(uint32_t id) const;
+    ArrayEntry *arrayForStore(uint32_t id);
     ObjectEntry *object(uint32_t id);
     const ObjectEntry *object(uint32_t id) const;
-    std::unordered_map<std::string, Value> *set(uint32_t id);
-    const std::unordered_map<std::string, Value> *set(uint32_t id) const;
+    ObjectEntry *objectForStore(uint32_t id);
+    ValueSet *set(uint32_t id);
+    const ValueSet *set(uint32_t id) const;
+    // Canonical form of a set member: heap strings become their interned id
+    // (an uninterned string is adopted into the table rather than copied),
+    // integral doubles become ints, anything else is kept as is. Chunk
+    // constants (StringValId) must be resolved by the caller first.
+    Value setMember(const Value &value);
+    // Lookup-only variant: never allocates or interns. Empty when the value
+    // cannot be in any set, i.e. a string whose bytes nobody interned.
+    std::optional<Value> findSetMember(const Value &value) const;
+    std::optional<Value> findSetMember(std::string_view text) const;
     uint64_t setVersion(uint32_t id) const;
     void bumpSetVersion(uint32_t id);
     uint64_t arrayVersion(uint32_t id) const;
     void bumpArrayVersion(uint32_t id);
     Range *range(uint32_t id);
     const Range *range(uint32_t id) const;
+    ByteBuffer *bytes(uint32_t id);
+    const ByteBuffer *bytes(uint32_t id) const;
     Iterator *iterator(uint32_t id);
     const Iterator *iterator(uint32_t id) const;
     BoundMethod *boundMethod(uint32_t id);
@@ -363,16 +552,22 @@ const ::havel::Interval* interval(uint32_t id) const;
     uint8_t promotionAgeThreshold() const { return promotion_age_threshold_; }
     uint64_t approxHeapBytes() const { return approx_heap_bytes_.load(std::memory_order_relaxed); }
   uint64_t cachedObjectCount() const { return cached_object_count_.load(std::memory_order_relaxed); }
-  size_t oldArrayCount() const { return old_arrays_.size(); }
-  size_t oldObjectCount() const { return old_objects_.size(); }
-  size_t oldClosureCount() const { return old_closures_.size(); }
-  bool arrayExists(uint32_t id) const { return arrays_.find(id) != arrays_.end(); }
-  bool objectExists(uint32_t id) const { return objects_.find(id) != objects_.end(); }
-  bool closureExists(uint32_t id) const { return closures_.find(id) != closures_.end(); }
-  bool setExists(uint32_t id) const { return sets_.find(id) != sets_.end(); }
-  bool isMarkedArray(uint32_t id) const { return marked_arrays_.find(id) != marked_arrays_.end(); }
-  bool isMarkedObject(uint32_t id) const { return marked_objects_.find(id) != marked_objects_.end(); }
-  bool isMarkedClosure(uint32_t id) const { return marked_closures_.find(id) != marked_closures_.end(); }
+  size_t oldArrayCount() const { return arrays_.oldCount(); }
+  size_t oldObjectCount() const { return objects_.oldCount(); }
+  size_t oldClosureCount() const { return closures_.oldCount(); }
+  size_t rememberedCount() const { return remembered_.size(); }
+  bool arrayExists(uint32_t id) const { return arrays_.contains(id); }
+  bool objectExists(uint32_t id) const { return objects_.contains(id); }
+  bool closureExists(uint32_t id) const { return closures_.contains(id); }
+  bool setExists(uint32_t id) const { return sets_.contains(id); }
+  bool isMarkedArray(uint32_t id) const { return arrays_.isMarked(id); }
+  bool isMarkedObject(uint32_t id) const { return objects_.isMarked(id); }
+  bool isMarkedClosure(uint32_t id) const { return closures_.isMarked(id); }
+  // For VM caches that hold closure ids without rooting them. Returns
+  // whether a cached closure may be handed out again: mid-mark the hit is
+  // shaded like any new reference, but once marking is over an unmarked
+  // closure may already be condemned and has to be treated as a miss.
+  bool retainCachedClosure(uint32_t id);
   const auto& closures() const { return closures_; }
   bool isCollectionInProgress() const;
 
@@ -386,69 +581,38 @@ const ::havel::Interval* interval(uint32_t id) const;
 
     void setStopTheWorldMode(bool v) { stop_the_world_ = v; }
     bool isStopTheWorld() const { return stop_the_world_; }
-
-void maybeCollectGarbage(
-    const std::vector<Value> &stack_values,
-    const std::vector<Value> &locals,
-    const std::unordered_map<std::string, Value> &globals,
-    const std::vector<uint32_t> &active_closure_ids,
-    const std::function<std::optional<Value>(uint32_t)>
-        &open_local_reader,
-    const std::vector<Value> &extra_roots = {});
+    // Threads that trace a stop-the-world collection, counting the VM
+    // thread; 0 or 1 marks on the VM thread alone. Incremental steps are
+    // always marked on the VM thread.
+    void setMarkThreads(size_t threads);
+    size_t markThreads() const;
+
+    // Collector entry points. `roots` is visited in place for as long as
+    // the call runs and is not retained afterwards; pinned external roots
+    // and the remembered set are added by the heap itself.
+    void maybeCollectGarbage(const RootSource &roots);
+    // True when a safe point has anything to hand the collector: a cycle
+    // still marking or sweeping, or a collection due. When false,
+    // maybeCollectGarbage and stepGarbageCollection return without
+    // touching the roots.
+    bool collectionWorkPending() const {
+        return gc_state_ != IncrementalState::Idle || collection_requested_ ||
+               allocations_since_last_ >= allocation_budget_;
+    }
 
 void abortIncrementalCollection() {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     gc_state_ = IncrementalState::Idle;
     mark_worklist_.clear();
-    marked_arrays_.clear();
-    marked_objects_.clear();
-    marked_sets_.clear();
-    marked_closures_.clear();
-    marked_strings_.clear();
-    marked_ranges_.clear();
-    marked_errors_.clear();
-    marked_enums_.clear();
-    marked_iterators_.clear();
-    marked_bound_methods_.clear();
-    sweep_keys_.clear();
-    sweep_index_ = 0;
-    sweep_phase_ = IncrementalState::Idle;
+    clearMarks();
+    sweep_kind_ = kSweepKindCount;
     collection_requested_ = false;
 }
 
-    void
-    collectGarbage(const std::vector<Value> &stack_values,
-        const std::vector<Value> &locals,
-        const std::unordered_map<std::string, Value> &globals,
-        const std::vector<uint32_t> &active_closure_ids,
-        const std::function<std::optional<Value>(uint32_t)>
-        &open_local_reader,
-        const std::vector<Value> &extra_roots = {});
-
-    void
-    stepGarbageCollection(const std::vector<Value> &stack_values,
-        const std::vector<Value> &locals,
-        const std::unordered_map<std::string, Value> &globals,
-        const std::vector<uint32_t> &active_closure_ids,
-        const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-        size_t work_budget = 128,
-        const std::vector<Value> &extra_roots = {});
-
-    void forceFullCollection(
-        const std::vector<Value> &stack_values,
-        const std::vector<Value> &locals,
-        const std::unordered_map<std::string, Value> &globals,
-        const std::vector<uint32_t> &active_closure_ids,
-        const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-        const std::vector<Value> &extra_roots = {});
-
-    void
-    startIncrementalCollection(const std::vector<Value> &stack_values,
-        const std::vector<Value> &locals,
-        const std::unordered_map<std::string, Value> &globals,
-        const std::vector<uint32_t> &active_closure_ids,
-        const std::function<std::optional<Value>(uint32_t)> &open_local_reader,
-        const std::vector<Value> &extra_roots = {});
+    void collectGarbage(const RootSource &roots);
+    void stepGarbageCollection(const RootSource &roots, size_t work_budget = 128);
+    void forceFullCollection(const RootSource &roots);
+    void startIncrementalCollection(const RootSource &roots);
 
     std::vector<std::pair<uint32_t, ObjectEntry>> drainFinalizers();
 
@@ -461,41 +625,70 @@ private:
     enum class IncrementalState : uint8_t {
         Idle,
         Mark,
-        SweepArrays,
-        SweepObjects,
-        SweepSets,
-        SweepClosures,
-        SweepStrings,
-    SweepIterators,
-    SweepBoundMethods,
-    SweepRanges,
-        SweepErrors,
-        SweepEnums,
-        SweepCoroutines,
-        SweepThreads,
-        SweepIntervals,
-        SweepTimeouts,
-  SweepChannels,
-  SweepWaitGroups,
-};
+        // Marking is done; slabs are swept by allocation, by sweepStep
+        // from GC steps and safe points, and in full before the next cycle.
+        Sweep,
+    };
+
+    // Slabs in the order sweepStep visits them.
+    enum class SweepKind : uint8_t {
+        Arrays,
+        Objects,
+        Sets,
+        Closures,
+        Strings,
+        Iterators,
+        BoundMethods,
+        Ranges,
+        Errors,
+        Enums,
+        Coroutines,
+        Threads,
+        Intervals,
+        Timeouts,
+        Channels,
+        WaitGroups,
+        Bytes,
+    };
+    static constexpr size_t kSweepKindCount = static_cast<size_t>(SweepKind::Bytes) + 1;
+
+    // Slot range of one slab still to sweep this cycle. `end` is the
+    // slab's index limit when marking finished; slots past it were first
+    // used afterwards and hold only black objects.
+    struct SweepCursor {
+        uint32_t next = 0;
+        uint32_t end = 0;
+    };
 
-    void markValue(const Value &value,
-        std::unordered_set<uint32_t> &marked_arrays,
-        std::unordered_set<uint32_t> &marked_objects,
-        std::unordered_set<uint32_t> &marked_sets,
-        std::unordered_set<uint32_t> &marked_closures,
-        const std::function<std::optional<Value>(uint32_t)>
-        &open_local_reader) const;
+    template <typename T> bool shadeGenerational(Slab<T> &slab, uint32_t id);
+    bool shade(const Value &value);
+    template <typename Push> void traceValue(const Value &value, Push &&push);
     void markReference(const Value &value);
+    void drainMarkParallel();
+    void clearMarks();
     void markRoots();
     void markStep(size_t &work_budget);
+    void finishMark();
+    void beginSweep();
     void sweepStep(size_t &work_budget);
+    void finishSweep();
+    size_t sweepKind(SweepKind kind, size_t budget);
+    template <typename T, typename Fn>
+    size_t sweepSlots(Slab<T> &slab, SweepCursor &cursor, size_t budget, Fn &&sweep_one);
+    void advanceSweep();
+    void noteSwept(size_t bytes);
+    template <typename T, typename... Args>
+    uint32_t place(Slab<T> &slab, SweepKind kind, Args &&...args);
     void completeCollection();
 
     void writeBarrier(const Value &obj, const Value &field);
-    void writeArrayBarrier(const std::vector<Value> &array, const Value &element);
-    void writeObjectBarrier(const std::unordered_map<std::string, Value> &obj, const std::string &key, const Value &value);
-    void writeSetBarrier(const std::unordered_map<std::string, Value> &set, const std::string &key, const Value &value);
+    void writeArrayBarrier(uint32_t array_id, const Value &element);
+    void writeObjectBarrier(uint32_t object_id, const Value &value);
+    void writeSetBarrier(const ValueSet &set, const Value &member);
+    bool isYoung(const Value &value) const;
+    void addRemembered(const Value &container);
+    bool setRemembered(const Value &container, bool remembered);
+    void refineRememberedSet();
     void ageOrPromoteArray(uint32_t id);
     void ageOrPromoteObject(uint32_t id);
     void ageOrPromoteSet(uint32_t id);
@@ -506,47 +699,54 @@ void checkHeapLimit(size_t extra_bytes);
 void addHeapBytes(size_t bytes);
 void subHeapBytes(size_t bytes);
 
-void snapshotSweepKeys();
 
-    std::unordered_map<uint32_t, RuntimeClosure> closures_;
-    std::unordered_map<uint32_t, std::string> strings_;
-    std::unordered_map<uint32_t, ArrayEntry> arrays_;
-    std::unordered_map<uint32_t, ObjectEntry> objects_;
-    std::unordered_map<uint32_t, std::unordered_map<std::string, Value>> sets_;
+    // Each object kind lives in its own Slab (see Slab.hpp): ids index the
+    // slab directly and lookups take no lock. Side tables keyed by id below
+    // must drop an id when its object is swept, since the slot is reused.
+    Slab<RuntimeClosure> closures_;
+    Slab<std::string> strings_;
+    // Unflattened concatenations. A rope id also has an (empty) strings_
+    // entry, so ages, marking and sweeping treat it like any other string.
+    // rope_count_ lets string() skip the lock while there are no ropes.
+    struct RopeNode {
+        uint32_t left = 0;
+        uint32_t right = 0;
+        size_t length = 0;
+    };
+    std::unordered_map<uint32_t, RopeNode> ropes_;
+    std::atomic<size_t> rope_count_{0};
+    void flattenRope(uint32_t id);
+    // Keys view the bytes of the strings_ entry they map to; slab entries
+    // never move and interned strings are never ropes or written to.
+    std::unordered_map<std::string_view, uint32_t> interned_;
+    std::unordered_set<uint32_t> interned_ids_;
+    std::unordered_map<uint32_t, Utf8Index> utf8_indices_;
+    Slab<ArrayEntry> arrays_;
+    Slab<ObjectEntry> objects_;
+    Slab<ValueSet> sets_;
     std::unordered_map<uint32_t, uint64_t> set_versions_;
-    std::unordered_map<uint32_t, Range> ranges_;
-    std::unordered_map<uint32_t, ErrorObject> errors_;
-    std::unordered_map<uint32_t, std::pair<uint32_t, std::vector<Value>>> enums_;
-    std::unordered_map<uint32_t, Iterator> iterators_;
-    std::unordered_map<uint32_t, BoundMethod> bound_methods_;
-
-    std::unordered_map<uint32_t, std::shared_ptr<::havel::Thread>> threads_;
-    std::unordered_map<uint32_t, std::shared_ptr<::havel::Interval>> intervals_;
-    std::unordered_map<uint32_t, std::shared_ptr<::havel::Timeout>> timeouts_;
-    std::unordered_map<uint32_t, std::vector<Value>> channels_;
-  std::unordered_map<uint32_t, std::unique_ptr<WaitGroup>> waitgroups_;
-
-    std::unordered_map<uint32_t, Coroutine> coroutines_;
+    Slab<Range> ranges_;
+    Slab<ByteBuffer> bytes_;
+    Slab<ErrorObject> errors_;
+    Slab<std::pair<uint32_t, std::vector<Value>>> enums_;
+    Slab<Iterator> iterators_;
+    Slab<BoundMethod> bound_methods_;
+
+    Slab<std::shared_ptr<::havel::Thread>> threads_;
+    Slab<std::shared_ptr<::havel::Interval>> intervals_;
+    Slab<std::shared_ptr<::havel::Timeout>> timeouts_;
+    Slab<std::vector<Value>> channels_;
+  Slab<std::unique_ptr<WaitGroup>> waitgroups_;
+
+    Slab<Coroutine> coroutines_;
+
+    // Cells never move once allocated (deque growth keeps addresses), so
+    // closures and the VM's open list can hold plain pointers to them.
+    std::deque<UpvalueCell> upvalue_cells_;
+    std::vector<UpvalueCell *> free_upvalue_cells_;
 
     std::vector<EnumType> enumTypes_;
 
-    uint32_t next_closure_id_ = 1;
-    uint32_t next_string_id_ = 1;
-    uint32_t next_array_id_ = 1;
-    uint32_t next_object_id_ = 1;
-    uint32_t next_set_id_ = 1;
-    uint32_t next_range_id_ = 1;
-  uint32_t next_error_id_ = 1;
-  uint32_t next_enum_id_ = 1;
-  uint32_t next_iterator_id_ = 1;
-    uint32_t next_bound_method_id_ = 1;
-    uint32_t next_thread_id_ = 1;
-    uint32_t next_interval_id_ = 1;
-    uint32_t next_timeout_id_ = 1;
-  uint32_t next_channel_id_ = 1;
-  uint32_t next_waitgroup_id_ = 1;
-  uint32_t next_coroutine_id_ = 1;
-
 size_t allocation_budget_ = 8192;
 size_t allocations_since_last_ = 0;
 size_t recovered_in_cycle_ = 0;
@@ -569,45 +769,45 @@ uint64_t heap_max_bytes_ = 4ULL * 1024 * 1024 * 1024;
 size_t full_collection_interval_ = 4;
   uint8_t promotion_age_threshold_ = 4;
 
+    // Gray objects: marked in their slab's bitmap but not yet traced. Only
+    // kinds that hold references are pushed; tracing never recurses, so deep
+    // structures cost stack entries here rather than native stack frames.
+    // The vector keeps its capacity between cycles.
     std::vector<Value> mark_worklist_;
-    std::unordered_set<uint32_t> marked_arrays_;
-    std::unordered_set<uint32_t> marked_objects_;
-    std::unordered_set<uint32_t> marked_sets_;
-    std::unordered_set<uint32_t> marked_closures_;
-    std::unordered_set<uint32_t> marked_strings_;
-    std::unordered_set<uint32_t> marked_iterators_;
-    std::unordered_set<uint32_t> marked_bound_methods_;
-    std::unordered_set<uint32_t> marked_ranges_;
-    std::unordered_set<uint32_t> marked_errors_;
-    std::unordered_set<uint32_t> marked_enums_;
-    std::unordered_set<uint32_t> marked_coroutines_;
-    std::unordered_set<uint32_t> marked_threads_;
-    std::unordered_set<uint32_t> marked_intervals_;
-    std::unordered_set<uint32_t> marked_timeouts_;
-    std::unordered_set<uint32_t> marked_channels_;
-  std::unordered_set<uint32_t> marked_waitgroups_;
+    uint64_t mark_ns_in_cycle_ = 0;
+    uint64_t last_mark_ns_ = 0;
+    std::unique_ptr<MarkWorkers> mark_workers_;
 
     std::unordered_map<uint32_t, uint8_t> array_ages_;
     std::unordered_map<uint32_t, uint8_t> object_ages_;
     std::unordered_map<uint32_t, uint8_t> set_ages_;
     std::unordered_map<uint32_t, uint8_t> closure_ages_;
     std::unordered_map<uint32_t, uint8_t> string_ages_;
-    std::unordered_set<uint32_t> old_arrays_;
-    std::unordered_set<uint32_t> old_objects_;
-    std::unordered_set<uint32_t> old_sets_;
-    std::unordered_set<uint32_t> old_closures_;
-    std::unordered_set<uint32_t> old_strings_;
-
-    std::vector<Value> root_stack_snapshot_;
-    std::vector<Value> root_locals_snapshot_;
-    const std::unordered_map<std::string, Value>* root_globals_ptr_ = nullptr;
-    std::vector<uint32_t> root_closures_snapshot_;
-    std::vector<Value> root_extra_roots_snapshot_;
-    std::function<std::optional<Value>(uint32_t)> open_local_reader_snapshot_;
-
-    std::vector<uint32_t> sweep_keys_;
-    size_t sweep_index_ = 0;
-    IncrementalState sweep_phase_ = IncrementalState::Idle;
+    // Which objects are old is a bit in their slab. The remembered set is
+    // the old arrays, objects, sets and ropes that may hold references to
+    // young objects: each has its slab's remembered bit set and appears
+    // here once, in the order it was first written (a sequential store
+    // buffer). Minor cycles trace these instead of the whole old
+    // generation; refineRememberedSet prunes the list after every cycle.
+    std::vector<Value> remembered_;
+
+    // The caller's roots while an entry point runs, otherwise null.
+    const RootSource *roots_ = nullptr;
+    // Points roots_ at one entry point's roots and restores the outer
+    // call's on return; entry points call each other.
+    struct RootsInUse {
+        RootsInUse(GCHeap &heap, const RootSource &roots)
+            : heap_(heap), outer_(std::exchange(heap.roots_, &roots)) {}
+        ~RootsInUse() { heap_.roots_ = outer_; }
+        RootsInUse(const RootsInUse &) = delete;
+        RootsInUse &operator=(const RootsInUse &) = delete;
+        GCHeap &heap_;
+        const RootSource *outer_;
+    };
+
+    std::array<SweepCursor, kSweepKindCount> sweep_cursors_{};
+    // First kind whose cursor may not be done yet.
+    size_t sweep_kind_ = kSweepKindCount;
     mutable std::recursive_mutex mutex_;
 
     std::vector<std::pair<uint32_t, ObjectEntry>> finalizer_queue_;
@@ -0,0 +1,69 @@
+#include "MarkWorkers.hpp"
+
+namespace havel::compiler {
+
+namespace {
+
+void invokeJob(const MarkWorkers::Job &job, size_t worker) noexcept {
+  job(worker);
+}
+
+} // namespace
+
+MarkWorkers::MarkWorkers(size_t helpers) {
+  threads_.reserve(helpers);
+  for (size_t i = 0; i < helpers; ++i) {
+    threads_.emplace_back([this, worker = i + 1] { helperLoop(worker); });
+  }
+}
+
+MarkWorkers::~MarkWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void MarkWorkers::run(const Job &job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    running_ = threads_.size();
+    ++round_;
+  }
+  start_cv_.notify_all();
+
+  invokeJob(job, 0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return running_ == 0; });
+  job_ = nullptr;
+}
+
+void MarkWorkers::helperLoop(size_t worker) {
+  uint64_t seen = 0;
+  for (;;) {
+    const Job *job = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_cv_.wait(lock, [this, seen] { return stopping_ || round_ != seen; });
+      if (stopping_) {
+        return;
+      }
+      seen = round_;
+      job = job_;
+    }
+    invokeJob(*job, worker);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+} // namespace havel::compiler
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace havel::compiler {
+
+// ============================================================================
+// MarkWorkers - helper threads for the collector's parallel mark phase
+//
+// Helpers are started once and park on a condition variable between
+// collections. run() hands one job to the calling thread (worker 0) and to
+// every helper (workers 1..N-1) and returns once all of them have returned
+// from it. The job must not throw: an escaping exception terminates the
+// process, on the caller just as on a helper.
+// ============================================================================
+class MarkWorkers {
+public:
+  using Job = std::function<void(size_t worker)>;
+
+  explicit MarkWorkers(size_t helpers);
+  ~MarkWorkers();
+  MarkWorkers(const MarkWorkers &) = delete;
+  MarkWorkers &operator=(const MarkWorkers &) = delete;
+
+  size_t workerCount() const { return threads_.size() + 1; }
+  void run(const Job &job);
+
+private:
+  void helperLoop(size_t worker);
+
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+  const Job *job_ = nullptr;
+  uint64_t round_ = 0;
+  size_t running_ = 0;
+  bool stopping_ = false;
+};
+
+} // namespace havel::compiler
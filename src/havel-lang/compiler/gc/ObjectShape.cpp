@@ -0,0 +1,99 @@
+#include "ObjectShape.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace havel::compiler {
+
+namespace {
+// Guards every shape's transition table. Transitions are only taken when an
+// object gains a key, never on reads, so one lock is plenty.
+std::mutex &transitionMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+} // namespace
+
+const std::shared_ptr<ObjectShape> &ObjectShape::empty() {
+  static const std::shared_ptr<ObjectShape> root =
+      std::make_shared<ObjectShape>();
+  return root;
+}
+
+std::shared_ptr<ObjectShape> ObjectShape::withKey(const std::string &key) {
+  std::lock_guard<std::mutex> lock(transitionMutex());
+  auto it = transitions_.find(key);
+  if (it != transitions_.end()) {
+    if (auto child = it->second.lock()) {
+      return child;
+    }
+  } else if (transitions_.size() >= prune_at_) {
+    pruneTransitions();
+  }
+  auto &edge = it != transitions_.end() ? it->second : transitions_[key];
+  auto child = std::make_shared<ObjectShape>();
+  child->keys_.reserve(keys_.size() + 1);
+  child->keys_.assign(keys_.begin(), keys_.end());
+  child->index_ = index_;
+  child->keys_.push_back(key);
+  child->indexKey(static_cast<uint32_t>(child->keys_.size() - 1));
+  // Parents are owned by their children, so walking `this` back to the root
+  // stays valid for as long as any object uses the child.
+  child->parent_ = shared_from_this();
+  edge = child;
+  return child;
+}
+
+size_t ObjectShape::transitionCount() const {
+  std::lock_guard<std::mutex> lock(transitionMutex());
+  return transitions_.size();
+}
+
+// Caller holds transitionMutex().
+void ObjectShape::pruneTransitions() {
+  std::erase_if(transitions_,
+                [](const auto &edge) { return edge.second.expired(); });
+  prune_at_ = std::max(kMinPruneAt, transitions_.size() * 2);
+}
+
+std::shared_ptr<ObjectShape> ObjectShape::dictionaryCopy() const {
+  auto copy = std::make_shared<ObjectShape>();
+  copy->keys_ = keys_;
+  copy->index_ = index_;
+  copy->shared_ = false;
+  return copy;
+}
+
+void ObjectShape::appendKey(const std::string &key) {
+  keys_.push_back(key);
+  indexKey(static_cast<uint32_t>(keys_.size() - 1));
+}
+
+void ObjectShape::removeSlot(uint32_t slot) {
+  if (!index_.empty()) {
+    index_.erase(keys_[slot]);
+  }
+  const uint32_t last = static_cast<uint32_t>(keys_.size() - 1);
+  if (slot != last) {
+    keys_[slot] = std::move(keys_[last]);
+    if (!index_.empty()) {
+      index_[keys_[slot]] = slot;
+    }
+  }
+  keys_.pop_back();
+}
+
+void ObjectShape::indexKey(uint32_t slot) {
+  if (index_.empty()) {
+    if (keys_.size() <= kIndexThreshold) {
+      return;
+    }
+    for (uint32_t i = 0; i < keys_.size(); ++i) {
+      index_.emplace(keys_[i], i);
+    }
+    return;
+  }
+  index_.emplace(keys_[slot], slot);
+}
+
+} // namespace havel::compiler
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace havel::compiler {
+
+// ============================================================================
+// ObjectShape - hidden class describing an object's key layout
+//
+// Objects built by adding the same keys in the same order share one shape:
+// the shape maps each key to a slot index and the object only stores a dense
+// slot vector, so per-object overhead is one pointer plus the values and a
+// field read is a key lookup in the shared table followed by an indexed load.
+// Slot order is insertion order.
+//
+// Shared shapes form a transition tree rooted at empty(): withKey() returns
+// the (cached) child for "this layout plus one key". Children hold their
+// parent strongly and parents only hold weak transition edges, so shapes no
+// object uses anymore are freed. Shared shapes are immutable once built and
+// safe to read from any thread.
+//
+// Edges to freed children are dropped whenever the table doubles past its
+// last pruned size, so a shape that sees many short-lived keys keeps a table
+// proportional to its live children.
+//
+// Objects that delete keys or grow past kMaxSharedSlots switch to dictionary
+// mode: they get a private, unshared shape that is edited in place, which
+// keeps one-off dictionaries from growing the transition tree without bound.
+// ============================================================================
+class ObjectShape : public std::enable_shared_from_this<ObjectShape> {
+public:
+  static constexpr uint32_t kNotFound = UINT32_MAX;
+  // Largest layout kept in the transition tree.
+  static constexpr size_t kMaxSharedSlots = 64;
+
+  // Root of the transition tree: the layout of a fresh `{}`.
+  static const std::shared_ptr<ObjectShape> &empty();
+
+  uint32_t slotOf(const std::string &key) const {
+    if (index_.empty()) {
+      // Small layouts: a linear scan beats hashing the key.
+      for (size_t i = 0; i < keys_.size(); ++i) {
+        if (keys_[i] == key) {
+          return static_cast<uint32_t>(i);
+        }
+      }
+      return kNotFound;
+    }
+    auto it = index_.find(key);
+    return it == index_.end() ? kNotFound : it->second;
+  }
+
+  size_t slotCount() const { return keys_.size(); }
+  const std::string &keyAt(uint32_t slot) const { return keys_[slot]; }
+  const std::vector<std::string> &keys() const { return keys_; }
+  bool isShared() const { return shared_; }
+
+  // Shared shape for this layout plus `key` (which must not be present).
+  std::shared_ptr<ObjectShape> withKey(const std::string &key);
+  // Transition edges currently stored, live or not.
+  size_t transitionCount() const;
+  // Private copy of this layout for an object entering dictionary mode.
+  std::shared_ptr<ObjectShape> dictionaryCopy() const;
+
+  // Dictionary-mode edits; only valid on an unshared shape.
+  void appendKey(const std::string &key);
+  // Remove `slot` by moving the last key into it, mirroring how the object
+  // moves its last value into the vacated slot.
+  void removeSlot(uint32_t slot);
+
+private:
+  static constexpr size_t kIndexThreshold = 8;
+  static constexpr size_t kMinPruneAt = 16;
+
+  void indexKey(uint32_t slot);
+  void pruneTransitions();
+
+  std::vector<std::string> keys_;
+  // Only built once the layout outgrows a linear scan.
+  std::unordered_map<std::string, uint32_t> index_;
+  std::shared_ptr<ObjectShape> parent_;
+  std::unordered_map<std::string, std::weak_ptr<ObjectShape>> transitions_;
+  size_t prune_at_ = kMinPruneAt;
+  bool shared_ = true;
+};
+
+} // namespace havel::compiler
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "../../core/Value.hpp"
+
+namespace havel::compiler {
+
+using ::havel::core::Value;
+
+// ============================================================================
+// RootVisitor / RootSource - precise root enumeration for the collector
+//
+// A RootSource hands every value it keeps alive to a RootVisitor, straight
+// out of its own storage: nothing is copied into an intermediate vector, so
+// a safe point that ends up doing no collection work costs nothing. The
+// heap holds on to the source only for the duration of one entry-point call
+// and may visit it more than once (a mark step re-scans roots before it
+// finishes a cycle), so visitRoots must be repeatable and must not allocate
+// heap objects.
+//
+// openLocal serves closures whose upvalue cells are still open: it reads
+// the local slot the cell aliases. Parallel marking may call it from
+// helper threads, so it must only read.
+// ============================================================================
+class RootVisitor {
+public:
+  virtual void visit(const Value &value) = 0;
+
+protected:
+  ~RootVisitor() = default;
+};
+
+class RootSource {
+public:
+  virtual void visitRoots(RootVisitor &visitor) const = 0;
+  virtual std::optional<Value> openLocal(uint32_t index) const {
+    (void)index;
+    return std::nullopt;
+  }
+
+protected:
+  ~RootSource() = default;
+};
+
+// Adapts a callable taking `const Value &` to a RootVisitor.
+template <typename Fn> class RootVisitorFn final : public RootVisitor {
+public:
+  explicit RootVisitorFn(Fn fn) : fn_(std::move(fn)) {}
+  void visit(const Value &value) override { fn_(value); }
+
+private:
+  Fn fn_;
+};
+
+template <typename Fn> RootVisitorFn<Fn> rootVisitor(Fn fn) {
+  return RootVisitorFn<Fn>(std::move(fn));
+}
+
+} // namespace havel::compiler
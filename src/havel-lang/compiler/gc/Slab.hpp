@@ -0,0 +1,324 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace havel::compiler {
+
+// ============================================================================
+// Slab - id-indexed storage for one kind of heap object
+//
+// An id is a slot index in the low kIndexBits and the slot's generation in
+// the high bits. Slots live in fixed pages that never move, so a pointer to
+// an entry stays valid until that entry is erased, and a lookup is a shift,
+// two loads and a compare. Erasing bumps the slot's generation and queues
+// the slot for reuse, so a stale id (one whose object was swept) misses
+// instead of aliasing the slot's next occupant, for the next 255 reuses of
+// that slot. Freed slots are reused oldest first to make that window long.
+// Index 0 is never handed out, so 0 stays usable as "no object".
+//
+// Each page also carries one mark bit per slot for the collector. Only a
+// live id can be marked, and erasing a slot clears its bit, so a reused
+// slot never inherits its previous occupant's mark. mark() is atomic, so
+// several marking threads may race on the same id; exactly one wins.
+//
+// Two more bits per slot serve the generational collector: `old` for
+// entries promoted out of the young generation, and `remembered` for old
+// entries that may hold references to young ones. Erasing clears both.
+//
+// Threading: insert, erase and clear must be serialized by the owner (the
+// heap's mutex). get/contains take no lock and are safe against concurrent
+// inserts: the page directory is published with release ordering and old
+// directories are kept until clear(), and each slot's id is published only
+// after its value is constructed.
+// ============================================================================
+template <typename T> class Slab {
+public:
+  static constexpr uint32_t kIndexBits = 24;
+  static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+  static constexpr uint32_t kPageBits = 8;
+  static constexpr uint32_t kPageSize = 1u << kPageBits;
+  static constexpr uint32_t kPageMask = kPageSize - 1;
+
+  static constexpr uint32_t indexOf(uint32_t id) { return id & kIndexMask; }
+
+  Slab() = default;
+  Slab(const Slab &) = delete;
+  Slab &operator=(const Slab &) = delete;
+  ~Slab() { clear(); }
+
+  // Stores `value` in a free slot and returns its id.
+  template <typename... Args> uint32_t emplace(Args &&...args) {
+    uint32_t index;
+    if (!free_.empty()) {
+      index = free_.front();
+      free_.pop_front();
+    } else {
+      if (next_index_ > kIndexMask) {
+        throw std::runtime_error("VM out of memory: too many live objects of one kind");
+      }
+      index = next_index_++;
+      if ((index >> kPageBits) >= pages_.size()) {
+        addPage();
+      }
+    }
+    Page &page = *pages_[index >> kPageBits];
+    const uint32_t slot = index & kPageMask;
+    new (page.slot(slot)) T(std::forward<Args>(args)...);
+    const uint32_t id = (static_cast<uint32_t>(page.generations[slot]) << kIndexBits) | index;
+    page.ids[slot].store(id, std::memory_order_release);
+    ++size_;
+    return id;
+  }
+
+  T *get(uint32_t id) {
+    Page *page = livePage(id);
+    return page ? page->slot(id & kPageMask) : nullptr;
+  }
+  const T *get(uint32_t id) const { return const_cast<Slab *>(this)->get(id); }
+  bool contains(uint32_t id) const { return get(id) != nullptr; }
+
+  // Destroys the entry for `id`. False if `id` is not live.
+  bool erase(uint32_t id) {
+    T *value = get(id);
+    if (!value) {
+      return false;
+    }
+    const uint32_t index = id & kIndexMask;
+    Page &page = *pages_[index >> kPageBits];
+    const uint32_t slot = index & kPageMask;
+    page.ids[slot].store(0, std::memory_order_release);
+    clearBit(page.marks, slot);
+    clearBit(page.remembered, slot);
+    if (clearBit(page.old, slot)) {
+      --old_count_;
+    }
+    value->~T();
+    ++page.generations[slot];
+    free_.push_back(index);
+    --size_;
+    return true;
+  }
+
+  // Sets the mark bit for `id`. True only if `id` is live and was unmarked.
+  bool mark(uint32_t id) {
+    Page *page = livePage(id);
+    if (!page) {
+      return false;
+    }
+    return setBit(page->marks, id & kPageMask);
+  }
+  bool isMarked(uint32_t id) const {
+    const Page *page = const_cast<Slab *>(this)->livePage(id);
+    return page && testBit(page->marks, id & kPageMask);
+  }
+  void clearMarks() {
+    for (auto &page : pages_) {
+      for (auto &word : page->marks) {
+        word.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Moves `id` to the old generation. True only if `id` is live and was
+  // young.
+  bool promote(uint32_t id) {
+    Page *page = livePage(id);
+    if (!page || !setBit(page->old, id & kPageMask)) {
+      return false;
+    }
+    ++old_count_;
+    return true;
+  }
+  bool isOld(uint32_t id) const {
+    const Page *page = const_cast<Slab *>(this)->livePage(id);
+    return page && testBit(page->old, id & kPageMask);
+  }
+  size_t oldCount() const { return old_count_; }
+
+  // Sets the remembered bit for `id`. True only if `id` is live, old and
+  // was not remembered, i.e. the caller should add it to its store buffer.
+  bool remember(uint32_t id) {
+    Page *page = livePage(id);
+    if (!page) {
+      return false;
+    }
+    const uint32_t slot = id & kPageMask;
+    return testBit(page->old, slot) && setBit(page->remembered, slot);
+  }
+  void forget(uint32_t id) {
+    if (Page *page = livePage(id)) {
+      clearBit(page->remembered, id & kPageMask);
+    }
+  }
+  bool isRemembered(uint32_t id) const {
+    const Page *page = const_cast<Slab *>(this)->livePage(id);
+    return page && testBit(page->remembered, id & kPageMask);
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // One past the highest slot index ever used; bounds an index cursor.
+  uint32_t indexLimit() const { return next_index_; }
+  // The live id in slot `index`, or 0.
+  uint32_t idAt(uint32_t index) const {
+    if (index >= next_index_) {
+      return 0;
+    }
+    return pages_[index >> kPageBits]->ids[index & kPageMask].load(std::memory_order_relaxed);
+  }
+
+  void clear() {
+    for (uint32_t index = 1; index < next_index_; ++index) {
+      Page &page = *pages_[index >> kPageBits];
+      const uint32_t slot = index & kPageMask;
+      if (page.ids[slot].load(std::memory_order_relaxed) != 0) {
+        page.ids[slot].store(0, std::memory_order_relaxed);
+        page.slot(slot)->~T();
+      }
+    }
+    page_count_.store(0, std::memory_order_release);
+    directory_.store(nullptr, std::memory_order_release);
+    pages_.clear();
+    directories_.clear();
+    directory_capacity_ = 0;
+    free_.clear();
+    next_index_ = 1;
+    size_ = 0;
+    old_count_ = 0;
+  }
+
+  // Iteration visits live entries in slot order as {id, value&} pairs.
+  // Erasing the current entry while iterating is allowed; inserting is not.
+  template <bool Const> class Iter {
+    using Owner = std::conditional_t<Const, const Slab, Slab>;
+    using Ref = std::conditional_t<Const, const T &, T &>;
+
+  public:
+    struct Entry {
+      uint32_t first;
+      Ref second;
+    };
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using reference = Entry;
+    using difference_type = std::ptrdiff_t;
+
+    Iter(Owner *owner, uint32_t index) : owner_(owner), index_(index) { skip(); }
+    Entry operator*() const {
+      const uint32_t id = owner_->idAt(index_);
+      return Entry{id, *owner_->pages_[index_ >> kPageBits]->slot(index_ & kPageMask)};
+    }
+    Iter &operator++() {
+      ++index_;
+      skip();
+      return *this;
+    }
+    bool operator==(const Iter &o) const { return index_ == o.index_; }
+    bool operator!=(const Iter &o) const { return index_ != o.index_; }
+
+  private:
+    void skip() {
+      while (index_ < owner_->next_index_ && owner_->idAt(index_) == 0) {
+        ++index_;
+      }
+    }
+    Owner *owner_;
+    uint32_t index_;
+  };
+  using iterator = Iter<false>;
+  using const_iterator = Iter<true>;
+
+  iterator begin() { return iterator(this, 1); }
+  iterator end() { return iterator(this, next_index_); }
+  const_iterator begin() const { return const_iterator(this, 1); }
+  const_iterator end() const { return const_iterator(this, next_index_); }
+
+private:
+  struct Page {
+    alignas(T) unsigned char storage[kPageSize * sizeof(T)];
+    std::atomic<uint32_t> ids[kPageSize] = {};
+    uint8_t generations[kPageSize] = {};
+    std::atomic<uint64_t> marks[kPageSize / 64] = {};
+    std::atomic<uint64_t> old[kPageSize / 64] = {};
+    std::atomic<uint64_t> remembered[kPageSize / 64] = {};
+
+    T *slot(uint32_t i) { return std::launder(reinterpret_cast<T *>(storage + i * sizeof(T))); }
+  };
+
+  using Bits = std::atomic<uint64_t>[kPageSize / 64];
+
+  static bool testBit(const Bits &bits, uint32_t slot) {
+    return (bits[slot >> 6].load(std::memory_order_relaxed) >> (slot & 63)) & 1;
+  }
+  // True if the bit was clear.
+  static bool setBit(Bits &bits, uint32_t slot) {
+    std::atomic<uint64_t> &word = bits[slot >> 6];
+    const uint64_t bit = uint64_t{1} << (slot & 63);
+    // Test first: most calls find the bit already set (an object reached
+    // again, a container already remembered), and a plain load is much
+    // cheaper than a locked read-modify-write.
+    if (word.load(std::memory_order_relaxed) & bit) {
+      return false;
+    }
+    return (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+  }
+  // True if the bit was set.
+  static bool clearBit(Bits &bits, uint32_t slot) {
+    const uint64_t bit = uint64_t{1} << (slot & 63);
+    return (bits[slot >> 6].fetch_and(~bit, std::memory_order_relaxed) & bit) != 0;
+  }
+
+  // The page holding `id`, if `id` is live.
+  Page *livePage(uint32_t id) {
+    const uint32_t index = id & kIndexMask;
+    const uint32_t page_index = index >> kPageBits;
+    if (page_index >= page_count_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    Page *page = directory_.load(std::memory_order_acquire)[page_index];
+    if (id == 0 || page->ids[index & kPageMask].load(std::memory_order_acquire) != id) {
+      return nullptr;
+    }
+    return page;
+  }
+
+  void addPage() {
+    pages_.push_back(std::make_unique<Page>());
+    const size_t count = pages_.size();
+    if (directories_.empty() || count > directory_capacity_) {
+      directory_capacity_ = directory_capacity_ ? directory_capacity_ * 2 : 16;
+      auto grown = std::make_unique<Page *[]>(directory_capacity_);
+      for (size_t i = 0; i + 1 < count; ++i) {
+        grown[i] = pages_[i].get();
+      }
+      directories_.push_back(std::move(grown));
+    }
+    Page **directory = directories_.back().get();
+    directory[count - 1] = pages_.back().get();
+    directory_.store(directory, std::memory_order_release);
+    page_count_.store(static_cast<uint32_t>(count), std::memory_order_release);
+  }
+
+  std::vector<std::unique_ptr<Page>> pages_;
+  // Every directory ever published; readers may still hold an older one.
+  std::vector<std::unique_ptr<Page *[]>> directories_;
+  size_t directory_capacity_ = 0;
+  std::atomic<Page **> directory_{nullptr};
+  std::atomic<uint32_t> page_count_{0};
+  std::deque<uint32_t> free_;
+  uint32_t next_index_ = 1;
+  size_t size_ = 0;
+  size_t old_count_ = 0;
+};
+
+} // namespace havel::compiler
@@ -0,0 +1,65 @@
+#include "Utf8Index.hpp"
+
+#include <algorithm>
+
+namespace havel::compiler {
+
+int64_t Utf8Index::decodeAt(std::string_view s, size_t byte) {
+  if (byte >= s.size()) return -1;
+  const auto c = static_cast<unsigned char>(s[byte]);
+  int64_t codepoint = c;
+  size_t len = 1;
+  if (c < 0x80) { codepoint = c; len = 1; }
+  else if ((c & 0xE0) == 0xC0) { codepoint = c & 0x1F; len = 2; }
+  else if ((c & 0xF0) == 0xE0) { codepoint = c & 0x0F; len = 3; }
+  else if ((c & 0xF8) == 0xF0) { codepoint = c & 0x07; len = 4; }
+  for (size_t i = 1; i < len && byte + i < s.size(); ++i) {
+    codepoint = (codepoint << 6) | (static_cast<unsigned char>(s[byte + i]) & 0x3F);
+  }
+  return codepoint;
+}
+
+Utf8Index::Utf8Index(std::string_view s) {
+  const bool all_ascii = std::all_of(s.begin(), s.end(), [](char c) {
+    return static_cast<unsigned char>(c) < 0x80;
+  });
+  if (all_ascii) {
+    length_ = s.size();
+    return;
+  }
+  ascii_ = false;
+  marks_.reserve(s.size() / kStride + 1);
+  size_t byte = 0;
+  size_t cp = 0;
+  while (byte < s.size()) {
+    if (cp % kStride == 0) marks_.push_back(byte);
+    byte += sequenceLength(s, byte);
+    ++cp;
+  }
+  length_ = cp;
+}
+
+size_t Utf8Index::byteOffset(std::string_view s, size_t cp) const {
+  if (cp >= length_) return s.size();
+  if (ascii_) return cp;
+  size_t byte = marks_[cp / kStride];
+  for (size_t n = cp % kStride; n > 0; --n) {
+    byte += sequenceLength(s, byte);
+  }
+  return byte;
+}
+
+size_t Utf8Index::codepointAtByte(std::string_view s, size_t byte) const {
+  if (byte >= s.size()) return length_;
+  if (ascii_) return byte;
+  auto mark = std::upper_bound(marks_.begin(), marks_.end(), byte) - 1;
+  size_t pos = *mark;
+  size_t cp = static_cast<size_t>(mark - marks_.begin()) * kStride;
+  while (pos < byte) {
+    pos += sequenceLength(s, pos);
+    ++cp;
+  }
+  return cp;
+}
+
+} // namespace havel::compiler
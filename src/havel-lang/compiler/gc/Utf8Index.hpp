@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace havel::compiler {
+
+// ============================================================================
+// Utf8Index - codepoint <-> byte offset map for one immutable string
+//
+// Strings are stored as UTF-8 and indexed by codepoint, so without help
+// s[i] has to walk from the start. The index records the codepoint count,
+// whether the string is pure ASCII (codepoint == byte, no table needed) and
+// otherwise the byte offset of every kStride-th codepoint, so a lookup walks
+// at most kStride - 1 sequences from the nearest breadcrumb.
+//
+// Decoding is lenient in the same way as the rest of the VM: a byte that is
+// not a valid lead, or a sequence cut short by the end of the string,
+// counts as one codepoint of one byte.
+// ============================================================================
+class Utf8Index {
+public:
+  // Codepoints between breadcrumbs.
+  static constexpr size_t kStride = 64;
+
+  // Byte length of the sequence starting at `byte` (0 past the end).
+  static size_t sequenceLength(std::string_view s, size_t byte) {
+    if (byte >= s.size()) return 0;
+    const auto c = static_cast<unsigned char>(s[byte]);
+    size_t len = 1;
+    if (c < 0x80) len = 1;
+    else if ((c & 0xE0) == 0xC0) len = 2;
+    else if ((c & 0xF0) == 0xE0) len = 3;
+    else if ((c & 0xF8) == 0xF0) len = 4;
+    return byte + len > s.size() ? 1 : len;
+  }
+
+  // Codepoint of the sequence starting at `byte`; the lead byte itself for
+  // invalid leads.
+  static int64_t decodeAt(std::string_view s, size_t byte);
+
+  Utf8Index() = default;
+  explicit Utf8Index(std::string_view s);
+
+  bool ascii() const { return ascii_; }
+  size_t length() const { return length_; }
+
+  // Byte offset of codepoint `cp`; s.size() for cp >= length(). `s` must be
+  // the string the index was built from.
+  size_t byteOffset(std::string_view s, size_t cp) const;
+  // Number of codepoints that start before `byte`.
+  size_t codepointAtByte(std::string_view s, size_t byte) const;
+
+private:
+  size_t length_ = 0;
+  bool ascii_ = true;
+  // marks_[k] is the byte offset of codepoint k * kStride. Empty when ascii_.
+  std::vector<size_t> marks_;
+};
+
+} // namespace havel::compiler
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../core/BytecodeIR.hpp"
+#include "utils/RobinHoodHashMap.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace havel::compiler {
+
+// ============================================================================
+// ValueSet - hash set of Values compared by their NaN-boxed bits
+//
+// Members are stored in canonical form (see GCHeap::setMember): strings as
+// their interned StringId and integral doubles as ints, so two members are
+// equal exactly when their bits are. Hashing a member is an integer mix and
+// comparing one is an integer compare; nothing is stringified per lookup.
+// Entries are 16 bytes in an open-addressed Robin Hood table, against a
+// heap node holding a std::string and a Value for the map this replaces.
+// ============================================================================
+class ValueSet {
+  struct BitsHash {
+    size_t operator()(const Value &v) const {
+      // The table masks the low bits, and ids differ only in the low bits
+      // of the payload while the tag sits high, so mix everything down.
+      uint64_t x = v.rawBits();
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return static_cast<size_t>(x);
+    }
+  };
+  struct BitsEqual {
+    bool operator()(const Value &a, const Value &b) const {
+      return a.rawBits() == b.rawBits();
+    }
+  };
+  struct Present {};
+  using Table = utils::RobinHoodHashMap<Value, Present, BitsHash, BitsEqual>;
+
+public:
+  class const_iterator {
+    friend class ValueSet;
+    Table::const_iterator it_;
+    explicit const_iterator(Table::const_iterator it) : it_(it) {}
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using reference = const Value &;
+    using difference_type = std::ptrdiff_t;
+
+    const_iterator() = default;
+    reference operator*() const { return (*it_).first; }
+    const Value *operator->() const { return &(*it_).first; }
+    const_iterator &operator++() { ++it_; return *this; }
+    bool operator==(const const_iterator &o) const { return it_ == o.it_; }
+    bool operator!=(const const_iterator &o) const { return it_ != o.it_; }
+  };
+
+  // All three expect a canonical member. insert and erase report whether
+  // the set changed. Do not insert or erase while iterating.
+  bool insert(const Value &member) { return table_.insert(member, Present{}).second; }
+  bool erase(const Value &member) { return table_.erase(member); }
+  bool contains(const Value &member) const { return table_.contains(member); }
+
+  size_t size() const { return table_.size(); }
+  bool empty() const { return table_.empty(); }
+  void clear() { table_.clear(); }
+  void reserve(size_t n) { table_.reserve(n); }
+
+  const_iterator begin() const { return const_iterator(table_.begin()); }
+  const_iterator end() const { return const_iterator(table_.end()); }
+
+private:
+  Table table_;
+};
+
+} // namespace havel::compiler
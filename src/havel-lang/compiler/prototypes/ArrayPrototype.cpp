@@ -186,45 +186,53 @@ void registerArrayPrototype(VM& vm) {
 		return Value::makeInt(-1);
 	});
 
+// The higher-order methods resolve the callback once with prepareCall and
+// run each element through callPrepared. The source and result arrays are
+// pinned for the loop and looked up again after every callback, which may
+// allocate or append to the array being walked.
 regProto("map", 2, [&vm](const std::vector<Value>& args) {
     if (args.size() < 2) return Value::makeNull();
     if (!args[1].isFunctionObjId() && !args[1].isClosureId()) return Value::makeNull();
-    if (args[0].isArrayId()) {
-        auto* arr = vm.getHeap().array(args[0].asArrayId());
-        if (arr) {
-            auto resultRef = vm.getHeap().allocateArray();
-            auto* result = vm.getHeap().array(resultRef.id);
-            for (const auto& v : *arr) {
-                auto val = vm.call(args[1], {v});
-                result->push_back(val);
-            }
-            return Value::makeArrayId(resultRef.id);
-        }
+    if (!args[0].isArrayId() || !vm.getHeap().array(args[0].asArrayId())) return Value::makeNull();
+    auto& heap = vm.getHeap();
+    const uint32_t arrayId = args[0].asArrayId();
+    auto call = vm.prepareCall(args[1]);
+    auto srcRoot = vm.makeRoot(args[0]);
+    auto resultRef = heap.allocateArray();
+    auto resultRoot = vm.makeRoot(Value::makeArrayId(resultRef.id));
+    heap.array(resultRef.id)->reserve(heap.array(arrayId)->size());
+    for (size_t i = 0; i < heap.array(arrayId)->size(); i++) {
+        Value v = (*heap.array(arrayId))[i];
+        Value mapped = vm.callPrepared(call, HostArgs(&v, 1));
+        heap.array(resultRef.id)->push_back(mapped);
     }
-    return Value::makeNull();
+    return Value::makeArrayId(resultRef.id);
 });
 
   regProto("filter", 2, [&vm](const std::vector<Value>& args) {
     if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeNull();
-    if (args[0].isArrayId()) {
-      auto* arr = vm.getHeap().array(args[0].asArrayId());
-      if (arr) {
-        auto resultRef = vm.getHeap().allocateArray();
-        auto* result = vm.getHeap().array(resultRef.id);
-        for (const auto& v : *arr) {
-          auto predResult = vm.call(args[1], {v});
-          if (vm.toBoolPublic(predResult)) result->push_back(v);
-        }
-        return Value::makeArrayId(resultRef.id);
-      }
+    if (!args[0].isArrayId() || !vm.getHeap().array(args[0].asArrayId())) return Value::makeNull();
+    auto& heap = vm.getHeap();
+    const uint32_t arrayId = args[0].asArrayId();
+    auto call = vm.prepareCall(args[1]);
+    auto srcRoot = vm.makeRoot(args[0]);
+    auto resultRef = heap.allocateArray();
+    auto resultRoot = vm.makeRoot(Value::makeArrayId(resultRef.id));
+    heap.array(resultRef.id)->reserve(heap.array(arrayId)->size());
+    for (size_t i = 0; i < heap.array(arrayId)->size(); i++) {
+      Value v = (*heap.array(arrayId))[i];
+      auto predResult = vm.callPrepared(call, HostArgs(&v, 1));
+      if (vm.toBoolPublic(predResult)) heap.array(resultRef.id)->push_back(v);
     }
-    return Value::makeNull();
+    return Value::makeArrayId(resultRef.id);
   });
 
 regProtoVar("reduce", [&vm](const std::vector<Value>& args) {
 if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeNull();
 if (args[0].isArrayId()) {
-auto* arr = vm.getHeap().array(args[0].asArrayId());
+auto& heap = vm.getHeap();
+const uint32_t arrayId = args[0].asArrayId();
+auto* arr = heap.array(arrayId);
 if (arr && !arr->empty()) {
 size_t start = 0;
 Value acc;
@@ -234,8 +242,11 @@ acc = args[2];
 acc = (*arr)[0];
 start = 1;
 }
-for (size_t i = start; i < arr->size(); i++) {
-acc = vm.call(args[1], {acc, (*arr)[i]});
+auto call = vm.prepareCall(args[1]);
+auto srcRoot = vm.makeRoot(args[0]);
+for (size_t i = start; i < heap.array(arrayId)->size(); i++) {
+Value callArgs[2] = {acc, (*heap.array(arrayId))[i]};
+acc = vm.callPrepared(call, HostArgs(callArgs, 2));
 }
 return acc;
 }
@@ -245,12 +256,14 @@ return args.size() > 2 ? args[2] : Value::makeNull();
 
 auto foreachFn = [&vm](const std::vector<Value>& args) {
 if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeNull();
-if (args[0].isArrayId()) {
-auto* arr = vm.getHeap().array(args[0].asArrayId());
-if (arr) {
-for (const auto& v : *arr) {
-vm.call(args[1], {v});
-}
+if (args[0].isArrayId() && vm.getHeap().array(args[0].asArrayId())) {
+auto& heap = vm.getHeap();
+const uint32_t arrayId = args[0].asArrayId();
+auto call = vm.prepareCall(args[1]);
+auto srcRoot = vm.makeRoot(args[0]);
+for (size_t i = 0; i < heap.array(arrayId)->size(); i++) {
+Value v = (*heap.array(arrayId))[i];
+vm.callPrepared(call, HostArgs(&v, 1));
 }
 }
 return Value::makeNull();
@@ -260,28 +273,32 @@ regProto("each", 2, foreachFn);
 
   regProto("every", 2, [&vm](const std::vector<Value>& args) {
     if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeBool(false);
-    if (args[0].isArrayId()) {
-      auto* arr = vm.getHeap().array(args[0].asArrayId());
-      if (arr) {
-        for (const auto& v : *arr) {
-          auto predResult = vm.call(args[1], {v});
-          if (!vm.toBoolPublic(predResult)) return Value::makeBool(false);
-        }
-        return Value::makeBool(true);
+    if (args[0].isArrayId() && vm.getHeap().array(args[0].asArrayId())) {
+      auto& heap = vm.getHeap();
+      const uint32_t arrayId = args[0].asArrayId();
+      auto call = vm.prepareCall(args[1]);
+      auto srcRoot = vm.makeRoot(args[0]);
+      for (size_t i = 0; i < heap.array(arrayId)->size(); i++) {
+        Value v = (*heap.array(arrayId))[i];
+        auto predResult = vm.callPrepared(call, HostArgs(&v, 1));
+        if (!vm.toBoolPublic(predResult)) return Value::makeBool(false);
       }
+      return Value::makeBool(true);
     }
     return Value::makeBool(false);
   });
 
   regProto("some", 2, [&vm](const std::vector<Value>& args) {
     if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeBool(false);
-    if (args[0].isArrayId()) {
-      auto* arr = vm.getHeap().array(args[0].asArrayId());
-      if (arr) {
-        for (const auto& v : *arr) {
-          auto predResult = vm.call(args[1], {v});
-          if (vm.toBoolPublic(predResult)) return Value::makeBool(true);
-        }
+    if (args[0].isArrayId() && vm.getHeap().array(args[0].asArrayId())) {
+      auto& heap = vm.getHeap();
+      const uint32_t arrayId = args[0].asArrayId();
+      auto call = vm.prepareCall(args[1]);
+      auto srcRoot = vm.makeRoot(args[0]);
+      for (size_t i = 0; i < heap.array(arrayId)->size(); i++) {
+        Value v = (*heap.array(arrayId))[i];
+        auto predResult = vm.callPrepared(call, HostArgs(&v, 1));
+        if (vm.toBoolPublic(predResult)) return Value::makeBool(true);
       }
     }
     return Value::makeBool(false);
@@ -647,15 +664,8 @@ return Value::makeBool(false);
     auto* arr = vm.getHeap().array(args[0].asArrayId());
     if (!arr) return Value::makeNull();
     auto resultRef = vm.getHeap().allocateSet();
-    auto* result = vm.getHeap().set(resultRef.id);
-    for (const auto& v : *arr) {
-      std::string key;
-      if (v.isInt()) key = std::to_string(v.asInt());
-      else if (v.isStringValId() && vm.getCurrentChunk()) key = vm.getCurrentChunk()->getString(v.asStringValId());
-      else if (v.isStringId() && vm.getHeap().string(v.asStringId())) key = *vm.getHeap().string(v.asStringId());
-      else key = vm.toString(v);
-      (*result)[key] = Value::makeBool(true);
-    }
+    vm.getHeap().set(resultRef.id)->reserve(arr->size());
+    for (size_t i = 0; i < arr->size(); ++i) vm.setAdd(resultRef.id, (*arr)[i]);
     return Value::makeSetId(resultRef.id);
     });
 
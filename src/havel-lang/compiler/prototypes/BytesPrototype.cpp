@@ -0,0 +1,210 @@
+#include "PrototypeRegistry.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace havel::compiler::prototypes {
+
+using ByteBuffer = GCHeap::ByteBuffer;
+
+static std::optional<ByteBuffer::Kind> kindFromName(const std::string& name) {
+    if (name == "u8") return ByteBuffer::Kind::U8;
+    if (name == "i32") return ByteBuffer::Kind::I32;
+    if (name == "f32") return ByteBuffer::Kind::F32;
+    if (name == "f64") return ByteBuffer::Kind::F64;
+    return std::nullopt;
+}
+
+static const char* kindName(ByteBuffer::Kind kind) {
+    switch (kind) {
+    case ByteBuffer::Kind::U8: return "u8";
+    case ByteBuffer::Kind::I32: return "i32";
+    case ByteBuffer::Kind::F32: return "f32";
+    case ByteBuffer::Kind::F64: return "f64";
+    }
+    return "u8";
+}
+
+static std::optional<int64_t> toIndex(const Value& v) {
+    if (v.isInt()) return v.asInt();
+    if (v.isDouble()) return static_cast<int64_t>(v.asDouble());
+    return std::nullopt;
+}
+
+// Clamps a possibly negative element index into [0, size].
+static size_t clampIndex(int64_t idx, size_t size) {
+    if (idx < 0) idx += static_cast<int64_t>(size);
+    if (idx < 0) return 0;
+    return std::min(static_cast<size_t>(idx), size);
+}
+
+void registerBytesPrototype(VM& vm) {
+    auto regProto = [&vm](const std::string& method, size_t arity, BytecodeHostFunction fn) {
+        vm.registerHostFunction("bytes." + method, arity, std::move(fn));
+        vm.registerPrototypeMethodByName("bytes", method, "bytes." + method);
+    };
+
+    auto regProtoVar = [&vm](const std::string& method, BytecodeHostFunction fn) {
+        vm.registerHostFunction("bytes." + method, std::move(fn));
+        vm.registerPrototypeMethodByName("bytes", method, "bytes." + method);
+    };
+
+    auto buffer = [&vm](const Value& v) -> ByteBuffer* {
+        return v.isBytesId() ? vm.getHeap().bytes(v.asBytesId()) : nullptr;
+    };
+
+    // Bytes.alloc(n, kind = "u8") - n zeroed elements of the given kind
+    vm.registerHostFunction("Bytes.alloc", [&vm](const std::vector<Value>& args) {
+        if (args.empty()) return Value::makeNull();
+        auto n = toIndex(args[0]);
+        if (!n || *n < 0) return Value::makeNull();
+        auto kind = ByteBuffer::Kind::U8;
+        if (args.size() > 1) {
+            auto k = kindFromName(vm.resolveStringKey(args[1]));
+            if (!k) return Value::makeNull();
+            kind = *k;
+        }
+        auto& heap = vm.getHeap();
+        auto ref = heap.allocateBytes(
+            std::vector<uint8_t>(static_cast<size_t>(*n) * ByteBuffer::elementSize(kind)));
+        if (kind == ByteBuffer::Kind::U8) return Value::makeBytesId(ref.id);
+        // Re-type the fresh storage; the u8 buffer becomes garbage at once.
+        auto* base = heap.bytes(ref.id);
+        auto view = heap.allocateBytesView(*base, 0, base->length, kind);
+        return Value::makeBytesId(view.id);
+    });
+
+    // Bytes.from(array | string) - u8 copy of the elements or UTF-8 bytes
+    vm.registerHostFunction("Bytes.from", 1, [&vm](const std::vector<Value>& args) {
+        if (args.empty()) return Value::makeNull();
+        std::vector<uint8_t> data;
+        if (args[0].isArrayId()) {
+            auto* arr = vm.getHeap().array(args[0].asArrayId());
+            if (!arr) return Value::makeNull();
+            data.reserve(arr->size());
+            for (size_t i = 0; i < arr->size(); ++i) {
+                auto b = toIndex((*arr)[i]);
+                data.push_back(static_cast<uint8_t>(b ? *b : 0));
+            }
+        } else if (const std::string* s = vm.getStringPtr(args[0])) {
+            data.assign(s->begin(), s->end());
+        } else {
+            return Value::makeNull();
+        }
+        return Value::makeBytesId(vm.getHeap().allocateBytes(std::move(data)).id);
+    });
+
+    regProto("len", 1, [buffer](const std::vector<Value>& args) {
+        auto* b = args.empty() ? nullptr : buffer(args[0]);
+        return Value::makeInt(b ? static_cast<int64_t>(b->size()) : 0);
+    });
+
+    regProto("kind", 1, [&vm, buffer](const std::vector<Value>& args) {
+        auto* b = args.empty() ? nullptr : buffer(args[0]);
+        if (!b) return Value::makeNull();
+        return Value::makeStringId(vm.getHeap().internString(kindName(b->kind)).id);
+    });
+
+    // slice(start, end = len) - view of elements [start, end) sharing storage
+    regProtoVar("slice", [&vm, buffer](const std::vector<Value>& args) {
+        auto* b = args.empty() ? nullptr : buffer(args[0]);
+        if (!b) return Value::makeNull();
+        const size_t n = b->size();
+        auto s = args.size() > 1 ? toIndex(args[1]) : std::optional<int64_t>(0);
+        auto e = args.size() > 2 ? toIndex(args[2]) : std::optional<int64_t>(n);
+        if (!s || !e) return Value::makeNull();
+        const size_t start = clampIndex(*s, n);
+        const size_t end = std::max(start, clampIndex(*e, n));
+        const size_t width = ByteBuffer::elementSize(b->kind);
+        auto ref = vm.getHeap().allocateBytesView(*b, start * width, (end - start) * width, b->kind);
+        return Value::makeBytesId(ref.id);
+    });
+
+    // view(kind) - the same bytes read as another element kind; a trailing
+    // partial element is left out of the view.
+    regProto("view", 2, [&vm, buffer](const std::vector<Value>& args) {
+        auto* b = buffer(args[0]);
+        if (!b) return Value::makeNull();
+        auto kind = kindFromName(vm.resolveStringKey(args[1]));
+        if (!kind) return Value::makeNull();
+        const size_t width = ByteBuffer::elementSize(*kind);
+        auto ref = vm.getHeap().allocateBytesView(*b, 0, b->length / width * width, *kind);
+        return Value::makeBytesId(ref.id);
+    });
+
+    // copy() - same elements in storage of their own
+    regProto("copy", 1, [&vm, buffer](const std::vector<Value>& args) {
+        auto* b = buffer(args[0]);
+        if (!b) return Value::makeNull();
+        const uint8_t* p = b->data();
+        const ByteBuffer::Kind kind = b->kind;
+        auto& heap = vm.getHeap();
+        auto ref = heap.allocateBytes(std::vector<uint8_t>(p, p + b->length));
+        if (kind == ByteBuffer::Kind::U8) return Value::makeBytesId(ref.id);
+        auto* fresh = heap.bytes(ref.id);
+        return Value::makeBytesId(heap.allocateBytesView(*fresh, 0, fresh->length, kind).id);
+    });
+
+    // set(src, at = 0) - bulk copy src (bytes or array) starting at element
+    // `at`. Buffers of the same kind are copied with one memmove, so
+    // overlapping views of one storage are safe. Returns elements written.
+    regProtoVar("set", [&vm, buffer](const std::vector<Value>& args) {
+        auto* dst = args.empty() ? nullptr : buffer(args[0]);
+        if (!dst || args.size() < 2) return Value::makeInt(0);
+        auto at = args.size() > 2 ? toIndex(args[2]) : std::optional<int64_t>(0);
+        if (!at || *at < 0 || static_cast<size_t>(*at) > dst->size()) return Value::makeInt(0);
+        const size_t room = dst->size() - static_cast<size_t>(*at);
+        if (auto* src = buffer(args[1])) {
+            const size_t n = std::min(room, src->size());
+            if (src->kind == dst->kind) {
+                const size_t width = ByteBuffer::elementSize(dst->kind);
+                std::memmove(dst->data() + *at * width, src->data(), n * width);
+            } else {
+                for (size_t i = 0; i < n; ++i) dst->set(*at + i, src->get(i));
+            }
+            return Value::makeInt(static_cast<int64_t>(n));
+        }
+        if (args[1].isArrayId()) {
+            auto* arr = vm.getHeap().array(args[1].asArrayId());
+            if (!arr) return Value::makeInt(0);
+            const size_t n = std::min(room, arr->size());
+            size_t written = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if (dst->set(*at + i, (*arr)[i])) ++written;
+            }
+            return Value::makeInt(static_cast<int64_t>(written));
+        }
+        return Value::makeInt(0);
+    });
+
+    regProto("fill", 2, [buffer](const std::vector<Value>& args) {
+        auto* b = buffer(args[0]);
+        if (!b) return Value::makeNull();
+        if (b->size() == 0 || !b->set(0, args[1])) return args[0];
+        const size_t width = ByteBuffer::elementSize(b->kind);
+        uint8_t* p = b->data();
+        for (size_t i = 1; i < b->size(); ++i) std::memcpy(p + i * width, p, width);
+        return args[0];
+    });
+
+    regProto("toArray", 1, [&vm, buffer](const std::vector<Value>& args) {
+        auto* b = buffer(args[0]);
+        if (!b) return Value::makeNull();
+        auto& heap = vm.getHeap();
+        auto srcRoot = vm.makeRoot(args[0]);
+        auto resultRef = heap.allocateArray();
+        auto* out = heap.array(resultRef.id);
+        out->reserve(b->size());
+        for (size_t i = 0; i < b->size(); ++i) out->push_back(b->get(i));
+        return Value::makeArrayId(resultRef.id);
+    });
+
+    // toString() - the raw bytes as a string, whatever the element kind
+    regProto("toString", 1, [&vm, buffer](const std::vector<Value>& args) {
+        auto* b = buffer(args[0]);
+        if (!b) return Value::makeNull();
+        const char* p = reinterpret_cast<const char*>(b->data());
+        return Value::makeStringId(vm.getHeap().allocateString(std::string(p, p + b->length)).id);
+    });
+}
+
+} // namespace havel::compiler::prototypes
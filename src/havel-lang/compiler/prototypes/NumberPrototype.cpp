@@ -370,7 +370,7 @@ void registerObjectPrototype(VM& vm) {
         auto* arr = vm.getHeap().array(arrRef.id);
         auto keys = obj->getKeys();
         for (const auto& key : keys) {
-          auto ref = vm.getHeap().allocateString(key);
+          auto ref = vm.getHeap().internString(key);
           arr->push_back(Value::makeStringId(ref.id));
         }
         return Value::makeArrayId(arrRef.id);
@@ -405,7 +405,7 @@ void registerObjectPrototype(VM& vm) {
         for (const auto& [key, val] : *obj) {
           auto entryRef = vm.getHeap().allocateArray();
           auto* entry = vm.getHeap().array(entryRef.id);
-          auto kRef = vm.getHeap().allocateString(key);
+          auto kRef = vm.getHeap().internString(key);
           entry->push_back(Value::makeStringId(kRef.id));
           entry->push_back(val);
           arr->push_back(Value::makeArrayId(entryRef.id));
@@ -480,7 +480,7 @@ auto mergeFn = [&vm](const std::vector<Value>& args) -> Value {
                 for (const auto& [key, val] : *obj1) result->set(key, val);
                 for (const auto& [key, val] : *obj2) {
                     if (has_merger && result->get(key)) {
-                        auto keyRef = vm.getHeap().allocateString(key);
+                        auto keyRef = vm.getHeap().internString(key);
                         auto merged = vm.call(args[2], {Value::makeStringId(keyRef.id), result->get(key), val});
                         result->set(key, merged);
                     } else {
@@ -571,7 +571,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     auto* arr = vm.getHeap().array(arrRef.id);
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       auto mapped = vm.call(args[1], {Value::makeStringId(kRef.id), val});
       arr->push_back(mapped);
     }
@@ -605,7 +605,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     auto* result = vm.getHeap().object(resultRef.id);
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       auto predResult = vm.call(args[1], {Value::makeStringId(kRef.id), val});
       if (vm.toBoolPublic(predResult)) result->set(key, val);
     }
@@ -636,7 +636,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     if (!obj) return Value::makeNull();
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       vm.call(args[1], {Value::makeStringId(kRef.id), val});
     }
     return Value::makeNull();
@@ -652,7 +652,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     Value acc = args[2];
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       acc = vm.call(args[1], {acc, Value::makeStringId(kRef.id), val});
     }
     return acc;
@@ -697,7 +697,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
       if (key == "__set_marker__" || key == "__proto__") continue;
       std::string valStr = vm.toString(val);
       result->set(valStr, [&vm, &key]() -> Value {
-        auto kRef = vm.getHeap().allocateString(key);
+        auto kRef = vm.getHeap().internString(key);
         return Value::makeStringId(kRef.id);
       }());
     }
@@ -797,7 +797,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     auto* result = vm.getHeap().object(resultRef.id);
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       auto predResult = vm.call(args[1], {Value::makeStringId(kRef.id), val});
       if (vm.toBoolPublic(predResult)) result->set(key, val);
     }
@@ -813,7 +813,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     auto* result = vm.getHeap().object(resultRef.id);
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       auto predResult = vm.call(args[1], {Value::makeStringId(kRef.id), val});
       if (!vm.toBoolPublic(predResult)) result->set(key, val);
     }
@@ -836,7 +836,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
       int64_t c = 0;
       for (const auto& [key, val] : *obj) {
         if (key == "__set_marker__" || key == "__proto__") continue;
-        auto kRef = vm.getHeap().allocateString(key);
+        auto kRef = vm.getHeap().internString(key);
         auto r = vm.call(args[1], {Value::makeStringId(kRef.id), val});
         if (vm.toBoolPublic(r)) ++c;
       }
@@ -890,7 +890,7 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
     if (!obj) return Value::makeNull();
     for (const auto& [key, val] : *obj) {
       if (key == "__set_marker__" || key == "__proto__") continue;
-      auto kRef = vm.getHeap().allocateString(key);
+      auto kRef = vm.getHeap().internString(key);
       vm.call(args[1], {Value::makeStringId(kRef.id), val});
     }
     return Value::makeNull();
@@ -962,444 +962,252 @@ regProto("sortKey", 2, [&vm](const std::vector<Value>& args) {
   });
 }
 
+// Set members are canonical Values (see GCHeap::setMember), so methods hand
+// them back as is and copy them between sets without re-keying.
 void registerSetPrototype(VM& vm) {
   auto regProto = [&vm](const std::string& method, size_t arity, BytecodeHostFunction fn) {
     vm.registerHostFunction("set." + method, arity, std::move(fn));
     vm.registerPrototypeMethodByName("set", method, "set." + method);
   };
 
-  regProto("len", 1, [&vm](const std::vector<Value>& args) {
-    if (args.empty()) return Value::makeInt(0);
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      return Value::makeInt(set ? static_cast<int64_t>(set->size()) : 0);
+  auto setOf = [&vm](const Value& v) -> const ValueSet* {
+    return v.isSetId() ? vm.getHeap().set(v.asSetId()) : nullptr;
+  };
+
+  // Members copied out before running script callbacks or allocating per
+  // member, so the loop never walks a set that is being changed.
+  auto snapshot = [](const ValueSet& set) {
+    return std::vector<Value>(set.begin(), set.end());
+  };
+
+  auto arrayOf = [&vm](const std::vector<Value>& vals) {
+    auto arrRef = vm.getHeap().allocateArray();
+    auto* arr = vm.getHeap().array(arrRef.id);
+    arr->reserve(vals.size());
+    for (const auto& v : vals) arr->push_back(v);
+    return Value::makeArrayId(arrRef.id);
+  };
+
+  // New set holding the members of `a` for which keep(member) holds
+  auto filtered = [&vm](const ValueSet& a, auto keep) {
+    auto resultRef = vm.getHeap().allocateSet();
+    for (const Value& member : a) {
+      if (keep(member)) vm.setAdd(resultRef.id, member);
     }
-    return Value::makeInt(0);
+    return resultRef.id;
+  };
+
+  regProto("len", 1, [setOf](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    return Value::makeInt(set ? static_cast<int64_t>(set->size()) : 0);
   });
 
   regProto("has", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeBool(false);
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        std::string key;
-        if (args[1].isInt()) {
-          key = std::to_string(args[1].asInt());
-        } else if (args[1].isStringValId() && vm.getCurrentChunk()) {
-          key = vm.getCurrentChunk()->getString(args[1].asStringValId());
-        } else if (args[1].isStringId() && vm.getHeap().string(args[1].asStringId())) {
-          key = *vm.getHeap().string(args[1].asStringId());
-        } else {
-          return Value::makeBool(false);
-        }
-        return Value::makeBool(set->find(key) != set->end());
-      }
-    }
-    return Value::makeBool(false);
+    if (args.size() < 2 || !args[0].isSetId()) return Value::makeBool(false);
+    return Value::makeBool(vm.setHas(args[0].asSetId(), args[1]));
   });
 
-  regProto("add", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeNull();
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        std::string key;
-        if (args[1].isInt()) {
-          key = std::to_string(args[1].asInt());
-        } else if (args[1].isStringValId() && vm.getCurrentChunk()) {
-          key = vm.getCurrentChunk()->getString(args[1].asStringValId());
-        } else if (args[1].isStringId() && vm.getHeap().string(args[1].asStringId())) {
-          key = *vm.getHeap().string(args[1].asStringId());
-        } else {
-          return Value::makeNull();
-        }
-        (*set)[key] = Value::makeBool(true);
-        return args[0];
-      }
-    }
-    return Value::makeNull();
+  regProto("includes", 2, [&vm](const std::vector<Value>& args) {
+    if (args.size() < 2 || !args[0].isSetId()) return Value::makeBool(false);
+    return Value::makeBool(vm.setHas(args[0].asSetId(), args[1]));
+  });
+
+  regProto("add", 2, [&vm, setOf](const std::vector<Value>& args) {
+    if (args.size() < 2 || !setOf(args[0])) return Value::makeNull();
+    vm.setAdd(args[0].asSetId(), args[1]);
+    return args[0];
   });
 
   regProto("delete", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeBool(false);
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        std::string key;
-        if (args[1].isInt()) {
-          key = std::to_string(args[1].asInt());
-        } else if (args[1].isStringValId() && vm.getCurrentChunk()) {
-          key = vm.getCurrentChunk()->getString(args[1].asStringValId());
-        } else if (args[1].isStringId() && vm.getHeap().string(args[1].asStringId())) {
-          key = *vm.getHeap().string(args[1].asStringId());
-        } else {
-          return Value::makeBool(false);
-        }
-        return Value::makeBool(set->erase(key) > 0);
-      }
-    }
-    return Value::makeBool(false);
+    if (args.size() < 2 || !args[0].isSetId()) return Value::makeBool(false);
+    return Value::makeBool(vm.setRemove(args[0].asSetId(), args[1]));
   });
 
-  regProto("list", 1, [&vm](const std::vector<Value>& args) {
-    if (args.empty()) return Value::makeNull();
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        auto arrRef = vm.getHeap().allocateArray();
-        auto* arr = vm.getHeap().array(arrRef.id);
-        for (const auto& [key, val] : *set) {
-          // Try to parse as int, otherwise use string
-          try {
-            arr->push_back(Value::makeInt(std::stoll(key)));
-          } catch (...) {
-            auto ref = vm.getHeap().allocateString(key);
-            arr->push_back(Value::makeStringId(ref.id));
-          }
-        }
-        return Value::makeArrayId(arrRef.id);
-      }
-    }
-    return Value::makeNull();
+  regProto("discard", 2, [&vm, setOf](const std::vector<Value>& args) {
+    if (args.size() < 2 || !setOf(args[0])) return Value::makeNull();
+    vm.setRemove(args[0].asSetId(), args[1]);
+    return args[0];
   });
 
   // empty: {1,2,3}.empty() -> false
-  regProto("empty", 1, [&vm](const std::vector<Value>& args) {
-    if (args.empty()) return Value::makeBool(true);
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      return Value::makeBool(!set || set->empty());
-    }
-    return Value::makeBool(true);
+  regProto("empty", 1, [setOf](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    return Value::makeBool(!set || set->empty());
   });
 
-  // union: {1,2,3}.union({3,4,5}) -> {1,2,3,4,5}
-  regProto("union", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeNull();
-    if (args[0].isSetId() && args[1].isSetId()) {
-      auto* s1 = vm.getHeap().set(args[0].asSetId());
-      auto* s2 = vm.getHeap().set(args[1].asSetId());
-      if (s1 && s2) {
-        auto resultRef = vm.getHeap().allocateSet();
-        auto* result = vm.getHeap().set(resultRef.id);
-        for (const auto& [k, v] : *s1) (*result)[k] = v;
-        for (const auto& [k, v] : *s2) (*result)[k] = v;
-        return Value::makeSetId(resultRef.id);
-      }
-    }
-    return Value::makeNull();
+  regProto("list", 1, [setOf, snapshot, arrayOf](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    if (!set) return Value::makeNull();
+    return arrayOf(snapshot(*set));
   });
 
-  // intersection: {1,2,3}.intersection({2,3,4}) -> {2,3}
-  regProto("intersection", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeNull();
-    if (args[0].isSetId() && args[1].isSetId()) {
-      auto* s1 = vm.getHeap().set(args[0].asSetId());
-      auto* s2 = vm.getHeap().set(args[1].asSetId());
-      if (s1 && s2) {
-        auto resultRef = vm.getHeap().allocateSet();
-        auto* result = vm.getHeap().set(resultRef.id);
-        for (const auto& [k, v] : *s1) {
-          if (s2->find(k) != s2->end()) (*result)[k] = v;
-        }
-        return Value::makeSetId(resultRef.id);
-      }
-    }
-    return Value::makeNull();
+  regProto("unique", 1, [setOf, snapshot, arrayOf](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    if (!set) return Value::makeNull();
+    return arrayOf(snapshot(*set));
   });
 
-  // difference: {1,2,3}.difference({2,3}) -> {1}
-  regProto("difference", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeNull();
-    if (args[0].isSetId() && args[1].isSetId()) {
-      auto* s1 = vm.getHeap().set(args[0].asSetId());
-      auto* s2 = vm.getHeap().set(args[1].asSetId());
-      if (s1 && s2) {
-        auto resultRef = vm.getHeap().allocateSet();
-        auto* result = vm.getHeap().set(resultRef.id);
-        for (const auto& [k, v] : *s1) {
-          if (s2->find(k) == s2->end()) (*result)[k] = v;
-        }
-        return Value::makeSetId(resultRef.id);
-      }
-    }
-    return Value::makeNull();
+  regProto("reversed", 1, [setOf, snapshot, arrayOf](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    if (!set) return Value::makeNull();
+    auto vals = snapshot(*set);
+    std::reverse(vals.begin(), vals.end());
+    return arrayOf(vals);
   });
 
-    regProto("isSubsetOf", 2, [&vm](const std::vector<Value>& args) {
-        if (args.size() < 2) return Value::makeBool(false);
-        if (args[0].isSetId() && args[1].isSetId()) {
-            auto* s1 = vm.getHeap().set(args[0].asSetId());
-            auto* s2 = vm.getHeap().set(args[1].asSetId());
-            if (s1 && s2) {
-                for (const auto& [k, v] : *s1) {
-                    if (s2->find(k) == s2->end()) return Value::makeBool(false);
-                }
-                return Value::makeBool(true);
-            }
-        }
-        return Value::makeBool(false);
-    });
-
-    auto setKeyFromValue = [&vm](const Value& v) -> std::string {
-        if (v.isInt()) return std::to_string(v.asInt());
-        if (v.isStringValId() && vm.getCurrentChunk()) return vm.getCurrentChunk()->getString(v.asStringValId());
-        if (v.isStringId() && vm.getHeap().string(v.asStringId())) return *vm.getHeap().string(v.asStringId());
-        return vm.toString(v);
+  // sorted: numbers ascending, then strings by bytes, then everything else
+  regProto("sorted", 1, [&vm, setOf, snapshot, arrayOf](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    if (!set) return Value::makeNull();
+    auto vals = snapshot(*set);
+    auto rank = [](const Value& v) {
+      if (v.isInt() || v.isDouble()) return 0;
+      if (v.isStringId()) return 1;
+      return 2;
     };
-
-    auto valueFromKey = [&vm](const std::string& key) -> Value {
-        try { return Value::makeInt(std::stoll(key)); }
-        catch (...) { auto ref = vm.getHeap().allocateString(key); return Value::makeStringId(ref.id); }
-    };
-
-  regProto("includes", 2, [&vm, &setKeyFromValue](const std::vector<Value>& args) {
-    if (args.size() < 2) return Value::makeBool(false);
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        std::string key = setKeyFromValue(args[1]);
-                return Value::makeBool(set->find(key) != set->end());
-            }
-        }
-        return Value::makeBool(false);
+    std::stable_sort(vals.begin(), vals.end(), [&vm, rank](const Value& a, const Value& b) {
+      const int ra = rank(a), rb = rank(b);
+      if (ra != rb) return ra < rb;
+      if (ra == 0) {
+        if (a.isInt() && b.isInt()) return a.asInt() < b.asInt();
+        return vm.toFloatPublic(a) < vm.toFloatPublic(b);
+      }
+      if (ra == 1) {
+        const std::string* sa = vm.getStringPtr(a);
+        const std::string* sb = vm.getStringPtr(b);
+        return sa && sb && *sa < *sb;
+      }
+      return false;
     });
+    return arrayOf(vals);
+  });
 
-    regProto("clone", 1, [&vm](const std::vector<Value>& args) {
-        if (args.empty()) return Value::makeNull();
-        if (args[0].isSetId()) {
-            auto* s = vm.getHeap().set(args[0].asSetId());
-            if (s) {
-                auto resultRef = vm.getHeap().allocateSet();
-                auto* result = vm.getHeap().set(resultRef.id);
-                for (const auto& [k, v] : *s) (*result)[k] = v;
-                return Value::makeSetId(resultRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
+  regProto("clone", 1, [setOf, filtered](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    if (!set) return Value::makeNull();
+    return Value::makeSetId(filtered(*set, [](const Value&) { return true; }));
+  });
 
-  regProto("foreach", 2, [&vm, &valueFromKey](const std::vector<Value>& args) {
-    if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeNull();
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        for (const auto& [k, v] : *set) {
-          vm.call(args[1], {valueFromKey(k)});
-        }
-      }
-    }
+  regProto("toSet", 1, [](const std::vector<Value>& args) {
+    if (args.empty()) return Value::makeNull();
+    if (args[0].isSetId()) return args[0];
     return Value::makeNull();
   });
 
-  regProto("each", 2, [&vm, &valueFromKey](const std::vector<Value>& args) {
+  auto forEach = [&vm, setOf, snapshot](const std::vector<Value>& args) {
     if (args.size() < 2 || (!args[1].isFunctionObjId() && !args[1].isClosureId())) return Value::makeNull();
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        for (const auto& [k, v] : *set) {
-          vm.call(args[1], {valueFromKey(k)});
-        }
-      }
+    auto* set = setOf(args[0]);
+    if (!set) return Value::makeNull();
+    for (const Value& member : snapshot(*set)) {
+      vm.call(args[1], {member});
     }
     return Value::makeNull();
-  });
-
-    regProto("sorted", 1, [&vm, &valueFromKey](const std::vector<Value>& args) {
-        if (args.empty()) return Value::makeNull();
-        if (args[0].isSetId()) {
-            auto* s = vm.getHeap().set(args[0].asSetId());
-            if (s) {
-                std::vector<Value> vals;
-                for (const auto& [k, v] : *s) vals.push_back(valueFromKey(k));
-                std::sort(vals.begin(), vals.end(), [](const Value& a, const Value& b) {
-                    if (a.isInt() && b.isInt()) return a.asInt() < b.asInt();
-                    if (a.isDouble() && b.isDouble()) return a.asDouble() < b.asDouble();
-                    return false;
-                });
-                auto arrRef = vm.getHeap().allocateArray();
-                auto* arr = vm.getHeap().array(arrRef.id);
-                for (const auto& v : vals) arr->push_back(v);
-                return Value::makeArrayId(arrRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
-
-    regProto("unique", 1, [&vm, &valueFromKey](const std::vector<Value>& args) {
-        if (args.empty()) return Value::makeNull();
-        if (args[0].isSetId()) {
-            auto* s = vm.getHeap().set(args[0].asSetId());
-            if (s) {
-                auto resultRef = vm.getHeap().allocateArray();
-                auto* arr = vm.getHeap().array(resultRef.id);
-                for (const auto& [k, v] : *s) arr->push_back(valueFromKey(k));
-                return Value::makeArrayId(resultRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
-
-    regProto("reversed", 1, [&vm, &valueFromKey](const std::vector<Value>& args) {
-        if (args.empty()) return Value::makeNull();
-        if (args[0].isSetId()) {
-            auto* s = vm.getHeap().set(args[0].asSetId());
-            if (s) {
-                std::vector<Value> vals;
-                for (const auto& [k, v] : *s) vals.push_back(valueFromKey(k));
-                auto arrRef = vm.getHeap().allocateArray();
-                auto* arr = vm.getHeap().array(arrRef.id);
-                for (auto it = vals.rbegin(); it != vals.rend(); ++it) arr->push_back(*it);
-                return Value::makeArrayId(arrRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
-
-    regProto("isSupersetOf", 2, [&vm](const std::vector<Value>& args) {
-        if (args.size() < 2) return Value::makeBool(false);
-        if (args[0].isSetId() && args[1].isSetId()) {
-            auto* s1 = vm.getHeap().set(args[0].asSetId());
-            auto* s2 = vm.getHeap().set(args[1].asSetId());
-            if (s1 && s2) {
-                for (const auto& [k, v] : *s2) {
-                    if (s1->find(k) == s1->end()) return Value::makeBool(false);
-                }
-                return Value::makeBool(true);
-            }
-        }
-        return Value::makeBool(false);
-    });
-
-    regProto("symmetricDifference", 2, [&vm](const std::vector<Value>& args) {
-        if (args.size() < 2) return Value::makeNull();
-        if (args[0].isSetId() && args[1].isSetId()) {
-            auto* s1 = vm.getHeap().set(args[0].asSetId());
-            auto* s2 = vm.getHeap().set(args[1].asSetId());
-            if (s1 && s2) {
-                auto resultRef = vm.getHeap().allocateSet();
-                auto* result = vm.getHeap().set(resultRef.id);
-                for (const auto& [k, v] : *s1) { if (s2->find(k) == s2->end()) (*result)[k] = v; }
-                for (const auto& [k, v] : *s2) { if (s1->find(k) == s1->end()) (*result)[k] = v; }
-                return Value::makeSetId(resultRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
-
-    regProto("cartesianProduct", 2, [&vm, &valueFromKey](const std::vector<Value>& args) {
-        if (args.size() < 2) return Value::makeNull();
-        if (args[0].isSetId() && args[1].isSetId()) {
-            auto* s1 = vm.getHeap().set(args[0].asSetId());
-            auto* s2 = vm.getHeap().set(args[1].asSetId());
-            if (s1 && s2) {
-                auto resultRef = vm.getHeap().allocateArray();
-                auto* result = vm.getHeap().array(resultRef.id);
-                for (const auto& [k1, v1] : *s1) {
-                    for (const auto& [k2, v2] : *s2) {
-                        auto pairRef = vm.getHeap().allocateArray();
-                        auto* pair = vm.getHeap().array(pairRef.id);
-                        pair->push_back(valueFromKey(k1));
-                        pair->push_back(valueFromKey(k2));
-                        result->push_back(Value::makeArrayId(pairRef.id));
-                    }
-                }
-                return Value::makeArrayId(resultRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
-
-    regProto("powerSet", 1, [&vm](const std::vector<Value>& args) {
-        if (args.empty()) return Value::makeNull();
-        if (args[0].isSetId()) {
-            auto* s = vm.getHeap().set(args[0].asSetId());
-            if (s) {
-                std::vector<std::string> keys;
-                for (const auto& [k, v] : *s) keys.push_back(k);
-                auto n = keys.size();
-                auto resultRef = vm.getHeap().allocateArray();
-                auto* result = vm.getHeap().array(resultRef.id);
-                uint64_t total = (n > 63) ? (1ULL << 63) : (1ULL << n);
-                for (uint64_t mask = 0; mask < total; ++mask) {
-                    auto subsetRef = vm.getHeap().allocateSet();
-                    auto* subset = vm.getHeap().set(subsetRef.id);
-                    for (size_t i = 0; i < n; ++i) {
-                        if (mask & (1ULL << i)) (*subset)[keys[i]] = Value::makeBool(true);
-                    }
-                    result->push_back(Value::makeSetId(subsetRef.id));
-                }
-                return Value::makeArrayId(resultRef.id);
-            }
-        }
-        return Value::makeNull();
-    });
-
-    regProto("toSet", 1, [](const std::vector<Value>& args) {
-        if (args.empty()) return Value::makeNull();
-        if (args[0].isSetId()) return args[0];
-        return Value::makeNull();
-    });
+  };
+  regProto("foreach", 2, forEach);
+  regProto("each", 2, forEach);
 
-  regProto("discard", 2, [&vm, &setKeyFromValue](const std::vector<Value>& args) {
+  // union: {1,2,3}.union({3,4,5}) -> {1,2,3,4,5}
+  regProto("union", 2, [&vm, setOf, filtered](const std::vector<Value>& args) {
     if (args.size() < 2) return Value::makeNull();
-    if (args[0].isSetId()) {
-      auto* set = vm.getHeap().set(args[0].asSetId());
-      if (set) {
-        std::string key = setKeyFromValue(args[1]);
-        set->erase(key);
-        return args[0];
-      }
-    }
-    return Value::makeNull();
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
+    if (!s1 || !s2) return Value::makeNull();
+    const uint32_t id = filtered(*s1, [](const Value&) { return true; });
+    for (const Value& member : *s2) vm.setAdd(id, member);
+    return Value::makeSetId(id);
   });
 
-  regProto("list", 1, [&vm, &valueFromKey](const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isSetId()) return Value::makeNull();
-    auto* s = vm.getHeap().set(args[0].asSetId());
-    if (!s) return Value::makeNull();
-    auto arrRef = vm.getHeap().allocateArray();
-    auto* arr = vm.getHeap().array(arrRef.id);
-    for (const auto& [k, v] : *s) arr->push_back(valueFromKey(k));
-    return Value::makeArrayId(arrRef.id);
+  // intersection: {1,2,3}.intersection({2,3,4}) -> {2,3}
+  regProto("intersection", 2, [setOf, filtered](const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::makeNull();
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
+    if (!s1 || !s2) return Value::makeNull();
+    return Value::makeSetId(filtered(*s1, [s2](const Value& m) { return s2->contains(m); }));
   });
 
-regProto("union", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2 || !args[0].isSetId() || !args[1].isSetId()) return Value::makeNull();
-    auto* s1 = vm.getHeap().set(args[0].asSetId());
-    auto* s2 = vm.getHeap().set(args[1].asSetId());
+  // difference: {1,2,3}.difference({2,3}) -> {1}
+  regProto("difference", 2, [setOf, filtered](const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::makeNull();
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
     if (!s1 || !s2) return Value::makeNull();
-    auto resultRef = vm.getHeap().allocateSet();
-    auto* result = vm.getHeap().set(resultRef.id);
-    for (const auto& [k, v] : *s1) (*result)[k] = v;
-    for (const auto& [k, v] : *s2) (*result)[k] = v;
-    return Value::makeSetId(resultRef.id);
-});
+    return Value::makeSetId(filtered(*s1, [s2](const Value& m) { return !s2->contains(m); }));
+  });
 
-  regProto("intersection", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2 || !args[0].isSetId() || !args[1].isSetId()) return Value::makeNull();
-    auto* s1 = vm.getHeap().set(args[0].asSetId());
-    auto* s2 = vm.getHeap().set(args[1].asSetId());
+  regProto("symmetricDifference", 2, [&vm, setOf, filtered](const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::makeNull();
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
     if (!s1 || !s2) return Value::makeNull();
-    auto resultRef = vm.getHeap().allocateSet();
-    auto* result = vm.getHeap().set(resultRef.id);
-    for (const auto& [k, v] : *s1) {
-      if (s2->find(k) != s2->end()) (*result)[k] = v;
+    const uint32_t id = filtered(*s1, [s2](const Value& m) { return !s2->contains(m); });
+    for (const Value& member : *s2) {
+      if (!s1->contains(member)) vm.setAdd(id, member);
     }
-    return Value::makeSetId(resultRef.id);
+    return Value::makeSetId(id);
   });
 
-  regProto("difference", 2, [&vm](const std::vector<Value>& args) {
-    if (args.size() < 2 || !args[0].isSetId() || !args[1].isSetId()) return Value::makeNull();
-    auto* s1 = vm.getHeap().set(args[0].asSetId());
-    auto* s2 = vm.getHeap().set(args[1].asSetId());
+  auto subset = [](const ValueSet& small, const ValueSet& big) {
+    if (small.size() > big.size()) return false;
+    for (const Value& member : small) {
+      if (!big.contains(member)) return false;
+    }
+    return true;
+  };
+
+  regProto("isSubsetOf", 2, [setOf, subset](const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::makeBool(false);
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
+    return Value::makeBool(s1 && s2 && subset(*s1, *s2));
+  });
+
+  regProto("isSupersetOf", 2, [setOf, subset](const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::makeBool(false);
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
+    return Value::makeBool(s1 && s2 && subset(*s2, *s1));
+  });
+
+  regProto("cartesianProduct", 2, [&vm, setOf, snapshot](const std::vector<Value>& args) {
+    if (args.size() < 2) return Value::makeNull();
+    auto* s1 = setOf(args[0]);
+    auto* s2 = setOf(args[1]);
     if (!s1 || !s2) return Value::makeNull();
-    auto resultRef = vm.getHeap().allocateSet();
-    auto* result = vm.getHeap().set(resultRef.id);
-    for (const auto& [k, v] : *s1) {
-      if (s2->find(k) == s2->end()) (*result)[k] = v;
+    const auto left = snapshot(*s1);
+    const auto right = snapshot(*s2);
+    auto& heap = vm.getHeap();
+    auto resultRef = heap.allocateArray();
+    auto* result = heap.array(resultRef.id);
+    result->reserve(left.size() * right.size());
+    for (const Value& a : left) {
+      for (const Value& b : right) {
+        auto pairRef = heap.allocateArray();
+        auto* pair = heap.array(pairRef.id);
+        pair->push_back(a);
+        pair->push_back(b);
+        result->push_back(Value::makeArrayId(pairRef.id));
+      }
+    }
+    return Value::makeArrayId(resultRef.id);
+  });
+
+  regProto("powerSet", 1, [&vm, setOf, snapshot](const std::vector<Value>& args) {
+    auto* set = args.empty() ? nullptr : setOf(args[0]);
+    if (!set) return Value::makeNull();
+    const auto members = snapshot(*set);
+    const size_t n = members.size();
+    auto resultRef = vm.getHeap().allocateArray();
+    auto* result = vm.getHeap().array(resultRef.id);
+    uint64_t total = (n > 63) ? (1ULL << 63) : (1ULL << n);
+    for (uint64_t mask = 0; mask < total; ++mask) {
+      auto subsetRef = vm.getHeap().allocateSet();
+      for (size_t i = 0; i < n; ++i) {
+        if (mask & (1ULL << i)) vm.setAdd(subsetRef.id, members[i]);
+      }
+      result->push_back(Value::makeSetId(subsetRef.id));
     }
-    return Value::makeSetId(resultRef.id);
+    return Value::makeArrayId(resultRef.id);
   });
 }
 
@@ -16,5 +16,6 @@ void registerBoolPrototype(VM& vm);
 void registerObjectPrototype(VM& vm);
 void registerSetPrototype(VM& vm);
 void registerRangePrototype(VM& vm);
+void registerBytesPrototype(VM& vm);
 
 } // namespace havel::compiler::prototypes
@@ -21,6 +21,22 @@ static std::string extractString(VM& vm, const Value& v) {
   return "";
 }
 
+// Helper: view a string value's bytes without copying them. The view is
+// only good until the next allocation that could collect the string.
+static std::string_view viewString(VM& vm, const Value& v) {
+  if (v.isStringValId() || v.isRegexValId()) {
+      const uint32_t idx = v.isStringValId() ? v.asStringValId() : v.asRegexValId();
+      if (vm.getCurrentChunk()) return vm.getCurrentChunk()->getString(idx);
+      auto mc = vm.getMainChunk();
+      if (mc) return mc->getString(idx);
+      return {};
+  }
+  if (v.isStringId()) {
+      if (const std::string* s = vm.getHeap().string(v.asStringId())) return *s;
+  }
+  return {};
+}
+
 static std::string extractStringArg(VM& vm, const std::vector<Value>& args, size_t i, const std::string& fallback) {
   if (i >= args.size()) return fallback;
   if (args[i].isStringValId()) {
@@ -178,56 +194,27 @@ void registerStringPrototype(VM& vm) {
 
 regProto("codePointAt", 2, [&vm](const std::vector<Value>& args) {
         if (args.size() < 2) return Value::makeInt(-1);
-        std::string s = extractString(vm, args[0]);
+        std::string_view s = viewString(vm, args[0]);
         int64_t idx = args[1].isInt() ? args[1].asInt() : 0;
-        size_t bytePos = 0;
-        int64_t cpIdx = 0;
-        while (bytePos < s.size() && cpIdx < idx) {
-            unsigned char c = static_cast<unsigned char>(s[bytePos]);
-            if (c < 0x80) bytePos += 1;
-            else if ((c & 0xE0) == 0xC0) bytePos += 2;
-            else if ((c & 0xF0) == 0xE0) bytePos += 3;
-            else if ((c & 0xF8) == 0xF0) bytePos += 4;
-            else bytePos += 1;
-            cpIdx++;
-        }
+        if (idx < 0) idx = 0;
+        Utf8Index scratch;
+        const Utf8Index& cps = vm.utf8Index(args[0], scratch);
+        size_t bytePos = cps.byteOffset(s, static_cast<size_t>(idx));
         if (bytePos >= s.size()) return Value::makeInt(-1);
-        unsigned char c = static_cast<unsigned char>(s[bytePos]);
-        int32_t codepoint;
-        size_t cpLen;
-        if (c < 0x80) { codepoint = c; cpLen = 1; }
-        else if ((c & 0xE0) == 0xC0) { codepoint = (c & 0x1F); cpLen = 2; }
-        else if ((c & 0xF0) == 0xE0) { codepoint = (c & 0x0F); cpLen = 3; }
-        else if ((c & 0xF8) == 0xF0) { codepoint = (c & 0x07); cpLen = 4; }
-        else { codepoint = c; cpLen = 1; }
-        for (size_t i = 1; i < cpLen && bytePos + i < s.size(); ++i) {
-            codepoint = (codepoint << 6) | (static_cast<unsigned char>(s[bytePos + i]) & 0x3F);
-        }
-        return Value::makeInt(static_cast<int64_t>(codepoint));
+        return Value::makeInt(Utf8Index::decodeAt(s, bytePos));
     });
 
     regProto("cpAtByte", 2, [&vm](const std::vector<Value>& args) {
         if (args.size() < 2) return Value::makeInt(-1);
-        std::string s = extractString(vm, args[0]);
+        std::string_view s = viewString(vm, args[0]);
         int64_t bytePos = args[1].isInt() ? args[1].asInt() : 0;
         if (bytePos < 0 || static_cast<size_t>(bytePos) >= s.size()) return Value::makeInt(-1);
-        unsigned char c = static_cast<unsigned char>(s[static_cast<size_t>(bytePos)]);
-        int32_t codepoint;
-        size_t cpLen;
-        if (c < 0x80) { codepoint = c; cpLen = 1; }
-        else if ((c & 0xE0) == 0xC0) { codepoint = (c & 0x1F); cpLen = 2; }
-        else if ((c & 0xF0) == 0xE0) { codepoint = (c & 0x0F); cpLen = 3; }
-        else if ((c & 0xF8) == 0xF0) { codepoint = (c & 0x07); cpLen = 4; }
-        else { codepoint = c; cpLen = 1; }
-        for (size_t i = 1; i < cpLen && static_cast<size_t>(bytePos) + i < s.size(); ++i) {
-            codepoint = (codepoint << 6) | (static_cast<unsigned char>(s[static_cast<size_t>(bytePos) + i]) & 0x3F);
-        }
-        return Value::makeInt(static_cast<int64_t>(codepoint));
+        return Value::makeInt(Utf8Index::decodeAt(s, static_cast<size_t>(bytePos)));
     });
 
     regProto("cpByteLen", 2, [&vm](const std::vector<Value>& args) {
         if (args.size() < 2) return Value::makeInt(0);
-        std::string s = extractString(vm, args[0]);
+        std::string_view s = viewString(vm, args[0]);
         int64_t bytePos = args[1].isInt() ? args[1].asInt() : 0;
         if (bytePos < 0 || static_cast<size_t>(bytePos) >= s.size()) return Value::makeInt(0);
         unsigned char c = static_cast<unsigned char>(s[static_cast<size_t>(bytePos)]);
@@ -485,7 +472,7 @@ regProtoVar("find", [&vm](const std::vector<Value>& args) {
 
     regProtoVar("slice", [&vm](const std::vector<Value>& args) {
     if (args.empty()) return Value::makeNull();
-    std::string s = extractString(vm, args[0]);
+    std::string_view s = viewString(vm, args[0]);
     if (s.empty()) { auto ref = vm.getHeap().allocateString(""); return Value::makeStringId(ref.id); }
 
     int64_t sz = static_cast<int64_t>(s.size());
@@ -529,7 +516,9 @@ regProtoVar("find", [&vm](const std::vector<Value>& args) {
     if (step < 0 && start <= end) { auto ref = vm.getHeap().allocateString(""); return Value::makeStringId(ref.id); }
 
     std::string result;
-    if (step > 0) {
+    if (step == 1) {
+      result.assign(s.substr(static_cast<size_t>(start), static_cast<size_t>(end - start)));
+    } else if (step > 0) {
       for (int64_t i = start; i < end; i += step) {
         result += s[static_cast<size_t>(i)];
       }
@@ -545,7 +534,7 @@ regProtoVar("find", [&vm](const std::vector<Value>& args) {
   // substr alias for sub
   regProtoVar("substr", [&vm](const std::vector<Value>& args) {
     if (args.size() < 2) return Value::makeNull();
-    std::string s = extractString(vm, args[0]);
+    std::string_view s = viewString(vm, args[0]);
     int64_t start = args[1].isInt() ? args[1].asInt() : 0;
     if (start < 0) start = std::max(static_cast<int64_t>(0), static_cast<int64_t>(s.size()) + start);
     int64_t len = (args.size() > 2 && args[2].isInt()) ? args[2].asInt() : static_cast<int64_t>(s.size()) - start;
@@ -555,7 +544,7 @@ regProtoVar("find", [&vm](const std::vector<Value>& args) {
     }
     if (len < 0) len = 0;
     if (static_cast<size_t>(start + len) > s.size()) len = s.size() - start;
-    auto ref = vm.getHeap().allocateString(s.substr(static_cast<size_t>(start), static_cast<size_t>(len)));
+    auto ref = vm.getHeap().allocateString(std::string(s.substr(static_cast<size_t>(start), static_cast<size_t>(len))));
     return Value::makeStringId(ref.id);
   });
 
@@ -465,7 +465,7 @@ std::string BytecodeDisassembler::disassembleFunction(
         std::unordered_map<uint32_t, std::string> slotNameMap;
         for (size_t i = 0; i < function->instructions.size(); ++i) {
             const auto& instr = function->instructions[i];
-            if ((instr.opcode == OpCode::LOAD_VAR ||
+            if ((unfusedOpcode(instr.opcode) == OpCode::LOAD_VAR ||
                  instr.opcode == OpCode::STORE_VAR ||
                  instr.opcode == OpCode::STORE_IMMUT_VAR) &&
                 instr.operands.size() >= 1) {
@@ -516,14 +516,24 @@ std::string BytecodeDisassembler::disassembleFunction(
         ss << "\n";
     }
 
+    // Instructions covered by a superinstruction are still listed (jumps may
+    // land on them) but marked with the head that runs them.
+    size_t fusedHead = 0;
+    size_t fusedEnd = 0;
     for (size_t i = 0; i < function->instructions.size(); ++i) {
         for (const auto& [tryStart, tryEnd, catchIp] : tryBlocks) {
             if (i == tryStart) ss << "  ┌─ try ─\n";
         }
 
-        ss << formatInstruction(static_cast<uint32_t>(i),
-                                function->instructions[i],
-                                options) << "\n";
+        const auto& instr = function->instructions[i];
+        ss << formatInstruction(static_cast<uint32_t>(i), instr, options, function);
+        if (i < fusedEnd) {
+            ss << " ; fused into " << fusedHead;
+        } else if (superinstructionLength(instr.opcode) > 1) {
+            fusedHead = i;
+            fusedEnd = i + superinstructionLength(instr.opcode);
+        }
+        ss << "\n";
 
         for (const auto& [tryStart, tryEnd, catchIp] : tryBlocks) {
             if (i == tryEnd) ss << "  └─ end try ─\n";
@@ -549,8 +559,9 @@ std::string BytecodeDisassembler::disassembleFunction(
 }
 
 std::string BytecodeDisassembler::disassembleInstruction(
-    const Instruction& instr, uint32_t index, const Options& options) const {
-    return formatInstruction(index, instr, options);
+    const Instruction& instr, uint32_t index, const Options& options,
+    const BytecodeFunction* function) const {
+    return formatInstruction(index, instr, options, function);
 }
 
 std::string BytecodeDisassembler::disassembleConstantPool() const {
@@ -861,6 +872,27 @@ case OpCode::WAITGROUP_WAIT: return "WAITGROUP_WAIT";
     case OpCode::FORMAT_BASE64_DECODE: return "FORMAT_BASE64_DECODE";
 
     case OpCode::NOP: return "NOP";
+
+    // Superinstructions
+    case OpCode::LOAD_VAR_LOAD_CONST_BINOP: return "LOAD_VAR_LOAD_CONST_BINOP";
+    case OpCode::LOAD_VAR_LOAD_VAR_BINOP: return "LOAD_VAR_LOAD_VAR_BINOP";
+    case OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP: return "LOAD_VAR_LOAD_CONST_CMP_JUMP";
+    case OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP: return "LOAD_VAR_LOAD_VAR_CMP_JUMP";
+    case OpCode::DUP_STORE_VAR_POP: return "DUP_STORE_VAR_POP";
+    case OpCode::DUP_STORE_GLOBAL_POP: return "DUP_STORE_GLOBAL_POP";
+
+    // Quickened forms (only seen when disassembling a running function)
+    case OpCode::ADD_INT: return "ADD_INT";
+    case OpCode::ADD_NUM: return "ADD_NUM";
+    case OpCode::ADD_STR: return "ADD_STR";
+    case OpCode::SUB_INT: return "SUB_INT";
+    case OpCode::SUB_NUM: return "SUB_NUM";
+    case OpCode::LT_INT: return "LT_INT";
+    case OpCode::LT_NUM: return "LT_NUM";
+    case OpCode::EQ_INT: return "EQ_INT";
+    case OpCode::EQ_NUM: return "EQ_NUM";
+    case OpCode::EQ_STR: return "EQ_STR";
+    case OpCode::ARRAY_GET_INT: return "ARRAY_GET_INT";
   default: return "UNKNOWN";
   }
 }
@@ -879,6 +911,7 @@ std::string BytecodeDisassembler::operandToString(const Value& operand) {
   if (operand.isSetId()) return "set[" + std::to_string(operand.asSetId()) + "]";
   if (operand.isHostFuncId()) return "hostfn[" + std::to_string(operand.asHostFuncId()) + "]";
   if (operand.isRangeId()) return "range[" + std::to_string(operand.asRangeId()) + "]";
+  if (operand.isBytesId()) return "bytes[" + std::to_string(operand.asBytesId()) + "]";
   if (operand.isEnumId()) return "enum[" + std::to_string(operand.asEnumId()) + "]";
     if (operand.isIteratorId()) return "iter[" + std::to_string(operand.asIteratorId()) + "]";
     if (operand.isBoundMethodId()) return "bm[" + std::to_string(operand.asBoundMethodId()) + "]";
@@ -888,7 +921,8 @@ std::string BytecodeDisassembler::operandToString(const Value& operand) {
 std::string BytecodeDisassembler::formatInstruction(
     uint32_t index,
     const Instruction& instr,
-    const Options& options) const {
+    const Options& options,
+    const BytecodeFunction* function) const {
     std::stringstream ss;
 
     if (options.showLineNumbers) {
@@ -896,6 +930,9 @@ std::string BytecodeDisassembler::formatInstruction(
     }
 
     ss << " " << std::left << std::setw(15) << opcodeToString(instr.opcode);
+    if (superinstructionLength(instr.opcode) > 1) {
+        ss << " [" << index << ".." << index + superinstructionLength(instr.opcode) - 1 << "]";
+    }
 
     for (size_t j = 0; j < instr.operands.size(); ++j) {
         const auto& operand = instr.operands[j];
@@ -920,8 +957,11 @@ std::string BytecodeDisassembler::formatInstruction(
         }
     }
 
-    if (options.showSourceLocations && instr.location) {
-        ss << " ; " << instr.location->line << ":" << instr.location->column;
+    if (options.showSourceLocations && function) {
+        const auto loc = function->line_table.lookup(index);
+        if (loc.line > 0) {
+            ss << " ; " << loc.line << ":" << loc.column;
+        }
     }
 
     return ss.str();
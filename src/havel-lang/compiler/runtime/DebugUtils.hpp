@@ -199,7 +199,8 @@ public:
   // Single instruction
   std::string disassembleInstruction(const Instruction& instr,
                                       uint32_t index,
-                                      const Options& options = Options{}) const;
+                                      const Options& options = Options{},
+                                      const BytecodeFunction* function = nullptr) const;
 
   // Constant pool
   std::string disassembleConstantPool() const;
@@ -208,10 +209,12 @@ public:
     static std::string opcodeToString(OpCode opcode);
     static std::string operandToString(const Value& operand);
 
-    // Single instruction formatting (used by VM trace)
+    // Single instruction formatting (used by VM trace). Source locations
+    // live in the owning function's line table, so pass it to show them.
     std::string formatInstruction(uint32_t index,
                                   const Instruction& instr,
-                                  const Options& options) const;
+                                  const Options& options,
+                                  const BytecodeFunction* function = nullptr) const;
 
 private:
     const BytecodeChunk& chunk_;
@@ -128,6 +128,8 @@ static std::string getTypeName(const Value &value) {
     return "enum";
   if (value.isRangeId())
     return "range";
+  if (value.isBytesId())
+    return "bytes";
   if (value.isThreadId())
     return "thread";
   if (value.isIntervalId())
@@ -412,6 +412,7 @@ bool RuntimeTypeSystem::equals(const Value& a, const Value& b) {
   if (a.isArrayId()) return a.asArrayId() == b.asArrayId();
   if (a.isObjectId()) return a.asObjectId() == b.asObjectId();
   if (a.isRangeId()) return a.asRangeId() == b.asRangeId();
+  if (a.isBytesId()) return a.asBytesId() == b.asBytesId();
   if (a.isIteratorId()) return a.asIteratorId() == b.asIteratorId();
 
   if (a.isEnumId()) return a.asEnumId() == b.asEnumId();
@@ -735,8 +736,9 @@ std::vector<uint8_t> ValueSerializer::serializeChunk(const BytecodeChunk& chunk,
     // Header: "HVC2" magic (version 3 adds per-function flags, version 4 adds variadic_param_index)
     append("HVC2", 4);
 
-    // Version (3 = per-function is_generator/is_timer_closure flags, 4 = variadic_param_index)
-    uint32_t version = 4;
+    // Version (3 = per-function is_generator/is_timer_closure flags, 4 = variadic_param_index,
+    // 5 = superinstruction opcodes after NOP)
+    uint32_t version = kChunkFormatVersion;
     append(&version, sizeof(version));
 
     // Flags (bit 0 = has compiler build ID)
@@ -879,7 +881,8 @@ std::vector<uint8_t> ValueSerializer::serializeChunk(const BytecodeChunk& chunk,
         uint32_t numInstr = static_cast<uint32_t>(func.instructions.size());
         append(&numInstr, sizeof(numInstr));
         for (const auto& instr : func.instructions) {
-            uint8_t opcode = static_cast<uint8_t>(instr.opcode);
+            // A function that already ran may hold quickened sites.
+            uint8_t opcode = static_cast<uint8_t>(unquickenedOpcode(instr.opcode));
             append(&opcode, sizeof(opcode));
             uint32_t numOps = static_cast<uint32_t>(instr.operands.size());
             append(&numOps, sizeof(numOps));
@@ -963,7 +966,7 @@ std::optional<BytecodeChunk> ValueSerializer::deserializeChunk(std::span<const u
     if (is_v2) {
         // HVC2: read version, flags, source path, source size, source hash
         if (!read(&hvc_version, sizeof(hvc_version))) return std::nullopt;
-        if (hvc_version < 2 || hvc_version > 4) return std::nullopt;
+        if (hvc_version != kChunkFormatVersion) return std::nullopt;
         ::havel::debug("[RTS-DEBUG] hvc_version = " + std::to_string(hvc_version));
 
     uint32_t flags = 0;
@@ -1194,7 +1197,7 @@ std::optional<BytecodeChunk> ValueSerializer::deserializeChunk(std::span<const u
             uint32_t numOps = 0;
             if (!read(&numOps, sizeof(numOps))) return std::nullopt;
 
-            std::vector<Value> operands;
+            OperandList operands;
             for (uint32_t o = 0; o < numOps; ++o) {
                 uint8_t opTag = 0;
                 if (!read(&opTag, sizeof(opTag))) return std::nullopt;
@@ -1283,6 +1286,17 @@ std::optional<BytecodeChunk> ValueSerializer::deserializeChunkMmap(const std::st
 }
 
 // Load bytecode chunk from file (mmap if large, read if small)
+bool ValueSerializer::hasCurrentChunkFormat(const std::string& filePath) {
+  std::ifstream file(filePath, std::ios::binary);
+  char magic[4] = {};
+  uint32_t version = 0;
+  if (!file.read(magic, sizeof(magic)) ||
+      !file.read(reinterpret_cast<char*>(&version), sizeof(version))) {
+    return false;
+  }
+  return std::memcmp(magic, "HVC2", 4) == 0 && version == kChunkFormatVersion;
+}
+
 std::optional<BytecodeChunk> ValueSerializer::loadChunk(const std::string& filePath, size_t mmapThreshold) {
   struct stat st;
   if (stat(filePath.c_str(), &st) != 0) {
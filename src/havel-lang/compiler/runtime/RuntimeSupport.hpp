@@ -352,6 +352,13 @@ public:
   std::optional<BytecodeChunk> deserializeChunkMmap(const std::string& filePath);
   std::optional<BytecodeChunk> loadChunk(const std::string& filePath, size_t mmapThreshold = 65536);
 
+  // .hvc version written by serializeChunk. Bump it whenever the image
+  // layout or opcode numbering changes: the reader rejects any other
+  // version, and the module loader recompiles such caches from source.
+  static constexpr uint32_t kChunkFormatVersion = 5;
+  // True when filePath starts with an HVC2 header of kChunkFormatVersion.
+  static bool hasCurrentChunkFormat(const std::string& filePath);
+
 private:
   std::string valueToJson(const Value& value);
   Value jsonToValue(const std::string& json);
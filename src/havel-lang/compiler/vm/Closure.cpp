@@ -46,7 +46,7 @@ Closure::Closure(uint32_t functionIndex, std::vector<Upvalue> upvalues)
 Closure Closure::create(
     uint32_t functionIndex,
     const std::vector<UpvalueDescriptor>& descriptors,
-    const std::vector<std::shared_ptr<GCHeap::UpvalueCell>>& parentUpvalues,
+    const std::vector<GCHeap::UpvalueCell *>& parentUpvalues,
     const std::vector<Value>& locals) {
 
   std::vector<Upvalue> upvalues;
@@ -144,14 +144,15 @@ Closure ClosureFactory::createWithUpvalues(
 
 UpvalueManager::UpvalueManager(GCHeap& heap) : heap_(heap) {}
 
-std::shared_ptr<GCHeap::UpvalueCell> UpvalueManager::openUpvalue(
+GCHeap::UpvalueCell *UpvalueManager::openUpvalue(
     uint32_t localIndex, const Value& value) {
   auto it = openUpvalues_.find(localIndex);
   if (it != openUpvalues_.end()) {
     return it->second;
   }
 
-  auto cell = heap_.createUpvalue(localIndex);
+  auto *cell = heap_.createUpvalue(localIndex);
+  heap_.retainUpvalue(cell);
   openUpvalues_[localIndex] = cell;
   return cell;
 }
@@ -171,6 +172,7 @@ void UpvalueManager::closeUpvalues(uint32_t localsBase, uint32_t localsEnd,
     if (it != openUpvalues_.end()) {
       Value value = (index < locals.size()) ? locals[index] : nullptr;
       it->second->close(value);
+      heap_.releaseUpvalue(it->second);
       openUpvalues_.erase(it);
     }
   }
@@ -180,11 +182,12 @@ void UpvalueManager::closeAllUpvalues(const std::vector<Value>& locals) {
   for (const auto& [index, cell] : openUpvalues_) {
     Value value = (index < locals.size()) ? locals[index] : nullptr;
     cell->close(value);
+    heap_.releaseUpvalue(cell);
   }
   openUpvalues_.clear();
 }
 
-std::shared_ptr<GCHeap::UpvalueCell> UpvalueManager::getOpenUpvalue(
+GCHeap::UpvalueCell *UpvalueManager::getOpenUpvalue(
     uint32_t localIndex) const {
   auto it = openUpvalues_.find(localIndex);
   if (it != openUpvalues_.end()) {
@@ -198,6 +201,9 @@ bool UpvalueManager::isUpvalueOpen(uint32_t localIndex) const {
 }
 
 void UpvalueManager::clear() {
+  for (const auto& [_, cell] : openUpvalues_) {
+    heap_.releaseUpvalue(cell);
+  }
   openUpvalues_.clear();
 }
 
@@ -30,8 +30,8 @@ public:
   bool isConst() const { return isConst_; }
 
   // GC cell management
-  void setGCTarget(std::shared_ptr<GCHeap::UpvalueCell> cell) { gcCell_ = cell; }
-  std::shared_ptr<GCHeap::UpvalueCell> getGCTarget() const { return gcCell_; }
+  void setGCTarget(GCHeap::UpvalueCell *cell) { gcCell_ = cell; }
+  GCHeap::UpvalueCell *getGCTarget() const { return gcCell_; }
   bool hasGCTarget() const { return gcCell_ != nullptr; }
 
   // Value access (delegates to GC cell if present)
@@ -46,7 +46,7 @@ private:
   uint32_t sourceIndex_;
   Type type_;
   bool isConst_;
-  std::shared_ptr<GCHeap::UpvalueCell> gcCell_;
+  GCHeap::UpvalueCell *gcCell_ = nullptr;
 };
 
 // ============================================================================
@@ -59,8 +59,7 @@ public:
   // Factory method for creating closures with runtime upvalue capture
   static Closure create(uint32_t functionIndex,
                         const std::vector<UpvalueDescriptor>& descriptors,
-                        const std::vector<std::shared_ptr<GCHeap::UpvalueCell>>&
-                            parentUpvalues,
+                        const std::vector<GCHeap::UpvalueCell *>& parentUpvalues,
                         const std::vector<Value>& locals);
 
   // Accessors
@@ -109,8 +108,7 @@ public:
   explicit UpvalueManager(GCHeap& heap);
 
   // Open a new upvalue or return existing one
-  std::shared_ptr<GCHeap::UpvalueCell> openUpvalue(uint32_t localIndex,
-                                                    const Value& value);
+  GCHeap::UpvalueCell *openUpvalue(uint32_t localIndex, const Value& value);
 
   // Close upvalues for a range of locals (when function returns)
   void closeUpvalues(uint32_t localsBase, uint32_t localsEnd,
@@ -120,7 +118,7 @@ public:
   void closeAllUpvalues(const std::vector<Value>& locals);
 
   // Get existing open upvalue if present
-  std::shared_ptr<GCHeap::UpvalueCell> getOpenUpvalue(uint32_t localIndex) const;
+  GCHeap::UpvalueCell *getOpenUpvalue(uint32_t localIndex) const;
 
   // Check if an upvalue is open
   bool isUpvalueOpen(uint32_t localIndex) const;
@@ -133,7 +131,7 @@ public:
 
 private:
   GCHeap& heap_;
-  std::unordered_map<uint32_t, std::shared_ptr<GCHeap::UpvalueCell>> openUpvalues_;
+  std::unordered_map<uint32_t, GCHeap::UpvalueCell *> openUpvalues_;
 };
 
 } // namespace havel::compiler
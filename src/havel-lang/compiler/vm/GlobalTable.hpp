@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../../core/Value.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace havel::compiler {
+
+using Value = havel::core::Value;
+
+// ============================================================================
+// GlobalTable - the VM's name -> Value globals map, with an epoch
+//
+// Nodes of an unordered_map never move, so a LOAD_GLOBAL/STORE_GLOBAL site
+// can cache a pointer to the Value slot of the name it resolved. The epoch
+// says whether such a pointer is still good: it changes whenever a slot may
+// have been freed (erase, clear, wholesale assignment when module code swaps
+// the active globals in and out) or a new name appears that could shadow a
+// host function the site resolved to. Overwriting an existing value keeps
+// the epoch, so steady-state stores don't invalidate anything.
+//
+// Epochs come from one process-wide counter, so an entry filled against one
+// table never validates against another. A move hands the nodes over intact,
+// so the epoch travels with them and the emptied source gets a fresh one:
+// module environments are swapped in and out of the VM by move, and sites
+// cached inside a module stay warm across calls into it.
+//
+// The map is inherited privately: every mutation goes through a member
+// here that keeps the epoch honest, and callers that need the plain map
+// (serialisation, snapshots) get it read-only through map().
+// ============================================================================
+class GlobalTable : private std::unordered_map<std::string, Value> {
+public:
+  using Map = std::unordered_map<std::string, Value>;
+  using Map::const_iterator;
+  using Map::iterator;
+  using Map::key_type;
+  using Map::mapped_type;
+  using Map::size_type;
+  using Map::value_type;
+
+  using Map::at;
+  using Map::begin;
+  using Map::cbegin;
+  using Map::cend;
+  using Map::contains;
+  using Map::count;
+  using Map::empty;
+  using Map::end;
+  using Map::find;
+  using Map::reserve;
+  using Map::size;
+
+  GlobalTable() = default;
+  GlobalTable(const GlobalTable &other) : Map(other) {}
+  GlobalTable(GlobalTable &&other) noexcept
+      : Map(std::move(other)), epoch_(other.epoch_) {
+    other.touch();
+  }
+  GlobalTable(const Map &other) : Map(other) {}
+  GlobalTable(Map &&other) noexcept : Map(std::move(other)) {}
+
+  GlobalTable &operator=(const GlobalTable &other) {
+    Map::operator=(other);
+    touch();
+    return *this;
+  }
+  GlobalTable &operator=(GlobalTable &&other) noexcept {
+    Map::operator=(std::move(other));
+    epoch_ = other.epoch_;
+    other.touch();
+    return *this;
+  }
+  GlobalTable &operator=(const Map &other) {
+    Map::operator=(other);
+    touch();
+    return *this;
+  }
+  GlobalTable &operator=(Map &&other) noexcept {
+    Map::operator=(std::move(other));
+    touch();
+    return *this;
+  }
+
+  Value &operator[](const std::string &key) {
+    auto [it, inserted] = Map::try_emplace(key);
+    if (inserted) touch();
+    return it->second;
+  }
+  Value &operator[](std::string &&key) {
+    auto [it, inserted] = Map::try_emplace(std::move(key));
+    if (inserted) touch();
+    return it->second;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    auto result = Map::emplace(std::forward<Args>(args)...);
+    if (result.second) touch();
+    return result;
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const std::string &key, Args &&...args) {
+    auto result = Map::try_emplace(key, std::forward<Args>(args)...);
+    if (result.second) touch();
+    return result;
+  }
+  std::pair<iterator, bool> insert(const value_type &entry) {
+    auto result = Map::insert(entry);
+    if (result.second) touch();
+    return result;
+  }
+  template <typename InputIt> void insert(InputIt first, InputIt last) {
+    Map::insert(first, last);
+    touch();
+  }
+  std::pair<iterator, bool> insert_or_assign(const std::string &key,
+                                             const Value &value) {
+    auto result = Map::insert_or_assign(key, value);
+    if (result.second) touch();
+    return result;
+  }
+
+  size_type erase(const std::string &key) {
+    touch();
+    return Map::erase(key);
+  }
+  iterator erase(iterator pos) {
+    touch();
+    return Map::erase(pos);
+  }
+  iterator erase(const_iterator pos) {
+    touch();
+    return Map::erase(pos);
+  }
+  void clear() noexcept {
+    touch();
+    Map::clear();
+  }
+  void swap(Map &other) noexcept {
+    touch();
+    Map::swap(other);
+  }
+
+  const Map &map() const { return *this; }
+  uint64_t epoch() const { return epoch_; }
+
+private:
+  static uint64_t nextEpoch() {
+    static std::atomic<uint64_t> counter{1};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+  }
+  void touch() { epoch_ = nextEpoch(); }
+
+  uint64_t epoch_ = nextEpoch();
+};
+
+// Module environments are shared by every closure defined in the module and
+// by the module loader's cache; the VM moves the contents in while the
+// module runs and back out when it leaves (see VM::enterModuleEnv). While
+// an env is active its table is an empty husk, so read it through
+// VM::moduleEnvContents rather than dereferencing it.
+using ModuleGlobals = std::shared_ptr<GlobalTable>;
+
+} // namespace havel::compiler
@@ -4,11 +4,6 @@
 #include "host/ServiceRegistry.hpp"
 #include <iostream>
 
-#if defined(__GNUC__) || defined(__clang__)
-#define HAVE_COMPUTED_GOTO 1
-#else
-#define HAVE_COMPUTED_GOTO 0
-#endif
 #include "../../../utils/Logger.hpp"
 #include "../../parser/BootstrapParser.h"
 #include "../../runtime/Modules.hpp"
@@ -30,11 +25,13 @@
 
 #include "../../stdlib/LogModule.hpp"
 #include "havel-lang/compiler/runtime/DebugUtils.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iomanip>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -59,7 +56,7 @@ static const std::unordered_set<std::string> &runtimeGlobalsSkipList() {
       // Reconstructed per process, so a stale GLBS copy must not clobber them.
       "string",     "String",     "array",     "Array",  "bit",     "ptr",
       "object",     "Object",     "physics",   "Physics", "Type",    "process",
-      "wayland",    "bytecodeBuilder",
+      "wayland",    "bytecodeBuilder", "Bytes",
   };
   return names;
 }
@@ -88,11 +85,17 @@ VM::VM(const VMConfig &cfg) {
       cfg.tier2_flush_on_shutdown || envU64("HAVEL_TIER2_FLUSH", 0) != 0;
   max_call_depth_ = cfg.max_call_depth;
   max_instructions_ = cfg.max_instructions;
+  opcode_pair_report_ = envU64("HAVEL_OPCODE_PAIRS", 0);
+  profiling_enabled_ = opcode_pair_report_ != 0;
+  quickening_enabled_ = cfg.quickening && envU64("HAVEL_QUICKEN", 1) != 0;
+  stack.reserve(cfg.stack_reserve);
+  locals.reserve(cfg.stack_reserve);
   heap_.setAllocationBudget(cfg.gc_budget);
   heap_.setHeapMaxBytes(cfg.heap_max_bytes);
   heap_.setStopTheWorldMode(cfg.gc_stop_the_world);
   heap_.setFullCollectionInterval(cfg.gc_full_collection_interval);
   heap_.setPromotionAgeThreshold(cfg.gc_promotion_age);
+  heap_.setMarkThreads(cfg.gc_mark_threads);
   timer_check_interval_ = cfg.timer_check_interval;
   if (!cfg.self_hosted_modules_path.empty()) {
     self_hosted_modules_path_ = cfg.self_hosted_modules_path;
@@ -132,11 +135,17 @@ VM::VM(const ::havel::HostContext &ctx, const VMConfig &cfg) {
   context_ = &ctx;
   max_call_depth_ = cfg.max_call_depth;
   max_instructions_ = cfg.max_instructions;
+  opcode_pair_report_ = envU64("HAVEL_OPCODE_PAIRS", 0);
+  profiling_enabled_ = opcode_pair_report_ != 0;
+  quickening_enabled_ = cfg.quickening && envU64("HAVEL_QUICKEN", 1) != 0;
+  stack.reserve(cfg.stack_reserve);
+  locals.reserve(cfg.stack_reserve);
   heap_.setAllocationBudget(cfg.gc_budget);
   heap_.setHeapMaxBytes(cfg.heap_max_bytes);
   heap_.setStopTheWorldMode(cfg.gc_stop_the_world);
   heap_.setFullCollectionInterval(cfg.gc_full_collection_interval);
   heap_.setPromotionAgeThreshold(cfg.gc_promotion_age);
+  heap_.setMarkThreads(cfg.gc_mark_threads);
   timer_check_interval_ = cfg.timer_check_interval;
   if (!cfg.self_hosted_modules_path.empty()) {
     self_hosted_modules_path_ = cfg.self_hosted_modules_path;
@@ -153,6 +162,114 @@ VM::VM(const ::havel::HostContext &ctx, const VMConfig &cfg) {
 
 void VM::setMaxCallDepth(size_t value) { max_call_depth_ = value; }
 
+void VM::recordOpcodeProfile(const BytecodeFunction *function, uint32_t ip,
+                             OpCode opcode) {
+  const OpCode op = unfusedOpcode(opcode);
+  const auto index = static_cast<uint8_t>(op);
+  opcode_counts_[index]++;
+  executed_instructions_++;
+  fused_dispatches_saved_ += superinstructionLength(opcode) - 1;
+  // Only straight-line successors can be fused, so taken jumps, calls and
+  // returns don't count as pairs.
+  if (function == profile_prev_function_ && ip == profile_prev_ip_ + 1 &&
+      ip > 0) {
+    const auto prev =
+        static_cast<uint8_t>(unfusedOpcode(function->instructions[ip - 1].opcode));
+    opcode_pair_counts_[static_cast<uint16_t>(prev << 8 | index)]++;
+  }
+  profile_prev_function_ = function;
+  profile_prev_ip_ = ip;
+}
+
+uint64_t VM::opcodePairCount(OpCode first, OpCode second) const {
+  auto it = opcode_pair_counts_.find(static_cast<uint16_t>(
+      static_cast<uint8_t>(first) << 8 | static_cast<uint8_t>(second)));
+  return it == opcode_pair_counts_.end() ? 0 : it->second;
+}
+
+std::string VM::opcodePairReport(size_t limit) const {
+  std::vector<std::pair<uint16_t, uint64_t>> pairs(opcode_pair_counts_.begin(),
+                                                   opcode_pair_counts_.end());
+  std::sort(pairs.begin(), pairs.end(), [](const auto &a, const auto &b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  });
+  std::ostringstream out;
+  out << "opcode pairs (" << executed_instructions_
+      << " instructions profiled, " << fused_dispatches_saved_
+      << " covered by superinstructions):\n";
+  for (size_t i = 0; i < pairs.size() && i < limit; ++i) {
+    const auto [key, count] = pairs[i];
+    const double share =
+        executed_instructions_ ? 100.0 * count / executed_instructions_ : 0.0;
+    out << "  " << std::setw(12) << count << "  " << std::fixed
+        << std::setprecision(1) << std::setw(5) << share << "%  "
+        << BytecodeDisassembler::opcodeToString(static_cast<OpCode>(key >> 8))
+        << " -> "
+        << BytecodeDisassembler::opcodeToString(static_cast<OpCode>(key & 0xff))
+        << "\n";
+  }
+  return out.str();
+}
+
+// Every OBJECT_GET/OBJECT_SET/CALL_METHOD site that has run, with its cache
+// state, across all chunks the VM holds.
+std::vector<VM::InlineCacheSiteStats> VM::inlineCacheStats() const {
+  std::vector<InlineCacheSiteStats> sites;
+  std::unordered_set<const BytecodeChunk *> seen;
+  auto collect = [&](const BytecodeChunk *chunk) {
+    if (!chunk || !seen.insert(chunk).second) {
+      return;
+    }
+    for (size_t f = 0; f < chunk->getFunctionCount(); ++f) {
+      const BytecodeFunction *function = chunk->getFunction(static_cast<uint32_t>(f));
+      if (!function || function->property_cache.empty()) {
+        continue;
+      }
+      for (uint32_t ip = 0; ip < function->instructions.size(); ++ip) {
+        const Instruction &instruction = function->instructions[ip];
+        size_t operand = 0;
+        if (instruction.opcode == OpCode::CALL_METHOD) {
+          operand = 2;
+        } else if (instruction.opcode != OpCode::OBJECT_GET &&
+                   instruction.opcode != OpCode::OBJECT_SET) {
+          continue;
+        }
+        if (instruction.operands.size() <= operand ||
+            !instruction.operands[operand].isInt()) {
+          continue;
+        }
+        const auto slot = static_cast<size_t>(instruction.operands[operand].asInt());
+        if (slot >= function->property_cache.size()) {
+          continue;
+        }
+        const PropertyInlineCache &ic = function->property_cache[slot];
+        if (ic.hits == 0 && ic.misses == 0) {
+          continue;
+        }
+        sites.push_back(InlineCacheSiteStats{.function = function->name,
+                                             .ip = ip,
+                                             .opcode = instruction.opcode,
+                                             .state = ic.state,
+                                             .ways = ic.count,
+                                             .hits = ic.hits,
+                                             .misses = ic.misses});
+      }
+    }
+  };
+  collect(main_chunk_.get());
+  collect(current_chunk);
+  for (const auto &chunk : persistent_chunks_) {
+    collect(chunk.get());
+  }
+  for (const auto &[_, chunk] : module_chunks_) {
+    collect(chunk.get());
+  }
+  for (const auto &chunk : repl_chunks_) {
+    collect(chunk.get());
+  }
+  return sites;
+}
+
 std::shared_ptr<BytecodeChunk>
 VM::findOwningChunk(const BytecodeChunk *raw) const {
   if (!raw)
@@ -239,6 +356,9 @@ VM::~VM() {
                   tier2_compile_count_.load(),
                   tier2_skip_duplicate_count_.load());
   }
+  if (opcode_pair_report_ > 0) {
+    std::cerr << opcodePairReport(opcode_pair_report_);
+  }
   for (auto &[name, rootId] : host_function_gc_roots_) {
     unpinExternalRoot(rootId);
   }
@@ -270,6 +390,11 @@ VM::~VM() {
   direct_call_thunks_.clear();
   coroutine_to_frame_.clear();
   globals_stack_.clear();
+  active_env_.reset();
+  env_stack_.clear();
+  fiber_env_base_ = 0;
+  fiber_envs_live_ = false;
+  throw_floor_ = 0;
   thread_results_.clear();
   timeout_results_.clear();
   interval_results_.clear();
@@ -365,7 +490,6 @@ Value VM::callFunctionSync(const Value &fn, const std::vector<Value> &args) {
   auto saved_frame_arena = frame_arena_;
   size_t saved_frame_count = frame_count_;
   const BytecodeChunk *saved_chunk = current_chunk;
-  auto saved_open_upvalues = open_upvalues;
   bool saved_exception = has_current_exception_;
   Value saved_exception_val = current_exception_;
   size_t saved_gc_suspend = gc_suspend_counter_;
@@ -386,13 +510,14 @@ Value VM::callFunctionSync(const Value &fn, const std::vector<Value> &args) {
     stack.pop();
   }
 
-  // Restore all VM state
+  // Restore all VM state. Cells the call left open belong to its frames,
+  // so close them over the locals they point into before those go.
+  closeFrameUpvalues(static_cast<uint32_t>(saved_locals.size()), UINT32_MAX);
   stack = std::move(saved_stack);
   locals = std::move(saved_locals);
   immutable_locals_.clear();
   frame_count_ = saved_frame_count;
   current_chunk = outer_chunk;
-  open_upvalues = std::move(saved_open_upvalues);
   has_current_exception_ = saved_exception;
   current_exception_ = saved_exception_val;
   gc_suspend_counter_ = saved_gc_suspend;
@@ -400,6 +525,163 @@ Value VM::callFunctionSync(const Value &fn, const std::vector<Value> &args) {
   return result;
 }
 
+VM::PreparedCall VM::prepareCall(const Value &fn) {
+  PreparedCall call;
+  if (fn.isHostFuncId()) {
+    call.fn = fn;
+    return call;
+  }
+  if (!fn.isFunctionObjId() && !fn.isClosureId()) {
+    return call;
+  }
+
+  const BytecodeChunk *chunk =
+      current_chunk ? current_chunk : main_chunk_.get();
+  uint32_t function_index = 0;
+  if (fn.isFunctionObjId()) {
+    // Allocate the closure doCall would create on every call just once.
+    function_index = fn.asFunctionObjId();
+    call.closure_id = closureForFunctionObj(function_index, chunk);
+    if (call.closure_id == 0) {
+      COMPILER_THROW("Function index not found: " +
+                     std::to_string(function_index));
+    }
+    call.root = GCRoot(*this, Value::makeClosureId(call.closure_id));
+  } else {
+    call.closure_id = fn.asClosureId();
+    auto *closure = heap_.closure(call.closure_id);
+    if (!closure) {
+      COMPILER_THROW("Closure not found for call (id=" +
+                     std::to_string(call.closure_id) + ")");
+    }
+    function_index = closure->function_index;
+    if (closure->chunk) {
+      chunk = closure->chunk;
+    }
+    call.globals = closure->module_globals;
+    call.root = GCRoot(*this, fn);
+  }
+  if (!chunk || !chunk->getFunction(function_index)) {
+    COMPILER_THROW("Function index not found: " +
+                   std::to_string(function_index));
+  }
+
+  call.fn = fn;
+  call.chunk = chunk;
+  call.function = chunk->getFunction(function_index);
+  call.direct = !call.function->is_generator &&
+                call.function->variadic_param_index == UINT32_MAX &&
+                !debugger_attached_;
+  return call;
+}
+
+// The per-element path of the array intrinsics: the frame setup doCall
+// performs for a plain bytecode callee, without re-resolving the callee,
+// building an argument vector or snapshotting VM state.
+Value VM::callPrepared(const PreparedCall &call, HostArgs args) {
+  const BytecodeFunction *callee = call.function;
+  if (!call.direct || callee->jit_compiled) {
+    return callFunctionSync(call.fn,
+                            std::vector<Value>(args.begin(), args.end()));
+  }
+  if (frame_count_ >= max_call_depth_) {
+    COMPILER_THROW("Stack overflow: maximum call depth " +
+                   std::to_string(max_call_depth_) + " reached");
+  }
+
+  callee->execution_count++;
+  if (callee->execution_count == 1000 && hot_func_cb_ && !debugger_attached_) {
+    hot_func_cb_(*callee);
+  }
+
+  tail_call_depth_ = 0;
+  pending_call_return_ip_ = -1;
+  const size_t base_depth = frame_count_;
+  const size_t base_locals = locals.size();
+  const size_t stack_depth = stack.size();
+  const BytecodeChunk *saved_chunk = current_chunk;
+  const bool saved_exception = has_current_exception_;
+  const Value saved_exception_val = current_exception_;
+  const size_t saved_gc_suspend = gc_suspend_counter_;
+  const size_t saved_throw_floor = throw_floor_;
+
+  current_chunk = call.chunk;
+  bool frame_owns_globals = false;
+  if (call.globals && call.globals != active_env_) {
+    enterModuleEnv(call.globals);
+    frame_owns_globals = true;
+  }
+
+  locals.resize(base_locals + std::max(callee->local_count, callee->param_count),
+                nullptr);
+  {
+    CallFrame cf;
+    cf.function = callee;
+    cf.chunk = call.chunk;
+    cf.ip = 0;
+    cf.locals_base = base_locals;
+    cf.closure_id = call.closure_id;
+    cf.owns_globals = frame_owns_globals;
+    cf.stack_depth = static_cast<uint32_t>(stack_depth);
+    frame_arena_.place(frame_count_, std::move(cf));
+  }
+  frame_count_++;
+  immutable_locals_.clear();
+
+  for (uint32_t i = 0; i < callee->param_count; i++) {
+    Value &slot = locals[base_locals + i];
+    if (i < args.size()) {
+      slot = args[i];
+    } else if (i < callee->default_values.size() &&
+               callee->default_values[i].has_value()) {
+      const auto &dv = callee->default_values[i].value();
+      // Sentinel: bool(true) means "fresh empty array" for arr=[] defaults
+      slot = dv.isBool() && dv.asBool()
+                 ? Value::makeArrayId(heap_.allocateArray().id)
+                 : dv;
+    }
+  }
+
+  throw_floor_ = base_depth;
+  try {
+    runDispatchLoop(base_depth);
+  } catch (...) {
+    // Unwind what the callee's frames left behind, innermost first: module
+    // envs they entered, then cells still open over their locals.
+    for (size_t i = frame_count_; i-- > base_depth;) {
+      if (frame_arena_[i].owns_globals) {
+        leaveModuleEnv();
+      }
+    }
+    frame_count_ = base_depth;
+    closeFrameUpvalues(static_cast<uint32_t>(base_locals), UINT32_MAX);
+    if (locals.size() > base_locals) {
+      locals.resize(base_locals);
+    }
+    if (stack.size() > stack_depth) {
+      stack.truncate(stack_depth);
+    }
+    current_chunk = saved_chunk;
+    has_current_exception_ = saved_exception;
+    current_exception_ = saved_exception_val;
+    gc_suspend_counter_ = saved_gc_suspend;
+    throw_floor_ = saved_throw_floor;
+    throw;
+  }
+
+  Value result;
+  if (stack.size() > stack_depth) {
+    result = stack.top();
+    stack.truncate(stack_depth);
+  }
+  current_chunk = saved_chunk;
+  has_current_exception_ = saved_exception;
+  current_exception_ = saved_exception_val;
+  gc_suspend_counter_ = saved_gc_suspend;
+  throw_floor_ = saved_throw_floor;
+  return result;
+}
+
 Value VM::execute(const BytecodeChunk &chunk, const std::string &function_name,
                   const std::vector<Value> &args) {
   const BytecodeChunk *saved_chunk = current_chunk;
@@ -410,16 +692,15 @@ Value VM::execute(const BytecodeChunk &chunk, const std::string &function_name,
     COMPILER_THROW("Function not found: " + function_name);
   }
 
-  while (!stack.empty()) {
-    stack.pop();
-  }
+  stack.clear();
   locals.clear();
   frame_count_ = 0;
+  throw_floor_ = 0;
 
   if (gc_suspend_counter_ == 0)
     collectGarbage();
 
-  open_upvalues.clear();
+  discardOpenUpvalues();
   has_current_exception_ = false;
   current_exception_ = nullptr;
   registerDefaultHostGlobals();
@@ -434,12 +715,7 @@ Value VM::execute(const BytecodeChunk &chunk, const std::string &function_name,
   opcode_counts_.fill(0);
   executed_instructions_ = 0;
 
-  if (frame_arena_.size() <= frame_count_) {
-    frame_arena_.push_back(CallFrame{entry, &chunk, 0, 0, 0, false, {}, {}, 0, {}});
-  } else {
-    frame_arena_[frame_count_] =
-        CallFrame{entry, &chunk, 0, 0, 0, false, {}, {}, 0, {}};
-  }
+  frame_arena_.place(frame_count_, CallFrame{entry, &chunk, 0, 0, 0, false});
   frame_count_++;
   locals.resize(entry->local_count);
 
@@ -670,9 +946,7 @@ Value VM::executePersistent(const BytecodeChunk &chunk,
   // The caller (bc.execute_persistent host function) saves/restores
   // locals, stack, and frames. We only clear them here for the
   // persistent execution context.
-  while (!stack.empty()) {
-    stack.pop();
-  }
+  stack.clear();
   locals.clear();
   frame_count_ = 0;
   // DON'T reset heap - preserves user globals
@@ -681,16 +955,11 @@ Value VM::executePersistent(const BytecodeChunk &chunk,
     host_globals_registered_ = true;
   }
   registerDefaultPrototypes();
-  open_upvalues.clear();
+  discardOpenUpvalues();
   has_current_exception_ = false;
   current_exception_ = nullptr;
 
-  if (frame_arena_.size() <= frame_count_) {
-    frame_arena_.push_back(CallFrame{entry, &chunk, 0, 0, 0, false, {}, {}, 0, {}});
-  } else {
-    frame_arena_[frame_count_] =
-        CallFrame{entry, &chunk, 0, 0, 0, false, {}, {}, 0, {}};
-  }
+  frame_arena_.place(frame_count_, CallFrame{entry, &chunk, 0, 0, 0, false});
   frame_count_++;
   locals.resize(entry->local_count);
 
@@ -816,7 +1085,7 @@ bool VM::evaluateConditionBytecode(uint32_t func_index, uint32_t ip) {
   }
 
   // Save current stack state (conditions shouldn't consume/modify main stack)
-  std::stack<Value> saved_stack = stack;
+  ValueStack saved_stack = stack;
   size_t saved_frame_count = frame_count_;
   auto saved_locals = locals;
   auto saved_frame_arena = frame_arena_;
@@ -853,7 +1122,7 @@ Value VM::evaluateExpressionBytecode(uint32_t func_index, size_t ip) {
     return Value::makeNull();
   }
 
-  std::stack<Value> saved_stack = stack;
+  ValueStack saved_stack = stack;
   size_t saved_frame_count = frame_count_;
   auto saved_locals = locals;
   auto saved_frame_arena = frame_arena_;
@@ -979,8 +1248,7 @@ VMExecutionResult VM::executeOneStep(Fiber *current_fiber) {
 
     // Track for profiling
     if (profiling_enabled_) {
-      opcode_counts_[static_cast<uint8_t>(instruction.opcode)]++;
-      executed_instructions_++;
+      recordOpcodeProfile(function, ip, instruction.opcode);
     }
 
     // Execute the instruction
@@ -1056,7 +1324,7 @@ VMExecutionResult VM::executeOneStep(Fiber *current_fiber) {
       if (frame_count_ > 0) {
         auto &frame = frame_arena_[frame_count_ - 1];
         if (frame.function &&
-            frame.ip < frame.function->instruction_locations.size()) {
+            frame.ip < frame.function->line_table.size()) {
           const auto loc = nearestSourceLocation(*frame.function, frame.ip);
           line = loc.line;
           column = loc.column;
@@ -1083,7 +1351,7 @@ VMExecutionResult VM::executeOneStep(Fiber *current_fiber) {
     if (frame_count_ > 0) {
       auto &frame = frame_arena_[frame_count_ - 1];
       if (frame.function &&
-          frame.ip < frame.function->instruction_locations.size()) {
+          frame.ip < frame.function->line_table.size()) {
         const auto loc = nearestSourceLocation(*frame.function, frame.ip);
         if (loc.line > 0) {
           if (!loc.filename.empty()) {
@@ -1125,60 +1393,24 @@ void VM::loadFiberState(Fiber *fiber) {
 
   // STEP 1: Clear VM's current execution state
   // These will be repopulated from the fiber
-  while (!stack.empty()) {
-    stack.pop();
-  }
+  stack.clear();
   locals.clear();
   immutable_locals_.clear();
   frame_count_ = 0;
 
   // STEP 2: Restore operand stack from fiber's stack
-  // FiberStack uses a data vector and size_t sp (stack pointer)
-  // We need to copy all pushed values onto the VM's stack
-  const auto &fiber_stack_data = fiber->stack.data();
-  const size_t fiber_sp = fiber->stack.size();
-  for (size_t i = 0; i < fiber_sp; ++i) {
-    stack.push(fiber_stack_data[i]);
-  }
-
-  // STEP 3: Restore locals from fiber's map into VM's vector
-  // VM locals is a vector indexed by absolute position
-  // We iterate fiber's map and restore to the correct index
-  if (!fiber->locals.empty()) {
-    // Find the maximum local index to know how big to make locals vector
-    size_t max_local = 0;
-    for (const auto &[name, value] : fiber->locals) {
-      // Extract numeric index from "_local_N" key
-      if (name.find("_local_") == 0) {
-        size_t idx = std::stoull(name.substr(7));
-        if (idx > max_local)
-          max_local = idx;
-      }
-    }
-
-    // Resize locals to hold all saved locals in correct positions
-    locals.resize(max_local + 1, Value::makeNull());
-
-    // Restore each local to its original position
-    for (const auto &[name, value] : fiber->locals) {
-      if (name.find("_local_") == 0) {
-        size_t idx = std::stoull(name.substr(7));
-        if (idx < locals.size()) {
-          locals[idx] = value;
-        }
-      }
-    }
-  }
+  // FiberStack uses a data vector and size_t sp (stack pointer); the live
+  // values are its first size() slots, bottom-first like ours
+  const Value *fiber_stack_data = fiber->stack.data().data();
+  stack.assign(fiber_stack_data, fiber_stack_data + fiber->stack.size());
+
+  // STEP 3: Restore locals; the fiber keeps them by absolute slot, like ours
+  locals.assign(fiber->locals.begin(), fiber->locals.end());
 
   // STEP 4: Restore call stack from fiber's call_stack
   // Copy each CallFrame from Fiber to VM's frame arena
   for (const auto &fiber_frame : fiber->call_stack) {
-    // Allocate a CallFrame in VM's frame arena
-    if (frame_arena_.size() <= frame_count_) {
-      frame_arena_.push_back(CallFrame());
-    }
-
-    auto &vm_frame = frame_arena_[frame_count_];
+    auto &vm_frame = frame_arena_.place(frame_count_, CallFrame{});
 
     // Resolve function pointer from function_id using the saved chunk
     const BytecodeChunk *resolve_chunk = fiber_frame.chunk_ptr;
@@ -1211,15 +1443,16 @@ void VM::loadFiberState(Fiber *fiber) {
     vm_frame.owns_globals = fiber_frame.owns_globals;
 
     // Convert try_stack: both have same structure but different types
-    vm_frame.try_stack.clear();
     for (const auto &handler : fiber_frame.try_stack) {
-      vm_frame.try_stack.push_back(
+      frame_arena_.pushTry(
+          frame_count_,
           VM::TryHandler{handler.catch_ip, handler.finally_ip,
                          handler.finally_return_ip, handler.stack_depth});
     }
 
     frame_count_++;
   }
+  throw_floor_ = fiber->throw_floor;
 
   // STEP 5: Restore current_chunk from the topmost frame's chunk
   // This is critical for LOAD_GLOBAL and other chunk-dependent operations
@@ -1268,7 +1501,7 @@ void VM::loadFiberState(Fiber *fiber) {
   } else {
     auto snapIt = spawn_globals_snapshot_.find(top_closure_id);
     if (snapIt != spawn_globals_snapshot_.end() && !snapIt->second->empty()) {
-      consider_source(*snapIt->second);
+      consider_source(snapIt->second->map());
     }
   }
 
@@ -1280,6 +1513,15 @@ void VM::loadFiberState(Fiber *fiber) {
       globals.emplace(std::move(k), std::move(v));
     }
   }
+
+  // STEP 7: Re-enter the module envs saveFiberState left, in call order, so
+  // the frames that own them find them active and leave them on return.
+  // This comes after the merge above, which targets the ambient globals.
+  fiber_env_base_ = env_stack_.size();
+  fiber_envs_live_ = true;
+  for (const auto &env : fiber->module_envs) {
+    enterModuleEnv(env);
+  }
 }
 
 /**
@@ -1297,26 +1539,11 @@ void VM::saveFiberState(Fiber *fiber) {
   // STEP 1: Save operand stack from VM back to fiber's stack
   fiber->stack.clear();
 
-  // Convert VM's std::stack<Value> to fiber's FiberStack
-  // std::stack is LIFO, so we need to extract in reverse order
-  std::vector<Value> temp_values;
-  auto temp_stack = stack; // Copy the stack
-  while (!temp_stack.empty()) {
-    temp_values.push_back(temp_stack.top());
-    temp_stack.pop();
-  }
-  // Now push in correct order (reverse of extraction)
-  for (auto it = temp_values.rbegin(); it != temp_values.rend(); ++it) {
-    fiber->stack.push(*it);
-  }
+  // Both stacks are contiguous and bottom-first: one bulk copy
+  fiber->stack.assign(stack.begin(), stack.end());
 
-  // STEP 2: Save locals from VM's vector back to fiber's map
-  fiber->locals.clear();
-  for (size_t i = 0; i < locals.size(); ++i) {
-
-    std::string key = "_local_" + std::to_string(i);
-    fiber->locals[key] = locals[i];
-  }
+  // STEP 2: Save locals by absolute slot; assign reuses the fiber's buffer
+  fiber->locals.assign(locals.begin(), locals.end());
 
   // STEP 3: Save call stack from VM back to fiber's call_stack
   fiber->call_stack.clear();
@@ -1350,7 +1577,8 @@ void VM::saveFiberState(Fiber *fiber) {
 
     // Convert try_stack: both have same structure but different types
     fiber_cf.try_stack.clear();
-    for (const auto &vm_handler : vm_frame.try_stack) {
+    for (uint32_t t = 0; t < vm_frame.try_count; ++t) {
+      const auto &vm_handler = frame_arena_.tries[vm_frame.try_base + t];
       fiber_cf.try_stack.push_back(
           TryHandlerType{vm_handler.catch_ip, vm_handler.finally_ip,
                          vm_handler.finally_return_ip, vm_handler.stack_depth});
@@ -1359,23 +1587,42 @@ void VM::saveFiberState(Fiber *fiber) {
     fiber->call_stack.push_back(fiber_cf);
   }
 
-  // STEP 4: Save current instruction pointer
+  // STEP 4: Save current instruction pointer and the throw floor, which
+  // indexes this fiber's frames
   if (frame_count_ > 0) {
     fiber->ip = frame_arena_[frame_count_ - 1].ip;
   }
+  fiber->throw_floor = throw_floor_;
+
+  // STEP 5: Leave the module envs this fiber's frames entered, so the next
+  // fiber runs against the env the scheduler is in rather than this one's
+  // module globals. Envs entered above fiber_env_base_ are env_stack_'s tail
+  // past that point plus the active env. A second save of a fiber that has
+  // not run since keeps the envs it recorded the first time.
+  if (fiber_envs_live_) {
+    fiber->module_envs.clear();
+    for (size_t i = fiber_env_base_ + 1; i < env_stack_.size(); ++i) {
+      fiber->module_envs.push_back(env_stack_[i]);
+    }
+    if (env_stack_.size() > fiber_env_base_) {
+      fiber->module_envs.push_back(active_env_);
+    }
+    while (env_stack_.size() > fiber_env_base_) {
+      leaveModuleEnv();
+    }
+    fiber_envs_live_ = false;
+  }
 
-  // STEP 5: Refresh the per-fiber fresh-globals fallback. loadFiberState
+  // STEP 6: Refresh the per-fiber fresh-globals fallback. loadFiberState
   // uses this (in preference to the stale spawn-time snapshot) when
   // ambient globals is a churned sidecar missing script keys — merging
   // the LAST saved values keeps the goroutine's live progress (e.g.
   // tick_in=5 survives a GC-churned ambient that lost it) without
   // breaking shared-write semantics (ambient stays the primary map).
-  fiber->saved_globals = globals;
-  fiber->saved_globals_stack = globals_stack_;
-  fiber->saved_globals_mirror_id = globals_mirror_object_id_;
+  fiber->saved_globals = globals.map();
   fiber->has_saved_globals = true;
 
-  // STEP 6: Update fiber state if needed
+  // STEP 7: Update fiber state if needed
   // Don't change the suspended_reason - that was set when suspension occurred
   // Just ensure the fiber's state reflects current execution point
 }
@@ -1383,11 +1630,13 @@ void VM::saveFiberState(Fiber *fiber) {
 VM::GoroutineCallResult VM::startGoroutineCall(const Value &callable,
                                                const std::vector<Value> &args) {
   // Clear VM state for fresh goroutine context
-  while (!stack.empty())
-    stack.pop();
+  stack.clear();
   locals.clear();
   immutable_locals_.clear();
   frame_count_ = 0;
+  throw_floor_ = 0;
+  fiber_env_base_ = env_stack_.size();
+  fiber_envs_live_ = true;
 
   // Resolve the callable's identity + chunk in ONE place.
   // The Value is the single source of truth — no caller-side chunk pinning
@@ -1587,11 +1836,7 @@ VM::GoroutineCallResult VM::startGoroutineCall(const Value &callable,
   cf.closure_id = closure_id;
   cf.stack_depth = static_cast<uint32_t>(stack_depth);
 
-  if (frame_arena_.size() <= frame_count_) {
-    frame_arena_.push_back(std::move(cf));
-  } else {
-    frame_arena_[frame_count_] = std::move(cf);
-  }
+  frame_arena_.place(frame_count_, std::move(cf));
   frame_count_++;
 
   return GoroutineCallResult::Interpreter;
@@ -1627,13 +1872,11 @@ VM::startGoroutineCall(uint32_t function_id, uint32_t closure_id,
 
 bool VM::executeDirectCallThunk(const DirectCallThunk &thunk) {
   for (const auto &call : thunk.calls) {
-    if (call.host_func_idx >= host_function_names_.size())
+    const HostFunctionEntry *entry = hostEntry(call.host_func_idx);
+    if (!entry || (entry->arity >= 0 &&
+                   call.args.size() != static_cast<size_t>(entry->arity)))
       return false;
-    const std::string &name = host_function_names_[call.host_func_idx];
-    auto it = host_functions.find(name);
-    if (it == host_functions.end())
-      return false;
-    it->second(call.args);
+    entry->call(call.args);
   }
   return true;
 }
@@ -1670,8 +1913,8 @@ VM::CallerInfo VM::getCallerInfo(int depth) const {
   if (frame.function) {
     info.function = frame.function->name;
     uint32_t ip = frame.ip;
-    if (ip < frame.function->instruction_locations.size()) {
-      const auto &loc = frame.function->instruction_locations[ip];
+    if (ip < frame.function->line_table.size()) {
+      const auto loc = frame.function->line_table.lookup(ip);
       info.line = loc.line;
       info.column = loc.column;
     }
@@ -1835,7 +2078,7 @@ void VM::runDispatchLoop(size_t stop_frame_depth) {
           if (frame_count_ > 0) {
             auto &frame = frame_arena_[frame_count_ - 1];
             if (frame.function &&
-                frame.ip < frame.function->instruction_locations.size()) {
+                frame.ip < frame.function->line_table.size()) {
               const auto loc = nearestSourceLocation(*frame.function, frame.ip);
               line = loc.line;
               column = loc.column;
@@ -1856,7 +2099,7 @@ void VM::runDispatchLoop(size_t stop_frame_depth) {
         if (frame_count_ > 0) {
           auto &frame = frame_arena_[frame_count_ - 1];
           if (frame.function &&
-              frame.ip < frame.function->instruction_locations.size()) {
+              frame.ip < frame.function->line_table.size()) {
             const auto loc = nearestSourceLocation(*frame.function, frame.ip);
             if (loc.line > 0) {
               if (!loc.filename.empty()) {
@@ -1954,8 +2197,7 @@ slow_path:
 
     try {
       if (has_profiling) {
-        opcode_counts_[static_cast<uint8_t>(instruction.opcode)]++;
-        executed_instructions_++;
+        recordOpcodeProfile(function, ip, instruction.opcode);
       }
       if (has_tracing && current_chunk) {
         auto funcName =
@@ -1967,7 +2209,7 @@ slow_path:
         opts.showFunctionInfo = false;
         opts.useLabels = true;
         auto disasm = BytecodeDisassembler(*current_chunk)
-                          .formatInstruction(ip, instruction, opts);
+                          .formatInstruction(ip, instruction, opts, function);
       }
       // Slow loop advances ip AFTER executeInstruction (see end of loop body),
       // so the return address for a coroutine resume inside this instruction
@@ -2130,7 +2372,7 @@ slow_path:
         if (frame_count_ > 0) {
           auto &frame = frame_arena_[frame_count_ - 1];
           if (frame.function &&
-              frame.ip < frame.function->instruction_locations.size()) {
+              frame.ip < frame.function->line_table.size()) {
             const auto loc = nearestSourceLocation(*frame.function, frame.ip);
             line = loc.line;
             column = loc.column;
@@ -2155,7 +2397,7 @@ slow_path:
       if (frame_count_ > 0) {
         auto &frame = frame_arena_[frame_count_ - 1];
         if (frame.function &&
-            frame.ip < frame.function->instruction_locations.size()) {
+            frame.ip < frame.function->line_table.size()) {
           const auto loc = nearestSourceLocation(*frame.function, frame.ip);
           if (loc.line > 0) {
             if (!loc.filename.empty()) {
@@ -2208,16 +2450,16 @@ bool VM::handleScriptThrow(const Value &value) {
       debug_break_cb_();
   }
 
-  while (frame_count_ > 0) {
+  while (frame_count_ > throw_floor_) {
     auto &frame = frame_arena_[frame_count_ - 1];
     // Defensive check: ensure frame is valid
     if (!frame.function) {
       frame_count_--;
       continue;
     }
-    if (!frame.try_stack.empty()) {
-      const auto handler = frame.try_stack.back();
-      frame.try_stack.pop_back();
+    if (frame.try_count > 0) {
+      const auto handler = frame_arena_.topTry(frame);
+      frame.try_count--;
 
       // Defensive check: ensure stack_depth is not larger than current stack
       // If it is, something went wrong - reset to empty stack
@@ -2225,47 +2467,19 @@ bool VM::handleScriptThrow(const Value &value) {
       if (target_depth > stack.size()) {
         target_depth = 0; // Reset to empty if corrupted
       }
-      while (stack.size() > target_depth) {
-        stack.pop();
-      }
+      stack.truncate(target_depth);
 
       // Jump to catch block (finally is compiled into the catch block if it
       // exists)
       frame.ip = handler.catch_ip;
       // Run deferred closures for this frame before resuming at catch
-      auto deferred_copy = frame.defer_stack;
-      frame.defer_stack.clear();
-      while (!deferred_copy.empty()) {
-        Value defer_fn = deferred_copy.back();
-        deferred_copy.pop_back();
-        if (defer_fn.isClosureId() || defer_fn.isFunctionObjId() ||
-            defer_fn.isHostFuncId()) {
-          try {
-            callFunction(defer_fn, {});
-          } catch (...) {
-            // Swallow exceptions in deferred code during exception unwinding
-          }
-        }
-      }
+      runFrameDefers();
       return true;
     }
 
-    auto finished = frame;
     // Run deferred closures for this unwound frame
-    auto deferred_copy = finished.defer_stack;
-    finished.defer_stack.clear();
-    while (!deferred_copy.empty()) {
-      Value defer_fn = deferred_copy.back();
-      deferred_copy.pop_back();
-      if (defer_fn.isClosureId() || defer_fn.isFunctionObjId() ||
-          defer_fn.isHostFuncId()) {
-        try {
-          callFunction(defer_fn, {});
-        } catch (...) {
-          // Swallow exceptions in deferred code during exception unwinding
-        }
-      }
-    }
+    runFrameDefers();
+    const auto finished = frame_arena_[frame_count_ - 1];
     frame_count_--;
 
     closeFrameUpvalues(static_cast<uint32_t>(finished.locals_base),
@@ -2275,6 +2489,12 @@ bool VM::handleScriptThrow(const Value &value) {
     }
   }
 
+  // No handler above a callPrepared base: hand the value to the host code
+  // that re-entered, which unwinds and rethrows to its own caller.
+  if (throw_floor_ > 0) {
+    throw ScriptThrow{value};
+  }
+
   // No handler found - exception is uncaught
   if (debugger_attached_ && debug_break_on_uncaught_) {
     if (debug_break_cb_)
@@ -2305,8 +2525,8 @@ std::string VM::buildStackTrace(size_t frame_count) const {
     // Get line/column from instruction location
     uint32_t line = 0;
     uint32_t column = 0;
-    if (frame.ip < frame.function->instruction_locations.size()) {
-      const auto &loc = frame.function->instruction_locations[frame.ip];
+    if (frame.ip < frame.function->line_table.size()) {
+      const auto loc = frame.function->line_table.lookup(frame.ip);
       line = loc.line;
       column = loc.column;
     }
@@ -2337,7 +2557,6 @@ Value VM::call(const Value &callee_value, const std::vector<Value> &args) {
   const auto saved_stack = stack;
   const auto saved_locals = locals;
   const BytecodeChunk *base_chunk = current_chunk;
-  const auto saved_upvalues = open_upvalues;
   const uint32_t saved_when_watcher = current_when_watcher_id_;
   const uint32_t saved_coroutine = current_coroutine_id_;
 
@@ -2345,11 +2564,11 @@ Value VM::call(const Value &callee_value, const std::vector<Value> &args) {
   try {
     runDispatchLoop(base_depth);
   } catch (...) {
+    closeFrameUpvalues(static_cast<uint32_t>(saved_locals.size()), UINT32_MAX);
     stack = saved_stack;
     locals = saved_locals;
     frame_count_ = base_depth;
     current_chunk = base_chunk;
-    open_upvalues = saved_upvalues;
     current_when_watcher_id_ = saved_when_watcher;
     current_coroutine_id_ = saved_coroutine;
     suspension_requested_ = false;
@@ -2392,6 +2611,88 @@ void VM::packVariadicArgs(std::vector<Value> &args,
 
 void VM::setDebugMode(bool enabled) { debug_mode = enabled; }
 
+// Resolve the chunk that defines `function_index` (starting from `chunk`,
+// then the main, persistent and module chunks) and wrap the function in a
+// closure, as a FunctionObjId callee needs one. Returns 0 (and leaves
+// `chunk` as the last candidate) when no chunk defines it.
+uint32_t VM::closureForFunctionObj(uint32_t function_index,
+                                   const BytecodeChunk *&chunk) {
+  std::shared_ptr<BytecodeChunk> chunk_ref;
+  if (chunk && !chunk->getFunction(function_index)) {
+    if (main_chunk_ && main_chunk_->getFunction(function_index)) {
+      chunk = main_chunk_.get();
+      chunk_ref = main_chunk_;
+    } else {
+      for (auto &pc : persistent_chunks_) {
+        if (pc && pc->getFunction(function_index)) {
+          chunk = pc.get();
+          chunk_ref = pc;
+          break;
+        }
+      }
+    }
+    if (!chunk->getFunction(function_index)) {
+      for (auto &[_, mc] : module_chunks_) {
+        if (mc && mc->getFunction(function_index)) {
+          chunk = mc.get();
+          chunk_ref = mc;
+          break;
+        }
+      }
+    }
+  }
+  if (!chunk || !chunk->getFunction(function_index)) {
+    return 0;
+  }
+  // Reuse the calling frame's module_globals pointer (if set) so any
+  // ::global writes made by the callee write back into the same dict
+  // the caller observes. Without this, calling nested fns that have no
+  // upvalues (via LOAD_CONST fn[i] emitted by ByteCompiler) would
+  // silently drop STORE_GLOBAL writeback because the temporary closure
+  // had module_globals=nullptr.
+  const ModuleGlobals *parent_globals = nullptr;
+  uint32_t parent_cid = currentFrame().closure_id;
+  if (parent_cid != 0) {
+    auto *pclosure = heap_.closure(parent_cid);
+    if (pclosure && pclosure->module_globals) {
+      parent_globals = &pclosure->module_globals;
+    }
+  }
+  const FunctionObjClosureKey key{
+      chunk, parent_globals ? parent_globals->get() : nullptr, function_index};
+  // The cache doesn't root its closures: an entry is only good while the
+  // closure it names is alive and still as made (module loading may rebind
+  // a closure's globals, and a swept id may be reused).
+  auto isLive = [this](const FunctionObjClosureKey &k, uint32_t id) {
+    const auto *closure = heap_.closure(id);
+    return closure && closure->chunk == k.chunk &&
+           closure->function_index == k.function_index &&
+           closure->module_globals.get() == k.globals;
+  };
+  auto cached = function_obj_closures_.find(key);
+  if (cached != function_obj_closures_.end()) {
+    if (isLive(key, cached->second) &&
+        heap_.retainCachedClosure(cached->second)) {
+      return cached->second;
+    }
+  } else if (function_obj_closures_.size() >= function_obj_closures_prune_at_) {
+    std::erase_if(function_obj_closures_, [&](const auto &entry) {
+      return !isLive(entry.first, entry.second);
+    });
+    function_obj_closures_prune_at_ =
+        std::max<size_t>(64, function_obj_closures_.size() * 2);
+  }
+  auto closureRef = heap_.allocateClosure(GCHeap::RuntimeClosure{
+      .function_index = function_index,
+      .chunk_index = 0,
+      .chunk = chunk,
+      .chunk_ref = std::move(chunk_ref),
+      .module_globals = parent_globals ? *parent_globals : ModuleGlobals{},
+      .upvalues = {}});
+  function_obj_closures_[key] = closureRef.id;
+  return closureRef.id;
+}
+
 void VM::doCall(Value callee_value, std::vector<Value> args) {
   tail_call_depth_ = 0;
   // Consume any stashed return address (set by dispatch sites immediately
@@ -2405,38 +2706,7 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
 
   // Handle host function call directly
   if (callee_value.isHostFuncId()) {
-    uint32_t host_func_idx = callee_value.asHostFuncId();
-    if (host_func_idx < host_function_names_.size()) {
-      const std::string &hfname = host_function_names_[host_func_idx];
-    }
-    if (host_func_idx >= host_function_names_.size()) {
-      COMPILER_THROW("Host function index out of range: " +
-                     std::to_string(host_func_idx));
-    }
-    const std::string &name = host_function_names_[host_func_idx];
-    auto it = host_functions.find(name);
-    if (it == host_functions.end()) {
-      COMPILER_THROW("Host function not found: " + name);
-    }
-    gc_suspend_counter_++;
-    Value result = it->second(args);
-    gc_suspend_counter_--;
-    pushStack(result);
-    maybeCollectGarbage();
-
-    // Check for suspension request after host function returns
-    if (suspension_requested_) {
-      if (std::getenv("HAVEL_TRACE_SLEEP")) {
-        // fprintf(stderr, "[SLEEPDBG] doCall host %s susp propagated\n", name.c_str());
-      }
-      // Propagate into last_suspension_* so the caller (scheduler) reads the
-      // correct reason. Previously this only invoked yield_callback_, which
-      // re-entered the scheduler inline and clobbered the active suspension
-      // state (other goroutines also set suspension_requested_), so main's
-      // sleep suspend was lost and execution ran to completion.
-      last_suspension_reason_ = suspension_reason_;
-      last_suspension_context_ = suspension_context_;
-    }
+    pushHostResult(callee_value.asHostFuncId(), args);
     return;
   }
 
@@ -2457,33 +2727,6 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
       return;
     }
 
-    {
-      GCHeap::CallerFrame cf;
-      cf.coroutine_id = current_coroutine_id_;
-      cf.frame_count = frame_count_;
-      // Dispatch sites stash the true return address before executeInstruction
-      // (fast path pre-increments ip; slow loop does not). Fall back to the
-      // legacy slow-loop computation for direct doCall callers.
-      if (stashed_return_ip_ >= 0) {
-        cf.ip = static_cast<uint32_t>(stashed_return_ip_);
-      } else {
-        cf.ip = currentFrame().ip + 1;
-      }
-      cf.locals = locals;
-      {
-        std::vector<Value> tmp;
-        while (!stack.empty()) {
-          tmp.push_back(stack.top());
-          stack.pop();
-        }
-        for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
-          cf.stack.push_back(*it);
-        }
-      }
-      co->caller_stack.push_back(std::move(cf));
-    }
-    current_coroutine_id_ = coId;
-
     const auto *co_chunk = co->chunk ? co->chunk : current_chunk;
     const auto *func =
         co_chunk ? co_chunk->getFunction(co->function_index) : nullptr;
@@ -2491,18 +2734,17 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
       COMPILER_THROW("Function not found for coroutine");
     }
 
-    locals = co->locals;
-
-    immutable_locals_.clear();
+    // Dispatch sites stash the true return address before executeInstruction
+    // (fast path pre-increments ip; slow loop does not). Fall back to the
+    // legacy slow-loop computation for direct doCall callers.
+    uint32_t return_ip = stashed_return_ip_ >= 0
+                             ? static_cast<uint32_t>(stashed_return_ip_)
+                             : currentFrame().ip + 1;
+    // Switch onto the coroutine's own stack and locals
+    enterCoroutine(*co, coId, return_ip);
 
     size_t coroutine_stack_depth = stack.size();
-    if (frame_arena_.size() <= frame_count_) {
-      frame_arena_.push_back(
-          CallFrame{func, co_chunk, co->ip, 0, co->closure_id, false, {}, {}, 0, {}});
-    } else {
-      frame_arena_[frame_count_] =
-          CallFrame{func, co_chunk, co->ip, 0, co->closure_id, false, {}, {}, 0, {}};
-    }
+    frame_arena_.place(frame_count_, CallFrame{func, co_chunk, co->ip, 0, co->closure_id, false});
     frame_arena_[frame_count_].stack_depth = coroutine_stack_depth;
     frame_count_++;
 
@@ -2513,58 +2755,10 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
   uint32_t function_index = 0;
   uint32_t closure_id = 0;
   const BytecodeChunk *resolve_chunk = current_chunk;
-  std::shared_ptr<BytecodeChunk> resolve_chunk_ref;
-  std::shared_ptr<std::unordered_map<std::string, Value>> closure_globals;
+  ModuleGlobals closure_globals;
   if (callee_value.isFunctionObjId()) {
     function_index = callee_value.asFunctionObjId();
-    if (resolve_chunk && !resolve_chunk->getFunction(function_index)) {
-      if (main_chunk_ && main_chunk_->getFunction(function_index)) {
-        resolve_chunk = main_chunk_.get();
-        resolve_chunk_ref = main_chunk_;
-      } else {
-        for (auto &pc : persistent_chunks_) {
-          if (pc && pc->getFunction(function_index)) {
-            resolve_chunk = pc.get();
-            resolve_chunk_ref = pc;
-            break;
-          }
-        }
-      }
-      if (!resolve_chunk->getFunction(function_index)) {
-        for (auto &[_, mc] : module_chunks_) {
-          if (mc && mc->getFunction(function_index)) {
-            resolve_chunk = mc.get();
-            resolve_chunk_ref = mc;
-            break;
-          }
-        }
-      }
-    }
-    // Create a closure for FunctionObjId to capture module globals.
-    // Reuse the calling frame's module_globals pointer (if set) so any
-    // ::global writes made by the callee write back into the same dict
-    // the caller observes. Without this, calling nested fns that have no
-    // upvalues (via LOAD_CONST fn[i] emitted by ByteCompiler) would
-    // silently drop STORE_GLOBAL writeback because the temporary closure
-    // had module_globals=nullptr.
-    std::shared_ptr<std::unordered_map<std::string, Value>> foid_globals;
-    uint32_t parent_cid = currentFrame().closure_id;
-    if (parent_cid != 0) {
-      auto *pclosure = heap_.closure(parent_cid);
-      if (pclosure && pclosure->module_globals) {
-        foid_globals = pclosure->module_globals;
-      }
-    }
-    if (resolve_chunk && resolve_chunk->getFunction(function_index)) {
-      auto closureRef = heap_.allocateClosure(
-          GCHeap::RuntimeClosure{.function_index = function_index,
-                                 .chunk_index = 0,
-                                 .chunk = resolve_chunk,
-                                 .chunk_ref = resolve_chunk_ref,
-                                 .module_globals = std::move(foid_globals),
-                                 .upvalues = {}});
-      closure_id = closureRef.id;
-    }
+    closure_id = closureForFunctionObj(function_index, resolve_chunk);
   } else if (callee_value.isClosureId()) {
     closure_id = callee_value.asClosureId();
     auto *closure = heap_.closure(closure_id);
@@ -2860,7 +3054,11 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
 
             cell->closed_value = found ? closed_val : Value::makeNull();
             cell->is_open = false;
-            open_upvalues.erase(abs_index);
+            auto open_it = std::find(open_upvalues.begin(), open_upvalues.end(), cell);
+            if (open_it != open_upvalues.end()) {
+              open_upvalues.erase(open_it);
+              heap_.releaseUpvalue(cell);
+            }
           }
         }
       }
@@ -2908,11 +3106,8 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
   current_chunk = resolve_chunk;
 
   bool frame_owns_globals = false;
-  if (closure_globals) {
-    uint32_t cid = currentFrame().closure_id;
-    auto *c = heap_.closure(cid);
-    globals_stack_.push_back(std::move(globals));
-    globals = *closure_globals;
+  if (closure_globals && closure_globals != active_env_) {
+    enterModuleEnv(closure_globals);
     frame_owns_globals = true;
   }
 
@@ -2929,11 +3124,7 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
     cf.closure_id = closure_id;
     cf.owns_globals = frame_owns_globals;
     cf.stack_depth = static_cast<uint32_t>(stack_depth);
-    if (frame_arena_.size() <= frame_count_) {
-      frame_arena_.push_back(std::move(cf));
-    } else {
-      frame_arena_[frame_count_] = std::move(cf);
-    }
+    frame_arena_.place(frame_count_, std::move(cf));
   }
   frame_count_++;
 
@@ -3006,6 +3197,102 @@ void VM::doCall(Value callee_value, std::vector<Value> args) {
   }
 }
 
+bool VM::callScriptFromStack(uint32_t arg_count) {
+  if (debugger_attached_ || frame_count_ >= max_call_depth_) {
+    return false;
+  }
+  const size_t callee_slot = stack.size() - 1 - arg_count;
+  const Value callee_value = stack[callee_slot];
+
+  uint32_t function_index = 0;
+  uint32_t closure_id = 0;
+  const BytecodeChunk *resolve_chunk = current_chunk;
+  const ModuleGlobals *closure_globals = nullptr;
+  if (callee_value.isClosureId()) {
+    closure_id = callee_value.asClosureId();
+    auto *closure = heap_.closure(closure_id);
+    if (!closure) {
+      return false;
+    }
+    function_index = closure->function_index;
+    if (closure->chunk) {
+      resolve_chunk = closure->chunk;
+    }
+    if (closure->module_globals) {
+      closure_globals = &closure->module_globals;
+    }
+  } else {
+    function_index = callee_value.asFunctionObjId();
+    if (!resolve_chunk) {
+      return false;
+    }
+    closure_id = closureForFunctionObj(function_index, resolve_chunk);
+    if (closure_id == 0) {
+      return false;
+    }
+  }
+  const auto *callee =
+      resolve_chunk ? resolve_chunk->getFunction(function_index) : nullptr;
+  if (!callee || callee->is_generator ||
+      callee->variadic_param_index != UINT32_MAX ||
+      (callee->jit_compiled && jit_compiler_)) {
+    return false;
+  }
+  if (arg_count > 0 && stack.top().isObjectId()) {
+    auto *last = heap_.object(stack.top().asObjectId());
+    if (last && last->find("__kwargs") != last->end()) {
+      return false;
+    }
+  }
+
+  // From here on this is doCall's interpreter path without the vector.
+  tail_call_depth_ = 0;
+  pending_call_return_ip_ = -1;
+  callee->execution_count++;
+  if (callee->execution_count == 1000 && hot_func_cb_) {
+    hot_func_cb_(*callee);
+  }
+
+  current_chunk = resolve_chunk;
+  bool frame_owns_globals = false;
+  if (closure_globals && *closure_globals != active_env_) {
+    enterModuleEnv(*closure_globals);
+    frame_owns_globals = true;
+  }
+
+  const size_t base = locals.size();
+  locals.resize(base + std::max(callee->local_count, callee->param_count),
+                nullptr);
+  const uint32_t passed = std::min(arg_count, callee->param_count);
+  for (uint32_t i = 0; i < passed; ++i) {
+    locals[base + i] = stack[callee_slot + 1 + i];
+  }
+  for (uint32_t i = passed; i < callee->param_count; ++i) {
+    if (i < callee->default_values.size() &&
+        callee->default_values[i].has_value()) {
+      const auto &dv = callee->default_values[i].value();
+      // Sentinel: bool(true) means "fresh empty array" for arr=[] defaults
+      locals[base + i] = dv.isBool() && dv.asBool()
+                             ? Value::makeArrayId(heap_.allocateArray().id)
+                             : dv;
+    }
+  }
+  stack.truncate(callee_slot);
+
+  CallFrame cf;
+  cf.function = callee;
+  cf.chunk = resolve_chunk;
+  cf.ip = 0;
+  cf.locals_base = base;
+  cf.closure_id = closure_id;
+  cf.owns_globals = frame_owns_globals;
+  cf.stack_depth = callee_slot;
+  frame_arena_.place(frame_count_, cf);
+  frame_count_++;
+  immutable_locals_.clear();
+  return true;
+}
+
 void VM::doTailCall(Value callee_value, std::vector<Value> args) {
   // TCO reuses the current frame, so frame_count_ does not grow.
   // Only enforce the real stack limit (frame_count_), not an artificial
@@ -3091,7 +3378,7 @@ void VM::doTailCall(Value callee_value, std::vector<Value> args) {
   const BytecodeChunk *resolve_chunk = current_chunk;
   uint32_t function_index = 0;
   uint32_t closure_id = 0;
-  std::shared_ptr<std::unordered_map<std::string, Value>> tail_closure_globals;
+  ModuleGlobals tail_closure_globals;
   if (callee_value.isFunctionObjId()) {
     function_index = callee_value.asFunctionObjId();
     if (resolve_chunk && !resolve_chunk->getFunction(function_index)) {
@@ -3204,12 +3491,13 @@ void VM::doTailCall(Value callee_value, std::vector<Value> args) {
   current_frame.ip = 0;
   current_frame.closure_id = closure_id;
   current_chunk = resolve_chunk;
-  if (tail_closure_globals) {
-    if (!current_frame.owns_globals) {
-      globals_stack_.push_back(std::move(globals));
+  if (tail_closure_globals && tail_closure_globals != active_env_) {
+    if (current_frame.owns_globals) {
+      switchModuleEnv(tail_closure_globals);
+    } else {
+      enterModuleEnv(tail_closure_globals);
       current_frame.owns_globals = true;
     }
-    globals = *tail_closure_globals;
   }
   // Keep same locals base
 
@@ -3288,97 +3576,160 @@ void VM::doTailCall(Value callee_value, std::vector<Value> args) {
   }
 }
 
+static auto openUpvalueLowerBound(std::vector<GCHeap::UpvalueCell *> &open,
+                                  uint32_t abs_index) {
+  return std::lower_bound(open.begin(), open.end(), abs_index,
+                          [](const GCHeap::UpvalueCell *cell, uint32_t index) {
+                            return cell->absoluteIndex() < index;
+                          });
+}
+
 void VM::closeFrameUpvalues(uint32_t locals_base, uint32_t locals_end) {
-  if (locals_end < locals_base) {
+  if (locals_end <= locals_base || open_upvalues.empty() ||
+      open_upvalues.back()->absoluteIndex() < locals_base) {
     return;
   }
 
-  std::vector<uint32_t> to_close;
-  to_close.reserve(open_upvalues.size());
-  for (const auto &[index, _] : open_upvalues) {
-    if (index >= locals_base && index < locals_end) {
-      to_close.push_back(index);
-    }
+  // The list is sorted, so the frame's cells are one contiguous run.
+  auto first = openUpvalueLowerBound(open_upvalues, locals_base);
+  auto last = openUpvalueLowerBound(open_upvalues, locals_end);
+  for (auto it = first; it != last; ++it) {
+    GCHeap::UpvalueCell *cell = *it;
+    const uint32_t index = cell->absoluteIndex();
+    cell->close(index < locals.size() ? locals[index] : Value(nullptr));
+    heap_.releaseUpvalue(cell);
   }
+  open_upvalues.erase(first, last);
+}
 
-  for (uint32_t index : to_close) {
-    auto it = open_upvalues.find(index);
-    if (it == open_upvalues.end() || !it->second) {
-      continue;
-    }
-    auto &cell = it->second;
-    if (index < locals.size()) {
-      cell->closed_value = locals[index];
-    } else {
-      cell->closed_value = nullptr;
+GCHeap::UpvalueCell *VM::captureLocal(uint32_t open_index) {
+  const uint32_t abs = toAbsoluteLocal(open_index);
+  ensureLocalIndex(abs);
+  auto it = openUpvalueLowerBound(open_upvalues, abs);
+  if (it != open_upvalues.end() && (*it)->absoluteIndex() == abs) {
+    return *it;
+  }
+  auto *cell = heap_.createUpvalue(
+      open_index, static_cast<uint32_t>(currentFrame().locals_base));
+  heap_.retainUpvalue(cell);
+  open_upvalues.insert(it, cell);
+  return cell;
+}
+
+void VM::discardOpenUpvalues() {
+  for (GCHeap::UpvalueCell *cell : open_upvalues) {
+    heap_.releaseUpvalue(cell);
+  }
+  open_upvalues.clear();
+}
+
+void VM::pushTryHandler(const TryHandler &handler) {
+  frame_arena_.pushTry(frame_count_ - 1, handler);
+}
+
+void VM::pushDefer(const Value &fn) {
+  frame_arena_.pushDefer(frame_count_ - 1, fn);
+}
+
+void VM::runFrameDefers() {
+  const size_t index = frame_count_ - 1;
+  // Each defer is popped before it runs: the call may push frames whose
+  // slices start where this frame's now ends, overwriting the slot.
+  while (frame_arena_[index].defer_count > 0) {
+    CallFrame &frame = frame_arena_[index];
+    frame.defer_count--;
+    Value defer_fn = frame_arena_.defers[frame.defer_base + frame.defer_count];
+    if (defer_fn.isClosureId() || defer_fn.isFunctionObjId() ||
+        defer_fn.isHostFuncId()) {
+      try {
+        callFunction(defer_fn, {});
+      } catch (...) {
+        // Swallow exceptions in deferred code to allow remaining defers to run
+      }
     }
-    cell->is_open = false;
-    open_upvalues.erase(it);
   }
 }
 
-std::vector<Value> VM::stackValuesForRoots() const {
-  std::vector<Value> values;
-  std::stack<Value> copy = stack;
-  values.reserve(copy.size() + 64);
-  while (!copy.empty()) {
-    values.push_back(copy.top());
-    copy.pop();
+void VM::visitRoots(RootVisitor &visitor) const {
+  for (const auto &v : stack) {
+    visitor.visit(v);
+  }
+  for (const auto &v : locals) {
+    visitor.visit(v);
+  }
+  for (const auto &[_, v] : globals) {
+    visitor.visit(v);
+  }
+  // Closures of active frames. Their open cells are read through
+  // openLocal while they are traced.
+  for (size_t i = 0; i < frame_count_; ++i) {
+    const auto &frame = frame_arena_[i];
+    if (frame.closure_id != 0) {
+      visitor.visit(Value::makeClosureId(frame.closure_id));
+    }
+  }
+  // Pending defers of live frames; the slices are contiguous from 0.
+  if (frame_count_ > 0) {
+    const CallFrame &top = frame_arena_[frame_count_ - 1];
+    const size_t live_defers = top.defer_base + top.defer_count;
+    for (size_t i = 0; i < live_defers; ++i) {
+      visitor.visit(frame_arena_.defers[i]);
+    }
   }
   for (const auto &gmap : globals_stack_) {
     for (const auto &[_, v] : gmap) {
-      values.push_back(v);
+      visitor.visit(v);
     }
   }
   for (const auto &[_, v] : thread_results_) {
-    values.push_back(v);
+    visitor.visit(v);
   }
   for (const auto &[_, v] : timeout_results_) {
-    values.push_back(v);
+    visitor.visit(v);
   }
   for (const auto &[_, v] : interval_results_) {
-    values.push_back(v);
+    visitor.visit(v);
   }
   for (const auto &[_, v] : interval_captured_closures_) {
-    values.push_back(v);
+    visitor.visit(v);
   }
   for (const auto &[_, v] : timeout_captured_closures_) {
-    values.push_back(v);
+    visitor.visit(v);
   }
   for (const auto &[_, v] : thread_captured_closures_) {
-    values.push_back(v);
+    visitor.visit(v);
   }
   for (const auto &[_, ov] : overloaded_methods_) {
     for (const auto &v : ov) {
-      values.push_back(v);
+      visitor.visit(v);
     }
   }
   for (const auto &[_, oref] : function_properties_) {
-    values.push_back(Value::makeObjectId(oref.id));
+    visitor.visit(Value::makeObjectId(oref.id));
   }
   for (const auto &[_, oref] : closure_properties_) {
-    values.push_back(Value::makeObjectId(oref.id));
+    visitor.visit(Value::makeObjectId(oref.id));
   }
   for (const auto &[_, oref] : hostfunc_properties_) {
-    values.push_back(Value::makeObjectId(oref.id));
+    visitor.visit(Value::makeObjectId(oref.id));
   }
   for (const auto &[_, thunk] : direct_call_thunks_) {
     for (const auto &call : thunk.calls) {
       for (const auto &arg : call.args) {
-        values.push_back(arg);
+        visitor.visit(arg);
       }
     }
   }
   if (current_exception_.isErrorId()) {
-    values.push_back(current_exception_);
+    visitor.visit(current_exception_);
   }
   if (current_coroutine_id_ != UINT32_MAX) {
-    values.push_back(Value::makeCoroutineId(current_coroutine_id_));
+    visitor.visit(Value::makeCoroutineId(current_coroutine_id_));
   }
   for (const auto &pc : pending_calls) {
-    values.push_back(pc.fn);
+    visitor.visit(pc.fn);
     for (const auto &arg : pc.args) {
-      values.push_back(arg);
+      visitor.visit(arg);
     }
   }
   for (const auto &[_, chunk] : module_chunks_) {
@@ -3386,7 +3737,7 @@ std::vector<Value> VM::stackValuesForRoots() const {
       continue;
     for (const auto &func : chunk->getAllFunctions()) {
       for (const auto &constVal : func.constants) {
-        values.push_back(constVal);
+        visitor.visit(constVal);
       }
     }
   }
@@ -3395,7 +3746,7 @@ std::vector<Value> VM::stackValuesForRoots() const {
       continue;
     for (const auto &func : chunk->getAllFunctions()) {
       for (const auto &constVal : func.constants) {
-        values.push_back(constVal);
+        visitor.visit(constVal);
       }
     }
   }
@@ -3403,45 +3754,26 @@ std::vector<Value> VM::stackValuesForRoots() const {
     if (!mg)
       continue;
     for (const auto &[_, v] : *mg) {
-      values.push_back(v);
+      visitor.visit(v);
     }
   }
   // Scheduler goroutine roots
   if (scheduler_) {
-    auto scheduler_roots = scheduler_->getGCRoots();
-    values.insert(values.end(), scheduler_roots.begin(), scheduler_roots.end());
+    scheduler_->visitGCRoots(visitor);
   }
-  return values;
 }
 
-std::vector<uint32_t> VM::activeClosureIdsForRoots() const {
-  std::vector<uint32_t> closure_ids;
-  closure_ids.reserve(frame_count_);
-  for (size_t i = 0; i < frame_count_; ++i) {
-    const auto &frame = frame_arena_[i];
-    if (frame.closure_id != 0) {
-      closure_ids.push_back(frame.closure_id);
-    }
+std::optional<Value> VM::openLocal(uint32_t index) const {
+  if (index >= locals.size()) {
+    return std::nullopt;
   }
-  return closure_ids;
+  return locals[index];
 }
 
 void VM::maybeCollectGarbage() {
-  if (gc_suspend_counter_ > 0)
+  if (gc_suspend_counter_ > 0 || !heap_.collectionWorkPending())
     return;
-  std::vector<Value> scheduler_roots;
-  if (scheduler_) {
-    scheduler_roots = scheduler_->getGCRoots();
-  }
-  heap_.maybeCollectGarbage(stackValuesForRoots(), locals, globals,
-                            activeClosureIdsForRoots(),
-                            [this](uint32_t index) -> std::optional<Value> {
-                              if (index >= locals.size()) {
-                                return std::nullopt;
-                              }
-                              return locals[index];
-                            },
-                            scheduler_roots);
+  heap_.maybeCollectGarbage(*this);
 }
 
 void VM::drainFinalizers() {
@@ -3461,35 +3793,11 @@ void VM::drainFinalizers() {
 void VM::collectGarbage() {
   if (gc_suspend_counter_ > 0)
     return;
-  std::vector<Value> scheduler_roots;
-  if (scheduler_) {
-    scheduler_roots = scheduler_->getGCRoots();
-  }
-  heap_.collectGarbage(stackValuesForRoots(), locals, globals,
-                       activeClosureIdsForRoots(),
-                       [this](uint32_t index) -> std::optional<Value> {
-                         if (index >= locals.size()) {
-                           return std::nullopt;
-                         }
-                         return locals[index];
-                       },
-                       scheduler_roots);
+  heap_.collectGarbage(*this);
 }
 
 void VM::stepGarbageCollection(size_t work_budget) {
-  std::vector<Value> scheduler_roots;
-  if (scheduler_) {
-    scheduler_roots = scheduler_->getGCRoots();
-  }
-  heap_.stepGarbageCollection(
-      stackValuesForRoots(), locals, globals, activeClosureIdsForRoots(),
-      [this](uint32_t index) -> std::optional<Value> {
-        if (index >= locals.size()) {
-          return std::nullopt;
-        }
-        return locals[index];
-      },
-      work_budget, scheduler_roots);
+  heap_.stepGarbageCollection(*this, work_budget);
 }
 
 void VM::garbageCollectionSafePoint(size_t work_budget) {
@@ -3503,30 +3811,25 @@ void VM::garbageCollectionSafePoint(size_t work_budget) {
 // Stack helpers - extracted from executeInstruction to reduce stack frame size
 // ============================================================================
 
-Value VM::popStack() {
-  if (stack.empty()) {
-    if (frame_count_ > 0) {
-      const auto &frame = currentFrame();
-      ::havel::error("Stack underflow in function '{}' at IP {}",
-                     frame.function->name, frame.ip);
-      if (frame.ip < frame.function->instructions.size()) {
-        const auto &instr = frame.function->instructions[frame.ip];
-        ::havel::error("Offending Instruction: IP {} OpCode {}", frame.ip,
-                       static_cast<int>(instr.opcode));
-      }
+void VM::stackUnderflow() {
+  if (frame_count_ > 0) {
+    const auto &frame = currentFrame();
+    ::havel::error("Stack underflow in function '{}' at IP {}",
+                   frame.function->name, frame.ip);
+    if (frame.ip < frame.function->instructions.size()) {
+      const auto &instr = frame.function->instructions[frame.ip];
+      ::havel::error("Offending Instruction: IP {} OpCode {}", frame.ip,
+                     static_cast<int>(instr.opcode));
     }
-    COMPILER_THROW("Stack underflow");
   }
-  Value value = stack.top();
-  stack.pop();
-  return value;
+  COMPILER_THROW("Stack underflow");
 }
 
-void VM::pushStack(Value value) {
-  if (stack.size() >= 1'000'000) {
+void VM::growStack() {
+  if (stack.size() >= vm_config_.max_stack_depth) {
     COMPILER_THROW("Expression stack overflow");
   }
-  stack.push(std::move(value));
+  stack.grow(stack.size() + 1);
 }
 
 uint32_t VM::toAbsoluteLocal(uint32_t local_index) {
@@ -3554,6 +3857,73 @@ void VM::ensureLocalIndex(uint32_t absolute_index) {
   }
 }
 
+void VM::enterModuleEnv(const ModuleGlobals &env) {
+  if (active_env_) {
+    *active_env_ = std::move(globals);
+  } else {
+    globals_stack_.push_back(std::move(globals));
+  }
+  env_stack_.push_back(std::move(active_env_));
+  globals = std::move(*env);
+  active_env_ = env;
+}
+
+void VM::leaveModuleEnv() {
+  if (active_env_) {
+    *active_env_ = std::move(globals);
+  }
+  if (!env_stack_.empty()) {
+    active_env_ = std::move(env_stack_.back());
+    env_stack_.pop_back();
+  } else {
+    active_env_.reset();
+  }
+  if (active_env_) {
+    globals = std::move(*active_env_);
+  } else if (!globals_stack_.empty()) {
+    globals = std::move(globals_stack_.back());
+    globals_stack_.pop_back();
+  }
+}
+
+void VM::switchModuleEnv(const ModuleGlobals &env) {
+  if (active_env_) {
+    *active_env_ = std::move(globals);
+  }
+  globals = std::move(*env);
+  active_env_ = env;
+}
+
+ModuleGlobals VM::parkModuleEnv() {
+  if (active_env_) {
+    *active_env_ = globals;
+  }
+  return std::exchange(active_env_, nullptr);
+}
+
+void VM::unparkModuleEnv(ModuleGlobals parked) {
+  if (parked) {
+    globals = std::move(*parked);
+    active_env_ = std::move(parked);
+  }
+}
+
+std::optional<Value> VM::saveGlobalObjectBinding() const {
+  auto it = globals.find("_G");
+  if (it == globals.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void VM::restoreGlobalObjectBinding(const std::optional<Value> &saved) {
+  if (saved) {
+    globals["_G"] = *saved;
+  } else if (globals.contains("_G")) {
+    globals.erase("_G");
+  }
+}
+
 void VM::doReturn() {
   tail_call_depth_ = 0;
   if (frame_count_ == 0) {
@@ -3561,21 +3931,7 @@ void VM::doReturn() {
   }
 
   // Execute deferred closures in reverse order (LIFO)
-  // Copy the defer stack first since callFunction may reallocate frame_arena_
-  auto deferred_copy = frame_arena_[frame_count_ - 1].defer_stack;
-  frame_arena_[frame_count_ - 1].defer_stack.clear();
-  while (!deferred_copy.empty()) {
-    Value defer_fn = deferred_copy.back();
-    deferred_copy.pop_back();
-    if (defer_fn.isClosureId() || defer_fn.isFunctionObjId() ||
-        defer_fn.isHostFuncId()) {
-      try {
-        callFunction(defer_fn, {});
-      } catch (...) {
-        // Swallow exceptions in deferred code to allow remaining defers to run
-      }
-    }
-  }
+  runFrameDefers();
 
   Value ret = nullptr;
   if (!stack.empty()) {
@@ -3591,7 +3947,7 @@ void VM::doReturn() {
     ret = deepMaterializeStrings(ret, current_chunk);
   }
 
-  auto finished = frame_arena_[frame_count_ - 1];
+  const auto finished = frame_arena_[frame_count_ - 1];
   frame_count_--;
 
   // Restore current_chunk from parent frame
@@ -3599,46 +3955,9 @@ void VM::doReturn() {
     current_chunk = frame_arena_[frame_count_ - 1].chunk;
   }
 
-  // Restore globals if this frame swapped them (module closure call)
-  if (finished.owns_globals && !globals_stack_.empty()) {
-    globals = std::move(globals_stack_.back());
-    globals_stack_.pop_back();
-    // Refresh the caller's globals from the shared module map when caller
-    // and callee share the same module globals (same-module nested call).
-    // The callee's STORE_GLOBAL persisted writes to the shared map, but the
-    // caller's saved copy predates them; without this refresh module state
-    // like display._dpy/_initialized written by a nested same-module call
-    // would be lost when the caller's stale copy is restored. The original
-    // buggy ClosureId wrapper (owns_globals=true, no push) hid this by
-    // accidentally leaving globals on the working copy.
-    // Only keys the callee chain actually wrote are copied (tracked in
-    // written_globals), keeping the hot self-hosted parser path cheap.
-    if (frame_count_ > 0) {
-      uint32_t callerCid = frame_arena_[frame_count_ - 1].closure_id;
-      uint32_t calleeCid = finished.closure_id;
-      if (callerCid != 0 && calleeCid != 0) {
-        auto *cc = heap_.closure(callerCid);
-        auto *fc = heap_.closure(calleeCid);
-        if (cc && fc && cc->module_globals && fc->module_globals &&
-            cc->module_globals == fc->module_globals) {
-          auto &callerFrame = frame_arena_[frame_count_ - 1];
-          for (const auto &k : finished.written_globals) {
-            auto it = fc->module_globals->find(k);
-            if (it != fc->module_globals->end()) {
-              globals[k] = it->second;
-              // Propagate the key up so a chain A->B->C sees B's writes
-              // when A returns (A's own written_globals must include the
-              // keys its callees wrote).
-              if (std::find(callerFrame.written_globals.begin(),
-                            callerFrame.written_globals.end(), k) ==
-                  callerFrame.written_globals.end()) {
-                callerFrame.written_globals.push_back(k);
-              }
-            }
-          }
-        }
-      }
-    }
+  // Leave the module env this frame entered (module closure call)
+  if (finished.owns_globals) {
+    leaveModuleEnv();
   }
 
   closeFrameUpvalues(static_cast<uint32_t>(finished.locals_base),
@@ -3655,29 +3974,14 @@ void VM::doReturn() {
   immutable_locals_.clear();
 
   // Restore expression stack to the depth at call time, preserving return value
-  while (stack.size() > finished.stack_depth) {
-    popStack();
-  }
+  stack.truncate(finished.stack_depth);
 
   if (current_coroutine_id_ != UINT32_MAX) {
     auto *co = heap_.coroutine(current_coroutine_id_);
     if (co) {
       co->state = GCHeap::Coroutine::Done;
       if (!co->caller_stack.empty()) {
-        auto &caller = co->caller_stack.back();
-        frame_count_ = caller.frame_count;
-        locals = caller.locals;
-        immutable_locals_.clear();
-        current_coroutine_id_ = caller.coroutine_id;
-
-        currentFrame().ip = caller.ip;
-
-        stack = std::stack<Value>();
-        for (auto it = caller.stack.begin(); it != caller.stack.end(); ++it) {
-          stack.push(*it);
-        }
-
-        co->caller_stack.pop_back();
+        leaveCoroutine(*co);
       }
     }
   }
@@ -3685,6 +3989,11 @@ void VM::doReturn() {
   pushStack(ret);
 }
 
+bool VM::variableChangesObserved() const {
+  return on_var_changed_sync_ || debugging::debug_var_changed ||
+         (event_queue_ && event_queue_->hasHandler(EventType::VAR_CHANGED));
+}
+
 void VM::emitVariableChanged(const std::string &var_name) {
   if (on_var_changed_sync_ && !on_var_changed_busy_.exchange(true)) {
     on_var_changed_sync_(var_name);
@@ -3859,7 +4168,7 @@ Value VM::deepMaterializeStrings(Value value, const BytecodeChunk *chunk,
     return value;
 
   if (value.isStringValId()) {
-    auto strRef = heap_.allocateString(chunk->getString(value.asStringValId()));
+    auto strRef = heap_.internString(chunk->getString(value.asStringValId()));
     return Value::makeStringId(strRef.id);
   }
 
@@ -3884,7 +4193,7 @@ Value VM::deepMaterializeStrings(Value value, const BytecodeChunk *chunk,
       return value;
     visited.insert(objId);
     std::vector<std::pair<std::string, Value>> entries;
-    for (auto &[k, v] : *obj) {
+    for (const auto &[k, v] : *obj) {
       Value mat_key_v = deepMaterializeStrings(v, chunk, visited);
       entries.emplace_back(k, mat_key_v);
     }
@@ -3913,7 +4222,7 @@ Value VM::deepMaterializeStrings(Value value, const BytecodeChunk *chunk,
 
 Value VM::deepWrapModuleFunctions(
     Value value, std::shared_ptr<BytecodeChunk> chunk,
-    std::shared_ptr<std::unordered_map<std::string, Value>> moduleGlobals,
+    ModuleGlobals moduleGlobals,
     const std::string &canonicalKey, const std::string &fieldPath, int depth,
     std::unordered_set<uint32_t> *visitedPtr) {
   if (depth > 64)
@@ -3966,16 +4275,20 @@ Value VM::deepWrapModuleFunctions(
             callArgs.erase(callArgs.begin());
           }
           auto *savedChunk = current_chunk;
-          auto savedGlobals = globals;
           auto savedMirrorId = globals_mirror_object_id_;
-          Value savedG = globals["_G"];
-          globals = *moduleGlobals;
+          const auto savedG = saveGlobalObjectBinding();
+          const bool enteredEnv = moduleGlobals != active_env_;
+          if (enteredEnv) {
+            enterModuleEnv(moduleGlobals);
+          }
           current_chunk = moduleChunk.get();
           const auto *callee = moduleChunk->getFunction(funcIdx);
           if (!callee) {
-            globals = std::move(savedGlobals);
+            if (enteredEnv) {
+              leaveModuleEnv();
+            }
             globals_mirror_object_id_ = savedMirrorId;
-            globals["_G"] = savedG;
+            restoreGlobalObjectBinding(savedG);
             current_chunk = savedChunk;
             return Value::makeNull();
           }
@@ -3983,21 +4296,13 @@ Value VM::deepWrapModuleFunctions(
           size_t savedLocalsSize = base;
           locals.resize(base + callee->local_count, nullptr);
           uint32_t frame_stack_depth = static_cast<uint32_t>(stack.size());
-          if (frame_arena_.size() <= frame_count_) {
-            CallFrame cf;
-            cf.function = callee;
-            cf.chunk = moduleChunk.get();
-            cf.ip = 0;
-            cf.locals_base = base;
-            cf.stack_depth = frame_stack_depth;
-            frame_arena_.push_back(std::move(cf));
-          } else {
-            frame_arena_[frame_count_].function = callee;
-            frame_arena_[frame_count_].chunk = moduleChunk.get();
-            frame_arena_[frame_count_].ip = 0;
-            frame_arena_[frame_count_].locals_base = base;
-            frame_arena_[frame_count_].stack_depth = frame_stack_depth;
-          }
+          CallFrame cf;
+          cf.function = callee;
+          cf.chunk = moduleChunk.get();
+          cf.ip = 0;
+          cf.locals_base = base;
+          cf.stack_depth = frame_stack_depth;
+          frame_arena_.place(frame_count_, std::move(cf));
           frame_count_++;
           for (uint32_t i = 0; i < callee->param_count; i++) {
             if (callee->variadic_param_index != UINT32_MAX &&
@@ -4043,9 +4348,11 @@ Value VM::deepWrapModuleFunctions(
             if (locals.size() > savedLocalsSize) {
               locals.resize(savedLocalsSize);
             }
-            globals = std::move(savedGlobals);
+            if (enteredEnv) {
+              leaveModuleEnv();
+            }
             globals_mirror_object_id_ = savedMirrorId;
-            globals["_G"] = savedG;
+            restoreGlobalObjectBinding(savedG);
             current_chunk = savedChunk;
             throw;
           }
@@ -4058,14 +4365,15 @@ Value VM::deepWrapModuleFunctions(
                 deepMaterializeStrings(result, current_chunk), moduleChunk,
                 moduleGlobals, fnCapturedKey, fnCapturedField + "_ret", depth + 1, visitedPtr);
           }
-          *moduleGlobals = std::move(globals);
-          globals = std::move(savedGlobals);
+          if (enteredEnv) {
+            leaveModuleEnv();
+          }
           globals_mirror_object_id_ = savedMirrorId;
-          globals["_G"] = savedG;
+          restoreGlobalObjectBinding(savedG);
           current_chunk = savedChunk;
           return result;
         });
-    uint32_t hostIdx = host_function_globals_[wrapperName].asHostFuncId();
+    uint32_t hostIdx = host_function_globals_.at(wrapperName).asHostFuncId();
     if (wantsSelf) {
       host_function_wants_self_.insert(hostIdx);
     }
@@ -4109,17 +4417,21 @@ Value VM::deepWrapModuleFunctions(
             return Value::makeNull();
 
           auto *savedChunk = current_chunk;
-          auto savedGlobals = globals;
           auto savedMirrorId = globals_mirror_object_id_;
-          Value savedG = globals["_G"];
-          globals = *closureGlobals;
+          const auto savedG = saveGlobalObjectBinding();
+          const bool enteredEnv = closureGlobals != active_env_;
+          if (enteredEnv) {
+            enterModuleEnv(closureGlobals);
+          }
           current_chunk = moduleChunk.get();
 
           const auto *callee = moduleChunk->getFunction(funcIdx);
           if (!callee) {
-            globals = std::move(savedGlobals);
+            if (enteredEnv) {
+              leaveModuleEnv();
+            }
             globals_mirror_object_id_ = savedMirrorId;
-            globals["_G"] = savedG;
+            restoreGlobalObjectBinding(savedG);
             current_chunk = savedChunk;
             return Value::makeNull();
           }
@@ -4127,10 +4439,9 @@ Value VM::deepWrapModuleFunctions(
           size_t base = locals.size();
           locals.resize(base + callee->local_count, nullptr);
           uint32_t frame_stack_depth = static_cast<uint32_t>(stack.size());
-          // IMPORTANT: owns_globals must be FALSE here. This wrapper saves
-          // globals into a local C++ variable (savedGlobals above) and
-          // restores it explicitly on return (line ~4193); it does NOT push
-          // onto globals_stack_. If owns_globals were true, the RET opcode
+          // IMPORTANT: owns_globals must be FALSE here. This wrapper enters
+          // the module env itself (above) and leaves it explicitly on
+          // return. If owns_globals were true, the RET opcode
           // inside the wrapped bytecode would pop a stale globals_stack_
           // entry (one pushed by an ancestor caller), corrupting the
           // goroutine's globals scope. This was the root cause of the
@@ -4140,25 +4451,15 @@ Value VM::deepWrapModuleFunctions(
           // eventually unwinding the goroutine's TCO-pushed ambient and
           // restoring globals to a map lacking the protocols module's
           // _atoms_cache, so the next LOAD_GLOBAL in _atom threw.
-          if (frame_arena_.size() <= frame_count_) {
-            CallFrame cf;
-            cf.function = callee;
-            cf.chunk = moduleChunk.get();
-            cf.ip = 0;
-            cf.locals_base = base;
-            cf.closure_id = closureId;
-            cf.stack_depth = frame_stack_depth;
-            cf.owns_globals = false;
-            frame_arena_.push_back(std::move(cf));
-          } else {
-            frame_arena_[frame_count_].function = callee;
-            frame_arena_[frame_count_].chunk = moduleChunk.get();
-            frame_arena_[frame_count_].ip = 0;
-            frame_arena_[frame_count_].locals_base = base;
-            frame_arena_[frame_count_].closure_id = closureId;
-            frame_arena_[frame_count_].stack_depth = frame_stack_depth;
-            frame_arena_[frame_count_].owns_globals = false;
-          }
+          CallFrame cf;
+          cf.function = callee;
+          cf.chunk = moduleChunk.get();
+          cf.ip = 0;
+          cf.locals_base = base;
+          cf.closure_id = closureId;
+          cf.stack_depth = frame_stack_depth;
+          cf.owns_globals = false;
+          frame_arena_.place(frame_count_, std::move(cf));
           frame_count_++;
 
           for (uint32_t i = 0; i < callee->param_count; i++) {
@@ -4205,9 +4506,11 @@ Value VM::deepWrapModuleFunctions(
             if (locals.size() > base) {
               locals.resize(base);
             }
-            globals = std::move(savedGlobals);
+            if (enteredEnv) {
+              leaveModuleEnv();
+            }
             globals_mirror_object_id_ = savedMirrorId;
-            globals["_G"] = savedG;
+            restoreGlobalObjectBinding(savedG);
             current_chunk = savedChunk;
             throw;
           }
@@ -4217,13 +4520,15 @@ Value VM::deepWrapModuleFunctions(
                 deepMaterializeStrings(result, current_chunk), moduleChunk,
                 closureGlobals, capturedKey, capturedField + "_ret", depth + 1, visitedPtr);
           }
-          globals = std::move(savedGlobals);
+          if (enteredEnv) {
+            leaveModuleEnv();
+          }
           globals_mirror_object_id_ = savedMirrorId;
-          globals["_G"] = savedG;
+          restoreGlobalObjectBinding(savedG);
           current_chunk = savedChunk;
           return result;
         });
-    uint32_t hostIdx = host_function_globals_[wrapperName].asHostFuncId();
+    uint32_t hostIdx = host_function_globals_.at(wrapperName).asHostFuncId();
     if (wantsSelfClosure) {
       host_function_wants_self_.insert(hostIdx);
     }
@@ -4396,7 +4701,7 @@ void VM::activateLazyModule(const std::string &name) {
     if (proxyObj) {
       auto *lazyFlag = proxyObj->get("__lazy__");
       if (lazyFlag && lazyFlag->isBool() && lazyFlag->asBool()) {
-        for (auto &[k, v] : *proxyObj) {
+        for (const auto &[k, v] : *proxyObj) {
           if (k != "__lazy__" && k != "__module__") {
             savedFields.emplace_back(k, v);
           }
@@ -4541,7 +4846,7 @@ Value VM::loadModule(const std::string &path) {
   // Local variables needed by all return paths
   std::unordered_set<std::string> inheritedGlobalNames;
   std::unordered_map<std::string, Value> inheritedGlobalValues;
-  std::shared_ptr<std::unordered_map<std::string, Value>> moduleGlobalsSnapshot;
+  ModuleGlobals moduleGlobalsSnapshot;
   std::unordered_set<std::string> saved_immutable_globals = immutable_globals_;
   uint32_t old_mirror_id = globals_mirror_object_id_;
   Value old_g = globals["_G"];
@@ -4556,19 +4861,20 @@ Value VM::loadModule(const std::string &path) {
   // debug's map) and fail at LOAD_GLOBAL time.
   auto fixupCachedClosures = [&](const std::string &moduleKey,
                                  Value exportsVal,
-                                 const std::shared_ptr<std::unordered_map<std::string, Value>> &cachedGlobals) {
+                                 const ModuleGlobals &cachedGlobals) {
     std::shared_ptr<BytecodeChunk> ownChunk;
     auto ownIt = module_chunks_.find(moduleKey);
     if (ownIt != module_chunks_.end()) ownChunk = ownIt->second;
     if (!ownChunk) return; // cannot verify ownership, leave closures untouched
+    const auto &cachedContents = moduleEnvContents(cachedGlobals);
 
     for (auto &[func_name, func_val] : globals) {
       if (!func_val.isClosureId()) continue;
       auto *closure = heap_.closure(func_val.asClosureId());
       if (!closure || !closure->module_globals) continue;
       if (closure->chunk != ownChunk.get()) continue;
-      auto it = cachedGlobals->find(func_name);
-      if (it != cachedGlobals->end() && it->second.isClosureId() &&
+      auto it = cachedContents.find(func_name);
+      if (it != cachedContents.end() && it->second.isClosureId() &&
           it->second.asClosureId() == func_val.asClosureId()) {
         closure->module_globals = cachedGlobals;
       }
@@ -4577,13 +4883,13 @@ Value VM::loadModule(const std::string &path) {
     if (exportsVal.isObjectId()) {
       auto *exportsObj = heap_.object(exportsVal.asObjectId());
       if (exportsObj) {
-        for (auto &[name, val] : *exportsObj) {
+        for (const auto &[name, val] : *exportsObj) {
           if (!val.isClosureId()) continue;
           auto *closure = heap_.closure(val.asClosureId());
           if (!closure || !closure->module_globals) continue;
           if (closure->chunk != ownChunk.get()) continue;
-          auto it = cachedGlobals->find(name);
-          if (it != cachedGlobals->end() && it->second.isClosureId() &&
+          auto it = cachedContents.find(name);
+          if (it != cachedContents.end() && it->second.isClosureId() &&
               it->second.asClosureId() == val.asClosureId()) {
             closure->module_globals = cachedGlobals;
           }
@@ -4602,7 +4908,7 @@ Value VM::loadModule(const std::string &path) {
   // Check cache via canonical ModuleLoader
   if (moduleLoader_.isCached(canonicalKey)) {
     Value cachedVal;
-    std::shared_ptr<std::unordered_map<std::string, Value>> cachedGlobals;
+    ModuleGlobals cachedGlobals;
     if (moduleLoader_.getCached(canonicalKey, &cachedVal)) {
       moduleLoader_.getCachedGlobals(path, &cachedGlobals);
 
@@ -4691,7 +4997,7 @@ return cachedVal;
     // Check cache by resolved path
     if (moduleLoader_.isCached(canonicalKey)) {
       Value cachedVal;
-      std::shared_ptr<std::unordered_map<std::string, Value>> cachedGlobals;
+      ModuleGlobals cachedGlobals;
       if (moduleLoader_.getCached(canonicalKey, &cachedVal)) {
         moduleLoader_.getCachedGlobals(canonicalKey, &cachedGlobals);
         if (cachedGlobals) {
@@ -5104,7 +5410,7 @@ return cachedVal;
     }
 
     // Create module globals snapshot for closures
-    auto moduleGlobalsForCache = std::make_shared<std::unordered_map<std::string, Value>>(globals);
+    auto moduleGlobalsForCache = std::make_shared<GlobalTable>(globals);
     for (auto &[name, value] : globals) {
       if (value.isClosureId()) {
         auto *closure = heap_.closure(value.asClosureId());
@@ -5237,6 +5543,7 @@ return cachedVal;
 
   // Execute the module in a sandboxed globals context
   // Save current globals state
+  auto parked_env = parkModuleEnv();
   globals_stack_.push_back(globals);
 
   // Save caller's immutable_globals_ and create fresh set for sandbox
@@ -5324,6 +5631,7 @@ return cachedVal;
     // Restore everything on error
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     stack = std::move(saved_stack);
@@ -5340,22 +5648,15 @@ return cachedVal;
     COMPILER_THROW("Module " + path + " has no __main__ function");
   }
 
-  while (!stack.empty())
-    stack.pop();
+  stack.clear();
   locals.clear();
   frame_count_ = 0;
-  open_upvalues.clear();
+  discardOpenUpvalues();
   immutable_locals_.clear();
   has_current_exception_ = false;
   current_exception_ = nullptr;
 
-  if (frame_arena_.size() <= frame_count_) {
-    frame_arena_.push_back(
-        CallFrame{entry, chunk.get(), 0, 0, 0, false, {}, {}, 0, {}});
-  } else {
-    frame_arena_[frame_count_] =
-        CallFrame{entry, chunk.get(), 0, 0, 0, false, {}, {}, 0, {}};
-  }
+  frame_arena_.place(frame_count_, CallFrame{entry, chunk.get(), 0, 0, 0, false});
   frame_count_++;
   locals.resize(entry->local_count);
 
@@ -5371,6 +5672,7 @@ return cachedVal;
     // Restore caller's globals and execution state on error
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     stack = std::move(saved_stack);
@@ -5394,7 +5696,7 @@ return cachedVal;
   // This includes runtime variables like 'flags = DebugFlags()'.
   // Use this for wrapping exports and for cached module loads.
   auto moduleGlobalsForCache =
-      std::make_shared<std::unordered_map<std::string, Value>>(globals);
+      std::make_shared<GlobalTable>(globals);
   if (globals.find("emitError") != globals.end() && globals.find("emitterError") == globals.end()) {
     std::cerr << "[DEBUG] COLD-SNAPSHOT-MISSES-EMITTERERROR module=" << canonicalKey
               << " size=" << globals.size() << "\n";
@@ -5624,6 +5926,7 @@ return cachedVal;
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
   }
+  unparkModuleEnv(std::move(parked_env));
   // Restore caller's immutable_globals_ (sandbox had its own cleared set)
   immutable_globals_ = std::move(sandbox_saved_immutable_globals);
   // Propagate lazy module objects to the caller's globals
@@ -6066,7 +6369,7 @@ std::unordered_map<std::string, Value> VM::deserializeGlobals(std::span<const ui
                 uint32_t strId = 0;
                 if (!read(&strId, sizeof(strId))) return std::nullopt;
                 if (strId < stringList.size()) {
-                    auto strRef = heap_.allocateString(stringList[strId]);
+                    auto strRef = heap_.internString(stringList[strId]);
                     return Value::makeStringId(strRef.id);
                 }
                 return nullptr;
@@ -6192,7 +6495,7 @@ std::optional<std::vector<uint8_t>> VM::readGlobalsFromHvc(const std::string& hv
     return globalsData;
 }
 
-bool VM::deserializeGlobalsFromHvc(const std::string& hvcPath, std::unordered_map<std::string, Value>& outGlobals,
+bool VM::deserializeGlobalsFromHvc(const std::string& hvcPath, GlobalTable& outGlobals,
                                    std::vector<ClosureImportRef>* outRefs) {
     auto globalsDataOpt = readGlobalsFromHvc(hvcPath);
     if (!globalsDataOpt) return false;
@@ -6356,21 +6659,14 @@ Value VM::loadScript(const std::string &path) {
     COMPILER_THROW("load: script " + path + " has no __main__ function");
   }
 
-  while (!stack.empty())
-    stack.pop();
+  stack.clear();
   locals.clear();
   frame_count_ = 0;
-  open_upvalues.clear();
+  discardOpenUpvalues();
   has_current_exception_ = false;
   current_exception_ = nullptr;
 
-  if (frame_arena_.size() <= frame_count_) {
-    frame_arena_.push_back(
-        CallFrame{entry, chunk.get(), 0, 0, 0, false, {}, {}, 0, {}});
-  } else {
-    frame_arena_[frame_count_] =
-        CallFrame{entry, chunk.get(), 0, 0, 0, false, {}, {}, 0, {}};
-  }
+  frame_arena_.place(frame_count_, CallFrame{entry, chunk.get(), 0, 0, 0, false});
   frame_count_++;
   locals.resize(entry->local_count);
 
@@ -6435,6 +6731,7 @@ Value VM::loadScript(const std::string &path) {
 }
 
 Value VM::runInContext(const std::string &source, Value context) {
+  auto parked_env = parkModuleEnv();
   globals_stack_.push_back(globals);
   auto old_mirror_id = globals_mirror_object_id_;
   Value old_g = globals["_G"];
@@ -6450,6 +6747,7 @@ Value VM::runInContext(const std::string &source, Value context) {
     globals["_G"] = context;
   } else {
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     throwError("runInContext: context must be null or object");
     return Value::makeNull();
   }
@@ -6461,12 +6759,14 @@ Value VM::runInContext(const std::string &source, Value context) {
   } catch (const ::havel::LexError &) {
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     return Value::makeNull();
   } catch (const ::havel::parser::ParseError &) {
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     return Value::makeNull();
@@ -6474,6 +6774,7 @@ Value VM::runInContext(const std::string &source, Value context) {
   if (!program || parser.hasErrors()) {
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     return Value::makeNull();
@@ -6488,6 +6789,7 @@ Value VM::runInContext(const std::string &source, Value context) {
   } catch (const std::exception &) {
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     return Value::makeNull();
@@ -6495,6 +6797,7 @@ Value VM::runInContext(const std::string &source, Value context) {
   if (!chunk) {
     globals = std::move(globals_stack_.back());
     globals_stack_.pop_back();
+    unparkModuleEnv(std::move(parked_env));
     globals["_G"] = old_g;
     globals_mirror_object_id_ = old_mirror_id;
     return Value::makeNull();
@@ -6504,6 +6807,7 @@ Value VM::runInContext(const std::string &source, Value context) {
 
   globals = std::move(globals_stack_.back());
   globals_stack_.pop_back();
+  unparkModuleEnv(std::move(parked_env));
   globals["_G"] = old_g;
   globals_mirror_object_id_ = old_mirror_id;
 
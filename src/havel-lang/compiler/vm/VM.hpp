@@ -20,6 +20,8 @@
 
 #include "../core/BytecodeIR.hpp"
 #include "../gc/GC.hpp"
+#include "GlobalTable.hpp"
+#include "ValueStack.hpp"
 #include "VMImage.hpp"
 #include "../../runtime/HostContext.hpp"
 #include "../../runtime/ModuleLoader.hpp"
@@ -176,15 +178,24 @@ struct VMConfig {
     bool gc_stop_the_world = true;
     size_t gc_full_collection_interval = 8;
     uint8_t gc_promotion_age = 2;
+    // Threads that trace a stop-the-world collection, including the VM
+    // thread. 0 or 1 keeps marking on the VM thread.
+    size_t gc_mark_threads = 0;
 
     // Call / stack limits
     size_t max_call_depth = 16384;
     size_t max_stack_depth = 1 << 20;
+    // Values reserved up front for the operand stack and for locals, so
+    // ordinary recursion depths never reallocate either one.
+    size_t stack_reserve = 4096;
     uint64_t max_instructions = 0;
 
-    // Scheduler / goroutine
+    // Scheduler / goroutine. A quantum ends at the instruction budget for
+    // the goroutine's priority or after goroutine_tick_micros, whichever
+    // comes first (0 = no time bound).
     uint64_t goroutine_tick_instructions = 10000;
     uint64_t goroutine_hotkey_tick_instructions = 100000;
+    uint64_t goroutine_tick_micros = 2000;
 
     // Tiering (JIT)
     bool tiering_enabled = false;
@@ -195,6 +206,11 @@ struct VMConfig {
     // JIT Debug
     bool debugJIT = false;
 
+    // Interpreter quickening of hot ADD/SUB/LT/EQ/ARRAY_GET sites. Off while
+    // the JIT tiers are in use, since quickened sites stop recording type
+    // feedback. HAVEL_QUICKEN=0 also turns it off.
+    bool quickening = true;
+
     // Timer check interval (instructions between timer checks)
     size_t timer_check_interval = 1000;
 
@@ -202,7 +218,8 @@ struct VMConfig {
     std::string self_hosted_modules_path;
 };
 
-class __attribute__((visibility("default"))) VM : public BytecodeInterpreter {
+class __attribute__((visibility("default"))) VM : public BytecodeInterpreter,
+                                               public RootSource {
 public:
 // Timer check callback - called periodically during script execution
 using TimerCheckFunction = std::function<void()>;
@@ -270,51 +287,110 @@ private:
     size_t stack_depth = 0;
   };
 
+// Try handlers and deferred closures live in side stacks of the frame arena
+// (see FrameArena); a frame only records its slice of each, so pushing or
+// reusing a frame never allocates.
 struct CallFrame {
   const BytecodeFunction *function = nullptr;
   const BytecodeChunk *chunk = nullptr;
   size_t ip = 0;
   size_t locals_base = 0;
   uint32_t closure_id = 0;
-  bool owns_globals = false;
-  // Module-global keys this frame (or a same-module callee) wrote and
-  // persisted to the shared module_globals map. On return, these keys are
-  // copied from the shared map into the caller's restored globals copy so
-  // nested same-module writes are not lost (see doReturn refresh).
-  std::vector<std::string> written_globals;
-  std::vector<TryHandler> try_stack;
+  bool owns_globals = false; // Entered a module env; doReturn leaves it
   size_t stack_depth = 0; // Expression stack depth at call time
-  std::vector<Value> defer_stack; // Deferred closures to execute on scope exit
+  uint32_t try_base = 0;
+  uint32_t try_count = 0;
+  uint32_t defer_base = 0;
+  uint32_t defer_count = 0;
+};
+
+// Call frames plus the side stacks their try handlers and defers occupy.
+// Frame i's slices start where frame i-1's end (fixed when frame i pushes
+// its first entry), so only the top frame grows its slices and the side
+// stacks only allocate when a deeper nesting than ever before is reached.
+// The arena is copied and restored as a whole by re-entrant calls and fiber
+// switches, which keeps the side stacks with the frames that index them.
+struct FrameArena {
+  std::vector<CallFrame> frames;
+  std::vector<TryHandler> tries;
+  std::vector<Value> defers;
+
+  size_t size() const { return frames.size(); }
+  void push_back(CallFrame frame) { frames.push_back(std::move(frame)); }
+  void resize(size_t n) { frames.resize(n); }
+  CallFrame &operator[](size_t i) { return frames[i]; }
+  const CallFrame &operator[](size_t i) const { return frames[i]; }
+
+  // Stores `frame` at `index` with empty slices starting just past those
+  // of the frame below. Reuses the slot when the arena already has it.
+  CallFrame &place(size_t index, CallFrame frame) {
+    frame.try_base = frame.defer_base = 0;
+    frame.try_count = frame.defer_count = 0;
+    if (index > 0) {
+      const CallFrame &below = frames[index - 1];
+      frame.try_base = below.try_base + below.try_count;
+      frame.defer_base = below.defer_base + below.defer_count;
+    }
+    if (index >= frames.size()) {
+      frames.resize(index + 1);
+    }
+    frames[index] = frame;
+    return frames[index];
+  }
+  void pushTry(size_t index, const TryHandler &handler) {
+    CallFrame &frame = frames[index];
+    const size_t slot = frame.try_base + frame.try_count++;
+    if (slot >= tries.size()) {
+      tries.resize(slot + 1);
+    }
+    tries[slot] = handler;
+  }
+  void pushDefer(size_t index, const Value &fn) {
+    CallFrame &frame = frames[index];
+    const size_t slot = frame.defer_base + frame.defer_count++;
+    if (slot >= defers.size()) {
+      defers.resize(slot + 1);
+    }
+    defers[slot] = fn;
+  }
+  const TryHandler &topTry(const CallFrame &frame) const {
+    return tries[frame.try_base + frame.try_count - 1];
+  }
 };
   public:
 
-  std::stack<Value> stack;
+  ValueStack stack;
   std::vector<Value> locals;
-  std::vector<CallFrame> frame_arena_;
+  FrameArena frame_arena_;
  size_t frame_count_ = 0;
  int bc_execute_depth_ = 0;
  GCHeap heap_;
-  std::unordered_map<uint32_t, std::shared_ptr<GCHeap::UpvalueCell>>
-      open_upvalues;
-    std::unordered_map<std::string, Value> globals;
+  // Open cells sorted by absolute local index. Captures come from the top
+  // frame, so inserts and the closes at return happen at the tail.
+  std::vector<GCHeap::UpvalueCell *> open_upvalues;
+    GlobalTable globals;
     mutable std::shared_mutex globals_mutex_; // Thread-safe access to globals
     std::unordered_set<std::string> immutable_globals_; // val-declared globals
     std::unordered_set<uint32_t> immutable_locals_; // val-declared local indices (per-frame)
   utils::RobinHoodHashMap<std::string, BytecodeHostFunction> host_functions;
   std::vector<std::string> host_function_names_; // Index -> name mapping
+  std::vector<HostFunctionEntry> host_function_table_; // Index -> fast-call entry
   std::unordered_set<uint32_t> host_function_wants_self_; // Host function indices whose first param is "self"
 utils::RobinHoodHashMap<std::string, Value> host_function_globals_; // Name -> HostFuncId Value
+  // Bumped by setHostFunctionGlobal; LOAD_GLOBAL host hits are valid only
+  // while it is unchanged (a rebind keeps the map size the same).
+  uint64_t host_globals_version_ = 1;
   std::unordered_map<std::string, uint64_t> host_function_gc_roots_; // Name -> pinned GC root ID
   std::unordered_map<std::string, uint64_t> module_cache_gc_roots_; // Module key -> pinned GC root for cached exports
   // Persistent class registry: class name -> class prototype object
   // Survives globals map changes (execute_persistent, function calls, etc.)
   std::unordered_map<std::string, Value> class_registry_;
-  std::vector<std::shared_ptr<std::unordered_map<std::string, Value>>> imported_module_globals_; // GC root for wrapped module functions
+  std::vector<ModuleGlobals> imported_module_globals_; // GC root for wrapped module functions
   // Spawn-time globals snapshot per goroutine closure id. Restored in
   // startGoroutineCall so a goroutine's first run resolves globals against
   // the module scope that was active at spawn, not whatever map is ambient
   // at first-pick (module-cache fixup may reassign the closure's module_globals).
-  std::unordered_map<uint32_t, std::shared_ptr<std::unordered_map<std::string, Value>>> spawn_globals_snapshot_;
+  std::unordered_map<uint32_t, ModuleGlobals> spawn_globals_snapshot_;
 
    
         // Function properties support (fn.prop = value for static state, memoization, etc.)
@@ -326,6 +402,10 @@ utils::RobinHoodHashMap<std::string, Value> host_function_globals_; // Name -> H
 
         bool has_current_exception_ = false;
   Value current_exception_ = nullptr;
+  // Frame depth a script throw stops unwinding at. callPrepared raises it to
+  // its base depth, so a throw the callback doesn't catch leaves through the
+  // host loop as a ScriptThrow instead of resuming a handler below it.
+  size_t throw_floor_ = 0;
 
     // Module exports for END_MODULE opcode
     Value module_exports_;
@@ -369,7 +449,14 @@ std::unordered_map<std::string, std::string> module_resolution_cache_;
 // init functions are called on first use (import/access)
 std::unordered_map<std::string, ModuleDescriptor> lazy_modules_;
 
-    std::vector<std::unordered_map<std::string, Value>> globals_stack_;
+    std::vector<GlobalTable> globals_stack_;
+    ModuleGlobals active_env_; // Env whose contents are in `globals`
+    std::vector<ModuleGlobals> env_stack_; // Envs active before each enter
+    // env_stack_ depth the running fiber entered its module envs above, and
+    // whether they are in place (set when a fiber starts or is loaded,
+    // cleared when saveFiberState leaves them).
+    size_t fiber_env_base_ = 0;
+    bool fiber_envs_live_ = false;
  std::unordered_map<std::string, Value> rootGlobals_;
 
   // ObjectId of the _G heap object; UINT32_MAX = unset.
@@ -455,6 +542,9 @@ class EventQueue* event_queue_ = nullptr;
   std::unordered_map<std::string,
   std::unordered_map<std::string, uint32_t>>
   prototypes_;
+  // Bumped on every prototypes_ write; CALL_METHOD cache ways that
+  // resolved through the table check it.
+  uint64_t prototype_epoch_ = 1;
 
   // Method overloading tracker (maps classObjId.methodName -> list of candidate function values)
   std::unordered_map<std::string, std::vector<Value>> overloaded_methods_;
@@ -487,6 +577,19 @@ int32_t pending_call_return_ip_ = -1;
     bool trace_execution_ = false;
     std::array<uint64_t, 256> opcode_counts_{};
     uint64_t executed_instructions_ = 0;
+    // Fallthrough opcode pairs (first * 256 + second) seen while profiling,
+    // kept for the VM's lifetime. Superinstruction heads are counted as the
+    // opcode they replaced. HAVEL_OPCODE_PAIRS=<n> enables profiling and
+    // prints the top n pairs on shutdown.
+    std::unordered_map<uint16_t, uint64_t> opcode_pair_counts_;
+    const BytecodeFunction *profile_prev_function_ = nullptr;
+    uint32_t profile_prev_ip_ = 0;
+    uint64_t opcode_pair_report_ = 0;
+    // Instructions covered by a superinstruction head, i.e. dispatches the
+    // threaded loop saves over the profiled (one-at-a-time) run.
+    uint64_t fused_dispatches_saved_ = 0;
+    void recordOpcodeProfile(const BytecodeFunction *function, uint32_t ip,
+                             OpCode opcode);
     uint64_t max_instructions_ = 0; // 0 = no limit
 
     // System object initializer - called after registerDefaultHostGlobals()
@@ -521,11 +624,12 @@ int32_t pending_call_return_ip_ = -1;
   CallFrame &currentFrame();
   Value getConstant(uint32_t index);
 
-  // State snapshot for re-entrant calls (HOF callbacks)
+  // State snapshot for re-entrant calls (HOF callbacks). The stack starts
+  // without a block so saving allocates only the live depth.
   struct ExecutionState {
-    std::stack<Value> stack;
+    ValueStack stack{0};
     std::vector<Value> locals;
-    std::vector<CallFrame> frames;
+    FrameArena frames;
     size_t frame_count = 0;
   };
   ExecutionState saveState() const;
@@ -546,21 +650,115 @@ int32_t pending_call_return_ip_ = -1;
   void processPendingCalls();
   Value callFunctionSync(const Value &fn,
                                  const std::vector<Value> &args);
+  uint32_t closureForFunctionObj(uint32_t function_index,
+                                 const BytecodeChunk *&chunk);
+  // Closures closureForFunctionObj made, reused while they are alive so a
+  // FunctionObjId call does not allocate one per call. Entries are weak: a
+  // hit is checked against the closure it names (slab ids are reused once
+  // swept) and handed to GCHeap::retainCachedClosure before reuse.
+  struct FunctionObjClosureKey {
+    const BytecodeChunk *chunk;
+    const GlobalTable *globals;
+    uint32_t function_index;
+    bool operator==(const FunctionObjClosureKey &o) const {
+      return chunk == o.chunk && globals == o.globals &&
+             function_index == o.function_index;
+    }
+  };
+  struct FunctionObjClosureKeyHash {
+    size_t operator()(const FunctionObjClosureKey &k) const {
+      return std::hash<const void *>{}(k.chunk) ^
+             (std::hash<const void *>{}(k.globals) << 1) ^
+             (static_cast<size_t>(k.function_index) * 0x9e3779b97f4a7c15ULL);
+    }
+  };
+  std::unordered_map<FunctionObjClosureKey, uint32_t, FunctionObjClosureKeyHash>
+      function_obj_closures_;
+  // Dead entries are dropped when the cache doubles past this size.
+  size_t function_obj_closures_prune_at_ = 64;
   void executeInstruction(const Instruction &instruction);
+  // The opcode switch without executeInstruction's per-call chunk resync;
+  // for callers (the threaded loop) that keep current_chunk in step.
+  void dispatchInstruction(const Instruction &instruction);
+  GlobalCacheEntry *globalCacheEntry(const Instruction &instruction);
+  // Shape inline caches for OBJECT_GET/OBJECT_SET/CALL_METHOD (see
+  // PropertyInlineCache). The *FromCache helpers perform the operation and
+  // return true on a hit; the fill helpers record a slow-path resolution.
+  struct MethodTarget {
+    bool host = false;
+    uint32_t host_index = 0;
+    Value function = Value::makeNull();
+    bool instance_func = false;
+    bool via_module = false;
+    bool missing = false; // resolves to nothing: the call yields null
+  };
+  PropertyInlineCache *propertyCache(const Instruction &instruction,
+                                     size_t operand);
+  bool objectGetFromCache(PropertyInlineCache &ic, const Value &object,
+                          const Value &key);
+  void fillObjectGetCache(PropertyInlineCache &ic,
+                          const GCHeap::ObjectEntry &obj, const Value &key,
+                          const std::string &key_name);
+  bool objectSetFromCache(PropertyInlineCache &ic, const Value &object,
+                          const Value &key, const Value &value);
+  void fillObjectSetCache(PropertyInlineCache &ic,
+                          const GCHeap::ObjectEntry &obj,
+                          const std::shared_ptr<ObjectShape> &shape_before,
+                          const Value &key, const std::string &key_name);
+  // True when something listens for VAR_CHANGED, so OBJECT_SET has to take
+  // the path that reports the write.
+  bool variableChangesObserved() const;
+  bool methodFromCache(PropertyInlineCache &ic, const Value &receiver,
+                       MethodTarget &target);
+  const GCHeap::ObjectEntry *
+  cachedHolder(const PropertyInlineCache::Way &way,
+               const GCHeap::ObjectEntry *receiver) const;
+  bool recordPrototypePath(PropertyInlineCache::Way &way,
+                           const GCHeap::ObjectEntry &receiver,
+                           const std::string &key, bool method_chain) const;
+  static uint8_t methodReceiverTag(const Value &receiver);
+  bool propertyCacheKey(const Value &key) const;
 
   // Inline stack helper declarations - extracted from executeInstruction lambdas
-  Value popStack();
-  void pushStack(Value value);
+  Value popStack() {
+    if (stack.empty()) [[unlikely]] {
+      stackUnderflow();
+    }
+    return stack.popValue();
+  }
+  void pushStack(Value value) {
+    if (stack.full()) [[unlikely]] {
+      growStack();
+    }
+    stack.push(value);
+  }
+  [[noreturn]] void stackUnderflow();
+  void growStack();
   uint32_t toAbsoluteLocal(uint32_t local_index);
   void ensureLocalIndex(uint32_t absolute_index);
   void doReturn();
 
   // Extracted opcode handlers to reduce stack frame size
   void execBinaryOp(const Instruction &instruction);
+  // Quickening. noteQuickenSite counts how long a generic site keeps seeing
+  // operands that fit one quickened form and rewrites it once that is
+  // stable. execQuickened runs a quickened instruction on the two values on
+  // top of the stack; on a guard miss it restores the generic opcode in
+  // place, leaves the stack untouched and returns false.
+  bool quickeningActive() const {
+    return quickening_enabled_ && !tiering_enabled_ && !hot_func_cb_;
+  }
+  TypeFeedback *quickenFeedback(const Instruction &instruction);
+  void noteQuickenSite(const Instruction &instruction, const Value &left,
+                       const Value &right);
+  bool execQuickened(const Instruction &instruction);
   void execLogicalOp(OpCode opcode);
   void execNegate();
   void execJump(const Instruction &instruction);
   void execJumpIfFalse(const Instruction &instruction);
+  // The threaded JUMP_IF_FALSE handlers, plain and fused, count a taken
+  // back edge before the jump; call with the condition on top of the stack.
+  void recordJumpIfFalseBackedge(const Instruction &instruction);
 	void execJumpIfTrue(const Instruction &instruction);
 	bool execCollectionOp(const Instruction &instruction);
 	bool execConcurrencyOp(const Instruction &instruction);
@@ -569,6 +767,36 @@ int32_t pending_call_return_ip_ = -1;
 
   void doCall(Value callee_value, std::vector<Value> args);
   void doTailCall(Value callee_value, std::vector<Value> args);
+
+  // Coroutine switching. A coroutine owns its locals and operand stack;
+  // entering parks the resumer's (returning to `return_ip`) in a
+  // CallerFrame and swaps the coroutine's in, leaving (yield, sleep,
+  // return) swaps them back. Both are O(1) in stack depth and locals.
+  void enterCoroutine(GCHeap::Coroutine &co, uint32_t co_id,
+                      uint32_t return_ip);
+  void leaveCoroutine(GCHeap::Coroutine &co);
+
+  // Module environments. While a module's code runs its env is "active":
+  // its contents live in `globals` and the shared table holds only the
+  // moved-from husk. Entering another env moves the active one back home
+  // (or parks non-module globals on globals_stack_), so at most one env is
+  // ever out of place and nothing is copied.
+  void enterModuleEnv(const ModuleGlobals &env);
+  void leaveModuleEnv();
+  void switchModuleEnv(const ModuleGlobals &env);
+  // Contents of an env as currently visible, whether or not it is active.
+  const GlobalTable &moduleEnvContents(const ModuleGlobals &env) const {
+    return env == active_env_ ? globals : *env;
+  }
+  // Sandboxed runs (module load, runInContext) replace `globals` wholesale;
+  // park the active env at home first so code they call can still enter it.
+  ModuleGlobals parkModuleEnv();
+  void unparkModuleEnv(ModuleGlobals parked);
+  // The deepWrapModuleFunctions wrappers hand their caller back its own
+  // _G. Leaving an entered env restores the caller's table whole, but a
+  // callee that shares the caller's env may rebind _G in place.
+  std::optional<Value> saveGlobalObjectBinding() const;
+  void restoreGlobalObjectBinding(const std::optional<Value> &saved);
   void packVariadicArgs(std::vector<Value> &args, const BytecodeFunction *callee);
   void runDispatchLoop(size_t stop_frame_depth);
   void runDispatchFast(size_t stop_frame_depth);
@@ -586,6 +814,17 @@ inline void periodicYieldCheck() {
   bool handleScriptThrow(const Value &value);
   std::string buildStackTrace(size_t frame_count) const;
   void closeFrameUpvalues(uint32_t locals_base, uint32_t locals_end);
+  // Open cell for local `open_index` of the current frame, shared with any
+  // closure that already captured it.
+  GCHeap::UpvalueCell *captureLocal(uint32_t open_index);
+  // Drops the open list without closing its cells (fresh execution).
+  void discardOpenUpvalues();
+
+  // Per-frame try handlers and defers in the frame arena's side stacks.
+  void pushTryHandler(const TryHandler &handler);
+  void pushDefer(const Value &fn);
+  // Runs and pops the top frame's defers newest-first, swallowing errors.
+  void runFrameDefers();
 
   // Source location helper for error messages
   std::string currentSourceLocation() const;
@@ -602,8 +841,9 @@ inline void periodicYieldCheck() {
                        std::unordered_set<uint64_t> &visited_object_pairs) const;
 
 
-  std::vector<Value> stackValuesForRoots() const;
-  std::vector<uint32_t> activeClosureIdsForRoots() const;
+  // RootSource: everything the VM keeps alive, visited in place.
+  void visitRoots(RootVisitor &visitor) const override;
+  std::optional<Value> openLocal(uint32_t index) const override;
     void maybeCollectGarbage();
     void collectGarbage();
     void stepGarbageCollection(size_t work_budget = 128);
@@ -612,6 +852,30 @@ inline void periodicYieldCheck() {
     void registerDefaultHostGlobals();
     void registerDefaultPrototypes();
   Value invokeHostFunction(const std::string &name, uint32_t arg_count);
+  // Fast-call dispatch by HostFuncId. Call sites copy at most
+  // kHostInlineArgs arguments off the operand stack into a local buffer, so
+  // the call allocates nothing and callbacks are free to grow the stack.
+  static constexpr uint32_t kHostInlineArgs = 8;
+  const HostFunctionEntry *hostEntry(uint32_t index) const {
+    return index < host_function_table_.size() && host_function_table_[index].call
+               ? &host_function_table_[index]
+               : nullptr;
+  }
+  Value callHostEntry(uint32_t index, HostArgs args);
+  // doCall's host path: call, push the result, then collect and propagate
+  // any suspension the callee requested.
+  void pushHostResult(uint32_t index, HostArgs args);
+  // CALL with a host callee: pops the callee and its `arg_count` arguments
+  // without building a vector.
+  void callHostFromStack(uint32_t index, uint32_t arg_count);
+  // CALL with a function or closure callee: copies the arguments straight
+  // from the operand stack into the new frame's locals. Returns false,
+  // having changed nothing, for callees that need doCall (generators,
+  // variadics, kwargs, JIT-compiled functions, an attached debugger).
+  bool callScriptFromStack(uint32_t arg_count);
+  uint32_t installHostFunction(const std::string &name,
+                               BytecodeHostFunction by_name,
+                               HostFunctionEntry entry);
 
 public:
     // Value utility functions (public for prototype method implementations and JIT bridges)
@@ -621,6 +885,15 @@ public:
     bool valuesEqualDeepPublic(const Value &left, const Value &right) const { return valuesEqualDeep(left, right); }
     Value callFunctionSyncPublic(const Value &fn, const std::vector<Value> &args) { return callFunctionSync(fn, args); }
     std::optional<std::string> resolveKeyPublic(const Value &value) const { return resolveKey(value); }
+    // Set members. Chunk string constants are resolved before reaching
+    // GCHeap::setMember / findSetMember; setAdd and setRemove also run the
+    // write barrier and bump the set version, and report whether the set
+    // changed.
+    Value setMember(const Value &value);
+    std::optional<Value> findSetMember(const Value &value) const;
+    bool setHas(uint32_t set_id, const Value &value) const;
+    bool setAdd(uint32_t set_id, const Value &value);
+    bool setRemove(uint32_t set_id, const Value &value);
     void pushStackPublic(Value value) { pushStack(std::move(value)); }
     Value popStackPublic() { return popStack(); }
     void loadFiberStatePublic(Fiber* fiber) { loadFiberState(fiber); }
@@ -663,14 +936,14 @@ public:
   }
     void pushFramePublic(const BytecodeFunction* function, size_t ip, size_t locals_base, uint32_t closure_id) {
         if (frame_count_ >= frame_arena_.size()) {
- frame_arena_.push_back(CallFrame{function, nullptr, ip, locals_base, closure_id, false, {}, {}, 0, {}});
+ frame_arena_.push_back(CallFrame{function, nullptr, ip, locals_base, closure_id, false});
  } else {
- frame_arena_[frame_count_] = CallFrame{function, nullptr, ip, locals_base, closure_id, false, {}, {}, 0, {}};
+ frame_arena_[frame_count_] = CallFrame{function, nullptr, ip, locals_base, closure_id, false};
         }
         frame_count_++;
     }
   size_t currentLocalsSizePublic() const { return locals.size(); }
-  std::unordered_map<uint32_t, std::shared_ptr<GCHeap::UpvalueCell>>& openUpvaluesPublic() { return open_upvalues; }
+  GCHeap::UpvalueCell *captureLocalPublic(uint32_t open_index) { return captureLocal(open_index); }
   void doTailCallPublic(Value callee_value, std::vector<Value> args) {
     doTailCall(std::move(callee_value), std::move(args));
   }
@@ -690,13 +963,12 @@ public:
   size_t frameCountPublic() const { return frame_count_; }
   void tryEnterPublic(uint32_t catch_ip, uint32_t finally_ip,
                       size_t stack_depth) {
-    currentFrame().try_stack.push_back(
-        TryHandler{.catch_ip = catch_ip,
-                   .finally_ip = finally_ip,
-                   .finally_return_ip = 0,
-                   .stack_depth = stack_depth});
+    pushTryHandler(TryHandler{.catch_ip = catch_ip,
+                              .finally_ip = finally_ip,
+                              .finally_return_ip = 0,
+                              .stack_depth = stack_depth});
   }
-  void tryExitPublic() { if (!currentFrame().try_stack.empty()) currentFrame().try_stack.pop_back(); }
+  void tryExitPublic() { if (currentFrame().try_count > 0) currentFrame().try_count--; }
   Value currentExceptionPublic() const { return has_current_exception_ ? current_exception_ : Value::makeNull(); }
   bool hasCurrentExceptionPublic() const { return has_current_exception_; }
     void setCurrentExceptionPublic(const Value& v) { has_current_exception_ = true; current_exception_ = v; }
@@ -921,8 +1193,32 @@ enum class GoroutineCallResult { Failed, Interpreter, JITExecuted };
   
   Value call(const Value &callee_value,
              const std::vector<Value> &args = {});
+
+  // A callee resolved once for repeated invocation from native loops (the
+  // array intrinsics and prototype methods). Bytecode callees are entered
+  // by pushing their frame directly; host functions, generators, variadic
+  // and JIT-compiled callees fall back to callFunctionSync. The closure
+  // stays pinned for as long as the PreparedCall lives.
+  struct PreparedCall {
+    Value fn = Value::makeNull();
+    GCRoot root;
+    const BytecodeFunction *function = nullptr;
+    const BytecodeChunk *chunk = nullptr;
+    uint32_t closure_id = 0;
+    ModuleGlobals globals;
+    bool direct = false;
+
+    bool callable() const { return !fn.isNull(); }
+  };
+  // Returns a PreparedCall with callable() == false if `fn` is not a
+  // function, closure or host function.
+  PreparedCall prepareCall(const Value &fn);
+  Value callPrepared(const PreparedCall &call, HostArgs args);
   std::string toString(const Value &value);
   const std::string* getStringPtr(const Value &value) const;
+  // Codepoint index of a string value. Long heap strings use the heap's
+  // cached index; anything else is indexed into `scratch`.
+  const Utf8Index &utf8Index(const Value &value, Utf8Index &scratch);
   bool toBoolPublic(const Value &value);
   void setDebugMode(bool enabled) override;
 
@@ -984,6 +1280,10 @@ enum class GoroutineCallResult { Failed, Interpreter, JITExecuted };
                             BytecodeHostFunction function) override;
   void registerHostFunction(const std::string &name, size_t arity,
                             BytecodeHostFunction function);
+  // Fast-call ABI registration (see HostArgs). A non-negative arity is
+  // checked by the VM, so the function can index args without testing.
+  void registerFastHostFunction(const std::string &name,
+                                HostFastFunction function, int32_t arity = -1);
   bool hasHostFunction(const std::string &name) const override;
   
   
@@ -1097,6 +1397,20 @@ void setJITCompiler(std::unique_ptr<JITCompiler> jit) { jit_compiler_ = std::mov
     uint64_t opcodeCount(OpCode opcode) const {
         return opcode_counts_[static_cast<uint8_t>(opcode)];
     }
+    uint64_t opcodePairCount(OpCode first, OpCode second) const;
+    std::string opcodePairReport(size_t limit) const;
+    // Per-site OBJECT_GET/OBJECT_SET/CALL_METHOD inline-cache counters for
+    // every site that has run, across loaded chunks (debug.inlineCaches()).
+    struct InlineCacheSiteStats {
+        std::string function;
+        uint32_t ip = 0;
+        OpCode opcode = OpCode::NOP;
+        PropertyInlineCache::State state = PropertyInlineCache::State::Empty;
+        uint32_t ways = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+    std::vector<InlineCacheSiteStats> inlineCacheStats() const;
 
 void setGcAllocationBudget(size_t value) { heap_.setAllocationBudget(value); }
 void runGarbageCollection() { collectGarbage(); }
@@ -1168,6 +1482,10 @@ uint64_t getHeapMaxBytes() const { return heap_.heapMaxBytes(); }
   ObjectRef createHostObject();
   ArrayRef createHostArray();
   StringRef createRuntimeString(std::string value);
+  // String concatenation for ADD and STRING_CONCAT. Operands that aren't
+  // strings are converted with toString(). Long results are ropes (see
+  // GCHeap::concatStrings).
+  Value concatStrings(Value left, Value right);
   size_t getRuntimeStringLength(StringRef string_ref);
   void setHostObjectField(ObjectRef object_ref, const std::string &key,
                           Value value);
@@ -1309,6 +1627,8 @@ const std::vector<Value> &args);
                       const uint8_t *data);
   VMImage createImageFromRGBA(int width, int height,
                               const std::vector<uint8_t> &rgbaData);
+  VMImage createImageFromRGBA(int width, int height,
+                              std::vector<uint8_t> &&rgbaData);
 
   // ============================================================================
   // Execution Context System - Isolated execution with shared globals
@@ -1320,7 +1640,7 @@ const std::vector<Value> &args);
   getGlobalThreadSafe(const std::string &name) const;
 
   // Get all globals (for module export collection)
-  const std::unordered_map<std::string, Value> &getAllGlobals() const { return globals; }
+  const std::unordered_map<std::string, Value> &getAllGlobals() const { return globals.map(); }
 
     // Get _G as object (for module exports)
     Value getGlobalObject() {
@@ -1336,7 +1656,7 @@ const std::vector<Value> &args);
     Value deepMaterializeStrings(Value value, const BytecodeChunk* chunk);
 Value deepMaterializeStrings(Value value, const BytecodeChunk* chunk, std::unordered_set<uint32_t>& visited);
   Value deepWrapModuleFunctions(Value value, std::shared_ptr<BytecodeChunk> chunk,
-                                std::shared_ptr<std::unordered_map<std::string, Value>> moduleGlobals,
+                                ModuleGlobals moduleGlobals,
                                 const std::string& canonicalKey, const std::string& fieldPath,
                                 int depth = 0, std::unordered_set<uint32_t>* visited = nullptr);
 
@@ -1358,7 +1678,7 @@ Value loadModule(const std::string& path);
                                                               std::vector<ClosureImportRef>* outRefs = nullptr);
     void writeGlobalsToHvc(const std::string& hvcPath, const std::vector<uint8_t>& globalsData);
     std::optional<std::vector<uint8_t>> readGlobalsFromHvc(const std::string& hvcPath);
-    bool deserializeGlobalsFromHvc(const std::string& hvcPath, std::unordered_map<std::string, Value>& outGlobals,
+    bool deserializeGlobalsFromHvc(const std::string& hvcPath, GlobalTable& outGlobals,
                                    std::vector<ClosureImportRef>* outRefs = nullptr);
     void registerLazyModule(const std::string &name, std::function<void(struct VMApi&)> initFn, const std::vector<std::string> &aliases = {});
   bool ensureModuleLoaded(const std::string &name);
@@ -1386,10 +1706,13 @@ bool isLazyModuleLoaded(const std::string &name) const;
         current_chunk = main_chunk_.get();
     }
  const std::shared_ptr<BytecodeChunk>& getMainChunk() const { return main_chunk_; }
-  std::unordered_map<std::string, Value>& getGlobals() { return globals; }
-  const std::unordered_map<std::string, Value>& getGlobals() const { return globals; }
-  auto& hostFunctionGlobals() { return host_function_globals_; }
+  GlobalTable& getGlobals() { return globals; }
+  const GlobalTable& getGlobals() const { return globals; }
   const auto& hostFunctionGlobals() const { return host_function_globals_; }
+  void setHostFunctionGlobal(const std::string &name, Value value) {
+    host_function_globals_[name] = value;
+    ++host_globals_version_;
+  }
   bool hasGlobalPublic(const std::string &name) const { return globals.find(name) != globals.end(); }
   bool isHostFunctionGlobal(const std::string &name) const { return host_function_globals_.find(name) != host_function_globals_.end(); }
     void storeReplChunk(std::shared_ptr<BytecodeChunk> chunk) {
@@ -1445,6 +1768,7 @@ private:
     HotFunctionCallback hot_func_cb_;
     std::unique_ptr<JITCompiler> jit_compiler_;
     bool tiering_enabled_ = false;
+    bool quickening_enabled_ = true;
     uint64_t tier1_threshold_ = 1000;
     uint64_t tier2_threshold_ = 10000;
     std::unordered_set<std::string> tier1_compiled_;
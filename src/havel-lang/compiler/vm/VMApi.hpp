@@ -10,8 +10,10 @@
 #include <vector>
 #include <utility>
 #include <functional>
+#include <span>
 #include <chrono>
 #include <thread>
+#include <type_traits>
 
 namespace havel::host {
 class ServiceRegistry;
@@ -21,6 +23,17 @@ namespace havel::compiler {
 
 using Value = ::havel::core::Value;
 
+namespace detail {
+// True when F has a single, non-template call operator (or is not a class,
+// e.g. a function pointer). Generic lambdas such as `(const auto &args)` are
+// not: probing them with HostArgs would deduce a span for code written
+// against the vector ABI, so registerFunction keeps them on that ABI.
+template <typename F, typename = void>
+struct HasPlainCallOperator : std::bool_constant<!std::is_class_v<F>> {};
+template <typename F>
+struct HasPlainCallOperator<F, std::void_t<decltype(&F::operator())>> : std::true_type {};
+} // namespace detail
+
 struct VMApi {
   VM *vm_;
   ::havel::host::ServiceRegistry* serviceRegistry = nullptr;
@@ -167,10 +180,30 @@ struct VMApi {
             return (uint32_t)vm().getHostArrayLength(havel::compiler::ArrayRef{arr.asArrayId()});
         } else if (arr.isStringId()) {
             return (uint32_t)vm().getRuntimeStringLength(havel::compiler::StringRef{arr.asStringId()});
+        } else if (arr.isBytesId()) {
+            auto *b = vm().getHeap().bytes(arr.asBytesId());
+            return b ? (uint32_t)b->size() : 0;
         }
         return 0;
     }
 
+    // Byte buffers. makeBytes takes ownership of the vector; bytes() views the
+    // live storage of a buffer (empty for anything else), so modules can read
+    // or fill it without copying. The span is only valid while the buffer is
+    // reachable from script, an argument or a root.
+    Value makeBytes(std::vector<uint8_t> data) const {
+        return Value::makeBytesId(vm().getHeap().allocateBytes(std::move(data)).id);
+    }
+
+    std::span<uint8_t> bytes(Value buf) const {
+        if (!buf.isBytesId())
+            return {};
+        auto *b = vm().getHeap().bytes(buf.asBytesId());
+        if (!b || !b->storage)
+            return {};
+        return {b->data(), b->length};
+    }
+
     Value getAt(Value arr, uint32_t index) const {
         if (!arr.isArrayId())
             return Value::makeNull();
@@ -183,14 +216,45 @@ struct VMApi {
         vm().setHostArrayValue(havel::compiler::ArrayRef{arr.asArrayId()}, index, std::move(value));
     }
 
+    // The calling convention follows the signature of `func`:
+    //   Value(HostArgs)                      fast-call ABI, any arity
+    //   Value(), Value(const Value &), ...   fixed arity (up to 3), arguments
+    //                                        passed unboxed, count checked by the VM
+    //   Value(const std::vector<Value> &)    legacy vector ABI, also used for
+    //                                        generic `(const auto &)` lambdas
     template <typename F>
     void registerFunction(const std::string &name, F func) const {
-        vm().registerHostFunction(name, std::function<Value(const std::vector<Value> &)>(std::move(func)));
+        using V = const Value &;
+        if constexpr (!detail::HasPlainCallOperator<F>::value) {
+            vm().registerHostFunction(name, std::function<Value(const std::vector<Value> &)>(std::move(func)));
+        } else if constexpr (std::is_invocable_r_v<Value, F &, HostArgs>) {
+            vm().registerFastHostFunction(name, HostFastFunction(std::move(func)));
+        } else if constexpr (std::is_invocable_r_v<Value, F &>) {
+            vm().registerFastHostFunction(
+                name, [func = std::move(func)](HostArgs) mutable { return func(); }, 0);
+        } else if constexpr (std::is_invocable_r_v<Value, F &, V>) {
+            vm().registerFastHostFunction(
+                name, [func = std::move(func)](HostArgs a) mutable { return func(a[0]); }, 1);
+        } else if constexpr (std::is_invocable_r_v<Value, F &, V, V>) {
+            vm().registerFastHostFunction(
+                name, [func = std::move(func)](HostArgs a) mutable { return func(a[0], a[1]); }, 2);
+        } else if constexpr (std::is_invocable_r_v<Value, F &, V, V, V>) {
+            vm().registerFastHostFunction(
+                name, [func = std::move(func)](HostArgs a) mutable { return func(a[0], a[1], a[2]); }, 3);
+        } else {
+            vm().registerHostFunction(name, std::function<Value(const std::vector<Value> &)>(std::move(func)));
+        }
     }
 
     template <typename F>
     void registerFunction(const std::string &name, uint32_t arity, F func) const {
-        vm().registerHostFunction(name, arity, std::function<Value(const std::vector<Value> &)>(std::move(func)));
+        if constexpr (detail::HasPlainCallOperator<F>::value &&
+                      std::is_invocable_r_v<Value, F &, HostArgs>) {
+            vm().registerFastHostFunction(name, HostFastFunction(std::move(func)),
+                                          static_cast<int32_t>(arity));
+        } else {
+            vm().registerHostFunction(name, arity, std::function<Value(const std::vector<Value> &)>(std::move(func)));
+        }
     }
 
     Value invoke(Value callee, const std::vector<Value> &args) const {
@@ -215,7 +279,7 @@ struct VMApi {
                                  const std::string &methodName,
                                  uint32_t arity, F func) const {
         std::string fullName = typeName + "." + methodName;
-        vm().registerHostFunction(fullName, arity, std::move(func));
+        registerFunction(fullName, arity, std::move(func));
         vm().registerPrototypeMethodByName(typeName, methodName, fullName);
     }
 
@@ -309,6 +373,11 @@ struct VMApi {
         return vm().createImageFromRGBA(width, height, rgbaData);
     }
 
+    havel::compiler::VMImage createImageFromRGBA(int width, int height,
+                                std::vector<uint8_t> &&rgbaData) const {
+        return vm().createImageFromRGBA(width, height, std::move(rgbaData));
+    }
+
     uint32_t registerEnumType(const std::string &name, const std::vector<std::string> &variants) const {
         return vm().registerEnumType(name, variants);
     }
@@ -3,13 +3,225 @@
 #include "../../../utils/Logger.hpp"
 #include "../../utils/ErrorPrinter.hpp"
 #include "../runtime/RuntimeSupport.hpp"
+#include "../../runtime/concurrency/DependencyTracker.hpp"
 
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <utility>
 
 namespace havel::compiler {
 
+namespace {
+
+// Generic runs with matching operands before a site is quickened, and guard
+// misses after which it is left generic for good.
+constexpr uint16_t kQuickenAfter = 64;
+constexpr uint8_t kMaxQuickenMisses = 4;
+
+bool isNumber(const Value &v) { return v.isInt() || v.isDouble(); }
+double asNumber(const Value &v) {
+  return v.isInt() ? static_cast<double>(v.asInt()) : v.asDouble();
+}
+// Numeric but not both int48: the generic handler does these in f64.
+bool isMixedNumber(const Value &l, const Value &r) {
+  return isNumber(l) && isNumber(r) && !(l.isInt() && r.isInt());
+}
+bool isPlainString(const Value &v) { return v.isStringId() || v.isStringValId(); }
+
+// The quickened form of `op` that these operands fit, or `op` itself.
+OpCode quickenedFor(OpCode op, const Value &left, const Value &right) {
+  const bool ints = left.isInt() && right.isInt();
+  const bool nums = isMixedNumber(left, right);
+  switch (op) {
+  case OpCode::ADD:
+    if (ints) return OpCode::ADD_INT;
+    if (nums) return OpCode::ADD_NUM;
+    if (isPlainString(left) && isPlainString(right)) return OpCode::ADD_STR;
+    break;
+  case OpCode::SUB:
+    if (ints) return OpCode::SUB_INT;
+    if (nums) return OpCode::SUB_NUM;
+    break;
+  case OpCode::LT:
+    if (ints) return OpCode::LT_INT;
+    if (nums) return OpCode::LT_NUM;
+    break;
+  case OpCode::EQ:
+    if (ints) return OpCode::EQ_INT;
+    if (nums) return OpCode::EQ_NUM;
+    if (isPlainString(left) && isPlainString(right)) return OpCode::EQ_STR;
+    break;
+  case OpCode::ARRAY_GET:
+    if (left.isArrayId() && right.isInt()) return OpCode::ARRAY_GET_INT;
+    break;
+  default:
+    break;
+  }
+  return op;
+}
+
+} // namespace
+
+// Quickening state lives in the type feedback slot of the instruction's own
+// index. Instructions that aren't part of the running function (copies made
+// by callers) have no slot and are never quickened.
+TypeFeedback *VM::quickenFeedback(const Instruction &instruction) {
+  if (frame_count_ == 0) return nullptr;
+  const BytecodeFunction *fn = currentFrame().function;
+  if (!fn || fn->instructions.empty()) return nullptr;
+  const Instruction *code = fn->instructions.data();
+  std::less<const Instruction *> before;
+  if (before(&instruction, code) ||
+      !before(&instruction, code + fn->instructions.size())) {
+    return nullptr;
+  }
+  const size_t site = static_cast<size_t>(&instruction - code);
+  return site < fn->type_feedback.size() ? &fn->type_feedback[site] : nullptr;
+}
+
+void VM::noteQuickenSite(const Instruction &instruction, const Value &left,
+                         const Value &right) {
+  switch (instruction.opcode) {
+  case OpCode::ADD: case OpCode::SUB: case OpCode::LT: case OpCode::EQ:
+  case OpCode::ARRAY_GET:
+    break;
+  default:
+    return;
+  }
+  TypeFeedback *fb = quickenFeedback(instruction);
+  if (!fb || fb->quicken_misses >= kMaxQuickenMisses) return;
+  const OpCode quick = quickenedFor(instruction.opcode, left, right);
+  if (quick == instruction.opcode) {
+    fb->quicken_streak = 0;
+    return;
+  }
+  if (fb->quicken_candidate != static_cast<uint8_t>(quick)) {
+    fb->quicken_candidate = static_cast<uint8_t>(quick);
+    fb->quicken_streak = 0;
+  }
+  if (++fb->quicken_streak >= kQuickenAfter) {
+    // Instructions are only const to the dispatch loops; the function owns
+    // them. The threaded loop picks the new opcode up on the next visit.
+    const_cast<Instruction &>(instruction).opcode = quick;
+    fb->quicken_streak = 0;
+  }
+}
+
+bool VM::execQuickened(const Instruction &instruction) {
+  if (stack.size() >= 2) {
+    Value &left = stack[stack.size() - 2];
+    const Value right = stack.top();
+    switch (instruction.opcode) {
+    case OpCode::ADD_INT:
+      if (!left.isInt() || !right.isInt()) break;
+      left = Value(left.asInt() + right.asInt());
+      stack.pop();
+      return true;
+    case OpCode::SUB_INT:
+      if (!left.isInt() || !right.isInt()) break;
+      left = Value(left.asInt() - right.asInt());
+      stack.pop();
+      return true;
+    case OpCode::LT_INT:
+      if (!left.isInt() || !right.isInt()) break;
+      left = Value(left.asInt() < right.asInt());
+      stack.pop();
+      return true;
+    case OpCode::EQ_INT:
+      if (!left.isInt() || !right.isInt()) break;
+      left = Value(left.asInt() == right.asInt());
+      stack.pop();
+      return true;
+    case OpCode::ADD_NUM:
+      if (!isMixedNumber(left, right)) break;
+      left = Value(asNumber(left) + asNumber(right));
+      stack.pop();
+      return true;
+    case OpCode::SUB_NUM:
+      if (!isMixedNumber(left, right)) break;
+      left = Value(asNumber(left) - asNumber(right));
+      stack.pop();
+      return true;
+    case OpCode::LT_NUM:
+      if (!isMixedNumber(left, right)) break;
+      left = Value(asNumber(left) < asNumber(right));
+      stack.pop();
+      return true;
+    case OpCode::EQ_NUM:
+      if (!isMixedNumber(left, right)) break;
+      left = Value(asNumber(left) == asNumber(right));
+      stack.pop();
+      return true;
+    case OpCode::ADD_STR: {
+      if (!isPlainString(left) || !isPlainString(right)) break;
+      // Both operands are still on the stack, so they stay rooted.
+      const Value joined = concatStrings(left, right);
+      stack[stack.size() - 2] = joined;
+      stack.pop();
+      return true;
+    }
+    case OpCode::EQ_STR: {
+      if (!isPlainString(left) || !isPlainString(right)) break;
+      bool equal;
+      if (left.isStringId() && right.isStringId() &&
+          left.asStringId() == right.asStringId()) {
+        equal = true;
+      } else if (left.isStringId() && right.isStringId() &&
+                 heap_.isInterned(left.asStringId()) &&
+                 heap_.isInterned(right.asStringId())) {
+        equal = false;
+      } else {
+        const std::string *l = getStringPtr(left);
+        const std::string *r = getStringPtr(right);
+        if (!l || !r) break;
+        equal = *l == *r;
+      }
+      left = Value(equal);
+      stack.pop();
+      return true;
+    }
+    case OpCode::ARRAY_GET_INT: {
+      if (!left.isArrayId() || !right.isInt()) break;
+      const uint32_t array_id = left.asArrayId();
+      const auto *array = std::as_const(heap_).array(array_id);
+      if (!array) break;
+      int64_t idx = right.asInt();
+      if (idx < 0) idx += static_cast<int64_t>(array->size());
+      const bool in_range = idx >= 0 && static_cast<size_t>(idx) < array->size();
+      if (g_active_tracker) {
+        trackFieldAccess("@A" + std::to_string(array_id) + ":[" +
+                         std::to_string(idx) + "]");
+      }
+      left = in_range ? (*array)[static_cast<size_t>(idx)] : Value::makeNull();
+      stack.pop();
+      return true;
+    }
+    default:
+      break;
+    }
+  }
+
+  // Guard miss: back to the generic opcode. After a few misses the site is
+  // treated as polymorphic and stays generic.
+  if (TypeFeedback *fb = quickenFeedback(instruction)) {
+    fb->quicken_streak = 0;
+    fb->quicken_candidate = 0;
+    if (fb->quicken_misses < kMaxQuickenMisses) fb->quicken_misses++;
+  }
+  const_cast<Instruction &>(instruction).opcode =
+      unquickenedOpcode(instruction.opcode);
+  return false;
+}
+
 void VM::execBinaryOp(const Instruction &instruction) {
+  if (isQuickenedOpcode(instruction.opcode) && execQuickened(instruction)) {
+    return;
+  }
+  // noteQuickenSite may rewrite the site below; that takes effect on its next
+  // visit, this one still runs the generic operation.
+  const OpCode opcode = instruction.opcode;
+
   Value right = popStack();
   Value left = popStack();
 
@@ -83,14 +295,17 @@ void VM::execBinaryOp(const Instruction &instruction) {
       hot_func_cb_(*const_cast<BytecodeFunction*>(frame.function));
     }
   }
+  if (quickeningActive()) {
+    noteQuickenSite(instruction, left, right);
+  }
 
 	if (isNull(left) || isNull(right)) {
-		if (instruction.opcode == OpCode::ADD &&
+		if (opcode == OpCode::ADD &&
 		    (left.isStringValId() || left.isStringId() || right.isStringValId() || right.isStringId())) {
 			// string + null -> concat as "strnull", fall through to string branch
 		} else {
 			bool result = false;
-			switch (instruction.opcode) {
+			switch (opcode) {
 			case OpCode::EQ:
 				result = isNull(left) && isNull(right);
 				break;
@@ -130,14 +345,14 @@ void VM::execBinaryOp(const Instruction &instruction) {
 		}
 	}
 
-        if (instruction.opcode == OpCode::EQ || instruction.opcode == OpCode::NEQ) {
+        if (opcode == OpCode::EQ || opcode == OpCode::NEQ) {
                 const bool equal = valuesEqualDeep(left, right);
-                bool result = instruction.opcode == OpCode::EQ ? equal : !equal;
+                bool result = opcode == OpCode::EQ ? equal : !equal;
         pushStack(result);
                 return;
         }
 
-	if (instruction.opcode == OpCode::IS) {
+	if (opcode == OpCode::IS) {
 		bool identical = false;
 		if (left.isInt() && right.isInt()) {
 			identical = left.asInt() == right.asInt();
@@ -187,7 +402,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 	if (left.isInt() && right.isInt()) {
 		int64_t l = left.asInt();
 		int64_t r = right.asInt();
-		switch (instruction.opcode) {
+		switch (opcode) {
 		case OpCode::ADD: pushStack(l + r); break;
 		case OpCode::SUB: pushStack(l - r); break;
 		case OpCode::MUL: pushStack(l * r); break;
@@ -256,7 +471,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 		(right.isInt() || right.isDouble())) {
 		double l = left.isInt() ? static_cast<double>(left.asInt()) : left.asDouble();
 		double r = right.isInt() ? static_cast<double>(right.asInt()) : right.asDouble();
-		switch (instruction.opcode) {
+		switch (opcode) {
 		case OpCode::ADD: pushStack(l + r); break;
 		case OpCode::SUB: pushStack(l - r); break;
 		case OpCode::MUL: pushStack(l * r); break;
@@ -318,6 +533,10 @@ void VM::execBinaryOp(const Instruction &instruction) {
 	}
 
 	if (left.isStringValId() || left.isStringId() || right.isStringValId() || right.isStringId()) {
+		if (opcode == OpCode::ADD) {
+			pushStack(concatStrings(left, right));
+			return;
+		}
 		std::string l;
 		if (left.isStringValId()) {
 			if (current_chunk) {
@@ -352,13 +571,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 			r = toString(right);
 		}
 
-		switch (instruction.opcode) {
-		case OpCode::ADD: {
-			std::string result = l + r;
-			auto strRef = heap_.allocateString(std::move(result));
-			pushStack(Value::makeStringId(strRef.id));
-			break;
-		}
+		switch (opcode) {
 		case OpCode::MUL: {
 			if (right.isInt()) {
 				int count = static_cast<int>(right.asInt());
@@ -393,7 +606,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 	}
 
 	if (left.isArrayId() || right.isArrayId()) {
-		switch (instruction.opcode) {
+		switch (opcode) {
 		case OpCode::ADD: {
 			if (left.isArrayId() && right.isArrayId()) {
 				auto *larr = heap_.array(left.asArrayId());
@@ -550,7 +763,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 		case OpCode::EQ:
 		case OpCode::NEQ: {
 			bool eq = valuesEqualDeep(left, right);
-			pushStack(instruction.opcode == OpCode::EQ ? eq : !eq);
+			pushStack(opcode == OpCode::EQ ? eq : !eq);
 			break;
 		}
 		default: COMPILER_THROW("Invalid array operation");
@@ -559,15 +772,20 @@ void VM::execBinaryOp(const Instruction &instruction) {
 	}
 
 	if (left.isSetId() || right.isSetId()) {
-		switch (instruction.opcode) {
+		switch (opcode) {
 		case OpCode::ADD: {
 			if (left.isSetId() && right.isSetId()) {
 				auto *lset = heap_.set(left.asSetId());
 				auto *rset = heap_.set(right.asSetId());
 				auto setRef = heap_.allocateSet();
 				auto *set = heap_.set(setRef.id);
-				if (lset) set->insert(lset->begin(), lset->end());
-				if (rset) set->insert(rset->begin(), rset->end());
+				// Members are already canonical, so they copy across as is.
+				for (const auto *src : {lset, rset}) {
+					if (!src) continue;
+					for (const Value &member : *src) {
+						if (set->insert(member)) heap_.writeSetBarrier(*set, member);
+					}
+				}
 				pushStack(Value::makeSetId(setRef.id));
 			} else {
 				COMPILER_THROW("Type mismatch in ADD for sets");
@@ -580,9 +798,12 @@ void VM::execBinaryOp(const Instruction &instruction) {
 				auto *rset = heap_.set(right.asSetId());
 				auto setRef = heap_.allocateSet();
 				auto *set = heap_.set(setRef.id);
-				if (lset) set->insert(lset->begin(), lset->end());
-				if (rset) {
-					for (const auto& [k, v] : *rset) set->erase(k);
+				if (lset) {
+					for (const Value &member : *lset) {
+						if (rset && rset->contains(member)) continue;
+						set->insert(member);
+						heap_.writeSetBarrier(*set, member);
+					}
 				}
 				pushStack(Value::makeSetId(setRef.id));
 			} else {
@@ -593,7 +814,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 		case OpCode::EQ:
 		case OpCode::NEQ: {
 			bool eq = valuesEqualDeep(left, right);
-			pushStack(instruction.opcode == OpCode::EQ ? eq : !eq);
+			pushStack(opcode == OpCode::EQ ? eq : !eq);
 			break;
 		}
 		default: COMPILER_THROW("Invalid set operation");
@@ -603,7 +824,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 
 	if (left.isObjectId()) {
 		const char *opMethodName = nullptr;
-		switch (instruction.opcode) {
+		switch (opcode) {
 		case OpCode::ADD: opMethodName = "op_add"; break;
 		case OpCode::SUB: opMethodName = "op_sub"; break;
 		case OpCode::MUL: opMethodName = "op_mul"; break;
@@ -638,7 +859,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 	}
 
 	if (left.isObjectId() || right.isObjectId()) {
-		switch (instruction.opcode) {
+		switch (opcode) {
 		case OpCode::ADD: {
 			if (left.isObjectId() && right.isObjectId()) {
 				auto *lobj = heap_.object(left.asObjectId());
@@ -733,7 +954,7 @@ void VM::execBinaryOp(const Instruction &instruction) {
 		case OpCode::EQ:
 		case OpCode::NEQ: {
 			bool eq = valuesEqualDeep(left, right);
-			pushStack(instruction.opcode == OpCode::EQ ? eq : !eq);
+			pushStack(opcode == OpCode::EQ ? eq : !eq);
 			break;
 		}
 		default: COMPILER_THROW("Invalid object operation");
@@ -800,6 +1021,15 @@ void VM::execJump(const Instruction &instruction) {
     frame.ip = target;
 }
 
+void VM::recordJumpIfFalseBackedge(const Instruction &instruction) {
+    uint32_t target = instruction.operands[0].asInt();
+    const auto &frame = currentFrame();
+    Value cond_peek = stack.empty() ? Value::makeNull() : stack.top();
+    if (!isTruthy(cond_peek) && target < frame.ip) {
+        recordBackedgePublic(static_cast<uint32_t>(frame.ip));
+    }
+}
+
 void VM::execJumpIfFalse(const Instruction &instruction) {
     uint32_t target = instruction.operands[0].asInt();
     Value condition = popStack();
@@ -81,8 +81,7 @@ bool VM::execBuiltinOp(const Instruction &instruction) {
   case OpCode::STRING_CONCAT: {
     Value right = popStack();
     Value left = popStack();
-    auto str_ref = createRuntimeString(toString(left) + toString(right));
-    pushStack(Value::makeStringId(str_ref.id));
+    pushStack(concatStrings(left, right));
     break;
   }
 
@@ -106,6 +105,7 @@ bool VM::execBuiltinOp(const Instruction &instruction) {
     else if (value.isObjectId()) typeName = "object";
     else if (value.isSetId()) typeName = "set";
     else if (value.isRangeId()) typeName = "range";
+    else if (value.isBytesId()) typeName = "bytes";
     else if (value.isClosureId() || value.isFunctionObjId() || value.isHostFuncId()) typeName = "fn";
     else if (value.isCoroutineId()) typeName = "coroutine";
     else if (value.isThreadId()) typeName = "thread";
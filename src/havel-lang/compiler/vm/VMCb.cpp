@@ -74,13 +74,13 @@ uint32_t VM::spawnGoroutine(const Value &callee, const std::vector<Value> &args)
     // where ambient globals is that module's sidecar; a script closure's
     // imports (STORE_GLOBAL from `use { x } from "m"`) live in the script
     // globals and would be missing from the wrong-map snapshot.
-    std::shared_ptr<std::unordered_map<std::string, Value>> snapshot_src;
+    ModuleGlobals snapshot_src;
     auto *closure = heap_.closure(cid);
     if (closure && closure->module_globals) {
-      snapshot_src = std::make_shared<std::unordered_map<std::string, Value>>(
-          *closure->module_globals);
+      snapshot_src = std::make_shared<GlobalTable>(
+          moduleEnvContents(closure->module_globals));
     } else {
-      snapshot_src = std::make_shared<std::unordered_map<std::string, Value>>(globals);
+      snapshot_src = std::make_shared<GlobalTable>(globals);
     }
     spawn_globals_snapshot_[cid] = std::move(snapshot_src);
   }
@@ -269,7 +269,7 @@ DirectCallThunk VM::buildDirectCallThunk(CallbackId id) {
     for (auto &instr : func->instructions) {
         if (!ok) break;
 
-        switch (instr.opcode) {
+        switch (unfusedOpcode(instr.opcode)) {
         case OpCode::LOAD_CONST:
             if (instr.operands.empty() || !instr.operands[0].isInt()) { ok = false; break; }
             pushConst(instr.operands[0].asInt());
@@ -440,6 +440,8 @@ DirectCallThunk VM::buildDirectCallThunk(CallbackId id) {
             tn = "waitgroup";
         } else if (recv->isRangeId()) {
             tn = "range";
+        } else if (recv->isBytesId()) {
+            tn = "bytes";
         } else if (recv->isChannelId()) {
             tn = "channel";
         } else if (recv->isHostFuncId()) {
@@ -510,16 +512,10 @@ VMImage VM::createImage(int width, int height, int stride, PixelFormat format,
   img.stride = stride;
   img.format = format;
 
-  // Create GC-managed byte array for image data
+  // One byte buffer for the whole image, copied in a single block
   size_t dataSize =
       stride > 0 ? static_cast<size_t>(stride) * height : width * height * 4;
-  auto arrayRef = createHostArray();
-  for (size_t i = 0; i < dataSize; ++i) {
-    pushHostArrayValue(arrayRef, static_cast<int64_t>(data[i]));
-  }
-
-  // Store array reference in VMImage
-  img.object_ref = ObjectRef{arrayRef.id};
+  img.pixels = heap_.allocateBytes(std::vector<uint8_t>(data, data + dataSize));
 
   return img;
 }
@@ -532,6 +528,18 @@ VMImage VM::createImageFromRGBA(int width, int height,
                      rgbaData.data());
 }
 
+VMImage VM::createImageFromRGBA(int width, int height,
+                                std::vector<uint8_t> &&rgbaData) {
+  // Already owned: hand the vector to the heap instead of copying it
+  VMImage img;
+  img.width = width;
+  img.height = height;
+  img.stride = width * 4;
+  img.format = PixelFormat::RGBA8;
+  img.pixels = heap_.allocateBytes(std::move(rgbaData));
+  return img;
+}
+
 void VM::setEventQueue(class EventQueue* eq) {
   event_queue_ = eq;
   if (eq && !timer_handler_registered_) {
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <numeric>
 #include <regex>
+#include <utility>
 
 namespace havel::compiler {
 
@@ -48,28 +49,12 @@ bool VM::execCollectionOp(const Instruction &instruction) {
       COMPILER_THROW("SET_SET expects set container");
     }
     uint32_t id = set_val.asSetId();
-    auto *set = heap_.set(id);
-    if (!set) {
+    if (!std::as_const(heap_).set(id)) {
       COMPILER_THROW("SET_SET unknown set id");
     }
-
-    std::string keyStr;
-    if (key.isStringValId() && current_chunk) {
-      keyStr = current_chunk->getString(key.asStringValId());
-    } else if (key.isStringId()) {
-      if (auto *s = heap_.string(key.asStringId())) {
-        keyStr = *s;
-      } else {
-        COMPILER_THROW("SET_SET expects string key");
-      }
-    } else if (key.isInt()) {
-      keyStr = std::to_string(key.asInt());
-    } else {
-      COMPILER_THROW("SET_SET expects string/number key");
-    }
-
-    (*set)[keyStr] = value;
-    heap_.bumpSetVersion(id);
+    // The value is only a presence marker; the key is the member.
+    (void)value;
+    setAdd(id, key);
     // Don't push set back - the caller manages it
     break;
   }
@@ -116,6 +101,12 @@ bool VM::execCollectionOp(const Instruction &instruction) {
 			COMPILER_THROW("ARRAY_LEN unknown string id");
 		}
 		pushStack(Value::makeInt(static_cast<int64_t>(str->size())));
+	} else if (container.isBytesId()) {
+		const auto *buf = heap_.bytes(container.asBytesId());
+		if (!buf) {
+			COMPILER_THROW("ARRAY_LEN unknown bytes id");
+		}
+		pushStack(Value::makeInt(static_cast<int64_t>(buf->size())));
 	} else {
 		COMPILER_THROW("ARRAY_LEN expects array or string");
 	}
@@ -202,14 +193,14 @@ bool VM::execCollectionOp(const Instruction &instruction) {
 		COMPILER_THROW("ENUM_PAYLOAD index must be non-negative");
 	}
 	size_t index = static_cast<size_t>(idx);
-	auto it = heap_.enums_.find(enumRef.id);
-	if (it == heap_.enums_.end()) {
+	const auto *payloads = heap_.enumPayloads(enumRef.id);
+	if (!payloads) {
 		COMPILER_THROW("ENUM_PAYLOAD unknown enum id");
 	}
-	if (index >= it->second.second.size()) {
+	if (index >= payloads->size()) {
 		COMPILER_THROW("ENUM_PAYLOAD index out of bounds");
 	}
-	pushStack(it->second.second.at(index));
+	pushStack(payloads->at(index));
 	break;
 	}
 
@@ -237,7 +228,7 @@ bool VM::execCollectionOp(const Instruction &instruction) {
       if (current_chunk) {
         s = current_chunk->getString(strIdx);
       }
-      auto strRef = heap_.allocateString(s);
+      auto strRef = heap_.internString(s);
       pushStack(Value::makeStringId(strRef.id));
     } else {
       // Already a StringId or other type, passthrough
@@ -276,6 +267,10 @@ case OpCode::ARRAY_GET: {
   Value index_or_key = popStack();
   Value container = popStack();
 
+  if (quickeningActive()) {
+    noteQuickenSite(instruction, container, index_or_key);
+  }
+
   if (hot_func_cb_) {
     auto &frame = currentFrame();
     if (frame.ip < frame.function->type_feedback.size()) {
@@ -294,65 +289,46 @@ case OpCode::ARRAY_GET: {
             if (!index) {
                 COMPILER_THROW("STRING_GET expects integer index");
             }
-            std::string s;
-            if (container.isStringId()) {
-                auto *sp = heap_.string(container.asStringId());
-                if (sp) s = *sp;
-            } else if (container.isStringValId() && current_chunk) {
-                s = current_chunk->getString(container.asStringValId());
-            }
-            int64_t numCodepoints = 0;
-            size_t bytePos = 0;
-            while (bytePos < s.size()) {
-                unsigned char c = static_cast<unsigned char>(s[bytePos]);
-                size_t cpLen = 1;
-                if (c < 0x80) { cpLen = 1; }
-                else if ((c & 0xE0) == 0xC0) { cpLen = 2; }
-                else if ((c & 0xF0) == 0xE0) { cpLen = 3; }
-                else if ((c & 0xF8) == 0xF0) { cpLen = 4; }
-                if (bytePos + cpLen > s.size()) { cpLen = 1; }
-                numCodepoints++;
-                bytePos += cpLen;
-            }
+            const std::string *sp = getStringPtr(container);
+            const std::string_view s = sp ? std::string_view(*sp) : std::string_view{};
+            Utf8Index scratch;
+            const Utf8Index &cps = utf8Index(container, scratch);
+            const int64_t numCodepoints = static_cast<int64_t>(cps.length());
             int64_t idx = *index;
             if (idx < 0) idx = numCodepoints + idx;
             if (idx < 0 || idx >= numCodepoints) {
                 pushStack(Value::makeNull());
             } else {
-                size_t targetByte = 0;
-                int64_t cpIdx = 0;
-                while (cpIdx < idx && targetByte < s.size()) {
-                    unsigned char c = static_cast<unsigned char>(s[targetByte]);
-                    size_t cpLen = 1;
-                    if (c < 0x80) { cpLen = 1; }
-                    else if ((c & 0xE0) == 0xC0) { cpLen = 2; }
-                    else if ((c & 0xF0) == 0xE0) { cpLen = 3; }
-                    else if ((c & 0xF8) == 0xF0) { cpLen = 4; }
-                    if (targetByte + cpLen > s.size()) { cpLen = 1; }
-                    targetByte += cpLen;
-                    cpIdx++;
-                }
-                size_t cpLen = 1;
-                if (targetByte < s.size()) {
-                    unsigned char c = static_cast<unsigned char>(s[targetByte]);
-                    if (c < 0x80) { cpLen = 1; }
-                    else if ((c & 0xE0) == 0xC0) { cpLen = 2; }
-                    else if ((c & 0xF0) == 0xE0) { cpLen = 3; }
-                    else if ((c & 0xF8) == 0xF0) { cpLen = 4; }
-                    if (targetByte + cpLen > s.size()) { cpLen = 1; }
-                }
-                auto ref = heap_.allocateString(s.substr(targetByte, cpLen));
+                const size_t targetByte = cps.byteOffset(s, static_cast<size_t>(idx));
+                const size_t cpLen = Utf8Index::sequenceLength(s, targetByte);
+                // Single characters repeat endlessly in character loops.
+                auto ref = heap_.internString(s.substr(targetByte, cpLen));
                 pushStack(Value::makeStringId(ref.id));
             }
             break;
         }
 
+        if (container.isBytesId()) {
+            auto index = indexFromValue(index_or_key);
+            if (!index) {
+                COMPILER_THROW("ARRAY_GET expects integer index");
+            }
+            const auto *buf = heap_.bytes(container.asBytesId());
+            if (!buf) {
+                COMPILER_THROW("ARRAY_GET unknown bytes id");
+            }
+            int64_t idx = *index;
+            if (idx < 0) idx += static_cast<int64_t>(buf->size());
+            pushStack(idx < 0 ? Value::makeNull() : buf->get(static_cast<size_t>(idx)));
+            break;
+        }
+
         if (container.isArrayId()) {
             auto index = indexFromValue(index_or_key);
             if (!index) {
                 COMPILER_THROW("ARRAY_GET expects integer index");
             }
-            auto *array = heap_.array(container.asArrayId());
+            const auto *array = std::as_const(heap_).array(container.asArrayId());
             if (!array) {
                 COMPILER_THROW("ARRAY_GET unknown array id");
             }
@@ -381,16 +357,10 @@ case OpCode::ARRAY_GET: {
 }
 
 if (container.isSetId()) {
-  auto key = resolveKey(index_or_key);
-  if (!key) {
-    COMPILER_THROW(
-      "SET membership expects string/number/bool key");
-  }
-  auto *set = heap_.set(container.asSetId());
-  if (!set) {
+  if (!std::as_const(heap_).set(container.asSetId())) {
     COMPILER_THROW("ARRAY_GET unknown set id");
   }
-  Value result = Value::makeBool(set->find(*key) != set->end());
+  Value result = Value::makeBool(setHas(container.asSetId(), index_or_key));
   if (hot_func_cb_) {
     auto &frame2 = currentFrame();
     if (frame2.ip < frame2.function->type_feedback.size()) {
@@ -456,7 +426,7 @@ if (container.isSetId()) {
         else if (index_or_key.isCoroutineId()) typeInfo = "coroutine_id";
         COMPILER_THROW("OBJECT index expects string/number/bool key (got " + typeInfo + ")");
       }
-      auto *object = heap_.object(container.asObjectId());
+      const auto *object = std::as_const(heap_).object(container.asObjectId());
       if (!object) {
         COMPILER_THROW("ARRAY_GET unknown object id");
       }
@@ -485,7 +455,7 @@ if (container.isSetId()) {
       if (!index) {
         COMPILER_THROW("ARRAY_SET expects integer index");
       }
-      auto *array = heap_.array(container.asArrayId());
+      auto *array = heap_.arrayForStore(container.asArrayId());
       if (!array) {
         COMPILER_THROW("ARRAY_SET unknown array id");
       }
@@ -509,7 +479,7 @@ if (container.isSetId()) {
 		array->resize(idx_size + 1, Value::makeNull());
 	}
 (*array)[idx_size] = value;
-      heap_.writeArrayBarrier(array->data, value);
+      heap_.writeArrayBarrier(container.asArrayId(), value);
       heap_.bumpArrayVersion(container.asArrayId());
   emitVariableChanged("@A" + std::to_string(container.asArrayId()) + ":[" + std::to_string(idx) + "]");
   if (old_size != array->size()) {
@@ -518,14 +488,29 @@ if (container.isSetId()) {
       break;
     }
 
-    if (container.isSetId()) {
-      auto key = resolveKey(index_or_key);
-      if (!key) {
-        COMPILER_THROW(
-            "SET assignment expects string/number/bool key");
+    if (container.isBytesId()) {
+      auto index = indexFromValue(index_or_key);
+      if (!index) {
+        COMPILER_THROW("ARRAY_SET expects integer index");
       }
-      auto *set = heap_.set(container.asSetId());
-      if (!set) {
+      auto *buf = heap_.bytes(container.asBytesId());
+      if (!buf) {
+        COMPILER_THROW("ARRAY_SET unknown bytes id");
+      }
+      // Buffers have a fixed size: no growing, and only numbers fit.
+      int64_t idx = *index;
+      if (idx < 0) idx += static_cast<int64_t>(buf->size());
+      if (idx < 0 || static_cast<size_t>(idx) >= buf->size()) {
+        COMPILER_THROW("ARRAY_SET index out of bounds: " + std::to_string(*index));
+      }
+      if (!buf->set(static_cast<size_t>(idx), value)) {
+        COMPILER_THROW("ARRAY_SET bytes element must be a number");
+      }
+      break;
+    }
+
+    if (container.isSetId()) {
+      if (!std::as_const(heap_).set(container.asSetId())) {
         COMPILER_THROW("ARRAY_SET unknown set id");
       }
       bool present = false;
@@ -540,12 +525,9 @@ if (container.isSetId()) {
             "SET assignment value must be bool/number to indicate presence");
       }
       if (present) {
-        (*set)[*key] = Value::makeNull();
-        heap_.writeSetBarrier(*set, *key, Value::makeNull());
-        heap_.bumpSetVersion(container.asSetId());
+        setAdd(container.asSetId(), index_or_key);
       } else {
-        set->erase(*key);
-        heap_.bumpSetVersion(container.asSetId());
+        setRemove(container.asSetId(), index_or_key);
       }
       break;
     }
@@ -573,12 +555,12 @@ if (container.isSetId()) {
 			globals[*key] = value;
 			break;
 		}
-		auto *object = heap_.object(container.asObjectId());
+		auto *object = heap_.objectForStore(container.asObjectId());
 		if (!object) {
 			COMPILER_THROW("ARRAY_SET unknown object id");
 		}
 (*object)[*key] = value;
-      heap_.writeObjectBarrier(object->data, *key, value);
+      heap_.writeObjectBarrier(container.asObjectId(), value);
       break;
     }
 
@@ -601,6 +583,16 @@ if (container.isSetId()) {
     Value key_value = popStack();
     Value object = popStack();
 
+    PropertyInlineCache *get_ic =
+        object.isObjectId() ? propertyCache(instruction, 0) : nullptr;
+    if (get_ic) {
+      if (objectGetFromCache(*get_ic, object, key_value)) {
+        ++get_ic->hits;
+        break;
+      }
+      ++get_ic->misses;
+    }
+
     // Handle interval/timeout objects
     if (object.isIntervalId() || object.isTimeoutId()) {
       auto key = resolveKey(key_value);
@@ -761,7 +753,7 @@ if (container.isSetId()) {
               for (const auto& k : keys) {
                 auto* val = obj->get(k);
                 if (val && (val->isFunctionObjId() || val->isHostFuncId())) {
-                  arr->push_back(Value::makeStringId(heap_.allocateString(k).id));
+                  arr->push_back(Value::makeStringId(heap_.internString(k).id));
                 }
               }
               pushStack(Value::makeArrayId(arrRef.id));
@@ -778,7 +770,7 @@ if (container.isSetId()) {
                 for (const auto& k : keys) {
                   auto* val = obj->get(k);
                   if (val && val->isNull()) {
-                    arr->push_back(Value::makeStringId(heap_.allocateString(k).id));
+                    arr->push_back(Value::makeStringId(heap_.internString(k).id));
                   }
                 }
                 pushStack(Value::makeArrayId(arrRef.id));
@@ -897,6 +889,27 @@ if (container.isSetId()) {
       break;
     }
 
+    if (object.isBytesId()) {
+      auto key = resolveKey(key_value);
+      const auto *buf = heap_.bytes(object.asBytesId());
+      if (key && buf && *key == "len") {
+        pushStack(Value::makeInt(static_cast<int64_t>(buf->size())));
+      } else if (key && buf && *key == "byteLength") {
+        pushStack(Value::makeInt(static_cast<int64_t>(buf->length)));
+      } else if (key) {
+        auto method = getPrototypeMethod(object, *key);
+        if (method) {
+          auto bmRef = heap_.allocateBoundMethod(Value::makeHostFuncId(getHostFunctionIndex(host_function_names_[*method])), object);
+          pushStack(Value::makeBoundMethodId(bmRef.id));
+        } else {
+          pushStack(Value::makeNull());
+        }
+      } else {
+        pushStack(Value::makeNull());
+      }
+      break;
+    }
+
     if (object.isSetId()) {
       auto key = resolveKey(key_value);
       if (key && *key == "len") {
@@ -974,9 +987,11 @@ if (container.isSetId()) {
 		}
 
         auto objRef = ObjectRef{object.asObjectId(), true};
-        auto *obj = heap_.object(objRef.id);
+        // Reads only; the autovivify store below looks the object up again
+        // for writing by id.
+        uint32_t obj_id = objRef.id;
+        const GCHeap::ObjectEntry *obj = std::as_const(heap_).object(obj_id);
         if (!obj) {
-            auto stats = heap_.stats();
             COMPILER_THROW("OBJECT_GET unknown object id");
         }
 
@@ -1000,7 +1015,7 @@ if (!modName.empty()) {
       write(2, "\n", 1);
       auto git = globals.find(modName);
       if (git != globals.end() && git->second.isObjectId()) {
-        auto *proxyObj = heap_.object(git->second.asObjectId());
+        auto *proxyObj = std::as_const(heap_).object(git->second.asObjectId());
         if (proxyObj) {
           auto *lf = proxyObj->get("__lazy__");
           if (lf && lf->isBool() && lf->asBool()) {
@@ -1010,7 +1025,8 @@ if (!modName.empty()) {
       }
       git = globals.find(modName);
             if (git != globals.end() && git->second.isObjectId()) {
-                obj = heap_.object(git->second.asObjectId());
+                obj_id = git->second.asObjectId();
+                obj = std::as_const(heap_).object(obj_id);
                 if (!obj) {
                     pushStack(Value::makeNull());
                     break;
@@ -1021,7 +1037,8 @@ if (!modName.empty()) {
                 git = globals.find(capModName);
                 if (git != globals.end() && git->second.isObjectId()) {
                     globals[modName] = git->second;
-                    obj = heap_.object(git->second.asObjectId());
+                    obj_id = git->second.asObjectId();
+                    obj = std::as_const(heap_).object(obj_id);
                     if (!obj) {
                         pushStack(Value::makeNull());
                         break;
@@ -1084,7 +1101,7 @@ if (!modName.empty()) {
 
     Value found_val = Value::makeNull();
     bool found_on_prototype = false;
-    GCHeap::ObjectEntry *current_obj = obj;
+    const GCHeap::ObjectEntry *current_obj = obj;
 
     while (current_obj) {
       auto *val = current_obj->get(*key);
@@ -1100,7 +1117,7 @@ if (!modName.empty()) {
       if (!parent_val) parent_val = current_obj->get("__parent");
 
       if (parent_val && parent_val->isObjectId()) {
-        current_obj = heap_.object(parent_val->asObjectId());
+        current_obj = std::as_const(heap_).object(parent_val->asObjectId());
       } else {
         current_obj = nullptr;
       }
@@ -1145,6 +1162,9 @@ if (!modName.empty()) {
                 break;
               }
             }
+            if (get_ic && obj == std::as_const(heap_).object(object.asObjectId())) {
+              fillObjectGetCache(*get_ic, *obj, key_value, *key);
+            }
             pushStack(found_val);
     } else {
         // Built-in .len property returns key count for objects
@@ -1185,7 +1205,9 @@ if (!modName.empty()) {
                     auto pathRef = heap_.allocateString(childPath);
                     (*subObj)["__cfg_path"] = Value::makeStringValId(pathRef.id);
                     // Store sub-object on parent so it persists
-                    obj->set(*key, Value::makeObjectId(subRef.id));
+                    if (auto *parent = heap_.object(obj_id)) {
+                        parent->set(*key, Value::makeObjectId(subRef.id));
+                    }
                     pushStack(Value::makeObjectId(subRef.id));
                 } else {
                     pushStack(Value::makeNull());
@@ -1203,6 +1225,19 @@ if (!modName.empty()) {
     Value value = popStack();
     Value object = popStack();
 
+    PropertyInlineCache *set_ic = nullptr;
+    if (object.isObjectId() && !variableChangesObserved()) {
+      set_ic = propertyCache(instruction, 0);
+      if (set_ic) {
+        if (objectSetFromCache(*set_ic, object, key, value)) {
+          ++set_ic->hits;
+          pushStack(object);
+          break;
+        }
+        ++set_ic->misses;
+      }
+    }
+
     auto keyStr = resolveKey(key);
     if (!keyStr) {
       COMPILER_THROW("OBJECT_SET expects string/number/bool key");
@@ -1288,7 +1323,7 @@ if (!modName.empty()) {
     break;
   }
 
-  auto *obj = heap_.object(object.asObjectId());
+  auto *obj = heap_.objectForStore(object.asObjectId());
     if (!obj) {
       COMPILER_THROW("OBJECT_SET unknown object id");
     }
@@ -1312,8 +1347,14 @@ if (!modName.empty()) {
       }
     }
 
+    std::shared_ptr<ObjectShape> shape_before =
+        set_ic ? obj->shape : std::shared_ptr<ObjectShape>();
     obj->set(*keyStr, value);
+    heap_.writeObjectBarrier(object.asObjectId(), value);
     emitVariableChanged("@O" + std::to_string(object.asObjectId()) + ":" + *keyStr);
+    if (set_ic) {
+      fillObjectSetCache(*set_ic, *obj, shape_before, key, *keyStr);
+    }
 
     // Auto-save: if object has __autosave_root, persist to config store
     auto* autoSaveRoot = obj->get("__autosave_root");
@@ -1438,7 +1479,7 @@ if (object.isIntervalId()) {
     auto *arr = heap_.array(arrRef.id);
     auto keys = obj->getKeys();
     for (const auto &key : keys) {
-      arr->push_back(Value::makeStringId(heap_.allocateString(key).id));
+      arr->push_back(Value::makeStringId(heap_.internString(key).id));
     }
     pushStack(Value::makeArrayId(arrRef.id));
     break;
@@ -1529,7 +1570,7 @@ if (object.isIntervalId()) {
     if (!obj) {
       pushStack(Value::makeBool(false));
     } else {
-      pushStack(Value::makeBool(obj->data.erase(*key) > 0));
+      pushStack(Value::makeBool(obj->erase(*key) > 0));
     }
     break;
   }
@@ -1593,23 +1634,14 @@ if (object.isIntervalId()) {
       if (!key || !obj) {
         pushStack(Value::makeBool(false));
       } else {
-        bool removed = obj->data.erase(*key) > 0;
+        bool removed = obj->erase(*key) > 0;
         pushStack(Value::makeBool(removed));
       }
     } else if (container.isSetId()) {
-      auto *set = heap_.set(container.asSetId());
-      if (!set) {
+      if (!std::as_const(heap_).set(container.asSetId())) {
         COMPILER_THROW("ARRAY_DEL unknown set id");
       }
-      auto key = resolveKey(keyValue);
-      if (!key) {
-        COMPILER_THROW("ARRAY_DEL expects string/number key for set");
-      }
-      bool removed = set->erase(*key) > 0;
-      if (removed) {
-        heap_.bumpSetVersion(container.asSetId());
-      }
-      pushStack(Value::makeBool(removed));
+      pushStack(Value::makeBool(setRemove(container.asSetId(), keyValue)));
     } else {
       COMPILER_THROW("ARRAY_DEL expects array/set/object/string container");
     }
@@ -1622,19 +1654,10 @@ if (object.isIntervalId()) {
     if (!setVal.isSetId()) {
       COMPILER_THROW("SET_DEL expects set container");
     }
-    auto *set = heap_.set(setVal.asSetId());
-    if (!set) {
+    if (!std::as_const(heap_).set(setVal.asSetId())) {
       COMPILER_THROW("SET_DEL unknown set id");
     }
-    auto key = resolveKey(keyValue);
-    if (!key) {
-      COMPILER_THROW("SET_DEL expects string/number key");
-    }
-    bool removed = set->erase(*key) > 0;
-    if (removed) {
-      heap_.bumpSetVersion(setVal.asSetId());
-    }
-    pushStack(Value::makeBool(removed));
+    pushStack(Value::makeBool(setRemove(setVal.asSetId(), keyValue)));
     break;
   }
 
@@ -1704,15 +1727,21 @@ if (object.isIntervalId()) {
     break;
   }
 
-  // Array higher-order functions (VM intrinsics)
+  // Array higher-order functions (VM intrinsics). The callee is resolved
+  // once with prepareCall and every element is run through callPrepared.
+  // The source array, the result and the reduce accumulator stay on the
+  // operand stack for the whole loop, which keeps them rooted; the array
+  // pointers are re-fetched after each callback since it may allocate.
   case OpCode::ARRAY_MAP: {
-    Value fn = popStack();
-    Value array = popStack();
+    Value fn = stack.top();
+    Value array = stack[stack.size() - 2];
     if (!array.isArrayId()) {
       COMPILER_THROW("ARRAY_MAP expects array");
     }
-    auto *arr = heap_.array(array.asArrayId());
+    const uint32_t arrayId = array.asArrayId();
+    const auto *arr = std::as_const(heap_).array(arrayId);
     if (!arr) {
+      stack.truncate(stack.size() - 2);
       pushStack(Value::makeNull());
       break;
     }
@@ -1720,101 +1749,103 @@ if (object.isIntervalId()) {
       COMPILER_THROW("ARRAY_MAP expects function/closure");
     }
 
-	auto resultRef = heap_.allocateArray();
-	auto *result = heap_.array(resultRef.id);
-	uint64_t resultRootId = pinExternalRoot(Value::makeArrayId(resultRef.id));
-	uint64_t srcRootId = pinExternalRoot(array);
-
-	for (size_t i = 0; i < arr->size(); i++) {
-		Value mapped = callFunctionSync(fn, {(*arr)[i]});
-		arr = heap_.array(array.asArrayId());
-		result->push_back(mapped);
-	}
-
-	unpinExternalRoot(srcRootId);
-	unpinExternalRoot(resultRootId);
-	pushStack(Value::makeArrayId(resultRef.id));
-	break;
-	}
+    PreparedCall call = prepareCall(fn);
+    auto resultRef = heap_.allocateArray();
+    heap_.array(resultRef.id)->reserve(std::as_const(heap_).array(arrayId)->size());
+    pushStack(Value::makeArrayId(resultRef.id));
+    for (size_t i = 0; i < std::as_const(heap_).array(arrayId)->size(); i++) {
+      Value element = (*std::as_const(heap_).array(arrayId))[i];
+      Value mapped = callPrepared(call, HostArgs(&element, 1));
+      heap_.array(resultRef.id)->push_back(mapped);
+    }
 
-	case OpCode::ARRAY_FILTER: {
-	Value fn = popStack();
-	Value array = popStack();
-	if (!array.isArrayId()) {
-		COMPILER_THROW("ARRAY_FILTER expects array");
-	}
-	auto *arr = heap_.array(array.asArrayId());
-	if (!arr) {
-		pushStack(Value::makeNull());
-		break;
-	}
+    stack.truncate(stack.size() - 3);
+    pushStack(Value::makeArrayId(resultRef.id));
+    break;
+  }
 
-	auto resultRef = heap_.allocateArray();
-	auto *result = heap_.array(resultRef.id);
-	uint64_t resultRootId = pinExternalRoot(Value::makeArrayId(resultRef.id));
-	uint64_t srcRootId = pinExternalRoot(array);
+  case OpCode::ARRAY_FILTER: {
+    Value fn = stack.top();
+    Value array = stack[stack.size() - 2];
+    if (!array.isArrayId()) {
+      COMPILER_THROW("ARRAY_FILTER expects array");
+    }
+    const uint32_t arrayId = array.asArrayId();
+    const auto *arr = std::as_const(heap_).array(arrayId);
+    if (!arr) {
+      stack.truncate(stack.size() - 2);
+      pushStack(Value::makeNull());
+      break;
+    }
 
-	for (size_t i = 0; i < arr->size(); i++) {
-		Value predResult = callFunctionSync(fn, {(*arr)[i]});
-		arr = heap_.array(array.asArrayId());
-		if (predResult.isBool() && predResult.asBool()) {
-			result->push_back((*arr)[i]);
-		}
-	}
+    PreparedCall call = prepareCall(fn);
+    auto resultRef = heap_.allocateArray();
+    heap_.array(resultRef.id)->reserve(std::as_const(heap_).array(arrayId)->size());
+    pushStack(Value::makeArrayId(resultRef.id));
+    for (size_t i = 0; i < std::as_const(heap_).array(arrayId)->size(); i++) {
+      Value element = (*std::as_const(heap_).array(arrayId))[i];
+      Value predResult = callPrepared(call, HostArgs(&element, 1));
+      if (predResult.isBool() && predResult.asBool()) {
+        heap_.array(resultRef.id)->push_back(element);
+      }
+    }
 
-	unpinExternalRoot(srcRootId);
-	unpinExternalRoot(resultRootId);
+    stack.truncate(stack.size() - 3);
     pushStack(Value::makeArrayId(resultRef.id));
     break;
   }
 
   case OpCode::ARRAY_REDUCE: {
-    Value initial = popStack();
-    Value fn = popStack();
-    Value array = popStack();
+    Value initial = stack.top();
+    Value fn = stack[stack.size() - 2];
+    Value array = stack[stack.size() - 3];
     if (!array.isArrayId()) {
       COMPILER_THROW("ARRAY_REDUCE expects array");
     }
-    auto *arr = heap_.array(array.asArrayId());
-    if (!arr) {
+    const uint32_t arrayId = array.asArrayId();
+    if (!std::as_const(heap_).array(arrayId)) {
+      stack.truncate(stack.size() - 3);
       pushStack(initial);
       break;
     }
 
-	uint64_t srcRootId = pinExternalRoot(array);
-	Value acc = initial;
-	for (size_t i = 0; i < arr->size(); i++) {
-		acc = callFunctionSync(fn, {acc, (*arr)[i]});
-		arr = heap_.array(array.asArrayId());
-	}
+    // The accumulator lives in the popped `initial` slot between calls.
+    PreparedCall call = prepareCall(fn);
+    const size_t accSlot = stack.size() - 1;
+    for (size_t i = 0; i < std::as_const(heap_).array(arrayId)->size(); i++) {
+      Value callArgs[2] = {stack[accSlot], (*std::as_const(heap_).array(arrayId))[i]};
+      stack[accSlot] = callPrepared(call, HostArgs(callArgs, 2));
+    }
 
-	unpinExternalRoot(srcRootId);
-	pushStack(acc);
-	break;
-	}
+    Value acc = stack[accSlot];
+    stack.truncate(stack.size() - 3);
+    pushStack(acc);
+    break;
+  }
 
-	case OpCode::ARRAY_FOREACH: {
-	Value fn = popStack();
-	Value array = popStack();
-	if (!array.isArrayId()) {
-		COMPILER_THROW("ARRAY_FOREACH expects array");
-	}
-	auto *arr = heap_.array(array.asArrayId());
-	if (!arr) {
-		pushStack(Value::makeNull());
-		break;
-	}
+  case OpCode::ARRAY_FOREACH: {
+    Value fn = stack.top();
+    Value array = stack[stack.size() - 2];
+    if (!array.isArrayId()) {
+      COMPILER_THROW("ARRAY_FOREACH expects array");
+    }
+    const uint32_t arrayId = array.asArrayId();
+    if (!std::as_const(heap_).array(arrayId)) {
+      stack.truncate(stack.size() - 2);
+      pushStack(Value::makeNull());
+      break;
+    }
 
-	uint64_t srcRootId = pinExternalRoot(array);
-	for (size_t i = 0; i < arr->size(); i++) {
-		(void)callFunctionSync(fn, {(*arr)[i]});
-		arr = heap_.array(array.asArrayId());
-	}
+    PreparedCall call = prepareCall(fn);
+    for (size_t i = 0; i < std::as_const(heap_).array(arrayId)->size(); i++) {
+      Value element = (*std::as_const(heap_).array(arrayId))[i];
+      (void)callPrepared(call, HostArgs(&element, 1));
+    }
 
-	unpinExternalRoot(srcRootId);
-	pushStack(Value::makeNull());
-	break;
-	}
+    stack.truncate(stack.size() - 2);
+    pushStack(Value::makeNull());
+    break;
+  }
 
   // String intrinsics (VM-level operations)
   case OpCode::STRING_LEN: {
@@ -19,6 +19,42 @@
 
 namespace havel::compiler {
 
+void VM::enterCoroutine(GCHeap::Coroutine &co, uint32_t co_id,
+                        uint32_t return_ip) {
+  GCHeap::CallerFrame &caller = co.caller_stack.emplace_back();
+  caller.coroutine_id = current_coroutine_id_;
+  caller.frame_count = frame_count_;
+  caller.ip = return_ip;
+  caller.locals.swap(locals);
+  caller.stack.swap(stack);
+  locals.swap(co.locals);
+  stack.swap(co.stack);
+  current_coroutine_id_ = co_id;
+  // Indices from the resumer's frame mean nothing in the coroutine's locals
+  immutable_locals_.clear();
+}
+
+void VM::leaveCoroutine(GCHeap::Coroutine &co) {
+  if (co.caller_stack.empty()) {
+    // Nobody parked here: keep running on the current window and leave the
+    // coroutine a snapshot of its state.
+    co.locals = locals;
+    co.stack = stack;
+    stack.clear();
+    return;
+  }
+  co.locals.swap(locals);
+  co.stack.swap(stack);
+  auto &caller = co.caller_stack.back();
+  frame_count_ = caller.frame_count;
+  locals.swap(caller.locals);
+  stack.swap(caller.stack);
+  current_coroutine_id_ = caller.coroutine_id;
+  currentFrame().ip = caller.ip;
+  co.caller_stack.pop_back();
+  immutable_locals_.clear();
+}
+
 bool VM::execConcurrencyOp(const Instruction &instruction) {
 	switch (instruction.opcode) {
   // CONCURRENCY PRIMITIVES
@@ -209,56 +245,22 @@ case OpCode::TIMEOUT_START: {
         if (!stack.empty()) {
             yield_value = popStack();
         }
-        fprintf(stderr, "[SLOWYIELD] co_id=%u val_isInt=%d val_int=%lld frame_count=%u ip=%u\n", (unsigned)current_coroutine_id_, (int)yield_value.isInt(), (long long)(yield_value.isInt() ? yield_value.asInt() : -999), (unsigned)frame_count_, (unsigned)currentFrame().ip);
-
-if (current_coroutine_id_ != UINT32_MAX) {
-auto *co = heap_.coroutine(current_coroutine_id_);
-if (co) {
-    auto saved_ip = currentFrame().ip;
-    co->ip = saved_ip + 1;
-    co->locals = locals;
-
-    // Save coroutine's current stack
-                    co->stack.clear();
-                    {
-                        std::vector<Value> tmp;
-                        while (!stack.empty()) {
-                            tmp.push_back(stack.top());
-                            stack.pop();
-                        }
-                        for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
-                            co->stack.push_back(*it);
-                        }
-                    }
-
-                    co->state = GCHeap::Coroutine::Waiting;
-
-                    // Pop caller frame from the coroutine's caller stack
-                    if (!co->caller_stack.empty()) {
-                        auto &caller = co->caller_stack.back();
-                        frame_count_ = caller.frame_count;
-                        locals = caller.locals;
-                        current_coroutine_id_ = caller.coroutine_id;
-
-                        currentFrame().ip = caller.ip;
-
-                        stack = std::stack<Value>();
-                        for (auto it = caller.stack.begin(); it != caller.stack.end(); ++it) {
-                            stack.push(*it);
-                        }
-
-                        co->caller_stack.pop_back();
-                    }
-
-		pushStack(yield_value);
-		return true;
-                }
+
+        if (current_coroutine_id_ != UINT32_MAX) {
+            auto *co = heap_.coroutine(current_coroutine_id_);
+            if (co) {
+                co->ip = currentFrame().ip + 1;
+                co->state = GCHeap::Coroutine::Waiting;
+                leaveCoroutine(*co);
+                pushStack(yield_value);
+                return true;
             }
+        }
 
         // Non-coroutine yield
         pushStack(yield_value);
         break;
-}
+    }
 
     case OpCode::YIELD_RESUME: {
         // Resume yielded coroutine
@@ -280,50 +282,16 @@ if (co) {
             break;
         }
 
-            // Push current caller's state onto the coroutine's caller stack
-            {
-                GCHeap::CallerFrame cf;
-                cf.coroutine_id = current_coroutine_id_;
-                cf.frame_count = frame_count_;
-                // Consume stashed return address if present (fast dispatch
-                // pre-increments ip before executeInstruction; see VM.hpp).
-                if (pending_call_return_ip_ >= 0) {
-                    cf.ip = static_cast<uint32_t>(pending_call_return_ip_);
-                } else {
-                    cf.ip = currentFrame().ip + 1;
-                }
-                pending_call_return_ip_ = -1;
-                cf.locals = locals;
-                {
-                    std::vector<Value> tmp;
-                    while (!stack.empty()) {
-                        tmp.push_back(stack.top());
-                        stack.pop();
-                    }
-                    for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
-                        cf.stack.push_back(*it);
-                    }
-                }
-                co->caller_stack.push_back(std::move(cf));
-            }
-            co->parent_locals_size = locals.size();
+        // Consume stashed return address if present (fast dispatch
+        // pre-increments ip before executeInstruction; see VM.hpp).
+        uint32_t return_ip = pending_call_return_ip_ >= 0
+                                 ? static_cast<uint32_t>(pending_call_return_ip_)
+                                 : currentFrame().ip + 1;
+        pending_call_return_ip_ = -1;
+        co->parent_locals_size = locals.size();
 
-        // Switch to the coroutine
-        current_coroutine_id_ = coroutine_id;
-
-        // Restore coroutine's stack (stack[0]=bottom, [N-1]=top)
-        stack = std::stack<Value>();
-        for (auto it = co->stack.begin(); it != co->stack.end(); ++it) {
-            stack.push(*it);
-        }
-
-        // Restore coroutine's locals
-        locals = co->locals;
-
-        // Clear stale immutable_locals_ from the previous frame that used
-        // different absolute indices; coroutine's STORE_IMMUT_VAR opcodes
-        // will repopulate during execution
-        immutable_locals_.clear();
+        // Switch onto the coroutine's own stack and locals
+        enterCoroutine(*co, coroutine_id, return_ip);
 
         // Restore coroutine's instruction pointer
         currentFrame().ip = co->ip;
@@ -370,16 +338,16 @@ break;
  }
 
  if (co->state == GCHeap::Coroutine::Done) {
- Value result = co->stack.empty() ? Value::makeNull() : co->stack.back();
+ Value result = co->stack.empty() ? Value::makeNull() : co->stack.top();
  pushStack(result);
  break;
  }
 
  struct VMState {
- std::stack<Value> stack;
+ ValueStack stack{0}; // sized to the live depth by the copy below
  std::vector<Value> locals;
  size_t frame_count;
- std::vector<CallFrame> frame_arena;
+ FrameArena frame_arena;
  uint32_t current_coroutine_id;
  };
 
@@ -390,17 +358,7 @@ break;
  saved.frame_arena = frame_arena_;
  saved.current_coroutine_id = current_coroutine_id_;
 
-            current_coroutine_id_ = coId;
-            {
-                GCHeap::CallerFrame cf;
-                cf.coroutine_id = saved.current_coroutine_id;
-                cf.frame_count = frame_count_;
-                cf.ip = 0;
-                cf.locals = locals;
-                co->caller_stack.push_back(std::move(cf));
-            }
-            locals = co->locals;
-            immutable_locals_.clear();
+            enterCoroutine(*co, coId, 0);
 
  const auto *chunk = current_chunk;
  const auto *func = chunk ? chunk->getFunction(co->function_index) : nullptr;
@@ -415,23 +373,14 @@ break;
  }
 
         uint32_t coroutine_stack_depth = static_cast<uint32_t>(stack.size());
-    if (frame_arena_.size() <= frame_count_) {
-        CallFrame cf;
-        cf.function = func;
-        cf.chunk = current_chunk;
-        cf.ip = co->ip;
-        cf.locals_base = 0;
-        cf.closure_id = co->closure_id;
-        cf.stack_depth = coroutine_stack_depth;
-        frame_arena_.push_back(std::move(cf));
-    } else {
-        frame_arena_[frame_count_].function = func;
-        frame_arena_[frame_count_].chunk = current_chunk;
-        frame_arena_[frame_count_].ip = co->ip;
-        frame_arena_[frame_count_].locals_base = 0;
-        frame_arena_[frame_count_].closure_id = co->closure_id;
-        frame_arena_[frame_count_].stack_depth = coroutine_stack_depth;
-        }
+    CallFrame cf;
+    cf.function = func;
+    cf.chunk = current_chunk;
+    cf.ip = co->ip;
+    cf.locals_base = 0;
+    cf.closure_id = co->closure_id;
+    cf.stack_depth = coroutine_stack_depth;
+    frame_arena_.place(frame_count_, std::move(cf));
         frame_count_++;
  co->state = GCHeap::Coroutine::Runnable;
 
@@ -460,30 +409,19 @@ break;
  }
                         // Resume coroutine after sleep
                         co->state = GCHeap::Coroutine::Runnable;
-                        current_coroutine_id_ = coId;
-                        locals = co->locals;
-  immutable_locals_.clear();
+                        enterCoroutine(*co, coId, 0);
  const auto *resume_chunk = current_chunk;
  const auto *resume_func = resume_chunk ? resume_chunk->getFunction(co->function_index) : nullptr;
         if (resume_func) {
             uint32_t resume_stack_depth = static_cast<uint32_t>(stack.size());
-        if (frame_arena_.size() <= frame_count_) {
-            CallFrame cf;
-            cf.function = resume_func;
-            cf.chunk = resume_chunk;
-            cf.ip = co->ip;
-            cf.locals_base = 0;
-            cf.closure_id = co->closure_id;
-            cf.stack_depth = resume_stack_depth;
-            frame_arena_.push_back(std::move(cf));
-        } else {
-            frame_arena_[frame_count_].function = resume_func;
-            frame_arena_[frame_count_].chunk = resume_chunk;
-            frame_arena_[frame_count_].ip = co->ip;
-                frame_arena_[frame_count_].locals_base = 0;
-                frame_arena_[frame_count_].closure_id = co->closure_id;
-                frame_arena_[frame_count_].stack_depth = resume_stack_depth;
-            }
+        CallFrame cf;
+        cf.function = resume_func;
+        cf.chunk = resume_chunk;
+        cf.ip = co->ip;
+        cf.locals_base = 0;
+        cf.closure_id = co->closure_id;
+        cf.stack_depth = resume_stack_depth;
+        frame_arena_.place(frame_count_, std::move(cf));
             frame_count_++;
  pushStack(Value::makeNull());
  }
@@ -523,7 +461,7 @@ Value result;
   if (co->state == GCHeap::Coroutine::Done && !stack.empty()) {
     result = popStack();
   } else if (co->state == GCHeap::Coroutine::Done) {
-    result = co->stack.empty() ? Value::makeNull() : co->stack.back();
+    result = co->stack.empty() ? Value::makeNull() : co->stack.top();
   } else if (co->state == GCHeap::Coroutine::Waiting && !stack.empty()) {
     result = popStack();
   } else {
@@ -689,45 +627,17 @@ case OpCode::FIBER_SLEEP: {
     // Inside a coroutine: yield with a resume time
     auto *co = heap_.coroutine(current_coroutine_id_);
     if (co && frame_count_ > 0) {
-      // Save VM's stack to coroutine's stack before yielding
-      co->stack.clear();
-      {
-        std::vector<Value> tmp;
-        while (!stack.empty()) {
-          tmp.push_back(stack.top());
-          stack.pop();
-        }
-        for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
-          co->stack.push_back(*it);
-        }
-      }
       co->ip = currentFrame().ip + 1;
-      co->locals = locals;
       co->state = GCHeap::Coroutine::Waiting;
       co->resume_at_time = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
 
-      auto finished = frame_arena_[frame_count_ - 1];
-      frame_count_--;
-
+      const auto &finished = frame_arena_[frame_count_ - 1];
       closeFrameUpvalues(static_cast<uint32_t>(finished.locals_base),
                          static_cast<uint32_t>(locals.size()));
-      if (locals.size() >= finished.locals_base) {
-        locals.resize(finished.locals_base);
-      }
+      frame_count_--;
 
-      // Stale immutable_locals_ indices from the old frame are invalid
-      // after locals truncation; clear for the parent frame to repopulate
-      immutable_locals_.clear();
-
-      if (!co->caller_stack.empty()) {
-          auto &caller = co->caller_stack.back();
-          frame_count_ = caller.frame_count;
-          locals = caller.locals;
-          immutable_locals_.clear();
-          current_coroutine_id_ = caller.coroutine_id;
-         currentFrame().ip = caller.ip;
-          co->caller_stack.pop_back();
-      }
+      // Hand the coroutine its stack and locals back and resume the caller
+      leaveCoroutine(*co);
 
       pushStack(Value::makeNull());
 
@@ -836,7 +746,7 @@ case OpCode::CHANNEL_SEND: {
   case OpCode::DEFER_PUSH: {
     Value closure = popStack();
     if (frame_count_ > 0) {
-      frame_arena_[frame_count_ - 1].defer_stack.push_back(closure);
+      pushDefer(closure);
     }
     break;
   }
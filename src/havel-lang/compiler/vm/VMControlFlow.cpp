@@ -86,6 +86,16 @@ bool VM::execControlFlowOp(const Instruction &instruction) {
             if (stack.size() < static_cast<size_t>(arg_count) + 1) {
                 COMPILER_THROW("Stack underflow during CALL");
             }
+            // Host callees read their arguments without an argument vector.
+            const Value &callee_slot = stack[stack.size() - 1 - arg_count];
+            if (callee_slot.isHostFuncId() && arg_count <= kHostInlineArgs) {
+                callHostFromStack(callee_slot.asHostFuncId(), arg_count);
+                break;
+            }
+            if ((callee_slot.isFunctionObjId() || callee_slot.isClosureId()) &&
+                callScriptFromStack(arg_count)) {
+                break;
+            }
 
             std::vector<Value> args(arg_count);
             for (uint32_t i = 0; i < arg_count; ++i) {
@@ -298,7 +308,7 @@ Value callee_value = popStack();
 
 case OpCode::CALL_METHOD: {
     // Dispatches based on receiver type without boxing.
-    if (instruction.operands.size() != 2 ||
+    if (instruction.operands.size() < 2 ||
         !instruction.operands[0].isStringValId() ||
         !instruction.operands[1].isInt()) {
       COMPILER_THROW("CALL_METHOD expects operands: <string method_name, uint32 arg_count>");
@@ -307,33 +317,17 @@ case OpCode::CALL_METHOD: {
             uint32_t strIndex = instruction.operands[0].asStringValId();
             const auto& cf_cm = currentFrame();
             const BytecodeChunk* resolveChunkCM = cf_cm.chunk ? cf_cm.chunk : current_chunk;
-            std::string method_name;
-            if (resolveChunkCM) {
-                method_name = resolveChunkCM->getString(strIndex);
-            }
-            method_name = operatorSymbolToMethodName(method_name);
     uint32_t arg_count = instruction.operands[1].asInt();
 
     // Receiver is at stack top - arg_count positions down
     if (stack.size() < static_cast<size_t>(arg_count) + 1) {
+      std::string method_name = resolveChunkCM ? resolveChunkCM->getString(strIndex) : std::string();
       COMPILER_THROW("Stack underflow during CALL_METHOD (stack=" + std::to_string(stack.size()) + " need=" + std::to_string(arg_count + 1) + " method=" + method_name + ")");
     }
 
     // Peek at receiver (don't pop yet)
-    std::vector<Value> temp_args;
-    temp_args.reserve(arg_count);
-    for (uint32_t i = 0; i < arg_count; ++i) {
-      temp_args.push_back(stack.top());
-      stack.pop();
-    }
-    Value receiver = stack.top();
-    // Push args back in reverse order
-    for (auto it = temp_args.rbegin(); it != temp_args.rend(); ++it) {
-      pushStack(*it);
-    }
+    Value receiver = stack[stack.size() - 1 - arg_count];
 
-    // Determine type name for dispatch
-    std::string type_name;
     uint32_t host_func_idx = 0;
     bool found_host = false;
     bool found_via_module = false;
@@ -341,6 +335,38 @@ case OpCode::CALL_METHOD: {
     bool isClassNewCall = false;
     Value classProtoForNew = Value::makeNull();
     Value vm_func = Value::makeNull();
+
+    PropertyInlineCache *method_ic = propertyCache(instruction, 2);
+    MethodTarget cached_method;
+    if (method_ic && methodFromCache(*method_ic, receiver, cached_method)) {
+      ++method_ic->hits;
+      if (cached_method.missing) {
+        for (uint32_t i = 0; i < arg_count; ++i) popStack();
+        popStack(); // receiver
+        pushStack(Value::makeNull());
+        break;
+      }
+      found_host = cached_method.host;
+      host_func_idx = cached_method.host_index;
+      vm_func = cached_method.function;
+      isInstanceFunc = cached_method.instance_func;
+      found_via_module = cached_method.via_module;
+    } else {
+    if (method_ic) ++method_ic->misses;
+            std::string method_name;
+            if (resolveChunkCM) {
+                method_name = resolveChunkCM->getString(strIndex);
+            }
+            method_name = operatorSymbolToMethodName(method_name);
+    const Value original_receiver = receiver;
+    // How the slow path resolved the method, for filling the cache.
+    enum class Resolved { None, OwnField, ClassChain, TypePrototype, NoMethod };
+    Resolved resolved = Resolved::None;
+    const Value *module_node = nullptr;
+    std::array<const Value *, 2> type_globals{};
+
+    // Determine type name for dispatch
+    std::string type_name;
     if (receiver.isStringValId() || receiver.isStringId() || receiver.isRegexValId()) {
       type_name = "string";
     } else if (receiver.isInt()) {
@@ -367,6 +393,8 @@ case OpCode::CALL_METHOD: {
     type_name = "channel";
   } else if (receiver.isRangeId()) {
         type_name = "range";
+  } else if (receiver.isBytesId()) {
+        type_name = "bytes";
     } else if (receiver.isHostFuncId()) {
         // Dotted host function call: e.g. interval.start(100, fn)
         // Resolve "interval.start" by concatenating receiver name + "." + method_name
@@ -460,10 +488,16 @@ if (instanceObj) {
                             for (const auto &g : globals) {
                                 if (g.second.isObjectId() && g.second.asObjectId() == receiver.asObjectId()) {
                                     found_via_module = true;
+                                    module_node = &g.second;
                                     break;
                                 }
                             }
                         }
+                        // Whether an object is a global can change without its
+                        // layout changing, so only the module case is pinned.
+                        if (isClassProto || wantsSelf || found_via_module) {
+                            resolved = Resolved::OwnField;
+                        }
           } else if (it->second.isFunctionObjId() || it->second.isClosureId()) {
             vm_func = it->second;
             // Method found as direct field on instance.
@@ -514,6 +548,7 @@ if (instanceObj) {
               }
               isInstanceFunc = !wantsSelf;
             }
+            resolved = Resolved::OwnField;
           } else if (it->second.isObjectId()) {
             // Check if it's a class prototype (has __is_class = true)
             auto *fieldObj = heap_.object(it->second.asObjectId());
@@ -553,10 +588,12 @@ if (instanceObj) {
           if (methodVal->isHostFuncId()) {
             host_func_idx = methodVal->asHostFuncId();
             found_host = true;
+            resolved = Resolved::ClassChain;
             break;
           } else if (methodVal->isFunctionObjId() || methodVal->isClosureId()) {
             vm_func = *methodVal;
             isInstanceFunc = false;
+            resolved = Resolved::ClassChain;
             break;
           }
         }
@@ -613,6 +650,7 @@ if (instanceObj) {
         if (methodIt != typeIt->second.end()) {
             host_func_idx = methodIt->second;
             found_host = true;
+            resolved = Resolved::TypePrototype;
         }
         }
     }
@@ -622,6 +660,18 @@ if (instanceObj) {
       // Generate capitalized version (e.g., "string" -> "String")
       std::string capName = type_name;
       if (!capName.empty()) capName[0] = static_cast<char>(std::toupper(capName[0]));
+      // A primitive type with no prototype method and no type module to
+      // patch one in resolves to nothing until either table changes.
+      if (!receiver.isObjectId()) {
+        resolved = Resolved::NoMethod;
+        for (size_t n = 0; n < 2; ++n) {
+          auto typeIt = globals.find(n == 0 ? type_name : capName);
+          if (typeIt != globals.end()) {
+            type_globals[n] = &typeIt->second;
+            if (typeIt->second.isObjectId()) resolved = Resolved::None;
+          }
+        }
+      }
 
       for (const auto &modName : {type_name, capName}) {
         auto modIt = globals.find(modName);
@@ -645,6 +695,70 @@ if (instanceObj) {
       }
     }
 
+    if (method_ic && !method_ic->megamorphic() && resolved != Resolved::None &&
+        receiver.rawBits() == original_receiver.rawBits()) {
+      PropertyInlineCache::Way way;
+      const GCHeap::ObjectEntry *recvObj =
+          receiver.isObjectId() ? heap_.object(receiver.asObjectId()) : nullptr;
+      bool fill = !receiver.isObjectId() ||
+                  (recvObj && recvObj->shape->isShared() &&
+                   recvObj->shape->slotOf("__lazy__") == ObjectShape::kNotFound);
+      if (fill && resolved == Resolved::NoMethod) {
+        way.flags = PropertyInlineCache::kNoMethod;
+        way.epoch = prototype_epoch_;
+        way.globals_epoch = globals.epoch();
+        way.type_globals = type_globals;
+        way.receiver_tag = methodReceiverTag(receiver);
+        fill = way.receiver_tag != 0;
+      } else if (fill && resolved == Resolved::TypePrototype) {
+        way.flags = PropertyInlineCache::kTypePrototype;
+        way.host_index = host_func_idx;
+        way.epoch = prototype_epoch_;
+        if (recvObj) {
+          // Only a layout with none of the earlier lookup steps' keys.
+          const ObjectShape &shape = *recvObj->shape;
+          fill = shape.slotOf(method_name) == ObjectShape::kNotFound &&
+                 shape.slotOf("__class") == ObjectShape::kNotFound &&
+                 shape.slotOf("__struct") == ObjectShape::kNotFound;
+          way.shape = recvObj->shape;
+        } else {
+          way.receiver_tag = methodReceiverTag(receiver);
+          fill = way.receiver_tag != 0;
+        }
+      } else if (fill) {
+        way.shape = recvObj->shape;
+        if (resolved == Resolved::OwnField) {
+          way.slot = recvObj->shape->slotOf(method_name);
+          fill = way.slot != ObjectShape::kNotFound;
+        } else {
+          fill = recordPrototypePath(way, *recvObj, method_name, true);
+        }
+        const GCHeap::ObjectEntry *holder = fill ? cachedHolder(way, recvObj) : nullptr;
+        fill = holder != nullptr;
+        if (fill) {
+          const Value method = holder->slots[way.slot];
+          fill = found_host ? method.isHostFuncId() && method.asHostFuncId() == host_func_idx
+                            : method.rawBits() == vm_func.rawBits();
+          way.method_bits = method.rawBits();
+        }
+        way.host_index = host_func_idx;
+        if (found_host) way.flags |= PropertyInlineCache::kHostMethod;
+        if (isInstanceFunc) way.flags |= PropertyInlineCache::kInstanceFunc;
+        // Function fields called without self don't care whether the
+        // receiver is a module; host fields do, so pin the globals node.
+        if (found_host && found_via_module) {
+          way.flags |= PropertyInlineCache::kViaModule;
+          way.module_slot = module_node;
+          way.epoch = globals.epoch();
+          fill = fill && module_node != nullptr;
+        }
+      }
+      if (fill) {
+        method_ic->add(std::move(way));
+      }
+    }
+    }
+
     if (!found_host && vm_func.isNull()) {
       // Pop args and receiver before pushing null result
       for (uint32_t i = 0; i < arg_count; ++i) popStack();
@@ -653,6 +767,24 @@ if (instanceObj) {
       break;
     }
 
+  // Host methods take the receiver (when they want it) and the arguments
+  // straight from the stack.
+  if (found_host && !isClassNewCall && arg_count < kHostInlineArgs &&
+      hostEntry(host_func_idx)) {
+    const uint32_t argc = arg_count + ((isInstanceFunc || found_via_module) ? 0 : 1);
+    std::array<Value, kHostInlineArgs> argv;
+    std::copy(stack.end() - argc, stack.end(), argv.begin());
+    stack.truncate(stack.size() - arg_count - 1);
+    Value result = callHostEntry(host_func_idx, HostArgs(argv.data(), argc));
+    pushStack(result);
+    if (hot_func_cb_) {
+      if (currentFrame().ip < currentFrame().function->type_feedback.size()) {
+        currentFrame().function->type_feedback[currentFrame().ip].result_type_mask |= getFeedbackMask(result);
+      }
+    }
+    break;
+  }
+
   // Pop args and receiver
   std::vector<Value> args2(arg_count);
   for (uint32_t i = 0; i < arg_count; ++i) {
@@ -676,23 +808,17 @@ if (instanceObj) {
     }
 
     if (found_host) {
-        if (host_func_idx < host_function_names_.size()) {
-            std::string resolved_name = host_function_names_[host_func_idx];
-            auto fnIt = host_functions.find(resolved_name);
-            if (fnIt != host_functions.end()) {
-                Value result = fnIt->second(all_args);
-                pushStack(result);
-    if (hot_func_cb_) {
-      if (currentFrame().ip < currentFrame().function->type_feedback.size()) {
-        currentFrame().function->type_feedback[currentFrame().ip].result_type_mask |= getFeedbackMask(result);
-      }
-    }
+        if (hostEntry(host_func_idx)) {
+            Value result = callHostEntry(host_func_idx, all_args);
+            pushStack(result);
+            if (hot_func_cb_) {
+                if (currentFrame().ip < currentFrame().function->type_feedback.size()) {
+                    currentFrame().function->type_feedback[currentFrame().ip].result_type_mask |= getFeedbackMask(result);
+                }
+            }
         } else {
-          pushStack(Value::makeNull());
+            pushStack(Value::makeNull());
         }
-      } else {
-        pushStack(Value::makeNull());
-      }
     } else {
         // Call VM function
         doCall(vm_func, all_args);
@@ -807,6 +933,8 @@ if (instanceObj) {
       type_name = "channel";
     } else if (receiver.isRangeId()) {
       type_name = "range";
+    } else if (receiver.isBytesId()) {
+      type_name = "bytes";
     } else if (receiver.isHostFuncId()) {
         std::string receiver_name;
         if (receiver.asHostFuncId() < host_function_names_.size()) {
@@ -1017,19 +1145,13 @@ if (instanceObj) {
     }
 
     if (found_host) {
-        if (host_func_idx < host_function_names_.size()) {
-            std::string resolved_name = host_function_names_[host_func_idx];
-            auto fnIt = host_functions.find(resolved_name);
-            if (fnIt != host_functions.end()) {
-                Value result = fnIt->second(call_args);
-                pushStack(result);
-                if (hot_func_cb_) {
-                    if (currentFrame().ip < currentFrame().function->type_feedback.size()) {
-                        currentFrame().function->type_feedback[currentFrame().ip].result_type_mask |= getFeedbackMask(result);
-                    }
+        if (hostEntry(host_func_idx)) {
+            Value result = callHostEntry(host_func_idx, call_args);
+            pushStack(result);
+            if (hot_func_cb_) {
+                if (currentFrame().ip < currentFrame().function->type_feedback.size()) {
+                    currentFrame().function->type_feedback[currentFrame().ip].result_type_mask |= getFeedbackMask(result);
                 }
-            } else {
-                pushStack(Value::makeNull());
             }
         } else {
             pushStack(Value::makeNull());
@@ -1178,16 +1300,16 @@ if (instanceObj) {
         instruction.operands[1].isInt()) {
       finally_ip = instruction.operands[1].asInt();
     }
-    currentFrame().try_stack.push_back(TryHandler{.catch_ip = catch_ip,
-                                                  .finally_ip = finally_ip,
-                                                  .finally_return_ip = 0,
-                                                  .stack_depth = stack.size()});
+    pushTryHandler(TryHandler{.catch_ip = catch_ip,
+                              .finally_ip = finally_ip,
+                              .finally_return_ip = 0,
+                              .stack_depth = stack.size()});
     break;
   }
 
   case OpCode::TRY_EXIT: {
-    if (!currentFrame().try_stack.empty()) {
-      currentFrame().try_stack.pop_back();
+    if (currentFrame().try_count > 0) {
+      currentFrame().try_count--;
     }
     break;
   }
@@ -1224,19 +1346,7 @@ case OpCode::CLOSURE: {
     closure.upvalues.reserve(target->upvalues.size());
     for (const auto &descriptor : target->upvalues) {
         if (descriptor.captures_local) {
-            uint32_t abs = this->toAbsoluteLocal(descriptor.index);
-            this->ensureLocalIndex(abs);
-            auto open_it = open_upvalues.find(abs);
-            if (open_it == open_upvalues.end()) {
-                auto cell = std::make_shared<GCHeap::UpvalueCell>();
-                cell->is_open = true;
-                cell->open_index = descriptor.index;
-                cell->locals_base = currentFrame().locals_base;
-                open_upvalues.emplace(abs, cell);
-                closure.upvalues.push_back(std::move(cell));
-            } else {
-                closure.upvalues.push_back(open_it->second);
-            }
+            closure.upvalues.push_back(captureLocal(descriptor.index));
         } else {
             uint32_t parent_closure_id = currentFrame().closure_id;
             if (parent_closure_id == 0) {
@@ -1259,7 +1369,7 @@ case OpCode::CLOSURE: {
         }
     }
 
-  std::shared_ptr<std::unordered_map<std::string, Value>> closure_globals;
+  ModuleGlobals closure_globals;
   if (main_chunk_ && current_chunk != main_chunk_.get()) {
     // For module chunks, share the parent frame's module_globals dict instead
     // of copying vm.globals. Closures created here must observe writes done
@@ -1276,7 +1386,7 @@ case OpCode::CLOSURE: {
       }
     }
     if (!closure_globals) {
-      closure_globals = std::make_shared<std::unordered_map<std::string, Value>>(globals);
+      closure_globals = std::make_shared<GlobalTable>(globals);
     }
   }
 
@@ -16,16 +16,52 @@
 #include <sstream>
 #include "../../stdlib/LogModule.hpp"
 
-#if defined(__GNUC__) && !defined(__clang__)
-#define HAVE_COMPUTED_GOTO 1
-#elif defined(__clang__)
-#define HAVE_COMPUTED_GOTO 1
-#else
-#define HAVE_COMPUTED_GOTO 0
-#endif
-
 namespace havel::compiler {
 
+// Inline-cache entry for a LOAD_GLOBAL/STORE_GLOBAL site, or nullptr when the
+// instruction carries no cache slot (bc.* builder output, older images) or
+// isn't part of the active frame's code.
+GlobalCacheEntry *VM::globalCacheEntry(const Instruction &instruction) {
+    if (instruction.operands.size() < 2 || !instruction.operands[1].isInt() ||
+        frame_count_ == 0) {
+        return nullptr;
+    }
+    const BytecodeFunction *function = frame_arena_[frame_count_ - 1].function;
+    if (!function) return nullptr;
+    const Instruction *code = function->instructions.data();
+    if (&instruction < code || &instruction >= code + function->instructions.size()) {
+        return nullptr;
+    }
+    const auto index = static_cast<uint32_t>(instruction.operands[1].asInt());
+    if (index >= function->global_cache_slots) return nullptr;
+    if (function->global_cache.size() < function->global_cache_slots) {
+        function->global_cache.resize(function->global_cache_slots);
+    }
+    return &function->global_cache[index];
+}
+
+// Same for the shape cache of an OBJECT_GET/OBJECT_SET (operand 0) or
+// CALL_METHOD (operand 2) site.
+PropertyInlineCache *VM::propertyCache(const Instruction &instruction,
+                                       size_t operand) {
+    if (instruction.operands.size() <= operand ||
+        !instruction.operands[operand].isInt() || frame_count_ == 0) {
+        return nullptr;
+    }
+    const BytecodeFunction *function = frame_arena_[frame_count_ - 1].function;
+    if (!function) return nullptr;
+    const Instruction *code = function->instructions.data();
+    if (&instruction < code || &instruction >= code + function->instructions.size()) {
+        return nullptr;
+    }
+    const auto index = static_cast<uint32_t>(instruction.operands[operand].asInt());
+    if (index >= function->property_cache_slots) return nullptr;
+    if (function->property_cache.size() < function->property_cache_slots) {
+        function->property_cache.resize(function->property_cache_slots);
+    }
+    return &function->property_cache[index];
+}
+
 // ============================================================================
 // Main executeInstruction dispatcher — switch-based (portable)
 // ============================================================================
@@ -34,7 +70,13 @@ void VM::executeInstruction(const Instruction &instruction) {
 if (frame_count_ > 0 && frame_arena_[frame_count_ - 1].chunk) {
         current_chunk = frame_arena_[frame_count_ - 1].chunk;
 }
+dispatchInstruction(instruction);
+}
+
+void VM::dispatchInstruction(const Instruction &instruction) {
 switch (instruction.opcode) {
+  // Superinstruction heads execute as the plain opcode they replaced; the
+  // rest of the sequence follows one instruction at a time (see OpCode).
   case OpCode::LOAD_CONST: {
     uint32_t const_index = instruction.operands[0].asInt();
     pushStack(getConstant(const_index));
@@ -46,6 +88,21 @@ case OpCode::LOAD_GLOBAL: {
                 !instruction.operands[0].isStringValId()) {
                 COMPILER_THROW("LOAD_GLOBAL expects string operand");
             }
+            GlobalCacheEntry *ic = globalCacheEntry(instruction);
+            if (ic && ic->epoch == globals.epoch()) {
+                if (ic->slot) {
+                    const Value cached = *ic->slot;
+                    if (!cached.isObjectId() || cached.asObjectId() == ic->checked_object) {
+                        trackGlobalAccess(*ic->name);
+                        pushStack(cached);
+                        break;
+                    }
+                } else if (ic->host_version == host_globals_version_) {
+                    trackGlobalAccess(*ic->name);
+                    pushStack(ic->host_value);
+                    break;
+                }
+            }
             uint32_t strIndex = instruction.operands[0].asStringValId();
             const auto& cf = currentFrame();
             const auto* func = cf.function;
@@ -87,6 +144,13 @@ case OpCode::LOAD_GLOBAL: {
         }
       }
     }
+    if (ic) {
+        *ic = GlobalCacheEntry{};
+        ic->epoch = globals.epoch();
+        ic->slot = &it->second;
+        ic->name = &it->first;
+        if (it->second.isObjectId()) ic->checked_object = it->second.asObjectId();
+    }
     trackGlobalAccess(name);
     pushStack(it->second);
     break;
@@ -94,6 +158,13 @@ case OpCode::LOAD_GLOBAL: {
 
 auto hostIt = host_function_globals_.find(name);
   if (hostIt != host_function_globals_.end()) {
+    if (ic) {
+        *ic = GlobalCacheEntry{};
+        ic->epoch = globals.epoch();
+        ic->name = &hostIt->first;
+        ic->host_value = hostIt->second;
+        ic->host_version = host_globals_version_;
+    }
     trackGlobalAccess(name);
     pushStack(hostIt->second);
     break;
@@ -111,13 +182,20 @@ case OpCode::STORE_GLOBAL: {
             }
             uint32_t strIndex = instruction.operands[0].asStringValId();
             const auto& cf_store = currentFrame();
-            const BytecodeChunk* resolveChunkStore = cf_store.chunk ? cf_store.chunk : current_chunk;
-            std::string name;
-            if (resolveChunkStore) {
-                name = resolveChunkStore->getString(strIndex);
+            GlobalCacheEntry *ic = globalCacheEntry(instruction);
+            Value *slot = nullptr;
+            std::string resolvedName;
+            if (ic && ic->epoch == globals.epoch() && ic->slot) {
+                slot = ic->slot;
             } else {
-                name = "<unknown:" + std::to_string(strIndex) + ">";
+                const BytecodeChunk* resolveChunkStore = cf_store.chunk ? cf_store.chunk : current_chunk;
+                if (resolveChunkStore) {
+                    resolvedName = resolveChunkStore->getString(strIndex);
+                } else {
+                    resolvedName = "<unknown:" + std::to_string(strIndex) + ">";
+                }
             }
+            const std::string &name = slot ? *ic->name : resolvedName;
 Value value = popStack();
 
              // Materialize StringValId to heap StringId so cross-chunk reads work
@@ -141,29 +219,27 @@ Value value = popStack();
                 }
                 COMPILER_THROW("Cannot reassign val global: " + name);
             }
-            globals[name] = value;
-
-            // Persist to the shared module_globals map so subsequent calls
-            // see the updated value. Gate on closure_id only: module function
-            // frames have a non-zero closure id whether they are nested
-            // (owns_globals=true) or running inside the ClosureId host wrapper
-            // (owns_globals=false). The wrapper never pushes to globals_stack_,
-            // so persisting is safe; dropping owns_globals here is what lets
-            // module functions maintain module-global state (caches, etc).
+            if (!slot) {
+                auto entry = globals.try_emplace(name).first;
+                slot = &entry->second;
+                if (ic) {
+                    *ic = GlobalCacheEntry{};
+                    ic->epoch = globals.epoch();
+                    ic->slot = slot;
+                    ic->name = &entry->first;
+                }
+            }
+            *slot = value;
+
+            // A module function normally runs with its env active, so the
+            // store above already landed in the module's own table. When it
+            // runs under someone else's globals (a sandboxed load parked its
+            // env), write through to the env so the module still sees it.
             if (cf_store.closure_id != 0) {
                 auto* closure = heap_.closure(cf_store.closure_id);
-                if (closure && closure->module_globals) {
+                if (closure && closure->module_globals &&
+                    closure->module_globals != active_env_) {
                     (*closure->module_globals)[name] = value;
-                    // Track the key so doReturn can refresh the caller's
-                    // stale globals copy cheaply (per-key, not full map).
-                    if (!frame_arena_.empty() && frame_count_ > 0) {
-                        auto &wf = frame_arena_[frame_count_ - 1];
-                        if (std::find(wf.written_globals.begin(),
-                                      wf.written_globals.end(), name) ==
-                            wf.written_globals.end()) {
-                            wf.written_globals.push_back(name);
-                        }
-                    }
                 }
             }
 
@@ -219,21 +295,12 @@ Value value = popStack();
         immutable_globals_.insert(name);
         globals[name] = value;
 
-        // Persist to shared module_globals (see STORE_GLOBAL above)
+        // Write through to an inactive module env (see STORE_GLOBAL above)
         if (cf_imut.closure_id != 0) {
             auto* closure = heap_.closure(cf_imut.closure_id);
-            if (closure && closure->module_globals) {
+            if (closure && closure->module_globals &&
+                closure->module_globals != active_env_) {
                 (*closure->module_globals)[name] = value;
-                // Track the key so doReturn can refresh the caller's
-                // stale globals copy cheaply (per-key, not full map).
-                if (!frame_arena_.empty() && frame_count_ > 0) {
-                    auto &wf = frame_arena_[frame_count_ - 1];
-                    if (std::find(wf.written_globals.begin(),
-                                  wf.written_globals.end(), name) ==
-                        wf.written_globals.end()) {
-                        wf.written_globals.push_back(name);
-                    }
-                }
             }
         }
 
@@ -242,6 +309,10 @@ Value value = popStack();
         break;
     }
 
+case OpCode::LOAD_VAR_LOAD_CONST_BINOP:
+case OpCode::LOAD_VAR_LOAD_VAR_BINOP:
+case OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP:
+case OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP:
 case OpCode::LOAD_VAR: {
     uint32_t var_index = instruction.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -488,18 +559,17 @@ if (cell->is_open) {
     break;
   }
 
+  case OpCode::DUP_STORE_VAR_POP:
+  case OpCode::DUP_STORE_GLOBAL_POP:
   case OpCode::DUP: {
-    Value value = popStack();
-    pushStack(value);
-    pushStack(value);
+    if (stack.empty()) stackUnderflow();
+    pushStack(stack.top());
     break;
   }
 
   case OpCode::SWAP: {
-    Value top = popStack();
-    Value next = popStack();
-    pushStack(top);
-    pushStack(next);
+    if (stack.size() < 2) stackUnderflow();
+    std::swap(stack.top(), stack[stack.size() - 2]);
     break;
   }
 
@@ -529,9 +599,25 @@ if (cell->is_open) {
     case OpCode::BIT_XOR:
     case OpCode::BIT_LSH:
     case OpCode::BIT_RSH:
+    // Quickened forms fall back to the generic path inside execBinaryOp.
+    case OpCode::ADD_INT:
+    case OpCode::ADD_NUM:
+    case OpCode::ADD_STR:
+    case OpCode::SUB_INT:
+    case OpCode::SUB_NUM:
+    case OpCode::LT_INT:
+    case OpCode::LT_NUM:
+    case OpCode::EQ_INT:
+    case OpCode::EQ_NUM:
+    case OpCode::EQ_STR:
       execBinaryOp(instruction);
       break;
 
+  case OpCode::ARRAY_GET_INT:
+    // On a guard miss the instruction is ARRAY_GET again.
+    if (!execQuickened(instruction)) dispatchInstruction(instruction);
+    break;
+
   case OpCode::AND:
   case OpCode::OR:
     execLogicalOp(instruction.opcode);
@@ -628,24 +714,28 @@ default:
 
 #if HAVE_COMPUTED_GOTO
 
-#define DISPATCH_NEXT() do { \
-    if (frame_count_ > stop_frame_depth) { \
-        auto &frm = frame_arena_[frame_count_ - 1]; \
-        if (frm.ip == saved_ip) frm.ip++; \
-        goto *dispatch_table[static_cast<uint8_t>( \
-            frm.function->instructions[frm.ip].opcode)]; \
+// Fetch and jump to the handler of the next instruction of the active frame.
+// The active frame and its code array are kept in locals so handlers don't
+// re-derive them from frame_arena_; the code pointer is only refreshed when
+// the active function changes (call, return, coroutine switch). The chunk
+// sync that executeInstruction does per instruction happens here instead,
+// which is why handlers below call dispatchInstruction directly.
+#define DISPATCH() do { \
+    if (frame_count_ <= stop_frame_depth) return; \
+    frame = &frame_arena_[frame_count_ - 1]; \
+    if (frame->function != code_fn) { \
+        code_fn = frame->function; \
+        code = code_fn->instructions.data(); \
+        code_size = code_fn->instructions.size(); \
     } \
-    return; \
-} while(0)
-
-#define DISPATCH_OP(op) do { \
-    if (frame_count_ > stop_frame_depth) { \
-        auto &frm = frame_arena_[frame_count_ - 1]; \
-        if (frm.ip == saved_ip) frm.ip++; \
-        goto *dispatch_table[static_cast<uint8_t>(OpCode::op)]; \
+    if (frame->chunk && frame->chunk != current_chunk) current_chunk = frame->chunk; \
+    if (frame->ip >= code_size) { \
+        stack.push(nullptr); \
+        executeInstruction(Instruction{OpCode::RETURN}); \
+        return; \
     } \
-    return; \
-} while(0)
+    goto *dispatch_table[static_cast<uint8_t>(code[frame->ip].opcode)]; \
+} while (0)
 
 __attribute__((hot, noinline))
 void VM::runDispatchFast(size_t stop_frame_depth) {
@@ -707,30 +797,44 @@ void VM::runDispatchFast(size_t stop_frame_depth) {
         dispatch_table[static_cast<uint8_t>(OpCode::CALL_SPREAD)] = &&op_CALL;
         dispatch_table[static_cast<uint8_t>(OpCode::RETURN)] = &&op_RETURN;
         dispatch_table[static_cast<uint8_t>(OpCode::YIELD)] = &&op_YIELD;
+        dispatch_table[static_cast<uint8_t>(OpCode::LOAD_VAR_LOAD_CONST_BINOP)] = &&op_LOAD_VAR_LOAD_CONST_BINOP;
+        dispatch_table[static_cast<uint8_t>(OpCode::LOAD_VAR_LOAD_VAR_BINOP)] = &&op_LOAD_VAR_LOAD_VAR_BINOP;
+        dispatch_table[static_cast<uint8_t>(OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP)] = &&op_LOAD_VAR_LOAD_CONST_CMP_JUMP;
+        dispatch_table[static_cast<uint8_t>(OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP)] = &&op_LOAD_VAR_LOAD_VAR_CMP_JUMP;
+        dispatch_table[static_cast<uint8_t>(OpCode::DUP_STORE_VAR_POP)] = &&op_DUP_STORE_VAR_POP;
+        dispatch_table[static_cast<uint8_t>(OpCode::DUP_STORE_GLOBAL_POP)] = &&op_DUP_STORE_GLOBAL_POP;
+        dispatch_table[static_cast<uint8_t>(OpCode::ADD_INT)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::ADD_NUM)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::ADD_STR)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::SUB_INT)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::SUB_NUM)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::LT_INT)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::LT_NUM)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::EQ_INT)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::EQ_NUM)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::EQ_STR)] = &&op_QUICKENED;
+        dispatch_table[static_cast<uint8_t>(OpCode::ARRAY_GET_INT)] = &&op_QUICKENED;
         dispatch_initialized = true;
     }
 
     size_t counter = 0;
+    // Set by a superinstruction head for superinstruction_done: how many
+    // plain instructions it ran.
+    size_t fused_ops = 0;
+    CallFrame *frame = nullptr;
+    const BytecodeFunction *code_fn = nullptr;
+    const Instruction *code = nullptr;
+    size_t code_size = 0;
 
     // Fetch first instruction
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &frm = frame_arena_[frame_count_ - 1];
-        if (frm.ip >= frm.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(frm.function->instructions[frm.ip].opcode)];
-    }
+    DISPATCH();
 
     // --- Hot opcodes (most frequent in self-hosted compilation) ---
 
 op_LOAD_CONST: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
-    uint32_t saved_ip = frm.ip;
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     pushStack(getConstant(inst.operands[0].asInt()));
     counter++;
@@ -738,14 +842,6 @@ op_LOAD_CONST: {
         if (exit_requested_.load()) return;
         maybeCollectGarbage();
         periodicYieldCheck();
-        if (suspension_requested_) { 
-            // Transfer suspension info to last_suspension_* so caller can handle it
-            last_suspension_reason_ = suspension_reason_;
-            last_suspension_context_ = suspension_context_;
-            suspension_requested_ = false;
-            suspension_context_ = nullptr;
-            return; 
-        }
         // Check for suspension request (e.g., channel receive, thread join)
         if (suspension_requested_) {
             last_suspension_reason_ = suspension_reason_;
@@ -759,24 +855,13 @@ op_LOAD_CONST: {
             if (exit_requested_.load()) return;
         }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            Instruction retInst{OpCode::RETURN};
-            try { executeInstruction(retInst); } catch (...) { throw; }
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_LOAD_VAR: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
-    uint32_t saved_ip = frm.ip;
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     uint32_t var_index = inst.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -789,23 +874,13 @@ op_LOAD_VAR: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_STORE_VAR: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
-    uint32_t saved_ip = frm.ip;
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     uint32_t var_index = inst.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -822,21 +897,12 @@ op_STORE_VAR: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_POP: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     popStack();
     counter++;
@@ -846,45 +912,27 @@ op_POP: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_PUSH_NULL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     pushStack(Value::makeNull());
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_CALL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     // ip now points at the instruction AFTER this CALL — the exact address
     // a coroutine yield must return to. Stash it for doCall's resume path.
     pending_call_return_ip_ = static_cast<int32_t>(frm.ip);
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const ScriptThrow &thrown) {
         ::havel::stdlib::notifyRuntimeError(thrown.value.toString());
         if (!handleScriptThrow(thrown.value)) {
@@ -901,9 +949,6 @@ op_CALL: {
     }
     // IMMEDIATE check for suspension after CALL - host functions may request suspension
     if (suspension_requested_ || last_suspension_reason_ != 0) {
-        if (std::getenv("HAVEL_TRACE_SLEEP")) {
-            // fprintf(stderr, "[SLEEPDBG] op_CALL susp_reason=%d last_reason=%d executing_fiber=%d\n", (int)suspension_reason_, (int)last_suspension_reason_, current_executing_fiber_ ? 1 : 0);
-        }
         // If it's a SLEEP suspension, handle it immediately like the periodic check does
         if (suspension_reason_ == static_cast<uint8_t>(SuspensionReason::SLEEP)) {
             if (scheduler_ && current_executing_fiber_) {
@@ -930,22 +975,15 @@ op_CALL: {
         }
     }
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_RETURN: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const ScriptThrow &thrown) {
         ::havel::stdlib::notifyRuntimeError(thrown.value.toString());
         if (!handleScriptThrow(thrown.value)) {
@@ -955,22 +993,13 @@ op_RETURN: {
         ::havel::stdlib::notifyRuntimeError(e.what());
         throw std::runtime_error(e.what());
     }
-if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-        {
-            auto &f2 = frame_arena_[frame_count_ - 1];
-            if (f2.ip >= f2.function->instructions.size()) {
-                stack.push(nullptr);
-                executeInstruction(Instruction{OpCode::RETURN});
-                return;
-            }
-            goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-        }
+    DISPATCH();
 }
 
 op_YIELD: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     
     // Check if there's a value on the stack to yield
@@ -987,71 +1016,29 @@ op_YIELD: {
     if (current_coroutine_id_ != UINT32_MAX) {
         auto *co = heap_.coroutine(current_coroutine_id_);
         if (co) {
-            auto saved_ip = frm.ip;
-            co->ip = saved_ip;
-            co->locals = locals;
-
-            co->stack.clear();
-            {
-                std::vector<Value> tmp;
-                while (!stack.empty()) {
-                    tmp.push_back(stack.top());
-                    stack.pop();
-                }
-                for (auto it = tmp.rbegin(); it != tmp.rend(); ++it) {
-                    co->stack.push_back(*it);
-                }
-            }
-
+            co->ip = frm.ip;
             co->state = GCHeap::Coroutine::Waiting;
-
-            if (!co->caller_stack.empty()) {
-                auto &caller = co->caller_stack.back();
-                frame_count_ = caller.frame_count;
-                locals = caller.locals;
-                current_coroutine_id_ = caller.coroutine_id;
-
-                frame_arena_[frame_count_ - 1].ip = caller.ip;
-
-                stack = std::stack<Value>();
-                for (auto it = caller.stack.begin(); it != caller.stack.end(); ++it) {
-                    stack.push(*it);
-                }
-
-                co->caller_stack.pop_back();
-            }
+            leaveCoroutine(*co);
 
             pushStack(yieldValue);
-            goto dispatch_next;
+            DISPATCH();
         }
     }
 
     // Non-coroutine yield: keep the value on the stack and continue
     pushStack(yieldValue);
-    goto dispatch_next;
+    DISPATCH();
 }
 
-dispatch_next:
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
-
     // --- Remaining opcodes: delegate to executeInstruction ---
 
 op_LOAD_GLOBAL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const ScriptThrow &thrown) {
         ::havel::stdlib::notifyRuntimeError(thrown.value.toString());
         if (!handleScriptThrow(thrown.value)) {
@@ -1073,25 +1060,16 @@ op_LOAD_GLOBAL: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_STORE_GLOBAL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const std::runtime_error &e) {
         Value exceptionValue = Value::makeStringId(heap_.allocateString(e.what()).id);
         ::havel::stdlib::notifyRuntimeError(e.what());
@@ -1108,25 +1086,16 @@ op_STORE_GLOBAL: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_STORE_IMMUT_GLOBAL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const std::runtime_error &e) {
         Value exceptionValue = Value::makeStringId(heap_.allocateString(e.what()).id);
         ::havel::stdlib::notifyRuntimeError(e.what());
@@ -1142,25 +1111,16 @@ op_STORE_IMMUT_GLOBAL: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_STORE_IMMUT_VAR: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const std::runtime_error &e) {
         throw std::runtime_error(e.what());
     }
@@ -1171,23 +1131,14 @@ op_STORE_IMMUT_VAR: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_LOAD_UPVALUE: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
-    try { executeInstruction(frm.function->instructions[frm.ip - 1]); }
+    try { dispatchInstruction(code[frm.ip - 1]); }
     catch (const std::runtime_error &e) { throw std::runtime_error(e.what()); }
     counter++;
     if ((counter & 8191) == 0) {
@@ -1196,23 +1147,14 @@ op_LOAD_UPVALUE: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_STORE_UPVALUE: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
-    try { executeInstruction(frm.function->instructions[frm.ip - 1]); }
+    try { dispatchInstruction(code[frm.ip - 1]); }
     catch (const std::runtime_error &e) { throw std::runtime_error(e.what()); }
     counter++;
     if ((counter & 8191) == 0) {
@@ -1221,61 +1163,31 @@ op_STORE_UPVALUE: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_DUP: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
-    Value value = popStack();
-    pushStack(value);
-    pushStack(value);
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    if (stack.empty()) stackUnderflow();
+    pushStack(stack.top());
+    DISPATCH();
 }
 
 op_SWAP: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
-    Value top = popStack();
-    Value next = popStack();
-    pushStack(top);
-    pushStack(next);
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    if (stack.size() < 2) stackUnderflow();
+    std::swap(stack.top(), stack[stack.size() - 2]);
+    DISPATCH();
 }
 
 op_INCLOCAL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     uint32_t var_index = inst.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -1297,22 +1209,13 @@ op_INCLOCAL: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_DECLOCAL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     uint32_t var_index = inst.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -1334,22 +1237,13 @@ op_DECLOCAL: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_INCLOCAL_POST: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     uint32_t var_index = inst.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -1368,22 +1262,13 @@ op_INCLOCAL_POST: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_DECLOCAL_POST: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     uint32_t var_index = inst.operands[0].asInt();
     uint32_t abs = this->toAbsoluteLocal(var_index);
@@ -1402,16 +1287,7 @@ op_DECLOCAL_POST: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_ADD: op_SUB: op_MUL: op_DIV:
@@ -1422,8 +1298,8 @@ op_LTE: op_GT: op_GTE:
 op_BIT_AND: op_BIT_OR: op_BIT_XOR:
 op_BIT_LSH: op_BIT_RSH: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     execBinaryOp(inst);
     counter++;
@@ -1433,195 +1309,100 @@ op_BIT_LSH: op_BIT_RSH: {
         periodicYieldCheck();
         if (suspension_requested_) { return; }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_AND: op_OR: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     execLogicalOp(inst.opcode);
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_NOT: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     Value v = popStack();
     pushStack(!isTruthy(v));
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_BIT_NOT: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     Value v = popStack();
     if (v.isInt()) pushStack(~v.asInt());
     else if (v.isDouble()) pushStack(~static_cast<int64_t>(v.asDouble()));
     else COMPILER_THROW("Bitwise NOT requires integer operand");
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_NEGATE: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     execNegate();
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_LENGTH: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     pushStack(execLengthOp(popStack()));
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_JUMP: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     uint32_t target = inst.operands[0].asInt();
     if (target < frm.ip) {
         recordBackedgePublic(frm.ip);
     }
     execJump(inst);
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_JUMP_IF_FALSE: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
-    uint32_t target = inst.operands[0].asInt();
-    Value cond_peek = stack.empty() ? Value::makeNull() : stack.top();
-    if (!isTruthy(cond_peek) && target < frm.ip) {
-        recordBackedgePublic(frm.ip);
-    }
+    const auto &inst = code[frame->ip];
+    recordJumpIfFalseBackedge(inst);
     execJumpIfFalse(inst);
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_JUMP_IF_TRUE: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     uint32_t target = inst.operands[0].asInt();
     Value cond_peek = stack.empty() ? Value::makeNull() : stack.top();
     if (isTruthy(cond_peek) && target < frm.ip) {
         recordBackedgePublic(frm.ip);
     }
     execJumpIfTrue(inst);
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_IS_NULL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
+    auto &frm = *frame;
     frm.ip++;
     Value value = popStack();
     pushStack(Value::makeBool(value.isNull()));
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
 op_JUMP_IF_NULL: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     uint32_t target = inst.operands[0].asInt();
     Value value = popStack();
     if (value.isNull()) {
@@ -1632,23 +1413,161 @@ op_JUMP_IF_NULL: {
     } else {
         frm.ip++;
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
+    DISPATCH();
+}
+
+    // --- Superinstructions (ByteCompiler::fuseSuperinstructions) ---
+    // One dispatch runs the whole sequence. The covered instructions are
+    // still in code[] and are read in place for their operands and opcodes,
+    // and ip is advanced exactly as the plain handlers would, so errors and
+    // type feedback land on the same instruction as the unfused sequence.
+    // Each head reports the instructions it ran in fused_ops, so counter
+    // (GC, yield and event polling) advances as it would unfused.
+
+op_LOAD_VAR_LOAD_CONST_BINOP: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    const Instruction *seq = &code[frm.ip];
+    uint32_t abs = this->toAbsoluteLocal(seq[0].operands[0].asInt());
+    this->ensureLocalIndex(abs);
+    pushStack(locals[abs]);
+    pushStack(getConstant(seq[1].operands[0].asInt()));
+    frm.ip += 3;
+    execBinaryOp(seq[2]);
+    fused_ops = 3;
+    goto superinstruction_done;
+}
+
+op_LOAD_VAR_LOAD_VAR_BINOP: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    const Instruction *seq = &code[frm.ip];
+    uint32_t lhs = this->toAbsoluteLocal(seq[0].operands[0].asInt());
+    uint32_t rhs = this->toAbsoluteLocal(seq[1].operands[0].asInt());
+    this->ensureLocalIndex(std::max(lhs, rhs));
+    pushStack(locals[lhs]);
+    pushStack(locals[rhs]);
+    frm.ip += 3;
+    execBinaryOp(seq[2]);
+    fused_ops = 3;
+    goto superinstruction_done;
+}
+
+op_LOAD_VAR_LOAD_CONST_CMP_JUMP: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    const Instruction *seq = &code[frm.ip];
+    uint32_t abs = this->toAbsoluteLocal(seq[0].operands[0].asInt());
+    this->ensureLocalIndex(abs);
+    pushStack(locals[abs]);
+    pushStack(getConstant(seq[1].operands[0].asInt()));
+    frm.ip += 3;
+    execBinaryOp(seq[2]);
+    // The comparison may have called an operator method; don't reuse frm.
+    recordJumpIfFalseBackedge(seq[3]);
+    execJumpIfFalse(seq[3]);
+    fused_ops = 4;
+    goto superinstruction_done;
+}
+
+op_LOAD_VAR_LOAD_VAR_CMP_JUMP: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    const Instruction *seq = &code[frm.ip];
+    uint32_t lhs = this->toAbsoluteLocal(seq[0].operands[0].asInt());
+    uint32_t rhs = this->toAbsoluteLocal(seq[1].operands[0].asInt());
+    this->ensureLocalIndex(std::max(lhs, rhs));
+    pushStack(locals[lhs]);
+    pushStack(locals[rhs]);
+    frm.ip += 3;
+    execBinaryOp(seq[2]);
+    // The comparison may have called an operator method; don't reuse frm.
+    recordJumpIfFalseBackedge(seq[3]);
+    execJumpIfFalse(seq[3]);
+    fused_ops = 4;
+    goto superinstruction_done;
+}
+
+op_DUP_STORE_VAR_POP: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    uint32_t var_index = code[frm.ip + 1].operands[0].asInt();
+    frm.ip += 2;
+    uint32_t abs = this->toAbsoluteLocal(var_index);
+    this->ensureLocalIndex(abs);
+    if (stack.empty()) stackUnderflow();
+    if (immutable_locals_.count(abs)) {
+        COMPILER_THROW("Cannot reassign val local at index " + std::to_string(var_index));
+    }
+    locals[abs] = popStack();
+    frm.ip++;
+    fused_ops = 3;
+    goto superinstruction_done;
+}
+
+op_DUP_STORE_GLOBAL_POP: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    const auto &store = code[frm.ip + 1];
+    if (stack.empty()) stackUnderflow();
+    frm.ip += 2;
+    try {
+        // STORE_GLOBAL consumes the value the DUP/POP pair would have kept.
+        dispatchInstruction(store);
+        currentFrame().ip++;
+    } catch (const std::runtime_error &e) {
+        Value exceptionValue = Value::makeStringId(heap_.allocateString(e.what()).id);
+        ::havel::stdlib::notifyRuntimeError(e.what());
+        if (handleScriptThrow(exceptionValue)) {
+            // caught
+        } else {
+            throw std::runtime_error(e.what());
         }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
     }
+    fused_ops = 3;
+    goto superinstruction_done;
+}
+
+op_QUICKENED: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
+    if (!execQuickened(inst)) {
+        // Guard miss: the site is generic again, run it through its handler.
+        goto *dispatch_table[static_cast<uint8_t>(inst.opcode)];
+    }
+    frm.ip++;
+    counter++;
+    if ((counter & 8191) == 0) {
+        if (exit_requested_.load()) return;
+        maybeCollectGarbage();
+        periodicYieldCheck();
+        if (suspension_requested_) { return; }
+    }
+    DISPATCH();
+}
+
+superinstruction_done: {
+    if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
+    // A head counting several instructions can step over a multiple of
+    // 8192, so look for a crossing rather than an exact hit.
+    const size_t before = counter;
+    counter += fused_ops;
+    if ((counter >> 13) != (before >> 13)) {
+        if (exit_requested_.load()) return;
+        maybeCollectGarbage();
+        periodicYieldCheck();
+        if (suspension_requested_) { return; }
+        if (!pending_calls.empty()) {
+            processPendingCalls();
+            if (exit_requested_.load()) return;
+        }
+    }
+    DISPATCH();
 }
 
 slow_dispatch_fallback:
     // Suspension or complex opcode encountered — return to caller's slow path
-    if (std::getenv("HAVEL_TRACE_SLEEP")) {
-        // fprintf(stderr, "[SLEEPDBG] slow_dispatch_fallback susp_req=%d reason=%d last_before=%d exec_fiber=%d\n", (int)suspension_requested_, (int)suspension_reason_, (int)last_suspension_reason_, (int)(current_executing_fiber_!=nullptr));
-    }
     if (suspension_requested_) {
         // Transfer suspension info to last_suspension_* so caller can handle it
         last_suspension_reason_ = suspension_reason_;
@@ -1660,14 +1579,14 @@ slow_dispatch_fallback:
 
 op_default: {
     if (suspension_requested_ || last_suspension_reason_ != 0) goto slow_dispatch_fallback;
-    auto &frm = frame_arena_[frame_count_ - 1];
-    const auto &inst = frm.function->instructions[frm.ip];
+    auto &frm = *frame;
+    const auto &inst = code[frm.ip];
     frm.ip++;
     // Stash post-increment ip as the return address for coroutine resumes
     // triggered inside this instruction (e.g. YIELD_RESUME). See VM.hpp.
     pending_call_return_ip_ = static_cast<int32_t>(frm.ip);
     try {
-        executeInstruction(inst);
+        dispatchInstruction(inst);
     } catch (const ScriptThrow &thrown) {
         ::havel::stdlib::notifyRuntimeError(thrown.value.toString());
         if (!handleScriptThrow(thrown.value)) {
@@ -1700,20 +1619,10 @@ op_default: {
             if (exit_requested_.load()) return;
         }
     }
-    if (frame_count_ == 0 || frame_count_ <= stop_frame_depth) return;
-    {
-        auto &f2 = frame_arena_[frame_count_ - 1];
-        if (f2.ip >= f2.function->instructions.size()) {
-            stack.push(nullptr);
-            executeInstruction(Instruction{OpCode::RETURN});
-            return;
-        }
-        goto *dispatch_table[static_cast<uint8_t>(f2.function->instructions[f2.ip].opcode)];
-    }
+    DISPATCH();
 }
 
-#undef DISPATCH_NEXT
-#undef DISPATCH_OP
+#undef DISPATCH
 }
 
 #endif // HAVE_COMPUTED_GOTO
@@ -114,10 +114,10 @@ std::string CallFrameManager::buildStackTrace() const {
     if (frame.function) {
       trace += "  at " + frame.function->name;
       if (frame.ip < frame.function->instructions.size()) {
-        const auto& instr = frame.function->instructions[frame.ip];
-        if (instr.location) {
-          trace += " (" + std::to_string(instr.location->line) + ":" +
-                   std::to_string(instr.location->column) + ")";
+        const auto loc = frame.function->line_table.lookup(frame.ip);
+        if (loc.line > 0) {
+          trace += " (" + std::to_string(loc.line) + ":" +
+                   std::to_string(loc.column) + ")";
         }
       }
       trace += "\n";
@@ -427,7 +427,7 @@ void VMExecutionContext::closeUpvalues(uint32_t localsBase) {
 }
 
 void VMExecutionContext::executeInstruction(const Instruction& instruction) {
-  switch (instruction.opcode) {
+  switch (unfusedOpcode(instruction.opcode)) {
     case OpCode::LOAD_CONST:
       stack_.push(instruction.operands[0]);
       break;
@@ -1692,6 +1692,8 @@ void VM::registerDefaultHostFunctions() {
       typeName = "set";
     else if (value.isRangeId())
       typeName = "range";
+    else if (value.isBytesId())
+      typeName = "bytes";
     else if (value.isHostFuncId())
       typeName = "function";
     else if (value.isClosureId())
@@ -1724,7 +1726,7 @@ void VM::registerDefaultHostFunctions() {
     // Check if value is iterable
     if (value.isArrayId() || value.isStringId() || value.isStringValId() ||
         value.isRegexValId() || value.isObjectId() || value.isSetId() ||
-        value.isRangeId()) {
+        value.isRangeId() || value.isBytesId()) {
       uint32_t iterId = heap_.createIterator(value);
       return Value::makeIteratorId(iterId);
     }
@@ -1780,7 +1782,8 @@ void VM::registerDefaultHostFunctions() {
     bool isIterable = value.isArrayId() || value.isStringId() ||
                       value.isStringValId() || value.isRegexValId() ||
                       value.isObjectId() || value.isSetId() ||
-                      value.isRangeId() || value.isIteratorId();
+                      value.isRangeId() || value.isBytesId() ||
+                      value.isIteratorId();
     return Value::makeBool(isIterable);
   });
 
@@ -1791,7 +1794,8 @@ void VM::registerDefaultHostFunctions() {
     const auto &value = args[0];
     bool isIndexable = value.isArrayId() || value.isStringId() ||
                        value.isStringValId() || value.isRegexValId() ||
-                       value.isObjectId() || value.isSetId();
+                       value.isObjectId() || value.isSetId() ||
+                       value.isBytesId();
     return Value::makeBool(isIndexable);
   });
 
@@ -2529,6 +2533,9 @@ void VM::registerDefaultHostFunctions() {
     setHostObjectField(
         object_ref, "lastPauseNs",
         Value::makeInt(static_cast<int64_t>(stats.last_pause_ns)));
+    setHostObjectField(
+        object_ref, "lastMarkNs",
+        Value::makeInt(static_cast<int64_t>(stats.last_mark_ns)));
     return Value::makeObjectId(object_ref.id);
   });
   registerHostFunction("system_gcStats", 0, [this](const std::vector<Value> &) {
@@ -2544,6 +2551,9 @@ void VM::registerDefaultHostFunctions() {
     setHostObjectField(
         object_ref, "lastPauseNs",
         Value::makeInt(static_cast<int64_t>(stats.last_pause_ns)));
+    setHostObjectField(
+        object_ref, "lastMarkNs",
+        Value::makeInt(static_cast<int64_t>(stats.last_mark_ns)));
     return Value::makeObjectId(object_ref.id);
   });
 
@@ -2938,10 +2948,11 @@ void VM::registerDefaultHostFunctions() {
     if (!args[offset + 1].isStringValId())
       COMPILER_THROW("struct.set second arg must be string");
 
-    auto *instance = heap_.object(args[offset].asObjectId());
+    auto *instance = heap_.objectForStore(args[offset].asObjectId());
     std::string fieldName =
         current_chunk->getString(args[offset + 1].asStringValId());
     instance->set(fieldName, args[offset + 2]);
+    heap_.writeObjectBarrier(args[offset].asObjectId(), args[offset + 2]);
     return Value::makeNull();
   });
 
@@ -2995,9 +3006,9 @@ void VM::registerDefaultHostFunctions() {
             [this, capturedTypeId, capturedTag](const std::vector<Value> &a) {
               EnumRef ref = heap_.allocateEnum(capturedTypeId, capturedTag, 1);
               if (!a.empty()) {
-                auto it = heap_.enums_.find(ref.id);
-                if (it != heap_.enums_.end() && !it->second.second.empty())
-                  it->second.second[0] = a[0];
+                auto *payloads = heap_.enumPayloadsMut(ref.id);
+                if (payloads && !payloads->empty())
+                  (*payloads)[0] = a[0];
               }
               return Value::makeEnumId(ref.id, capturedTypeId);
             });
@@ -3380,10 +3391,11 @@ void VM::registerDefaultHostFunctions() {
     if (!args[offset + 1].isStringValId())
       COMPILER_THROW("class.set second arg must be string");
 
-    auto *instance = heap_.object(args[offset].asObjectId());
+    auto *instance = heap_.objectForStore(args[offset].asObjectId());
     std::string fieldName =
         current_chunk->getString(args[offset + 1].asStringValId());
     instance->set(fieldName, args[offset + 2]);
+    heap_.writeObjectBarrier(args[offset].asObjectId(), args[offset + 2]);
     return Value::makeNull();
   });
 
@@ -3533,18 +3545,7 @@ void VM::registerDefaultHostFunctions() {
 
   registerHostFunction(
       "gc_collect_full", 0, [this](const std::vector<Value> &) -> Value {
-        std::vector<Value> scheduler_roots;
-        if (scheduler_) {
-          scheduler_roots = scheduler_->getGCRoots();
-        }
-        heap_.forceFullCollection(
-            stackValuesForRoots(), locals, globals, activeClosureIdsForRoots(),
-            [this](uint32_t index) -> std::optional<Value> {
-              if (index >= locals.size())
-                return std::nullopt;
-              return locals[index];
-            },
-            scheduler_roots);
+        heap_.forceFullCollection(*this);
         return Value::makeNull();
       });
 
@@ -3560,6 +3561,8 @@ void VM::registerDefaultHostFunctions() {
             Value::makeInt(static_cast<int64_t>(s.collections));
         (*o)["last_pause_ns"] =
             Value::makeInt(static_cast<int64_t>(s.last_pause_ns));
+        (*o)["last_mark_ns"] =
+            Value::makeInt(static_cast<int64_t>(s.last_mark_ns));
         (*o)["total_recovered"] =
             Value::makeInt(static_cast<int64_t>(s.total_recovered));
         (*o)["locals_size"] =
@@ -3656,7 +3659,9 @@ void VM::registerDefaultHostFunctions() {
             }
           }
           if (closure.module_globals) {
-            for (const auto &[gname, gv] : *closure.module_globals) {
+            // The running module's env lives in `globals`, not its table.
+            for (const auto &[gname, gv] :
+                 moduleEnvContents(closure.module_globals)) {
               checked++;
               if (gv.isArrayId() && !heap_.arrayExists(gv.asArrayId())) {
                 invalid++;
@@ -4006,6 +4011,8 @@ void VM::registerDefaultHostFunctions() {
             Value::makeInt(static_cast<int64_t>(s.default_tick_instructions));
         (*o)["hotkey_tick_instructions"] =
             Value::makeInt(static_cast<int64_t>(s.hotkey_tick_instructions));
+        (*o)["tick_quantum_us"] =
+            Value::makeInt(static_cast<int64_t>(s.tick_quantum_us));
         return Value::makeObjectId(objRef.id);
       });
 
@@ -4390,6 +4397,10 @@ void VM::registerDefaultPrototypes() {
   prototypes::registerObjectPrototype(*this);
   prototypes::registerSetPrototype(*this);
   prototypes::registerRangePrototype(*this);
+  prototypes::registerBytesPrototype(*this);
+  // Bytes.alloc / Bytes.from; capitalised like Object so it cannot clash
+  // with the many scripts that name a local `bytes`.
+  registerLazyModule("Bytes", [](VMApi &) {});
 
   registerPrototypeMethodByName("thread", "send", "thread.send");
   registerPrototypeMethodByName("thread", "join", "thread.join");
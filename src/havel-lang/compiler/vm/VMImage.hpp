@@ -3,7 +3,7 @@
  *
  * VM-managed image representation.
  * 
- * Image data is stored in GC heap via ObjectRef.
+ * Image data is stored in GC heap as a byte buffer.
  * This struct is a lightweight wrapper with metadata.
  */
 #pragma once
@@ -26,23 +26,23 @@ enum class PixelFormat : uint8_t {
 /**
  * VMImage - GC-managed image representation
  * 
- * Image data is stored in GC heap as a byte array.
- * This struct contains metadata and a reference to the GC object.
+ * Image data is stored in GC heap as one byte buffer (a `bytes` value to
+ * scripts). This struct contains metadata and a reference to the buffer.
  * 
  * Usage:
  *   VMImage img = vm.createImageFromRGBA(width, height, data);
- *   // img is automatically GC-managed via object_ref
+ *   // img is automatically GC-managed via pixels
  */
 struct VMImage {
     int32_t width = 0;
     int32_t height = 0;
     int32_t stride = 0;  // bytes per row
     PixelFormat format = PixelFormat::BGRA8;
-    ObjectRef object_ref;  // GC-managed object containing byte array
+    BytesRef pixels;  // GC-managed byte buffer holding the pixel data
     
     // Helper: check if valid
     bool isValid() const {
-        return width > 0 && height > 0 && object_ref.id != 0;
+        return width > 0 && height > 0 && pixels.id != 0;
     }
     
     // Helper: total size in bytes
@@ -10,6 +10,14 @@
 #include <string>
 #include <unordered_map>
 
+// Threaded dispatch needs labels-as-values (GCC/Clang). Define
+// HAVEL_NO_COMPUTED_GOTO to force the portable switch loop.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(HAVEL_NO_COMPUTED_GOTO)
+#define HAVE_COMPUTED_GOTO 1
+#else
+#define HAVE_COMPUTED_GOTO 0
+#endif
+
 namespace havel::compiler {
 
 #undef COMPILER_THROW
@@ -23,8 +31,9 @@ do { \
 #define COMPILER_THROW_AT(msg, instr) \
 do { \
     std::string _ct_msg = (msg); \
-    if ((instr).location.has_value() && (instr).location->line > 0) { \
-        _ct_msg += " at " + std::to_string((instr).location->line) + ":" + std::to_string((instr).location->column); \
+    const auto _ct_loc = instructionLocation(currentFunction(), (instr)); \
+    if (_ct_loc.line > 0) { \
+        _ct_msg += " at " + std::to_string(_ct_loc.line) + ":" + std::to_string(_ct_loc.column); \
     } \
     ::havel::errors::ErrorReporter::instance().report( \
     HAVEL_ERROR(::havel::errors::ErrorStage::VM, _ct_msg)); \
@@ -116,22 +125,25 @@ inline std::optional<std::string> keyFromValue(const Value &value, const GCHeap
 }
 
 inline std::string formatSourceLocation(const BytecodeFunction &function, size_t ip) {
-    if (ip >= function.instruction_locations.size()) return "<unknown>";
-    const auto &location = function.instruction_locations[ip];
+    if (ip >= function.line_table.size()) return "<unknown>";
+    const auto location = function.line_table.lookup(ip);
     if (location.line == 0 && location.column == 0) return "<unknown>";
     return std::to_string(location.line) + ":" + std::to_string(location.column);
 }
 
 inline SourceLocation nearestSourceLocation(const BytecodeFunction &function, size_t ip) {
-    if (function.instruction_locations.empty()) return {};
-    size_t idx = std::min(ip, function.instruction_locations.size() - 1);
-    while (true) {
-        const auto &loc = function.instruction_locations[idx];
-        if (loc.line > 0) return loc;
-        if (idx == 0) break;
-        --idx;
-    }
-    return {};
+    return function.line_table.nearest(ip);
+}
+
+// Location of an instruction referenced by address. Handlers receive the
+// instruction by reference, and its offset in the owning code array is exact
+// regardless of whether the dispatch loop has already advanced frame.ip.
+inline SourceLocation instructionLocation(const BytecodeFunction *function,
+                                          const Instruction &instr) {
+    if (!function || function->instructions.empty()) return {};
+    const Instruction *base = function->instructions.data();
+    if (&instr < base || &instr >= base + function->instructions.size()) return {};
+    return function->line_table.lookup(static_cast<size_t>(&instr - base));
 }
 
 } // namespace havel::compiler
@@ -2,14 +2,17 @@
 #include "VMInternals.hpp"
 #include "../../../utils/Logger.hpp"
 #include "../../utils/ErrorPrinter.hpp"
+#include "../../runtime/concurrency/DependencyTracker.hpp"
 
 #include <set>
 #include <sstream>
+#include <utility>
 
 namespace havel::compiler {
 
-void VM::registerHostFunction(const std::string &name,
-    BytecodeHostFunction function) {
+uint32_t VM::installHostFunction(const std::string &name,
+                                 BytecodeHostFunction by_name,
+                                 HostFunctionEntry entry) {
     auto it = host_functions.find(name);
     if (it != host_functions.end()) {
         auto rootIt = host_function_gc_roots_.find(name);
@@ -18,16 +21,50 @@ void VM::registerHostFunction(const std::string &name,
             host_function_gc_roots_.erase(rootIt);
         }
     }
-    host_functions[name] = std::move(function);
-  for (uint32_t i = 0; i < host_function_names_.size(); i++) {
-    if (host_function_names_[i] == name) {
-      host_function_globals_[name] = Value::makeHostFuncId(i);
-      return;
-    }
-  }
+    host_functions[name] = std::move(by_name);
     uint32_t idx = static_cast<uint32_t>(host_function_names_.size());
-    host_function_names_.push_back(name);
-    host_function_globals_[name] = Value::makeHostFuncId(idx);
+    for (uint32_t i = 0; i < host_function_names_.size(); i++) {
+        if (host_function_names_[i] == name) {
+            idx = i;
+            break;
+        }
+    }
+    if (idx == host_function_names_.size()) {
+        host_function_names_.push_back(name);
+    }
+    setHostFunctionGlobal(name, Value::makeHostFuncId(idx));
+    if (host_function_table_.size() <= idx) {
+        host_function_table_.resize(idx + 1);
+    }
+    host_function_table_[idx] = std::move(entry);
+    return idx;
+}
+
+void VM::registerHostFunction(const std::string &name,
+    BytecodeHostFunction function) {
+    // Vector-ABI functions copy the argument view into a vector per call.
+    HostFunctionEntry entry;
+    entry.call = [function](HostArgs args) {
+        return function(std::vector<Value>(args.begin(), args.end()));
+    };
+    installHostFunction(name, std::move(function), std::move(entry));
+}
+
+void VM::registerFastHostFunction(const std::string &name,
+                                  HostFastFunction function, int32_t arity) {
+    // Name-based callers (invokeHostFunctionDirect, getHostFunctions) still
+    // see a vector function; it views the vector in place.
+    BytecodeHostFunction by_name =
+        [function, arity, name](const std::vector<Value> &args) -> Value {
+            if (arity >= 0 && args.size() != static_cast<size_t>(arity)) {
+                COMPILER_THROW("Host function '" + name + "' expects " +
+                    std::to_string(arity) + " arguments, got " +
+                    std::to_string(args.size()));
+            }
+            return function(HostArgs(args));
+        };
+    installHostFunction(name, std::move(by_name),
+                        HostFunctionEntry{std::move(function), arity});
 }
 
 void VM::registerHostFunction(const std::string &name, size_t arity,
@@ -73,9 +110,30 @@ StringRef VM::createRuntimeString(std::string value) {
   return heap_.allocateString(std::move(value));
 }
 
+Value VM::concatStrings(Value left, Value right) {
+  const bool long_left = left.isStringId() &&
+      heap_.stringLength(left.asStringId()) >= GCHeap::kRopeMinLength;
+  const bool long_right = right.isStringId() &&
+      heap_.stringLength(right.asStringId()) >= GCHeap::kRopeMinLength;
+  if (long_left || long_right || (left.isStringId() && right.isStringId())) {
+    // Give the other side a heap id (chunk constants, numbers, ...) and let
+    // the heap decide between copying and a rope. Only one side can need an
+    // allocation here, so nothing is left unrooted across a toString() call.
+    auto heapId = [this](const Value &v) {
+      return v.isStringId() ? v.asStringId()
+                            : heap_.allocateString(toString(v)).id;
+    };
+    const uint32_t l = heapId(left);
+    const uint32_t r = heapId(right);
+    return Value::makeStringId(heap_.concatStrings(l, r).id);
+  }
+  std::string joined = toString(left);
+  joined += toString(right);
+  return Value::makeStringId(heap_.allocateString(std::move(joined)).id);
+}
+
 size_t VM::getRuntimeStringLength(StringRef string_ref) {
-  auto *str = heap_.string(string_ref.id);
-  return str ? str->length() : 0;
+  return heap_.stringLength(string_ref.id);
 }
 
  void VM::setHostObjectField(ObjectRef object_ref, const std::string &key,
@@ -120,8 +178,7 @@ Value VM::execLengthOp(Value v) {
  if (typeIt != prototypes_.end()) {
  auto methodIt = typeIt->second.find("len");
  if (methodIt != typeIt->second.end()) {
- auto fnIt = host_functions.find(host_function_names_[methodIt->second]);
- if (fnIt != host_functions.end()) return fnIt->second({v});
+ if (hostEntry(methodIt->second)) return callHostEntry(methodIt->second, HostArgs(&v, 1));
  }
  }
  }
@@ -141,8 +198,7 @@ Value VM::execLengthOp(Value v) {
  if (typeIt != prototypes_.end()) {
  auto methodIt = typeIt->second.find("len");
   if (methodIt != typeIt->second.end()) {
-  auto fnIt = host_functions.find(host_function_names_[methodIt->second]);
-  if (fnIt != host_functions.end()) return fnIt->second({v});
+  if (hostEntry(methodIt->second)) return callHostEntry(methodIt->second, HostArgs(&v, 1));
   }
   }
   }
@@ -230,27 +286,27 @@ EnumRef VM::createEnum(uint32_t typeId, uint32_t tag, size_t payloadCount) {
 uint32_t VM::getEnumTag(EnumRef enum_ref) { return heap_.enumTag(enum_ref.id); }
 
 Value VM::getEnumPayload(EnumRef enum_ref, size_t index) {
-  auto it = heap_.enums_.find(enum_ref.id);
-  if (it == heap_.enums_.end() || index >= it->second.second.size()) {
+  const auto *payloads = heap_.enumPayloads(enum_ref.id);
+  if (!payloads || index >= payloads->size()) {
     return Value::makeNull();
   }
-  return it->second.second[index];
+  return (*payloads)[index];
 }
 
 void VM::setEnumPayload(EnumRef enum_ref, size_t index,
                         const Value &value) {
-  auto it = heap_.enums_.find(enum_ref.id);
-  if (it == heap_.enums_.end() || index >= it->second.second.size()) {
+  auto *payloads = heap_.enumPayloadsMut(enum_ref.id);
+  if (!payloads || index >= payloads->size()) {
     return;
   }
-  it->second.second[index] = value;
+  (*payloads)[index] = value;
 }
 
 uint32_t VM::getEnumPayloadCount(EnumRef enum_ref) {
-  auto it = heap_.enums_.find(enum_ref.id);
-  if (it == heap_.enums_.end())
+  const auto *payloads = heap_.enumPayloads(enum_ref.id);
+  if (!payloads)
     return 0;
-  return static_cast<uint32_t>(it->second.second.size());
+  return static_cast<uint32_t>(payloads->size());
 }
 
 std::string VM::getEnumTypeName(uint32_t typeId) const {
@@ -320,7 +376,7 @@ IteratorRef VM::createIterator(const Value &iterable) {
     if (iterable.isStringValId()) {
         if (current_chunk) {
             const std::string &src = current_chunk->getString(iterable.asStringValId());
-            auto strRef = heap_.allocateString(src);
+            auto strRef = heap_.internString(src);
             effective = Value::makeStringId(strRef.id);
         }
     }
@@ -346,7 +402,7 @@ Value VM::iteratorNext(IteratorRef iterRef) {
       return Value::makeObjectId(resultObj.id);
     }
     auto key = iter->keys[iter->index++];
-    auto keyStrRef = heap_.allocateString(key);
+    auto keyStrRef = heap_.internString(key);
     Value first = Value::makeStringId(keyStrRef.id);
     Value second = Value::makeNull();
     auto it = globals.find(key);
@@ -381,12 +437,7 @@ std::vector<std::string> VM::getHostObjectKeys(ObjectRef object_ref) {
   auto *object = heap_.object(object_ref.id);
   if (!object)
     return {};
-  std::vector<std::string> keys;
-  keys.reserve(object->size());
-  for (const auto &[key, value] : *object) {
-    keys.push_back(key);
-  }
-  return keys;
+  return object->getKeys();
 }
 
 std::vector<std::pair<std::string, Value>>
@@ -472,20 +523,56 @@ Value VM::getHostObjectField(ObjectRef object_ref,
   }
 
 // Function calling
+Value VM::callHostEntry(uint32_t index, HostArgs args) {
+  const HostFunctionEntry *entry = hostEntry(index);
+  if (!entry) {
+    if (index >= host_function_names_.size()) {
+      COMPILER_THROW("Host function index out of range: " +
+                     std::to_string(index));
+    }
+    COMPILER_THROW("Host function not found: " + host_function_names_[index]);
+  }
+  if (entry->arity >= 0 && args.size() != static_cast<size_t>(entry->arity)) {
+    COMPILER_THROW("Host function '" + host_function_names_[index] +
+                   "' expects " + std::to_string(entry->arity) +
+                   " arguments, got " + std::to_string(args.size()));
+  }
+  return entry->call(args);
+}
+
+void VM::pushHostResult(uint32_t index, HostArgs args) {
+  gc_suspend_counter_++;
+  Value result = callHostEntry(index, args);
+  gc_suspend_counter_--;
+  pushStack(result);
+  maybeCollectGarbage();
+
+  // Check for suspension request after host function returns
+  if (suspension_requested_) {
+    // Propagate into last_suspension_* so the caller (scheduler) reads the
+    // correct reason. Previously this only invoked yield_callback_, which
+    // re-entered the scheduler inline and clobbered the active suspension
+    // state (other goroutines also set suspension_requested_), so main's
+    // sleep suspend was lost and execution ran to completion.
+    last_suspension_reason_ = suspension_reason_;
+    last_suspension_context_ = suspension_context_;
+  }
+}
+
+void VM::callHostFromStack(uint32_t index, uint32_t arg_count) {
+  // Same entry bookkeeping as doCall.
+  tail_call_depth_ = 0;
+  pending_call_return_ip_ = -1;
+  std::array<Value, kHostInlineArgs> argv;
+  std::copy(stack.end() - arg_count, stack.end(), argv.begin());
+  stack.truncate(stack.size() - arg_count - 1);
+  pushHostResult(index, HostArgs(argv.data(), arg_count));
+}
+
 Value VM::callHostFunction(const Value &fn,
                                     const std::vector<Value> &args) {
   if (fn.isHostFuncId()) {
-    uint32_t host_func_idx = fn.asHostFuncId();
-    if (host_func_idx >= host_function_names_.size()) {
-      COMPILER_THROW("Host function index out of range: " +
-                     std::to_string(host_func_idx));
-    }
-    const std::string &name = host_function_names_[host_func_idx];
-    auto it = host_functions.find(name);
-    if (it == host_functions.end()) {
-      COMPILER_THROW("Host function not found: " + name);
-    }
-    return it->second(args);
+    return callHostEntry(fn.asHostFuncId(), args);
   }
   return Value::makeNull();
 }
@@ -507,6 +594,7 @@ void VM::registerPrototypeMethod(const std::string &typeName,
                                  const std::string &methodName,
                                  uint32_t hostFuncIndex) {
   prototypes_[typeName][methodName] = hostFuncIndex;
+  ++prototype_epoch_;
 }
 
 void VM::registerPrototypeMethodByName(const std::string &typeName,
@@ -516,11 +604,13 @@ void VM::registerPrototypeMethodByName(const std::string &typeName,
     for (size_t i = 0; i < host_function_names_.size(); ++i) {
         if (host_function_names_[i] == funcName) {
         prototypes_[typeName][methodName] = static_cast<uint32_t>(i);
+        ++prototype_epoch_;
         return;
         }
     }
     // Not found - register with 0 (will be null)
     prototypes_[typeName][methodName] = 0;
+    ++prototype_epoch_;
 }
 
 std::optional<uint32_t>
@@ -535,6 +625,9 @@ VM::getPrototypeMethod(const Value &value,
   } else if (value.isArrayId()) {
     typeName = "array";
     moduleName = "array";
+  } else if (value.isBytesId()) {
+    typeName = "bytes";
+    moduleName = "Bytes";
   } else if (value.isObjectId()) {
     typeName = "object";
     moduleName = "Object"; // Object module uses capital O
@@ -578,6 +671,7 @@ VM::getPrototypeMethod(const Value &value,
                   } else {
                     classIt->second[methodName] = idx;
                   }
+                  ++prototype_epoch_;
                   return idx;
                 }
               }
@@ -625,6 +719,7 @@ VM::getPrototypeMethod(const Value &value,
             } else {
               typeIt->second[methodName] = idx;
             }
+            ++prototype_epoch_;
             return idx;
           }
           // If it's a closure or function object, we need to handle it differently
@@ -714,6 +809,7 @@ std::string VM::getTypeName(const Value &value) const {
   if (value.isArrayId()) return "array";
   if (value.isSetId()) return "set";
   if (value.isRangeId()) return "range";
+  if (value.isBytesId()) return "bytes";
   if (value.isHostFuncId()) return "hostfunc";
   if (value.isClosureId()) return "closure";
   if (value.isFunctionObjId()) return "fn";
@@ -726,18 +822,18 @@ std::string VM::getTypeName(const Value &value) const {
   const auto *obj = heap_.object(value.asObjectId());
   if (!obj) return "";
   // Check __name on the object itself (struct/class prototypes store __name)
-  auto nameIt = obj->data.find("__name");
-  if (nameIt != obj->data.end() && nameIt->second.isStringValId() && current_chunk) {
+  auto nameIt = obj->find("__name");
+  if (nameIt != obj->end() && nameIt->second.isStringValId() && current_chunk) {
     return current_chunk->getString(nameIt->second.asStringValId());
   }
   // Walk __class/__struct prototype chain for __name
   for (const char *protoKey : {"__class", "__struct"}) {
-    auto protoIt = obj->data.find(protoKey);
-    if (protoIt != obj->data.end() && protoIt->second.isObjectId()) {
+    auto protoIt = obj->find(protoKey);
+    if (protoIt != obj->end() && protoIt->second.isObjectId()) {
       const auto *proto = heap_.object(protoIt->second.asObjectId());
       if (proto) {
-        auto pnIt = proto->data.find("__name");
-        if (pnIt != proto->data.end() && pnIt->second.isStringValId() && current_chunk) {
+        auto pnIt = proto->find("__name");
+        if (pnIt != proto->end() && pnIt->second.isStringValId() && current_chunk) {
           return current_chunk->getString(pnIt->second.asStringValId());
         }
       }
@@ -776,4 +872,290 @@ void VM::pinModuleCacheExports(const std::string &key, const Value &exports) {
 }
 
 
+// ============================================================================
+// Property inline caches (OBJECT_GET / OBJECT_SET / CALL_METHOD)
+//
+// A way is only filled for resolutions the shape alone pins down: the keys
+// that steer the slow paths (__lazy__, __is_class/__is_struct, __autosave_root,
+// the prototype links) are part of the layout, so an object with the cached
+// shape takes the same path. Values that can change without a layout change
+// (prototype link targets, a string __class, the method found) are re-checked
+// on every hit, and anything else falls back to the slow path.
+// ============================================================================
+
+namespace {
+constexpr std::array<const char *, 4> kPrototypeLinks = {"__proto", "__class",
+                                                         "__struct", "__parent"};
+} // namespace
+
+// Constant string keys only: heap string ids can be reused after a
+// collection, constant-table indices can't.
+bool VM::propertyCacheKey(const Value &key) const {
+  return key.isStringValId();
+}
+
+const GCHeap::ObjectEntry *
+VM::cachedHolder(const PropertyInlineCache::Way &way,
+                 const GCHeap::ObjectEntry *receiver) const {
+  const GCHeap::ObjectEntry *current = receiver;
+  for (uint8_t i = 0; i < way.depth; ++i) {
+    const Value link = current->slots[way.link_slots[i]];
+    if (!link.isObjectId()) {
+      return nullptr;
+    }
+    current = heap_.object(link.asObjectId());
+    if (!current || current->shape != way.link_shapes[i]) {
+      return nullptr;
+    }
+  }
+  return current;
+}
+
+// Record where `key` lives relative to `receiver`: the prototype links
+// followed and the holder's slot. OBJECT_GET follows the first of
+// __proto/__class/__struct/__parent present at each level; method lookups
+// (`method_chain`) skip the receiver itself and follow __class (or __struct)
+// once, then __parent. False when the key is further than kMaxDepth links.
+bool VM::recordPrototypePath(PropertyInlineCache::Way &way,
+                             const GCHeap::ObjectEntry &receiver,
+                             const std::string &key, bool method_chain) const {
+  const GCHeap::ObjectEntry *current = &receiver;
+  for (uint8_t depth = 0;; ++depth) {
+    // Dictionary-mode layouts are edited in place, so their slots can't be
+    // remembered by pointer.
+    if (!current->shape->isShared()) {
+      return false;
+    }
+    const ObjectShape &shape = *current->shape;
+    const uint32_t slot = shape.slotOf(key);
+    if (slot != ObjectShape::kNotFound) {
+      if (method_chain && depth == 0) {
+        return false;
+      }
+      way.depth = depth;
+      way.slot = slot;
+      return true;
+    }
+    if (depth == PropertyInlineCache::kMaxDepth) {
+      return false;
+    }
+    uint32_t link = ObjectShape::kNotFound;
+    if (method_chain) {
+      link = depth == 0 ? shape.slotOf("__class") : shape.slotOf("__parent");
+      if (depth == 0 && link == ObjectShape::kNotFound) {
+        link = shape.slotOf("__struct");
+      }
+    } else {
+      for (const char *name : kPrototypeLinks) {
+        link = shape.slotOf(name);
+        if (link != ObjectShape::kNotFound) {
+          break;
+        }
+      }
+    }
+    if (link == ObjectShape::kNotFound || !current->slots[link].isObjectId()) {
+      return false;
+    }
+    current = heap_.object(current->slots[link].asObjectId());
+    if (!current) {
+      return false;
+    }
+    way.link_slots[depth] = link;
+    way.link_shapes[depth] = current->shape;
+  }
+}
+
+bool VM::objectGetFromCache(PropertyInlineCache &ic, const Value &object,
+                            const Value &key) {
+  if (!object.isObjectId() || object.asObjectId() == globals_mirror_object_id_ ||
+      g_active_tracker) {
+    return false;
+  }
+  const auto *obj = std::as_const(heap_).object(object.asObjectId());
+  if (!obj) {
+    return false;
+  }
+  const auto &cf = currentFrame();
+  const BytecodeChunk *chunk = cf.chunk ? cf.chunk : current_chunk;
+  for (uint8_t i = 0; i < ic.count; ++i) {
+    const auto &way = ic.ways[i];
+    if (way.shape != obj->shape || way.key_bits != key.rawBits() ||
+        way.key_chunk != chunk) {
+      continue;
+    }
+    if (way.class_slot != ObjectShape::kNotFound) {
+      const Value &cls = obj->slots[way.class_slot];
+      if (cls.isStringValId() || cls.isStringId()) {
+        return false; // may have a __get_<key> accessor
+      }
+    }
+    const auto *holder = cachedHolder(way, obj);
+    if (!holder) {
+      return false;
+    }
+    const Value value = holder->slots[way.slot];
+    // Null falls through to .len/prototype methods/autovivification, and
+    // inherited functions may be auto-called getters: both stay slow.
+    if (value.isNull() ||
+        (way.depth > 0 && (value.isFunctionObjId() || value.isClosureId()))) {
+      return false;
+    }
+    pushStack(value);
+    return true;
+  }
+  return false;
+}
+
+void VM::fillObjectGetCache(PropertyInlineCache &ic,
+                            const GCHeap::ObjectEntry &obj, const Value &key,
+                            const std::string &key_name) {
+  if (ic.megamorphic() || !propertyCacheKey(key) ||
+      obj.shape->slotOf("__lazy__") != ObjectShape::kNotFound) {
+    return;
+  }
+  PropertyInlineCache::Way way;
+  way.shape = obj.shape;
+  way.key_bits = key.rawBits();
+  const auto &cf = currentFrame();
+  way.key_chunk = cf.chunk ? cf.chunk : current_chunk;
+  way.class_slot = obj.shape->slotOf("__class");
+  if (recordPrototypePath(way, obj, key_name, false)) {
+    ic.add(std::move(way));
+  }
+}
+
+bool VM::objectSetFromCache(PropertyInlineCache &ic, const Value &object,
+                            const Value &key, const Value &value) {
+  if (!object.isObjectId() || object.asObjectId() == globals_mirror_object_id_) {
+    return false;
+  }
+  auto *obj = heap_.objectForStore(object.asObjectId());
+  if (!obj) {
+    return false;
+  }
+  const auto &cf = currentFrame();
+  const BytecodeChunk *chunk = cf.chunk ? cf.chunk : current_chunk;
+  for (uint8_t i = 0; i < ic.count; ++i) {
+    const auto &way = ic.ways[i];
+    if (way.shape != obj->shape || way.key_bits != key.rawBits() ||
+        way.key_chunk != chunk) {
+      continue;
+    }
+    if (way.class_slot != ObjectShape::kNotFound) {
+      const Value &cls = obj->slots[way.class_slot];
+      if (cls.isStringValId() || cls.isStringId()) {
+        return false; // may have a __set_<key> accessor
+      }
+    }
+    if (way.transition) {
+      obj->appendSlot(way.transition, value);
+    } else {
+      obj->storeSlot(way.slot, value);
+    }
+    heap_.writeObjectBarrier(object.asObjectId(), value);
+    return true;
+  }
+  return false;
+}
+
+void VM::fillObjectSetCache(PropertyInlineCache &ic,
+                            const GCHeap::ObjectEntry &obj,
+                            const std::shared_ptr<ObjectShape> &shape_before,
+                            const Value &key, const std::string &key_name) {
+  if (ic.megamorphic() || !propertyCacheKey(key) || !shape_before ||
+      !shape_before->isShared() || !obj.shape->isShared() ||
+      obj.shape->slotOf("__autosave_root") != ObjectShape::kNotFound) {
+    return;
+  }
+  PropertyInlineCache::Way way;
+  way.shape = shape_before;
+  way.key_bits = key.rawBits();
+  const auto &cf = currentFrame();
+  way.key_chunk = cf.chunk ? cf.chunk : current_chunk;
+  way.class_slot = shape_before->slotOf("__class");
+  way.slot = obj.shape->slotOf(key_name);
+  if (obj.shape != shape_before) {
+    // Only a plain append of this one key can be replayed.
+    if (obj.shape->slotCount() != shape_before->slotCount() + 1 ||
+        way.slot != shape_before->slotCount()) {
+      return;
+    }
+    way.transition = obj.shape;
+  }
+  ic.add(std::move(way));
+}
+
+uint8_t VM::methodReceiverTag(const Value &receiver) {
+  if (receiver.isStringValId() || receiver.isStringId() || receiver.isRegexValId())
+    return 1;
+  if (receiver.isInt()) return 2;
+  if (receiver.isDouble()) return 3;
+  if (receiver.isBool()) return 4;
+  if (receiver.isArrayId()) return 5;
+  if (receiver.isSetId()) return 6;
+  if (receiver.isRangeId()) return 7;
+  if (receiver.isChannelId()) return 8;
+  if (receiver.isBytesId()) return 9;
+  return 0;
+}
+
+bool VM::methodFromCache(PropertyInlineCache &ic, const Value &receiver,
+                         MethodTarget &target) {
+  const GCHeap::ObjectEntry *obj = nullptr;
+  uint8_t tag = 0;
+  if (receiver.isObjectId()) {
+    obj = heap_.object(receiver.asObjectId());
+    if (!obj) {
+      return false;
+    }
+  } else {
+    tag = methodReceiverTag(receiver);
+    if (tag == 0) {
+      return false;
+    }
+  }
+  for (uint8_t i = 0; i < ic.count; ++i) {
+    const auto &way = ic.ways[i];
+    if (way.receiver_tag != tag || (obj ? way.shape != obj->shape : way.shape != nullptr)) {
+      continue;
+    }
+    if (way.flags & PropertyInlineCache::kTypePrototype) {
+      if (way.epoch != prototype_epoch_) {
+        return false;
+      }
+      target = MethodTarget{.host = true, .host_index = way.host_index};
+      return true;
+    }
+    if (way.flags & PropertyInlineCache::kNoMethod) {
+      if (way.epoch != prototype_epoch_ || way.globals_epoch != globals.epoch()) {
+        return false;
+      }
+      for (const Value *type_global : way.type_globals) {
+        if (type_global && type_global->isObjectId()) {
+          return false;
+        }
+      }
+      target = MethodTarget{.missing = true};
+      return true;
+    }
+    const auto *holder = cachedHolder(way, obj);
+    if (!holder || holder->slots[way.slot].rawBits() != way.method_bits) {
+      return false;
+    }
+    if (way.flags & PropertyInlineCache::kViaModule) {
+      if (way.epoch != globals.epoch() || !way.module_slot->isObjectId() ||
+          way.module_slot->asObjectId() != receiver.asObjectId()) {
+        return false;
+      }
+    }
+    target.host = (way.flags & PropertyInlineCache::kHostMethod) != 0;
+    target.host_index = way.host_index;
+    target.function = target.host ? Value::makeNull() : holder->slots[way.slot];
+    target.instance_func = (way.flags & PropertyInlineCache::kInstanceFunc) != 0;
+    target.via_module = (way.flags & PropertyInlineCache::kViaModule) != 0;
+    return true;
+  }
+  return false;
+}
+
 } // namespace havel::compiler
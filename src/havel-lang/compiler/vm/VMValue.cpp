@@ -24,6 +24,19 @@ const std::string* VM::getStringPtr(const Value &value) const {
   return nullptr;
 }
 
+const Utf8Index &VM::utf8Index(const Value &value, Utf8Index &scratch) {
+  const std::string *s = getStringPtr(value);
+  if (!s) {
+    scratch = Utf8Index();
+    return scratch;
+  }
+  if (value.isStringId() && s->size() >= Utf8Index::kStride) {
+    return heap_.utf8Index(value.asStringId());
+  }
+  scratch = Utf8Index(*s);
+  return scratch;
+}
+
 bool VM::toBoolPublic(const Value &value) {
   return isTruthy(value);
 }
@@ -229,10 +242,10 @@ return "<struct " + structName + ">";
         if (!set) return "{}";
         std::string result = "{";
     bool first = true;
-    for (const auto &pair : *set) {
+    for (const Value &member : *set) {
       if (!first) result += ", ";
       first = false;
-      result += pair.first;
+      result += toStringInternal(member, visitedIds, depth + 1);
     }
         result += "}";
         return result;
@@ -240,10 +253,10 @@ return "<struct " + structName + ">";
     if (value.isEnumId()) {
         uint32_t enumId = value.asEnumId();
         uint32_t typeId = value.asEnumTypeId();
-        auto it = heap_.enums_.find(enumId);
-        if (it == heap_.enums_.end()) return "<enum:invalid>";
-        uint32_t tag = it->second.first;
-        const auto &payload = it->second.second;
+        const auto *payloads = heap_.enumPayloads(enumId);
+        if (!payloads) return "<enum:invalid>";
+        uint32_t tag = heap_.enumTag(enumId);
+        const auto &payload = *payloads;
         std::string typeName = (typeId < heap_.enumTypes_.size()) ? heap_.enumTypes_[typeId].name : "enum";
         std::string variantName = (typeId < heap_.enumTypes_.size() && tag < heap_.enumTypes_[typeId].variantNames.size())
             ? heap_.enumTypes_[typeId].variantNames[tag] : std::to_string(tag);
@@ -403,6 +416,20 @@ bool VM::valuesEqualDeep(
     return left.asBool() == right.asBool();
   }
 
+  if (left.isStringId() && right.isStringId()) {
+    const uint32_t l_id = left.asStringId();
+    const uint32_t r_id = right.asStringId();
+    if (l_id == r_id) {
+      return true;
+    }
+    if (heap_.isInterned(l_id) && heap_.isInterned(r_id)) {
+      return false;
+    }
+    const std::string *l = heap_.string(l_id);
+    const std::string *r = heap_.string(r_id);
+    return l && r && *l == *r;
+  }
+
   if (auto l = valueAsString(left); l.has_value()) {
     auto r = valueAsString(right);
     return r.has_value() && (*l == *r);
@@ -497,13 +524,13 @@ bool VM::valuesEqualDeep(
         if (left.asEnumId() == right.asEnumId()) return true;
         uint32_t lId = left.asEnumId();
         uint32_t rId = right.asEnumId();
-        auto lIt = heap_.enums_.find(lId);
-        auto rIt = heap_.enums_.find(rId);
-        if (lIt == heap_.enums_.end() || rIt == heap_.enums_.end()) return false;
+        const auto *lPayloads = heap_.enumPayloads(lId);
+        const auto *rPayloads = heap_.enumPayloads(rId);
+        if (!lPayloads || !rPayloads) return false;
         if (left.asEnumTypeId() != right.asEnumTypeId()) return false;
-        if (lIt->second.first != rIt->second.first) return false;
-        const auto &lPayload = lIt->second.second;
-        const auto &rPayload = rIt->second.second;
+        if (heap_.enumTag(lId) != heap_.enumTag(rId)) return false;
+        const auto &lPayload = *lPayloads;
+        const auto &rPayload = *rPayloads;
         if (lPayload.size() != rPayload.size()) return false;
         for (size_t i = 0; i < lPayload.size(); ++i) {
             if (!valuesEqualDeep(lPayload[i], rPayload[i], visited_array_pairs, visited_object_pairs)) return false;
@@ -516,15 +543,9 @@ bool VM::valuesEqualDeep(
       const auto *rset = heap_.set(right.asSetId());
       if (!lset || !rset) return false;
       if (lset->size() != rset->size()) return false;
-      for (const auto &elem : *lset) {
-        bool found = false;
-        for (const auto &r_elem : *rset) {
-          if (valuesEqualDeep(elem.second, r_elem.second, visited_array_pairs, visited_object_pairs)) {
-            found = true;
-            break;
-          }
-        }
-        if (!found) return false;
+      // Canonical members are equal exactly when their bits are.
+      for (const Value &member : *lset) {
+        if (!rset->contains(member)) return false;
       }
       return true;
     }
@@ -538,6 +559,55 @@ std::optional<std::string> VM::resolveKey(const Value &value) const {
     return ::havel::compiler::keyFromValue(value, &heap_, chunk);
 }
 
+Value VM::setMember(const Value &value) {
+    if (value.isStringValId()) {
+        const auto& cf = currentFrame();
+        const BytecodeChunk* chunk = cf.chunk ? cf.chunk : current_chunk;
+        if (chunk) {
+            return Value::makeStringId(
+                heap_.internString(chunk->getString(value.asStringValId())).id);
+        }
+    }
+    return heap_.setMember(value);
+}
+
+std::optional<Value> VM::findSetMember(const Value &value) const {
+    if (value.isStringValId()) {
+        const auto& cf = currentFrame();
+        const BytecodeChunk* chunk = cf.chunk ? cf.chunk : current_chunk;
+        if (chunk) {
+            return heap_.findSetMember(std::string_view(chunk->getString(value.asStringValId())));
+        }
+    }
+    return heap_.findSetMember(value);
+}
+
+bool VM::setHas(uint32_t set_id, const Value &value) const {
+    const auto *set = heap_.set(set_id);
+    if (!set) return false;
+    auto member = findSetMember(value);
+    return member && set->contains(*member);
+}
+
+bool VM::setAdd(uint32_t set_id, const Value &value) {
+    auto *set = heap_.set(set_id);
+    if (!set) return false;
+    const Value member = setMember(value);
+    if (!set->insert(member)) return false;
+    heap_.writeSetBarrier(*set, member);
+    heap_.bumpSetVersion(set_id);
+    return true;
+}
+
+bool VM::setRemove(uint32_t set_id, const Value &value) {
+    auto *set = heap_.set(set_id);
+    if (!set) return false;
+    auto member = findSetMember(value);
+    if (!member || !set->erase(*member)) return false;
+    heap_.bumpSetVersion(set_id);
+    return true;
+}
+
 // Value utility functions
 bool VM::isNull(const Value &value) const {
   return value.isNull();
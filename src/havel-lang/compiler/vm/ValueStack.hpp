@@ -0,0 +1,155 @@
+#pragma once
+
+#include "../../core/Value.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace havel::compiler {
+
+using Value = havel::core::Value;
+
+// ============================================================================
+// ValueStack - contiguous operand stack
+//
+// One pre-reserved block addressed by a raw top pointer, so push/pop in the
+// dispatch loop are a compare plus a pointer bump. Frames address their part
+// of it through CallFrame::stack_depth. The std::stack-style interface
+// (push/pop/top/size/empty) is kept so existing call sites read the same.
+//
+// Growing reallocates the block and moves the values over, which invalidates
+// pointers and references into the stack: hold indices across anything that
+// can push, never Value&. Copies only take the live values, and assigning a
+// saved copy back reuses the live block, so the usual save/restore pattern
+// around re-entrant calls doesn't shrink the VM's reservation.
+//
+// A ValueStack built with capacity 0 owns no block until its first push, and
+// swap() exchanges blocks in O(1): coroutines keep their own stack this way
+// and the VM switches onto it and back without copying values.
+// ============================================================================
+class ValueStack {
+public:
+  static constexpr size_t kDefaultCapacity = 4096;
+
+  ValueStack() { allocate(kDefaultCapacity); }
+  explicit ValueStack(size_t capacity) {
+    if (capacity > 0) {
+      allocate(capacity);
+    }
+  }
+
+  ValueStack(const ValueStack &other) {
+    allocate(std::max<size_t>(other.size(), 16));
+    top_ = std::copy(other.base_, other.top_, base_);
+  }
+  ValueStack(ValueStack &&other) noexcept { take(other); }
+
+  ValueStack &operator=(const ValueStack &other) {
+    if (this != &other) {
+      assign(other.base_, other.top_);
+    }
+    return *this;
+  }
+  ValueStack &operator=(ValueStack &&other) noexcept {
+    if (this == &other) {
+      return *this;
+    }
+    if (capacity() >= other.size() && capacity() >= other.capacity()) {
+      top_ = std::copy(other.base_, other.top_, base_);
+      other.top_ = other.base_;
+    } else {
+      take(other);
+    }
+    return *this;
+  }
+
+  void push(const Value &value) {
+    if (top_ == limit_) [[unlikely]] {
+      grow(size() + 1);
+    }
+    *top_++ = value;
+  }
+  template <typename... Args> void emplace(Args &&...args) {
+    push(Value(std::forward<Args>(args)...));
+  }
+  void pop() { --top_; }
+  // pop() that hands back the value; the caller has checked empty().
+  Value popValue() { return *--top_; }
+  Value &top() { return top_[-1]; }
+  const Value &top() const { return top_[-1]; }
+
+  bool empty() const { return top_ == base_; }
+  bool full() const { return top_ == limit_; }
+  size_t size() const { return static_cast<size_t>(top_ - base_); }
+  size_t capacity() const { return static_cast<size_t>(limit_ - base_); }
+
+  Value &operator[](size_t index) { return base_[index]; }
+  const Value &operator[](size_t index) const { return base_[index]; }
+  Value *data() { return base_; }
+  const Value *data() const { return base_; }
+  Value *begin() { return base_; }
+  Value *end() { return top_; }
+  const Value *begin() const { return base_; }
+  const Value *end() const { return top_; }
+
+  void clear() { top_ = base_; }
+  // Drop everything above `depth` (a frame's stack_depth, a handler's
+  // saved depth). No-op when the stack is already at or below it.
+  void truncate(size_t depth) {
+    if (depth < size()) {
+      top_ = base_ + depth;
+    }
+  }
+  void reserve(size_t capacity) {
+    if (capacity > this->capacity()) {
+      reallocate(capacity);
+    }
+  }
+  void assign(const Value *first, const Value *last) {
+    size_t count = static_cast<size_t>(last - first);
+    if (count > capacity()) {
+      allocate(count);
+    }
+    top_ = std::copy(first, last, base_);
+  }
+  void swap(ValueStack &other) noexcept {
+    std::swap(buffer_, other.buffer_);
+    std::swap(base_, other.base_);
+    std::swap(top_, other.top_);
+    std::swap(limit_, other.limit_);
+  }
+  // Make room for `needed` values, doubling so pushes stay amortized O(1).
+  void grow(size_t needed) {
+    reallocate(std::max(needed, std::max<size_t>(capacity() * 2, 16)));
+  }
+
+private:
+  void allocate(size_t capacity) {
+    buffer_ = std::make_unique<Value[]>(capacity);
+    base_ = top_ = buffer_.get();
+    limit_ = base_ + capacity;
+  }
+  void reallocate(size_t capacity) {
+    auto fresh = std::make_unique<Value[]>(capacity);
+    Value *fresh_top = std::copy(base_, top_, fresh.get());
+    buffer_ = std::move(fresh);
+    base_ = buffer_.get();
+    top_ = fresh_top;
+    limit_ = base_ + capacity;
+  }
+  void take(ValueStack &other) {
+    buffer_ = std::move(other.buffer_);
+    base_ = std::exchange(other.base_, nullptr);
+    top_ = std::exchange(other.top_, nullptr);
+    limit_ = std::exchange(other.limit_, nullptr);
+  }
+
+  std::unique_ptr<Value[]> buffer_;
+  Value *base_ = nullptr;
+  Value *top_ = nullptr;
+  Value *limit_ = nullptr;
+};
+
+} // namespace havel::compiler
@@ -39,6 +39,9 @@ std::string Value::toString() const {
     if (isRangeId()) {
         return "<range:" + std::to_string(asRangeId()) + ">";
     }
+    if (isBytesId()) {
+        return "<bytes:" + std::to_string(asBytesId()) + ">";
+    }
     if (isEnumId()) {
         return "<enum:" + std::to_string(asEnumId()) + ">";
     }
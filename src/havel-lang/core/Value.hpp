@@ -79,6 +79,7 @@ enum class ExtendedTag : uint64_t {
     REGEX_VAL_ID = 0x11, // Regex string literal (stores index into string pool)
   BOUND_METHOD_ID = 0x12, // Bound method (stores index into GC heap)
   WAITGROUP_ID = 0x13, // WaitGroup object (stores index into GC heap)
+  BYTES_ID = 0x14, // Byte buffer / typed view (stores index into GC heap)
 };
 
 // Bool payload values
@@ -322,6 +323,10 @@ public:
     return Value(makeExtendedRaw(static_cast<uint64_t>(ExtendedTag::WAITGROUP_ID), id));
   }
 
+  static Value makeBytesId(uint32_t id) {
+    return Value(makeExtendedRaw(static_cast<uint64_t>(ExtendedTag::BYTES_ID), id));
+  }
+
   static Value makeCoroutineId(uint32_t id) {
     return Value(makeExtendedRaw(static_cast<uint64_t>(ExtendedTag::COROUTINE_ID), id));
   }
@@ -449,6 +454,11 @@ public:
       extractExtendedTag(bits_) == ExtendedTag::WAITGROUP_ID;
   }
 
+  bool isBytesId() const {
+    return isBoxed(bits_) && extractTag(bits_) == ValueTag::EXTENDED &&
+      extractExtendedTag(bits_) == ExtendedTag::BYTES_ID;
+  }
+
   bool isCoroutineId() const {
     return isBoxed(bits_) && extractTag(bits_) == ValueTag::EXTENDED &&
            extractExtendedTag(bits_) == ExtendedTag::COROUTINE_ID;
@@ -577,6 +587,10 @@ public:
     return static_cast<uint32_t>(extractPayload(bits_));
   }
 
+  uint32_t asBytesId() const {
+    return static_cast<uint32_t>(extractPayload(bits_));
+  }
+
   uint32_t asCoroutineId() const {
     return static_cast<uint32_t>(extractPayload(bits_));
   }
@@ -97,6 +97,8 @@ vm_ = std::make_shared<compiler::VM>(*hostContext_, config_.vmConfig);
         compiler::Scheduler::instance().setDefaultTickInstructions(
             config_.vmConfig.goroutine_tick_instructions,
             config_.vmConfig.goroutine_hotkey_tick_instructions);
+        compiler::Scheduler::instance().setTickQuantumMicros(
+            config_.vmConfig.goroutine_tick_micros);
 
 #ifdef HAVEL_ENABLE_LLVM
         const bool wantJIT = config_.vmConfig.tiering_enabled ||
@@ -1,4 +1,5 @@
 #include "ModuleLoader.hpp"
+#include "../compiler/runtime/RuntimeSupport.hpp"
 #include "c/ModulePlugin.h"
 #include "dl/Loader.h"
 #include <algorithm>
@@ -191,6 +192,10 @@ ModuleLoader::resolve(const std::string& modulePath,
   auto checkBcCache = [&](const fs::path& hvcPath, const fs::path& hvPath,
                           const std::string& hashKey) -> std::optional<ResolvedModule> {
     if (!fs::exists(hvcPath)) return std::nullopt;
+    // A cache from another image version is stale whatever its hash says;
+    // resolve to the source so it gets recompiled and rewritten.
+    if (!compiler::ValueSerializer::hasCurrentChunkFormat(hvcPath.string()))
+      return std::nullopt;
 
     // Check persistent hash index first
     loadHashIndex();
@@ -445,7 +450,7 @@ bool ModuleLoader::getCached(const std::string& key, core::Value* outValue) cons
     return true;
 }
 
-bool ModuleLoader::getCachedGlobals(const std::string& key, std::shared_ptr<std::unordered_map<std::string, core::Value>>* outGlobals) const {
+bool ModuleLoader::getCachedGlobals(const std::string& key, compiler::ModuleGlobals* outGlobals) const {
     auto it = cache_.find(key);
     if (it == cache_.end()) {
         return false;
@@ -467,11 +472,11 @@ void ModuleLoader::putCache(const std::string& key, core::Value value,
                                      std::max(mtimeNs(sourcePath), mtimeNs(bytecodePath))};
 }
 
-void ModuleLoader::putCacheWithGlobals(const std::string& key, core::Value value, std::shared_ptr<std::unordered_map<std::string, core::Value>> globals) {
+void ModuleLoader::putCacheWithGlobals(const std::string& key, core::Value value, compiler::ModuleGlobals globals) {
     cache_[key] = CachedModule{value, globals};
 }
 
-void ModuleLoader::putCacheWithGlobals(const std::string& key, core::Value value, std::shared_ptr<std::unordered_map<std::string, core::Value>> globals,
+void ModuleLoader::putCacheWithGlobals(const std::string& key, core::Value value, compiler::ModuleGlobals globals,
                                        const std::string &sourcePath, const std::string &bytecodePath) {
     cache_[key] = CachedModule{value, globals};
     freshness_[key] = CacheFreshness{sourcePath, bytecodePath,
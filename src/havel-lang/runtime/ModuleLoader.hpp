@@ -8,6 +8,7 @@
 #include <unordered_set>
 #include <vector>
 #include "core/Value.hpp"
+#include "compiler/vm/GlobalTable.hpp"
 
 namespace fs_time = std::filesystem;
 
@@ -52,7 +53,7 @@ public:
     // Cached module entry: exports + globals snapshot for internal function calls
     struct CachedModule {
         core::Value exports;
-        std::shared_ptr<std::unordered_map<std::string, core::Value>> globals_snapshot;
+        compiler::ModuleGlobals globals_snapshot;
     };
 
     ModuleLoader() = default;
@@ -85,12 +86,12 @@ public:
     // ========================================================================
     bool isCached(const std::string& key) const;
     bool getCached(const std::string& key, core::Value* outValue) const;
-    bool getCachedGlobals(const std::string& key, std::shared_ptr<std::unordered_map<std::string, core::Value>>* outGlobals) const;
+    bool getCachedGlobals(const std::string& key, compiler::ModuleGlobals* outGlobals) const;
     void putCache(const std::string& key, core::Value value);
     void putCache(const std::string& key, core::Value value,
                   const std::string &sourcePath, const std::string &bytecodePath);
-    void putCacheWithGlobals(const std::string& key, core::Value value, std::shared_ptr<std::unordered_map<std::string, core::Value>> globals);
-    void putCacheWithGlobals(const std::string& key, core::Value value, std::shared_ptr<std::unordered_map<std::string, core::Value>> globals,
+    void putCacheWithGlobals(const std::string& key, core::Value value, compiler::ModuleGlobals globals);
+    void putCacheWithGlobals(const std::string& key, core::Value value, compiler::ModuleGlobals globals,
                              const std::string &sourcePath, const std::string &bytecodePath);
     void clearCache();
     void invalidate(const std::string& key);
@@ -37,6 +37,7 @@ static std::string getTypeName(const Value &value) {
     if (value.isSetId()) return "set";
     if (value.isEnumId()) return "enum";
     if (value.isRangeId()) return "range";
+    if (value.isBytesId()) return "bytes";
     if (value.isThreadId()) return "thread";
     if (value.isIntervalId()) return "interval";
     if (value.isTimeoutId()) return "timeout";
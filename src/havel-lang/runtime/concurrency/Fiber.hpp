@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "../../core/Value.hpp"
+#include "../../compiler/gc/RootVisitor.hpp"
 
 namespace havel::compiler {
 
@@ -28,6 +29,7 @@ using ::havel::core::Value;
  * each frame so suspension can preserve the entire call chain.
  */
 class BytecodeChunk;
+class GlobalTable;
 
 struct CallFrame {
   // ===== FUNCTION IDENTITY =====
@@ -133,6 +135,12 @@ public:
     void reserve(size_t capacity) {
         data_.reserve(capacity);
     }
+
+    // Replace the contents with [first, last), bottom first
+    void assign(const Value* first, const Value* last) {
+        data_.assign(first, last);
+        sp_ = data_.size();
+    }
 };
 
 // ============================================================================
@@ -200,18 +208,25 @@ public:
     // ========== VM STATE (MUST BE PER-FIBER) ==========
     // These are independent for each fiber - NOT shared with global VM
     FiberStack stack;          // Operand stack (values being computed)
-    std::map<std::string, Value> locals;  // Local variables by name
+    std::vector<Value> locals; // Local slots, indexed like VM::locals
     Value return_value;        // Last computed value / return
     
     // ========== GLOBALS SNAPSHOT (per-fiber) ==========
     // globals are shared across all goroutines in the VM, but each goroutine
     // needs its own globals view. When a goroutine yields, its current globals
-    // (and globals_stack_ depth marker) are saved here. When it resumes, they
-    // are restored. has_saved_globals=false on first run (use VM's current).
+    // are saved here; on resume, keys the ambient globals lost are merged back
+    // from it. has_saved_globals=false on first run (use VM's current).
     std::unordered_map<std::string, Value> saved_globals;
-    std::vector<std::unordered_map<std::string, Value>> saved_globals_stack;
-    uint32_t saved_globals_mirror_id = UINT32_MAX;
     bool has_saved_globals = false;
+
+    // ========== MODULE ENVIRONMENTS (per-fiber) ==========
+    // Module envs this fiber's frames entered, outermost first. The VM
+    // leaves them when the fiber is saved and re-enters them when it is
+    // loaded, so another fiber never runs against this one's module globals.
+    std::vector<std::shared_ptr<GlobalTable>> module_envs;
+    // VM throw floor at save time; nonzero when saved inside a callPrepared
+    // callback (see VM::throw_floor_).
+    size_t throw_floor = 0;
     
     // ========== EXECUTION STATE ==========
     FiberState state;
@@ -389,26 +404,32 @@ public:
     // ===== GC SUPPORT =====
     
     /**
-     * Get all Value references from this fiber for GC tracing
+     * Visit all Value references from this fiber for GC tracing
      * The GC must treat all these as roots to prevent collection
      * while the fiber is suspended
      */
-    std::vector<Value> getGCRoots() const {
-        std::vector<Value> roots;
-        
+    void visitGCRoots(RootVisitor& visitor) const {
         // Stack values
         for (const Value& v : stack.data()) {
-            roots.push_back(v);
+            visitor.visit(v);
         }
         
         // Local variables
-        for (const auto& [name, value] : locals) {
-            roots.push_back(value);
+        for (const Value& v : locals) {
+            visitor.visit(v);
         }
         
         // Return value
-        roots.push_back(return_value);
-        
+        visitor.visit(return_value);
+    }
+    
+    /**
+     * Copy of the values visitGCRoots visits
+     */
+    std::vector<Value> getGCRoots() const {
+        std::vector<Value> roots;
+        auto collect = rootVisitor([&roots](const Value& v) { roots.push_back(v); });
+        visitGCRoots(collect);
         return roots;
     }
     
@@ -426,11 +447,8 @@ public:
         // Operand stack
         total += stack.data().capacity() * sizeof(Value);
         
-        // Locals map
-        total += locals.size() * sizeof(void*);
-        for (const auto& [name, value] : locals) {
-            total += name.capacity();  // String storage
-        }
+        // Locals
+        total += locals.capacity() * sizeof(Value);
         
         return total;
     }
@@ -61,7 +61,7 @@ uint32_t Scheduler::spawn(Value callable, const std::vector<Value>& args,
     g->callable = callable;
     g->hotkey_callable = callable;
     g->state = GoroutineState::Created;
-    g->max_instructions_per_tick = (priority == FiberPriority::HOTKEY) ? hotkey_tick_instructions_ : default_tick_instructions_;
+    g->max_instructions_per_tick = tickInstructionsFor(priority);
 
     // Pre-resolve function_id/closure_id for diagnostics and the legacy Fiber
     // constructor (which expects an initial function index). The authoritative
@@ -133,6 +133,7 @@ Scheduler::Goroutine* Scheduler::get(uint32_t id) {
 
 void Scheduler::registerMainGoroutine(Goroutine* g) {
     if (!g) return;
+    g->max_instructions_per_tick = tickInstructionsFor(g->priority);
     {
         std::lock_guard glock(goroutines_mutex_);
         // If there's already a goroutine with ID 1, replace it
@@ -148,6 +149,7 @@ void Scheduler::registerMainGoroutine(Goroutine* g) {
 
 void Scheduler::registerGoroutine(Goroutine* g) {
     if (!g) return;
+    g->max_instructions_per_tick = tickInstructionsFor(g->priority);
     std::lock_guard lock(goroutines_mutex_);
     goroutines_[g->id] = std::unique_ptr<Goroutine>(g);
 }
@@ -333,37 +335,34 @@ void Scheduler::forEachGoroutine(std::function<void(Goroutine*)> fn) {
     }
 }
 
-std::vector<Value> Scheduler::getGCRoots() const {
-    std::vector<Value> roots;
+void Scheduler::visitGCRoots(RootVisitor& visitor) const {
     std::lock_guard lock(goroutines_mutex_);
     for (const auto& [id, g] : goroutines_) {
         if (!g) continue;
         // Primary callable — the goroutine's function/closure identity.
         // Without this root, the closure can be GC-collected while the
         // goroutine is queued (not yet executing on the VM stack).
-        if (!g->callable.isNull()) roots.push_back(g->callable);
+        if (!g->callable.isNull()) visitor.visit(g->callable);
         // Hotkey arm — the version to re-run on each trigger. Separate
         // from callable because hotkeys can swap their callback at runtime.
-        if (!g->hotkey_callable.isNull()) roots.push_back(g->hotkey_callable);
+        if (!g->hotkey_callable.isNull()) visitor.visit(g->hotkey_callable);
         // Stack values (used at spawn, then fiber takes over)
         for (const Value& v : g->stack) {
-            roots.push_back(v);
+            visitor.visit(v);
         }
         // Local variables (used at spawn, then fiber takes over)
         for (const Value& v : g->locals) {
-            roots.push_back(v);
+            visitor.visit(v);
         }
         // Hotkey args
         for (const Value& v : g->hotkey_args) {
-            roots.push_back(v);
+            visitor.visit(v);
         }
         // Fiber state (holds actual execution state when running/suspended)
         if (g->fiber && g->fiber->state != FiberState::DONE) {
-            auto fiber_roots = g->fiber->getGCRoots();
-            roots.insert(roots.end(), fiber_roots.begin(), fiber_roots.end());
+            g->fiber->visitGCRoots(visitor);
         }
     }
-    return roots;
 }
 
 void Scheduler::start() {
@@ -519,6 +518,7 @@ void Scheduler::addActionFiber(Fiber* fiber, FiberPriority priority) {
 	if (!fiber) return;
 
 	auto g = std::make_unique<Scheduler::Goroutine>(fiber->id, fiber->name, priority);
+	g->max_instructions_per_tick = tickInstructionsFor(priority);
 
 	g->function_id = fiber->current_function_id;
 	g->state = GoroutineState::Runnable;
@@ -1248,6 +1248,7 @@ Scheduler::SchedulerSummary Scheduler::getSchedulerSummary() const {
   s.suspended_hotkey_count = suspendedHotkeyCount();
   s.default_tick_instructions = default_tick_instructions_;
   s.hotkey_tick_instructions = hotkey_tick_instructions_;
+  s.tick_quantum_us = tick_quantum_us_;
   {
     auto* cur = current_.load();
     s.current_goroutine_id = cur ? cur->id : 0;
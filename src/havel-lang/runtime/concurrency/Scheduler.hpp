@@ -19,6 +19,7 @@ namespace havel::compiler {
 using ::havel::core::Value;
 
 class BytecodeChunk;
+class RootVisitor;
 
 /**
  * FiberPriority - Execution priority for scheduler
@@ -426,10 +427,10 @@ uint32_t hotkey_callback_id = 0; // CallbackId for looking up DirectCallThunk
     // Calls fn(g) for each goroutine where hotkey_condition_callback_id != 0
     void forEachConditionalHotkey(std::function<void(Goroutine*)> fn);
     /**
-     * Get all GC roots from all goroutines for garbage collection
+     * Visit all GC roots from all goroutines for garbage collection
      * Scans stacks and locals of all goroutines regardless of state
      */
-    std::vector<Value> getGCRoots() const;
+    void visitGCRoots(RootVisitor& visitor) const;
     void forEachGoroutine(std::function<void(Goroutine*)> fn);
 
     // ===== Scheduler Lifecycle =====
@@ -574,12 +575,26 @@ void setCurrent(Goroutine* g) { current_.store(g, std::memory_order_release); }
     // Change the hotkey policy on a goroutine at runtime
     void setHotkeyPolicy(Goroutine* g, HotkeyPolicy policy);
 
+    // Per-quantum instruction budgets. ExecutionEngine runs a goroutine for
+    // up to this many instructions (or the time quantum, whichever ends
+    // first) before returning to the event loop. Applied to every goroutine
+    // the scheduler registers, by priority.
     void setDefaultTickInstructions(uint64_t normal, uint64_t hotkey) {
-        default_tick_instructions_ = normal;
-        hotkey_tick_instructions_ = hotkey;
+        default_tick_instructions_ = normal ? normal : 1;
+        hotkey_tick_instructions_ = hotkey ? hotkey : 1;
     }
     uint64_t defaultTickInstructions() const { return default_tick_instructions_; }
     uint64_t hotkeyTickInstructions() const { return hotkey_tick_instructions_; }
+    uint64_t tickInstructionsFor(FiberPriority priority) const {
+        return priority == FiberPriority::HOTKEY ? hotkey_tick_instructions_
+                                                 : default_tick_instructions_;
+    }
+
+    // Wall-clock bound on one quantum, in microseconds. 0 disables it and
+    // leaves only the instruction budget.
+    static constexpr uint64_t DEFAULT_TICK_QUANTUM_US = 2000;
+    void setTickQuantumMicros(uint64_t us) { tick_quantum_us_ = us; }
+    uint64_t tickQuantumMicros() const { return tick_quantum_us_; }
 
   // Query the hotkey policy on a goroutine
   HotkeyPolicy getHotkeyPolicy(Goroutine* g) const;
@@ -643,6 +658,7 @@ void setCurrent(Goroutine* g) { current_.store(g, std::memory_order_release); }
     uint32_t current_goroutine_id = 0;
     uint64_t default_tick_instructions = 0;
     uint64_t hotkey_tick_instructions = 0;
+    uint64_t tick_quantum_us = 0;
   };
 
   std::vector<GoroutineInfo> getGoroutineList() const;
@@ -757,6 +773,7 @@ private:
     // Configurable tick instructions (set via setDefaultTickInstructions)
     uint64_t default_tick_instructions_ = Goroutine::DEFAULT_MAX_INSTRUCTIONS;
     uint64_t hotkey_tick_instructions_ = Goroutine::HOTKEY_MAX_INSTRUCTIONS;
+    uint64_t tick_quantum_us_ = DEFAULT_TICK_QUANTUM_US;
 };
 
 }  // namespace havel::compiler
\ No newline at end of file
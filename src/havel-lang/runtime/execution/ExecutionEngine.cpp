@@ -6,6 +6,7 @@
 #include "../concurrency/Fiber.hpp"
 #include "../concurrency/DependencyTracker.hpp"
 #include "havel-lang/stdlib/HotkeyModule.hpp"
+#include <chrono>
 #include <iostream>
 
 namespace havel::compiler {
@@ -34,6 +35,10 @@ static Scheduler::SuspensionReason toSchedulerReason(uint8_t fiberReason) {
   }
 }
 
+// Instructions between wall-clock and preempt-fd checks inside a quantum.
+// Must be a power of two.
+static constexpr uint64_t kQuantumCheckInterval = 256;
+
 ExecutionEngine::ExecutionEngine(VM* vm, Scheduler* sched, EventQueue* eq)
     : vm_(vm), scheduler_(sched), event_queue_(eq), running_(true) {
   if (!vm || !sched || !eq) {
@@ -92,6 +97,74 @@ ExecutionEngine::~ExecutionEngine() {
 
 // ============================================================================
 
+void ExecutionEngine::setPreemptFds(std::vector<int> fds) {
+  preempt_fds_ = std::move(fds);
+}
+
+void ExecutionEngine::armPreemptPoll() {
+  preempt_polls_.clear();
+  for (int fd : preempt_fds_) {
+    if (fd >= 0) {
+      preempt_polls_.push_back({fd, POLLIN, 0});
+    }
+  }
+  if (preempt_polls_.empty()) {
+    return;
+  }
+  // Input that was already waiting when the quantum began is not news; the
+  // loop handles it right after this frame either way. Disable those
+  // entries (poll() skips negative fds) so they cannot end every quantum.
+  if (poll(preempt_polls_.data(), preempt_polls_.size(), 0) > 0) {
+    for (auto &p : preempt_polls_) {
+      if (p.revents) {
+        p.fd = -1;
+      }
+      p.revents = 0;
+    }
+  }
+}
+
+bool ExecutionEngine::preemptPending() {
+  if (preempt_polls_.empty()) {
+    return false;
+  }
+  return poll(preempt_polls_.data(), preempt_polls_.size(), 0) > 0;
+}
+
+ExecutionEngine::Quantum ExecutionEngine::beginQuantum(Scheduler::Goroutine* g) {
+  armPreemptPoll();
+  g->instructions_executed = 0;
+  return Quantum{std::chrono::steady_clock::now(),
+                 scheduler_->tickQuantumMicros()};
+}
+
+// Wall time and preempt fds are checked every kQuantumCheckInterval
+// instructions so the clock read and the poll() stay off the
+// per-instruction path.
+bool ExecutionEngine::quantumOver(Scheduler::Goroutine* g, const Quantum& quantum) {
+  if (g->instructions_executed >= g->max_instructions_per_tick) {
+    stats_.quanta_budget_expired++;
+    if (debug_mode_) {
+      std::cerr << "[ExecutionEngine] Goroutine " << g->id << " time slice expired ("
+                << g->max_instructions_per_tick << " instructions), yielding\n";
+    }
+    return true;
+  }
+  if ((g->instructions_executed & (kQuantumCheckInterval - 1)) == 0) {
+    if (quantum.budget_us > 0 &&
+        std::chrono::steady_clock::now() - quantum.start >=
+            std::chrono::microseconds(quantum.budget_us)) {
+      stats_.quanta_time_expired++;
+      return true;
+    }
+    if (preemptPending()) {
+      stats_.quanta_preempted++;
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ExecutionEngine::executeFrame() {
   static int call_count = 0;
   if (call_count < 3 || (call_count < 20 && script_ready_.load())) {
@@ -329,6 +402,8 @@ vm_->saveFiberState(g->fiber);
             g->fiber->state = FiberState::RUNNING;
         }
 
+        const Quantum quantum = beginQuantum(g);
+
         for (;;) {
           // Before running the next step, check if we're close to the tick
           // budget limit. If so, request the JIT to yield at its next
@@ -347,15 +422,11 @@ vm_->saveFiberState(g->fiber);
                 break;
             }
 
-            if (g->instructions_executed >= g->max_instructions_per_tick) {
-                g->instructions_executed = 0;
-                if (debug_mode_) {
-                    std::cerr << "[ExecutionEngine] Goroutine " << g->id << " time slice expired ("
-                              << g->max_instructions_per_tick << " instructions), yielding\n";
-                }
+            if (quantumOver(g, quantum)) {
                 break;
             }
         }
+        g->instructions_executed = 0;
     }
 
 // STEP 5: Save VM state back to fiber
@@ -1015,8 +1086,10 @@ void ExecutionEngine::processGoroutinesInline() {
 
         scheduler_->setCurrent(g);
 
-        for (int i = 0; i < 64; ++i) {
+        const Quantum quantum = beginQuantum(g);
+        for (;;) {
             auto result = vm_->executeOneStep(g->fiber);
+            stats_.instructions_executed++;
             g->instructions_executed++;
             executed++;
             if (vm_->isSuspensionRequested()) {
@@ -1072,8 +1145,7 @@ void ExecutionEngine::processGoroutinesInline() {
                 }
                 break;
             }
-            if (g->instructions_executed >= g->max_instructions_per_tick) {
-                g->instructions_executed = 0;
+            if (quantumOver(g, quantum)) {
                 if (g->fiber) vm_->saveFiberState(g->fiber);
                 handleYield(g);
                 break;
@@ -6,9 +6,12 @@
 #include "../concurrency/Scheduler.hpp"
 #include "../concurrency/WatcherRegistry.hpp"
 
+#include <chrono>
 #include <memory>
 #include <cstdint>
 #include <functional>
+#include <vector>
+#include <poll.h>
 
 namespace havel::compiler {
 
@@ -21,7 +24,7 @@ namespace havel::compiler {
  * 1. Main loop: executeFrame() - called repeatedly by event loop
  * 2. Scheduler integration - picks next runnable goroutine
  * 3. Event queue handling - drains callbacks before each frame
- * 4. Single-step execution - VM::executeOneStep()
+ * 4. Quantum execution - VM::executeOneStep() until the goroutine's budget
  * 5. Result handling - manages goroutine state transitions
  * 
  * Non-blocking: All operations return immediately, no blocking waits.
@@ -42,13 +45,16 @@ public:
    * executeFrame - Core Phase 3 main loop
    * 
    * Called repeatedly by application's event loop (e.g., 60x/second).
-   * Executes one instruction in the next runnable goroutine, then returns.
+   * Runs one quantum of the next runnable goroutine, then returns.
    * 
    * Algorithm:
    * 1. Drain all pending callbacks (EventQueue::processAll)
    * 2. Pick next runnable goroutine (Scheduler::pickNext)
    * 3. If no work, return idle
-   * 4. Execute one instruction (VM::executeOneStep)
+   * 4. Run instructions (VM::executeOneStep) until the goroutine suspends
+   *    or returns, or the quantum ends: max_instructions_per_tick reached,
+   *    Scheduler::tickQuantumMicros() elapsed, or a preempt fd turned
+   *    readable (input is waiting)
    * 5. Handle result (YIELD/SUSPENDED/RETURNED/ERROR)
    * 
    * @return true if work remains, false if all goroutines suspended/done
@@ -77,6 +83,10 @@ public:
     uint64_t goroutines_spawned = 0;
     uint64_t goroutines_completed = 0;
     uint64_t instructions_executed = 0;
+    // Why quanta that were still runnable ended.
+    uint64_t quanta_budget_expired = 0;
+    uint64_t quanta_time_expired = 0;
+    uint64_t quanta_preempted = 0;
   };
   Stats getStats() const { return stats_; }
 
@@ -99,6 +109,11 @@ public:
   VM* getVM() const { return vm_; }
   Scheduler* getScheduler() const { return scheduler_; }
 
+  // Fds whose readiness ends the running quantum early (input devices).
+  // Only a transition to readable counts: fds already readable when the
+  // quantum starts are ignored until the event loop has drained them.
+  void setPreemptFds(std::vector<int> fds);
+
   void setScriptReady(bool ready) { script_ready_.store(ready, std::memory_order_release); }
   bool isScriptReady() const { return script_ready_.load(std::memory_order_acquire); }
 
@@ -126,12 +141,28 @@ private:
   DebugBreakCallback debug_break_cb_;
   bool inline_yield_active_ = false;
   std::unique_ptr<Fiber> main_script_fiber_;
+  std::vector<int> preempt_fds_;
+  std::vector<struct pollfd> preempt_polls_;
   
   // ========== HELPER METHODS ==========
   void handleYield(Scheduler::Goroutine* g);
   void handleSuspended(Scheduler::Goroutine* g);
   void handleReturned(Scheduler::Goroutine* g);
   void handleError(Scheduler::Goroutine* g, const std::string& msg);
+  void armPreemptPoll();
+  bool preemptPending();
+
+  // One goroutine quantum, shared by executeFrame and the inline pump: it
+  // ends when the goroutine's instruction budget is spent,
+  // Scheduler::tickQuantumMicros() has elapsed or a preempt fd turned
+  // readable. beginQuantum resets the goroutine's instruction count;
+  // quantumOver is asked after each instruction.
+  struct Quantum {
+    std::chrono::steady_clock::time_point start;
+    uint64_t budget_us = 0;
+  };
+  Quantum beginQuantum(Scheduler::Goroutine* g);
+  bool quantumOver(Scheduler::Goroutine* g, const Quantum& quantum);
 
 
     void onThreadComplete(uint32_t thread_id);
@@ -5,13 +5,14 @@
 #include <stdexcept>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
 
 void registerArrayModule(const VMApi &api) {
   // array.insert(arr, index, value) - Insert value at index
-  api.registerFunction("array.insert", [api](const std::vector<Value> &args) {
+  api.registerFunction("array.insert", [api](HostArgs args) {
     if (args.size() < 3)
       throw std::runtime_error("array.insert() requires array, index, and value");
     if (!args[0].isArrayId())
@@ -23,7 +24,7 @@ void registerArrayModule(const VMApi &api) {
   });
 
   // array.remove(arr, index) - Remove and return value at index
-  api.registerFunction("array.remove", [api](const std::vector<Value> &args) {
+  api.registerFunction("array.remove", [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("array.remove() requires array and index");
     if (!args[0].isArrayId())
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -37,55 +38,55 @@ static int64_t getInt(const Value &v) {
 }
 
 void registerBitModule(const VMApi &api) {
-    api.registerFunction("bit._popcount", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._popcount", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("bit._popcount() requires an argument");
         return Value(static_cast<int64_t>(popcount64(
             static_cast<uint64_t>(getInt(args[0])))));
     });
 
-    api.registerFunction("bit._ctz", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._ctz", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("bit._ctz() requires an argument");
         uint64_t v = static_cast<uint64_t>(getInt(args[0]));
         if (v == 0) return Value(static_cast<int64_t>(-1));
         return Value(static_cast<int64_t>(ctz64(v)));
     });
 
-    api.registerFunction("bit._clz", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._clz", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("bit._clz() requires an argument");
         uint64_t v = static_cast<uint64_t>(getInt(args[0]));
         if (v == 0) return Value(static_cast<int64_t>(-1));
         return Value(static_cast<int64_t>(63 - clz64(v)));
     });
 
-    api.registerFunction("bit._parity", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._parity", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("bit._parity() requires an argument");
         return Value(static_cast<int64_t>(parity64(
             static_cast<uint64_t>(getInt(args[0])))));
     });
 
-    api.registerFunction("bit._rshift", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._rshift", [](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("bit._rshift() requires value and shift");
         uint64_t v = static_cast<uint64_t>(getInt(args[0]));
         int s = static_cast<int>(getInt(args[1]));
         return Value(static_cast<int64_t>(s >= 0 ? v >> s : v << (-s)));
     });
 
-    api.registerFunction("bit._and", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._and", [](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("bit._and() requires two arguments");
         return Value(getInt(args[0]) & getInt(args[1]));
     });
 
-    api.registerFunction("bit._or", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._or", [](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("bit._or() requires two arguments");
         return Value(getInt(args[0]) | getInt(args[1]));
     });
 
-    api.registerFunction("bit._xor", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._xor", [](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("bit._xor() requires two arguments");
         return Value(getInt(args[0]) ^ getInt(args[1]));
     });
 
-    api.registerFunction("bit._not", [](const std::vector<Value> &args) {
+    api.registerFunction("bit._not", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("bit._not() requires an argument");
         return Value(~getInt(args[0]));
     });
@@ -12,6 +12,7 @@
 #include <array>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 using json = nlohmann::json;
 
@@ -203,7 +204,7 @@ static Value makeTabObj(const json &tab, const VMApi &api) {
 }
 
 void registerBrowserModule(const VMApi &api) {
-  api.registerFunction("browser.connect", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.connect", [api](HostArgs args) {
     auto &st = cdpState();
     std::lock_guard<std::mutex> lock(st.mutex);
     st.browserUrl = "http://localhost:9222";
@@ -220,7 +221,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(true);
   });
 
-  api.registerFunction("browser.disconnect", [](const std::vector<Value> &) {
+  api.registerFunction("browser.disconnect", [](HostArgs) {
     auto &st = cdpState();
     std::lock_guard<std::mutex> lock(st.mutex);
     st.connected = false;
@@ -229,42 +230,42 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(true);
   });
 
-  api.registerFunction("browser.isConnected", [](const std::vector<Value> &) {
+  api.registerFunction("browser.isConnected", [](HostArgs) {
     return Value::makeBool(cdpState().connected);
   });
 
-  api.registerFunction("browser.goto", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.goto", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.goto requires a url");
     std::string url = api.toString(args[0]);
     std::string response = sendCdp("Page.navigate", "{\"url\":\"" + url + "\"}");
     return Value::makeBool(!response.empty() && response.find("\"errorText\"") == std::string::npos);
   });
 
-  api.registerFunction("browser.open", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.open", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.open requires a url");
     std::string url = api.toString(args[0]);
     std::string response = sendCdp("Target.createTarget", "{\"url\":\"" + url + "\",\"newWindow\":true}");
     return Value::makeBool(!response.empty() && response.find("\"targetId\"") != std::string::npos);
   });
 
-  api.registerFunction("browser.newTab", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.newTab", [api](HostArgs args) {
     std::string url;
     if (!args.empty()) url = api.toString(args[0]);
     std::string response = sendCdp("Target.createTarget", "{\"url\":\"" + url + "\",\"newWindow\":true}");
     return Value::makeBool(!response.empty() && response.find("\"targetId\"") != std::string::npos);
   });
 
-  api.registerFunction("browser.back", [](const std::vector<Value> &) {
+  api.registerFunction("browser.back", [](HostArgs) {
     std::string response = sendCdp("Page.navigateToHistoryEntry", "{\"entryId\":-1}");
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.forward", [](const std::vector<Value> &) {
+  api.registerFunction("browser.forward", [](HostArgs) {
     std::string response = sendCdp("Page.navigateToHistoryEntry", "{\"entryId\":1}");
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.reload", [](const std::vector<Value> &args) {
+  api.registerFunction("browser.reload", [](HostArgs args) {
     bool ignoreCache = false;
     if (!args.empty() && args[0].isBool()) ignoreCache = args[0].asBool();
     std::string response = sendCdp("Page.reload",
@@ -272,7 +273,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.listTabs", [api](const std::vector<Value> &) {
+  api.registerFunction("browser.listTabs", [api](HostArgs) {
     auto tabs = getTabs(true);
     auto arr = api.makeArray();
     for (auto &tab : tabs) {
@@ -281,7 +282,7 @@ void registerBrowserModule(const VMApi &api) {
     return arr;
   });
 
-  api.registerFunction("browser.activate", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.activate", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.activate requires a tab id or index");
     auto &st = cdpState();
     int idx = 0;
@@ -310,7 +311,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(true);
   });
 
-  api.registerFunction("browser.closeTab", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.closeTab", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.closeTab requires a tab id");
     std::string targetId;
     if (args[0].isStringId()) {
@@ -326,7 +327,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(!response.empty() && response.find("\"success\":true") != std::string::npos);
   });
 
-  api.registerFunction("browser.closeAll", [](const std::vector<Value> &) {
+  api.registerFunction("browser.closeAll", [](HostArgs) {
     auto tabs = getTabs(true);
     bool allOk = true;
     for (auto &tab : tabs) {
@@ -340,7 +341,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(allOk);
   });
 
-  api.registerFunction("browser.eval", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.eval", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.eval requires javascript code");
     std::string js = escapeJs(api.toString(args[0]));
     std::string fullJs = "JSON.stringify(" + js + ")";
@@ -360,7 +361,7 @@ void registerBrowserModule(const VMApi &api) {
     return api.makeString(response);
   });
 
-  api.registerFunction("browser.click", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.click", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.click requires a selector");
     std::string sel = escapeJs(api.toString(args[0]));
     std::string js = "(function(){try{var el=document.querySelector('" + sel +
@@ -371,7 +372,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(!response.empty() && response.find("\"success\":true") != std::string::npos);
   });
 
-  api.registerFunction("browser.type", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.type", [api](HostArgs args) {
     if (args.size() < 2) throw std::runtime_error("browser.type requires selector and text");
     std::string sel = escapeJs(api.toString(args[0]));
     std::string text = escapeJs(api.toString(args[1]));
@@ -384,7 +385,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(!response.empty() && response.find("true") != std::string::npos);
   });
 
-  api.registerFunction("browser.focus", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.focus", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.focus requires a selector");
     std::string sel = escapeJs(api.toString(args[0]));
     std::string js = "(function(){var el=document.querySelector('" + sel +
@@ -394,7 +395,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(!response.empty() && response.find("true") != std::string::npos);
   });
 
-  api.registerFunction("browser.screenshot", [api](const std::vector<Value> &args) {
+  api.registerFunction("browser.screenshot", [api](HostArgs args) {
     std::string path = "screenshot.png";
     if (!args.empty()) path = api.toString(args[0]);
     std::string response = sendCdp("Page.captureScreenshot", "{\"format\":\"png\"}");
@@ -426,7 +427,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(false);
   });
 
-  api.registerFunction("browser.setZoom", [](const std::vector<Value> &args) {
+  api.registerFunction("browser.setZoom", [](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.setZoom requires a zoom level");
     double level = 1.0;
     if (args[0].isDouble()) level = args[0].asDouble();
@@ -438,7 +439,7 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.getZoom", [](const std::vector<Value> &) {
+  api.registerFunction("browser.getZoom", [](HostArgs) {
     std::string js = "(function(){return document.body.style.zoom||'100%'})()";
     std::string response = sendCdp("Runtime.evaluate",
       "{\"expression\":\"" + js + "\",\"returnByValue\":true}");
@@ -457,12 +458,12 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeDouble(1.0);
   });
 
-  api.registerFunction("browser.resetZoom", [](const std::vector<Value> &) {
+  api.registerFunction("browser.resetZoom", [](HostArgs) {
     std::string response = sendCdp("Emulation.setPageScaleFactor", "{\"scaleFactor\":1.0}");
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.getUrl", [api](const std::vector<Value> &) {
+  api.registerFunction("browser.getUrl", [api](HostArgs) {
     std::string js = "window.location.href";
     std::string response = sendCdp("Runtime.evaluate",
       "{\"expression\":\"" + js + "\",\"returnByValue\":true}");
@@ -477,7 +478,7 @@ void registerBrowserModule(const VMApi &api) {
     return api.makeString("");
   });
 
-  api.registerFunction("browser.getTitle", [api](const std::vector<Value> &) {
+  api.registerFunction("browser.getTitle", [api](HostArgs) {
     std::string js = "document.title";
     std::string response = sendCdp("Runtime.evaluate",
       "{\"expression\":\"" + js + "\",\"returnByValue\":true}");
@@ -492,7 +493,7 @@ void registerBrowserModule(const VMApi &api) {
     return api.makeString("");
   });
 
-  api.registerFunction("browser.listWindows", [api](const std::vector<Value> &) {
+  api.registerFunction("browser.listWindows", [api](HostArgs) {
     auto tabs = getTabs();
     auto arr = api.makeArray();
     std::set<std::string> seen;
@@ -509,25 +510,25 @@ void registerBrowserModule(const VMApi &api) {
     return arr;
   });
 
-  api.registerFunction("browser.maximize", [](const std::vector<Value> &args) {
+  api.registerFunction("browser.maximize", [](HostArgs args) {
     std::string response = sendCdp("Browser.setWindowBounds",
       "{\"windowId\":1,\"bounds\":{\"windowState\":\"maximized\"}}");
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.minimize", [](const std::vector<Value> &args) {
+  api.registerFunction("browser.minimize", [](HostArgs args) {
     std::string response = sendCdp("Browser.setWindowBounds",
       "{\"windowId\":1,\"bounds\":{\"windowState\":\"minimized\"}}");
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.fullscreen", [](const std::vector<Value> &args) {
+  api.registerFunction("browser.fullscreen", [](HostArgs args) {
     std::string response = sendCdp("Browser.setWindowBounds",
       "{\"windowId\":1,\"bounds\":{\"windowState\":\"fullscreen\"}}");
     return Value::makeBool(!response.empty());
   });
 
-  api.registerFunction("browser.setPort", [](const std::vector<Value> &args) {
+  api.registerFunction("browser.setPort", [](HostArgs args) {
     if (args.empty()) throw std::runtime_error("browser.setPort requires a port number");
     auto &st = cdpState();
     std::lock_guard<std::mutex> lock(st.mutex);
@@ -536,11 +537,11 @@ void registerBrowserModule(const VMApi &api) {
     return Value::makeBool(true);
   });
 
-  api.registerFunction("browser.getPort", [](const std::vector<Value> &) {
+  api.registerFunction("browser.getPort", [](HostArgs) {
     return Value::makeInt(cdpState().cdpPort);
   });
 
-  api.registerFunction("browser.getVersion", [api](const std::vector<Value> &) {
+  api.registerFunction("browser.getVersion", [api](HostArgs) {
     std::string response = httpGet(cdpState().browserUrl + "/json/version");
     if (response.empty()) return api.makeString("");
     try {
@@ -551,7 +552,7 @@ void registerBrowserModule(const VMApi &api) {
     }
   });
 
-  api.registerFunction("browser.findPath", [api](const std::vector<Value> &) {
+  api.registerFunction("browser.findPath", [api](HostArgs) {
     return api.makeString(findBrowserPath());
   });
 
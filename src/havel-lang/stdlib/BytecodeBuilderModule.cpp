@@ -11,9 +11,12 @@ using havel::compiler::BytecodeChunk;
 using havel::compiler::BytecodeFunction;
 using havel::compiler::Instruction;
 using havel::compiler::OpCode;
+using havel::compiler::OperandList;
 using havel::compiler::SourceLocation;
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
+using havel::compiler::ValueStack;
 using havel::compiler::VM;
 
 namespace havel::stdlib {
@@ -264,19 +267,19 @@ static OpCode parseOpcode(const std::string &name) {
 }
 
 void registerBytecodeBuilderModule(const VMApi &api) {
-    api.registerFunction("bc.reset", [](const std::vector<Value> &) -> Value {
+    api.registerFunction("bc.reset", [](HostArgs) -> Value {
     auto saved_chunks = std::move(g_builder.stored_chunks);
     g_builder = BuilderState();
     g_builder.stored_chunks = std::move(saved_chunks);
     return Value::makeNull();
     });
 
-    api.registerFunction("bc.clear_stored", [](const std::vector<Value> &) -> Value {
+    api.registerFunction("bc.clear_stored", [](HostArgs) -> Value {
         g_builder.stored_chunks.clear();
         return Value::makeNull();
     });
 
-	api.registerFunction("bc.func_new", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.func_new", [api](HostArgs args) -> Value {
     if (args.size() < 1 || (!args[0].isStringId() && !args[0].isStringValId())) {
         throw std::runtime_error("bc.func_new: requires name (string)");
     }
@@ -300,13 +303,13 @@ void registerBytecodeBuilderModule(const VMApi &api) {
         return Value::makeInt(static_cast<int64_t>(g_builder.current_func_idx));
     });
 
-    api.registerFunction("bc.func_push", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.func_push", [](HostArgs args) -> Value {
         g_builder.saved_func_stack.push_back(g_builder.current_func_idx);
         g_builder.current_func_idx = -1;
         return Value::makeInt(0);
     });
 
-    api.registerFunction("bc.func_pop", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.func_pop", [](HostArgs args) -> Value {
         if (g_builder.saved_func_stack.empty()) {
             throw std::runtime_error("bc.func_pop: no saved function context");
         }
@@ -315,7 +318,7 @@ void registerBytecodeBuilderModule(const VMApi &api) {
         return Value::makeInt(static_cast<int64_t>(g_builder.current_func_idx));
     });
 
-    api.registerFunction("bc.emit", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.emit", [api](HostArgs args) -> Value {
         auto *fn = g_builder.currentFunc();
         if (!fn) throw std::runtime_error("bc.emit: no current function");
     if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
@@ -324,7 +327,8 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     auto opName = api.resolveString(args[0]);
 		OpCode op = parseOpcode(opName);
 
-		std::vector<Value> operands;
+		OperandList operands;
+		operands.reserve(args.size() > 0 ? args.size() - 1 : 0);
 		for (size_t i = 1; i < args.size(); ++i) {
 			operands.push_back(args[i]);
 		}
@@ -335,16 +339,14 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     if (g_builder.current_source_file.isStringId() || g_builder.current_source_file.isStringValId()) {
       srcFile = api.resolveString(g_builder.current_source_file);
     }
-    auto &instr = fn->instructions.back();
-    instr.location = SourceLocation{srcFile, g_builder.current_source_line, g_builder.current_source_col, 0};
-    fn->instruction_locations.push_back(SourceLocation{srcFile, g_builder.current_source_line, g_builder.current_source_col, 0});
+    fn->line_table.append(SourceLocation{srcFile, g_builder.current_source_line, g_builder.current_source_col, 0});
   } else {
-    fn->instruction_locations.push_back(SourceLocation{});
+    fn->line_table.append(SourceLocation{});
   }
   return Value::makeInt(static_cast<int64_t>(ip));
   });
 
-  api.registerFunction("bc.set_source", [](const std::vector<Value> &args) -> Value {
+  api.registerFunction("bc.set_source", [](HostArgs args) -> Value {
     if (args.size() >= 2 && args[0].isInt() && args[1].isInt()) {
       g_builder.current_source_line = static_cast<uint32_t>(args[0].asInt());
       g_builder.current_source_col = static_cast<uint32_t>(args[1].asInt());
@@ -360,7 +362,7 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     return Value::makeInt(0);
   });
 
-  api.registerFunction("bc.clear_source", [](const std::vector<Value> &args) -> Value {
+  api.registerFunction("bc.clear_source", [](HostArgs args) -> Value {
     g_builder.has_source_location = false;
     g_builder.current_source_line = 0;
     g_builder.current_source_col = 0;
@@ -368,7 +370,7 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     return Value::makeInt(0);
   });
 
-  api.registerFunction("bc.set_func_source_line", [](const std::vector<Value> &args) -> Value {
+  api.registerFunction("bc.set_func_source_line", [](HostArgs args) -> Value {
     auto *fn = g_builder.currentFunc();
     if (!fn) throw std::runtime_error("bc.set_func_source_line: no current function");
     if (!args.empty() && args[0].isInt()) {
@@ -377,7 +379,7 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     return Value::makeInt(0);
   });
 
-  api.registerFunction("bc.set_source_file", [api](const std::vector<Value> &args) -> Value {
+  api.registerFunction("bc.set_source_file", [api](HostArgs args) -> Value {
     if (!args.empty() && (args[0].isStringId() || args[0].isStringValId())) {
       g_builder.current_source_file = args[0];
       auto *fn = g_builder.currentFunc();
@@ -388,7 +390,7 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     return Value::makeInt(0);
   });
 
-  api.registerFunction("bc.add_const", [](const std::vector<Value> &args) -> Value {
+  api.registerFunction("bc.add_const", [](HostArgs args) -> Value {
     auto *fn = g_builder.currentFunc();
     if (!fn) throw std::runtime_error("bc.add_const: no current function");
     if (args.empty()) throw std::runtime_error("bc.add_const: requires value");
@@ -401,7 +403,7 @@ void registerBytecodeBuilderModule(const VMApi &api) {
     return Value::makeInt(static_cast<int64_t>(idx));
 });
 
-api.registerFunction("bc.add_string", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.add_string", [api](HostArgs args) -> Value {
   auto *fn = g_builder.currentFunc();
   if (!fn) throw std::runtime_error("bc.add_string: no current function");
   if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
@@ -419,7 +421,7 @@ api.registerFunction("bc.add_string", [api](const std::vector<Value> &args) -> V
   return Value::makeInt(static_cast<int64_t>(idx));
 	});
 
-	api.registerFunction("bc.add_regex", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.add_regex", [api](HostArgs args) -> Value {
 		auto *fn = g_builder.currentFunc();
 		if (!fn) throw std::runtime_error("bc.add_regex: no current function");
 		if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
@@ -437,7 +439,7 @@ api.registerFunction("bc.add_string", [api](const std::vector<Value> &args) -> V
 		return Value::makeInt(static_cast<int64_t>(idx));
 	});
 
-	api.registerFunction("bc.add_chunk_string", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.add_chunk_string", [api](HostArgs args) -> Value {
     if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
         throw std::runtime_error("bc.add_chunk_string: requires string");
     }
@@ -446,7 +448,7 @@ api.registerFunction("bc.add_string", [api](const std::vector<Value> &args) -> V
 		return Value::makeInt(static_cast<int64_t>(idx));
 	});
 
-api.registerFunction("bc.patch_jump", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.patch_jump", [](HostArgs args) -> Value {
 auto *fn = g_builder.currentFunc();
 if (!fn) throw std::runtime_error("bc.patch_jump: no current function");
 if (args.size() < 2 || !args[0].isInt() || !args[1].isInt()) {
@@ -466,7 +468,7 @@ throw std::runtime_error("bc.patch_jump: requires (jump_ip, target_ip)");
         return Value::makeNull();
     });
 
-    api.registerFunction("bc.patch_operand", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.patch_operand", [](HostArgs args) -> Value {
         auto *fn = g_builder.currentFunc();
         if (!fn) throw std::runtime_error("bc.patch_operand: no current function");
         if (args.size() < 3 || !args[0].isInt() || !args[1].isInt() || !args[2].isInt()) {
@@ -486,7 +488,7 @@ throw std::runtime_error("bc.patch_jump: requires (jump_ip, target_ip)");
         return Value::makeNull();
     });
 
-    api.registerFunction("bc.set_local_count", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.set_local_count", [](HostArgs args) -> Value {
         auto *fn = g_builder.currentFunc();
 		if (!fn) throw std::runtime_error("bc.set_local_count: no current function");
 		if (args.empty() || !args[0].isInt()) {
@@ -496,7 +498,7 @@ throw std::runtime_error("bc.patch_jump: requires (jump_ip, target_ip)");
 		return Value::makeNull();
 	});
 
-api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.set_param_count", [](HostArgs args) -> Value {
     auto *fn = g_builder.currentFunc();
     if (!fn) throw std::runtime_error("bc.set_param_count: no current function");
     if (args.empty() || !args[0].isInt()) {
@@ -506,7 +508,7 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
   return Value::makeNull();
  });
 
- api.registerFunction("bc.set_param_names", [api](const std::vector<Value> &args) -> Value {
+ api.registerFunction("bc.set_param_names", [api](HostArgs args) -> Value {
   auto *fn = g_builder.currentFunc();
   if (!fn) throw std::runtime_error("bc.set_param_names: no current function");
   if (args.empty() || !args[0].isArrayId()) {
@@ -533,14 +535,14 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
   return Value::makeNull();
  });
 
- api.registerFunction("bc.str_id", [](const std::vector<Value> &args) -> Value {
+ api.registerFunction("bc.str_id", [](HostArgs args) -> Value {
     if (args.empty() || !args[0].isInt()) {
         throw std::runtime_error("bc.str_id: requires chunk string index (int)");
     }
     return Value::makeStringValId(static_cast<uint32_t>(args[0].asInt()));
 });
 
-    api.registerFunction("bc.add_upvalue", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.add_upvalue", [](HostArgs args) -> Value {
         auto *fn = g_builder.currentFunc();
         if (!fn) throw std::runtime_error("bc.add_upvalue: no current function");
         if (args.size() < 2 || !args[0].isInt() || !args[1].isInt()) {
@@ -563,7 +565,7 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
         return Value::makeInt(static_cast<int64_t>(fn->upvalues.size() - 1));
     });
 
-    api.registerFunction("bc.add_upvalue_to", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.add_upvalue_to", [](HostArgs args) -> Value {
         if (args.size() < 3 || !args[0].isInt() || !args[1].isInt() || !args[2].isInt()) {
             throw std::runtime_error("bc.add_upvalue_to: requires (funcIdx, index, captures_local)");
         }
@@ -591,7 +593,7 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
         return Value::makeInt(static_cast<int64_t>(targetFn->upvalues.size() - 1));
     });
 
-    api.registerFunction("bc.set_default_value", [](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.set_default_value", [](HostArgs args) -> Value {
     auto *fn = g_builder.currentFunc();
     if (!fn) throw std::runtime_error("bc.set_default_value: no current function");
     if (args.size() < 2 || !args[0].isInt()) {
@@ -605,7 +607,7 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
     return Value::makeBool(true);
 });
 
-    api.registerFunction("bc.execute", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.execute", [api](HostArgs args) -> Value {
         if (g_builder.chunk->getFunctionCount() == 0) {
             throw std::runtime_error("bc.execute: no functions in chunk");
         }
@@ -625,7 +627,7 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
     auto saved_chunk = vm.current_chunk;
     auto saved_frame_count = vm.frame_count_;
     auto saved_frame_arena = vm.frame_arena_;
-    std::stack<Value> saved_stack = vm.stack;
+    ValueStack saved_stack = vm.stack;
     auto saved_locals = vm.locals;
   auto saved_main_chunk = vm.getMainChunk();
 
@@ -661,7 +663,7 @@ api.registerFunction("bc.set_param_count", [](const std::vector<Value> &args) ->
 
 
 
-api.registerFunction("bc.execute_persistent", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.execute_persistent", [api](HostArgs args) -> Value {
     if (g_builder.chunk->getFunctionCount() == 0) {
         throw std::runtime_error("bc.execute_persistent: no functions in chunk");
     }
@@ -683,7 +685,7 @@ api.registerFunction("bc.execute_persistent", [api](const std::vector<Value> &ar
     auto saved_chunk = vm.current_chunk;
     auto saved_frame_count = vm.frame_count_;
     auto saved_frame_arena = vm.frame_arena_;
-    std::stack<Value> saved_stack = vm.stack;
+    ValueStack saved_stack = vm.stack;
     auto saved_locals = vm.locals;
     auto saved_immutable_locals = vm.immutable_locals_;
     auto saved_main_chunk = vm.getMainChunk();
@@ -740,7 +742,7 @@ api.registerFunction("bc.execute_persistent", [api](const std::vector<Value> &ar
         for (auto &[name, val] : post_globals) {
             auto preIt = pre_globals.find(name);
             if (preIt == pre_globals.end() || !(preIt->second == val)) {
-                vm.host_function_globals_[name] = val;
+                vm.setHostFunctionGlobal(name, val);
             }
         }
 
@@ -788,7 +790,7 @@ api.registerFunction("bc.execute_persistent", [api](const std::vector<Value> &ar
     }
 });
 
-api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.get_global", [api](HostArgs args) -> Value {
     if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
         throw std::runtime_error("bc.get_global: requires name (string)");
     }
@@ -798,7 +800,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
     return result;
 });
 
-    api.registerFunction("bc.set_global", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.set_global", [api](HostArgs args) -> Value {
         if (args.size() < 2 || (!args[0].isStringId() && !args[0].isStringValId())) {
             throw std::runtime_error("bc.set_global: requires name (string) and value");
         }
@@ -808,7 +810,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
         return args[1];
     });
 
-    api.registerFunction("bc.set_script_dir", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.set_script_dir", [api](HostArgs args) -> Value {
         if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
             throw std::runtime_error("bc.set_script_dir: requires dir (string)");
         }
@@ -817,7 +819,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
         return Value::makeInt(0);
     });
 
-    api.registerFunction("bc.serialize", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.serialize", [api](HostArgs args) -> Value {
         if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
             throw std::runtime_error("bc.serialize: requires path (string)");
         }
@@ -838,23 +840,23 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
 	    return Value::makeBool(true);
 	});
 
-	api.registerFunction("bc.func_count", [](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.func_count", [](HostArgs) -> Value {
 		return Value::makeInt(static_cast<int64_t>(g_builder.chunk->getFunctionCount()));
 	});
 
-	api.registerFunction("bc.instr_count", [](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.instr_count", [](HostArgs) -> Value {
 		auto *fn = g_builder.currentFunc();
 		if (!fn) return Value::makeInt(0);
 		return Value::makeInt(static_cast<int64_t>(fn->instructions.size()));
 	});
 
-	api.registerFunction("bc.const_count", [](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.const_count", [](HostArgs) -> Value {
 		auto *fn = g_builder.currentFunc();
 		if (!fn) return Value::makeInt(0);
 		return Value::makeInt(static_cast<int64_t>(fn->constants.size()));
 	});
 
-	api.registerFunction("bc.disasm", [api](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.disasm", [api](HostArgs) -> Value {
 		auto *fn = g_builder.currentFunc();
 		if (!fn) return api.makeString("<no current function>");
 		std::string out;
@@ -888,7 +890,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
 		return api.makeString(out);
 	});
 
-  api.registerFunction("bc.disasm_all", [api](const std::vector<Value> &) -> Value {
+  api.registerFunction("bc.disasm_all", [api](HostArgs) -> Value {
     std::string out;
     auto *chunk = g_builder.chunk.get();
     if (!chunk) return api.makeString("<no chunk>");
@@ -949,7 +951,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
 	// ----------------------------------------------------------------------
 	// bc.debug_attach – attach VM debugger
 	// ----------------------------------------------------------------------
-	api.registerFunction("bc.debug_attach", [api](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.debug_attach", [api](HostArgs) -> Value {
 		api.vm().attachDebugger();
 		return Value::makeNull();
 	});
@@ -957,7 +959,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
 	// ----------------------------------------------------------------------
 	// bc.debug_detach – detach VM debugger
 	// ----------------------------------------------------------------------
-	api.registerFunction("bc.debug_detach", [api](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.debug_detach", [api](HostArgs) -> Value {
 		api.vm().detachDebugger();
 		return Value::makeNull();
 	});
@@ -965,7 +967,7 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
 	// ----------------------------------------------------------------------
 	// bc.debug_step_mode – set VM debug step mode (0=Continue, 1=StepInto, 2=StepOver, 3=StepOut)
 	// ----------------------------------------------------------------------
-	api.registerFunction("bc.debug_step_mode", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.debug_step_mode", [api](HostArgs args) -> Value {
 		if (args.empty()) return Value::makeNull();
 		int mode = static_cast<int>(args[0].asInt());
 		if (mode < 0 || mode > 3) mode = 0;
@@ -976,31 +978,31 @@ api.registerFunction("bc.get_global", [api](const std::vector<Value> &args) -> V
 	// ----------------------------------------------------------------------
 	// bc.debug_is_attached – check if debugger is attached
 	// ----------------------------------------------------------------------
-	api.registerFunction("bc.debug_is_attached", [api](const std::vector<Value> &) -> Value {
+	api.registerFunction("bc.debug_is_attached", [api](HostArgs) -> Value {
 		return Value::makeBool(api.vm().isDebuggerAttached());
 	});
 
 	// ----------------------------------------------------------------------
 	// bc.debug_step_frame_depth – set frame depth for step out
 	// ----------------------------------------------------------------------
-	api.registerFunction("bc.debug_step_frame_depth", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.debug_step_frame_depth", [api](HostArgs args) -> Value {
 		if (args.empty()) return Value::makeNull();
 		size_t depth = static_cast<size_t>(args[0].asInt());
 		api.vm().setDebugStepFrameDepth(depth);
 		return Value::makeNull();
 	});
 
-api.registerFunction("bc.is_string_id", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.is_string_id", [](HostArgs args) -> Value {
     if (args.empty()) return Value::makeBool(false);
     return Value::makeBool(args[0].isStringId());
     });
 
-api.registerFunction("bc.is_string_val_id", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.is_string_val_id", [](HostArgs args) -> Value {
 if (args.empty()) return Value::makeBool(false);
 return Value::makeBool(args[0].isStringValId());
 });
 
-api.registerFunction("bc.make_function_obj", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.make_function_obj", [](HostArgs args) -> Value {
 if (args.empty() || !args[0].isInt()) {
 throw std::runtime_error("bc.make_function_obj: requires function index (int)");
 }
@@ -1008,7 +1010,7 @@ uint32_t idx = static_cast<uint32_t>(args[0].asInt());
 return Value::makeFunctionObjId(idx);
 });
 
-api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("bc.opcode_id", [api](HostArgs args) -> Value {
     if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
         throw std::runtime_error("bc.opcode_id: requires opcode name (string)");
     }
@@ -1017,7 +1019,7 @@ api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Va
     return Value::makeInt(static_cast<int64_t>(static_cast<uint8_t>(op)));
     });
 
-    api.registerFunction("bc.trace_execution", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.trace_execution", [api](HostArgs args) -> Value {
         auto &vm = api.vm();
         bool enabled = true;
         if (!args.empty()) {
@@ -1028,7 +1030,7 @@ api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Va
         return Value::makeBool(enabled);
     });
 
-	api.registerFunction("bc.log", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.log", [api](HostArgs args) -> Value {
 		if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
 			return Value::makeNull();
 		}
@@ -1047,7 +1049,7 @@ api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Va
 		return Value::makeNull();
 	});
 
-	api.registerFunction("bc.log_level", [api](const std::vector<Value> &args) -> Value {
+	api.registerFunction("bc.log_level", [api](HostArgs args) -> Value {
 		auto &logger = havel::Logger::getInstance();
 		if (args.empty() || (!args[0].isStringId() && !args[0].isStringValId())) {
 			auto lvl = static_cast<int>(logger.getCurrentLevel());
@@ -1065,17 +1067,17 @@ api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Va
     return Value::makeInt(static_cast<int>(lvl));
     });
 
-    api.registerFunction("bc.suspend_gc", [api](const std::vector<Value> &) -> Value {
+    api.registerFunction("bc.suspend_gc", [api](HostArgs) -> Value {
         api.vm().suspendGC();
         return Value::makeNull();
     });
 
-    api.registerFunction("bc.resume_gc", [api](const std::vector<Value> &) -> Value {
+    api.registerFunction("bc.resume_gc", [api](HostArgs) -> Value {
         api.vm().resumeGC();
         return Value::makeNull();
     });
 
-    api.registerFunction("bc.store_chunk", [](const std::vector<Value> &) -> Value {
+    api.registerFunction("bc.store_chunk", [](HostArgs) -> Value {
         auto count = g_builder.chunk->getFunctionCount();
         if (count == 0) {
             throw std::runtime_error("bc.store_chunk: no functions in chunk");
@@ -1092,7 +1094,7 @@ api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Va
         return result;
     });
 
-    api.registerFunction("bc.execute_stored", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.execute_stored", [api](HostArgs args) -> Value {
         if (args.empty() || !args[0].isInt()) {
             throw std::runtime_error("bc.execute_stored: requires chunk id (int)");
         }
@@ -1119,7 +1121,7 @@ api.registerFunction("bc.opcode_id", [api](const std::vector<Value> &args) -> Va
       auto saved_chunk = vm.current_chunk;
       auto saved_frame_count = vm.frame_count_;
       auto saved_frame_arena = vm.frame_arena_;
-      std::stack<Value> saved_stack = vm.stack;
+      ValueStack saved_stack = vm.stack;
       auto saved_locals = vm.locals;
       auto saved_immutable_locals = vm.immutable_locals_;
       auto saved_main_chunk = vm.getMainChunk();
@@ -1154,7 +1156,7 @@ return result;
       }
     });
 
-    api.registerFunction("bc.spawn_stored", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("bc.spawn_stored", [api](HostArgs args) -> Value {
         if (args.empty() || !args[0].isInt()) {
             throw std::runtime_error("bc.spawn_stored: requires chunk id (int)");
         }
@@ -1193,7 +1195,7 @@ return result;
     // Run one scheduler tick (drain events + one goroutine). Used by the
     // self-hosted REPL to keep hotkey/update goroutines alive while reading
     // stdin.
-    api.registerFunction("bc.tick", [api](const std::vector<Value> &) -> Value {
+    api.registerFunction("bc.tick", [api](HostArgs) -> Value {
         api.vm().tickScheduler();
         return Value::makeNull();
     });
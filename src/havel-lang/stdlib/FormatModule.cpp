@@ -10,6 +10,7 @@
 #include <stdexcept>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -82,7 +83,7 @@ static std::string intToBase(int64_t val, int base, const std::string &prefix) {
 
 void registerFormatModule(const VMApi &api) {
     // C++ shim: b64 encode/decode (byte-level ops, pointer hex)
-    api.registerFunction("fmt.b64", [api](const std::vector<Value> &args) {
+    api.registerFunction("fmt.b64", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("b64() requires a string or array");
         const auto &v = args[0];
@@ -109,7 +110,7 @@ void registerFormatModule(const VMApi &api) {
         throw std::runtime_error("b64() expects a string or byte array");
     });
 
-    api.registerFunction("fmt.b64decode", [api](const std::vector<Value> &args) {
+    api.registerFunction("fmt.b64decode", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("b64decode() requires a string");
         const auto &v = args[0];
@@ -124,7 +125,7 @@ void registerFormatModule(const VMApi &api) {
     });
 
     // C++ shim: pointer-based hex (can't do reinterpret_cast in Havel)
-    api.registerFunction("fmt._hexPtr", [api](const std::vector<Value> &args) {
+    api.registerFunction("fmt._hexPtr", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("_hexPtr() requires a value");
         const auto &v = args[0];
@@ -29,6 +29,7 @@
 #include "havel-lang/core/Value.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace fs = std::filesystem;
@@ -214,7 +215,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.exists
     api.registerFunction(
-        "fs.exists", [api](const std::vector<Value> &args) {
+        "fs.exists", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -223,7 +224,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.writable
     api.registerFunction(
-        "fs.writable", [api](const std::vector<Value> &args) {
+        "fs.writable", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -232,7 +233,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.isDir
     api.registerFunction(
-        "fs.isDir", [api](const std::vector<Value> &args) {
+        "fs.isDir", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -242,7 +243,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.isFile
     api.registerFunction(
-        "fs.isFile", [api](const std::vector<Value> &args) {
+        "fs.isFile", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -252,7 +253,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.isSymlink
     api.registerFunction(
-        "fs.isSymlink", [api](const std::vector<Value> &args) {
+        "fs.isSymlink", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -262,7 +263,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.size
     api.registerFunction(
-        "fs.size", [api](const std::vector<Value> &args) {
+        "fs.size", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeInt(-1);
             std::string path = api.resolveString(args[0]);
@@ -275,7 +276,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.read
     api.registerFunction(
-"fs.read", [api](const std::vector<Value> &args) {
+"fs.read", [api](HostArgs args) {
         if (args.empty())
             return Value::makeNull();
         std::string path = api.resolveString(args[0]);
@@ -288,9 +289,28 @@ void registerFsModule(const VMApi &api) {
         return api.makeString(content);
     });
 
+    // fs.readBytes - whole file read straight into a byte buffer
+    api.registerFunction(
+        "fs.readBytes", [api](HostArgs args) {
+            if (args.empty())
+                return Value::makeNull();
+            std::string path = api.resolveString(args[0]);
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file.is_open())
+                return Value::makeNull();
+            const auto size = file.tellg();
+            if (size < 0)
+                return Value::makeNull();
+            std::vector<uint8_t> data(static_cast<size_t>(size));
+            file.seekg(0);
+            if (!file.read(reinterpret_cast<char *>(data.data()), size))
+                return Value::makeNull();
+            return api.makeBytes(std::move(data));
+        });
+
     // fs.readDir
     api.registerFunction(
-        "fs.readDir", [api](const std::vector<Value> &args) {
+        "fs.readDir", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string path = api.resolveString(args[0]);
@@ -305,7 +325,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.readLines
     api.registerFunction(
-        "fs.readLines", [api](const std::vector<Value> &args) {
+        "fs.readLines", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string path = api.resolveString(args[0]);
@@ -322,10 +342,19 @@ void registerFsModule(const VMApi &api) {
 
     // fs.write
     api.registerFunction(
-        "fs.write", [api](const std::vector<Value> &args) {
+        "fs.write", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
+            if (args[1].isBytesId()) {
+                auto data = api.bytes(args[1]);
+                std::ofstream file(path, std::ios::binary);
+                if (!file.is_open())
+                    return Value::makeBool(false);
+                file.write(reinterpret_cast<const char *>(data.data()),
+                           static_cast<std::streamsize>(data.size()));
+                return Value::makeBool(static_cast<bool>(file));
+            }
             std::string content = api.resolveString(args[1]);
             std::ofstream file(path);
             if (!file.is_open())
@@ -336,7 +365,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.append
     api.registerFunction(
-        "fs.append", [api](const std::vector<Value> &args) {
+        "fs.append", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -350,7 +379,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.touch
     api.registerFunction(
-        "fs.touch", [api](const std::vector<Value> &args) {
+        "fs.touch", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string path = api.resolveString(args[0]);
@@ -362,7 +391,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.mkdir
     api.registerFunction(
-        "fs.mkdir", [api](const std::vector<Value> &args) {
+        "fs.mkdir", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -372,7 +401,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.mkdirAll
     api.registerFunction(
-        "fs.mkdirAll", [api](const std::vector<Value> &args) {
+        "fs.mkdirAll", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -383,7 +412,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.delete (legacy name)
     api.registerFunction(
-        "fs.delete", [api](const std::vector<Value> &args) {
+        "fs.delete", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -393,7 +422,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.rm (same as delete, more conventional)
     api.registerFunction(
-        "fs.rm", [api](const std::vector<Value> &args) {
+        "fs.rm", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -403,7 +432,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.copy
     api.registerFunction(
-        "fs.copy", [api](const std::vector<Value> &args) {
+        "fs.copy", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string src = api.resolveString(args[0]);
@@ -415,7 +444,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.copyDir (recursive directory copy)
     api.registerFunction(
-        "fs.copyDir", [api](const std::vector<Value> &args) {
+        "fs.copyDir", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string src = api.resolveString(args[0]);
@@ -427,7 +456,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.move
     api.registerFunction(
-        "fs.move", [api](const std::vector<Value> &args) {
+        "fs.move", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string src = api.resolveString(args[0]);
@@ -439,7 +468,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.rename (same as move, explicit name)
     api.registerFunction(
-        "fs.rename", [api](const std::vector<Value> &args) {
+        "fs.rename", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string src = api.resolveString(args[0]);
@@ -451,7 +480,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.rmdir (directory removal, recursive if second arg is true)
     api.registerFunction(
-        "fs.rmdir", [api](const std::vector<Value> &args) {
+        "fs.rmdir", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -466,7 +495,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.stat (detailed file metadata)
     api.registerFunction(
-        "fs.stat", [api](const std::vector<Value> &args) {
+        "fs.stat", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string path = api.resolveString(args[0]);
@@ -475,7 +504,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.symlink (create symbolic link)
     api.registerFunction(
-        "fs.symlink", [api](const std::vector<Value> &args) {
+        "fs.symlink", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string target = api.resolveString(args[0]);
@@ -487,7 +516,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.readlink (read symbolic link target)
     api.registerFunction(
-        "fs.readlink", [api](const std::vector<Value> &args) {
+        "fs.readlink", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string path = api.resolveString(args[0]);
@@ -500,7 +529,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.chmod
     api.registerFunction(
-        "fs.chmod", [api](const std::vector<Value> &args) {
+        "fs.chmod", [api](HostArgs args) {
             if (args.size() < 2)
                 return Value::makeBool(false);
             std::string path = api.resolveString(args[0]);
@@ -521,7 +550,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.walk (recursive directory walk, returns flat array of paths)
     api.registerFunction(
-        "fs.walk", [api](const std::vector<Value> &args) {
+        "fs.walk", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string path = api.resolveString(args[0]);
@@ -539,7 +568,7 @@ void registerFsModule(const VMApi &api) {
 
 // fs.traverse (same as walk but returns FileObjects instead of strings)
   api.registerFunction(
-  "fs.traverse", [api](const std::vector<Value> &args) {
+  "fs.traverse", [api](HostArgs args) {
   if (args.empty())
     return Value::makeNull();
   std::string path = api.resolveString(args[0]);
@@ -558,7 +587,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.glob (pattern matching with * and **)
     api.registerFunction(
-        "fs.glob", [api](const std::vector<Value> &args) {
+        "fs.glob", [api](HostArgs args) {
             if (args.empty())
                 return Value::makeNull();
             std::string pattern = api.resolveString(args[0]);
@@ -590,7 +619,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.watch (inotify-based directory watcher)
     api.registerFunction(
-        "fs.watch", [api](const std::vector<Value> &args) {
+        "fs.watch", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.size() < 2)
                 return Value::makeNull();
@@ -614,7 +643,7 @@ void registerFsModule(const VMApi &api) {
             api.setField(watchObj, "callback", callback);
             api.setField(watchObj, "close", api.makeFunctionRef("fs._watchClose"));
   api.registerFunction("fs._watchClose_" + std::to_string(inotifyFd),
-                [inotifyFd](const std::vector<Value> &) {
+                [inotifyFd](HostArgs) {
                     close(inotifyFd);
                     return Value::makeBool(true);
                 });
@@ -627,7 +656,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs._watchClose (close watch handle)
     api.registerFunction(
-        "fs._watchClose", [api](const std::vector<Value> &args) {
+        "fs._watchClose", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -646,7 +675,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.watchTree (recursive directory watcher)
     api.registerFunction(
-        "fs.watchTree", [api](const std::vector<Value> &args) {
+        "fs.watchTree", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.size() < 2)
                 return Value::makeNull();
@@ -681,7 +710,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.open (file handle: r, w, w+, a)
     api.registerFunction(
-        "fs.open", [api](const std::vector<Value> &args) {
+        "fs.open", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty())
                 return Value::makeNull();
@@ -734,7 +763,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: read(n)
     api.registerFunction(
-        "fs._handleRead", [api](const std::vector<Value> &args) {
+        "fs._handleRead", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeNull();
@@ -766,7 +795,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: write(data)
     api.registerFunction(
-        "fs._handleWrite", [api](const std::vector<Value> &args) {
+        "fs._handleWrite", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.size() < 2 || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -784,7 +813,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: prepend(data)
     api.registerFunction(
-        "fs._handlePrepend", [api](const std::vector<Value> &args) {
+        "fs._handlePrepend", [api](HostArgs args) {
             if (args.size() < 2 || !args[0].isObjectId())
                 return Value::makeBool(false);
             auto *handle = getHandle(args[0], api);
@@ -808,7 +837,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: append(data)
     api.registerFunction(
-        "fs._handleAppend", [api](const std::vector<Value> &args) {
+        "fs._handleAppend", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.size() < 2 || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -827,7 +856,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: seek(position)
     api.registerFunction(
-        "fs._handleSeek", [api](const std::vector<Value> &args) {
+        "fs._handleSeek", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -849,7 +878,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: clear()
     api.registerFunction(
-        "fs._handleClear", [api](const std::vector<Value> &args) {
+        "fs._handleClear", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -868,7 +897,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: flush()
     api.registerFunction(
-        "fs._handleFlush", [api](const std::vector<Value> &args) {
+        "fs._handleFlush", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -884,7 +913,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: close()
     api.registerFunction(
-        "fs._handleClose", [api](const std::vector<Value> &args) {
+        "fs._handleClose", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -905,7 +934,7 @@ void registerFsModule(const VMApi &api) {
 
     // File handle: remove() (close and delete file)
     api.registerFunction(
-        "fs._handleRemove", [api](const std::vector<Value> &args) {
+        "fs._handleRemove", [api](HostArgs args) {
 #ifndef _WIN32
             if (args.empty() || !args[0].isObjectId())
                 return Value::makeBool(false);
@@ -929,7 +958,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.atomicWrite (write to exclusive temp then fsync+rename)
     api.registerFunction(
-    "fs.atomicWrite", [api](const std::vector<Value> &args) {
+    "fs.atomicWrite", [api](HostArgs args) {
 #ifndef _WIN32
         if (args.size() < 2)
             return Value::makeBool(false);
@@ -982,7 +1011,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.tempFile (create temporary file, returns {path, fd})
     api.registerFunction(
-        "fs.tempFile", [api](const std::vector<Value> &args) {
+        "fs.tempFile", [api](HostArgs args) {
 #ifndef _WIN32
             std::string tmpl = "/tmp/havel_XXXXXX";
             if (!args.empty()) {
@@ -1014,7 +1043,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.lock (advisory file lock via flock — fd stays open)
     api.registerFunction(
-    "fs.lock", [api](const std::vector<Value> &args) {
+    "fs.lock", [api](HostArgs args) {
 #ifndef _WIN32
         if (args.empty())
             return Value::makeBool(false);
@@ -1038,7 +1067,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.tryLock (non-blocking advisory file lock — fd stays open)
     api.registerFunction(
-    "fs.tryLock", [api](const std::vector<Value> &args) {
+    "fs.tryLock", [api](HostArgs args) {
 #ifndef _WIN32
         if (args.empty())
             return Value::makeBool(false);
@@ -1062,7 +1091,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.isLocked
     api.registerFunction(
-    "fs.isLocked", [api](const std::vector<Value> &args) {
+    "fs.isLocked", [api](HostArgs args) {
         if (args.empty())
             return Value::makeBool(false);
         std::string path = api.resolveString(args[0]);
@@ -1072,7 +1101,7 @@ void registerFsModule(const VMApi &api) {
 
     // fs.unlock (release advisory file lock and close fd)
     api.registerFunction(
-    "fs.unlock", [api](const std::vector<Value> &args) {
+    "fs.unlock", [api](HostArgs args) {
 #ifndef _WIN32
         if (args.empty())
             return Value::makeBool(false);
@@ -1103,6 +1132,7 @@ void registerFsModule(const VMApi &api) {
     api.setField(fsObj, "isSymlink", api.makeFunctionRef("fs.isSymlink"));
     api.setField(fsObj, "size", api.makeFunctionRef("fs.size"));
     api.setField(fsObj, "read", api.makeFunctionRef("fs.read"));
+    api.setField(fsObj, "readBytes", api.makeFunctionRef("fs.readBytes"));
     api.setField(fsObj, "readDir", api.makeFunctionRef("fs.readDir"));
     api.setField(fsObj, "readLines", api.makeFunctionRef("fs.readLines"));
     api.setField(fsObj, "write", api.makeFunctionRef("fs.write"));
@@ -18,6 +18,7 @@ using havel::compiler::Value;
 using havel::compiler::CallbackId;
 using havel::compiler::ObjectRef;
 using havel::compiler::VM;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 using havel::compiler::Scheduler;
 using havel::compiler::HotkeyPolicy;
@@ -299,41 +300,41 @@ void registerHotkeyModule(const VMApi &api) {
     VM &vm = api.vm();
 
     // Property getters
-    api.registerPrototypeMethod("Hotkey", "id", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "id", 1, [&vm](HostArgs args) -> Value {
         if (args.empty() || !args[0].isObjectId()) return Value::makeNull();
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         return vm.getHostObjectField(objRef, "id");
     });
 
-    api.registerPrototypeMethod("Hotkey", "alias", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "alias", 1, [&vm](HostArgs args) -> Value {
         if (args.empty() || !args[0].isObjectId()) return Value::makeNull();
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         return vm.getHostObjectField(objRef, "alias");
     });
 
-    api.registerPrototypeMethod("Hotkey", "key", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "key", 1, [&vm](HostArgs args) -> Value {
         if (args.empty() || !args[0].isObjectId()) return Value::makeNull();
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         return vm.getHostObjectField(objRef, "key");
     });
 
-    api.registerPrototypeMethod("Hotkey", "condition", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "condition", 1, [&vm](HostArgs args) -> Value {
         if (args.empty() || !args[0].isObjectId()) return Value::makeNull();
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         return vm.getHostObjectField(objRef, "condition");
     });
 
-    api.registerPrototypeMethod("Hotkey", "info", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "info", 1, [&vm](HostArgs args) -> Value {
         if (args.empty() || !args[0].isObjectId()) return Value::makeNull();
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         return vm.getHostObjectField(objRef, "info");
     });
 
-    api.registerPrototypeMethod("Hotkey", "callback", 1, [](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "callback", 1, [](HostArgs args) -> Value {
         return Value::makeNull();
     });
 
-    api.registerPrototypeMethod("Hotkey", "state", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "state", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeNull();
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -342,7 +343,7 @@ void registerHotkeyModule(const VMApi &api) {
         return Value::makeStringId(strRef.id);
     });
 
-    api.registerPrototypeMethod("Hotkey", "modifiers", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "modifiers", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeNull();
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -351,7 +352,7 @@ void registerHotkeyModule(const VMApi &api) {
         return Value::makeStringId(strRef.id);
     });
 
-    api.registerPrototypeMethod("Hotkey", "combo", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "combo", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeNull();
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -360,7 +361,7 @@ void registerHotkeyModule(const VMApi &api) {
         return Value::makeStringId(strRef.id);
     });
 
-    api.registerPrototypeMethod("Hotkey", "addedAt", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "addedAt", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeNull();
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -369,7 +370,7 @@ void registerHotkeyModule(const VMApi &api) {
     });
 
     // count() - number of times this hotkey has been triggered
-api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeInt(0);
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -378,7 +379,7 @@ api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](const std::vector<Value>
     });
 
     // lastTriggeredAt() - epoch ms of last trigger, 0 if never triggered
-    api.registerPrototypeMethod("Hotkey", "lastTriggeredAt", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "lastTriggeredAt", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeInt(0);
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -387,7 +388,7 @@ api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](const std::vector<Value>
     });
 
     // isActive() - true if the persistent goroutine is currently running or pending
-    api.registerPrototypeMethod("Hotkey", "isActive", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "isActive", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeBool(false);
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -403,7 +404,7 @@ api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](const std::vector<Value>
     });
 
     // getPolicy() - returns the current hotkey policy as a string
-    api.registerPrototypeMethod("Hotkey", "getPolicy", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "getPolicy", 1, [&vm](HostArgs args) -> Value {
         auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
         if (hotkeyId.empty()) return Value::makeNull();
         auto *ctx = getHotkeyContextData(hotkeyId);
@@ -419,7 +420,7 @@ api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](const std::vector<Value>
     });
 
     // enable() - enable this hotkey
-    api.registerPrototypeMethod("Hotkey", "enable", 1, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "enable", 1, [&vm](HostArgs args) -> Value {
         if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         auto idValue = vm.getHostObjectField(objRef, "id");
@@ -441,7 +442,7 @@ api.registerPrototypeMethod("Hotkey", "count", 1, [&vm](const std::vector<Value>
     });
 
 // disable() - disable this hotkey
-api.registerPrototypeMethod("Hotkey", "disable", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "disable", 1, [&vm](HostArgs args) -> Value {
 	if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
 	auto objRef = ObjectRef{args[0].asObjectId(), true};
 	auto idValue = vm.getHostObjectField(objRef, "id");
@@ -463,7 +464,7 @@ api.registerPrototypeMethod("Hotkey", "disable", 1, [&vm](const std::vector<Valu
 });
 
 // toggle() - toggle enabled/disabled
-api.registerPrototypeMethod("Hotkey", "toggle", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "toggle", 1, [&vm](HostArgs args) -> Value {
 	if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
 	auto objRef = ObjectRef{args[0].asObjectId(), true};
 	auto idValue = vm.getHostObjectField(objRef, "id");
@@ -491,7 +492,7 @@ api.registerPrototypeMethod("Hotkey", "toggle", 1, [&vm](const std::vector<Value
     });
 
 // remove() - remove this hotkey
-api.registerPrototypeMethod("Hotkey", "remove", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "remove", 1, [&vm](HostArgs args) -> Value {
 	if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
 	auto objRef = ObjectRef{args[0].asObjectId(), true};
 	auto idValue = vm.getHostObjectField(objRef, "id");
@@ -513,7 +514,7 @@ api.registerPrototypeMethod("Hotkey", "remove", 1, [&vm](const std::vector<Value
     });
 
     // setPolicy(policy_str) - change the hotkey policy at runtime
-    api.registerPrototypeMethod("Hotkey", "setPolicy", 2, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "setPolicy", 2, [&vm](HostArgs args) -> Value {
         if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
         auto hotkeyId = extractHotkeyId(vm, args[0]);
         if (hotkeyId.empty()) return Value::makeBool(false);
@@ -535,7 +536,7 @@ api.registerPrototypeMethod("Hotkey", "remove", 1, [&vm](const std::vector<Value
     });
 
     // setAlias(alias_str) - change the alias at runtime
-    api.registerPrototypeMethod("Hotkey", "setAlias", 2, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "setAlias", 2, [&vm](HostArgs args) -> Value {
         if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         auto idValue = vm.getHostObjectField(objRef, "id");
@@ -567,7 +568,7 @@ api.registerPrototypeMethod("Hotkey", "remove", 1, [&vm](const std::vector<Value
     });
 
     // setEnabled(bool) - explicit enable/disable by boolean argument
-    api.registerPrototypeMethod("Hotkey", "setEnabled", 2, [&vm](const std::vector<Value> &args) -> Value {
+    api.registerPrototypeMethod("Hotkey", "setEnabled", 2, [&vm](HostArgs args) -> Value {
         if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
         auto objRef = ObjectRef{args[0].asObjectId(), true};
         auto idValue = vm.getHostObjectField(objRef, "id");
@@ -595,7 +596,7 @@ api.registerPrototypeMethod("Hotkey", "remove", 1, [&vm](const std::vector<Value
     });
 
 // removeAll() - remove all hotkeys
-api.registerPrototypeMethod("Hotkey", "removeAll", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "removeAll", 1, [&vm](HostArgs args) -> Value {
 	auto *hostCtx = vm.hostContext();
 	if (!hostCtx || !hostCtx->hotkeyManager) return Value::makeInt(0);
 
@@ -609,7 +610,7 @@ api.registerPrototypeMethod("Hotkey", "removeAll", 1, [&vm](const std::vector<Va
 });
 
 // clearAll() - alias for removeAll
-api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](HostArgs args) -> Value {
 	auto *hostCtx = vm.hostContext();
 	if (!hostCtx || !hostCtx->hotkeyManager) return Value::makeInt(0);
 
@@ -625,7 +626,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   // ===== New Prototype Methods =====
 
   // age() - milliseconds since this hotkey was added
-  api.registerPrototypeMethod("Hotkey", "age", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "age", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeInt(0);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -637,7 +638,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // elapsed() - milliseconds since last trigger, -1 if never triggered
-  api.registerPrototypeMethod("Hotkey", "elapsed", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "elapsed", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeInt(-1);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -650,7 +651,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // resetCount() - reset the trigger counter to 0
-  api.registerPrototypeMethod("Hotkey", "resetCount", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "resetCount", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeBool(false);
     auto *ctx = getHotkeyContextDataMutable(hotkeyId);
@@ -660,7 +661,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // toString() - human-readable summary of this hotkey
-  api.registerPrototypeMethod("Hotkey", "toString", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "toString", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) {
       auto ref = vm.createRuntimeString("Hotkey<unknown>");
@@ -687,7 +688,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // equals(other) - compare two hotkey context objects by id
-  api.registerPrototypeMethod("Hotkey", "equals", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "equals", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId() || !args[1].isObjectId())
       return Value::makeBool(false);
     auto objRef0 = ObjectRef{args[0].asObjectId(), true};
@@ -701,7 +702,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // isEnabled() - check if this hotkey is enabled (from context data)
-  api.registerPrototypeMethod("Hotkey", "isEnabled", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "isEnabled", 1, [&vm](HostArgs args) -> Value {
     if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto enabledVal = vm.getHostObjectField(objRef, "enabled");
@@ -710,7 +711,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // isSuspended() - check if the persistent goroutine is currently suspended
-  api.registerPrototypeMethod("Hotkey", "isSuspended", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "isSuspended", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeBool(false);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -723,7 +724,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // goroutineId() - return the scheduler goroutine ID for this hotkey, or 0
-  api.registerPrototypeMethod("Hotkey", "goroutineId", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "goroutineId", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeInt(0);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -736,7 +737,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // setKey(key_str) - update the key string on this hotkey context
-  api.registerPrototypeMethod("Hotkey", "setKey", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "setKey", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -752,7 +753,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
   });
 
   // setInfo(info_str) - update the info string on this hotkey context
-  api.registerPrototypeMethod("Hotkey", "setInfo", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "setInfo", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -770,7 +771,7 @@ api.registerPrototypeMethod("Hotkey", "clearAll", 1, [&vm](const std::vector<Val
 // ===== Live Property Getters =====
 
 // status - live goroutine state
-api.registerPrototypeMethod("Hotkey", "status", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "status", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeNull();
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -782,7 +783,7 @@ api.registerPrototypeMethod("Hotkey", "status", 1, [&vm](const std::vector<Value
 });
 
 // policy - current hotkey policy
-api.registerPrototypeMethod("Hotkey", "policy", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "policy", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeNull();
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -798,7 +799,7 @@ api.registerPrototypeMethod("Hotkey", "policy", 1, [&vm](const std::vector<Value
 });
 
 // date - registration date string
-api.registerPrototypeMethod("Hotkey", "date", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "date", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeNull();
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -808,7 +809,7 @@ api.registerPrototypeMethod("Hotkey", "date", 1, [&vm](const std::vector<Value>
 });
 
 // goroutineId() - scheduler goroutine ID (live lookup)
-api.registerPrototypeMethod("Hotkey", "goroutineId", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "goroutineId", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeInt(0);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -823,7 +824,7 @@ api.registerPrototypeMethod("Hotkey", "goroutineId", 1, [&vm](const std::vector<
 // ===== Action Methods =====
 
 // trigger() - programmatically trigger this hotkey
-api.registerPrototypeMethod("Hotkey", "trigger", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "trigger", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeBool(false);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -838,7 +839,7 @@ api.registerPrototypeMethod("Hotkey", "trigger", 1, [&vm](const std::vector<Valu
 });
 
 // stop() - stop the persistent goroutine (marks Done, disables OS hotkey)
-api.registerPrototypeMethod("Hotkey", "stop", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "stop", 1, [&vm](HostArgs args) -> Value {
     if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto hotkeyId = extractHotkeyId(vm, args[0]);
@@ -869,7 +870,7 @@ api.registerPrototypeMethod("Hotkey", "stop", 1, [&vm](const std::vector<Value>
 });
 
 // resume() - unpark a suspended goroutine
-api.registerPrototypeMethod("Hotkey", "resume", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "resume", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeBool(false);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -887,7 +888,7 @@ api.registerPrototypeMethod("Hotkey", "resume", 1, [&vm](const std::vector<Value
 // NOTE: spins with yield because we're inside a host callback and cannot
 //       suspend the calling fiber mid-step. A proper await-based wait
 //       would require returning an awaitable from a VM opcode.
-api.registerPrototypeMethod("Hotkey", "wait", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "wait", 1, [&vm](HostArgs args) -> Value {
     auto hotkeyId = extractHotkeyId(vm, args.empty() ? Value::makeNull() : args[0]);
     if (hotkeyId.empty()) return Value::makeBool(false);
     auto *ctx = getHotkeyContextData(hotkeyId);
@@ -923,7 +924,7 @@ api.registerPrototypeMethod("Hotkey", "wait", 1, [&vm](const std::vector<Value>
 
 // edit(props) - update multiple hotkey properties at once
 // props is an object with optional keys: alias, key, policy, condition, info
-api.registerPrototypeMethod("Hotkey", "edit", 2, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "edit", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId() || !args[1].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1001,13 +1002,13 @@ api.registerPrototypeMethod("Hotkey", "edit", 2, [&vm](const std::vector<Value>
 // ===== Static Utility Methods (on Hotkey global) =====
 
   // Hotkey.count() - total number of registered hotkey contexts
-api.registerPrototypeMethod("Hotkey", "count", 1, [](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "count", 1, [](HostArgs args) -> Value {
     (void)args;
     return Value::makeInt(static_cast<int64_t>(HotkeyModule::contextCount()));
   });
 
 // Hotkey.findByAlias(alias) - find a hotkey context object by alias, or null
-api.registerPrototypeMethod("Hotkey", "findByAlias", 2, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "findByAlias", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2) return Value::makeNull();
     std::string alias = vm.resolveStringKey(args[1]);
     std::string hotkeyId = HotkeyModule::findByAlias(alias);
@@ -1017,7 +1018,7 @@ api.registerPrototypeMethod("Hotkey", "findByAlias", 2, [&vm](const std::vector<
 });
 
 // Hotkey.findByKey(key) - find all hotkey contexts matching a key string
-api.registerPrototypeMethod("Hotkey", "findByKey", 2, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "findByKey", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2) return Value::makeNull();
     std::string key = vm.resolveStringKey(args[1]);
     auto ids = HotkeyModule::findByKey(key);
@@ -1031,7 +1032,7 @@ api.registerPrototypeMethod("Hotkey", "findByKey", 2, [&vm](const std::vector<Va
 });
 
 // Hotkey.all() - return array of all registered hotkey context objects
-api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &args) -> Value {
+api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](HostArgs args) -> Value {
     (void)args;
     auto ids = HotkeyModule::getAllIds();
     auto arr = vm.createHostArray();
@@ -1044,7 +1045,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
 });
 
   // Hotkey.activeCount() - number of persistent hotkey goroutines that are running/runnable
-  api.registerPrototypeMethod("Hotkey", "activeCount", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "activeCount", 1, [&vm](HostArgs args) -> Value {
     (void)args;
     auto *sched = vm.getScheduler();
     if (!sched) return Value::makeInt(0);
@@ -1052,7 +1053,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   });
 
   // Hotkey.suspendedCount() - number of persistent hotkey goroutines that are suspended
-  api.registerPrototypeMethod("Hotkey", "suspendedCount", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "suspendedCount", 1, [&vm](HostArgs args) -> Value {
     (void)args;
     auto *sched = vm.getScheduler();
     if (!sched) return Value::makeInt(0);
@@ -1060,7 +1061,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   });
 
   // Hotkey.policies() - return array of valid policy strings
-  api.registerPrototypeMethod("Hotkey", "policies", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "policies", 1, [&vm](HostArgs args) -> Value {
     (void)args;
     auto arr = vm.createHostArray();
     for (const char *p : {"drop", "replace", "queue", "coalesce"}) {
@@ -1071,7 +1072,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   });
 
   // Hotkey.aliases() - return array of all registered hotkey aliases
-  api.registerPrototypeMethod("Hotkey", "aliases", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "aliases", 1, [&vm](HostArgs args) -> Value {
     (void)args;
     auto *sched = vm.getScheduler();
     if (!sched) {
@@ -1088,7 +1089,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   });
 
   // conditionFn - returns whether a condition function exists for this hotkey
-  api.registerPrototypeMethod("Hotkey", "conditionFn", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "conditionFn", 1, [&vm](HostArgs args) -> Value {
     if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1106,7 +1107,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   // re-evals synchronously so the returned value reflects the latest
   // STORE_GLOBAL state, including mid-tick reads inside a goroutine where
   // the scheduler-level drain only fires at tick end.
-  api.registerPrototypeMethod("Hotkey", "grab", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "grab", 1, [&vm](HostArgs args) -> Value {
     if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1117,7 +1118,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
     if (!ctx) return Value::makeBool(false);
     return Value::makeBool(ctx->grab);
   });
-  api.registerPrototypeMethod("Hotkey", "__get_grab", 1, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "__get_grab", 1, [&vm](HostArgs args) -> Value {
     if (args.empty() || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1136,7 +1137,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   // ===== Dynamic Update Methods =====
 
   // setCondition(newConditionFn) - update the condition function for this hotkey
-  api.registerPrototypeMethod("Hotkey", "setCondition", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "setCondition", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1189,7 +1190,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   });
 
   // setExpression(newActionFn) - update the action/body for this hotkey
-  api.registerPrototypeMethod("Hotkey", "setExpression", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "setExpression", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1233,7 +1234,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
 
   // __set_enabled — property setter interceptor for `m.enabled = bool`
   // Calls EnableHotkey/DisableHotkey so OS grab state stays in sync
-  api.registerPrototypeMethod("Hotkey", "__set_enabled", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "__set_enabled", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1261,7 +1262,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
 
   // __set_grab — property setter interceptor for `m.grab = bool`
   // Calls SetHotkeyGrab so OS grab state stays in sync
-  api.registerPrototypeMethod("Hotkey", "__set_grab", 2, [&vm](const std::vector<Value> &args) -> Value {
+  api.registerPrototypeMethod("Hotkey", "__set_grab", 2, [&vm](HostArgs args) -> Value {
     if (args.size() < 2 || !args[0].isObjectId()) return Value::makeBool(false);
     auto objRef = ObjectRef{args[0].asObjectId(), true};
     auto idValue = vm.getHostObjectField(objRef, "id");
@@ -1283,7 +1284,7 @@ api.registerPrototypeMethod("Hotkey", "all", 1, [&vm](const std::vector<Value> &
   // ===== Standalone update function =====
 
   // hotkey.update(keyOrAlias, newCondition?, newAction?)
-  api.registerFunction("hotkey.update", [&vm](const std::vector<Value> &args) -> Value {
+  api.registerFunction("hotkey.update", [&vm](HostArgs args) -> Value {
     if (args.empty()) return Value::makeBool(false);
     auto keyOrAlias = vm.resolveStringKey(args[0]);
     if (keyOrAlias.empty()) return Value::makeBool(false);
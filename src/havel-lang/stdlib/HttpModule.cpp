@@ -7,6 +7,7 @@
 #include <cctype>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -183,7 +184,7 @@ static Value doRequest(const std::string &method, const std::string &url,
 }
 
 void registerHttpModule(const VMApi &api) {
-    api.registerFunction("http.get", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.get", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.get requires a url");
         std::string url = api.toString(args[0]);
         HttpRequestOpts opts;
@@ -191,7 +192,7 @@ void registerHttpModule(const VMApi &api) {
         return doRequest("GET", url, "", opts, api);
     });
 
-    api.registerFunction("http.post", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.post", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.post requires a url");
         std::string url = api.toString(args[0]);
         std::string data;
@@ -201,7 +202,7 @@ void registerHttpModule(const VMApi &api) {
         return doRequest("POST", url, data, opts, api);
     });
 
-    api.registerFunction("http.put", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.put", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.put requires a url");
         std::string url = api.toString(args[0]);
         std::string data;
@@ -211,7 +212,7 @@ void registerHttpModule(const VMApi &api) {
         return doRequest("PUT", url, data, opts, api);
     });
 
-    api.registerFunction("http.del", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.del", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.del requires a url");
         std::string url = api.toString(args[0]);
         HttpRequestOpts opts;
@@ -219,7 +220,7 @@ void registerHttpModule(const VMApi &api) {
         return doRequest("DELETE", url, "", opts, api);
     });
 
-    api.registerFunction("http.patch", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.patch", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.patch requires a url");
         std::string url = api.toString(args[0]);
         std::string data;
@@ -229,7 +230,7 @@ void registerHttpModule(const VMApi &api) {
         return doRequest("PATCH", url, data, opts, api);
     });
 
-    api.registerFunction("http.head", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.head", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.head requires a url");
         std::string url = api.toString(args[0]);
         HttpRequestOpts opts;
@@ -237,7 +238,7 @@ void registerHttpModule(const VMApi &api) {
         return doRequest("HEAD", url, "", opts, api);
     });
 
-    api.registerFunction("http.download", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.download", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("http.download requires url and path");
         std::string url = api.toString(args[0]);
         std::string path = api.toString(args[1]);
@@ -277,7 +278,7 @@ void registerHttpModule(const VMApi &api) {
         return Value::makeBool(true);
     });
 
-    api.registerFunction("http.upload", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.upload", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("http.upload requires url and file path");
         std::string url = api.toString(args[0]);
         std::string filePath = api.toString(args[1]);
@@ -352,7 +353,7 @@ void registerHttpModule(const VMApi &api) {
         return makeResponseObj(statusCode, responseBody, responseHeaders, error, api);
     });
 
-    api.registerFunction("http.urlEncode", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.urlEncode", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.urlEncode requires a string");
         std::string str = api.toString(args[0]);
         std::ostringstream oss;
@@ -368,7 +369,7 @@ void registerHttpModule(const VMApi &api) {
         return api.makeString(oss.str());
     });
 
-    api.registerFunction("http.urlDecode", [api](const std::vector<Value> &args) {
+    api.registerFunction("http.urlDecode", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("http.urlDecode requires a string");
         std::string str = api.toString(args[0]);
         std::ostringstream oss;
@@ -391,7 +392,7 @@ void registerHttpModule(const VMApi &api) {
         return api.makeString(oss.str());
     });
 
-    api.registerFunction("http.isOnline", [](const std::vector<Value> &) {
+    api.registerFunction("http.isOnline", [](HostArgs) {
         ensureCurl();
         CURL *curl = curl_easy_init();
         if (!curl) return Value::makeBool(false);
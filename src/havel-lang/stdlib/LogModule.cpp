@@ -12,6 +12,8 @@ void registerDebugModule(const VMApi &) {}
 } // namespace havel::stdlib
 #else
 #include "RuntimeErrorTracker.hpp"
+#include "havel-lang/compiler/runtime/DebugUtils.hpp"
+#include "havel-lang/compiler/vm/VM.hpp"
 #include "../../utils/Logger.hpp"
 #include "core/config/ConfigManager.hpp"
 #include <fstream>
@@ -22,6 +24,7 @@ void registerDebugModule(const VMApi &) {}
 #include <unordered_map>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -50,7 +53,7 @@ static std::string valueToString(const Value &v, const VMApi &api) {
     return "?";
 }
 
-static std::string formatMessage(const std::vector<Value> &args, const VMApi &api) {
+static std::string formatMessage(HostArgs args, const VMApi &api) {
     std::ostringstream ss;
     for (size_t i = 0; i < args.size(); ++i) {
         if (i > 0) ss << " ";
@@ -70,41 +73,41 @@ static std::string getTimestamp() {
 void registerLogModule(const VMApi &api) {
     auto &logger = havel::Logger::getInstance();
 
-    api.registerFunction("log.info", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.info", [api](HostArgs args) -> Value {
         std::string msg = formatMessage(args, api);
         ::havel::info("{}", msg);
         return Value::makeNull();
     });
 
-    api.registerFunction("log.error", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.error", [api](HostArgs args) -> Value {
         std::string msg = formatMessage(args, api);
         ::havel::error("{}", msg);
         return Value::makeNull();
     });
 
-    api.registerFunction("log.warn", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.warn", [api](HostArgs args) -> Value {
         std::string msg = formatMessage(args, api);
         havel::warn("{}", msg);
         return Value::makeNull();
     });
 
-    api.registerFunction("log.debug", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.debug", [api](HostArgs args) -> Value {
         std::string msg = formatMessage(args, api);
         ::havel::debug("{}", msg);
         return Value::makeNull();
     });
 
-    api.registerFunction("log.critical", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.critical", [api](HostArgs args) -> Value {
         std::string msg = formatMessage(args, api);
         havel::critical("{}", msg);
         return Value::makeNull();
     });
 
-    api.registerFunction("log.get", [api, &logger](const std::vector<Value> &) -> Value {
+    api.registerFunction("log.get", [api, &logger](HostArgs) -> Value {
         return api.makeString(logger.getLogFilePath());
     });
 
-    api.registerFunction("log.set", [&logger, api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.set", [&logger, api](HostArgs args) -> Value {
         if (args.empty()) {
             throw std::runtime_error("log.set() requires a file path");
         }
@@ -127,7 +130,7 @@ void registerLogModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("log.history", [&logger, api](const std::vector<Value> &) -> Value {
+    api.registerFunction("log.history", [&logger, api](HostArgs) -> Value {
         auto history = logger.getHistory();
         auto arrId = api.makeArray();
         for (const auto &entry : history) {
@@ -136,19 +139,17 @@ void registerLogModule(const VMApi &api) {
         return arrId;
     });
 
-    api.registerFunction("log.log", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.log", [api](HostArgs args) -> Value {
         if (args.empty()) {
             throw std::runtime_error("log.log() requires at least a target");
         }
 
         std::string target = "stdout";
-        std::vector<Value> msgArgs;
+        HostArgs msgArgs = args;
 
         if (args[0].isStringValId() || args[0].isStringId()) {
             target = api.toString(args[0]);
-            msgArgs = std::vector<Value>(args.begin() + 1, args.end());
-        } else {
-            msgArgs = args;
+            msgArgs = args.subspan(1);
         }
 
         std::string msg = formatMessage(msgArgs, api);
@@ -173,7 +174,7 @@ void registerLogModule(const VMApi &api) {
     });
 
     // Origin-based logging functions
-    api.registerFunction("log.setOriginFilter", [&logger, api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.setOriginFilter", [&logger, api](HostArgs args) -> Value {
         if (args.empty()) {
             throw std::runtime_error("log.setOriginFilter() requires an origin object");
         }
@@ -208,12 +209,12 @@ void registerLogModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("log.clearOriginFilter", [&logger](const std::vector<Value> &) -> Value {
+    api.registerFunction("log.clearOriginFilter", [&logger](HostArgs) -> Value {
         logger.clearOriginFilter();
         return Value::makeNull();
     });
 
-    api.registerFunction("log.debugOrigin", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.debugOrigin", [api](HostArgs args) -> Value {
         if (args.size() < 2) {
             throw std::runtime_error("log.debugOrigin() requires origin and message");
         }
@@ -237,7 +238,7 @@ void registerLogModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("log.infoOrigin", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.infoOrigin", [api](HostArgs args) -> Value {
         if (args.size() < 2) {
             throw std::runtime_error("log.infoOrigin() requires origin and message");
         }
@@ -261,7 +262,7 @@ void registerLogModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("log.warnOrigin", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.warnOrigin", [api](HostArgs args) -> Value {
         if (args.size() < 2) {
             throw std::runtime_error("log.warnOrigin() requires origin and message");
         }
@@ -285,7 +286,7 @@ void registerLogModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("log.errorOrigin", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.errorOrigin", [api](HostArgs args) -> Value {
         if (args.size() < 2) {
             throw std::runtime_error("log.errorOrigin() requires origin and message");
         }
@@ -309,7 +310,7 @@ void registerLogModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("log.fatalOrigin", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("log.fatalOrigin", [api](HostArgs args) -> Value {
         if (args.size() < 2) {
             throw std::runtime_error("log.fatalOrigin() requires origin and message");
         }
@@ -365,19 +366,19 @@ return flags;
 }
 
 void registerDebugModule(const VMApi &api) {
-api.registerFunction("debug.toggleVerboseConditionLogging", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.toggleVerboseConditionLogging", [](HostArgs) -> Value {
 bool current = Configs::Get().Get<bool>("Debug.VerboseConditionLogging", false);
 Configs::Get().Set("Debug.VerboseConditionLogging", !current, true);
 return Value::makeBool(!current);
 });
 
-api.registerFunction("debug.toggleVerboseKeyLogging", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.toggleVerboseKeyLogging", [](HostArgs) -> Value {
 bool current = Configs::Get().Get<bool>("Debug.VerboseKeyLogging", false);
 Configs::Get().Set("Debug.VerboseKeyLogging", !current, true);
 return Value::makeBool(!current);
 });
 
-api.registerFunction("debug.isOn", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.isOn", [api](HostArgs args) -> Value {
 if (args.empty()) return Value::makeBool(false);
 std::string name = api.toString(args[0]);
 auto &f = debugFlags();
@@ -387,7 +388,7 @@ if (it != f.end()) return Value::makeBool(it->second);
 return Value::makeBool(false);
 });
 
-api.registerFunction("debug.setFlag", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.setFlag", [api](HostArgs args) -> Value {
 if (args.size() < 2) return Value::makeNull();
 std::string name = api.toString(args[0]);
 bool val = args[1].isBool() ? args[1].asBool() : (args[1].isInt() && args[1].asInt() != 0);
@@ -400,7 +401,7 @@ f["scope"] = f["emitter"] = f["types"] = true;
 return Value::makeNull();
 });
 
-api.registerFunction("debug.parseDebugArgs", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.parseDebugArgs", [](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!args.empty() && args[0].isArrayId()) {
 // iterate not available here, just set all from known flags
@@ -409,14 +410,14 @@ f["all"] = false;
 return Value::makeNull();
 });
 
-api.registerFunction("debug.trace", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.trace", [api](HostArgs args) -> Value {
 std::string stage = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "?";
 std::string msg = (args.size() > 1 && (args[1].isStringValId() || args[1].isStringId())) ? api.toString(args[1]) : "";
 std::cerr << "[" << stage << "] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceEmitter", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceEmitter", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f.count("emitter") || !f["emitter"]) return Value::makeNull();
 if (!f.count("all") || !f["all"]) {
@@ -427,7 +428,7 @@ std::cerr << "[EMIT] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceBytecode", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceBytecode", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["bytecode"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -435,7 +436,7 @@ std::cerr << "[BC] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceLexer", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceLexer", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["lexer"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -443,7 +444,7 @@ std::cerr << "[LEXER] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceParser", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceParser", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["parser"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -451,7 +452,7 @@ std::cerr << "[PARSER] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceAst", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceAst", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["ast"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -459,7 +460,7 @@ std::cerr << "[AST] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceScope", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceScope", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["scope"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -467,7 +468,7 @@ std::cerr << "[SCOPE] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceTypes", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceTypes", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["types"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -475,7 +476,7 @@ std::cerr << "[TYPES] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.traceGc", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.traceGc", [api](HostArgs args) -> Value {
 auto &f = debugFlags();
 if (!f["gc"] && !f["all"]) return Value::makeNull();
 std::string msg = (!args.empty() && (args[0].isStringValId() || args[0].isStringId())) ? api.toString(args[0]) : "";
@@ -483,36 +484,36 @@ std::cerr << "[GC] " << msg << "\n";
 return Value::makeNull();
 });
 
-api.registerFunction("debug.dumpAst", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.dumpAst", [](HostArgs) -> Value {
 return Value::makeNull();
 });
 
-api.registerFunction("debug.dumpBytecode", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.dumpBytecode", [](HostArgs) -> Value {
 return Value::makeNull();
 });
 
-api.registerFunction("debug.startTimer", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.startTimer", [](HostArgs) -> Value {
 return Value::makeNull();
 });
 
-api.registerFunction("debug.endTimer", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.endTimer", [](HostArgs) -> Value {
 return Value::makeNull();
 });
 
-api.registerFunction("debug.colorize", [](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.colorize", [](HostArgs args) -> Value {
 if (args.empty()) return Value::makeNull();
 return args[0];
 });
 
-api.registerFunction("debug.minimal", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.minimal", [](HostArgs) -> Value {
   return Value::makeBool(Configs::Get().Get<bool>("Debug.ForceMinimal", false));
 });
 
-api.registerFunction("debug.errorCount", [](const std::vector<Value> &) -> Value {
+api.registerFunction("debug.errorCount", [](HostArgs) -> Value {
   return Value::makeInt(static_cast<int64_t>(runtimeErrorCount()));
 });
 
-api.registerFunction("debug.errors", [api](const std::vector<Value> &args) -> Value {
+api.registerFunction("debug.errors", [api](HostArgs args) -> Value {
   auto arr = api.makeArray();
   for (const auto &err : runtimeErrorsList()) {
     api.push(arr, api.makeString(err));
@@ -520,6 +521,44 @@ api.registerFunction("debug.errors", [api](const std::vector<Value> &args) -> Va
   return arr;
 });
 
+// Inline cache state of every property/method site that has run, to find
+// megamorphic sites: {hits, misses, monomorphic, polymorphic, megamorphic,
+// sites: [{function, ip, op, state, ways, hits, misses}]}.
+api.registerFunction("debug.inlineCaches", [api](HostArgs) -> Value {
+  using State = havel::compiler::PropertyInlineCache::State;
+  auto result = api.makeObject();
+  auto sites = api.makeArray();
+  int64_t hits = 0, misses = 0, mono = 0, poly = 0, mega = 0;
+  for (const auto &site : api.vm().inlineCacheStats()) {
+    const char *state = "empty";
+    switch (site.state) {
+    case State::Monomorphic: state = "monomorphic"; ++mono; break;
+    case State::Polymorphic: state = "polymorphic"; ++poly; break;
+    case State::Megamorphic: state = "megamorphic"; ++mega; break;
+    case State::Empty: break;
+    }
+    hits += static_cast<int64_t>(site.hits);
+    misses += static_cast<int64_t>(site.misses);
+    auto entry = api.makeObject();
+    api.setField(entry, "function", api.makeString(site.function));
+    api.setField(entry, "ip", Value::makeInt(site.ip));
+    api.setField(entry, "op", api.makeString(
+        havel::compiler::BytecodeDisassembler::opcodeToString(site.opcode)));
+    api.setField(entry, "state", api.makeString(state));
+    api.setField(entry, "ways", Value::makeInt(site.ways));
+    api.setField(entry, "hits", Value::makeInt(static_cast<int64_t>(site.hits)));
+    api.setField(entry, "misses", Value::makeInt(static_cast<int64_t>(site.misses)));
+    api.push(sites, entry);
+  }
+  api.setField(result, "hits", Value::makeInt(hits));
+  api.setField(result, "misses", Value::makeInt(misses));
+  api.setField(result, "monomorphic", Value::makeInt(mono));
+  api.setField(result, "polymorphic", Value::makeInt(poly));
+  api.setField(result, "megamorphic", Value::makeInt(mega));
+  api.setField(result, "sites", sites);
+  return result;
+});
+
 auto debugObj = api.makeObject();
 api.setField(debugObj, "toggleVerboseConditionLogging", api.makeFunctionRef("debug.toggleVerboseConditionLogging"));
 api.setField(debugObj, "toggleVerboseKeyLogging", api.makeFunctionRef("debug.toggleVerboseKeyLogging"));
@@ -543,6 +582,7 @@ api.setField(debugObj, "colorize", api.makeFunctionRef("debug.colorize"));
 api.setField(debugObj, "minimal", api.makeFunctionRef("debug.minimal"));
 api.setField(debugObj, "errorCount", api.makeFunctionRef("debug.errorCount"));
 api.setField(debugObj, "errors", api.makeFunctionRef("debug.errors"));
+api.setField(debugObj, "inlineCaches", api.makeFunctionRef("debug.inlineCaches"));
 api.setGlobal("debug", debugObj);
 }
 
@@ -11,6 +11,7 @@
 #include <limits>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -37,65 +38,55 @@ void registerMathModule(const VMApi &api) {
   auto &vm = api.vm();
 
   // --- cmath host bridges (require native <cmath>) ---
+  // Fixed-arity forms: the VM checks the argument count.
 
-  api.registerFunction("math.ceil", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.ceil() requires 1 argument");
-    return Value(std::ceil(toNum(args[0])));
+  api.registerFunction("math.ceil", [](const Value &x) {
+    return Value(std::ceil(toNum(x)));
   });
-  api.registerFunction("math.floor", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.floor() requires 1 argument");
-    return Value(std::floor(toNum(args[0])));
+  api.registerFunction("math.floor", [](const Value &x) {
+    return Value(std::floor(toNum(x)));
   });
-  api.registerFunction("math.round", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.round() requires 1 argument");
-    return Value(std::round(toNum(args[0])));
+  api.registerFunction("math.round", [](const Value &x) {
+    return Value(std::round(toNum(x)));
   });
-  api.registerFunction("math.sin", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.sin() requires 1 argument");
-    return Value(std::sin(toNum(args[0])));
+  api.registerFunction("math.sin", [](const Value &x) {
+    return Value(std::sin(toNum(x)));
   });
-  api.registerFunction("math.cos", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.cos() requires 1 argument");
-    return Value(std::cos(toNum(args[0])));
+  api.registerFunction("math.cos", [](const Value &x) {
+    return Value(std::cos(toNum(x)));
   });
-  api.registerFunction("math.tan", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.tan() requires 1 argument");
-    return Value(std::tan(toNum(args[0])));
+  api.registerFunction("math.tan", [](const Value &x) {
+    return Value(std::tan(toNum(x)));
   });
-  api.registerFunction("math.sqrt", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.sqrt() requires 1 argument");
-    double val = toNum(args[0]);
+  api.registerFunction("math.sqrt", [](const Value &x) {
+    double val = toNum(x);
     if (val < 0) throw std::runtime_error("math.sqrt() argument must be non-negative");
     return Value(std::sqrt(val));
   });
-  api.registerFunction("math.log", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.log() requires 1 argument");
-    double val = toNum(args[0]);
+  api.registerFunction("math.log", [](const Value &x) {
+    double val = toNum(x);
     if (val <= 0) throw std::runtime_error("math.log() argument must be positive");
     return Value(std::log(val));
   });
-  api.registerFunction("math.exp", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.exp() requires 1 argument");
-    return Value(std::exp(toNum(args[0])));
+  api.registerFunction("math.exp", [](const Value &x) {
+    return Value(std::exp(toNum(x)));
   });
-  api.registerFunction("math.pow", [](const std::vector<Value> &args) {
-    if (args.size() != 2) throw std::runtime_error("math.pow() requires 2 arguments");
-    return Value(std::pow(toNum(args[0]), toNum(args[1])));
+  api.registerFunction("math.pow", [](const Value &base, const Value &exponent) {
+    return Value(std::pow(toNum(base), toNum(exponent)));
   });
-  api.registerFunction("math.random", [](const std::vector<Value> &) {
+  api.registerFunction("math.random", [](HostArgs) {
     return Value(static_cast<double>(std::rand()) / RAND_MAX);
   });
-  api.registerFunction("math.abs", [](const std::vector<Value> &args) {
-    if (args.size() != 1) throw std::runtime_error("math.abs() requires 1 argument");
-    return Value(std::abs(toNum(args[0])));
+  api.registerFunction("math.abs", [](const Value &x) {
+    return Value(std::abs(toNum(x)));
   });
-  api.registerFunction("math.min", [](const std::vector<Value> &args) {
+  api.registerFunction("math.min", [](HostArgs args) {
     if (args.empty()) throw std::runtime_error("math.min() requires at least 1 argument");
     double min = toNum(args[0]);
     for (size_t i = 1; i < args.size(); ++i) { double val = toNum(args[i]); if (val < min) min = val; }
     return Value(min);
   });
-  api.registerFunction("math.max", [](const std::vector<Value> &args) {
+  api.registerFunction("math.max", [](HostArgs args) {
     if (args.empty()) throw std::runtime_error("math.max() requires at least 1 argument");
     double max = toNum(args[0]);
     for (size_t i = 1; i < args.size(); ++i) { double val = toNum(args[i]); if (val > max) max = val; }
@@ -7,6 +7,7 @@
 #include <algorithm>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 using havel::compiler::ObjectRef;
 
@@ -19,7 +20,7 @@ static bool isInternalKey(const std::string &key) {
 
 void registerObjectModule(const VMApi &api) {
     // Object.keys(obj) - Get all keys of an object
-    api.registerFunction("object.keys", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.keys", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("Object.keys() requires object");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.keys() arg must be object");
 
@@ -34,7 +35,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.values(obj) - Get all values of an object
-    api.registerFunction("object.values", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.values", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("Object.values() requires object");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.values() arg must be object");
 
@@ -49,7 +50,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.entries(obj) - Get all entries of an object as [key, value] pairs
-    api.registerFunction("object.entries", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.entries", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("Object.entries() requires object");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.entries() arg must be object");
 
@@ -67,7 +68,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.has(obj, key) - Check if object has a key
-    api.registerFunction("object.has", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.has", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("Object.has() requires object and key");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.has() first arg must be object");
 
@@ -76,7 +77,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.find(obj, key) - Find key index in object, returns index >= 0 or -1
-    api.registerFunction("object.find", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.find", [api](HostArgs args) {
         if (args.size() < 2) return Value::makeInt(-1);
         if (!args[0].isObjectId()) return Value::makeInt(-1);
 
@@ -89,7 +90,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.set(obj, key, value) - Set a value on an object
-    api.registerFunction("object.set", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.set", [api](HostArgs args) {
         if (args.size() < 3) throw std::runtime_error("Object.set() requires object, key, and value");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.set() first arg must be object");
         if (!args[1].isStringId() && !args[1].isStringValId()) throw std::runtime_error("Object.set() second arg must be key string");
@@ -100,7 +101,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.delete(obj, key) - Delete a value from an object
-    api.registerFunction("object.delete", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.delete", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("Object.delete() requires object and key");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.delete() first arg must be object");
         if (!args[1].isStringId() && !args[1].isStringValId()) throw std::runtime_error("Object.delete() second arg must be key string");
@@ -110,7 +111,7 @@ void registerObjectModule(const VMApi &api) {
   });
 
   // Object.freeze(obj) - Freeze object (no additions, deletions, or modifications)
-  api.registerFunction("object.freeze", [api](const std::vector<Value>& args) {
+  api.registerFunction("object.freeze", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("Object.freeze() requires object");
     if (!args[0].isObjectId()) throw std::runtime_error("Object.freeze() arg must be object");
     api.freeze(args[0]);
@@ -118,7 +119,7 @@ void registerObjectModule(const VMApi &api) {
   });
 
   // Object.seal(obj) - Seal object (no additions or deletions, modifications allowed)
-  api.registerFunction("object.seal", [api](const std::vector<Value>& args) {
+  api.registerFunction("object.seal", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("Object.seal() requires object");
     if (!args[0].isObjectId()) throw std::runtime_error("Object.seal() arg must be object");
     api.seal(args[0]);
@@ -126,21 +127,21 @@ void registerObjectModule(const VMApi &api) {
   });
 
   // Object.isFrozen(obj) - Check if object is frozen
-  api.registerFunction("object.isFrozen", [api](const std::vector<Value>& args) {
+  api.registerFunction("object.isFrozen", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("Object.isFrozen() requires object");
     if (!args[0].isObjectId()) throw std::runtime_error("Object.isFrozen() arg must be object");
     return Value::makeBool(api.isFrozen(args[0]));
   });
 
   // Object.isSealed(obj) - Check if object is sealed
-  api.registerFunction("object.isSealed", [api](const std::vector<Value>& args) {
+  api.registerFunction("object.isSealed", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("Object.isSealed() requires object");
     if (!args[0].isObjectId()) throw std::runtime_error("Object.isSealed() arg must be object");
     return Value::makeBool(api.isSealed(args[0]));
   });
 
     // Object.isEmpty(obj) - Check if object has no user keys
-    api.registerFunction("object.isEmpty", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.isEmpty", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("Object.isEmpty() requires object");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.isEmpty() arg must be object");
 
@@ -152,7 +153,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // Object.size(obj) - Get number of keys in object
-    api.registerFunction("object.size", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.size", [api](HostArgs args) {
         if (args.empty()) throw std::runtime_error("Object.size() requires object");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.size() arg must be object");
 
@@ -165,7 +166,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
   // object.len(obj) - Alias for size, dispatches to execLengthOp for non-objects
-  api.registerFunction("object.len", [api](const std::vector<Value>& args) {
+  api.registerFunction("object.len", [api](HostArgs args) {
     if (args.empty()) throw std::runtime_error("object.len() requires an argument");
     if (!args[0].isObjectId()) {
       return api.vm().execLengthOpPublic(args[0]);
@@ -179,7 +180,7 @@ void registerObjectModule(const VMApi &api) {
   });
 
     // object.map(obj, func) - Map object values
-    api.registerFunction("object.map", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.map", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("Object.map() requires object and function");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.map() first arg must be object");
         
@@ -194,7 +195,7 @@ void registerObjectModule(const VMApi &api) {
     });
 
     // object.filter(obj, func) - Filter object keys
-    api.registerFunction("object.filter", [api](const std::vector<Value>& args) {
+    api.registerFunction("object.filter", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("Object.filter() requires object and function");
         if (!args[0].isObjectId()) throw std::runtime_error("Object.filter() first arg must be object");
         
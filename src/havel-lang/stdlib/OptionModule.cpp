@@ -1,6 +1,7 @@
 #include "OptionModule.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -11,13 +12,13 @@ void registerOptionModule(const VMApi &api) {
     Value noneSingleton = api.makeEnum(optionTypeId, 1, {});
     api.setGlobal("None", noneSingleton);
 
-    api.registerFunction("Some", 1, [api, optionTypeId](const std::vector<Value> &args) {
+    api.registerFunction("Some", 1, [api, optionTypeId](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("Some() requires 1 argument");
         return api.makeEnum(optionTypeId, 0, {args[0]});
     });
 
-    api.registerFunction("Option.isSome", 1, [api, optionTypeId](const std::vector<Value> &args) {
+    api.registerFunction("Option.isSome", 1, [api, optionTypeId](HostArgs args) {
         if (args.empty() || !args[0].isEnumId())
             return Value::makeBool(false);
         if (args[0].asEnumTypeId() != optionTypeId)
@@ -26,7 +27,7 @@ void registerOptionModule(const VMApi &api) {
         return Value::makeBool(tag == 0);
     });
 
-    api.registerFunction("Option.isNone", 1, [api, optionTypeId](const std::vector<Value> &args) {
+    api.registerFunction("Option.isNone", 1, [api, optionTypeId](HostArgs args) {
         if (args.empty() || !args[0].isEnumId())
             return Value::makeBool(false);
         if (args[0].asEnumTypeId() != optionTypeId)
@@ -35,7 +36,7 @@ void registerOptionModule(const VMApi &api) {
         return Value::makeBool(tag == 1);
     });
 
-    api.registerFunction("Option.unwrap", 1, [api, optionTypeId](const std::vector<Value> &args) {
+    api.registerFunction("Option.unwrap", 1, [api, optionTypeId](HostArgs args) {
         if (args.empty() || !args[0].isEnumId() || args[0].asEnumTypeId() != optionTypeId)
             throw std::runtime_error("Option.unwrap: not an Option value");
         uint32_t tag = api.getEnumTag(args[0]);
@@ -44,7 +45,7 @@ void registerOptionModule(const VMApi &api) {
         return api.getEnumPayload(args[0], 0);
     });
 
-    api.registerFunction("Option.unwrapOr", 2, [api, optionTypeId](const std::vector<Value> &args) {
+    api.registerFunction("Option.unwrapOr", 2, [api, optionTypeId](HostArgs args) {
         if (args.size() < 2)
             throw std::runtime_error("Option.unwrapOr requires 2 arguments");
         if (!args[0].isEnumId() || args[0].asEnumTypeId() != optionTypeId)
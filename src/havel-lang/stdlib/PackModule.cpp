@@ -1,11 +1,13 @@
 #include "PackModule.hpp"
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <stdexcept>
 #include <vector>
 #include <string>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -132,8 +134,9 @@ static double getFloatArg(const Value &v) {
     throw std::runtime_error("pack: expected float value");
 }
 
-void registerPackModule(const VMApi &api) {
-  api.registerFunction("pack.pack", [api](const std::vector<Value> &args) {
+// Encodes args[1..] by the format in args[0]; shared by pack.pack and
+// pack.bytes, which differ only in how the result is handed back.
+static std::vector<uint8_t> packArgs(const VMApi &api, HostArgs args) {
     if (args.empty())
       throw std::runtime_error("pack.pack() requires a format string");
     const auto &fmtVal = args[0];
@@ -241,35 +244,53 @@ void registerPackModule(const VMApi &api) {
             }
         }
 
+        return out;
+}
+
+void registerPackModule(const VMApi &api) {
+  api.registerFunction("pack.pack", [api](HostArgs args) {
+        auto out = packArgs(api, args);
         Value arr = api.makeArray();
         for (auto b : out)
             api.push(arr, Value(static_cast<int64_t>(b)));
         return arr;
     });
 
-  api.registerFunction("pack.unpack", [api](const std::vector<Value> &args) {
+  // Same encoding, returned as a byte buffer that takes over the vector.
+  api.registerFunction("pack.bytes", [api](HostArgs args) {
+    return api.makeBytes(packArgs(api, args));
+  });
+
+  api.registerFunction("pack.unpack", [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("pack.unpack() requires a format string and byte array");
     const auto &fmtVal = args[0];
     const auto &dataVal = args[1];
     if (!fmtVal.isStringValId() && !fmtVal.isStringId())
       throw std::runtime_error("pack.unpack(): first argument must be a format string");
-    if (!dataVal.isArrayId())
-      throw std::runtime_error("pack.unpack(): second argument must be a byte array");
+    if (!dataVal.isArrayId() && !dataVal.isBytesId())
+      throw std::runtime_error("pack.unpack(): second argument must be a byte array or bytes");
 
         std::string fmt = api.toString(fmtVal);
-        uint32_t dataLen = api.length(dataVal);
+        uint32_t dataLen = dataVal.isArrayId() ? api.length(dataVal) : 0;
         size_t offset = 0;
         if (args.size() >= 3 && args[2].isInt())
             offset = static_cast<size_t>(args[2].asInt());
 
         FormatIter fi(fmt);
-        std::vector<uint8_t> raw;
-        raw.reserve(dataLen);
-        for (uint32_t i = 0; i < dataLen; ++i) {
-            Value elem = api.getAt(dataVal, i);
-            raw.push_back(elem.isInt()
-                ? static_cast<uint8_t>(elem.asInt() & 0xFF) : 0);
+        // Byte buffers are decoded in place; arrays are narrowed to a copy.
+        std::vector<uint8_t> copied;
+        std::span<const uint8_t> raw;
+        if (dataVal.isBytesId()) {
+            raw = api.bytes(dataVal);
+        } else {
+            copied.reserve(dataLen);
+            for (uint32_t i = 0; i < dataLen; ++i) {
+                Value elem = api.getAt(dataVal, i);
+                copied.push_back(elem.isInt()
+                    ? static_cast<uint8_t>(elem.asInt() & 0xFF) : 0);
+            }
+            raw = copied;
         }
 
         Value result = api.makeArray();
@@ -390,6 +411,7 @@ void registerPackModule(const VMApi &api) {
   auto packObj = api.makeObject();
   api.setField(packObj, "pack", api.makeFunctionRef("pack.pack"));
   api.setField(packObj, "unpack", api.makeFunctionRef("pack.unpack"));
+  api.setField(packObj, "bytes", api.makeFunctionRef("pack.bytes"));
   api.setGlobal("pack", packObj);
 }
 
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -27,7 +28,7 @@ static Value typedRead(const Value &ptrVal) {
 }
 
 template <typename T>
-static Value typedWrite(const std::vector<Value> &args) {
+static Value typedWrite(HostArgs args) {
     if (args.size() < 2) throw std::runtime_error("requires pointer and value");
     void *p = getPtr(args[0]);
     if (!p) throw std::runtime_error("null pointer dereference");
@@ -42,7 +43,7 @@ static Value typedWrite(const std::vector<Value> &args) {
 }
 
 void registerPointerModule(const VMApi &api) {
-	api.registerFunction("ptr.create", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.create", [](HostArgs args) {
 		if (args.empty())
 			throw std::runtime_error("ptr() requires a value");
 		const auto &v = args[0];
@@ -61,7 +62,7 @@ void registerPointerModule(const VMApi &api) {
 		throw std::runtime_error("ptr() expects an integer address or null");
 	});
 
-	api.registerFunction("ptr.deref", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref", [](HostArgs args) {
 		if (args.empty())
 			throw std::runtime_error("deref() requires a pointer");
 		const auto &v = args[0];
@@ -74,7 +75,7 @@ void registerPointerModule(const VMApi &api) {
 		return Value(static_cast<int64_t>(addr));
 	});
 
-	api.registerFunction("ptr.offset", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.offset", [](HostArgs args) {
 		if (args.size() < 2)
 			throw std::runtime_error("offset() requires a pointer and offset");
 		const auto &base = args[0];
@@ -86,7 +87,7 @@ void registerPointerModule(const VMApi &api) {
 		return Value::makePtr(reinterpret_cast<void *>(addr + delta));
 	});
 
-	api.registerFunction("ptr.eq", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.eq", [](HostArgs args) {
 		if (args.size() < 2)
 			throw std::runtime_error("ptreq() requires two pointers");
 		const auto &a = args[0];
@@ -101,75 +102,75 @@ void registerPointerModule(const VMApi &api) {
 		return Value(va == vb);
 	});
 
-	api.registerFunction("ptr.deref_i8", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_i8", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.i8() requires a pointer");
 		return typedRead<int8_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_i16", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_i16", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.i16() requires a pointer");
 		return typedRead<int16_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_i32", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_i32", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.i32() requires a pointer");
 		return typedRead<int32_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_i64", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_i64", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.i64() requires a pointer");
 		return typedRead<int64_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_u8", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_u8", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.u8() requires a pointer");
 		return typedRead<uint8_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_u16", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_u16", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.u16() requires a pointer");
 		return typedRead<uint16_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_u32", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_u32", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.u32() requires a pointer");
 		return typedRead<uint32_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_u64", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_u64", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.u64() requires a pointer");
 		return typedRead<uint64_t>(args[0]);
 	});
-	api.registerFunction("ptr.deref_f32", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_f32", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.f32() requires a pointer");
 		return typedRead<float>(args[0]);
 	});
-	api.registerFunction("ptr.deref_f64", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.deref_f64", [](HostArgs args) {
 		if (args.empty()) throw std::runtime_error("deref.f64() requires a pointer");
 		return typedRead<double>(args[0]);
 	});
 
-	api.registerFunction("ptr.write_i8", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_i8", [](HostArgs args) {
 		return typedWrite<int8_t>(args);
 	});
-	api.registerFunction("ptr.write_i16", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_i16", [](HostArgs args) {
 		return typedWrite<int16_t>(args);
 	});
-	api.registerFunction("ptr.write_i32", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_i32", [](HostArgs args) {
 		return typedWrite<int32_t>(args);
 	});
-	api.registerFunction("ptr.write_i64", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_i64", [](HostArgs args) {
 		return typedWrite<int64_t>(args);
 	});
-	api.registerFunction("ptr.write_u8", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_u8", [](HostArgs args) {
 		return typedWrite<uint8_t>(args);
 	});
-	api.registerFunction("ptr.write_u16", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_u16", [](HostArgs args) {
 		return typedWrite<uint16_t>(args);
 	});
-	api.registerFunction("ptr.write_u32", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_u32", [](HostArgs args) {
 		return typedWrite<uint32_t>(args);
 	});
-	api.registerFunction("ptr.write_u64", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_u64", [](HostArgs args) {
 		return typedWrite<uint64_t>(args);
 	});
-	api.registerFunction("ptr.write_f32", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_f32", [](HostArgs args) {
 		return typedWrite<float>(args);
 	});
-	api.registerFunction("ptr.write_f64", [](const std::vector<Value> &args) {
+	api.registerFunction("ptr.write_f64", [](HostArgs args) {
 		return typedWrite<double>(args);
 	});
 
@@ -16,6 +16,7 @@
 #endif
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -114,7 +115,7 @@ void registerRandomModule(const VMApi &api) {
 
   // ─── Basic random ─────────────────────────────────────────────
   api.registerFunction(
-      "random.num", [](const std::vector<Value> &args) {
+      "random.num", [](HostArgs args) {
         if (args.empty()) {
           return Value::makeDouble(
               std::uniform_real_distribution<double>(0.0, 1.0)(g_rng));
@@ -130,7 +131,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.int", [](const std::vector<Value> &args) {
+      "random.int", [](HostArgs args) {
         if (args.size() == 1) {
           int64_t mx = toInt(args[0]);
           return Value(
@@ -145,7 +146,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.range", [](const std::vector<Value> &args) {
+      "random.range", [](HostArgs args) {
         if (args.empty()) {
           throw std::runtime_error("random.range() requires at least 1 "
                                    "argument");
@@ -177,7 +178,7 @@ void registerRandomModule(const VMApi &api) {
 
   // ─── Seeding ───────────────────────────────────────────────────
   api.registerFunction(
-      "random.seed", [](const std::vector<Value> &args) {
+      "random.seed", [](HostArgs args) {
         if (args.empty())
           throw std::runtime_error("random.seed() requires 1 argument");
         const auto &v = args[0];
@@ -206,13 +207,13 @@ void registerRandomModule(const VMApi &api) {
         return Value::makeNull();
       });
 
-  api.registerFunction("random.getSeed", [](const std::vector<Value> &) {
+  api.registerFunction("random.getSeed", [](HostArgs) {
     return Value::makeNull();
   });
 
   // ─── Distributions ─────────────────────────────────────────────
   api.registerFunction(
-      "random.normal", [](const std::vector<Value> &args) {
+      "random.normal", [](HostArgs args) {
         double mean = 0.0, std = 1.0;
         if (args.size() >= 1)
           mean = toNum(args[0]);
@@ -223,7 +224,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.exp", [](const std::vector<Value> &args) {
+      "random.exp", [](HostArgs args) {
         double lambda = 1.0;
         if (args.size() >= 1)
           lambda = toNum(args[0]);
@@ -231,7 +232,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.uniform", [](const std::vector<Value> &args) {
+      "random.uniform", [](HostArgs args) {
         double lo = 0.0, hi = 1.0;
         if (args.size() >= 1)
           lo = toNum(args[0]);
@@ -242,7 +243,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.gamma", [](const std::vector<Value> &args) {
+      "random.gamma", [](HostArgs args) {
         double shape = 1.0, scale = 1.0;
         if (args.size() >= 1)
           shape = toNum(args[0]);
@@ -253,7 +254,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.beta", [](const std::vector<Value> &args) -> Value {
+      "random.beta", [](HostArgs args) -> Value {
         double a = 1.0, b = 1.0;
         if (args.size() >= 1)
           a = toNum(args[0]);
@@ -268,7 +269,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.poisson", [](const std::vector<Value> &args) {
+      "random.poisson", [](HostArgs args) {
         double lambda = 1.0;
         if (args.size() >= 1)
           lambda = toNum(args[0]);
@@ -279,7 +280,7 @@ void registerRandomModule(const VMApi &api) {
 
   // ─── Array operations ──────────────────────────────────────────
   api.registerFunction(
-      "random.choice", [api](const std::vector<Value> &args) {
+      "random.choice", [api](HostArgs args) {
         if (args.empty() || !args[0].isArrayId())
           throw std::runtime_error("random.choice() requires an array");
         size_t len = api.length(args[0]);
@@ -291,7 +292,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.choices", [api](const std::vector<Value> &args) {
+      "random.choices", [api](HostArgs args) {
         if (args.size() < 2 || !args[0].isArrayId())
           throw std::runtime_error(
               "random.choices() requires array and k");
@@ -314,7 +315,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.sample", [api](const std::vector<Value> &args) {
+      "random.sample", [api](HostArgs args) {
         if (args.size() < 2 || !args[0].isArrayId())
           throw std::runtime_error(
               "random.sample() requires array and k");
@@ -340,7 +341,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.shuffle", [api](const std::vector<Value> &args) {
+      "random.shuffle", [api](HostArgs args) {
         if (args.empty() || !args[0].isArrayId())
           throw std::runtime_error("random.shuffle() requires an array");
         size_t len = api.length(args[0]);
@@ -358,7 +359,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.shuffled", [api](const std::vector<Value> &args) {
+      "random.shuffled", [api](HostArgs args) {
         if (args.empty() || !args[0].isArrayId())
           throw std::runtime_error(
               "random.shuffled() requires an array");
@@ -379,7 +380,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.permutation", [api](const std::vector<Value> &args) {
+      "random.permutation", [api](HostArgs args) {
         if (args.empty())
           throw std::runtime_error(
               "random.permutation() requires n");
@@ -404,7 +405,7 @@ void registerRandomModule(const VMApi &api) {
 
   // ─── Weighted random ───────────────────────────────────────────
   api.registerFunction(
-      "random.weighted", [api](const std::vector<Value> &args) {
+      "random.weighted", [api](HostArgs args) {
         if (args.empty() || !args[0].isArrayId())
           throw std::runtime_error(
               "random.weighted() requires weights array");
@@ -434,7 +435,7 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.weightedChoice", [api](const std::vector<Value> &args) {
+      "random.weightedChoice", [api](HostArgs args) {
         if (args.size() < 2 || !args[0].isArrayId() ||
             !args[1].isArrayId())
           throw std::runtime_error(
@@ -466,7 +467,7 @@ void registerRandomModule(const VMApi &api) {
 
   // ─── Utility ───────────────────────────────────────────────────
   api.registerFunction(
-      "random.bool", [](const std::vector<Value> &args) {
+      "random.bool", [](HostArgs args) {
         double prob = 0.5;
         if (args.size() >= 1)
           prob = toNum(args[0]);
@@ -475,14 +476,14 @@ void registerRandomModule(const VMApi &api) {
       });
 
   api.registerFunction(
-      "random.byte", [](const std::vector<Value> &) {
+      "random.byte", [](HostArgs) {
         return Value(
             static_cast<double>(
                 std::uniform_int_distribution<int>(0, 255)(g_rng)));
       });
 
   api.registerFunction(
-      "random.bytes", [api](const std::vector<Value> &args) {
+      "random.bytes", [api](HostArgs args) {
         if (args.empty())
           throw std::runtime_error(
               "random.bytes() requires count");
@@ -510,12 +511,12 @@ void registerRandomModule(const VMApi &api) {
   // We create wrapper lambdas that delegate to the main functions.
 
   // Note: For aliases we register them as host functions that call through
-  api.registerFunction("rand", [](const std::vector<Value> &args) {
+  api.registerFunction("rand", [](HostArgs args) {
     return Value(std::uniform_real_distribution<double>(0.0, 1.0)(g_rng));
   });
 
   api.registerFunction(
-      "randint", [](const std::vector<Value> &args) {
+      "randint", [](HostArgs args) {
         if (args.size() == 1) {
           int64_t mx = toInt(args[0]);
           return Value(
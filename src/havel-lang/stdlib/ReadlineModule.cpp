@@ -37,6 +37,7 @@ static int write_history(const char *) { return 0; }
 #include "havel-lang/compiler/vm/VMApi.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -75,7 +76,7 @@ static char *completion_generator(const char *text, int state) {
 // ----------------------------------------------------------------------
 static void register_readline_functions(const VMApi &api) {
     api.registerFunction("readline.readline",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             std::string prompt;
             if (!args.empty()) prompt = api.resolveString(args[0]);
             
@@ -105,7 +106,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.add_history – add a line to history
     // ----------------------------------------------------------------------
     api.registerFunction("readline.add_history",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             if (args.empty()) return Value::makeNull();
             std::string line = api.resolveString(args[0]);
 #ifdef HAVE_READLINE
@@ -118,7 +119,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.read_history – load history from file
     // ----------------------------------------------------------------------
     api.registerFunction("readline.read_history",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             std::string path;
             if (!args.empty()) path = api.resolveString(args[0]);
             else {
@@ -138,7 +139,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.write_history – save history to file
     // ----------------------------------------------------------------------
     api.registerFunction("readline.write_history",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             std::string path;
             if (!args.empty()) path = api.resolveString(args[0]);
             else {
@@ -158,7 +159,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.clear_history – clear in-memory history
     // ----------------------------------------------------------------------
     api.registerFunction("readline.clear_history",
-        [](const std::vector<Value> &) {
+        [](HostArgs) {
 #ifdef HAVE_READLINE
             clear_history();
 #endif
@@ -169,7 +170,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.history_length – get current history length
     // ----------------------------------------------------------------------
     api.registerFunction("readline.history_length",
-        [](const std::vector<Value> &) {
+        [](HostArgs) {
 #ifdef HAVE_READLINE
             return Value::makeInt(history_length);
 #else
@@ -181,7 +182,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.add_completion_word – add a word to completion dictionary
     // ----------------------------------------------------------------------
     api.registerFunction("readline.add_completion_word",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
 #ifdef HAVE_READLINE
             if (args.empty()) return Value::makeNull();
             std::string word = api.resolveString(args[0]);
@@ -203,7 +204,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.clear_completion_words – clear completion dictionary
     // ----------------------------------------------------------------------
     api.registerFunction("readline.clear_completion_words",
-        [](const std::vector<Value> &) {
+        [](HostArgs) {
 #ifdef HAVE_READLINE
             g_completion_words.clear();
             g_completion_initialized = false;
@@ -216,7 +217,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.add_history – add a line to history
     // ----------------------------------------------------------------------
     api.registerFunction("readline.add_history",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             if (args.empty()) return Value::makeNull();
             std::string line = api.resolveString(args[0]);
 #ifdef HAVE_READLINE
@@ -229,7 +230,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.read_history – load history from file
     // ----------------------------------------------------------------------
     api.registerFunction("readline.read_history",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             std::string path;
             if (!args.empty()) path = api.resolveString(args[0]);
             else {
@@ -249,7 +250,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.write_history – save history to file
     // ----------------------------------------------------------------------
     api.registerFunction("readline.write_history",
-        [api](const std::vector<Value> &args) {
+        [api](HostArgs args) {
             std::string path;
             if (!args.empty()) path = api.resolveString(args[0]);
             else {
@@ -269,7 +270,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.clear_history – clear in-memory history
     // ----------------------------------------------------------------------
     api.registerFunction("readline.clear_history",
-        [](const std::vector<Value> &) {
+        [](HostArgs) {
 #ifdef HAVE_READLINE
             clear_history();
 #endif
@@ -280,7 +281,7 @@ static void register_readline_functions(const VMApi &api) {
     // readline.history_length – get current history length
     // ----------------------------------------------------------------------
     api.registerFunction("readline.history_length",
-        [](const std::vector<Value> &) {
+        [](HostArgs) {
 #ifdef HAVE_READLINE
             return Value::makeInt(history_length);
 #else
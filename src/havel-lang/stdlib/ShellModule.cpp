@@ -36,6 +36,7 @@
 #include "core/process/Launcher.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace fs = std::filesystem;
@@ -278,7 +279,7 @@ void registerShellModule(const VMApi &api) {
 // shell.run – execute command (non-blocking, returns pid on success)
 // ----------------------------------------------------------------------
 api.registerFunction("shell.run",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("shell.run() requires a command string");
     std::string cmd = api.resolveString(args[0]);
@@ -299,7 +300,7 @@ api.registerFunction("shell.run",
 // shell.exec – capture stdout of command (returns object {stdout, stderr, exitCode})
 // ----------------------------------------------------------------------
 api.registerFunction("shell.exec",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (api.vm().getScheduler()) {
       api.vm().getScheduler()->yieldCurrentAndCheckTimers();
     }
@@ -332,7 +333,7 @@ api.registerFunction("shell.exec",
   // shell.which – locate executable in PATH
   // ----------------------------------------------------------------------
   api.registerFunction("shell.which",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         return Value::makeNull();
       std::string name = api.resolveString(args[0]);
@@ -373,7 +374,7 @@ api.registerFunction("shell.exec",
   // shell.env – get / set a single environment variable
   // ----------------------------------------------------------------------
   api.registerFunction("shell.env",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         return Value::makeNull();
       std::string name = api.resolveString(args[0]);
@@ -400,7 +401,7 @@ api.registerFunction("shell.exec",
   // shell.cwd – current working directory
   // ----------------------------------------------------------------------
   api.registerFunction("shell.cwd",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
       return api.makeString(fs::current_path().string());
     });
 
@@ -408,7 +409,7 @@ api.registerFunction("shell.exec",
   // shell.getenv – get environment variable (readonly, returns null if missing)
   // ----------------------------------------------------------------------
   api.registerFunction("shell.getenv",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         return Value::makeNull();
       std::string name = api.resolveString(args[0]);
@@ -422,7 +423,7 @@ api.registerFunction("shell.exec",
   // shell.cd – change directory
   // ----------------------------------------------------------------------
   api.registerFunction("shell.cd",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         return Value::makeBool(false);
       std::string path = api.resolveString(args[0]);
@@ -437,7 +438,7 @@ api.registerFunction("shell.exec",
   // shell.escape – shell‑safe quoting
   // ----------------------------------------------------------------------
   api.registerFunction("shell.escape",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
 #ifdef _WIN32
         return api.makeString("\"\"");
@@ -475,7 +476,7 @@ api.registerFunction("shell.exec",
   // shell.platform – returns OS identifier (e.g. "linux", "windows", "macos")
   // ----------------------------------------------------------------------
 api.registerFunction("shell.platform",
-[&api](const std::vector<Value>&) {
+[&api](HostArgs) {
 return api.makeString(getPlatform());
     });
 
@@ -483,7 +484,7 @@ return api.makeString(getPlatform());
   // shell.pid – current process ID
   // ----------------------------------------------------------------------
   api.registerFunction("shell.pid",
-      [](const std::vector<Value>&) {
+      [](HostArgs) {
 #ifdef _WIN32
       return Value::makeInt(static_cast<int64_t>(GetCurrentProcessId()));
 #else
@@ -495,7 +496,7 @@ return api.makeString(getPlatform());
   // shell.home – user home directory path
   // ----------------------------------------------------------------------
   api.registerFunction("shell.home",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
       std::string home;
 #ifdef _WIN32
       const char *drive = std::getenv("HOMEDRIVE");
@@ -520,7 +521,7 @@ return api.makeString(getPlatform());
   // shell.tmpdir – system temporary directory
   // ----------------------------------------------------------------------
   api.registerFunction("shell.tmpdir",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
 #ifdef _WIN32
       char buf[MAX_PATH];
       DWORD len = GetTempPathA(MAX_PATH, buf);
@@ -544,7 +545,7 @@ return api.makeString(getPlatform());
   // shell.hostname – system host name
   // ----------------------------------------------------------------------
   api.registerFunction("shell.hostname",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
       char buf[256];
 #ifdef _WIN32
       DWORD size = sizeof(buf);
@@ -561,7 +562,7 @@ return api.makeString(getPlatform());
   // shell.user – current user name
   // ----------------------------------------------------------------------
   api.registerFunction("shell.user",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
 #ifdef _WIN32
       char buf[256];
       DWORD size = sizeof(buf);
@@ -583,7 +584,7 @@ return api.makeString(getPlatform());
   // shell.shell – path to the default system shell
   // ----------------------------------------------------------------------
   api.registerFunction("shell.shell",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
       std::string shell;
 #ifdef _WIN32
       const char *comspec = std::getenv("ComSpec");
@@ -603,7 +604,7 @@ return api.makeString(getPlatform());
   // shell.sleep – suspend execution for given seconds (fractional)
   // ----------------------------------------------------------------------
   api.registerFunction("shell.sleep",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
   if (args.empty())
   throw std::runtime_error("shell.sleep() requires a number (seconds)");
   double secs = args[0].asNumber();
@@ -623,7 +624,7 @@ return api.makeString(getPlatform());
   // shell.read – read line from stdin
   // ----------------------------------------------------------------------
   api.registerFunction("shell.read",
-    [api](const std::vector<Value> &) {
+    [api](HostArgs) {
       std::string line;
 if (!std::getline(std::cin, line))
       return Value::makeNull();
@@ -635,7 +636,7 @@ if (!std::getline(std::cin, line))
   //   shell.ready() or shell.ready(timeoutMs) -> bool (input available)
   // ----------------------------------------------------------------------
   api.registerFunction("shell.ready",
-    [](const std::vector<Value> &args) {
+    [](HostArgs args) {
       int timeoutMs = 0;
       if (!args.empty() && args[0].isInt()) {
         timeoutMs = static_cast<int>(args[0].asInt());
@@ -654,7 +655,7 @@ if (!std::getline(std::cin, line))
   //   shell.write(text) or shell.write(text, fd) where fd: 1=stdout, 2=stderr
   // ----------------------------------------------------------------------
   api.registerFunction("shell.write",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         throw std::runtime_error("shell.write() requires a string");
       std::string text = api.resolveString(args[0]);
@@ -672,7 +673,7 @@ if (!std::getline(std::cin, line))
   // shell.isatty – check if a file descriptor is a terminal (0=stdin, 1=stdout, 2=stderr)
   // ----------------------------------------------------------------------
   api.registerFunction("shell.isatty",
-      [](const std::vector<Value> &args) {
+      [](HostArgs args) {
       if (args.empty())
         return Value::makeBool(false);
       int fd = static_cast<int>(args[0].asInt());
@@ -688,7 +689,7 @@ if (!std::getline(std::cin, line))
   // shell.history_path – get path to history file (~/.havel_history)
   // ----------------------------------------------------------------------
   api.registerFunction("shell.history_path",
-      [api](const std::vector<Value>&) {
+      [api](HostArgs) {
         std::string home;
   #ifdef _WIN32
         const char *drive = std::getenv("HOMEDRIVE");
@@ -714,7 +715,7 @@ if (!std::getline(std::cin, line))
   // shell.history_read – read history file, return array of lines
   // ----------------------------------------------------------------------
   api.registerFunction("shell.history_read",
-      [api](const std::vector<Value> &args) {
+      [api](HostArgs args) {
         std::string path;
         if (!args.empty()) path = api.resolveString(args[0]);
         else {
@@ -753,7 +754,7 @@ if (!std::getline(std::cin, line))
   // shell.history_write – write array of strings to history file
   // ----------------------------------------------------------------------
   api.registerFunction("shell.history_write",
-      [api](const std::vector<Value> &args) {
+      [api](HostArgs args) {
         if (args.empty() || !args[0].isArrayId()) {
           throw std::runtime_error("shell.history_write: requires array argument");
         }
@@ -798,7 +799,7 @@ if (!std::getline(std::cin, line))
   // shell.history_add – append a line to history file
   // ----------------------------------------------------------------------
   api.registerFunction("shell.history_add",
-      [api](const std::vector<Value> &args) {
+      [api](HostArgs args) {
         if (args.empty()) return Value::makeNull();
         std::string line = api.resolveString(args[0]);
         std::string path;
@@ -833,7 +834,7 @@ if (!std::getline(std::cin, line))
   // shell.exit – terminate the program with a status code
   // ----------------------------------------------------------------------
   api.registerFunction("shell.exit",
-      [](const std::vector<Value> &args) {
+      [](HostArgs args) {
       int code = 0;
       if (!args.empty()) code = static_cast<int>(args[0].asInt());
       havel::exit(ExitReason::VmExit, code);
@@ -844,7 +845,7 @@ if (!std::getline(std::cin, line))
   // shell.splitArgs – split a command string into a list of arguments
   // ----------------------------------------------------------------------
   api.registerFunction("shell.splitArgs",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         return api.makeArray();  // empty array
       std::string cmd = api.resolveString(args[0]);
@@ -861,7 +862,7 @@ if (!std::getline(std::cin, line))
 
 // shell.exists(path)
 api.registerFunction("shell.exists",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty()) return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
     if (!isPathAllowed(p)) return Value::makeBool(false);
@@ -870,7 +871,7 @@ api.registerFunction("shell.exists",
 
 // shell.isFile(path)
 api.registerFunction("shell.isFile",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty()) return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
     if (!isPathAllowed(p)) return Value::makeBool(false);
@@ -879,7 +880,7 @@ api.registerFunction("shell.isFile",
 
 // shell.isDir(path)
 api.registerFunction("shell.isDir",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty()) return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
     if (!isPathAllowed(p)) return Value::makeBool(false);
@@ -888,7 +889,7 @@ api.registerFunction("shell.isDir",
 
 // shell.mkdir(path) – create single directory (non‑recursive)
 api.registerFunction("shell.mkdir",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty())
       return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
@@ -900,7 +901,7 @@ api.registerFunction("shell.mkdir",
 
 // shell.mkdirs(path) – create directory and all missing parents
 api.registerFunction("shell.mkdirs",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty())
       return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
@@ -912,7 +913,7 @@ api.registerFunction("shell.mkdirs",
 
 // shell.remove(path) – delete a file or empty directory
 api.registerFunction("shell.remove",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty())
       return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
@@ -924,7 +925,7 @@ api.registerFunction("shell.remove",
 
 // shell.removeAll(path) – delete a file or directory recursively
 api.registerFunction("shell.removeAll",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty())
       return Value::makeBool(false);
     std::string p = api.resolveString(args[0]);
@@ -936,7 +937,7 @@ api.registerFunction("shell.removeAll",
 
 // shell.copy(src, dst) – copy file; if dst is a directory, file is copied inside it
 api.registerFunction("shell.copy",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("shell.copy() requires source and destination");
     std::string src = api.resolveString(args[0]);
@@ -949,7 +950,7 @@ api.registerFunction("shell.copy",
 
 // shell.move(src, dst) – move/rename a file or directory
 api.registerFunction("shell.move",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("shell.move() requires source and destination");
     std::string src = api.resolveString(args[0]);
@@ -962,7 +963,7 @@ api.registerFunction("shell.move",
 
 // shell.listDir(path) – returns array of filenames inside directory
 api.registerFunction("shell.listDir",
-  [api](const std::vector<Value> &args) {
+  [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("shell.listDir() requires a directory path");
     std::string p = api.resolveString(args[0]);
@@ -980,7 +981,7 @@ api.registerFunction("shell.listDir",
 
   // shell.tmpfile() – create a temporary file and return its path
   api.registerFunction("shell.tmpfile",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
 #ifdef _WIN32
       char tmpPath[MAX_PATH];
       if (GetTempPathA(MAX_PATH, tmpPath) == 0) return Value::makeNull();
@@ -1009,13 +1010,13 @@ api.registerFunction("shell.listDir",
 
   // shell.envList() – returns an object containing all environment variables
   api.registerFunction("shell.envList",
-    [api](const std::vector<Value>&) {
+    [api](HostArgs) {
       return listEnvironment(api);
     });
 
   // shell.open(path) – open a file/URL with the default system handler
   api.registerFunction("shell.open",
-    [api](const std::vector<Value> &args) {
+    [api](HostArgs args) {
       if (args.empty())
         throw std::runtime_error("shell.open() requires a path or URL");
       std::string path = api.resolveString(args[0]);
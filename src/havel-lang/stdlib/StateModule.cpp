@@ -8,6 +8,7 @@
 
 using json = nlohmann::json;
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace {
@@ -109,7 +110,7 @@ void registerStateModule(const VMApi &api) {
     auto store = std::make_shared<StateStore>();
     store->path = getStatePath();
 
-    api.registerFunction("state.save", [api, store](const std::vector<Value> &args) {
+    api.registerFunction("state.save", [api, store](HostArgs args) {
         if (args.size() < 2)
             throw std::runtime_error("state.save(key, value) requires 2 arguments");
         std::string key = api.resolveString(args[0]);
@@ -122,7 +123,7 @@ void registerStateModule(const VMApi &api) {
         return Value::makeNull();
     });
 
-    api.registerFunction("state.load", [api, store](const std::vector<Value> &args) {
+    api.registerFunction("state.load", [api, store](HostArgs args) {
         if (args.size() < 1)
             throw std::runtime_error("state.load(key) requires at least 1 argument");
         std::string key = api.resolveString(args[0]);
@@ -138,7 +139,7 @@ void registerStateModule(const VMApi &api) {
         return jsonToValue(api, *it);
     });
 
-    api.registerFunction("state.has", [api, store](const std::vector<Value> &args) {
+    api.registerFunction("state.has", [api, store](HostArgs args) {
         if (args.size() < 1)
             throw std::runtime_error("state.has(key) requires 1 argument");
         std::string key = api.resolveString(args[0]);
@@ -149,7 +150,7 @@ void registerStateModule(const VMApi &api) {
         return Value::makeBool(store->cached.find(key) != store->cached.end());
     });
 
-    api.registerFunction("state.remove", [api, store](const std::vector<Value> &args) {
+    api.registerFunction("state.remove", [api, store](HostArgs args) {
         if (args.size() < 1)
             throw std::runtime_error("state.remove(key) requires 1 argument");
         std::string key = api.resolveString(args[0]);
@@ -165,7 +166,7 @@ void registerStateModule(const VMApi &api) {
         return Value::makeBool(existed);
     });
 
-    api.registerFunction("state.keys", [api, store](const std::vector<Value> &) {
+    api.registerFunction("state.keys", [api, store](HostArgs) {
         if (!store->loaded) {
             store->cached = loadFile(store->path);
             store->loaded = true;
@@ -176,7 +177,7 @@ void registerStateModule(const VMApi &api) {
         return arr;
     });
 
-    api.registerFunction("state.clear", [store](const std::vector<Value> &) {
+    api.registerFunction("state.clear", [store](HostArgs) {
         store->cached = json::object();
         store->loaded = true;
         saveFile(store->path, store->cached);
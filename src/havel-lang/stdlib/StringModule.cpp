@@ -4,12 +4,13 @@
 #include <regex>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
 
 void registerStringModule(const VMApi &api) {
-    api.registerFunction("string._fromCodePoint", [api](const std::vector<Value> &args) {
+    api.registerFunction("string._fromCodePoint", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("string._fromCodePoint() requires 1 argument");
         int64_t cp = args[0].isInt() ? args[0].asInt() : 0;
@@ -33,7 +34,7 @@ void registerStringModule(const VMApi &api) {
         return api.makeString(result);
     });
 
-    api.registerFunction("string.chr", [api](const std::vector<Value> &args) {
+    api.registerFunction("string.chr", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("string.chr() requires 1 argument");
         int64_t cp = args[0].isInt() ? args[0].asInt() : 0;
@@ -57,7 +58,7 @@ void registerStringModule(const VMApi &api) {
         return api.makeString(result);
     });
 
-    api.registerFunction("string._codePointLen", [api](const std::vector<Value> &args) {
+    api.registerFunction("string._codePointLen", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("string._codePointLen() requires 1 argument");
         const std::string* strPtr = api.getStringPtr(args[0]);
@@ -77,7 +78,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(count);
     });
 
-    api.registerFunction("string._toCodePointArray", [api](const std::vector<Value> &args) {
+    api.registerFunction("string._toCodePointArray", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("string._toCodePointArray() requires 1 argument");
         std::string s = api.toString(args[0]);
@@ -129,7 +130,7 @@ void registerStringModule(const VMApi &api) {
         return arr;
     });
 
-    api.registerFunction("string._cursor", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor", [api](HostArgs args) -> Value {
         if (args.empty())
             throw std::runtime_error("string._cursor() requires 1 argument");
         const std::string* strPtr = api.getStringPtr(args[0]);
@@ -198,7 +199,7 @@ void registerStringModule(const VMApi &api) {
     });
 
     // Simplified cursor functions - just update idx field
-    api.registerFunction("string._cursor_cp", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_cp", [api](HostArgs args) -> Value {
         if (args.size() < 2)
             throw std::runtime_error("string._cursor_cp() requires cursor and offset");
         auto cursorObj = args[0];
@@ -215,7 +216,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(-1);
     });
 
-    api.registerFunction("string._cursor_current", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_current", [api](HostArgs args) -> Value {
         if (args.empty())
             throw std::runtime_error("string._cursor_current() requires cursor");
         auto cursorObj = args[0];
@@ -230,7 +231,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(-1);
     });
 
-    api.registerFunction("string._cursor_advance", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_advance", [api](HostArgs args) -> Value {
         if (args.empty())
             throw std::runtime_error("string._cursor_advance() requires cursor");
         auto cursorObj = args[0];
@@ -247,7 +248,7 @@ void registerStringModule(const VMApi &api) {
         return cp;
     });
 
-    api.registerFunction("string._cursor_bytePos", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_bytePos", [api](HostArgs args) -> Value {
         if (args.empty())
             throw std::runtime_error("string._cursor_bytePos() requires cursor");
         auto cursorObj = args[0];
@@ -263,7 +264,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(static_cast<int64_t>(api.toString(strVal).size()));
     });
 
-    api.registerFunction("string._cursor_byteLen", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_byteLen", [api](HostArgs args) -> Value {
         if (args.size() < 2)
             throw std::runtime_error("string._cursor_byteLen() requires cursor and index");
         auto cursorObj = args[0];
@@ -277,7 +278,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(1);
     });
 
-    api.registerFunction("string._cursor_len", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_len", [api](HostArgs args) -> Value {
         if (args.empty())
             throw std::runtime_error("string._cursor_len() requires cursor");
         auto cursorObj = args[0];
@@ -288,7 +289,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(static_cast<int64_t>(api.length(cpArr)));
     });
 
-    api.registerFunction("string._cursor_setIdx", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_setIdx", [api](HostArgs args) -> Value {
         if (args.size() < 2)
             throw std::runtime_error("string._cursor_setIdx() requires cursor and index");
         auto cursorObj = args[0];
@@ -302,7 +303,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(idx);
     });
 
-    api.registerFunction("string._cursor_idxAtByte", [api](const std::vector<Value> &args) -> Value {
+    api.registerFunction("string._cursor_idxAtByte", [api](HostArgs args) -> Value {
         if (args.size() < 2)
             throw std::runtime_error("string._cursor_idxAtByte() requires cursor and bytePos");
         auto cursorObj = args[0];
@@ -325,7 +326,7 @@ void registerStringModule(const VMApi &api) {
         return Value::makeInt(static_cast<int64_t>(lo));
     });
 
-    api.registerFunction("string._regexReplace", [api](const std::vector<Value>& args) {
+    api.registerFunction("string._regexReplace", [api](HostArgs args) {
         if (args.size() < 3)
             throw std::runtime_error("string._regexReplace() requires string, pattern, and replacement");
         std::string s = api.toString(args[0]);
@@ -340,7 +341,7 @@ void registerStringModule(const VMApi &api) {
         }
     });
 
-    api.registerFunction("replace", [api](const std::vector<Value>& args) {
+    api.registerFunction("replace", [api](HostArgs args) {
         if (args.size() < 3)
             throw std::runtime_error("replace() requires string, pattern, and replacement");
         std::string s = api.toString(args[0]);
@@ -363,7 +364,7 @@ void registerStringModule(const VMApi &api) {
         return api.makeString(std::move(s));
     });
 
-    api.registerFunction("string.join", [api](const std::vector<Value> &args) {
+    api.registerFunction("string.join", [api](HostArgs args) {
         if (args.empty())
             throw std::runtime_error("string.join() requires at least 1 argument");
         if (!args[0].isArrayId())
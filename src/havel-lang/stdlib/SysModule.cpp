@@ -39,6 +39,7 @@
 #include "utils/SafeExec.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace fs = std::filesystem;
@@ -96,7 +97,7 @@ static std::unordered_map<int64_t, std::pair<int, int>> g_spawnPipes;
 
 void registerSysModule(const VMApi &api) {
   api.registerFunction("sys.platform",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
 #if defined(__linux__)
                          return api.makeString("linux");
@@ -110,7 +111,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.arch",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
 #if defined(__x86_64__) || defined(_M_X64)
                          return api.makeString("x86_64");
@@ -126,13 +127,13 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.version",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
                          return api.makeString("0.1.0");
                        });
 
   api.registerFunction("sys.argv",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
   auto arr = api.makeArray();
   for (const auto& a : api.vm().getProgramArgs())
@@ -141,7 +142,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.env",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          if (args.empty())
                            return Value::makeNull();
                          std::string name = api.resolveString(args[0]);
@@ -152,7 +153,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.envAll",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
   auto obj = api.makeObject();
 #ifndef _WIN32
@@ -173,14 +174,14 @@ void registerSysModule(const VMApi &api) {
 });
 
   api.registerFunction("sys.cwd",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
   return api.makeString(
       std::filesystem::current_path().string());
 });
 
   api.registerFunction("sys.pid",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
 #ifndef _WIN32
                          return Value(static_cast<int64_t>(getpid()));
@@ -190,7 +191,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.ppid",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
 #ifndef _WIN32
                          return Value(static_cast<int64_t>(getppid()));
@@ -217,7 +218,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("__proc.pid",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
 #ifndef _WIN32
                          return Value(static_cast<int64_t>(getpid()));
@@ -227,7 +228,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("__proc.ppid",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
 #ifndef _WIN32
                          return Value(static_cast<int64_t>(getppid()));
@@ -258,7 +259,7 @@ void registerSysModule(const VMApi &api) {
         g_exitCleanups = new std::vector<std::function<void()>>();
     }
     api.registerFunction("sys.registerExitCleanup",
-        [&api](const std::vector<Value> &args) -> Value {
+        [&api](HostArgs args) -> Value {
         if (args.empty() || !args[0].isFunctionObjId()) {
             return Value::makeNull();
         }
@@ -276,7 +277,7 @@ void registerSysModule(const VMApi &api) {
     });
 
   api.registerFunction("sys.hostname",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
 #ifndef _WIN32
                          char buf[256];
@@ -294,7 +295,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.username",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
                          const char *user = std::getenv("USER");
                          if (!user)
@@ -313,7 +314,7 @@ void registerSysModule(const VMApi &api) {
 });
 
   api.registerFunction("sys.home",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
                          const char *home = std::getenv("HOME");
                          if (!home)
@@ -322,7 +323,7 @@ void registerSysModule(const VMApi &api) {
 });
 
   api.registerFunction("sys.tmpdir",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
 #ifdef _WIN32
                          const char *tmp = std::getenv("TEMP");
@@ -335,7 +336,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.shell",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
 #ifdef _WIN32
                          const char *sh = std::getenv("ComSpec");
@@ -348,7 +349,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("sys.uptime",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
                          double uptime_secs = 0.0;
 #if defined(__linux__)
@@ -362,7 +363,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("jit.last_error",
-                       [api](const std::vector<Value> &args) {
+                       [api](HostArgs args) {
                          (void)args;
 #ifdef HAVEL_ENABLE_LLVM
                          return api.makeString(havel::compiler::BytecodeOrcJIT::lastError());
@@ -372,7 +373,7 @@ void registerSysModule(const VMApi &api) {
                        });
 
   api.registerFunction("jit.clear_error",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
 #ifdef HAVEL_ENABLE_LLVM
                          havel::compiler::BytecodeOrcJIT::clearLastError();
@@ -407,7 +408,7 @@ void registerSysModule(const VMApi &api) {
   // ========================================================================
   // system.detect — detect OS, display protocol, window manager, etc.
   // ========================================================================
-  api.registerFunction("system.detect", [api](const std::vector<Value>&) {
+  api.registerFunction("system.detect", [api](HostArgs) {
     auto obj = api.makeObject();
 
     std::string os = "Unknown";
@@ -531,7 +532,7 @@ void registerSysModule(const VMApi &api) {
   // ========================================================================
   // system.hardware — detect CPU, GPU, RAM, storage, etc.
   // ========================================================================
-  api.registerFunction("system.hardware", [api](const std::vector<Value>&) {
+  api.registerFunction("system.hardware", [api](HostArgs) {
     auto obj = api.makeObject();
 
     std::string cpu;
@@ -699,7 +700,7 @@ void registerSysModule(const VMApi &api) {
   // ========================================================================
   // process.find — find PIDs by name
   // ========================================================================
-api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
+api.registerFunction("__proc.find", [api](HostArgs args) {
     if (args.empty())
         throw std::runtime_error("__proc.find() requires a process name");
     std::string name = api.resolveString(args[0]);
@@ -718,7 +719,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.exists — check if process is running (by name or PID)
   // ========================================================================
-  api.registerFunction("__proc.exists", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.exists", [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("__proc.exists() requires a process name or PID");
 #ifndef _WIN32
@@ -736,7 +737,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.kill — send signal to PID
   // ========================================================================
-  api.registerFunction("__proc.kill", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.kill", [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("__proc.kill() requires PID and signal");
     if (!args[0].isInt())
@@ -759,7 +760,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
 
   // process.getState — get process state (RUNNING, STOPPED, etc.)
   // ========================================================================
-  api.registerFunction("__proc.getState", [api](const std::vector<Value>& args) -> Value {
+  api.registerFunction("__proc.getState", [api](HostArgs args) -> Value {
     if (args.size() < 1)
       throw std::runtime_error("__proc.getState() requires PID");
     if (!args[0].isInt())
@@ -808,7 +809,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.nice — set nice value for PID
   // ========================================================================
-  api.registerFunction("__proc.nice", [](const std::vector<Value>& args) -> Value {
+  api.registerFunction("__proc.nice", [](HostArgs args) -> Value {
     if (args.size() < 2)
       throw std::runtime_error("__proc.nice() requires PID and nice value");
     if (!args[0].isInt())
@@ -831,7 +832,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.run — run command synchronously, return {pid, exitCode, success, stdout, stderr, error}
   // ========================================================================
-  api.registerFunction("__proc.run", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.run", [api](HostArgs args) {
     if (api.vm().getScheduler())
       api.vm().getScheduler()->yieldCurrentAndCheckTimers();
     if (args.empty())
@@ -853,7 +854,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.runDetached — run command without waiting, return pid
   // ========================================================================
-  api.registerFunction("__proc.runDetached", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.runDetached", [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("__proc.runDetached() requires a command");
     std::string cmd = api.resolveString(args[0]);
@@ -865,7 +866,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.wait — wait for spawned process to finish, update fields on object
   // ========================================================================
-  api.registerFunction("__proc.wait", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.wait", [api](HostArgs args) {
     if (api.vm().getScheduler())
       api.vm().getScheduler()->yieldCurrentAndCheckTimers();
     if (args.empty())
@@ -916,7 +917,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.killObj — kill spawned process (use process.kill(pid, sig) for PID)
   // ========================================================================
-  api.registerFunction("__proc.killObj", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.killObj", [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("__proc.killObj() requires process object");
 
@@ -940,7 +941,7 @@ api.registerFunction("__proc.find", [api](const std::vector<Value>& args) {
   // ========================================================================
   // process.spawn — run command, return process object with .pid (data fields only)
   // ========================================================================
-  api.registerFunction("__proc.spawn", [api](const std::vector<Value>& args) {
+  api.registerFunction("__proc.spawn", [api](HostArgs args) {
     if (api.vm().getScheduler())
       api.vm().getScheduler()->yieldCurrentAndCheckTimers();
     if (args.empty())
@@ -14,6 +14,7 @@
 #include "havel-lang/runtime/concurrency/Scheduler.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -26,7 +27,7 @@ static std::tm getLocalTm() {
 }
 
 // Helper: get timestamp in milliseconds from args
-static int64_t getTimestampMs(const std::vector<Value> &args) {
+static int64_t getTimestampMs(HostArgs args) {
   if (args.empty())
     throw std::runtime_error("time: requires timestamp argument");
   if (args[0].isInt())
@@ -39,7 +40,7 @@ static int64_t getTimestampMs(const std::vector<Value> &args) {
 void registerTimeModule(const VMApi &api) {
   // time.now() — current epoch in milliseconds
   api.registerFunction("time.now",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
                          auto now = std::chrono::system_clock::now();
                          auto ms = std::chrono::duration_cast<
@@ -51,7 +52,7 @@ void registerTimeModule(const VMApi &api) {
 
   // time.epoch() — Unix epoch in seconds
   api.registerFunction("time.epoch",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
                          auto now = std::chrono::system_clock::now();
                          auto secs = std::chrono::duration_cast<
@@ -63,7 +64,7 @@ void registerTimeModule(const VMApi &api) {
 
   // time.millis() — same as time.now (milliseconds since epoch)
   api.registerFunction("time.millis",
-                       [](const std::vector<Value> &args) {
+                       [](HostArgs args) {
                          (void)args;
                          auto now = std::chrono::system_clock::now();
                          auto ms = std::chrono::duration_cast<
@@ -75,7 +76,7 @@ void registerTimeModule(const VMApi &api) {
 
   // time.format(timestamp, format?) — format timestamp as string
   api.registerFunction(
-      "time.format", [api](const std::vector<Value> &args) {
+      "time.format", [api](HostArgs args) {
         int64_t timestamp = getTimestampMs(args);
         std::time_t time = timestamp / 1000;
         std::string fmt = "%Y-%m-%d %H:%M:%S";
@@ -91,7 +92,7 @@ void registerTimeModule(const VMApi &api) {
   // time.parse(datestr, format?) — parse date string to millisecond
   // timestamp
   api.registerFunction(
-      "time.parse", [api](const std::vector<Value> &args) {
+      "time.parse", [api](HostArgs args) {
         if (args.empty())
           throw std::runtime_error("time.parse() requires date string");
         std::string datestr = api.resolveString(args[0]);
@@ -116,7 +117,7 @@ void registerTimeModule(const VMApi &api) {
 
 // time.sleep(ms) — non-blocking if in a goroutine
   api.registerFunction(
-      "time.sleep", [api](const std::vector<Value> &args) {
+      "time.sleep", [api](HostArgs args) {
         if (args.empty())
           throw std::runtime_error("time.sleep() requires milliseconds");
         int64_t ms = 0;
@@ -139,56 +140,56 @@ if (api.isInGoroutine()) {
       });
 
   // time.year() — current year
-  api.registerFunction("time.year", [](const std::vector<Value> &args) {
+  api.registerFunction("time.year", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_year + 1900));
   });
 
   // time.month() — current month (1-12)
-  api.registerFunction("time.month", [](const std::vector<Value> &args) {
+  api.registerFunction("time.month", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_mon + 1));
   });
 
   // time.day() — current day of month (1-31)
-  api.registerFunction("time.day", [](const std::vector<Value> &args) {
+  api.registerFunction("time.day", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_mday));
   });
 
   // time.hour() — current hour (0-23)
-  api.registerFunction("time.hour", [](const std::vector<Value> &args) {
+  api.registerFunction("time.hour", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_hour));
   });
 
   // time.minute() — current minute (0-59)
-  api.registerFunction("time.minute", [](const std::vector<Value> &args) {
+  api.registerFunction("time.minute", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_min));
   });
 
   // time.second() — current second (0-59)
-  api.registerFunction("time.second", [](const std::vector<Value> &args) {
+  api.registerFunction("time.second", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_sec));
   });
 
   // time.weekday() — day of week (0=Sunday, 6=Saturday)
-  api.registerFunction("time.weekday", [](const std::vector<Value> &args) {
+  api.registerFunction("time.weekday", [](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     return Value(static_cast<int64_t>(tm.tm_wday));
   });
 
   // time.date() — current date as "YYYY-MM-DD" string
-  api.registerFunction("time.date", [api](const std::vector<Value> &args) {
+  api.registerFunction("time.date", [api](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     char buf[32];
@@ -197,7 +198,7 @@ if (api.isInGoroutine()) {
   });
 
   // time.time() — current time as "HH:MM:SS" string
-  api.registerFunction("time.time", [api](const std::vector<Value> &args) {
+  api.registerFunction("time.time", [api](HostArgs args) {
     (void)args;
     auto tm = getLocalTm();
     char buf[32];
@@ -9,58 +9,59 @@
 #include "havel-lang/core/Value.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
 
 void registerTimerModule(const VMApi &api) {
   // timer.setTimeout(ms, fn) — one-shot timer, delegates to timeout.start
-  api.registerFunction("timer.setTimeout", [api](const std::vector<Value> &args) {
+  api.registerFunction("timer.setTimeout", [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("timer.setTimeout requires ms and callback");
     auto fnIdx = api.vm().getHostFunctionIndex("timeout.start");
-    return api.vm().invokeHostFunctionDirect("timeout.start", args);
+    return api.vm().invokeHostFunctionDirect("timeout.start", std::vector<Value>(args.begin(), args.end()));
   });
 
   // timer.setInterval(ms, fn) — repeating timer, delegates to interval.start
-  api.registerFunction("timer.setInterval", [api](const std::vector<Value> &args) {
+  api.registerFunction("timer.setInterval", [api](HostArgs args) {
     if (args.size() < 2)
       throw std::runtime_error("timer.setInterval requires ms and callback");
-    return api.vm().invokeHostFunctionDirect("interval.start", args);
+    return api.vm().invokeHostFunctionDirect("interval.start", std::vector<Value>(args.begin(), args.end()));
   });
 
   // timer.clear(id) — cancel a timer (interval or timeout)
-  api.registerFunction("timer.clear", [api](const std::vector<Value> &args) {
+  api.registerFunction("timer.clear", [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("timer.clear requires a timer id");
     if (args[0].isIntervalId()) {
-      return api.vm().invokeHostFunctionDirect("interval.stop", args);
+      return api.vm().invokeHostFunctionDirect("interval.stop", std::vector<Value>(args.begin(), args.end()));
     }
     if (args[0].isTimeoutId()) {
-      return api.vm().invokeHostFunctionDirect("timeout.cancel", args);
+      return api.vm().invokeHostFunctionDirect("timeout.cancel", std::vector<Value>(args.begin(), args.end()));
     }
     throw std::runtime_error("timer.clear: invalid timer id");
   });
 
   // timer.activeCount() — number of active timers (tracked by TimerService)
-  api.registerFunction("timer.activeCount", [](const std::vector<Value> &args) {
+  api.registerFunction("timer.activeCount", [](HostArgs args) {
     (void)args;
     return Value::makeInt(0);
   });
 
   // timer.sleep(ms) — sleep for milliseconds (delegates to VM yield with sleep reason)
-  api.registerFunction("timer.sleep", [api](const std::vector<Value> &args) {
+  api.registerFunction("timer.sleep", [api](HostArgs args) {
     if (args.empty())
       throw std::runtime_error("timer.sleep requires milliseconds");
     if (!args[0].isInt())
       throw std::runtime_error("timer.sleep requires integer milliseconds");
     int64_t ms = args[0].asInt();
     if (ms < 0) throw std::runtime_error("timer.sleep: ms must be non-negative");
-    return api.vm().invokeHostFunctionDirect("sleep_ms", args);
+    return api.vm().invokeHostFunctionDirect("sleep_ms", {args[0]});
   });
 
   // timer.now() — current time in milliseconds
-  api.registerFunction("timer.now", [](const std::vector<Value> &args) {
+  api.registerFunction("timer.now", [](HostArgs args) {
     (void)args;
     auto now = std::chrono::steady_clock::now();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
@@ -5,40 +5,41 @@
 #include <stdexcept>
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
 
 void registerTypeModule(const VMApi &api) {
-    api.registerFunction("type._isNumber", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isNumber", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isNumber() requires an argument");
         return Value(args[0].isInt() || args[0].isDouble());
     });
-    api.registerFunction("type._isString", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isString", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isString() requires an argument");
         return Value(args[0].isStringValId());
     });
-    api.registerFunction("type._isArray", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isArray", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isArray() requires an argument");
         return Value(args[0].isArrayId());
     });
-    api.registerFunction("type._isObject", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isObject", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isObject() requires an argument");
         return Value(args[0].isObjectId());
     });
-    api.registerFunction("type._isNull", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isNull", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isNull() requires an argument");
         return Value(args[0].isNull());
     });
-    api.registerFunction("type._isBoolean", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isBoolean", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isBoolean() requires an argument");
         return Value::makeBool(args[0].isBool());
     });
-    api.registerFunction("type._isEnum", [](const std::vector<Value> &args) {
+    api.registerFunction("type._isEnum", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("type._isEnum() requires an argument");
         return Value(args[0].isEnumId());
     });
-    api.registerFunction("type._newEnum", [api](const std::vector<Value> &args) {
+    api.registerFunction("type._newEnum", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("type._newEnum() requires at least type name and variant name");
         std::string typeName = api.toString(args[0]);
         std::string variantName = api.toString(args[1]);
@@ -47,12 +48,12 @@ void registerTypeModule(const VMApi &api) {
         for (size_t i = 2; i < args.size(); ++i) payload.push_back(args[i]);
         return api.makeEnum(typeId, 0, payload);
     });
-    api.registerFunction("type._getVariant", [api](const std::vector<Value> &args) {
+    api.registerFunction("type._getVariant", [api](HostArgs args) {
         if (args.empty() || !args[0].isEnumId()) throw std::runtime_error("type._getVariant() requires an enum argument");
         Value val = args[0];
         return api.makeString(api.getEnumVariantName(val.asEnumTypeId(), api.getEnumTag(val)));
     });
-    api.registerFunction("type._getVariantPayload", [api](const std::vector<Value> &args) {
+    api.registerFunction("type._getVariantPayload", [api](HostArgs args) {
         if (args.empty() || !args[0].isEnumId()) throw std::runtime_error("type._getVariantPayload() requires an enum argument");
         Value val = args[0];
         uint32_t count = api.getEnumPayloadCount(val);
@@ -93,35 +94,35 @@ void registerTypeModule(const VMApi &api) {
         }
     }
 
-    api.registerFunction("isNumber", [](const std::vector<Value> &args) {
+    api.registerFunction("isNumber", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isNumber() requires an argument");
         return Value(args[0].isInt() || args[0].isDouble());
     });
-    api.registerFunction("isString", [](const std::vector<Value> &args) {
+    api.registerFunction("isString", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isString() requires an argument");
         return Value(args[0].isStringValId());
     });
-    api.registerFunction("isArray", [](const std::vector<Value> &args) {
+    api.registerFunction("isArray", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isArray() requires an argument");
         return Value(args[0].isArrayId());
     });
-    api.registerFunction("isObject", [](const std::vector<Value> &args) {
+    api.registerFunction("isObject", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isObject() requires an argument");
         return Value(args[0].isObjectId());
     });
-    api.registerFunction("isNull", [](const std::vector<Value> &args) {
+    api.registerFunction("isNull", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isNull() requires an argument");
         return Value(args[0].isNull());
     });
-    api.registerFunction("isBoolean", [](const std::vector<Value> &args) {
+    api.registerFunction("isBoolean", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isBoolean() requires an argument");
         return Value::makeBool(args[0].isBool());
     });
-    api.registerFunction("isEnum", [](const std::vector<Value> &args) {
+    api.registerFunction("isEnum", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("isEnum() requires an argument");
         return Value(args[0].isEnumId());
     });
-    api.registerFunction("toString", [](const std::vector<Value> &args) {
+    api.registerFunction("toString", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("toString() requires an argument");
         const auto &arg = args[0];
         if (arg.isNull()) return Value::makeNull();
@@ -131,7 +132,7 @@ void registerTypeModule(const VMApi &api) {
         if (arg.isStringValId()) return arg;
         return Value::makeNull();
     });
-    api.registerFunction("toNumber", [](const std::vector<Value> &args) {
+    api.registerFunction("toNumber", [](HostArgs args) {
         if (args.empty()) throw std::runtime_error("toNumber() requires an argument");
         const auto &arg = args[0];
         if (arg.isNull()) return Value::makeInt(0);
@@ -140,7 +141,7 @@ void registerTypeModule(const VMApi &api) {
         if (arg.isDouble()) return arg;
         return Value::makeInt(0);
     });
-    api.registerFunction("newEnum", [api](const std::vector<Value> &args) {
+    api.registerFunction("newEnum", [api](HostArgs args) {
         if (args.size() < 2) throw std::runtime_error("newEnum() requires at least type name and variant name");
         std::string typeName = api.toString(args[0]);
         std::string variantName = api.toString(args[1]);
@@ -149,12 +150,12 @@ void registerTypeModule(const VMApi &api) {
         for (size_t i = 2; i < args.size(); ++i) payload.push_back(args[i]);
         return api.makeEnum(typeId, 0, payload);
     });
-    api.registerFunction("getVariant", [api](const std::vector<Value> &args) {
+    api.registerFunction("getVariant", [api](HostArgs args) {
         if (args.empty() || !args[0].isEnumId()) throw std::runtime_error("getVariant() requires an enum argument");
         Value val = args[0];
         return api.makeString(api.getEnumVariantName(val.asEnumTypeId(), api.getEnumTag(val)));
     });
-    api.registerFunction("getVariantPayload", [api](const std::vector<Value> &args) {
+    api.registerFunction("getVariantPayload", [api](HostArgs args) {
         if (args.empty() || !args[0].isEnumId()) throw std::runtime_error("getVariantPayload() requires an enum argument");
         Value val = args[0];
         uint32_t count = api.getEnumPayloadCount(val);
@@ -183,7 +184,7 @@ void registerTypeModule(const VMApi &api) {
     api.setGlobal("newEnum", api.makeFunctionRef("newEnum"));
 
     if (vm.hostFunctionGlobals().find("type") != vm.hostFunctionGlobals().end()) {
-        vm.getGlobals()["type"] = vm.hostFunctionGlobals()["type"];
+        vm.getGlobals()["type"] = vm.hostFunctionGlobals().at("type");
     }
 }
 
@@ -7,6 +7,7 @@
 #include "utils/Logger.hpp"
 
 using havel::compiler::Value;
+using havel::compiler::HostArgs;
 using havel::compiler::VMApi;
 
 namespace havel::stdlib {
@@ -33,26 +34,26 @@ void registerWaylandModule(const VMApi &apiRef) {
     const auto &api = apiRef;
     auto &client = havel::WaylandProtocolClient::instance();
 
-    api.registerFunction("wayland.connect", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.connect", [&client](HostArgs) {
         return Value::makeBool(client.connect());
     });
 
-    api.registerFunction("wayland.connected", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.connected", [&client](HostArgs) {
         return Value::makeBool(client.isConnected());
     });
 
-    api.registerFunction("wayland.compositor", [&api, &client](const std::vector<Value> &) {
+    api.registerFunction("wayland.compositor", [&api, &client](HostArgs) {
         return api.makeString(client.compositorName());
     });
 
-    api.registerFunction("wayland.disconnect", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.disconnect", [&client](HostArgs) {
         client.disconnect();
         return Value::makeNull();
     });
 
     auto infoObj = api.makeObject();
 
-    api.registerFunction("wayland.info.protocols", [&api, &client](const std::vector<Value> &) {
+    api.registerFunction("wayland.info.protocols", [&api, &client](HostArgs) {
         auto arr = api.makeArray();
         for (const auto &proto : client.protocols()) {
             auto obj = api.makeObject();
@@ -63,7 +64,7 @@ void registerWaylandModule(const VMApi &apiRef) {
         return arr;
     });
 
-    api.registerFunction("wayland.info.outputs", [&api, &client](const std::vector<Value> &) {
+    api.registerFunction("wayland.info.outputs", [&api, &client](HostArgs) {
         auto arr = api.makeArray();
         for (const auto &out : client.outputs()) {
             auto obj = api.makeObject();
@@ -78,19 +79,19 @@ void registerWaylandModule(const VMApi &apiRef) {
         return arr;
     });
 
-    api.registerFunction("wayland.info.has_keyboard", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.info.has_keyboard", [&client](HostArgs) {
         return Value::makeBool(client.hasVirtualKeyboard());
     });
 
-    api.registerFunction("wayland.info.has_pointer", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.info.has_pointer", [&client](HostArgs) {
         return Value::makeBool(client.hasVirtualPointer());
     });
 
-    api.registerFunction("wayland.info.has_toplevel", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.info.has_toplevel", [&client](HostArgs) {
         return Value::makeBool(client.hasForeignToplevel());
     });
 
-    api.registerFunction("wayland.info.has_data_control", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.info.has_data_control", [&client](HostArgs) {
         return Value::makeBool(client.hasDataControl());
     });
 
@@ -105,28 +106,28 @@ void registerWaylandModule(const VMApi &apiRef) {
     static std::unique_ptr<havel::VirtualKeyboard> vkb;
     static bool kbInit = false;
 
-    api.registerFunction("wayland.keyboard.init", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.keyboard.init", [&client](HostArgs) {
         if (kbInit && vkb) return Value::makeBool(true);
         vkb = std::make_unique<havel::VirtualKeyboard>(client);
         kbInit = vkb->initialize();
         return Value::makeBool(kbInit);
     });
 
-    api.registerFunction("wayland.keyboard.press", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.press", [](HostArgs args) {
         if (!kbInit || !vkb) return Value::makeBool(false);
         uint32_t kc = static_cast<uint32_t>(intArg(args.empty() ? Value::makeNull() : args[0]));
         vkb->pressKey(kc);
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.release", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.release", [](HostArgs args) {
         if (!kbInit || !vkb) return Value::makeBool(false);
         uint32_t kc = static_cast<uint32_t>(intArg(args.empty() ? Value::makeNull() : args[0]));
         vkb->releaseKey(kc);
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.tap", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.tap", [](HostArgs args) {
         if (!kbInit || !vkb) return Value::makeBool(false);
         uint32_t kc = static_cast<uint32_t>(intArg(args.empty() ? Value::makeNull() : args[0]));
         uint32_t delay = args.size() > 1 ? static_cast<uint32_t>(intArg(args[1], 50)) : 50;
@@ -134,31 +135,31 @@ void registerWaylandModule(const VMApi &apiRef) {
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.type", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.type", [&api](HostArgs args) {
         if (!kbInit || !vkb || args.empty()) return Value::makeBool(false);
         vkb->typeText(strArg(api, args[0]));
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.press_name", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.press_name", [&api](HostArgs args) {
         if (!kbInit || !vkb || args.empty()) return Value::makeBool(false);
         vkb->pressKeyByName(strArg(api, args[0]));
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.release_name", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.release_name", [&api](HostArgs args) {
         if (!kbInit || !vkb || args.empty()) return Value::makeBool(false);
         vkb->releaseKeyByName(strArg(api, args[0]));
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.tap_name", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.tap_name", [&api](HostArgs args) {
         if (!kbInit || !vkb || args.empty()) return Value::makeBool(false);
         vkb->tapKeyByName(strArg(api, args[0]));
         return Value::makeBool(true);
     });
 
-    api.registerFunction("wayland.keyboard.keycode", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.keyboard.keycode", [&api](HostArgs args) {
         if (!kbInit || !vkb || args.empty()) return Value::makeInt(0);
         return Value::makeInt(static_cast<int64_t>(vkb->keyNameToKeycode(strArg(api, args[0]))));
     });
@@ -178,19 +179,19 @@ void registerWaylandModule(const VMApi &apiRef) {
     static std::unique_ptr<havel::VirtualPointer> vptr;
     static bool ptrInit = false;
 
-    api.registerFunction("wayland.mouse.init", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.mouse.init", [&client](HostArgs) {
         if (ptrInit && vptr) return Value::makeBool(true);
         vptr = std::make_unique<havel::VirtualPointer>(client);
         ptrInit = vptr->initialize();
         return Value::makeBool(ptrInit);
     });
 
-    api.registerFunction("wayland.mouse.move", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.move", [](HostArgs args) {
         if (!ptrInit || !vptr || args.size() < 2) return Value::makeBool(false);
         return Value::makeBool(vptr->moveRelative(numArg(args[0]), numArg(args[1])));
     });
 
-    api.registerFunction("wayland.mouse.move_to", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.move_to", [](HostArgs args) {
         if (!ptrInit || !vptr || args.size() < 2) return Value::makeBool(false);
         auto &outputs = havel::WaylandProtocolClient::instance().outputs();
         if (outputs.empty()) return Value::makeBool(false);
@@ -202,39 +203,39 @@ void registerWaylandModule(const VMApi &apiRef) {
             static_cast<uint32_t>(out.height)));
     });
 
-    api.registerFunction("wayland.mouse.click", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.click", [](HostArgs args) {
         if (!ptrInit || !vptr || args.empty()) return Value::makeBool(false);
         uint32_t btn = static_cast<uint32_t>(intArg(args[0]));
         return Value::makeBool(vptr->tapButton(btn));
     });
 
-    api.registerFunction("wayland.mouse.button_down", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.button_down", [](HostArgs args) {
         if (!ptrInit || !vptr || args.empty()) return Value::makeBool(false);
         uint32_t btn = static_cast<uint32_t>(intArg(args[0]));
         return Value::makeBool(vptr->clickButton(btn, true));
     });
 
-    api.registerFunction("wayland.mouse.button_up", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.button_up", [](HostArgs args) {
         if (!ptrInit || !vptr || args.empty()) return Value::makeBool(false);
         uint32_t btn = static_cast<uint32_t>(intArg(args[0]));
         return Value::makeBool(vptr->clickButton(btn, false));
     });
 
-    api.registerFunction("wayland.mouse.scroll", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.scroll", [](HostArgs args) {
         if (!ptrInit || !vptr) return Value::makeBool(false);
         double dy = args.size() > 0 ? numArg(args[0]) : 0.0;
         double dx = args.size() > 1 ? numArg(args[1]) : 0.0;
         return Value::makeBool(vptr->scrollSmooth(dy, dx));
     });
 
-    api.registerFunction("wayland.mouse.scroll_discrete", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.scroll_discrete", [](HostArgs args) {
         if (!ptrInit || !vptr) return Value::makeBool(false);
         int32_t dy = static_cast<int32_t>(intArg(args.empty() ? Value::makeNull() : args[0]));
         int32_t dx = args.size() > 1 ? static_cast<int32_t>(intArg(args[1])) : 0;
         return Value::makeBool(vptr->scrollDiscrete(dy, dx));
     });
 
-    api.registerFunction("wayland.mouse.button_name_to_code", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.mouse.button_name_to_code", [&api](HostArgs args) {
         if (args.empty()) return Value::makeInt(0);
         return Value::makeInt(static_cast<int64_t>(
             havel::VirtualPointer::buttonNameToLinux(strArg(api, args[0]))));
@@ -255,39 +256,39 @@ void registerWaylandModule(const VMApi &apiRef) {
     static std::unique_ptr<havel::WaylandClipboardBackend> clip;
     static bool clipInit = false;
 
-    api.registerFunction("wayland.clipboard.init", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.clipboard.init", [&client](HostArgs) {
         if (clipInit && clip) return Value::makeBool(true);
         clip = std::make_unique<havel::WaylandClipboardBackend>(client);
         clipInit = clip->initialize();
         return Value::makeBool(clipInit);
     });
 
-    api.registerFunction("wayland.clipboard.get_text", [&api](const std::vector<Value> &) {
+    api.registerFunction("wayland.clipboard.get_text", [&api](HostArgs) {
         if (!clipInit || !clip) return api.makeString("");
         return api.makeString(clip->getText());
     });
 
-    api.registerFunction("wayland.clipboard.set_text", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.clipboard.set_text", [&api](HostArgs args) {
         if (!clipInit || !clip || args.empty()) return Value::makeBool(false);
         return Value::makeBool(clip->setText(strArg(api, args[0])));
     });
 
-    api.registerFunction("wayland.clipboard.clear", [](const std::vector<Value> &) {
+    api.registerFunction("wayland.clipboard.clear", [](HostArgs) {
         if (!clipInit || !clip) return Value::makeBool(false);
         return Value::makeBool(clip->clear());
     });
 
-    api.registerFunction("wayland.clipboard.has_text", [](const std::vector<Value> &) {
+    api.registerFunction("wayland.clipboard.has_text", [](HostArgs) {
         if (!clipInit || !clip) return Value::makeBool(false);
         return Value::makeBool(clip->hasText());
     });
 
-    api.registerFunction("wayland.clipboard.get_primary", [&api](const std::vector<Value> &) {
+    api.registerFunction("wayland.clipboard.get_primary", [&api](HostArgs) {
         if (!clipInit || !clip) return api.makeString("");
         return api.makeString(clip->getPrimaryText());
     });
 
-    api.registerFunction("wayland.clipboard.set_primary", [&api](const std::vector<Value> &args) {
+    api.registerFunction("wayland.clipboard.set_primary", [&api](HostArgs args) {
         if (!clipInit || !clip || args.empty()) return Value::makeBool(false);
         return Value::makeBool(clip->setPrimaryText(strArg(api, args[0])));
     });
@@ -305,14 +306,14 @@ void registerWaylandModule(const VMApi &apiRef) {
     static std::unique_ptr<havel::ForeignToplevel> tl;
     static bool tlInit = false;
 
-    api.registerFunction("wayland.windows.init", [&client](const std::vector<Value> &) {
+    api.registerFunction("wayland.windows.init", [&client](HostArgs) {
         if (tlInit && tl) return Value::makeBool(true);
         tl = std::make_unique<havel::ForeignToplevel>(client);
         tlInit = tl->initialize();
         return Value::makeBool(tlInit);
     });
 
-    api.registerFunction("wayland.windows.list", [&api](const std::vector<Value> &) {
+    api.registerFunction("wayland.windows.list", [&api](HostArgs) {
         if (!tlInit || !tl) return api.makeArray();
         auto arr = api.makeArray();
         for (const auto &w : tl->windows()) {
@@ -329,7 +330,7 @@ void registerWaylandModule(const VMApi &apiRef) {
         return arr;
     });
 
-    api.registerFunction("wayland.windows.active", [&api](const std::vector<Value> &) {
+    api.registerFunction("wayland.windows.active", [&api](HostArgs) {
         if (!tlInit || !tl) return Value::makeNull();
         auto w = tl->activeWindow();
         if (!w.handle) return Value::makeNull();
@@ -341,27 +342,27 @@ void registerWaylandModule(const VMApi &apiRef) {
         return obj;
     });
 
-    api.registerFunction("wayland.windows.focus", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.windows.focus", [](HostArgs args) {
         if (!tlInit || !tl || args.empty()) return Value::makeBool(false);
         return Value::makeBool(tl->focusWindow(static_cast<uint32_t>(intArg(args[0]))));
     });
 
-    api.registerFunction("wayland.windows.close", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.windows.close", [](HostArgs args) {
         if (!tlInit || !tl || args.empty()) return Value::makeBool(false);
         return Value::makeBool(tl->closeWindow(static_cast<uint32_t>(intArg(args[0]))));
     });
 
-    api.registerFunction("wayland.windows.minimize", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.windows.minimize", [](HostArgs args) {
         if (!tlInit || !tl || args.empty()) return Value::makeBool(false);
         return Value::makeBool(tl->minimizeWindow(static_cast<uint32_t>(intArg(args[0]))));
     });
 
-    api.registerFunction("wayland.windows.maximize", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.windows.maximize", [](HostArgs args) {
         if (!tlInit || !tl || args.empty()) return Value::makeBool(false);
         return Value::makeBool(tl->maximizeWindow(static_cast<uint32_t>(intArg(args[0]))));
     });
 
-    api.registerFunction("wayland.windows.fullscreen", [](const std::vector<Value> &args) {
+    api.registerFunction("wayland.windows.fullscreen", [](HostArgs args) {
         if (!tlInit || !tl || args.empty()) return Value::makeBool(false);
         bool fs = args.size() > 1 ? (intArg(args[1], 1) != 0) : true;
         return Value::makeBool(tl->setFullscreen(static_cast<uint32_t>(intArg(args[0])), fs));
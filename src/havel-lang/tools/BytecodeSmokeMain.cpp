@@ -194,8 +194,8 @@ void dumpBytecode(const std::string &name, const std::string &source) {
           std::cout << bytecodeValueToString(instruction.operands[j]);
         }
       }
-      if (i < function.instruction_locations.size()) {
-        const auto &location = function.instruction_locations[i];
+      if (i < function.line_table.size()) {
+        const auto location = function.line_table.lookup(i);
         std::cout << " @";
         if (location.line == 0 && location.column == 0) {
           std::cout << "?";
@@ -276,8 +276,9 @@ int64_t ImageService::create(int width, int height, int r, int g, int b, int a)
     return impl_->store(img);
 }
 
-int64_t ImageService::fromRGBA(const std::vector<uint8_t>& data, int width, int height) {
-    if (data.size() < static_cast<size_t>(width * height * 4)) return 0;
+int64_t ImageService::fromRGBA(std::span<const uint8_t> data, int width, int height) {
+    if (width <= 0 || height <= 0) return 0;
+    if (data.size() < static_cast<size_t>(width) * height * 4) return 0;
     cv::Mat img(height, width, CV_8UC4);
     std::memcpy(img.data, data.data(), width * height * 4);
     return impl_->store(img);
@@ -366,7 +367,7 @@ int64_t ImageService::blend(int64_t, int64_t, double) { return 0; }
 bool ImageService::getPixel(int64_t, int, int, int&, int&, int&, int&) { return false; }
 bool ImageService::setPixel(int64_t, int, int, int, int, int, int) { return false; }
 int64_t ImageService::create(int, int, int, int, int, int) { return 0; }
-int64_t ImageService::fromRGBA(const std::vector<uint8_t>&, int, int) { return 0; }
+int64_t ImageService::fromRGBA(std::span<const uint8_t>, int, int) { return 0; }
 std::vector<uint8_t> ImageService::toRGBA(int64_t) { return {}; }
 int64_t ImageService::matchTemplate(int64_t, int64_t, float, int&, int&, float&) { return -1; }
 void ImageService::releaseAll() {}
@@ -6,6 +6,7 @@
  */
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 #include <memory>
@@ -51,7 +52,7 @@ public:
     bool setPixel(int64_t handle, int x, int y, int r, int g, int b, int a);
 
     int64_t create(int width, int height, int r, int g, int b, int a);
-    int64_t fromRGBA(const std::vector<uint8_t>& data, int width, int height);
+    int64_t fromRGBA(std::span<const uint8_t> data, int width, int height);
     std::vector<uint8_t> toRGBA(int64_t handle);
 
     int64_t matchTemplate(int64_t screen, int64_t templ, float threshold, int& outX, int& outY, float& outConf);
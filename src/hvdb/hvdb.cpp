@@ -413,6 +413,7 @@ int main(int argc, char* argv[]) {
                           << "  Collections: " << stats.collections << "\n"
                           << "  Recovered: " << stats.total_recovered << " bytes\n"
                           << "  Last pause: " << stats.last_pause_ns << " ns\n"
+                          << "  Last mark: " << stats.last_mark_ns << " ns\n"
                           << "  Memory: " << vm.getMemoryUsage() << " bytes\n"
                           << "  GC suspended: " << (vm.gcSuspended() ? "yes" : "no") << "\n";
             } else if (cmd == "threads" || cmd == "goroutines") {
@@ -10,7 +10,7 @@
 #include "smoke_runner.hpp"
 #include "script_runner.hpp"
 
-namespace havel::test { void run_scheduler_tests(); }
+namespace havel::test { void run_scheduler_tests(); void run_superinstruction_tests(); void run_gc_heap_tests(); }
 
 namespace fs = std::filesystem;
 
@@ -53,6 +53,8 @@ static void print_usage(const char *prog) {
 " --cpp run C++ unit tests via ctest\n"
 " --jit   run JIT smoke tests (requires LLVM build)\n"
 " --compare run comparison between C++, self-hosted, JIT, AOT for all tests\n"
+" --fused run superinstruction vs plain dispatch tests\n"
+" --gc run GC heap tests\n"
 " --list list all test files without running\n"
 " --all run everything (smoke + jit + hvmoke + scripts + cpp)\n"
 "\n"
@@ -80,6 +82,8 @@ int main(int argc, char **argv) {
 	bool mode_all = false;
 	bool mode_compare = false;
 	bool mode_scheduler = false;
+	bool mode_fused = false;
+	bool mode_gc = false;
 	bool verbose = false;
 	int timeout = 60;
 	std::string havel_bin;
@@ -100,6 +104,8 @@ int main(int argc, char **argv) {
 		else if (arg == "--list") { mode_list = true; }
 		else if (arg == "--all") { mode_all = true; }
 		else if (arg == "--scheduler") { mode_scheduler = true; }
+		else if (arg == "--fused") { mode_fused = true; }
+		else if (arg == "--gc") { mode_gc = true; }
 		else if (arg == "--verbose") { verbose = true; }
 		else if (arg == "--timeout" && i + 1 < argc) { timeout = std::atoi(argv[++i]); }
 		else if (arg == "--havel" && i + 1 < argc) { havel_bin = argv[++i]; }
@@ -134,6 +140,16 @@ int main(int argc, char **argv) {
 		return 0;
 	}
 
+	if (mode_fused) {
+		havel::test::run_superinstruction_tests();
+		return 0;
+	}
+
+	if (mode_gc) {
+		havel::test::run_gc_heap_tests();
+		return 0;
+	}
+
 	if (!single_files.empty()) {
 		for (const auto &file : single_files) {
 			auto result = hvtest::run_script(havel_bin, file, timeout);
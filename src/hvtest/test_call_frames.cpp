@@ -0,0 +1,208 @@
+#include "havel-lang/compiler/core/Pipeline.hpp"
+#include "havel-lang/compiler/vm/VM.hpp"
+#include "havel-lang/runtime/concurrency/Scheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace havel::compiler;
+
+// Counts every global operator new on the thread running the script. The
+// replacement is binary-wide, so this test is built as its own executable
+// (hvtest_frames) and the counter stays a plain malloc/free pair with one
+// thread-local increment.
+static thread_local size_t g_thread_allocations = 0;
+
+void *operator new(std::size_t size) {
+    ++g_thread_allocations;
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace havel::test {
+
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { std::cerr << "  FAIL: " << msg << "\n"; std::abort(); } \
+} while(0)
+
+#define CHECK_EQ(a, b, msg) do { \
+    if ((a) != (b)) { \
+        std::cerr << "  FAIL: " << msg << " (got " << a << ", expected " << b << ")\n"; \
+        std::abort(); \
+    } \
+} while(0)
+
+// Runs `source` with collection suspended, recording the allocation counter
+// each time the script calls mark(). Returns the allocations between
+// consecutive marks.
+static std::vector<size_t> allocationsBetweenMarks(const std::string &source) {
+    std::vector<size_t> marks;
+    marks.reserve(64);
+    PipelineOptions options;
+    options.compile_unit_name = "call_frames";
+    options.host_functions["mark"] = [&marks](const std::vector<Value> &) {
+        marks.push_back(g_thread_allocations);
+        return Value::makeNull();
+    };
+    options.vm_setup = [](VM &vm) {
+        // VM::execute runs the entry function as the scheduler's main goroutine.
+        vm.setScheduler(&Scheduler::instance());
+        vm.suspendGC();
+    };
+    runBytecodePipeline(source, "__main__", options);
+
+    std::vector<size_t> windows;
+    for (size_t i = 1; i < marks.size(); ++i) {
+        windows.push_back(marks[i] - marks[i - 1]);
+    }
+    return windows;
+}
+
+// Each window makes 2000 calls. The dispatch loop polls for events every
+// 8192 calls, so at most one of three consecutive windows contains a poll;
+// the others must not allocate at all.
+static size_t quietestWindow(const std::vector<size_t> &windows) {
+    CHECK(windows.size() >= 3, "expected at least three measured windows");
+    return *std::min_element(windows.begin() + windows.size() - 3, windows.end());
+}
+
+static void test_plain_call_does_not_allocate() {
+    const std::string source = R"(
+fn leaf(a, b) { return a + b }
+fn run(n) {
+  s = 0
+  i = 0
+  while i < n {
+    s = leaf(s, i)
+    i += 1
+  }
+  return s
+}
+run(3000)
+mark()
+run(2000)
+mark()
+run(2000)
+mark()
+run(2000)
+mark()
+return 0
+)";
+    CHECK_EQ(quietestWindow(allocationsBetweenMarks(source)), 0u,
+             "allocations during 2000 calls of a function");
+}
+
+static void test_default_params_do_not_allocate() {
+    const std::string source = R"(
+fn scaled(x, by = 3) { return x * by }
+fn run(n) {
+  s = 0
+  i = 0
+  while i < n {
+    s += scaled(i)
+    i += 1
+  }
+  return s
+}
+run(3000)
+mark()
+run(2000)
+mark()
+run(2000)
+mark()
+run(2000)
+mark()
+return 0
+)";
+    CHECK_EQ(quietestWindow(allocationsBetweenMarks(source)), 0u,
+             "allocations during 2000 calls filling a default parameter");
+}
+
+static void test_try_in_callee_does_not_allocate() {
+    const std::string source = R"(
+fn guarded(x) {
+  y = 0
+  try {
+    y = x + 1
+  } catch (e) {
+    y = -1
+  }
+  return y
+}
+fn run(n) {
+  s = 0
+  i = 0
+  while i < n {
+    s = guarded(s)
+    i += 1
+  }
+  return s
+}
+run(3000)
+mark()
+run(2000)
+mark()
+run(2000)
+mark()
+run(2000)
+mark()
+return 0
+)";
+    CHECK_EQ(quietestWindow(allocationsBetweenMarks(source)), 0u,
+             "allocations during 2000 calls entering a try block");
+}
+
+static void test_closures_still_capture() {
+    const std::string source = R"(
+fn makeCounter() {
+  count = 0
+  fn inc() {
+    count += 1
+    return count
+  }
+  return inc
+}
+a = makeCounter()
+b = makeCounter()
+a()
+a()
+return a() * 10 + b()
+)";
+    PipelineOptions options;
+    options.compile_unit_name = "call_frames_capture";
+    options.vm_setup = [](VM &vm) { vm.setScheduler(&Scheduler::instance()); };
+    auto result = runBytecodePipeline(source, "__main__", options);
+    CHECK(result.return_value.isInt(), "counter result should be an int");
+    CHECK_EQ(result.return_value.asInt(), 31, "closures keep separate cells");
+}
+
+void run_call_frame_tests() {
+    std::cout << "=== Call Frame Tests ===\n\n";
+
+    test_plain_call_does_not_allocate();
+    std::cout << " PASS plain call/return allocates nothing\n";
+
+    test_default_params_do_not_allocate();
+    std::cout << " PASS call filling a default parameter allocates nothing\n";
+
+    test_try_in_callee_does_not_allocate();
+    std::cout << " PASS try handlers use the frame arena's side stack\n";
+
+    test_closures_still_capture();
+    std::cout << " PASS closures capture through arena upvalue cells\n";
+
+    std::cout << "\nAll call frame tests passed.\n";
+}
+
+} // namespace havel::test
+
+int main() {
+    havel::test::run_call_frame_tests();
+    return 0;
+}
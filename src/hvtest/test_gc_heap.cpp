@@ -0,0 +1,562 @@
+#include "havel-lang/compiler/core/Pipeline.hpp"
+#include "havel-lang/compiler/gc/GC.hpp"
+#include "havel-lang/compiler/gc/Slab.hpp"
+#include "havel-lang/compiler/vm/VM.hpp"
+#include "havel-lang/runtime/concurrency/Scheduler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace havel::compiler;
+
+namespace havel::test {
+
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { std::cerr << "  FAIL: " << msg << "\n"; std::abort(); } \
+} while(0)
+
+#define CHECK_EQ(a, b, msg) do { \
+    if ((a) != (b)) { \
+        std::cerr << "  FAIL: " << msg << " (got " << a << ", expected " << b << ")\n"; \
+        std::abort(); \
+    } \
+} while(0)
+
+// Roots held in a vector the test owns, visited in place. Counts how often
+// the heap visits them.
+class VectorRoots final : public RootSource {
+public:
+    explicit VectorRoots(const std::vector<Value> &values) : values_(values) {}
+    void visitRoots(RootVisitor &visitor) const override {
+        ++visits;
+        for (const Value &value : values_) {
+            visitor.visit(value);
+        }
+    }
+    mutable size_t visits = 0;
+
+private:
+    const std::vector<Value> &values_;
+};
+
+static void test_slab_stale_id_misses_after_reuse() {
+    Slab<std::string> slab;
+    const uint32_t first = slab.emplace("first");
+    CHECK(first != 0, "id 0 is reserved");
+    CHECK(slab.mark(first), "first mark of a live id");
+    CHECK(!slab.mark(first), "second mark is a no-op");
+    CHECK(slab.erase(first), "erase of a live id");
+    CHECK(!slab.erase(first), "second erase of the same id");
+
+    const uint32_t second = slab.emplace("second");
+    CHECK_EQ(Slab<std::string>::indexOf(second), Slab<std::string>::indexOf(first),
+             "a freed slot is reused");
+    CHECK(second != first, "reuse bumps the generation");
+    CHECK(slab.get(first) == nullptr, "stale id misses");
+    CHECK(!slab.isMarked(second), "a reused slot starts unmarked");
+    CHECK(!slab.mark(first), "stale id cannot be marked");
+    CHECK_EQ(*slab.get(second), std::string("second"), "fresh id hits");
+}
+
+static void test_shape_transitions_drop_dead_edges() {
+    // A private parent, so other tests' layouts don't share its table.
+    auto parent = ObjectShape::empty()->withKey("__shape_prune_test");
+    auto kept = parent->withKey("kept");
+
+    for (int i = 0; i < 10000; ++i) {
+        // The child dies at the end of the statement.
+        parent->withKey("k" + std::to_string(i));
+    }
+    CHECK(parent->transitionCount() <= 64,
+          "dead transition edges are pruned as the table grows");
+    CHECK(parent->withKey("kept") == kept,
+          "a live child survives pruning and is reused");
+    CHECK_EQ(kept->slotOf("kept"), 1u, "surviving child keeps its layout");
+}
+
+static void test_slab_iteration_and_erase() {
+    Slab<int> slab;
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(slab.emplace(i));
+    }
+    const int *pinned = slab.get(ids[3]);
+    for (size_t i = 0; i < ids.size(); i += 2) {
+        slab.erase(ids[i]);
+    }
+    CHECK_EQ(slab.size(), 500u, "half erased");
+    CHECK(slab.get(ids[3]) == pinned, "entries never move");
+
+    size_t seen = 0;
+    for (auto [id, value] : slab) {
+        CHECK(value % 2 == 1, "only odd entries survive");
+        CHECK(slab.get(id) == &value, "iteration yields live ids");
+        ++seen;
+    }
+    CHECK_EQ(seen, 500u, "iteration visits every live entry");
+}
+
+static void test_heap_survives_churn() {
+    const std::string source = R"(
+keep = []
+i = 0
+while i < 20000 {
+  tmp = [i, i + 1, {v: i}]
+  if i % 100 == 0 { keep.push(tmp) }
+  i += 1
+}
+total = 0
+for k in keep { total += k[2].v }
+return total
+)";
+    PipelineOptions options;
+    options.compile_unit_name = "gc_churn";
+    // VM::execute runs the entry function as the scheduler's main goroutine.
+    options.vm_setup = [](VM &vm) { vm.setScheduler(&Scheduler::instance()); };
+    auto result = runBytecodePipeline(source, "__main__", options);
+    CHECK(result.return_value.isInt(), "churn result should be an int");
+    CHECK_EQ(result.return_value.asInt(), 1990000, "survivors keep their contents");
+}
+
+// An automatic collection stops the world only to mark. Sweeping is left
+// to later allocations, which sweep their own kind first and are allocated
+// black, and to GC steps, which finish the rest. Finalizers are queued by
+// whichever of those sweeps the object and handed out by drainFinalizers.
+static void test_sweep_is_lazy() {
+    GCHeap heap;
+    heap.setAllocationBudget(256);
+    const ArrayRef root = heap.allocateArray();
+    std::vector<uint32_t> kept;
+    std::vector<uint32_t> garbage;
+    for (int i = 0; i < 4000; ++i) {
+        const uint32_t id = heap.allocateArray().id;
+        if (i % 4 == 0) {
+            heap.array(root.id)->push_back(Value::makeArrayId(id));
+            kept.push_back(id);
+        } else {
+            garbage.push_back(id);
+        }
+    }
+    const ObjectRef doomed = heap.allocateObject();
+    (*heap.object(doomed.id))["op_destructor"] = Value::makeHostFuncId(0);
+
+    const std::vector<Value> roots = {Value::makeArrayId(root.id)};
+    heap.maybeCollectGarbage(VectorRoots(roots));
+    CHECK(heap.isCollectionInProgress(), "sweeping is deferred past the mark");
+    CHECK(heap.arrayExists(garbage.back()), "unswept garbage is still allocated");
+
+    std::vector<uint32_t> fresh;
+    for (int i = 0; i < 200; ++i) {
+        fresh.push_back(heap.allocateArray().id);
+    }
+    CHECK(!heap.arrayExists(garbage.front()), "allocation sweeps its own kind");
+
+    heap.stepGarbageCollection(VectorRoots(roots), std::numeric_limits<size_t>::max());
+    CHECK(!heap.isCollectionInProgress(), "a GC step finishes the sweep");
+    for (uint32_t id : garbage) {
+        CHECK(!heap.arrayExists(id), "garbage array " << id << " is swept");
+    }
+    for (uint32_t id : kept) {
+        CHECK(heap.arrayExists(id), "reachable array " << id << " survives");
+    }
+    for (uint32_t id : fresh) {
+        CHECK(heap.arrayExists(id), "array " << id << " allocated mid-sweep survives");
+    }
+    const auto finalizers = heap.drainFinalizers();
+    CHECK_EQ(finalizers.size(), 1u, "the swept object's finalizer is queued");
+    CHECK_EQ(finalizers.front().first, doomed.id, "finalizer for the right object");
+}
+
+// VM caches hold closure ids without rooting them. A hit taken mid-mark
+// keeps its closure alive for the cycle; once marking is over an unmarked
+// closure is condemned, so the hit must be refused.
+static void test_cached_closures_follow_the_cycle() {
+    GCHeap heap;
+    std::vector<Value> values;
+    VectorRoots roots(values);
+    const uint32_t revived = heap.allocateClosure(GCHeap::RuntimeClosure{}).id;
+    const uint32_t dropped = heap.allocateClosure(GCHeap::RuntimeClosure{}).id;
+    CHECK(heap.retainCachedClosure(revived), "an idle heap hands out any live closure");
+
+    heap.startIncrementalCollection(roots);
+    CHECK(heap.retainCachedClosure(revived), "a hit mid-mark is handed out");
+    heap.stepGarbageCollection(roots, std::numeric_limits<size_t>::max());
+    CHECK(!heap.isCollectionInProgress(), "the step finishes the cycle");
+    CHECK(heap.closureExists(revived), "the closure hit mid-mark survives");
+    CHECK(!heap.closureExists(dropped), "the unrooted closure is swept");
+
+    // Enough garbage that the collection cannot sweep it all in one call.
+    heap.setAllocationBudget(256);
+    const uint32_t condemned = heap.allocateClosure(GCHeap::RuntimeClosure{}).id;
+    for (int i = 0; i < 4000; ++i) {
+        heap.allocateArray();
+    }
+    heap.maybeCollectGarbage(roots);
+    CHECK(heap.isCollectionInProgress(), "sweeping is deferred past the mark");
+    CHECK(heap.closureExists(condemned), "the condemned closure is not swept yet");
+    CHECK(!heap.retainCachedClosure(condemned), "a condemned closure is refused");
+}
+
+// Roots are visited where they live, only while the collector has work.
+// An idle safe point returns without looking at them, and a cycle sees
+// roots added after it started when it re-visits them before sweeping.
+static void test_roots_are_visited_in_place() {
+    GCHeap heap;
+    std::vector<Value> values;
+    VectorRoots roots(values);
+    const ArrayRef early = heap.allocateArray();
+    const ArrayRef late = heap.allocateArray();
+    const ArrayRef garbage = heap.allocateArray();
+    values.push_back(Value::makeArrayId(early.id));
+
+    heap.maybeCollectGarbage(roots);
+    heap.stepGarbageCollection(roots);
+    CHECK_EQ(roots.visits, 0u, "an idle safe point does not visit roots");
+
+    heap.startIncrementalCollection(roots);
+    CHECK_EQ(roots.visits, 1u, "starting a cycle visits the roots");
+    values.push_back(Value::makeArrayId(late.id));
+    heap.stepGarbageCollection(roots, std::numeric_limits<size_t>::max());
+    CHECK(!heap.isCollectionInProgress(), "the step finishes the cycle");
+    CHECK(roots.visits >= 2u, "the roots are visited again before sweeping");
+    CHECK(heap.arrayExists(early.id), "a root from the start survives");
+    CHECK(heap.arrayExists(late.id), "a root added mid-cycle survives");
+    CHECK(!heap.arrayExists(garbage.id), "unrooted array is swept");
+
+    const size_t visits = roots.visits;
+    heap.maybeCollectGarbage(roots);
+    CHECK_EQ(roots.visits, visits, "no visits once the cycle is done");
+}
+
+// Minor collections trace only the young heap plus the remembered set.
+// An old array written through a mutable lookup is remembered, so the
+// young array stored in it survives a minor cycle; once that array is
+// promoted too the old array is forgotten. Unreachable old arrays are left
+// to the next full collection.
+static void test_remembered_set_keeps_old_to_young_edges() {
+    GCHeap heap;
+    heap.setPromotionAgeThreshold(1);
+    heap.setFullCollectionInterval(1000);
+
+    const ArrayRef root = heap.allocateArray();
+    const ArrayRef old_garbage = heap.allocateArray();
+    const std::vector<Value> roots = {Value::makeArrayId(root.id)};
+    heap.collectGarbage(
+        VectorRoots({Value::makeArrayId(root.id), Value::makeArrayId(old_garbage.id)}));
+    CHECK_EQ(heap.oldArrayCount(), 2u, "survivors are promoted");
+    CHECK_EQ(heap.rememberedCount(), 0u, "arrays holding nothing are not remembered");
+
+    const ArrayRef young = heap.allocateArray();
+    const ArrayRef young_garbage = heap.allocateArray();
+    std::as_const(heap).array(root.id);
+    CHECK_EQ(heap.rememberedCount(), 0u, "a read-only lookup does not remember");
+    heap.array(root.id)->push_back(Value::makeArrayId(young.id));
+    CHECK_EQ(heap.rememberedCount(), 1u, "a mutable lookup remembers the old array");
+
+    heap.collectGarbage(VectorRoots(roots));
+    CHECK(heap.arrayExists(young.id), "young array reachable from an old one survives");
+    CHECK(!heap.arrayExists(young_garbage.id), "unreachable young array is swept");
+    CHECK(heap.arrayExists(old_garbage.id), "a minor cycle leaves old garbage alone");
+    CHECK_EQ(heap.rememberedCount(), 0u, "nothing young is left to remember");
+
+    heap.forceFullCollection(VectorRoots(roots));
+    CHECK(!heap.arrayExists(old_garbage.id), "a full cycle sweeps old garbage");
+    CHECK(heap.arrayExists(young.id), "promoted array survives a full cycle");
+}
+
+// Generational torture: a random graph of arrays is rewired between a mix
+// of minor and full collections, so edges keep appearing from old arrays
+// to young ones. Every array reachable from the roots must survive every
+// cycle; a full cycle must also free everything else.
+static void test_minor_cycles_match_reachability() {
+    GCHeap heap;
+    heap.setPromotionAgeThreshold(2);
+    heap.setFullCollectionInterval(3);
+
+    std::mt19937 rng(20240702);
+    std::unordered_map<uint32_t, std::vector<uint32_t>> edges;
+    std::vector<uint32_t> ids;
+    auto add_node = [&] {
+        const uint32_t id = heap.allocateArray().id;
+        edges[id];
+        ids.push_back(id);
+        return id;
+    };
+    auto link = [&](uint32_t from, uint32_t to) {
+        edges[from].push_back(to);
+        heap.array(from)->push_back(Value::makeArrayId(to));
+    };
+    auto pick = [&] { return ids[rng() % ids.size()]; };
+
+    const uint32_t root = add_node();
+    for (int i = 0; i < 5000; ++i) {
+        link(i % 3 == 0 ? root : pick(), add_node());
+    }
+
+    const std::vector<Value> roots = {Value::makeArrayId(root)};
+    for (int round = 0; round < 12; ++round) {
+        const bool full = round % 4 == 3;
+        if (full) {
+            heap.forceFullCollection(VectorRoots(roots));
+        } else {
+            heap.collectGarbage(VectorRoots(roots));
+        }
+
+        std::unordered_set<uint32_t> reachable = {root};
+        std::vector<uint32_t> frontier = {root};
+        while (!frontier.empty()) {
+            const uint32_t id = frontier.back();
+            frontier.pop_back();
+            for (uint32_t child : edges[id]) {
+                if (reachable.insert(child).second) {
+                    frontier.push_back(child);
+                }
+            }
+        }
+        std::vector<uint32_t> survivors;
+        for (uint32_t id : ids) {
+            if (reachable.count(id)) {
+                CHECK(heap.arrayExists(id), "reachable array " << id << " survives round " << round);
+                survivors.push_back(id);
+            } else {
+                if (full) {
+                    CHECK(!heap.arrayExists(id), "full cycle frees array " << id);
+                }
+                // Unreachable arrays are never linked to again, so a minor
+                // cycle may keep the old ones until the next full cycle.
+                edges.erase(id);
+            }
+        }
+        ids = std::move(survivors);
+
+        for (int i = 0; i < 500; ++i) {
+            const uint32_t id = pick();
+            if (id != root && !edges[id].empty()) {
+                edges[id].clear();
+                heap.array(id)->clear();
+            }
+        }
+        for (int i = 0; i < 3000; ++i) {
+            link(pick(), add_node());
+        }
+    }
+}
+
+// Reports a minor collection's mark time over a heap of about 200k old
+// objects that nothing has written to since they were promoted, next to a
+// full collection of the same heap. As with the mark benchmark below,
+// nothing is asserted about the times.
+static std::pair<uint64_t, uint64_t> benchmark_minor_over_old_heap() {
+    GCHeap heap;
+    heap.setPromotionAgeThreshold(1);
+    heap.setFullCollectionInterval(1000);
+    const ArrayRef root = heap.allocateArray();
+    for (int i = 0; i < 200; ++i) {
+        const ArrayRef inner = heap.allocateArray();
+        heap.array(root.id)->push_back(Value::makeArrayId(inner.id));
+        for (int j = 0; j < 1000; ++j) {
+            const ObjectRef obj = heap.allocateObject();
+            heap.array(inner.id)->push_back(Value::makeObjectId(obj.id));
+        }
+    }
+    const std::vector<Value> roots = {Value::makeArrayId(root.id)};
+    heap.collectGarbage(VectorRoots(roots));
+    CHECK_EQ(heap.rememberedCount(), 0u, "a fully promoted heap needs no remembered set");
+
+    for (int i = 0; i < 1000; ++i) {
+        heap.allocateArray();
+    }
+    heap.collectGarbage(VectorRoots(roots));
+    const uint64_t minor_ns = heap.stats().last_mark_ns;
+    heap.forceFullCollection(VectorRoots(roots));
+    const uint64_t full_ns = heap.stats().last_mark_ns;
+    CHECK(heap.oldObjectCount() == 200000u, "old objects survive both cycles");
+    return {minor_ns, full_ns};
+}
+
+// Builds a heap of one root array holding 1000 arrays of 999 objects each,
+// roughly a million live objects, and reports the fastest of a few full
+// collections' mark time with `threads` marking threads. Nothing is
+// asserted about the time itself; the number is for comparing builds and
+// thread counts on the same machine.
+static uint64_t benchmark_mark_million_live(size_t threads) {
+    constexpr size_t kOuter = 1000;
+    constexpr size_t kInner = 999;
+    GCHeap heap;
+    heap.setMarkThreads(threads);
+    const ArrayRef root = heap.allocateArray();
+    for (size_t i = 0; i < kOuter; ++i) {
+        const ArrayRef inner = heap.allocateArray();
+        heap.array(root.id)->push_back(Value::makeArrayId(inner.id));
+        heap.array(inner.id)->reserve(kInner);
+        for (size_t j = 0; j < kInner; ++j) {
+            const ObjectRef obj = heap.allocateObject();
+            heap.array(inner.id)->push_back(Value::makeObjectId(obj.id));
+        }
+    }
+    const uint64_t live = heap.stats().object_count;
+    CHECK(live >= 1000000u, "benchmark heap holds a million objects");
+
+    uint64_t best_ns = std::numeric_limits<uint64_t>::max();
+    for (int run = 0; run < 3; ++run) {
+        heap.forceFullCollection(VectorRoots({Value::makeArrayId(root.id)}));
+        CHECK_EQ(heap.stats().object_count, live, "every object is reachable");
+        best_ns = std::min(best_ns, heap.stats().last_mark_ns);
+    }
+    CHECK(best_ns > 0, "mark time is recorded");
+    return best_ns * 1000000u / live;
+}
+
+// Parallel marking torture: a random graph of arrays (cycles, shared
+// children, one long chain) is collected repeatedly with eight marking
+// threads while the test rewires it between collections. After every
+// collection the survivors must be exactly what a plain BFS over the
+// test's own copy of the edges reaches from the roots.
+static void test_parallel_mark_matches_reachability() {
+    GCHeap heap;
+    heap.setMarkThreads(8);
+    CHECK_EQ(heap.markThreads(), 8u, "mark thread count applies");
+
+    std::mt19937 rng(20240611);
+    std::unordered_map<uint32_t, std::vector<uint32_t>> edges;
+    std::vector<uint32_t> ids;
+    auto add_node = [&] {
+        const uint32_t id = heap.allocateArray().id;
+        edges[id];
+        ids.push_back(id);
+        return id;
+    };
+    auto link = [&](uint32_t from, uint32_t to) {
+        edges[from].push_back(to);
+        heap.array(from)->push_back(Value::makeArrayId(to));
+    };
+    auto pick = [&] { return ids[rng() % ids.size()]; };
+
+    for (int i = 0; i < 40000; ++i) {
+        add_node();
+    }
+    uint32_t chain = add_node();
+    const uint32_t chain_head = chain;
+    for (int i = 0; i < 60000; ++i) {
+        const uint32_t next = add_node();
+        link(chain, next);
+        chain = next;
+    }
+    for (int i = 0; i < 60000; ++i) {
+        link(pick(), pick());
+    }
+
+    for (int round = 0; round < 6; ++round) {
+        std::vector<uint32_t> roots = {chain_head};
+        for (int i = 0; i < 8; ++i) {
+            roots.push_back(pick());
+        }
+        std::vector<Value> root_values;
+        for (uint32_t id : roots) {
+            root_values.push_back(Value::makeArrayId(id));
+        }
+
+        std::unordered_set<uint32_t> reachable(roots.begin(), roots.end());
+        std::vector<uint32_t> frontier(roots.begin(), roots.end());
+        while (!frontier.empty()) {
+            const uint32_t id = frontier.back();
+            frontier.pop_back();
+            for (uint32_t child : edges[id]) {
+                if (reachable.insert(child).second) {
+                    frontier.push_back(child);
+                }
+            }
+        }
+
+        heap.forceFullCollection(VectorRoots(root_values));
+
+        for (uint32_t id : ids) {
+            CHECK_EQ(heap.arrayExists(id), (reachable.count(id) != 0),
+                     "array " << id << " survival in round " << round);
+        }
+        std::vector<uint32_t> survivors;
+        for (uint32_t id : ids) {
+            if (reachable.count(id)) {
+                survivors.push_back(id);
+            } else {
+                edges.erase(id);
+            }
+        }
+        ids = std::move(survivors);
+
+        // Rewire: cut some edges, add new nodes and links between
+        // survivors and the new nodes.
+        for (int i = 0; i < 2000; ++i) {
+            const uint32_t id = pick();
+            if (id != chain_head && !edges[id].empty()) {
+                edges[id].clear();
+                heap.array(id)->clear();
+            }
+        }
+        for (int i = 0; i < 20000; ++i) {
+            add_node();
+        }
+        for (int i = 0; i < 40000; ++i) {
+            link(pick(), pick());
+        }
+    }
+}
+
+void run_gc_heap_tests() {
+    std::cout << "=== GC Heap Tests ===\n\n";
+
+    test_slab_stale_id_misses_after_reuse();
+    std::cout << " PASS stale slab ids miss and lose their mark after reuse\n";
+
+    test_shape_transitions_drop_dead_edges();
+    std::cout << " PASS shape transition tables drop edges to freed shapes\n";
+
+    test_slab_iteration_and_erase();
+    std::cout << " PASS slab entries stay put and iterate in slot order\n";
+
+    test_heap_survives_churn();
+    std::cout << " PASS survivors keep their contents across slot reuse\n";
+
+    test_sweep_is_lazy();
+    std::cout << " PASS automatic collections sweep lazily\n";
+
+    test_cached_closures_follow_the_cycle();
+    std::cout << " PASS cached closures are kept mid-mark and refused once condemned\n";
+
+    test_roots_are_visited_in_place();
+    std::cout << " PASS roots are visited in place and only when there is work\n";
+
+    test_remembered_set_keeps_old_to_young_edges();
+    std::cout << " PASS minor collections keep old-to-young edges via the remembered set\n";
+
+    test_minor_cycles_match_reachability();
+    std::cout << " PASS minor and full cycles keep every reachable array\n";
+
+    const auto [minor_ns, full_ns] = benchmark_minor_over_old_heap();
+    std::cout << " PASS minor mark over 200k old objects took " << minor_ns / 1000000.0
+              << " ms (full: " << full_ns / 1000000.0 << " ms)\n";
+
+    test_parallel_mark_matches_reachability();
+    std::cout << " PASS parallel marking keeps exactly the reachable graph\n";
+
+    const size_t helpers = std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+    for (size_t threads : {size_t{1}, helpers}) {
+        const uint64_t mark_ns = benchmark_mark_million_live(threads);
+        std::cout << " PASS marked 1M live objects in " << mark_ns / 1000000.0
+                  << " ms with " << threads << " thread(s)\n";
+    }
+
+    std::cout << "\nAll GC heap tests passed.\n";
+}
+
+} // namespace havel::test
@@ -922,6 +922,44 @@ static void test_loadFiberState_restores_current_chunk_from_top_frame() {
   assert(vm.frame_arena_[1].chunk == &chunk_b);
 }
 
+// A fiber that is saved inside a module function takes the module's env
+// with it: the next fiber runs against the ambient globals, and the env is
+// active again when the first fiber is loaded.
+static void test_fiber_state_carries_module_envs() {
+  HostContext ctx;
+  VM vm(ctx);
+  vm.getGlobals()["ambient"] = Value::makeInt(1);
+  auto env = std::make_shared<GlobalTable>();
+  (*env)["inner"] = Value::makeInt(2);
+
+  Fiber fib(41, 0, 0, "env-owner");
+  vm.loadFiberState(&fib);
+  vm.enterModuleEnv(env);
+  CHECK(vm.getGlobals().contains("inner"), "the module env is active");
+
+  vm.saveFiberState(&fib);
+  CHECK_EQ(fib.module_envs.size(), 1u, "the saved fiber records its env");
+  CHECK(vm.active_env_ == nullptr, "saving leaves the module env");
+  CHECK(vm.env_stack_.empty(), "saving pops the env stack");
+  CHECK(vm.getGlobals().contains("ambient"), "ambient globals are back");
+  CHECK(!vm.getGlobals().contains("inner"), "module globals are not visible");
+
+  Fiber other(42, 0, 0, "env-bystander");
+  vm.loadFiberState(&other);
+  CHECK(vm.active_env_ == nullptr, "another fiber runs in the ambient env");
+  vm.saveFiberState(&other);
+  CHECK(other.module_envs.empty(), "the other fiber entered no env");
+
+  vm.loadFiberState(&fib);
+  CHECK(vm.active_env_ == env, "loading re-enters the saved env");
+  CHECK(vm.getGlobals().contains("inner"), "module globals are visible again");
+
+  vm.saveFiberState(&fib);
+  vm.saveFiberState(&fib);
+  CHECK_EQ(fib.module_envs.size(), 1u, "a second save keeps the recorded env");
+  CHECK(vm.getGlobals().contains("ambient"), "ambient globals after a double save");
+}
+
 // ============================================================
 // HotkeyPolicy + wakeHotkey + requeueFront + wakeHotkeyByAlias
 // ============================================================
@@ -2129,6 +2167,31 @@ static void test_hotkey_max_instructions_on_spawn() {
     sched.clearCurrent();
 }
 
+static void test_tick_instruction_knobs_apply() {
+    auto& sched = Scheduler::instance();
+    sched.setDefaultTickInstructions(500, 7000);
+
+    uint32_t normal = sched.spawn(0, {}, 0, "knob_normal");
+    uint32_t hk = sched.spawnHotkey(0, {}, 0, "knob_hotkey");
+    auto* registered = new Scheduler::Goroutine(900001, "knob_registered",
+                                                FiberPriority::NORMAL, false);
+    sched.registerGoroutine(registered);
+
+    auto* gn = sched.get(normal);
+    auto* gh = sched.get(hk);
+    CHECK_EQ(gn->max_instructions_per_tick, 500u, "spawn uses the normal knob");
+    CHECK_EQ(gh->max_instructions_per_tick, 7000u, "spawnHotkey uses the hotkey knob");
+    CHECK_EQ(registered->max_instructions_per_tick, 500u,
+             "registerGoroutine applies the knob to pre-built goroutines");
+
+    sched.setDefaultTickInstructions(Scheduler::Goroutine::DEFAULT_MAX_INSTRUCTIONS,
+                                     Scheduler::Goroutine::HOTKEY_MAX_INSTRUCTIONS);
+    gn->state = Scheduler::GoroutineState::Done;
+    gh->state = Scheduler::GoroutineState::Done;
+    registered->state = Scheduler::GoroutineState::Done;
+    sched.clearCurrent();
+}
+
 static void test_yield_done_goroutine_noop() {
     auto& sched = Scheduler::instance();
 
@@ -2451,7 +2514,7 @@ static void test_fiber_gc_roots() {
     Fiber fib(1, 0, 0, "gc_test");
     fib.stack.push(Value::makeInt(10));
     fib.stack.push(Value::makeInt(20));
-    fib.locals["x"] = Value::makeInt(30);
+    fib.locals.push_back(Value::makeInt(30));
     fib.return_value = Value::makeInt(40);
 
     auto roots = fib.getGCRoots();
@@ -3593,6 +3656,9 @@ std::cout << "=== Scheduler Tests ===\n\n";
     test_loadFiberState_restores_current_chunk_from_top_frame();
     std::cout << " PASS loadFiberState restores current_chunk from top frame\n";
 
+    test_fiber_state_carries_module_envs();
+    std::cout << " PASS fiber state carries the module envs it entered\n";
+
     // Hotkey policy + wakeHotkey + requeueFront + wakeHotkeyByAlias
     test_requeueFront_resets_state_and_requeues();
     std::cout << " PASS requeueFront resets state and requeues persistent goroutine\n";
@@ -3740,6 +3806,9 @@ std::cout << "=== Scheduler Tests ===\n\n";
  test_hotkey_max_instructions_on_spawn();
  std::cout << " PASS spawn vs spawnHotkey: max_instructions differ\n";
 
+ test_tick_instruction_knobs_apply();
+ std::cout << " PASS tick instruction knobs reach every registered goroutine\n";
+
  test_yield_done_goroutine_noop();
  std::cout << " PASS yield: Done goroutine is no-op\n";
 
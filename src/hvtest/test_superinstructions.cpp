@@ -0,0 +1,206 @@
+#include "havel-lang/compiler/core/Pipeline.hpp"
+#include "havel-lang/compiler/vm/VM.hpp"
+#include "havel-lang/runtime/concurrency/Scheduler.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace havel::compiler;
+
+namespace havel::test {
+
+#define CHECK(cond, msg) do { \
+    if (!(cond)) { std::cerr << "  FAIL: " << msg << "\n"; std::abort(); } \
+} while(0)
+
+#define CHECK_EQ(a, b, msg) do { \
+    if ((a) != (b)) { \
+        std::cerr << "  FAIL: " << msg << " (got " << a << ", expected " << b << ")\n"; \
+        std::abort(); \
+    } \
+} while(0)
+
+static bool isFusedHead(OpCode op) {
+    return superinstructionLength(op) > 1;
+}
+
+static size_t countOpcode(const BytecodeChunk &chunk, OpCode op) {
+    size_t n = 0;
+    for (const auto &fn : chunk.getAllFunctions()) {
+        for (const auto &inst : fn.instructions) {
+            if (inst.opcode == op) ++n;
+        }
+    }
+    return n;
+}
+
+static size_t countFusedHeads(const BytecodeChunk &chunk) {
+    size_t n = 0;
+    for (const auto &fn : chunk.getAllFunctions()) {
+        for (const auto &inst : fn.instructions) {
+            if (isFusedHead(inst.opcode)) ++n;
+        }
+    }
+    return n;
+}
+
+static double runNumber(const std::string &source, bool fused) {
+    PipelineOptions options;
+    options.compile_unit_name = "superinstructions";
+    options.superinstructions = fused;
+    // VM::execute runs the entry function as the scheduler's main goroutine.
+    options.vm_setup = [](VM &vm) { vm.setScheduler(&Scheduler::instance()); };
+    auto result = runBytecodePipeline(source, "__main__", options);
+    CHECK(result.return_value.isNumber(), "script should return a number");
+    return result.return_value.asNumber();
+}
+
+// Compiles `source` with and without fusion, checks that `head` is emitted
+// only when fusing, then runs both and compares with `expected`. The loops
+// run well past 8192 instructions so the fused heads also cross the
+// dispatcher's periodic poll.
+static void checkFusedMatchesPlain(OpCode head, const std::string &source,
+                                   double expected, const std::string &what) {
+    PipelineOptions fused_options;
+    fused_options.compile_unit_name = "superinstructions";
+    auto fused = compileToBytecodeChunk(source, "__main__", fused_options);
+    CHECK(fused && countOpcode(*fused, head) > 0, what << ": fused head not emitted");
+
+    PipelineOptions plain_options = fused_options;
+    plain_options.superinstructions = false;
+    auto plain = compileToBytecodeChunk(source, "__main__", plain_options);
+    CHECK(plain, what << ": plain compile failed");
+    CHECK_EQ(countFusedHeads(*plain), 0u, what << ": fused heads with fusion off");
+    CHECK_EQ(plain->getAllFunctions().size(), fused->getAllFunctions().size(),
+             what << ": function count");
+
+    const double fused_result = runNumber(source, true);
+    const double plain_result = runNumber(source, false);
+    CHECK_EQ(fused_result, plain_result, what << ": fused vs plain");
+    CHECK_EQ(fused_result, expected, what << ": result");
+}
+
+static void test_load_var_load_const_binop() {
+    checkFusedMatchesPlain(OpCode::LOAD_VAR_LOAD_CONST_BINOP, R"(
+fn run(n) {
+  s = 0
+  f = 0.5
+  i = 0
+  while i < n {
+    s = s + 3
+    f = f * 2
+    if f > 1000 { f = f - 1000 }
+    i += 1
+  }
+  return s + f
+}
+return run(5000)
+)", 15000 + 688.0, "LOAD_VAR_LOAD_CONST_BINOP");
+}
+
+static void test_load_var_load_var_binop() {
+    checkFusedMatchesPlain(OpCode::LOAD_VAR_LOAD_VAR_BINOP, R"(
+fn run(n) {
+  a = 1
+  b = 2.5
+  s = 0
+  i = 0
+  while i < n {
+    s = s + a * b
+    a = b - a
+    i += 1
+  }
+  return s
+}
+return run(4000)
+)", 2000 * 2.5 + 2000 * 1.5 * 2.5, "LOAD_VAR_LOAD_VAR_BINOP");
+}
+
+static void test_load_var_load_const_cmp_jump() {
+    checkFusedMatchesPlain(OpCode::LOAD_VAR_LOAD_CONST_CMP_JUMP, R"(
+fn run() {
+  i = 0
+  hits = 0
+  while i < 6000 {
+    if i >= 5990.5 { hits += 1 }
+    i += 1
+  }
+  return hits * 100000 + i
+}
+return run()
+)", 9 * 100000 + 6000, "LOAD_VAR_LOAD_CONST_CMP_JUMP");
+}
+
+static void test_load_var_load_var_cmp_jump() {
+    checkFusedMatchesPlain(OpCode::LOAD_VAR_LOAD_VAR_CMP_JUMP, R"(
+fn run(n, limit) {
+  i = 0
+  over = 0
+  while i < n {
+    if i > limit { over += 1 }
+    i += 1
+  }
+  return over
+}
+return run(6000, 4999.5)
+)", 1000, "LOAD_VAR_LOAD_VAR_CMP_JUMP");
+}
+
+static void test_dup_store_var_pop() {
+    checkFusedMatchesPlain(OpCode::DUP_STORE_VAR_POP, R"(
+fn run(n) {
+  a = 0
+  b = 0
+  i = 0
+  while i < n {
+    a = i
+    b = a + b
+    i += 1
+  }
+  return b
+}
+return run(3000)
+)", 3000.0 * 2999 / 2, "DUP_STORE_VAR_POP");
+}
+
+static void test_dup_store_global_pop() {
+    checkFusedMatchesPlain(OpCode::DUP_STORE_GLOBAL_POP, R"(
+total = 0
+fn run(n) {
+  i = 0
+  while i < n {
+    total = total + 2
+    i += 1
+  }
+}
+run(3000)
+return total
+)", 6000, "DUP_STORE_GLOBAL_POP");
+}
+
+void run_superinstruction_tests() {
+    std::cout << "=== Superinstruction Tests ===\n\n";
+
+    test_load_var_load_const_binop();
+    std::cout << " PASS LOAD_VAR_LOAD_CONST_BINOP matches the plain sequence\n";
+
+    test_load_var_load_var_binop();
+    std::cout << " PASS LOAD_VAR_LOAD_VAR_BINOP matches the plain sequence\n";
+
+    test_load_var_load_const_cmp_jump();
+    std::cout << " PASS LOAD_VAR_LOAD_CONST_CMP_JUMP matches the plain sequence\n";
+
+    test_load_var_load_var_cmp_jump();
+    std::cout << " PASS LOAD_VAR_LOAD_VAR_CMP_JUMP matches the plain sequence\n";
+
+    test_dup_store_var_pop();
+    std::cout << " PASS DUP_STORE_VAR_POP matches the plain sequence\n";
+
+    test_dup_store_global_pop();
+    std::cout << " PASS DUP_STORE_GLOBAL_POP matches the plain sequence\n";
+
+    std::cout << "\nAll superinstruction tests passed.\n";
+}
+
+} // namespace havel::test
@@ -31,8 +31,11 @@ static std::shared_ptr<FFIType> resolveType(const compiler::VMApi& api, const Va
     return t;
 }
 
-static void* resolvePtr(const Value& v) {
+static void* resolvePtr(const compiler::VMApi& api, const Value& v) {
     if (v.isPtr()) return v.asPtr();
+    // Byte buffers pass their storage directly; the callee must not keep
+    // the pointer past the buffer's lifetime.
+    if (v.isBytesId()) return api.bytes(v).data();
     if (v.isInt()) return reinterpret_cast<void*>(static_cast<uintptr_t>(v.asInt64()));
     if (v.isDouble()) return reinterpret_cast<void*>(static_cast<uintptr_t>(v.asDouble()));
     // Handle arrays - extract the data pointer
@@ -77,7 +80,7 @@ static Value ffiOpen(const compiler::VMApi& api, const std::vector<Value>& rawAr
 static Value ffiClose(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* handle = resolvePtr(args[0]);
+    void* handle = resolvePtr(api, args[0]);
     if (handle) {
         FFICall::unload_library(handle);
     }
@@ -87,7 +90,7 @@ static Value ffiClose(const compiler::VMApi& api, const std::vector<Value>& rawA
 static Value ffiSym(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* handle = resolvePtr(args[0]);
+    void* handle = resolvePtr(api, args[0]);
     std::string name = api.toString(args[1]);
     void* sym = FFICall::get_symbol(handle, name);
     return Value::makePtr(sym);
@@ -104,7 +107,7 @@ static Value ffiCall(const compiler::VMApi& api, const std::vector<Value>& rawAr
         return Value::makeNull();
     }
 
-    void* fn_ptr = resolvePtr(args[0]);
+    void* fn_ptr = resolvePtr(api, args[0]);
     if (!fn_ptr) {
         ::havel::error("ffi.call: null function pointer");
         return Value::makeNull();
@@ -158,7 +161,7 @@ static Value ffiCall(const compiler::VMApi& api, const std::vector<Value>& rawAr
       arg_storage.push_back(std::move(ptr_buf));
       string_storage.push_back(std::move(buf));
         } else if (pt->kind == FFITypeKind::POINTER) {
-            void* p = resolvePtr(arg);
+            void* p = resolvePtr(api, arg);
             auto buf = std::make_unique<uint8_t[]>(sizeof(void*));
             std::memcpy(buf.get(), static_cast<const void*>(&p), sizeof(void*));
             arg_ptrs.push_back(buf.get());
@@ -192,7 +195,7 @@ static Value ffiCdef(const compiler::VMApi& api, const std::vector<Value>& rawAr
 
     void* lib_handle = nullptr;
     if (args.size() >= 2) {
-        lib_handle = resolvePtr(args[1]);
+        lib_handle = resolvePtr(api, args[1]);
     }
 
     auto decls = FFICall::parse_cdef(cdef);
@@ -304,7 +307,7 @@ static Value ffiAllocBytes(const compiler::VMApi& api, const std::vector<Value>&
 static Value ffiFree(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     FFIMemory::free(ptr);
     return Value::makeNull();
 }
@@ -332,7 +335,7 @@ static Value ffiAlignof(const compiler::VMApi& api, const std::vector<Value>& ra
 static Value ffiString(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     const char* str = static_cast<const char*>(ptr);
 constexpr size_t FFI_MAX_STRING_READ = 64 * 1024 * 1024;
@@ -362,7 +365,7 @@ static Value ffiCstring(const compiler::VMApi& api, const std::vector<Value>& ra
 static Value ffiArray(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
 	auto args = stripReceiver(api, rawArgs);
 	if (args.size() < 3) return Value::makeNull();
-	void* ptr = resolvePtr(args[0]);
+	void* ptr = resolvePtr(api, args[0]);
 	if (!ptr) return Value::makeNull();
 	auto t = resolveType(api, args[1]);
 	if (!t) return Value::makeNull();
@@ -384,7 +387,7 @@ static Value ffiArray(const compiler::VMApi& api, const std::vector<Value>& rawA
 static Value ffiCast(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     auto t = resolveType(api, args[1]);
     if (!t) return Value::makeNull();
     void* result = FFIMemory::cast(ptr, t);
@@ -422,7 +425,7 @@ static Value ffiStruct(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiField(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 3) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     auto t = resolveType(api, args[1]);
     if (!t || t->kind != FFITypeKind::STRUCT) return Value::makeNull();
@@ -442,7 +445,7 @@ static Value ffiField(const compiler::VMApi& api, const std::vector<Value>& rawA
 static Value ffiSetField(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 4) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     auto t = resolveType(api, args[1]);
     if (!t || t->kind != FFITypeKind::STRUCT) return Value::makeNull();
@@ -502,7 +505,7 @@ static Value ffiCallback(const compiler::VMApi& api, const std::vector<Value>& r
 static Value ffiClosure(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* cb = resolvePtr(args[0]);
+    void* cb = resolvePtr(api, args[0]);
     FFICall::destroy_callback(cb);
     return Value::makeNull();
 }
@@ -514,8 +517,8 @@ static Value ffiClosure(const compiler::VMApi& api, const std::vector<Value>& ra
 static Value ffiMemcpy(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
 	auto args = stripReceiver(api, rawArgs);
 	if (args.size() < 3) return Value::makeNull();
-	void* dst = resolvePtr(args[0]);
-	void* src = resolvePtr(args[1]);
+	void* dst = resolvePtr(api, args[0]);
+	void* src = resolvePtr(api, args[1]);
 	if (!dst || !src) return Value::makeNull();
 	int64_t sz = args[2].asInt64();
 	if (sz < 0 || sz > 1024 * 1024 * 1024) return Value::makeNull();
@@ -527,7 +530,7 @@ static Value ffiMemcpy(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiMemset(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
 	auto args = stripReceiver(api, rawArgs);
 	if (args.size() < 3) return Value::makeNull();
-	void* ptr = resolvePtr(args[0]);
+	void* ptr = resolvePtr(api, args[0]);
 	if (!ptr) return Value::makeNull();
 	int val = static_cast<int>(args[1].asInt64());
 	int64_t sz = args[2].asInt64();
@@ -544,7 +547,7 @@ static Value ffiMemset(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiVar(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* handle = resolvePtr(args[0]);
+    void* handle = resolvePtr(api, args[0]);
     std::string name = api.toString(args[1]);
     void* sym = FFICall::get_symbol(handle, name);
     return Value::makePtr(sym);
@@ -553,7 +556,7 @@ static Value ffiVar(const compiler::VMApi& api, const std::vector<Value>& rawArg
 static Value ffiGet(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     auto t = resolveType(api, args[1]);
     if (!t) return Value::makeNull();
@@ -563,7 +566,7 @@ static Value ffiGet(const compiler::VMApi& api, const std::vector<Value>& rawArg
 static Value ffiSet(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 3) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     auto t = resolveType(api, args[1]);
     if (!t) return Value::makeNull();
@@ -584,7 +587,7 @@ static Value ffiSet(const compiler::VMApi& api, const std::vector<Value>& rawArg
 static Value ffi##name(const compiler::VMApi& api, const std::vector<Value>& rawArgs) { \
     auto args = stripReceiver(api, rawArgs); \
     if (args.size() < 1) return Value::makeNull(); \
-        void* ptr = resolvePtr(args[0]); \
+        void* ptr = resolvePtr(api, args[0]); \
         if (!ptr) return Value::makeNull(); \
         return accessor(ptr); \
     }
@@ -593,7 +596,7 @@ static Value ffi##name(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffi##name(const compiler::VMApi& api, const std::vector<Value>& rawArgs) { \
     auto args = stripReceiver(api, rawArgs); \
     if (args.size() < 2) return Value::makeNull(); \
-        void* ptr = resolvePtr(args[0]); \
+        void* ptr = resolvePtr(api, args[0]); \
         if (!ptr) return Value::makeNull(); \
         ctype v = static_cast<ctype>(args[1].asInt64()); \
         accessor(ptr, v); \
@@ -603,14 +606,14 @@ static Value ffi##name(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetI8(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_int8(ptr)));
 }
 static Value ffiSetI8(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_int8(ptr, static_cast<int8_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -619,14 +622,14 @@ static Value ffiSetI8(const compiler::VMApi& api, const std::vector<Value>& rawA
 static Value ffiGetI16(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_int16(ptr)));
 }
 static Value ffiSetI16(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_int16(ptr, static_cast<int16_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -635,14 +638,14 @@ static Value ffiSetI16(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetI32(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_int32(ptr)));
 }
 static Value ffiSetI32(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_int32(ptr, static_cast<int32_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -651,14 +654,14 @@ static Value ffiSetI32(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetI64(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(havel::ffi::get_int64(ptr));
 }
 static Value ffiSetI64(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_int64(ptr, args[1].asInt64());
     return Value::makeNull();
@@ -667,14 +670,14 @@ static Value ffiSetI64(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetU8(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_uint8(ptr)));
 }
 static Value ffiSetU8(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_uint8(ptr, static_cast<uint8_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -683,14 +686,14 @@ static Value ffiSetU8(const compiler::VMApi& api, const std::vector<Value>& rawA
 static Value ffiGetU16(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_uint16(ptr)));
 }
 static Value ffiSetU16(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_uint16(ptr, static_cast<uint16_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -699,14 +702,14 @@ static Value ffiSetU16(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetU32(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_uint32(ptr)));
 }
 static Value ffiSetU32(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_uint32(ptr, static_cast<uint32_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -715,14 +718,14 @@ static Value ffiSetU32(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetU64(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value(static_cast<int64_t>(havel::ffi::get_uint64(ptr)));
 }
 static Value ffiSetU64(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_uint64(ptr, static_cast<uint64_t>(args[1].asInt64()));
     return Value::makeNull();
@@ -731,14 +734,14 @@ static Value ffiSetU64(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetF32(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value::makeDouble(static_cast<double>(havel::ffi::get_float32(ptr)));
 }
 static Value ffiSetF32(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_float32(ptr, static_cast<float>(args[1].asDouble()));
     return Value::makeNull();
@@ -747,14 +750,14 @@ static Value ffiSetF32(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetF64(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value::makeDouble(havel::ffi::get_float64(ptr));
 }
 static Value ffiSetF64(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     havel::ffi::set_float64(ptr, args[1].asDouble());
     return Value::makeNull();
@@ -763,16 +766,16 @@ static Value ffiSetF64(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiGetPtr(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 1) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
     return Value::makePtr(havel::ffi::get_pointer(ptr));
 }
 static Value ffiSetPtr(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
     auto args = stripReceiver(api, rawArgs);
     if (args.size() < 2) return Value::makeNull();
-    void* ptr = resolvePtr(args[0]);
+    void* ptr = resolvePtr(api, args[0]);
     if (!ptr) return Value::makeNull();
-    void* v = resolvePtr(args[1]);
+    void* v = resolvePtr(api, args[1]);
     havel::ffi::set_pointer(ptr, v);
     return Value::makeNull();
 }
@@ -780,7 +783,7 @@ static Value ffiSetPtr(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiPtrAdd(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
   auto args = stripReceiver(api, rawArgs);
   if (args.size() < 2) return Value::makeNull();
-  void* ptr = resolvePtr(args[0]);
+  void* ptr = resolvePtr(api, args[0]);
   if (!ptr) return Value::makeNull();
   int64_t offset = args[1].isInt() ? args[1].asInt64() :
                    args[1].isDouble() ? static_cast<int64_t>(args[1].asDouble()) : 0;
@@ -790,7 +793,7 @@ static Value ffiPtrAdd(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiPtrSub(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
   auto args = stripReceiver(api, rawArgs);
   if (args.size() < 2) return Value::makeNull();
-  void* ptr = resolvePtr(args[0]);
+  void* ptr = resolvePtr(api, args[0]);
   if (!ptr) return Value::makeNull();
   int64_t offset = args[1].isInt() ? args[1].asInt64() :
                    args[1].isDouble() ? static_cast<int64_t>(args[1].asDouble()) : 0;
@@ -800,7 +803,7 @@ static Value ffiPtrSub(const compiler::VMApi& api, const std::vector<Value>& raw
 static Value ffiPtrToUint(const compiler::VMApi& api, const std::vector<Value>& rawArgs) {
   auto args = stripReceiver(api, rawArgs);
   if (args.empty()) return Value::makeNull();
-  void* ptr = resolvePtr(args[0]);
+  void* ptr = resolvePtr(api, args[0]);
   return Value(static_cast<int64_t>(reinterpret_cast<uintptr_t>(ptr)));
 }
 
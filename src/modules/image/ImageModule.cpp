@@ -283,15 +283,20 @@ void registerImageModule(const VMApi& api) {
 
     REG("image.toRGBA", [api](const auto& rawArgs) {
         auto args = stripReceiver(api, rawArgs);
-        if (args.size() < 1) return api.makeArray();
+        if (args.size() < 1) return api.makeBytes({});
         auto svc = getImageService();
-        if (!svc) return api.makeArray();
-        auto rgba = svc->toRGBA(toInt(args[0]));
-        auto arr = api.makeArray();
-        for (uint8_t v : rgba) {
-            api.push(arr, Value::makeInt(v));
-        }
-        return arr;
+        if (!svc) return api.makeBytes({});
+        // The pixel vector becomes the buffer's storage as-is
+        return api.makeBytes(svc->toRGBA(toInt(args[0])));
+    });
+
+    REG("image.fromRGBA", [api](const auto& rawArgs) {
+        auto args = stripReceiver(api, rawArgs);
+        if (args.size() < 3 || !args[0].isBytesId()) return Value::makeInt(0);
+        auto svc = getImageService();
+        if (!svc) return Value::makeInt(0);
+        // Read straight out of the buffer; OpenCV takes its own copy
+        return Value::makeInt(svc->fromRGBA(api.bytes(args[0]), toInt(args[1]), toInt(args[2])));
     });
 
     REG("image.matchTemplate", [api](const auto& rawArgs) {
@@ -344,6 +349,7 @@ void registerImageModule(const VMApi& api) {
     api.setField(imageObj, "setPixel", api.makeFunctionRef("image.setPixel"));
     api.setField(imageObj, "create", api.makeFunctionRef("image.create"));
     api.setField(imageObj, "toRGBA", api.makeFunctionRef("image.toRGBA"));
+    api.setField(imageObj, "fromRGBA", api.makeFunctionRef("image.fromRGBA"));
     api.setField(imageObj, "matchTemplate", api.makeFunctionRef("image.matchTemplate"));
 
     HAVEL_END_MODULE();